@@ -49,6 +49,14 @@ public:
 	UPROPERTY(config, EditAnywhere, Category=Transport, AdvancedDisplay)
 	TArray<FString> StaticEndpoints;
 
+	/**
+	 * Whether messages are sent in the compact binary format instead of Json.
+	 *
+	 * Binary messages are smaller and cheaper to process, but all devices on the network have to use the same format.
+	 */
+	UPROPERTY(config, EditAnywhere, Category=Transport, AdvancedDisplay)
+	bool UseBinarySerializer;
+
 public:
 
 	/**
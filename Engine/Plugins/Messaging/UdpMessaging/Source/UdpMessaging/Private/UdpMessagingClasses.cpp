@@ -12,5 +12,6 @@ UUdpMessagingSettings::UUdpMessagingSettings( const class FPostConstructInitiali
 	: Super(PCIP)
 	, EnableTransport(true)
 	, MulticastTimeToLive(1)
+	, UseBinarySerializer(false)
 	, EnableTunnel(false)
 { }
@@ -141,8 +141,18 @@ protected:
 
 		GLog->Logf(TEXT("UdpMessaging: Initializing bridge on interface %s to multicast group %s."), *UnicastEndpoint.ToText().ToString(), *MulticastEndpoint.ToText().ToString());
 
-		MessageBridge = FMessageBridgeBuilder()
-			.UsingJsonSerializer()
+		FMessageBridgeBuilder BridgeBuilder;
+
+		if (Settings->UseBinarySerializer)
+		{
+			BridgeBuilder.UsingBinarySerializer();
+		}
+		else
+		{
+			BridgeBuilder.UsingJsonSerializer();
+		}
+
+		MessageBridge = BridgeBuilder
 			.UsingTransport(MakeShareable(new FUdpMessageTransport(UnicastEndpoint, MulticastEndpoint, Settings->MulticastTimeToLive)));
 	}
 
@@ -193,6 +193,127 @@ bool FPackageDependencyInfo::DeterminePackageDependentTimeStamp(const TCHAR* InP
 	return bSuccessful;
 }
 
+/** Sorts package dependency tracking infos by package name */
+struct FComparePackageDependencyTrackingInfoByName
+{
+	FORCEINLINE bool operator()(const FPackageDependencyTrackingInfo& A, const FPackageDependencyTrackingInfo& B) const
+	{
+		return A.PackageName < B.PackageName;
+	}
+};
+
+bool FPackageDependencyInfo::DeterminePackageDependentHash(const TCHAR* InPackageName, FSHAHash& OutHash)
+{
+	// The dependent time stamp pass gathers the dependencies of the package
+	FDateTime DependentTimeStamp;
+	if (DeterminePackageDependentTimeStamp(InPackageName, DependentTimeStamp) == false)
+	{
+		return false;
+	}
+
+	FPackageDependencyTrackingInfo* PkgInfo = PackageInformation.FindRef(InPackageName);
+	if (PkgInfo->bHasDependentHash == false)
+	{
+		// Gather the package and everything it depends on, circular dependencies simply end up in the same set
+		TSet<FPackageDependencyTrackingInfo*> Dependencies;
+		TArray<FPackageDependencyTrackingInfo*> PackagesToVisit;
+		PackagesToVisit.Add(PkgInfo);
+		while (PackagesToVisit.Num() > 0)
+		{
+			FPackageDependencyTrackingInfo* VisitInfo = PackagesToVisit.Pop(false);
+			if (Dependencies.Contains(VisitInfo) == false)
+			{
+				Dependencies.Add(VisitInfo);
+				for (TMap<FString,FPackageDependencyTrackingInfo*>::TConstIterator DepIt(VisitInfo->DependentPackages); DepIt; ++DepIt)
+				{
+					PackagesToVisit.Add(DepIt.Value());
+				}
+			}
+		}
+
+		// Hash in name order, so the hash doesn't depend on the order the dependencies were found in
+		TArray<FPackageDependencyTrackingInfo*> SortedDependencies = Dependencies.Array();
+		SortedDependencies.Sort(FComparePackageDependencyTrackingInfoByName());
+
+		FSHA1 HashState;
+		for (int32 DepIdx = 0; DepIdx < SortedDependencies.Num(); DepIdx++)
+		{
+			FPackageDependencyTrackingInfo* DepInfo = SortedDependencies[DepIdx];
+			DetermineSourceHash(DepInfo);
+			HashState.UpdateWithString(*DepInfo->PackageName, DepInfo->PackageName.Len());
+			HashState.Update(DepInfo->SourceHash.Hash, sizeof(DepInfo->SourceHash.Hash));
+		}
+		HashState.Final();
+		HashState.GetHash(PkgInfo->DependentHash.Hash);
+		PkgInfo->bHasDependentHash = true;
+	}
+
+	OutHash = PkgInfo->DependentHash;
+	return true;
+}
+
+void FPackageDependencyInfo::DetermineSourceHash(FPackageDependencyTrackingInfo* InPkgInfo)
+{
+	if (InPkgInfo->bHasSourceHash == true)
+	{
+		return;
+	}
+
+	if (InPkgInfo == ShaderSourcePkgInfo)
+	{
+		HashSourceFiles(ShaderSourceFiles, false, InPkgInfo->SourceHash);
+	}
+	else if (InPkgInfo == ScriptSourcePkgInfo)
+	{
+		// Only reflected types end up in cooked blueprints, so other headers can change without recooking them
+		HashSourceFiles(ScriptSourceFiles, true, InPkgInfo->SourceHash);
+	}
+	else
+	{
+		TArray<uint8> Contents;
+		if (FFileHelper::LoadFileToArray(Contents, *InPkgInfo->SourceFilename) == false)
+		{
+			UE_LOG(LogPackageDependencyInfo, Display, TEXT("DetermineSourceHash: Failed to read %s"), *InPkgInfo->SourceFilename);
+		}
+		FSHA1::HashBuffer(Contents.GetTypedData(), Contents.Num(), InPkgInfo->SourceHash.Hash);
+	}
+	InPkgInfo->bHasSourceHash = true;
+}
+
+void FPackageDependencyInfo::HashSourceFiles(const TArray<FString>& InFilenames, bool bInReflectedOnly, FSHAHash& OutHash)
+{
+	TArray<FString> SortedFilenames = InFilenames;
+	SortedFilenames.Sort();
+
+	FSHA1 HashState;
+	for (int32 FileIdx = 0; FileIdx < SortedFilenames.Num(); FileIdx++)
+	{
+		const FString& Filename = SortedFilenames[FileIdx];
+		FString Contents;
+		if (FFileHelper::LoadFileToString(Contents, *Filename) == false)
+		{
+			UE_LOG(LogPackageDependencyInfo, Display, TEXT("HashSourceFiles: Failed to read %s"), *Filename);
+			continue;
+		}
+
+		if (bInReflectedOnly == true && 
+			Contents.Contains(TEXT("UCLASS(")) == false && 
+			Contents.Contains(TEXT("USTRUCT(")) == false && 
+			Contents.Contains(TEXT("UENUM(")) == false && 
+			Contents.Contains(TEXT("UINTERFACE(")) == false &&
+			Contents.Contains(TEXT("UFUNCTION(")) == false &&
+			Contents.Contains(TEXT("UPROPERTY(")) == false)
+		{
+			continue;
+		}
+
+		HashState.UpdateWithString(*Filename, Filename.Len());
+		HashState.UpdateWithString(*Contents, Contents.Len());
+	}
+	HashState.Final();
+	HashState.GetHash(OutHash.Hash);
+}
+
 void FPackageDependencyInfo::DetermineDependentTimeStamps(const TArray<FString>& InPackageList)
 {
 	FDateTime TempTimeStamp;
@@ -239,6 +360,7 @@ void FPackageDependencyInfo::DetermineShaderSourceTimeStamp()
 		if (FPaths::GetExtension(ShaderFilename) == TEXT("usf"))
 		{
 			// It's a shader file
+			ShaderSourceFiles.Add(ShaderFilename);
 			FDateTime ShaderTimestamp = It.Value();
 			if (ShaderTimestamp > ShaderSourceTimeStamp)
 			{
@@ -305,6 +427,7 @@ void FPackageDependencyInfo::DetermineScriptSourceTimeStamp(bool bInGame, FDateT
 		if (FPaths::GetExtension(ScriptFilename) == TEXT("h"))
 		{
 			// It's a 'script' file
+			ScriptSourceFiles.Add(ScriptFilename);
 			FDateTime ScriptTimestamp = It.Value();
 			if (ScriptTimestamp > OutNewestTime)
 			{
@@ -343,9 +466,11 @@ void FPackageDependencyInfo::PrepContentPackageTimeStamps()
 			if ( FPackageName::IsPackageExtension(*FPaths::GetExtension(ContentFilename, true)) )
 			{
 				FDateTime ContentTimestamp = It.Value();
+				FString ContentSourceFilename = ContentFilename;
 				ContentFilename = FPaths::GetBaseFilename(ContentFilename, false);
 				// Add it to the pkg info mapping
 				FPackageDependencyTrackingInfo* NewInfo = new FPackageDependencyTrackingInfo(ContentFilename, ContentTimestamp);
+				NewInfo->SourceFilename = ContentSourceFilename;
 				PackageInformation.Add(ContentFilename, NewInfo);
 			}
 		}
@@ -632,6 +757,12 @@ bool FPackageDependencyInfoModule::DeterminePackageDependentTimeStamp(const TCHA
 	return PackageDependencyInfo->DeterminePackageDependentTimeStamp(InPackageName, OutNewestTime);
 }
 
+bool FPackageDependencyInfoModule::DeterminePackageDependentHash(const TCHAR* InPackageName, FSHAHash& OutHash)
+{
+	check(PackageDependencyInfo);
+	return PackageDependencyInfo->DeterminePackageDependentHash(InPackageName, OutHash);
+}
+
 void FPackageDependencyInfoModule::DetermineDependentTimeStamps(const TArray<FString>& InPackageList)
 {
 	check(PackageDependencyInfo);
@@ -37,6 +37,16 @@ public:
 	 */
 	bool DeterminePackageDependentTimeStamp(const TCHAR* InPackageName, FDateTime& OutNewestTime);
 
+	/**
+	 *	Determine the given packages dependent hash
+	 *
+	 *	@param	InPackageName		The package to process
+	 *	@param	OutHash				The dependent hash for the package.
+	 *
+	 *	@return	bool				true if successful, false if not
+	 */
+	bool DeterminePackageDependentHash(const TCHAR* InPackageName, FSHAHash& OutHash);
+
 	/**
 	 *	Determine dependent timestamps for the given list of files
 	 *
@@ -70,6 +80,22 @@ protected:
 	 */
 	void DetermineScriptSourceTimeStamp(bool bInGame, FDateTime& OutNewestTime);
 
+	/**
+	 *	Determine the source hash of the given info if it hasn't been determined yet
+	 *
+	 *	@param	InPkgInfo			The package dependency tracking info to hash
+	 */
+	void DetermineSourceHash(FPackageDependencyTrackingInfo* InPkgInfo);
+
+	/**
+	 *	Hash the contents of a list of files
+	 *
+	 *	@param	InFilenames			The files to hash, in the order they are hashed
+	 *	@param	bInReflectedOnly	If true, only files that declare reflected types are hashed
+	 *	@param	OutHash				OUTPUT - the hash of the files
+	 */
+	void HashSourceFiles(const TArray<FString>& InFilenames, bool bInReflectedOnly, FSHAHash& OutHash);
+
 	/** Prep the content package list - ie gather the list of all content files and their actual timestamps */
 	void PrepContentPackageTimeStamps();
 
@@ -100,6 +126,8 @@ protected:
 	FString NewestShaderSource;
 	/** The pkg info for shader source */
 	FPackageDependencyTrackingInfo* ShaderSourcePkgInfo;
+	/** All shader source files, hashed for the shader source pkg info */
+	TArray<FString> ShaderSourceFiles;
 
 	/** The newest time stamp of the engine 'script' source files. Used when a package contains a blueprint */
 	FDateTime EngineScriptSourceTimeStamp;
@@ -111,6 +139,8 @@ protected:
 	FDateTime ScriptSourceTimeStamp;
 	/** The pkg info for script source */
 	FPackageDependencyTrackingInfo* ScriptSourcePkgInfo;
+	/** All engine and game 'script' source files, hashed for the script source pkg info */
+	TArray<FString> ScriptSourceFiles;
 
 	/** The package information, including dependencies for content files */
 	TMap<FString,class FPackageDependencyTrackingInfo*> PackageInformation;
@@ -4,6 +4,7 @@
 
 #include "Core.h"
 #include "ModuleInterface.h"
+#include "SecureHash.h"
 
 /** Helper struct for tracking dependency info for package timestamps */
 class FPackageDependencyTrackingInfo
@@ -17,6 +18,16 @@ public:
 	FDateTime TimeStamp;
 	/** Timestamp of the cooked package (not that actual cooked package - but the 'newest' of any dependencies) */
 	FDateTime DependentTimeStamp;
+	/** The file the package was found in, empty for the shader and script source entries */
+	FString SourceFilename;
+	/** Hash of the package file's contents, valid if bHasSourceHash is set */
+	FSHAHash SourceHash;
+	/** Hash of the package's and all of its direct and indirect dependencies' source hashes, valid if bHasDependentHash is set */
+	FSHAHash DependentHash;
+	/** Has the source hash been determined? */
+	bool bHasSourceHash;
+	/** Has the dependent hash been determined? */
+	bool bHasDependentHash;
 	/** Does the package contain a map? */
 	bool bContainsMap;
 	/** Does the package contain shaders? (ie any material interface?) */
@@ -41,6 +52,8 @@ public:
 
 	FPackageDependencyTrackingInfo()
 		: DependentTimeStamp(FDateTime::MinValue())
+		, bHasSourceHash(false)
+		, bHasDependentHash(false)
 		, bContainsMap(false)
 		, bContainsShaders(false)
 		, bContainsBlueprints(false)
@@ -53,6 +66,8 @@ public:
 		: PackageName(InPackageName)
 		, TimeStamp(InTimeStamp)
 		, DependentTimeStamp(FDateTime::MinValue())
+		, bHasSourceHash(false)
+		, bHasDependentHash(false)
 		, bContainsMap(false)
 		, bContainsShaders(false)
 		, bContainsBlueprints(false)
@@ -67,6 +82,11 @@ public:
 		PackageGuid = InInfo.PackageGuid;
 		TimeStamp = InInfo.TimeStamp;
 		DependentTimeStamp = InInfo.DependentTimeStamp;
+		SourceFilename = InInfo.SourceFilename;
+		SourceHash = InInfo.SourceHash;
+		DependentHash = InInfo.DependentHash;
+		bHasSourceHash = InInfo.bHasSourceHash;
+		bHasDependentHash = InInfo.bHasDependentHash;
 		bContainsMap = InInfo.bContainsMap;
 		bContainsShaders = InInfo.bContainsShaders;
 		bContainsBlueprints = InInfo.bContainsBlueprints;
@@ -136,6 +156,18 @@ public:
 	 */
 	virtual bool DeterminePackageDependentTimeStamp(const TCHAR* InPackageName, FDateTime& OutNewestTime);
 
+	/**
+	 *	Determine the given packages dependent hash, a hash of the contents of the package and of every
+	 *	package, shader source or script source it depends on, directly or not.
+	 *	Unlike the dependent time stamp it doesn't change when files are touched without being modified.
+	 *
+	 *	@param	InPackageName		The package to process
+	 *	@param	OutHash				The dependent hash for the package.
+	 *
+	 *	@return	bool				true if successful, false if not
+	 */
+	virtual bool DeterminePackageDependentHash(const TCHAR* InPackageName, FSHAHash& OutHash);
+
 	/**
 	 *	Determine dependent timestamps for the given list of files
 	 *
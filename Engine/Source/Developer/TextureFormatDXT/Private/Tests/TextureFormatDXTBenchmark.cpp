@@ -0,0 +1,134 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	TextureFormatDXTBenchmark.cpp: DXT compression rate at 1..N threads
+=============================================================================*/
+
+#include "Core.h"
+#include "ImageCore.h"
+#include "ModuleManager.h"
+#include "TargetPlatform.h"
+#include "TextureCompressorModule.h"
+#include "PixelFormat.h"
+#include "IConsoleManager.h"
+#include "AutomationTest.h"
+
+/** Number of times the set of textures is compressed for every thread count. */
+static const int32 DXTBenchmarkNumIterations = 2;
+
+/** A synthetic texture and the format it is compressed to. */
+struct FDXTBenchmarkTexture
+{
+	FImage Image;
+	FTextureBuildSettings BuildSettings;
+	bool bHasAlpha;
+	/** The compressed texture of the single threaded run, later runs have to match it. */
+	TArray<uint8> ReferenceData;
+};
+
+/** Adds a texture with a pattern that doesn't compress trivially. */
+static void AddDXTBenchmarkTexture(TIndirectArray<FDXTBenchmarkTexture>& Textures, const TCHAR* FormatName, int32 SizeX, int32 SizeY, int32 NumSlices, bool bHasAlpha)
+{
+	FDXTBenchmarkTexture* Texture = new(Textures) FDXTBenchmarkTexture;
+	Texture->Image.Init(SizeX, SizeY, NumSlices, ERawImageFormat::BGRA8, true);
+	Texture->BuildSettings.TextureFormatName = FName(FormatName);
+	Texture->bHasAlpha = bHasAlpha;
+
+	FColor* Texels = Texture->Image.AsBGRA8();
+	for (int32 SliceIndex = 0; SliceIndex < NumSlices; ++SliceIndex)
+	{
+		for (int32 Y = 0; Y < SizeY; ++Y)
+		{
+			for (int32 X = 0; X < SizeX; ++X)
+			{
+				const uint32 Hash = (X * 73856093) ^ (Y * 19349663) ^ (SliceIndex * 83492791);
+				FColor& Texel = Texels[(SliceIndex * SizeY + Y) * SizeX + X];
+				Texel.R = (uint8)(X * 255 / SizeX);
+				Texel.G = (uint8)(Y * 255 / SizeY);
+				Texel.B = (uint8)(Hash & 0x3f) + (uint8)(SliceIndex * 32);
+				Texel.A = bHasAlpha ? (uint8)((X ^ Y) & 0xff) : 255;
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTextureFormatDXTBenchmark, "Engine.Texture.DXT Compression Benchmark", EAutomationTestFlags::ATF_Editor | EAutomationTestFlags::ATF_Commandlet)
+
+/**
+ * Compresses a set of textures with Tex.AsyncDXTMaxThreads set to 1, 2, 4 ... up to the number of pool threads plus one,
+ * reports the textures compressed per second and checks that the results don't depend on the number of threads.
+ */
+bool FTextureFormatDXTBenchmark::RunTest(const FString& Parameters)
+{
+	ITextureFormat* TextureFormat = FModuleManager::LoadModuleChecked<ITextureFormatModule>(TEXT("TextureFormatDXT")).GetTextureFormat();
+	IConsoleVariable* MaxThreadsCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Tex.AsyncDXTMaxThreads"));
+	check(TextureFormat && MaxThreadsCVar);
+
+	TIndirectArray<FDXTBenchmarkTexture> Textures;
+	AddDXTBenchmarkTexture(Textures, TEXT("DXT1"), 2048, 2048, 1, false);
+	AddDXTBenchmarkTexture(Textures, TEXT("DXT5"), 1024, 1024, 1, true);
+	AddDXTBenchmarkTexture(Textures, TEXT("BC5"), 1024, 512, 1, false);
+	AddDXTBenchmarkTexture(Textures, TEXT("AutoDXT"), 512, 512, 6, false);
+	AddDXTBenchmarkTexture(Textures, TEXT("DXT1"), 256, 256, 16, false);
+	AddDXTBenchmarkTexture(Textures, TEXT("BC4"), 64, 64, 1, false);
+
+	// 1, 2, 4 ... and the number of pool threads plus the calling thread
+	const int32 MaxThreads = FPlatformMisc::NumberOfWorkerThreadsToSpawn() + 1;
+	TArray<int32> ThreadCounts;
+	for (int32 NumThreads = 1; NumThreads < MaxThreads; NumThreads *= 2)
+	{
+		ThreadCounts.Add(NumThreads);
+	}
+	ThreadCounts.Add(MaxThreads);
+
+	const int32 OldMaxThreads = MaxThreadsCVar->GetInt();
+	double SingleThreadedRate = 0.0;
+	bool bSucceeded = true;
+
+	AddLogItem(FString::Printf(TEXT("%d textures, %d iterations"), Textures.Num(), DXTBenchmarkNumIterations));
+	AddLogItem(FString::Printf(TEXT("%8s %12s %12s %8s"), TEXT("Threads"), TEXT("Time"), TEXT("Textures/s"), TEXT("Speedup")));
+
+	for (int32 CountIndex = 0; CountIndex < ThreadCounts.Num(); ++CountIndex)
+	{
+		const int32 NumThreads = ThreadCounts[CountIndex];
+		MaxThreadsCVar->Set(*FString::FromInt(NumThreads));
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < DXTBenchmarkNumIterations; ++Iteration)
+		{
+			for (int32 TextureIndex = 0; TextureIndex < Textures.Num(); ++TextureIndex)
+			{
+				FDXTBenchmarkTexture& Texture = Textures[TextureIndex];
+				FCompressedImage2D CompressedImage;
+
+				if (!TextureFormat->CompressImage(Texture.Image, Texture.BuildSettings, Texture.bHasAlpha, CompressedImage))
+				{
+					AddError(FString::Printf(TEXT("Failed to compress %s texture %d with %d threads"), *Texture.BuildSettings.TextureFormatName.ToString(), TextureIndex, NumThreads));
+					bSucceeded = false;
+				}
+				else if (NumThreads == 1 && Iteration == 0)
+				{
+					Texture.ReferenceData = CompressedImage.RawData;
+				}
+				else if (CompressedImage.RawData != Texture.ReferenceData)
+				{
+					AddError(FString::Printf(TEXT("%s texture %d compressed differently with %d threads"), *Texture.BuildSettings.TextureFormatName.ToString(), TextureIndex, NumThreads));
+					bSucceeded = false;
+				}
+			}
+		}
+		const double Time = FPlatformTime::Seconds() - StartTime;
+
+		const double Rate = Textures.Num() * DXTBenchmarkNumIterations / FMath::Max(Time, (double)SMALL_NUMBER);
+		if (NumThreads == 1)
+		{
+			SingleThreadedRate = Rate;
+		}
+
+		AddLogItem(FString::Printf(TEXT("%8d %10.2fms %12.2f %7.2fx"), NumThreads, Time * 1000.0, Rate, Rate / FMath::Max(SingleThreadedRate, (double)SMALL_NUMBER)));
+	}
+
+	MaxThreadsCVar->Set(*FString::FromInt(OldMaxThreads));
+
+	return bSucceeded;
+}
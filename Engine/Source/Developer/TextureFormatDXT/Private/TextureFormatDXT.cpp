@@ -87,11 +87,11 @@ struct FNVErrorHandler : public nvtt::ErrorHandler
 	bool bSuccess;
 };
 
-/** Critical section to isolate construction of nvtt objects */
-FCriticalSection GNVCompressionCriticalSection;
-
 /**
  * All state objects needed for NVTT.
+ *
+ * The nvtt::Compressor is not part of it, constructing one probes for CUDA which is not thread safe.
+ * Compressing only reads it though, so all compressions share the one owned by the texture format.
  */
 class FNVTTCompressor
 {
@@ -100,11 +100,12 @@ class FNVTTCompressor
 	nvtt::InputOptions			InputOptions;
 	nvtt::CompressionOptions	CompressionOptions;
 	nvtt::OutputOptions			OutputOptions;
-	nvtt::Compressor			Compressor;
+	const nvtt::Compressor&		Compressor;
 
 public:
 	/** Initialization constructor. */
 	FNVTTCompressor(
+		const nvtt::Compressor& InCompressor,
 		const void* SourceData,
 		EPixelFormat PixelFormat,
 		int32 SizeX,
@@ -115,13 +116,8 @@ public:
 		int32 BufferSize
 		)
 		: OutputHandler(OutBuffer, BufferSize)
+		, Compressor(InCompressor)
 	{
-		// CUDA acceleration currently disabled, needs more robust error handling
-		// With one core of a Xeon 3GHz CPU, compressing a 2048^2 normal map to DXT1 with NVTT 2.0.4 takes 7.49s.
-		// With the same settings but using CUDA and a Geforce 8800 GTX it takes 1.66s.
-		// To use CUDA, a CUDA 2.0 capable driver is required (178.08 or greater) and a Geforce 8 or higher.
-		const bool bUseCUDAAcceleration = false;
-
 		// DXT1a support is currently not exposed.
 		const bool bSupportDXT1a = false;
 
@@ -202,7 +198,6 @@ public:
 			CompressionOptions.setColorWeights(1, 1, 1);
 		}
 
-		Compressor.enableCudaAcceleration(bUseCUDAAcceleration);
 		//OutputHandler.ReserveMemory( Compressor.estimateSize(InputOptions, CompressionOptions) );
 		check(OutputHandler.BufferEnd - OutputHandler.Buffer <= Compressor.estimateSize(InputOptions, CompressionOptions));
 
@@ -219,6 +214,82 @@ public:
 	}
 };
 
+/**
+ * A part of an image that is compressed on its own. Tiles span whole block rows,
+ * so the compressed tiles of an image laid out one after another are the compressed image.
+ */
+struct FNVTTTile
+{
+	/** Source texels, in BGRA 8bit per channel unsigned format. */
+	const uint8* SourceData;
+	/** Number of texels along the X-axis. */
+	int32 SizeX;
+	/** Number of texels along the Y-axis. */
+	int32 SizeY;
+	/** Where the compressed blocks of the tile go. */
+	uint8* OutData;
+	/** Size of the compressed tile in bytes. */
+	int32 OutDataSize;
+};
+
+/**
+ * The tiles of all slices of an image, compressed by as many threads as pick them up.
+ */
+class FNVTTTileCompressor
+{
+public:
+	/** Initialization constructor. */
+	FNVTTTileCompressor(const nvtt::Compressor& InCompressor, EPixelFormat InPixelFormat, bool bInSRGB, bool bInIsNormalMap)
+		: Compressor(InCompressor)
+		, PixelFormat(InPixelFormat)
+		, bSRGB(bInSRGB)
+		, bIsNormalMap(bInIsNormalMap)
+	{
+	}
+
+	/** Compresses tiles until there are none left, called by every thread that helps. */
+	void Run()
+	{
+		for (int32 TileIndex = NextTile.Increment() - 1; TileIndex < Tiles.Num(); TileIndex = NextTile.Increment() - 1)
+		{
+			const FNVTTTile& Tile = Tiles[TileIndex];
+			FNVTTCompressor TileCompressor(
+				Compressor,
+				Tile.SourceData,
+				PixelFormat,
+				Tile.SizeX,
+				Tile.SizeY,
+				bSRGB,
+				bIsNormalMap,
+				Tile.OutData,
+				Tile.OutDataSize
+				);
+
+			if (!TileCompressor.Compress())
+			{
+				NumFailedTiles.Increment();
+			}
+		}
+	}
+
+	/** The tiles to compress. */
+	TArray<FNVTTTile> Tiles;
+	/** Number of tiles that failed to compress. */
+	FThreadSafeCounter NumFailedTiles;
+
+private:
+	/** The shared NVTT compressor. */
+	const nvtt::Compressor& Compressor;
+	/** Texture format. */
+	EPixelFormat PixelFormat;
+	/** Whether the texture is in SRGB space. */
+	bool bSRGB;
+	/** Whether the texture is a normal map. */
+	bool bIsNormalMap;
+	/** Index of the next tile a thread picks up. */
+	FThreadSafeCounter NextTile;
+};
+
 /**
  * Asynchronous NVTT worker.
  */
@@ -228,16 +299,16 @@ public:
 	/**
 	 * Initializes the data and creates the async compression task.
 	 */
-	FAsyncNVTTWorker(FNVTTCompressor* InCompressor)
-		: Compressor(InCompressor)
+	FAsyncNVTTWorker(FNVTTTileCompressor* InTileCompressor)
+		: TileCompressor(InTileCompressor)
 	{
-		check(Compressor);
+		check(TileCompressor);
 	}
 
-	/** Compresses the texture. */
+	/** Compresses tiles of the texture. */
 	void DoWork()
 	{
-		bCompressionResults = Compressor->Compress();
+		TileCompressor->Run();
 	}
 
 	static const TCHAR* Name()
@@ -245,14 +316,9 @@ public:
 		return TEXT("FAsyncNVTTTask");
 	}
 
-	/** Retrieve compression results. */
-	bool GetCompressionResults() const { return bCompressionResults; }
-
 private:
-	/** The NVTT compressor. */
-	FNVTTCompressor* Compressor;
-	/** true if compression was successful. */
-	bool bCompressionResults;
+	/** The tiles to help compressing. */
+	FNVTTTileCompressor* TileCompressor;
 };
 typedef FAsyncTask<FAsyncNVTTWorker> FAsyncNVTTTask;
 
@@ -264,26 +330,31 @@ namespace CompressionSettings
 		BlocksPerBatch,
 		TEXT("The number of blocks to compress in parallel for DXT compression.")
 		);
+
+	int32 MaxThreads = 0;
+	FAutoConsoleVariableRef MaxThreads_CVar(
+		TEXT("Tex.AsyncDXTMaxThreads"),
+		MaxThreads,
+		TEXT("The maximum number of threads compressing the tiles of one texture for DXT compression, 0 for the thread pool plus the calling thread.")
+		);
 }
 
 /**
- * Compresses an image using NVTT.
+ * Splits an image into tiles of at most Tex.AsyncDXTBlocksPerBatch blocks.
  * @param SourceData			Source texture data to DXT compress, in BGRA 8bit per channel unsigned format.
  * @param PixelFormat			Texture format
  * @param SizeX					Number of texels along the X-axis
  * @param SizeY					Number of texels along the Y-axis
- * @param bSRGB					Whether the texture is in SRGB space
- * @param bIsNormalMap			Whether the texture is a normal map
- * @param OutCompressedData		Compressed image data output by nvtt.
+ * @param OutCompressedData		Where the compressed image goes, must have room for GetCompressedImageSize bytes.
+ * @param OutTiles				Tiles are added to this array.
  */
-static bool CompressImageUsingNVTT(
+static void AddImageTiles(
 	const void* SourceData,
 	EPixelFormat PixelFormat,
 	int32 SizeX,
 	int32 SizeY,
-	bool bSRGB,
-	bool bIsNormalMap,
-	TArray<uint8>& OutCompressedData
+	uint8* OutCompressedData,
+	TArray<FNVTTTile>& OutTiles
 	)
 {
 	check(PixelFormat == PF_DXT1 || PixelFormat == PF_DXT3 || PixelFormat == PF_DXT5 || PixelFormat == PF_BC4 || PixelFormat == PF_BC5);
@@ -296,90 +367,77 @@ static bool CompressImageUsingNVTT(
 	const int32 ImageBlocksY = FMath::Max(SizeY / BlockSizeY, 1);
 	const int32 BlocksPerBatch = FMath::Max<int32>(ImageBlocksX, FMath::RoundUpToPowerOfTwo(CompressionSettings::BlocksPerBatch));
 	const int32 RowsPerBatch = BlocksPerBatch / ImageBlocksX;
-	const int32 NumBatches = ImageBlocksY / RowsPerBatch;
 
-	// Allocate space to store compressed data.
-	OutCompressedData.Empty(ImageBlocksX * ImageBlocksY * BlockBytes);
-	OutCompressedData.AddUninitialized(ImageBlocksX * ImageBlocksY * BlockBytes);
+	// Rows of partial blocks can only be compressed as part of the whole image.
+	if (ImageBlocksY <= RowsPerBatch || SizeY % BlockSizeY != 0)
+	{
+		FNVTTTile& Tile = OutTiles[OutTiles.AddUninitialized()];
+		Tile.SourceData = (const uint8*)SourceData;
+		Tile.SizeX = SizeX;
+		Tile.SizeY = SizeY;
+		Tile.OutData = OutCompressedData;
+		Tile.OutDataSize = ImageBlocksX * ImageBlocksY * BlockBytes;
+		return;
+	}
 
-	if (ImageBlocksX * ImageBlocksY <= BlocksPerBatch ||
-		BlocksPerBatch % ImageBlocksX != 0 ||
-		RowsPerBatch * NumBatches != ImageBlocksY)
+	// The last tile takes the rows that are left over.
+	for (int32 FirstRow = 0; FirstRow < ImageBlocksY; FirstRow += RowsPerBatch)
 	{
-		FNVTTCompressor* Compressor = NULL;
-		{
-			FScopeLock ScopeLock(&GNVCompressionCriticalSection);
-			Compressor = new FNVTTCompressor(
-				SourceData,
-				PixelFormat,
-				SizeX,
-				SizeY,
-				bSRGB,
-				bIsNormalMap,
-				OutCompressedData.GetTypedData(),
-				OutCompressedData.Num()
-				);
-		}
-		bool bSuccess = Compressor->Compress();
-		{
-			FScopeLock ScopeLock(&GNVCompressionCriticalSection);
-			delete Compressor;
-			Compressor = NULL;
-		}
-		return bSuccess;
+		const int32 NumRows = FMath::Min(RowsPerBatch, ImageBlocksY - FirstRow);
+
+		FNVTTTile& Tile = OutTiles[OutTiles.AddUninitialized()];
+		Tile.SourceData = (const uint8*)SourceData + FirstRow * BlockSizeY * SizeX * sizeof(FColor);
+		Tile.SizeX = SizeX;
+		Tile.SizeY = NumRows * BlockSizeY;
+		Tile.OutData = OutCompressedData + FirstRow * ImageBlocksX * BlockBytes;
+		Tile.OutDataSize = NumRows * ImageBlocksX * BlockBytes;
 	}
+}
 
-	int32 UncompressedStride = RowsPerBatch * BlockSizeY * SizeX * sizeof(FColor);
-	int32 CompressedStride = RowsPerBatch * ImageBlocksX * BlockBytes;
+/**
+ * Gets the size of an image compressed by NVTT.
+ * @param PixelFormat			Texture format
+ * @param SizeX					Number of texels along the X-axis
+ * @param SizeY					Number of texels along the Y-axis
+ */
+static int32 GetCompressedImageSize(EPixelFormat PixelFormat, int32 SizeX, int32 SizeY)
+{
+	const int32 BlockBytes = (PixelFormat == PF_DXT1 || PixelFormat == PF_BC4) ? 8 : 16;
+	return FMath::Max(SizeX / 4, 1) * FMath::Max(SizeY / 4, 1) * BlockBytes;
+}
 
-	// Create compressors for each batch.
-	TIndirectArray<FNVTTCompressor> Compressors;
-	Compressors.Empty(NumBatches);
+/**
+ * Compresses tiles using NVTT, on the thread pool and the calling thread.
+ * @param TileCompressor		The tiles to compress.
+ * @return true if all tiles were compressed.
+ */
+static bool CompressTilesUsingNVTT(FNVTTTileCompressor& TileCompressor)
+{
+	int32 NumThreads = CompressionSettings::MaxThreads > 0 ? CompressionSettings::MaxThreads : FPlatformMisc::NumberOfWorkerThreadsToSpawn() + 1;
+	if (GThreadPool == NULL)
 	{
-		FScopeLock ScopeLock(&GNVCompressionCriticalSection);
-		const uint8* Src = (const uint8*)SourceData;
-		uint8* Dest = OutCompressedData.GetTypedData();
-		for (int32 BatchIndex = 0; BatchIndex < NumBatches; ++BatchIndex)
-		{
-			new(Compressors) FNVTTCompressor(
-				Src,
-				PixelFormat,
-				SizeX,
-				RowsPerBatch * BlockSizeY,
-				bSRGB,
-				bIsNormalMap,
-				Dest,
-				CompressedStride
-				);
-			Src += UncompressedStride;
-			Dest += CompressedStride;
-		}
+		NumThreads = 1;
 	}
+	NumThreads = FMath::Min(NumThreads, TileCompressor.Tiles.Num());
 
-	// Asynchronously compress each batch.
-	bool bSuccess = true;
+	// Threads that don't find any tiles left to compress just return.
+	TIndirectArray<FAsyncNVTTTask> AsyncTasks;
+	for (int32 TaskIndex = 1; TaskIndex < NumThreads; ++TaskIndex)
 	{
-		TIndirectArray<FAsyncNVTTTask> AsyncTasks;
-		for (int32 BatchIndex = 0; BatchIndex < NumBatches; ++BatchIndex)
-		{
-			FAsyncNVTTTask* AsyncTask = new(AsyncTasks) FAsyncNVTTTask(&Compressors[BatchIndex]);
-			AsyncTask->StartBackgroundTask();
-		}
-		for (int32 BatchIndex = 0; BatchIndex < NumBatches; ++BatchIndex)
-		{
-			FAsyncNVTTTask& AsyncTask = AsyncTasks[BatchIndex];
-			AsyncTask.EnsureCompletion();
-			bSuccess = bSuccess && AsyncTask.GetTask().GetCompressionResults();
-		}
+		FAsyncNVTTTask* AsyncTask = new(AsyncTasks) FAsyncNVTTTask(&TileCompressor);
+		AsyncTask->StartBackgroundTask();
 	}
 
-	// Release compressors
+	// This thread does its share too instead of just waiting.
+	// Pool threads may compress textures themselves, tasks they never got to are done here.
+	TileCompressor.Run();
+
+	for (int32 TaskIndex = 0; TaskIndex < AsyncTasks.Num(); ++TaskIndex)
 	{
-		FScopeLock ScopeLock(&GNVCompressionCriticalSection);
-		Compressors.Empty();
+		AsyncTasks[TaskIndex].EnsureCompletion();
 	}
 
-	return bSuccess;
+	return TileCompressor.NumFailedTiles.GetValue() == 0;
 }
 
 /**
@@ -387,6 +445,21 @@ static bool CompressImageUsingNVTT(
  */
 class FTextureFormatDXT : public ITextureFormat
 {
+	/** The compressor shared by all compressions, it is only read while compressing. */
+	nvtt::Compressor Compressor;
+
+public:
+	FTextureFormatDXT()
+	{
+		// CUDA acceleration currently disabled, needs more robust error handling
+		// With one core of a Xeon 3GHz CPU, compressing a 2048^2 normal map to DXT1 with NVTT 2.0.4 takes 7.49s.
+		// With the same settings but using CUDA and a Geforce 8800 GTX it takes 1.66s.
+		// To use CUDA, a CUDA 2.0 capable driver is required (178.08 or greater) and a Geforce 8 or higher.
+		const bool bUseCUDAAcceleration = false;
+
+		Compressor.enableCudaAcceleration(bUseCUDAAcceleration);
+	}
+
 	virtual bool AllowParallelBuild() const OVERRIDE
 	{
 		return true;
@@ -448,23 +521,27 @@ class FTextureFormatDXT : public ITextureFormat
 			CompressedPixelFormat = PF_BC4;
 		}
 
-		bool bCompressionSucceeded = true;
-		int32 SliceSize = Image.SizeX * Image.SizeY;
-		for (int32 SliceIndex = 0; SliceIndex < Image.NumSlices && bCompressionSucceeded; ++SliceIndex)
+		// Tiles of all slices are compressed together, so small mips of texture arrays keep all threads busy too.
+		const int32 SliceSize = Image.SizeX * Image.SizeY;
+		const int32 CompressedSliceSize = GetCompressedImageSize(CompressedPixelFormat, Image.SizeX, Image.SizeY);
+		OutCompressedImage.RawData.Empty(CompressedSliceSize * Image.NumSlices);
+		OutCompressedImage.RawData.AddUninitialized(CompressedSliceSize * Image.NumSlices);
+
+		FNVTTTileCompressor TileCompressor(Compressor, CompressedPixelFormat, Image.bSRGB, bIsNormalMap);
+		for (int32 SliceIndex = 0; SliceIndex < Image.NumSlices; ++SliceIndex)
 		{
-			TArray<uint8> CompressedSliceData;
-			bCompressionSucceeded = CompressImageUsingNVTT(
+			AddImageTiles(
 				Image.AsBGRA8() + SliceIndex * SliceSize,
 				CompressedPixelFormat,
 				Image.SizeX,
 				Image.SizeY,
-				Image.bSRGB,
-				bIsNormalMap,
-				CompressedSliceData
+				OutCompressedImage.RawData.GetTypedData() + SliceIndex * CompressedSliceSize,
+				TileCompressor.Tiles
 				);
-			OutCompressedImage.RawData.Append(CompressedSliceData);
 		}
 
+		bool bCompressionSucceeded = CompressTilesUsingNVTT(TileCompressor);
+
 		if (bCompressionSucceeded)
 		{
 			OutCompressedImage.SizeX = FMath::Max(Image.SizeX, 4);
@@ -30,6 +30,8 @@ class UCookCommandlet
 	bool bUnversioned;
 	/** Generate manifests for building streaming install packages */
 	bool bGenerateStreamingInstallManifests;
+	/** Index of this process if it is a worker of a cook split over several processes, INDEX_NONE otherwise */
+	int32 CookWorkerIndex;
 	/** All commandline tokens */
 	TArray<FString> Tokens;
 	/** All commandline switches */
@@ -57,14 +59,16 @@ class UCookCommandlet
 	FString GetOutputDirectory( const FString& PlatformName ) const;
 
 	/**
-	 *	Get the given packages 'cooked' timestamp (i.e. account for dependencies)
+	 *	Get the key the given package is cooked with for a platform (i.e. a hash of the package, its dependencies,
+	 *	the cook settings and the engine version)
 	 *
 	 *	@param	InFilename			The filename of the package
-	 *	@param	OutDateTime			The timestamp the cooked file should have
+	 *	@param	Target				The platform the package is cooked for
+	 *	@param	OutCookKey			The key the cooked package is recorded with in the cook manifest
 	 *
-	 *	@return	bool				true if the package timestamp was found, false if not
+	 *	@return	bool				true if the package hash was found, false if not
 	 */
-	bool GetPackageTimestamp( const FString& InFilename, FDateTime& OutDateTime );
+	bool GetPackageCookKey( const FString& InFilename, const ITargetPlatform* Target, class FSHAHash& OutCookKey );
 
 	/**
 	 *	Cook (save) the given package
@@ -110,6 +114,44 @@ private:
 	/** Leak test: last gc items */
 	TSet<FWeakObjectPtr> LastGCItems;
 
+	/** Packages cooked for each platform in this and previous iterative cooks, by platform name */
+	TMap<FString, TSharedPtr<class FCookManifest> > CookManifests;
+
+	/** Returns where the cook manifest of a platform is stored */
+	FString GetCookManifestFilename(const FString& PlatformName) const;
+
+	/** Loads the cook manifests of all target platforms, only used when cooking iteratively */
+	void LoadCookManifests(const TArray<ITargetPlatform*>& Platforms);
+
+	/** Saves the cook manifests and reports how many packages were up to date */
+	void SaveCookManifests();
+
+	/** Returns the cook manifest of a platform, NULL if not cooking iteratively */
+	class FCookManifest* GetCookManifest(const ITargetPlatform* Target) const;
+
+	/** Worker process that saves each package, when cooking as a worker of a cook split over several processes */
+	TMap<FName, int32> CookWorkerPackages;
+
+	/** Returns the directory a cook split over several processes exchanges its files in */
+	FString GetCookWorkerDirectory() const;
+
+	/**
+	 * Groups packages that depend on each other and spreads the groups over worker processes, so that each worker
+	 * loads as few packages another worker saves as possible.
+	 *
+	 * @param FilesInPath Long package names of the packages to cook
+	 * @param NumWorkers Number of worker processes
+	 * @param OutPackageWorkers Worker that saves each package, including all packages the packages to cook depend on
+	 * @param OutWorkerSizes Total package file size assigned to each worker
+	 */
+	void PartitionPackages(const TArray<FString>& FilesInPath, int32 NumWorkers, TMap<FName, int32>& OutPackageWorkers, TArray<int64>& OutWorkerSizes) const;
+
+	/** Loads the packages this worker process saves, written by the coordinating process */
+	bool LoadCookWorkerPackages(const FString& Filename);
+
+	/** Returns true if the package is saved by this process, false if another worker process of the cook saves it */
+	bool IsSavedByThisProcess(UPackage* Package) const;
+
 	void MaybeMarkPackageAsAlreadyLoaded(UPackage *Package);
 
 	/** Gets the output directory respecting any command line overrides */
@@ -133,5 +175,17 @@ private:
 	/** Cooks all files */
 	bool Cook(const TArray<ITargetPlatform*>& Platforms, TArray<FString>& FilesInPath);
 
+	/**
+	 * Loads the given files and saves everything they load that this process saves.
+	 *
+	 * @param FilesInPath Long package names of the files to cook
+	 * @param ManifestGenerator Collects the chunks the loaded packages go to
+	 * @param OutUnassignedPackages Packages loaded by a cook worker that no worker was assigned to save
+	 */
+	void CookFiles(const TArray<FString>& FilesInPath, class FChunkManifestGenerator& ManifestGenerator, TArray<FString>& OutUnassignedPackages);
+
+	/** Cooks all files with several worker processes and merges what they generated */
+	bool CookInWorkers(const TArray<ITargetPlatform*>& Platforms, TArray<FString>& FilesInPath, int32 NumWorkers);
+
 
 };
\ No newline at end of file
@@ -0,0 +1,19 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "StatsAnalyzerCommandlet.generated.h"
+
+/**
+ * Reads a stats capture (.ue4stats, regular or written by "stat startcompactfile") without the profiler and writes
+ * per stat inclusive and exclusive time percentiles and a report of the hitch frames as CSV or JSON.
+ *
+ * Usage: -run=StatsAnalyzer -File=<capture> [-Out=<report>] [-Json] [-HitchMS=<game thread ms>] [-MaxHitchStats=<n>]
+ */
+UCLASS()
+class UStatsAnalyzerCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+	// Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) OVERRIDE;
+	// End UCommandlet Interface
+};
@@ -198,10 +198,10 @@ void FChunkManifestGenerator::AddPackageToChunkManifest(UPackage* Package, const
 
 	if (TargetChunk == INDEX_NONE || ExistingChunkIDs.Num() == 0)
 	{
+		// Try to determine if this package has been loaded as a result of loading a map package.
+		FString MapThisAssetWasLoadedWith;
 		if (bGenerateChunks)
 		{
-			// Try to determine if this package has been loaded as a result of loading a map package.
-			FString MapThisAssetWasLoadedWith;
 			if (!LastLoadedMapName.IsEmpty())
 			{
 				if (AssetsLoadedWithLastPackage.Contains(Package->GetFName()))
@@ -240,17 +240,25 @@ void FChunkManifestGenerator::AddPackageToChunkManifest(UPackage* Package, const
 		// Now actually add the package to the manifest
 		if (!ExistingChunkIDs.Contains(TargetChunk))
 		{
-			AddPackageToManifest(SandboxFilename, TargetChunk);
-			// Fill asset registry data with real IDs
-			auto PackageDataList = PackageToRegistryDataMap.Find(Package->GetFName());
-			if (PackageDataList != NULL)
-			{
-				for (auto DataIndex : *PackageDataList)
-				{
-					auto& AssetData = AssetRegistryData[DataIndex];
-					AssetData.ChunkIDs.AddUnique(TargetChunk);
-				}
-			}
+			AddPackageToChunk(Package->GetFName(), SandboxFilename, TargetChunk);
+			ManifestPackageMaps.FindOrAdd(SandboxFilename).Add(TargetChunk, MapThisAssetWasLoadedWith);
+		}
+	}
+}
+
+void FChunkManifestGenerator::AddPackageToChunk(FName PackageFName, const FString& SandboxFilename, int32 ChunkId)
+{
+	AddPackageToManifest(SandboxFilename, ChunkId);
+	ManifestPackageNames.Add(SandboxFilename, PackageFName);
+
+	// Fill asset registry data with real IDs
+	auto PackageDataList = PackageToRegistryDataMap.Find(PackageFName);
+	if (PackageDataList != NULL)
+	{
+		for (auto DataIndex : *PackageDataList)
+		{
+			auto& AssetData = AssetRegistryData[DataIndex];
+			AssetData.ChunkIDs.AddUnique(ChunkId);
 		}
 	}
 }
@@ -348,4 +356,98 @@ bool FChunkManifestGenerator::SaveAssetRegistry(const FString& SandboxPath)
 		FFileHelper::SaveArrayToFile(SerializedAssetRegistry, *PlatformSandboxPath);
 	}
 	return true;
-}
\ No newline at end of file
+}
+
+bool FChunkManifestGenerator::SaveChunkAssignments(const FString& Filename) const
+{
+	TAutoPtr<FArchive> File(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!File.IsValid())
+	{
+		UE_LOG(LogChunkManifestGenerator, Error, TEXT("Failed to open chunk assignments file %s"), *Filename);
+		return false;
+	}
+
+	for (int32 ChunkIndex = 0; ChunkIndex < ChunkManifests.Num(); ++ChunkIndex)
+	{
+		for (auto& SandboxFilename : *ChunkManifests[ChunkIndex])
+		{
+			FString PackageName = ManifestPackageNames.FindRef(SandboxFilename).ToString();
+			FString PackageFilename = SandboxFilename;
+			const TMap<int32, FString>* ChunkMaps = ManifestPackageMaps.Find(SandboxFilename);
+			FString MapName = ChunkMaps ? ChunkMaps->FindRef(ChunkIndex) : FString();
+			int32 ChunkID = ChunkIndex;
+			*File << PackageName;
+			*File << PackageFilename;
+			*File << MapName;
+			*File << ChunkID;
+		}
+	}
+
+	return File->Close();
+}
+
+bool FChunkManifestGenerator::LoadChunkAssignments(const FString& Filename)
+{
+	TAutoPtr<FArchive> File(IFileManager::Get().CreateFileReader(*Filename));
+	if (!File.IsValid())
+	{
+		UE_LOG(LogChunkManifestGenerator, Error, TEXT("Failed to open chunk assignments file %s"), *Filename);
+		return false;
+	}
+
+	TMap<FString, TArray<int32> > ChunkIDsAddedFromFile;
+
+	while (!File->AtEnd() && !File->IsError())
+	{
+		FString PackageName;
+		FString SandboxFilename;
+		FString MapName;
+		int32 ChunkID = INDEX_NONE;
+		*File << PackageName;
+		*File << SandboxFilename;
+		*File << MapName;
+		*File << ChunkID;
+
+		if (File->IsError() || ChunkID < 0)
+		{
+			continue;
+		}
+
+		TArray<int32> ExistingChunkIDs;
+		FindPackageInManifests(SandboxFilename, ExistingChunkIDs);
+
+		// chunks of this package that were assigned by the other process itself
+		TArray<int32>& ChunkIDsFromFile = ChunkIDsAddedFromFile.FindOrAdd(SandboxFilename);
+
+		if (ExistingChunkIDs.Num() == ChunkIDsFromFile.Num())
+		{
+			// no other process had the package, keep the decisions of the one that did
+			if (!ExistingChunkIDs.Contains(ChunkID))
+			{
+				AddPackageToChunk(FName(*PackageName), SandboxFilename, ChunkID);
+				ManifestPackageMaps.FindOrAdd(SandboxFilename).Add(ChunkID, MapName);
+				ChunkIDsFromFile.Add(ChunkID);
+			}
+		}
+		else if (FGameDelegates::Get().GetAssignStreamingChunkDelegate().IsBound())
+		{
+			// the other process decided without knowing the chunks the package is in already, ask again
+			int32 TargetChunk = INDEX_NONE;
+			auto& RegistryChunkIDs = RegistryChunkIDsMap.FindOrAdd(FName(*PackageName));
+			FGameDelegates::Get().GetAssignStreamingChunkDelegate().Execute(PackageName, MapName, RegistryChunkIDs, ExistingChunkIDs, TargetChunk);
+			if (TargetChunk != INDEX_NONE && !ExistingChunkIDs.Contains(TargetChunk))
+			{
+				AddPackageToChunk(FName(*PackageName), SandboxFilename, TargetChunk);
+				ManifestPackageMaps.FindOrAdd(SandboxFilename).Add(TargetChunk, MapName);
+			}
+		}
+		else if (!ExistingChunkIDs.Contains(ChunkID))
+		{
+			// without the delegate the chunk only depends on the package and the asset registry, so it is the same in every process
+			AddPackageToChunk(FName(*PackageName), SandboxFilename, ChunkID);
+			ManifestPackageMaps.FindOrAdd(SandboxFilename).Add(ChunkID, MapName);
+		}
+	}
+
+	return !File->IsError();
+}
@@ -27,6 +27,10 @@ class FChunkManifestGenerator
 	TArray<FAssetData> AssetRegistryData;
 	/** Maps packages to assets from the asset registry */
 	TMap<FName, TArray<int32> > PackageToRegistryDataMap;
+	/** Package name of every sandbox path added to a manifest */
+	TMap<FString, FName> ManifestPackageNames;
+	/** Map every sandbox path was loaded with when it was added to each of its chunks, empty if there was none */
+	TMap<FString, TMap<int32, FString> > ManifestPackageMaps;
 	/** Should the chunks be generated or only asset registry */
 	bool bGenerateChunks;
 
@@ -45,6 +49,15 @@ class FChunkManifestGenerator
 	 */
 	void AddPackageToManifest(const FString& PackageName, int32 ChunkId);
 
+	/**
+	 * Adds package to the specified chunk manifest and records the chunk in the asset registry data of its assets.
+	 *
+	 * @param PackageFName Name of the package to add
+	 * @param SandboxFilename Sandbox path of the package to add
+	 * @param ChunkId Id of the chunk to add the package to.
+	 */
+	void AddPackageToChunk(FName PackageFName, const FString& SandboxFilename, int32 ChunkId);
+
 	/**
 	 * Finds a package in any of the created manifests and fills a list of all chunks this asset was found in.
 	 *
@@ -120,4 +133,20 @@ public:
 	* Saves generated asset registry data for each platform.
 	*/
 	bool SaveAssetRegistry(const FString& SandboxPath);
+
+	/**
+	 * Saves the chunks every package added so far went to, so the packages added by another cook process can be merged in.
+	 *
+	 * @param Filename File to save the chunk assignments to
+	 */
+	bool SaveChunkAssignments(const FString& Filename) const;
+
+	/**
+	 * Adds all packages in a file saved by SaveChunkAssignments to the same chunks. Packages that are already in a
+	 * manifest are assigned by the AssignStreamingChunk delegate, as if this process had loaded them again with the map
+	 * the other process loaded them with, so a map dependent delegate splits them over chunks like a single process cook.
+	 *
+	 * @param Filename File to load the chunk assignments from
+	 */
+	bool LoadChunkAssignments(const FString& Filename);
 };
@@ -20,9 +20,13 @@
 #include "UnrealEdMessages.h"
 #include "GameDelegates.h"
 #include "ChunkManifestGenerator.h"
+#include "CookManifest.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogCookCommandlet, Log, All);
 
+/** A cluster of packages never grows beyond this fraction of a cook worker's share, so a few widely shared packages don't tie everything into one cluster */
+static const int32 CookWorkerClusterDivisor = 4;
+
 
 /** Helper to pass a recompile request to game thread */
 struct FRecompileRequest
@@ -80,6 +84,77 @@ static FString GetPackageFilename( UPackage* Package )
 	return Filename;
 }
 
+/** Adds a package to be spread over cook workers, returns its index or INDEX_NONE if it has no file to cook */
+static int32 AddPartitionPackage( FName PackageName, TArray<FName>& Packages, TArray<int64>& PackageSizes, TMap<FName, int32>& PackageIndices )
+{
+	const int32* ExistingIndex = PackageIndices.Find(PackageName);
+	if (ExistingIndex)
+	{
+		return *ExistingIndex;
+	}
+
+	int32 Index = INDEX_NONE;
+	FString Filename;
+	if (FPackageName::DoesPackageExist(PackageName.ToString(), NULL, &Filename))
+	{
+		Index = Packages.Add(PackageName);
+		PackageSizes.Add(FMath::Max<int64>(IFileManager::Get().FileSize(*Filename), 1));
+	}
+	PackageIndices.Add(PackageName, Index);
+	return Index;
+}
+
+/** Returns the package a cluster of packages is identified by */
+static int32 FindPackageCluster( TArray<int32>& ClusterParents, int32 Index )
+{
+	while (ClusterParents[Index] != Index)
+	{
+		ClusterParents[Index] = ClusterParents[ClusterParents[Index]];
+		Index = ClusterParents[Index];
+	}
+	return Index;
+}
+
+/** Sorts clusters of packages largest first */
+struct FCompareClusterSize
+{
+	const TArray<int64>& ClusterSizes;
+
+	FCompareClusterSize( const TArray<int64>& InClusterSizes )
+		: ClusterSizes(InClusterSizes)
+	{}
+
+	FORCEINLINE bool operator()( int32 A, int32 B ) const
+	{
+		return ClusterSizes[A] != ClusterSizes[B] ? ClusterSizes[A] > ClusterSizes[B] : A < B;
+	}
+};
+
+/** Returns a command line with all occurrences of a -Key=Value parameter removed */
+static FString RemoveCommandLineValue( const FString& CommandLine, const TCHAR* Key )
+{
+	FString Result = CommandLine;
+	const FString Parameter = FString(TEXT("-")) + Key;
+
+	int32 Start = Result.Find(Parameter);
+	while (Start != INDEX_NONE)
+	{
+		int32 End = Start + Parameter.Len();
+		bool bInQuotes = false;
+		while (End < Result.Len() && (bInQuotes || !FChar::IsWhitespace(Result[End])))
+		{
+			if (Result[End] == TEXT('"'))
+			{
+				bInQuotes = !bInQuotes;
+			}
+			End++;
+		}
+		Result = Result.Left(Start) + Result.Mid(End);
+		Start = Result.Find(Parameter);
+	}
+	return Result;
+}
+
 
 /* UCookCommandlet structors
  *****************************************************************************/
@@ -89,6 +164,7 @@ UCookCommandlet::UCookCommandlet( const class FPostConstructInitializeProperties
 {
 
 	LogToConsole = false;
+	CookWorkerIndex = INDEX_NONE;
 }
 
 
@@ -378,6 +454,9 @@ bool UCookCommandlet::CookOnTheFly( bool BindAnyPort, int32 Timeout, bool bForce
 	NetworkFileServer->Shutdown();
 	delete NetworkFileServer;
 
+	UPackage::WaitForAsyncFileWrites();
+	SaveCookManifests();
+
 	return true;
 }
 
@@ -391,64 +470,78 @@ FString UCookCommandlet::GetOutputDirectory( const FString& PlatformName ) const
 }
 
 
-bool UCookCommandlet::GetPackageTimestamp( const FString& InFilename, FDateTime& OutDateTime )
+bool UCookCommandlet::GetPackageCookKey( const FString& InFilename, const ITargetPlatform* Target, FSHAHash& OutCookKey )
 {
 	FPackageDependencyInfoModule& PDInfoModule = FModuleManager::LoadModuleChecked<FPackageDependencyInfoModule>("PackageDependencyInfo");
-	FDateTime DependentTime;
+	FSHAHash DependentHash;
 
-	if (PDInfoModule.DeterminePackageDependentTimeStamp(*InFilename, DependentTime) == true)
+	if (PDInfoModule.DeterminePackageDependentHash(*InFilename, DependentHash) == false)
 	{
-		OutDateTime = DependentTime;
-
-		return true;
+		return false;
 	}
 
-	return false;
+	// Everything besides the sources that changes the cooked bytes
+	const FString CookSettings = FString::Printf(TEXT("%s %s %d %d %d %d %d"), 
+		*Target->PlatformName(), *GEngineVersion.ToString(), GPackageFileUE4Version, GPackageFileLicenseeUE4Version,
+		bCompressed, bUnversioned, Target->HasEditorOnlyData());
+
+	FSHA1 HashState;
+	HashState.Update(DependentHash.Hash, sizeof(DependentHash.Hash));
+	HashState.UpdateWithString(*CookSettings, CookSettings.Len());
+	HashState.Final();
+	HashState.GetHash(OutCookKey.Hash);
+
+	return true;
 }
 
 bool UCookCommandlet::ShouldCook(const FString& InFileName)
 {
-	bool bDoCook = false;
-
-	FString PkgFile;
+	// If we are not iterative cooking, then cook the package
 	FString PkgFilename;
-	FDateTime DependentTimeStamp = FDateTime::MinValue();
-
-	if (bIterativeCooking && FPackageName::DoesPackageExist(InFileName, NULL, &PkgFile))
+	if (bIterativeCooking == false || FPackageName::DoesPackageExist(InFileName, NULL, &PkgFilename) == false)
 	{
-		PkgFilename = PkgFile;
-
-		if (GetPackageTimestamp(FPaths::GetBaseFilename(PkgFilename, false), DependentTimeStamp) == false)
-		{
-			UE_LOG(LogCookCommandlet, Display, TEXT("Failed to find depedency timestamp for: %s"), *PkgFilename);
-		}
+		return true;
 	}
 
+	const FString SourceName = FPaths::GetBaseFilename(PkgFilename, false);
+
 	// Use SandboxFile to do path conversion to properly handle sandbox paths (outside of standard paths in particular).
 	PkgFilename = SandboxFile->ConvertToAbsolutePathForExternalAppForWrite(*PkgFilename);
 
 	ITargetPlatformManagerModule& TPM = GetTargetPlatformManagerRef();
 	static const TArray<ITargetPlatform*>& Platforms =  TPM.GetActiveTargetPlatforms();
 
-	for (int32 Index = 0; Index < Platforms.Num() && !bDoCook; Index++)
+	for (int32 Index = 0; Index < Platforms.Num(); Index++)
 	{
 		ITargetPlatform* Target = Platforms[Index];
 		FString PlatFilename = PkgFilename.Replace(TEXT("[Platform]"), *Target->PlatformName());
 
-		// If we are not iterative cooking, then cook the package
-		bool bCookPackage = (bIterativeCooking == false);
-
-		if (bCookPackage == false)
+		// If the package wasn't cooked with the key it would be cooked with now, re-cook it
+		FCookManifest* CookManifest = GetCookManifest(Target);
+		FSHAHash CookKey;
+		if (CookManifest == NULL)
+		{
+			return true;
+		}
+		if (GetPackageCookKey(SourceName, Target, CookKey) == false)
+		{
+			UE_LOG(LogCookCommandlet, Display, TEXT("Failed to find dependency hash for: %s"), *SourceName);
+			return true;
+		}
+		if (CookManifest->IsUpToDate(PlatFilename, CookKey) == false)
 		{
-			// If the cooked package doesn't exist, or if the cooked is older than the dependent, re-cook it
-			FDateTime CookedTimeStamp = IFileManager::Get().GetTimeStamp(*PlatFilename);
-			int32 CookedTimespanSeconds = (CookedTimeStamp - DependentTimeStamp).GetTotalSeconds();
-			bCookPackage = (CookedTimeStamp == FDateTime::MinValue()) || (CookedTimespanSeconds < 0);
+			return true;
 		}
-		bDoCook |= bCookPackage;
 	}
 
-	return bDoCook;
+	// Up to date for all platforms, the package won't get to SaveCookedPackage
+	for (int32 Index = 0; Index < Platforms.Num(); Index++)
+	{
+		ITargetPlatform* Target = Platforms[Index];
+		GetCookManifest(Target)->MarkUpToDate(PkgFilename.Replace(TEXT("[Platform]"), *Target->PlatformName()));
+	}
+
+	return false;
 }
 
 bool UCookCommandlet::SaveCookedPackage( UPackage* Package, uint32 SaveFlags, bool& bOutWasUpToDate )
@@ -459,22 +552,13 @@ bool UCookCommandlet::SaveCookedPackage( UPackage* Package, uint32 SaveFlags, bo
 
 	if (Filename.Len())
 	{
-		FString PkgFilename;
-		FDateTime DependentTimeStamp = FDateTime::MinValue();
-
-		// We always want to use the dependent time stamp when saving a cooked package...
-		// Iterative or not!
+		FString SourceName;
 		FString PkgFile;
 		FString Name = Package->GetPathName();
 
 		if (bIterativeCooking && FPackageName::DoesPackageExist(Name, NULL, &PkgFile))
 		{
-			PkgFilename = PkgFile;
-
-			if (GetPackageTimestamp(FPaths::GetBaseFilename(PkgFilename, false), DependentTimeStamp) == false)
-			{
-				UE_LOG(LogCookCommandlet, Display, TEXT("Failed to find depedency timestamp for: %s"), *PkgFilename);
-			}
+			SourceName = FPaths::GetBaseFilename(PkgFile, false);
 		}
 
 		// Use SandboxFile to do path conversion to properly handle sandbox paths (outside of standard paths in particular).
@@ -498,17 +582,23 @@ bool UCookCommandlet::SaveCookedPackage( UPackage* Package, uint32 SaveFlags, bo
 			ITargetPlatform* Target = Platforms[Index];
 			FString PlatFilename = Filename.Replace(TEXT("[Platform]"), *Target->PlatformName());
 
-			// If we are not iterative cooking, then cook the package
-			bool bCookPackage = (bIterativeCooking == false);
+			// If we are iterative cooking, only cook the package if it wasn't cooked with the key it would be cooked with now
+			FCookManifest* CookManifest = GetCookManifest(Target);
+			FSHAHash CookKey;
+			bool bHasCookKey = false;
 
-			if (bCookPackage == false)
+			if (CookManifest && SourceName.Len())
 			{
-				// If the cooked package doesn't exist, or if the cooked is older than the dependent, re-cook it
-				FDateTime CookedTimeStamp = IFileManager::Get().GetTimeStamp(*PlatFilename);
-				int32 CookedTimespanSeconds = (CookedTimeStamp - DependentTimeStamp).GetTotalSeconds();
-				bCookPackage = (CookedTimeStamp == FDateTime::MinValue()) || (CookedTimespanSeconds < 0);
+				bHasCookKey = GetPackageCookKey(SourceName, Target, CookKey);
+				if (bHasCookKey == false)
+				{
+					UE_LOG(LogCookCommandlet, Display, TEXT("Failed to find dependency hash for: %s"), *SourceName);
+				}
 			}
 
+			const bool bUpToDate = bHasCookKey && CookManifest->IsUpToDate(PlatFilename, CookKey);
+			bool bCookPackage = !bUpToDate;
+
 			// don't save Editor resources from the Engine if the target doesn't have editoronly data
 			if (bSkipEditorContent && Name.StartsWith(TEXT("/Engine/Editor")) && !Target->HasEditorOnlyData())
 			{
@@ -554,13 +644,25 @@ bool UCookCommandlet::SaveCookedPackage( UPackage* Package, uint32 SaveFlags, bo
 					World->PersistentLevel->OwningWorld = World;
 				}
 
-				bSavedCorrectly &= GEditor->SavePackage(Package, World, Flags, *PlatFilename, GError, NULL, bSwap, false, SaveFlags, Target, FDateTime::MinValue());
+				const double SaveStartTime = FPlatformTime::Seconds();
+				const bool bSaved = GEditor->SavePackage(Package, World, Flags, *PlatFilename, GError, NULL, bSwap, false, SaveFlags, Target, FDateTime::MinValue());
+				bSavedCorrectly &= bSaved;
 				bOutWasUpToDate = false;
+
+				if (bSaved && bHasCookKey)
+				{
+					CookManifest->MarkCooked(PlatFilename, CookKey, FPlatformTime::Seconds() - SaveStartTime);
+				}
 			}
 			else
 			{
 				UE_LOG(LogCookCommandlet, Display, TEXT("Up to date: %s"), *PlatFilename);
 
+				if (bUpToDate)
+				{
+					CookManifest->MarkUpToDate(PlatFilename);
+				}
+
 				bOutWasUpToDate = true;
 			}
 		}
@@ -599,6 +701,20 @@ int32 UCookCommandlet::Main(const FString& CmdLineParams)
 	bIterativeCooking = Switches.Contains(TEXT("ITERATE"));
 	bSkipEditorContent = Switches.Contains(TEXT("SKIPEDITORCONTENT")); // This won't save out any packages in Engine/COntent/Editor*
 
+	// Split the cook over several processes, or cook the share of a process that does
+	int32 NumCookProcesses = 1;
+	FParse::Value(*Params, TEXT("CookProcesses="), NumCookProcesses);
+
+	FString CookWorkerPackagesFilename;
+	if (FParse::Value(*Params, TEXT("CookWorkerPackages="), CookWorkerPackagesFilename))
+	{
+		if (!FParse::Value(*Params, TEXT("CookWorkerIndex="), CookWorkerIndex) || !LoadCookWorkerPackages(CookWorkerPackagesFilename))
+		{
+			UE_LOG(LogCookCommandlet, Error, TEXT("Failed to load the packages to cook from %s"), *CookWorkerPackagesFilename);
+			return -1;
+		}
+	}
+
 	if (bLeakTest)
 	{
 		for (FObjectIterator It; It; ++It)
@@ -626,7 +742,16 @@ int32 UCookCommandlet::Main(const FString& CmdLineParams)
 	// Use SandboxFile to do path conversion to properly handle sandbox paths (outside of standard paths in particular).
 	SandboxFile->Initialize(&FPlatformFileManager::Get().GetPlatformFile(), *FString::Printf(TEXT("-sandbox=%s"), *OutputDirectory));
 
-	CleanSandbox(Platforms);
+	if (bIterativeCooking)
+	{
+		LoadCookManifests(Platforms);
+	}
+
+	// Workers of a cook split over several processes find the sandbox cleaned by the process that started them
+	if (CookWorkerIndex == INDEX_NONE)
+	{
+		CleanSandbox(Platforms);
+	}
 
 	// allow the game to fill out the asset registry, as well as get a list of objects to always cook
 	TArray<FString> FilesInPath;
@@ -659,6 +784,13 @@ int32 UCookCommandlet::Main(const FString& CmdLineParams)
 			return -1;
 		}
 	}
+	else if (NumCookProcesses > 1 && CookWorkerIndex == INDEX_NONE)
+	{
+		if (!CookInWorkers(Platforms, FilesInPath, NumCookProcesses))
+		{
+			return -1;
+		}
+	}
 	else
 	{
 		Cook(Platforms, FilesInPath);
@@ -697,18 +829,17 @@ void UCookCommandlet::CleanSandbox(const TArray<ITargetPlatform*>& Platforms)
 
 		if (bIterativeCooking == false)
 		{
-			// for now we are going to wipe the cooked directory
+			// for now we are going to wipe the cooked directory, along with the record of what was in it
 			for (int32 Index = 0; Index < Platforms.Num(); Index++)
 			{
 				ITargetPlatform* Target = Platforms[Index];
 				FString SandboxDirectory = GetOutputDirectory(Target->PlatformName());
 				IFileManager::Get().DeleteDirectory(*SandboxDirectory, false, true);
+				IFileManager::Get().Delete(*GetCookManifestFilename(Target->PlatformName()));
 			}
 		}
 		else
 		{
-			FPackageDependencyInfoModule& PDInfoModule = FModuleManager::LoadModuleChecked<FPackageDependencyInfoModule>("PackageDependencyInfo");
-			
 			// list of directories to skip
 			TArray<FString> DirectoriesToSkip;
 			TArray<FString> DirectoriesToNotRecurse;
@@ -718,6 +849,7 @@ void UCookCommandlet::CleanSandbox(const TArray<ITargetPlatform*>& Platforms)
 			{
 				ITargetPlatform* Target = Platforms[Index];
 				FString SandboxDirectory = GetOutputDirectory(Target->PlatformName());
+				FCookManifest* CookManifest = GetCookManifest(Target);
 
 				// use the timestamp grabbing visitor
 				IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
@@ -728,19 +860,19 @@ void UCookCommandlet::CleanSandbox(const TArray<ITargetPlatform*>& Platforms)
 				for (TMap<FString, FDateTime>::TIterator TimestampIt(Visitor.FileTimes); TimestampIt; ++TimestampIt)
 				{
 					FString CookedFilename = TimestampIt.Key();
-					FDateTime CookedTimestamp = TimestampIt.Value();
 					FString StandardCookedFilename = CookedFilename.Replace(*SandboxDirectory, *(FPaths::GetRelativePathToRoot()));
-					FDateTime DependentTimestamp;
+					FSHAHash CookKey;
 
-					if (PDInfoModule.DeterminePackageDependentTimeStamp(*(FPaths::GetBaseFilename(StandardCookedFilename, false)), DependentTimestamp) == true)
+					if (FPackageName::IsPackageExtension(*FPaths::GetExtension(CookedFilename, true)) &&
+						GetPackageCookKey(FPaths::GetBaseFilename(StandardCookedFilename, false), Target, CookKey) == true)
 					{
-						double Diff = (CookedTimestamp - DependentTimestamp).GetTotalSeconds();
-
-						if (Diff < 0.0)
+						// Touched but unmodified sources keep their key, only actual changes make the cooked file out of date
+						if (CookManifest->IsUpToDate(CookedFilename, CookKey) == false)
 						{
 							UE_LOG(LogCookCommandlet, Display, TEXT("Deleting out of date cooked file: %s"), *CookedFilename);
 
 							IFileManager::Get().Delete(*CookedFilename);
+							CookManifest->Remove(CookedFilename);
 						}
 					}
 				}
@@ -754,6 +886,205 @@ void UCookCommandlet::CleanSandbox(const TArray<ITargetPlatform*>& Platforms)
 	UE_LOG(LogCookCommandlet, Display, TEXT("Sandbox cleanup took %5.3f seconds"), SandboxCleanTime);
 }
 
+FString UCookCommandlet::GetCookManifestFilename(const FString& PlatformName) const
+{
+	// Kept next to, not in, the sandbox so it never gets staged with the cooked content
+	return FPaths::GameIntermediateDir() / TEXT("Cook") / PlatformName / TEXT("CookManifest.bin");
+}
+
+void UCookCommandlet::LoadCookManifests(const TArray<ITargetPlatform*>& Platforms)
+{
+	for (int32 Index = 0; Index < Platforms.Num(); Index++)
+	{
+		const FString PlatformName = Platforms[Index]->PlatformName();
+		TSharedPtr<FCookManifest> CookManifest;
+
+		if (CookWorkerIndex == INDEX_NONE)
+		{
+			CookManifest = MakeShareable(new FCookManifest(GetCookManifestFilename(PlatformName)));
+			CookManifest->Load();
+		}
+		else
+		{
+			// Workers start from the shared manifest and save what they cooked next to it, to be merged back by the process that started them
+			CookManifest = MakeShareable(new FCookManifest(GetCookWorkerDirectory() / FString::Printf(TEXT("CookManifest-%s-%d.bin"), *PlatformName, CookWorkerIndex)));
+			CookManifest->Load(*GetCookManifestFilename(PlatformName));
+		}
+
+		CookManifests.Add(PlatformName, CookManifest);
+	}
+}
+
+void UCookCommandlet::SaveCookManifests()
+{
+	for (TMap<FString, TSharedPtr<FCookManifest> >::TIterator ManifestIt(CookManifests); ManifestIt; ++ManifestIt)
+	{
+		const FCookManifest& CookManifest = *ManifestIt.Value();
+		CookManifest.Save();
+
+		UE_LOG(LogCookCommandlet, Display, TEXT("Iterative cook for %s: %d packages up to date, %d packages cooked, saved %5.2fs of cooking"),
+			*ManifestIt.Key(), CookManifest.GetNumUpToDate(), CookManifest.GetNumCooked(), CookManifest.GetCookTimeSaved());
+	}
+}
+
+FCookManifest* UCookCommandlet::GetCookManifest(const ITargetPlatform* Target) const
+{
+	const TSharedPtr<FCookManifest>* CookManifest = CookManifests.Find(Target->PlatformName());
+	return CookManifest ? CookManifest->Get() : NULL;
+}
+
+FString UCookCommandlet::GetCookWorkerDirectory() const
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::GameIntermediateDir() / TEXT("Cook") / TEXT("Workers"));
+}
+
+void UCookCommandlet::PartitionPackages(const TArray<FString>& FilesInPath, int32 NumWorkers, TMap<FName, int32>& OutPackageWorkers, TArray<int64>& OutWorkerSizes) const
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	// Gather the packages to cook and everything they depend on, as far as the asset registry knows
+	TArray<FName> Packages;
+	TArray<int64> PackageSizes;
+	TMap<FName, int32> PackageIndices;
+	TArray<FIntPoint> Dependencies;
+
+	for (int32 FileIndex = 0; FileIndex < FilesInPath.Num(); FileIndex++)
+	{
+		AddPartitionPackage(FName(*FilesInPath[FileIndex]), Packages, PackageSizes, PackageIndices);
+	}
+
+	for (int32 PackageIndex = 0; PackageIndex < Packages.Num(); PackageIndex++)
+	{
+		TArray<FName> PackageDependencies;
+		AssetRegistry.GetDependencies(Packages[PackageIndex], PackageDependencies);
+
+		for (int32 DependencyIndex = 0; DependencyIndex < PackageDependencies.Num(); DependencyIndex++)
+		{
+			const int32 Dependency = AddPartitionPackage(PackageDependencies[DependencyIndex], Packages, PackageSizes, PackageIndices);
+			if (Dependency != INDEX_NONE && Dependency != PackageIndex)
+			{
+				Dependencies.Add(FIntPoint(PackageIndex, Dependency));
+			}
+		}
+	}
+
+	// Join packages that depend on each other into clusters, each loaded by a single worker
+	TArray<int32> ClusterParents;
+	TArray<int64> ClusterSizes = PackageSizes;
+	int64 TotalSize = 0;
+	int64 MaxClusterSize = 0;
+
+	ClusterParents.AddUninitialized(Packages.Num());
+	for (int32 PackageIndex = 0; PackageIndex < Packages.Num(); PackageIndex++)
+	{
+		ClusterParents[PackageIndex] = PackageIndex;
+		TotalSize += PackageSizes[PackageIndex];
+		MaxClusterSize = FMath::Max(MaxClusterSize, PackageSizes[PackageIndex]);
+	}
+	MaxClusterSize = FMath::Max(MaxClusterSize, TotalSize / (NumWorkers * CookWorkerClusterDivisor));
+
+	for (int32 DependencyIndex = 0; DependencyIndex < Dependencies.Num(); DependencyIndex++)
+	{
+		const int32 ClusterA = FindPackageCluster(ClusterParents, Dependencies[DependencyIndex].X);
+		const int32 ClusterB = FindPackageCluster(ClusterParents, Dependencies[DependencyIndex].Y);
+
+		if (ClusterA != ClusterB && ClusterSizes[ClusterA] + ClusterSizes[ClusterB] <= MaxClusterSize)
+		{
+			ClusterParents[ClusterB] = ClusterA;
+			ClusterSizes[ClusterA] += ClusterSizes[ClusterB];
+		}
+	}
+
+	// Collect the packages of each cluster, in the order they were found so packages to cook come before their dependencies
+	TArray<int32> Clusters;
+	TArray<int32> ClusterSlots;
+	TArray<TArray<int32> > ClusterPackages;
+
+	ClusterSlots.Init(INDEX_NONE, Packages.Num());
+	for (int32 PackageIndex = 0; PackageIndex < Packages.Num(); PackageIndex++)
+	{
+		const int32 Cluster = FindPackageCluster(ClusterParents, PackageIndex);
+		if (ClusterSlots[Cluster] == INDEX_NONE)
+		{
+			ClusterSlots[Cluster] = Clusters.Add(Cluster);
+			new(ClusterPackages) TArray<int32>();
+		}
+		ClusterPackages[ClusterSlots[Cluster]].Add(PackageIndex);
+	}
+
+	// Hand out the largest clusters first, each to the worker with the least to cook so far
+	Clusters.Sort(FCompareClusterSize(ClusterSizes));
+
+	OutPackageWorkers.Empty(Packages.Num());
+	OutWorkerSizes.Init(0, NumWorkers);
+
+	for (int32 ClusterIndex = 0; ClusterIndex < Clusters.Num(); ClusterIndex++)
+	{
+		const int32 Cluster = Clusters[ClusterIndex];
+
+		int32 Worker = 0;
+		for (int32 WorkerIndex = 1; WorkerIndex < NumWorkers; WorkerIndex++)
+		{
+			if (OutWorkerSizes[WorkerIndex] < OutWorkerSizes[Worker])
+			{
+				Worker = WorkerIndex;
+			}
+		}
+		OutWorkerSizes[Worker] += ClusterSizes[Cluster];
+
+		const TArray<int32>& PackagesInCluster = ClusterPackages[ClusterSlots[Cluster]];
+		for (int32 PackageIndex = 0; PackageIndex < PackagesInCluster.Num(); PackageIndex++)
+		{
+			OutPackageWorkers.Add(Packages[PackagesInCluster[PackageIndex]], Worker);
+		}
+	}
+
+	UE_LOG(LogCookCommandlet, Display, TEXT("Split %d packages in %d clusters over %d workers"), Packages.Num(), Clusters.Num(), NumWorkers);
+}
+
+bool UCookCommandlet::LoadCookWorkerPackages(const FString& Filename)
+{
+	FString PackageList;
+	if (!FFileHelper::LoadFileToString(PackageList, *Filename))
+	{
+		return false;
+	}
+
+	TArray<FString> Lines;
+	PackageList.ParseIntoArray(&Lines, TEXT("\n"), true);
+
+	CookWorkerPackages.Empty(Lines.Num());
+	for (int32 LineIndex = 0; LineIndex < Lines.Num(); LineIndex++)
+	{
+		FString PackageName;
+		FString WorkerIndex;
+		if (Lines[LineIndex].Trim().TrimTrailing().Split(TEXT("\t"), &PackageName, &WorkerIndex))
+		{
+			CookWorkerPackages.Add(FName(*PackageName), FCString::Atoi(*WorkerIndex));
+		}
+	}
+
+	// A worker may be handed an empty list, it then only cooks what it is left with by the process that started it
+	return true;
+}
+
+bool UCookCommandlet::IsSavedByThisProcess(UPackage* Package) const
+{
+	if (CookWorkerIndex == INDEX_NONE && CookWorkerPackages.Num() == 0)
+	{
+		return true;
+	}
+
+	const int32* Worker = CookWorkerPackages.Find(Package->GetFName());
+	if (Worker)
+	{
+		return *Worker == CookWorkerIndex;
+	}
+
+	// Packages nobody knew would be loaded are left for the process that started the workers to cook once they are done
+	return CookWorkerIndex == INDEX_NONE;
+}
+
 void UCookCommandlet::GenerateAssetRegistry(const TArray<ITargetPlatform*>& Platforms)
 {
 	// load the interface
@@ -1030,6 +1361,75 @@ void UCookCommandlet::GenerateLongPackageNames(TArray<FString>& FilesInPath)
 }
 
 bool UCookCommandlet::Cook(const TArray<ITargetPlatform*>& Platforms, TArray<FString>& FilesInPath)
+{
+	FCoreDelegates::PackageCreatedForLoad.AddUObject(this, &UCookCommandlet::MaybeMarkPackageAsAlreadyLoaded);
+	
+	if (CookWorkerIndex == INDEX_NONE)
+	{
+		SaveGlobalShaderMapFiles(Platforms);
+
+		CollectFilesToCook(FilesInPath);
+		if (FilesInPath.Num() == 0)
+		{
+			UE_LOG(LogCookCommandlet, Warning, TEXT("No files found."));
+		}
+
+		GenerateLongPackageNames(FilesInPath);
+	}
+	else
+	{
+		// Workers cook the packages they were handed, the process that started them takes care of everything shared
+		FilesInPath.Empty(CookWorkerPackages.Num());
+		for (TMap<FName, int32>::TConstIterator PackageIt(CookWorkerPackages); PackageIt; ++PackageIt)
+		{
+			if (PackageIt.Value() == CookWorkerIndex)
+			{
+				FilesInPath.Add(PackageIt.Key().ToString());
+			}
+		}
+	}
+
+	FChunkManifestGenerator ManifestGenerator(Platforms);
+	if (CookWorkerIndex == INDEX_NONE)
+	{
+		// Always clean manifest directories so that there's no stale data
+		ManifestGenerator.CleanManifestDirectories();
+	}
+	ManifestGenerator.Initialize(bGenerateStreamingInstallManifests);
+
+	TArray<FString> UnassignedPackages;
+	CookFiles(FilesInPath, ManifestGenerator, UnassignedPackages);
+
+	IConsoleManager::Get().ProcessUserConsoleInput(TEXT("Tex.DerivedDataTimings"), *GWarn, NULL );
+	UPackage::WaitForAsyncFileWrites();
+	SaveCookManifests();
+
+	GetDerivedDataCacheRef().WaitForQuiescence(true);
+
+	if (CookWorkerIndex != INDEX_NONE)
+	{
+		// Hand what was generated back to the process that started this worker
+		const FString WorkerDirectory = GetCookWorkerDirectory();
+		ManifestGenerator.SaveChunkAssignments(WorkerDirectory / FString::Printf(TEXT("ChunkAssignments-%d.bin"), CookWorkerIndex));
+		FFileHelper::SaveStringToFile(FString::Join(UnassignedPackages, LINE_TERMINATOR), *(WorkerDirectory / FString::Printf(TEXT("UnassignedPackages-%d.txt"), CookWorkerIndex)));
+		return true;
+	}
+
+	if (bGenerateStreamingInstallManifests)
+	{
+		ManifestGenerator.SaveManifests();
+	}
+	{
+		// Save modified asset registry with all streaming chunk info generated during cook
+		FString RegistryFilename = FPaths::GameDir() / TEXT("AssetRegistry.bin");
+		FString SandboxRegistryFilename = SandboxFile->ConvertToAbsolutePathForExternalAppForWrite(*RegistryFilename);
+		ManifestGenerator.SaveAssetRegistry(SandboxRegistryFilename);
+	}
+
+	return true;
+}
+
+void UCookCommandlet::CookFiles(const TArray<FString>& FilesInPath, FChunkManifestGenerator& ManifestGenerator, TArray<FString>& OutUnassignedPackages)
 {
 	// Subsets for parallel processing
 	uint32 SubsetMod = 0;
@@ -1038,18 +1438,6 @@ bool UCookCommandlet::Cook(const TArray<ITargetPlatform*>& Platforms, TArray<FSt
 	FParse::Value(*Params, TEXT("SubsetTarget="), SubsetTarget);
 	bool bDoSubset = SubsetMod > 0 && SubsetTarget < SubsetMod;
 
-	FCoreDelegates::PackageCreatedForLoad.AddUObject(this, &UCookCommandlet::MaybeMarkPackageAsAlreadyLoaded);
-	
-	SaveGlobalShaderMapFiles(Platforms);
-
-	CollectFilesToCook(FilesInPath);
-	if (FilesInPath.Num() == 0)
-	{
-		UE_LOG(LogCookCommandlet, Warning, TEXT("No files found."));
-	}
-
-	GenerateLongPackageNames(FilesInPath);
-	
 	const int32 GCInterval = bLeakTest ? 1: 500;
 	int32 NumProcessedSinceLastGC = GCInterval;
 	bool bLastLoadWasMap = false;
@@ -1057,11 +1445,6 @@ bool UCookCommandlet::Cook(const TArray<ITargetPlatform*>& Platforms, TArray<FSt
 	TSet<FString> CookedPackages;
 	FString LastLoadedMapName;
 
-	FChunkManifestGenerator ManifestGenerator(Platforms);
-	// Always clean manifest directories so that there's no stale data
-	ManifestGenerator.CleanManifestDirectories();
-	ManifestGenerator.Initialize(bGenerateStreamingInstallManifests);
-
 	for( int32 FileIndex = 0; ; FileIndex++ )
 	{
 		if (NumProcessedSinceLastGC >= GCInterval || bLastLoadWasMap || FileIndex < 0 || FileIndex >= FilesInPath.Num())
@@ -1095,7 +1478,15 @@ bool UCookCommandlet::Cook(const TArray<ITargetPlatform*>& Platforms, TArray<FSt
 
 					bool bWasUpToDate = false;
 
-					SaveCookedPackage(Pkg, SAVE_KeepGUID | SAVE_Async | (bUnversioned ? SAVE_Unversioned : 0), bWasUpToDate);
+					if (IsSavedByThisProcess(Pkg))
+					{
+						SaveCookedPackage(Pkg, SAVE_KeepGUID | SAVE_Async | (bUnversioned ? SAVE_Unversioned : 0), bWasUpToDate);
+					}
+					else if (!Filename.IsEmpty() && !CookWorkerPackages.Contains(Pkg->GetFName()))
+					{
+						// script and transient packages have no file to cook
+						OutUnassignedPackages.AddUnique(Pkg->GetName());
+					}
 
 					PackagesToNotReload.Add(Pkg->GetName());
 					Pkg->PackageFlags |= PKG_ReloadingForCooker;
@@ -1210,10 +1601,190 @@ bool UCookCommandlet::Cook(const TArray<ITargetPlatform*>& Platforms, TArray<FSt
 			}
 		}
 	}
+}
+
+bool UCookCommandlet::CookInWorkers(const TArray<ITargetPlatform*>& Platforms, TArray<FString>& FilesInPath, int32 NumWorkers)
+{
+	const double CookStartTime = FPlatformTime::Seconds();
+
+	FCoreDelegates::PackageCreatedForLoad.AddUObject(this, &UCookCommandlet::MaybeMarkPackageAsAlreadyLoaded);
+
+	// Global shaders are shared by all packages, save them once before the workers start
+	SaveGlobalShaderMapFiles(Platforms);
+
+	CollectFilesToCook(FilesInPath);
+	if (FilesInPath.Num() == 0)
+	{
+		UE_LOG(LogCookCommandlet, Warning, TEXT("No files found."));
+	}
+
+	GenerateLongPackageNames(FilesInPath);
+
+	// Workers start from the manifests as cleaned by CleanSandbox
+	for (TMap<FString, TSharedPtr<FCookManifest> >::TIterator ManifestIt(CookManifests); ManifestIt; ++ManifestIt)
+	{
+		ManifestIt.Value()->Save();
+	}
+
+	TArray<int64> WorkerSizes;
+	PartitionPackages(FilesInPath, NumWorkers, CookWorkerPackages, WorkerSizes);
+	if (CookWorkerPackages.Num() == 0)
+	{
+		UE_LOG(LogCookCommandlet, Display, TEXT("Nothing to cook, not starting any cook workers"));
+		NumWorkers = 0;
+	}
+
+	const FString WorkerDirectory = GetCookWorkerDirectory();
+	IFileManager::Get().DeleteDirectory(*WorkerDirectory, false, true);
+	IFileManager::Get().MakeDirectory(*WorkerDirectory, true);
+
+	TArray<int32> WorkerNumPackages;
+	WorkerNumPackages.Init(0, NumWorkers);
+
+	FString PackageList;
+	for (TMap<FName, int32>::TConstIterator PackageIt(CookWorkerPackages); PackageIt; ++PackageIt)
+	{
+		PackageList += FString::Printf(TEXT("%s\t%d") LINE_TERMINATOR, *PackageIt.Key().ToString(), PackageIt.Value());
+		WorkerNumPackages[PackageIt.Value()]++;
+	}
+
+	const FString PackageListFilename = WorkerDirectory / TEXT("Packages.txt");
+	if (!FFileHelper::SaveStringToFile(PackageList, *PackageListFilename))
+	{
+		UE_LOG(LogCookCommandlet, Error, TEXT("Failed to write the packages to cook to %s"), *PackageListFilename);
+		return false;
+	}
+
+	// Workers run with the same command line, minus the split and with their own logs. The engine has already removed the
+	// game name or project file from the command line, so it has to be passed on explicitly.
+	FString WorkerCommandLine = RemoveCommandLineValue(RemoveCommandLineValue(FCommandLine::Get(), TEXT("CookProcesses=")), TEXT("abslog="));
+	if (FPaths::IsProjectFilePathSet())
+	{
+		// Put quotes around the file since it may contain spaces.
+		WorkerCommandLine = FString::Printf(TEXT("\"%s\" %s"), *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()), *WorkerCommandLine);
+	}
+	else
+	{
+		WorkerCommandLine = FString::Printf(TEXT("%s %s"), GGameName, *WorkerCommandLine);
+	}
+	const FString ExecutableName = FPlatformProcess::ExecutableName(false);
+
+	TArray<FProcHandle> WorkerHandles;
+	TArray<double> WorkerEndTimes;
+	const double WorkerStartTime = FPlatformTime::Seconds();
+	bool bWorkersSucceeded = true;
+
+	for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; WorkerIndex++)
+	{
+		const FString WorkerParams = FString::Printf(TEXT("%s -CookWorkerPackages=\"%s\" -CookWorkerIndex=%d -abslog=\"%s\""),
+			*WorkerCommandLine, *PackageListFilename, WorkerIndex, *(WorkerDirectory / FString::Printf(TEXT("CookWorker-%d.log"), WorkerIndex)));
+
+		FProcHandle WorkerHandle = FPlatformProcess::CreateProc(*ExecutableName, *WorkerParams, true, false, false, NULL, 0, NULL, NULL);
+		if (!WorkerHandle.IsValid())
+		{
+			UE_LOG(LogCookCommandlet, Error, TEXT("Failed to start cook worker %d: %s %s"), WorkerIndex, *ExecutableName, *WorkerParams);
+			bWorkersSucceeded = false;
+		}
+
+		WorkerHandles.Add(WorkerHandle);
+		WorkerEndTimes.Add(WorkerStartTime);
+	}
+
+	if (NumWorkers > 0)
+	{
+		UE_LOG(LogCookCommandlet, Display, TEXT("Started %d cook workers, logs are in %s"), NumWorkers, *WorkerDirectory);
+	}
+
+	for (bool bWorkersRunning = true; bWorkersRunning; )
+	{
+		bWorkersRunning = false;
+		for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; WorkerIndex++)
+		{
+			FProcHandle& WorkerHandle = WorkerHandles[WorkerIndex];
+			if (!WorkerHandle.IsValid())
+			{
+				continue;
+			}
+
+			if (FPlatformProcess::IsProcRunning(WorkerHandle))
+			{
+				bWorkersRunning = true;
+				continue;
+			}
+
+			WorkerEndTimes[WorkerIndex] = FPlatformTime::Seconds();
+
+			int32 ReturnCode = 0;
+			if (!FPlatformProcess::GetProcReturnCode(WorkerHandle, &ReturnCode) || ReturnCode != 0)
+			{
+				UE_LOG(LogCookCommandlet, Error, TEXT("Cook worker %d failed with return code %d"), WorkerIndex, ReturnCode);
+				bWorkersSucceeded = false;
+			}
+			WorkerHandle.Close();
+		}
+
+		if (bWorkersRunning)
+		{
+			FPlatformProcess::Sleep(0.5f);
+		}
+	}
+
+	const double WorkerTime = FPlatformTime::Seconds() - WorkerStartTime;
+
+	// Merge what the workers generated
+	FChunkManifestGenerator ManifestGenerator(Platforms);
+	ManifestGenerator.CleanManifestDirectories();
+	ManifestGenerator.Initialize(bGenerateStreamingInstallManifests);
+
+	TArray<FString> UnassignedPackages;
+	int32 NumMergedPackages = 0;
+
+	for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; WorkerIndex++)
+	{
+		ManifestGenerator.LoadChunkAssignments(WorkerDirectory / FString::Printf(TEXT("ChunkAssignments-%d.bin"), WorkerIndex));
+
+		for (int32 PlatformIndex = 0; PlatformIndex < Platforms.Num(); PlatformIndex++)
+		{
+			FCookManifest* CookManifest = GetCookManifest(Platforms[PlatformIndex]);
+			if (CookManifest)
+			{
+				FCookManifest WorkerManifest(WorkerDirectory / FString::Printf(TEXT("CookManifest-%s-%d.bin"), *Platforms[PlatformIndex]->PlatformName(), WorkerIndex));
+				WorkerManifest.Load();
+				NumMergedPackages += CookManifest->Merge(WorkerManifest);
+			}
+		}
+
+		FString WorkerUnassignedPackages;
+		if (FFileHelper::LoadFileToString(WorkerUnassignedPackages, *(WorkerDirectory / FString::Printf(TEXT("UnassignedPackages-%d.txt"), WorkerIndex))))
+		{
+			TArray<FString> Lines;
+			WorkerUnassignedPackages.ParseIntoArray(&Lines, LINE_TERMINATOR, true);
+			for (int32 LineIndex = 0; LineIndex < Lines.Num(); LineIndex++)
+			{
+				UnassignedPackages.AddUnique(Lines[LineIndex]);
+			}
+		}
+	}
+
+	// Packages the workers loaded without knowing who saves them are cooked here, now nobody else writes to the sandbox
+	if (UnassignedPackages.Num())
+	{
+		UE_LOG(LogCookCommandlet, Display, TEXT("Cooking %d packages the asset registry didn't list as dependencies"), UnassignedPackages.Num());
+		TArray<FString> UnusedUnassignedPackages;
+		CookFiles(UnassignedPackages, ManifestGenerator, UnusedUnassignedPackages);
+	}
 
-	IConsoleManager::Get().ProcessUserConsoleInput(TEXT("Tex.DerivedDataTimings"), *GWarn, NULL );
 	UPackage::WaitForAsyncFileWrites();
 
+	for (TMap<FString, TSharedPtr<FCookManifest> >::TIterator ManifestIt(CookManifests); ManifestIt; ++ManifestIt)
+	{
+		ManifestIt.Value()->Save();
+	}
+	if (CookManifests.Num())
+	{
+		UE_LOG(LogCookCommandlet, Display, TEXT("Merged %d packages cooked by the workers into the cook manifests"), NumMergedPackages);
+	}
+
 	GetDerivedDataCacheRef().WaitForQuiescence(true);
 
 	if (bGenerateStreamingInstallManifests)
@@ -1221,13 +1792,28 @@ bool UCookCommandlet::Cook(const TArray<ITargetPlatform*>& Platforms, TArray<FSt
 		ManifestGenerator.SaveManifests();
 	}
 	{
-		// Save modified asset registry with all streaming chunk info generated during cook
+		// Save modified asset registry with all streaming chunk info generated by the workers
 		FString RegistryFilename = FPaths::GameDir() / TEXT("AssetRegistry.bin");
 		FString SandboxRegistryFilename = SandboxFile->ConvertToAbsolutePathForExternalAppForWrite(*RegistryFilename);
 		ManifestGenerator.SaveAssetRegistry(SandboxRegistryFilename);
 	}
 
-	return true;
+	// Report how well the work was spread
+	const double CookTime = FPlatformTime::Seconds() - CookStartTime;
+	double TotalBusyTime = 0.0;
+
+	UE_LOG(LogCookCommandlet, Display, TEXT("Cooked with %d workers in %.2fs, %.2fs of it with workers running"), NumWorkers, CookTime, WorkerTime);
+	for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; WorkerIndex++)
+	{
+		const double BusyTime = WorkerEndTimes[WorkerIndex] - WorkerStartTime;
+		TotalBusyTime += BusyTime;
+
+		UE_LOG(LogCookCommandlet, Display, TEXT("  Worker %d: %d packages, %.1f MB, ran %.2fs, %.0f%% utilization"),
+			WorkerIndex, WorkerNumPackages[WorkerIndex], (double)WorkerSizes[WorkerIndex] / (1024.0 * 1024.0), BusyTime, WorkerTime > 0.0 ? 100.0 * BusyTime / WorkerTime : 0.0);
+	}
+	UE_LOG(LogCookCommandlet, Display, TEXT("Average worker utilization %.0f%%"), NumWorkers > 0 && WorkerTime > 0.0 ? 100.0 * TotalBusyTime / (NumWorkers * WorkerTime) : 0.0);
+
+	return bWorkersSucceeded;
 }
 
 
@@ -0,0 +1,120 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "UnrealEd.h"
+#include "CookManifest.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCookManifest, Log, All);
+
+/** Bump this when the cook manifest format or the way cook keys are computed changes */
+static const int32 CookManifestVersion = 1;
+
+FCookManifest::FCookManifest(const FString& InFilename)
+	: Filename(InFilename)
+	, NumCooked(0)
+	, CookTimeSaved(0.0)
+{
+}
+
+void FCookManifest::Load(const TCHAR* SourceFilename)
+{
+	Entries.Empty();
+
+	if (SourceFilename == NULL)
+	{
+		SourceFilename = *Filename;
+	}
+
+	TScopedPointer<FArchive> FileReader(IFileManager::Get().CreateFileReader(SourceFilename));
+	if (!FileReader)
+	{
+		return;
+	}
+
+	int32 Version = 0;
+	*FileReader << Version;
+	if (Version != CookManifestVersion)
+	{
+		UE_LOG(LogCookManifest, Display, TEXT("Ignoring cook manifest %s, it was written by another version"), SourceFilename);
+		return;
+	}
+
+	*FileReader << Entries;
+
+	if (FileReader->IsError())
+	{
+		UE_LOG(LogCookManifest, Warning, TEXT("Failed to read cook manifest %s"), SourceFilename);
+		Entries.Empty();
+	}
+}
+
+bool FCookManifest::Save() const
+{
+	TScopedPointer<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!FileWriter)
+	{
+		UE_LOG(LogCookManifest, Warning, TEXT("Failed to write cook manifest %s"), *Filename);
+		return false;
+	}
+
+	int32 Version = CookManifestVersion;
+	*FileWriter << Version;
+	*FileWriter << const_cast<TMap<FString, FCookManifestEntry>&>(Entries);
+
+	return !FileWriter->IsError();
+}
+
+FString FCookManifest::GetEntryName(const FString& CookedFilename)
+{
+	FString EntryName = FPaths::ConvertRelativePathToFull(CookedFilename);
+	FPaths::NormalizeFilename(EntryName);
+	return EntryName;
+}
+
+bool FCookManifest::IsUpToDate(const FString& CookedFilename, const FSHAHash& CookKey) const
+{
+	const FCookManifestEntry* Entry = Entries.Find(GetEntryName(CookedFilename));
+	return Entry && Entry->CookKey == CookKey && IFileManager::Get().FileSize(*CookedFilename) >= 0;
+}
+
+void FCookManifest::MarkUpToDate(const FString& CookedFilename)
+{
+	const FString EntryName = GetEntryName(CookedFilename);
+	if (!UpToDatePackages.Contains(EntryName))
+	{
+		UpToDatePackages.Add(EntryName);
+
+		const FCookManifestEntry* Entry = Entries.Find(EntryName);
+		if (Entry)
+		{
+			CookTimeSaved += Entry->CookTime;
+		}
+	}
+}
+
+void FCookManifest::MarkCooked(const FString& CookedFilename, const FSHAHash& CookKey, float CookTime)
+{
+	FCookManifestEntry& Entry = Entries.FindOrAdd(GetEntryName(CookedFilename));
+	Entry.CookKey = CookKey;
+	Entry.CookTime = CookTime;
+	NumCooked++;
+}
+
+void FCookManifest::Remove(const FString& CookedFilename)
+{
+	Entries.Remove(GetEntryName(CookedFilename));
+}
+
+int32 FCookManifest::Merge(const FCookManifest& Other)
+{
+	int32 NumMerged = 0;
+	for (TMap<FString, FCookManifestEntry>::TConstIterator EntryIt(Other.Entries); EntryIt; ++EntryIt)
+	{
+		FCookManifestEntry& Entry = Entries.FindOrAdd(EntryIt.Key());
+		if (Entry.CookKey != EntryIt.Value().CookKey)
+		{
+			Entry = EntryIt.Value();
+			NumMerged++;
+		}
+	}
+	return NumMerged;
+}
@@ -0,0 +1,105 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "SecureHash.h"
+
+/** What a cooked package was cooked from */
+struct FCookManifestEntry
+{
+	/** Hash of the source package, all of its dependencies and the cook settings */
+	FSHAHash CookKey;
+	/** Seconds it took to save the cooked package */
+	float CookTime;
+
+	FCookManifestEntry()
+		: CookTime(0.0f)
+	{}
+
+	friend FArchive& operator<<(FArchive& Ar, FCookManifestEntry& Entry)
+	{
+		Ar << Entry.CookKey;
+		Ar << Entry.CookTime;
+		return Ar;
+	}
+};
+
+/**
+ * Records the cook key of every package cooked for a platform, kept on disk between cooks so iterative cooks only
+ * recook packages whose contents, dependencies or cook settings changed
+ */
+class FCookManifest
+{
+public:
+	/**
+	 * @param InFilename Where the manifest is stored
+	 */
+	FCookManifest(const FString& InFilename);
+
+	/**
+	 * Loads the manifest, starts out empty if there is none or it was written by another version
+	 *
+	 * @param SourceFilename File to load the manifest from if it isn't where the manifest is saved to
+	 */
+	void Load(const TCHAR* SourceFilename = NULL);
+
+	/** Saves the manifest */
+	bool Save() const;
+
+	/**
+	 * Returns true if a cooked package exists and was cooked with the given key.
+	 *
+	 * @param CookedFilename Filename of the cooked package
+	 * @param CookKey Key the package would be cooked with now
+	 */
+	bool IsUpToDate(const FString& CookedFilename, const FSHAHash& CookKey) const;
+
+	/** Counts a package that didn't need to be cooked, once per cook */
+	void MarkUpToDate(const FString& CookedFilename);
+
+	/** Records a package that was just cooked */
+	void MarkCooked(const FString& CookedFilename, const FSHAHash& CookKey, float CookTime);
+
+	/** Forgets a package, i.e. when its cooked file was deleted */
+	void Remove(const FString& CookedFilename);
+
+	/**
+	 * Takes over the packages another cook process recorded differently than this manifest.
+	 *
+	 * @return The number of packages that were taken over
+	 */
+	int32 Merge(const FCookManifest& Other);
+
+	/** Returns the number of packages that were up to date */
+	int32 GetNumUpToDate() const
+	{
+		return UpToDatePackages.Num();
+	}
+
+	/** Returns the number of packages that were cooked */
+	int32 GetNumCooked() const
+	{
+		return NumCooked;
+	}
+
+	/** Returns the seconds the up to date packages took to cook the last time they were cooked */
+	double GetCookTimeSaved() const
+	{
+		return CookTimeSaved;
+	}
+
+private:
+	/** Returns the name a cooked file is recorded under, so differently formed paths to the same file match */
+	static FString GetEntryName(const FString& CookedFilename);
+
+	/** Where the manifest is stored */
+	FString Filename;
+	/** Cooked filename to what it was cooked from */
+	TMap<FString, FCookManifestEntry> Entries;
+	/** Packages that were found to be up to date by this cook */
+	TSet<FString> UpToDatePackages;
+	/** Number of packages cooked by this cook */
+	int32 NumCooked;
+	/** Seconds saved by not cooking the up to date packages */
+	double CookTimeSaved;
+};
@@ -0,0 +1,337 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	StatsAnalyzerCommandlet.cpp: Headless percentile and hitch reports for
+	                             stats captures
+=============================================================================*/
+
+#include "UnrealEd.h"
+#if STATS
+#include "StatsData.h"
+#endif // STATS
+
+DEFINE_LOG_CATEGORY_STATIC(LogStatsAnalyzer, Log, All);
+
+#if STATS
+
+/** Cycles a stat took in every frame it showed up in. */
+struct FStatsAnalyzerSamples
+{
+	TArray<double> Inclusive;
+	TArray<double> Exclusive;
+	int64 NumCalls;
+
+	FStatsAnalyzerSamples()
+		: NumCalls(0)
+	{
+	}
+};
+
+/** Frame in which the game thread took longer than the hitch threshold. */
+struct FStatsAnalyzerHitch
+{
+	int64 Frame;
+	double GameThreadCycles;
+
+	/** Stats with the most exclusive time in the frame, longest first. */
+	TArray<FStatMessage> TopStats;
+};
+
+/** Average and percentiles of some samples, in milliseconds. */
+struct FStatsAnalyzerPercentiles
+{
+	double Average;
+	double P50;
+	double P90;
+	double P99;
+	double Max;
+
+	/** Sorts the samples, which are in cycles. */
+	FStatsAnalyzerPercentiles(TArray<double>& Samples, double MsPerCycle)
+		: Average(0.0)
+		, P50(0.0)
+		, P90(0.0)
+		, P99(0.0)
+		, Max(0.0)
+	{
+		if (Samples.Num() == 0)
+		{
+			return;
+		}
+
+		Samples.Sort();
+		double Sum = 0.0;
+		for (int32 Index = 0; Index < Samples.Num(); Index++)
+		{
+			Sum += Samples[Index];
+		}
+		Average = Sum / Samples.Num() * MsPerCycle;
+		P50 = GetPercentile(Samples, 0.50) * MsPerCycle;
+		P90 = GetPercentile(Samples, 0.90) * MsPerCycle;
+		P99 = GetPercentile(Samples, 0.99) * MsPerCycle;
+		Max = Samples.Last() * MsPerCycle;
+	}
+
+	/** Nearest rank percentile of sorted samples. */
+	static double GetPercentile(TArray<double> const& SortedSamples, double Percentile)
+	{
+		const int32 Index = FMath::Clamp(FMath::Ceil(float(Percentile * SortedSamples.Num())) - 1, 0, SortedSamples.Num() - 1);
+		return SortedSamples[Index];
+	}
+
+	void WriteCSV(FString& Out) const
+	{
+		Out += FString::Printf(TEXT(",%.4f,%.4f,%.4f,%.4f,%.4f"), Average, P50, P90, P99, Max);
+	}
+
+	void WriteJson(TSharedRef< TJsonWriter< TCHAR, TPrettyJsonPrintPolicy<TCHAR> > > const& Writer, const FString& Identifier) const
+	{
+		Writer->WriteObjectStart(Identifier);
+		Writer->WriteValue(TEXT("Average"), Average);
+		Writer->WriteValue(TEXT("P50"), P50);
+		Writer->WriteValue(TEXT("P90"), P90);
+		Writer->WriteValue(TEXT("P99"), P99);
+		Writer->WriteValue(TEXT("Max"), Max);
+		Writer->WriteObjectEnd();
+	}
+};
+
+#endif // STATS
+
+/*-----------------------------------------------------------------------------
+	UStatsAnalyzerCommandlet commandlet.
+-----------------------------------------------------------------------------*/
+UStatsAnalyzerCommandlet::UStatsAnalyzerCommandlet(const class FPostConstructInitializeProperties& PCIP)
+	: Super(PCIP)
+{
+	LogToConsole = true;
+}
+
+int32 UStatsAnalyzerCommandlet::Main(const FString& Params)
+{
+#if STATS
+	FString Filename;
+	if (!FParse::Value(*Params, TEXT("File="), Filename))
+	{
+		UE_LOG(LogStatsAnalyzer, Error, TEXT("Usage: -run=StatsAnalyzer -File=<capture> [-Out=<report>] [-Json] [-HitchMS=<game thread ms>] [-MaxHitchStats=<n>]"));
+		return 1;
+	}
+
+	const bool bJson = FParse::Param(*Params, TEXT("Json"));
+	FString OutFilename = FPaths::GetBaseFilename(Filename, false) + (bJson ? TEXT(".json") : TEXT(".csv"));
+	FParse::Value(*Params, TEXT("Out="), OutFilename);
+	float HitchMS = 33.3f;
+	FParse::Value(*Params, TEXT("HitchMS="), HitchMS);
+	int32 MaxHitchStats = 5;
+	FParse::Value(*Params, TEXT("MaxHitchStats="), MaxHitchStats);
+
+	const double StartTime = FPlatformTime::Seconds();
+	FStatsThreadState Loaded(Filename);
+	if (Loaded.GetLatestValidFrame() < 0)
+	{
+		UE_LOG(LogStatsAnalyzer, Error, TEXT("Failed to load stats file: %s"), *Filename);
+		return 1;
+	}
+	UE_LOG(LogStatsAnalyzer, Log, TEXT("Loaded %s in %.2fs"), *Filename, FPlatformTime::Seconds() - StartTime);
+
+	static const FName NAME_SecondsPerCycle(TEXT("STAT_SecondsPerCycle"));
+	double SecondsPerCycle = 0.0;
+
+	// samples are kept in cycles until we know the seconds per cycle of the machine the capture was made on
+	TMap<FName, FStatsAnalyzerSamples> Samples;
+	TArray<FStatsAnalyzerHitch> Hitches;
+	TArray<double> GameThreadTimes;
+	int32 NumFrames = 0;
+
+	TArray<FStatMessage> Inclusive;
+	TArray<FStatMessage> Exclusive;
+	TArray<FStatMessage> NonStackStats;
+	for (int64 Frame = Loaded.GetOldestValidFrame(); Frame <= Loaded.GetLatestValidFrame(); Frame++)
+	{
+		if (!Loaded.IsFrameValid(Frame))
+		{
+			continue;
+		}
+		NumFrames++;
+
+		FRawStatStackNode Root;
+		NonStackStats.Reset();
+		Loaded.UncondenseStackStats(Frame, Root, NULL, &NonStackStats);
+
+		for (int32 Index = 0; Index < NonStackStats.Num(); Index++)
+		{
+			FStatMessage const& Item = NonStackStats[Index];
+			if (Item.NameAndInfo.GetShortName() == NAME_SecondsPerCycle && Item.NameAndInfo.GetField<EStatDataType>() == EStatDataType::ST_double && Item.GetValue_double() > 0.0)
+			{
+				SecondsPerCycle = Item.GetValue_double();
+			}
+		}
+
+		double GameThreadCycles = 0.0;
+		for (TMap<FName, FRawStatStackNode*>::TConstIterator It(Root.Children); It; ++It)
+		{
+			if (It.Value()->Meta.NameAndInfo.GetShortName() == NAME_GameThread)
+			{
+				GameThreadCycles = It.Value()->Meta.GetValue_Duration();
+			}
+		}
+		GameThreadTimes.Add(GameThreadCycles);
+
+		Inclusive.Reset();
+		Loaded.GetInclusiveAggregateStackStats(Frame, Inclusive, NULL, false);
+		for (int32 Index = 0; Index < Inclusive.Num(); Index++)
+		{
+			FStatMessage const& Item = Inclusive[Index];
+			if (Item.NameAndInfo.GetFlag(EStatMetaFlags::IsCycle))
+			{
+				FStatsAnalyzerSamples& StatSamples = Samples.FindOrAdd(Item.NameAndInfo.GetShortName());
+				StatSamples.Inclusive.Add(Item.GetValue_Duration());
+				StatSamples.NumCalls += Item.GetValue_CallCount();
+			}
+		}
+
+		Exclusive.Reset();
+		Loaded.GetExclusiveAggregateStackStats(Frame, Exclusive, NULL, false);
+		for (int32 Index = 0; Index < Exclusive.Num(); Index++)
+		{
+			FStatMessage const& Item = Exclusive[Index];
+			if (Item.NameAndInfo.GetFlag(EStatMetaFlags::IsCycle))
+			{
+				Samples.FindOrAdd(Item.NameAndInfo.GetShortName()).Exclusive.Add(Item.GetValue_Duration());
+			}
+		}
+
+		// the threshold is converted once we know the seconds per cycle, so every frame is a hitch candidate until then
+		FStatsAnalyzerHitch* Hitch = new (Hitches) FStatsAnalyzerHitch();
+		Hitch->Frame = Frame;
+		Hitch->GameThreadCycles = GameThreadCycles;
+		Exclusive.Sort(FStatDurationComparer<FStatMessage>());
+		for (int32 Index = 0; Index < Exclusive.Num() && Hitch->TopStats.Num() < MaxHitchStats; Index++)
+		{
+			if (Exclusive[Index].NameAndInfo.GetFlag(EStatMetaFlags::IsCycle))
+			{
+				Hitch->TopStats.Add(Exclusive[Index]);
+			}
+		}
+	}
+
+	if (SecondsPerCycle <= 0.0)
+	{
+		UE_LOG(LogStatsAnalyzer, Warning, TEXT("The capture doesn't have STAT_SecondsPerCycle, using the cycle rate of this machine"));
+		SecondsPerCycle = FPlatformTime::GetSecondsPerCycle();
+	}
+	const double MsPerCycle = SecondsPerCycle * 1000.0;
+
+	for (int32 Index = Hitches.Num() - 1; Index >= 0; Index--)
+	{
+		if (Hitches[Index].GameThreadCycles * MsPerCycle <= HitchMS)
+		{
+			Hitches.RemoveAtSwap(Index);
+		}
+	}
+	struct FCompareFrame
+	{
+		FORCEINLINE bool operator()(const FStatsAnalyzerHitch& A, const FStatsAnalyzerHitch& B) const
+		{
+			return A.Frame < B.Frame;
+		}
+	};
+	Hitches.Sort(FCompareFrame());
+
+	struct FCompareName
+	{
+		FORCEINLINE bool operator()(const FName& A, const FName& B) const
+		{
+			return A.ToString() < B.ToString();
+		}
+	};
+	Samples.KeySort(FCompareName());
+
+	FString Out;
+	if (bJson)
+	{
+		TSharedRef< TJsonWriter< TCHAR, TPrettyJsonPrintPolicy<TCHAR> > > Writer = TJsonWriterFactory< TCHAR, TPrettyJsonPrintPolicy<TCHAR> >::Create(&Out);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("File"), Filename);
+		Writer->WriteValue(TEXT("Frames"), NumFrames);
+		FStatsAnalyzerPercentiles(GameThreadTimes, MsPerCycle).WriteJson(Writer, TEXT("GameThread"));
+
+		Writer->WriteArrayStart(TEXT("Stats"));
+		for (TMap<FName, FStatsAnalyzerSamples>::TIterator It(Samples); It; ++It)
+		{
+			FStatsAnalyzerSamples& StatSamples = It.Value();
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("Name"), It.Key().ToString());
+			Writer->WriteValue(TEXT("Frames"), StatSamples.Inclusive.Num());
+			Writer->WriteValue(TEXT("CallsPerFrame"), StatSamples.Inclusive.Num() ? double(StatSamples.NumCalls) / StatSamples.Inclusive.Num() : 0.0);
+			FStatsAnalyzerPercentiles(StatSamples.Inclusive, MsPerCycle).WriteJson(Writer, TEXT("Inclusive"));
+			FStatsAnalyzerPercentiles(StatSamples.Exclusive, MsPerCycle).WriteJson(Writer, TEXT("Exclusive"));
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("Hitches"));
+		for (int32 Index = 0; Index < Hitches.Num(); Index++)
+		{
+			FStatsAnalyzerHitch const& Hitch = Hitches[Index];
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("Frame"), Hitch.Frame);
+			Writer->WriteValue(TEXT("GameThreadMS"), Hitch.GameThreadCycles * MsPerCycle);
+			Writer->WriteArrayStart(TEXT("TopExclusive"));
+			for (int32 StatIndex = 0; StatIndex < Hitch.TopStats.Num(); StatIndex++)
+			{
+				Writer->WriteObjectStart();
+				Writer->WriteValue(TEXT("Name"), Hitch.TopStats[StatIndex].NameAndInfo.GetShortName().ToString());
+				Writer->WriteValue(TEXT("MS"), Hitch.TopStats[StatIndex].GetValue_Duration() * MsPerCycle);
+				Writer->WriteObjectEnd();
+			}
+			Writer->WriteArrayEnd();
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteObjectEnd();
+		Writer->Close();
+	}
+	else
+	{
+		// one table for the stats, the hitches follow after an empty line
+		Out += TEXT("Stat,Frames,CallsPerFrame,IncAvgMS,IncP50MS,IncP90MS,IncP99MS,IncMaxMS,ExcAvgMS,ExcP50MS,ExcP90MS,ExcP99MS,ExcMaxMS") LINE_TERMINATOR;
+		Out += FString::Printf(TEXT("GameThread,%d,1"), NumFrames);
+		FStatsAnalyzerPercentiles(GameThreadTimes, MsPerCycle).WriteCSV(Out);
+		Out += TEXT(",,,,,") LINE_TERMINATOR;
+		for (TMap<FName, FStatsAnalyzerSamples>::TIterator It(Samples); It; ++It)
+		{
+			FStatsAnalyzerSamples& StatSamples = It.Value();
+			Out += FString::Printf(TEXT("%s,%d,%.2f"), *It.Key().ToString(), StatSamples.Inclusive.Num(), StatSamples.Inclusive.Num() ? double(StatSamples.NumCalls) / StatSamples.Inclusive.Num() : 0.0);
+			FStatsAnalyzerPercentiles(StatSamples.Inclusive, MsPerCycle).WriteCSV(Out);
+			FStatsAnalyzerPercentiles(StatSamples.Exclusive, MsPerCycle).WriteCSV(Out);
+			Out += LINE_TERMINATOR;
+		}
+
+		Out += LINE_TERMINATOR TEXT("HitchFrame,GameThreadMS,TopExclusiveStats") LINE_TERMINATOR;
+		for (int32 Index = 0; Index < Hitches.Num(); Index++)
+		{
+			FStatsAnalyzerHitch const& Hitch = Hitches[Index];
+			Out += FString::Printf(TEXT("%lld,%.2f"), Hitch.Frame, Hitch.GameThreadCycles * MsPerCycle);
+			for (int32 StatIndex = 0; StatIndex < Hitch.TopStats.Num(); StatIndex++)
+			{
+				Out += FString::Printf(TEXT(",%s %.2f"), *Hitch.TopStats[StatIndex].NameAndInfo.GetShortName().ToString(), Hitch.TopStats[StatIndex].GetValue_Duration() * MsPerCycle);
+			}
+			Out += LINE_TERMINATOR;
+		}
+	}
+
+	if (!FFileHelper::SaveStringToFile(Out, *OutFilename))
+	{
+		UE_LOG(LogStatsAnalyzer, Error, TEXT("Could not write: %s"), *OutFilename);
+		return 1;
+	}
+
+	UE_LOG(LogStatsAnalyzer, Log, TEXT("%d frames, %d stats, %d hitches over %.1fms, wrote %s"), NumFrames, Samples.Num(), Hitches.Num(), HitchMS, *OutFilename);
+	return 0;
+#else
+	UE_LOG(LogStatsAnalyzer, Error, TEXT("The stats analyzer needs a build with STATS enabled"));
+	return 1;
+#endif // STATS
+}
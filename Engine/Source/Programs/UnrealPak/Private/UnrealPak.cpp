@@ -94,37 +94,252 @@ FString GetCommonRootPath(TArray<FPakInputPair>& FilesToAdd)
 }
 
 
-bool CopyFileToPak(FArchive& InPak, const FString& InMountPoint, const FPakInputPair& InFile, uint8*& InOutPersistentBuffer, int64& InOutBufferSize, FPakEntryPair& OutNewEntry)
+struct FPakCompressionSettings
+{
+	/** Compression method used for new entries, COMPRESS_None stores files uncompressed. */
+	ECompressionFlags CompressionMethod;
+	/** Size of the uncompressed blocks files are split into before compressing. */
+	int32 BlockSize;
+
+	FPakCompressionSettings()
+		: CompressionMethod(COMPRESS_None)
+		, BlockSize(64 * 1024)
+	{}
+};
+
+/**
+ * Compresses file data in fixed size blocks.
+ *
+ * @param InSettings Compression settings.
+ * @param InData Uncompressed file data.
+ * @param InDataSize Size of the uncompressed data.
+ * @param OutCompressedData Receives all compressed blocks back to back.
+ * @param OutEntry Receives the block table.
+ * @return true if the compressed data is smaller than the source data.
+ */
+bool CompressFileData(const FPakCompressionSettings& InSettings, const uint8* InData, int64 InDataSize, TArray<uint8>& OutCompressedData, FPakEntry& OutEntry)
+{
+	const int32 NumBlocks = (int32)((InDataSize + InSettings.BlockSize - 1) / InSettings.BlockSize);
+	const int32 MaxCompressedBlockSize = 2 * InSettings.BlockSize;
+
+	OutCompressedData.Reset();
+	OutEntry.CompressionBlocks.Empty(NumBlocks);
+	for (int32 BlockIndex = 0; BlockIndex < NumBlocks; BlockIndex++)
+	{
+		const int64 BlockStart = (int64)BlockIndex * InSettings.BlockSize;
+		const int32 UncompressedBlockSize = (int32)FMath::Min<int64>(InSettings.BlockSize, InDataSize - BlockStart);
+		const int32 CompressedStart = OutCompressedData.Num();
+
+		OutCompressedData.AddUninitialized(MaxCompressedBlockSize);
+		int32 CompressedBlockSize = MaxCompressedBlockSize;
+		if (!FCompression::CompressMemory(InSettings.CompressionMethod, OutCompressedData.GetData() + CompressedStart, CompressedBlockSize, InData + BlockStart, UncompressedBlockSize))
+		{
+			return false;
+		}
+		OutCompressedData.SetNum(CompressedStart + CompressedBlockSize, false);
+
+		FPakCompressedBlock Block;
+		Block.CompressedStart = CompressedStart;
+		Block.CompressedEnd = CompressedStart + CompressedBlockSize;
+		OutEntry.CompressionBlocks.Add(Block);
+	}
+	return OutCompressedData.Num() < InDataSize;
+}
+
+/** Time spent in each stage of building a pak file. Worker stage times are summed over all workers. */
+struct FPakBuildTimings
+{
+	double ReadTime;
+	double HashTime;
+	double CompressTime;
+	double WriteTime;
+	/** Time the writer spent waiting for workers to finish files. */
+	double WriterStallTime;
+
+	FPakBuildTimings()
+		: ReadTime(0.0)
+		, HashTime(0.0)
+		, CompressTime(0.0)
+		, WriteTime(0.0)
+		, WriterStallTime(0.0)
+	{}
+
+	void Accumulate(const FPakBuildTimings& Other)
+	{
+		ReadTime += Other.ReadTime;
+		HashTime += Other.HashTime;
+		CompressTime += Other.CompressTime;
+		WriteTime += Other.WriteTime;
+		WriterStallTime += Other.WriterStallTime;
+	}
+};
+
+/** A file prepared for being appended to a pak: its entry and the (possibly compressed) data to store. */
+struct FPakFileJob
+{
+	/** New pak entry. Offset is assigned by the writer. */
+	FPakEntryPair Entry;
+	/** Data to write after the entry header. */
+	TArray<uint8> Data;
+	/** False if the source file could not be opened. */
+	bool bFileExists;
+	/** True if the source file is too large to be read into memory in one piece. */
+	bool bFileTooLarge;
+	/** Set by the worker once Entry and Data are ready to be written. */
+	volatile int32 bReady;
+
+	FPakFileJob()
+		: bFileExists(false)
+		, bFileTooLarge(false)
+		, bReady(0)
+	{}
+};
+
+/**
+ * Reads, compresses and hashes a single file. Safe to call from any thread.
+ *
+ * @param InMountPoint Pak mount point.
+ * @param InFile File to prepare.
+ * @param InCompression Compression settings.
+ * @param InOutReadBuffer Scratch buffer used for reading files that are going to be compressed.
+ * @param OutJob Receives the new entry and the data to write.
+ * @param OutTimings Stage timings are added to this struct.
+ */
+void PrepareFileForPak(const FString& InMountPoint, const FPakInputPair& InFile, const FPakCompressionSettings& InCompression, TArray<uint8>& InOutReadBuffer, FPakFileJob& OutJob, FPakBuildTimings& OutTimings)
 {	
+	double StageStartTime = FPlatformTime::Seconds();
 	TAutoPtr<FArchive> FileHandle(IFileManager::Get().CreateFileReader(*InFile.Source));
-	bool bFileExists = FileHandle.IsValid();
-	if (bFileExists)
+	OutJob.bFileExists = FileHandle.IsValid();
+	if (OutJob.bFileExists)
 	{
 		const int64 FileSize = FileHandle->TotalSize();
-		OutNewEntry.Filename = InFile.Dest.Mid(InMountPoint.Len());
-		OutNewEntry.Info.Offset = 0; // Don't serialize offsets here.
-		OutNewEntry.Info.Size = FileSize;
-		OutNewEntry.Info.UncompressedSize = FileSize;
-		OutNewEntry.Info.CompressionMethod = 0;
-
-		if (InOutBufferSize < FileSize)
+		if (FileSize > MAX_int32)
 		{
-			InOutPersistentBuffer = (uint8*)FMemory::Realloc(InOutPersistentBuffer, FileSize);
-			InOutBufferSize = FileSize;
+			// TArray sizes are int32, files this large can't be read in one piece.
+			OutJob.bFileExists = false;
+			OutJob.bFileTooLarge = true;
+			OutTimings.ReadTime += FPlatformTime::Seconds() - StageStartTime;
+			return;
 		}
 
-		// Load to buffer
-		FileHandle->Serialize(InOutPersistentBuffer, FileSize);
-		// Calculate the buffer hash value
-		FSHA1::HashBuffer(InOutPersistentBuffer, FileSize, OutNewEntry.Info.Hash);
+		FPakEntryPair& NewEntry = OutJob.Entry;
+		NewEntry.Filename = InFile.Dest.Mid(InMountPoint.Len());
+		NewEntry.Info.Offset = 0; // Don't serialize offsets here.
+		NewEntry.Info.Size = FileSize;
+		NewEntry.Info.UncompressedSize = FileSize;
+		NewEntry.Info.CompressionMethod = COMPRESS_None;
 
-		// Write to file
-		OutNewEntry.Info.Serialize(InPak, FPakInfo::PakFile_Version_Latest);
-		InPak.Serialize(InOutPersistentBuffer, FileSize);
+		const bool bCompress = InCompression.CompressionMethod != COMPRESS_None && FileSize > 0;
+		TArray<uint8>& FileData = bCompress ? InOutReadBuffer : OutJob.Data;
+		FileData.Reset();
+		FileData.AddUninitialized((int32)FileSize);
+		FileHandle->Serialize(FileData.GetData(), FileSize);
+		FileHandle.Reset();
+		OutTimings.ReadTime += FPlatformTime::Seconds() - StageStartTime;
+
+		if (bCompress)
+		{
+			// Only keep the compressed version if it actually saves space.
+			StageStartTime = FPlatformTime::Seconds();
+			if (CompressFileData(InCompression, FileData.GetData(), FileSize, OutJob.Data, NewEntry.Info))
+			{
+				NewEntry.Info.CompressionMethod = InCompression.CompressionMethod;
+				NewEntry.Info.CompressionBlockSize = InCompression.BlockSize;
+				NewEntry.Info.Size = OutJob.Data.Num();
+			}
+			else
+			{
+				NewEntry.Info.CompressionBlocks.Empty();
+				Exchange(OutJob.Data, InOutReadBuffer);
+			}
+			OutTimings.CompressTime += FPlatformTime::Seconds() - StageStartTime;
+		}
+
+		// Calculate the hash value of the data stored in pak
+		StageStartTime = FPlatformTime::Seconds();
+		FSHA1::HashBuffer(OutJob.Data.GetData(), OutJob.Data.Num(), NewEntry.Info.Hash);
+		OutTimings.HashTime += FPlatformTime::Seconds() - StageStartTime;
+	}
+	else
+	{
+		OutTimings.ReadTime += FPlatformTime::Seconds() - StageStartTime;
 	}
-	return bFileExists;
 }
 
+/**
+ * Shared state of a pak build. Workers prepare files in any order, the writer appends them in FilesToAdd order
+ * so the resulting pak is identical to a serial build.
+ */
+struct FPakBuildPipeline
+{
+	const TArray<FPakInputPair>& FilesToAdd;
+	const FString& MountPoint;
+	const FPakCompressionSettings& Compression;
+	/** One job per file in FilesToAdd. */
+	TArray<FPakFileJob> Jobs;
+	/** Index of the next file a worker should pick up. */
+	FThreadSafeCounter NextJob;
+	/** Number of files the writer has already written. */
+	FThreadSafeCounter NumWritten;
+	/** Maximum number of files workers may be ahead of the writer (limits memory usage). */
+	int32 MaxJobsInFlight;
+	/** Triggered whenever a worker finishes a file. */
+	FEvent* JobReadyEvent;
+
+	FPakBuildPipeline(const TArray<FPakInputPair>& InFilesToAdd, const FString& InMountPoint, const FPakCompressionSettings& InCompression, int32 InMaxJobsInFlight)
+		: FilesToAdd(InFilesToAdd)
+		, MountPoint(InMountPoint)
+		, Compression(InCompression)
+		, MaxJobsInFlight(InMaxJobsInFlight)
+		, JobReadyEvent(FPlatformProcess::CreateSynchEvent())
+	{
+		Jobs.SetNum(FilesToAdd.Num());
+	}
+
+	~FPakBuildPipeline()
+	{
+		delete JobReadyEvent;
+	}
+};
+
+/**
+ * Worker thread reading, compressing and hashing files for the pak writer.
+ */
+class FPakBuildWorker : public FRunnable
+{
+	FPakBuildPipeline& Pipeline;
+	/** Scratch buffer for reading files that get compressed. */
+	TArray<uint8> ReadBuffer;
+
+public:
+
+	/** Time spent in each stage on this worker. */
+	FPakBuildTimings Timings;
+
+	FPakBuildWorker(FPakBuildPipeline& InPipeline)
+		: Pipeline(InPipeline)
+	{}
+
+	virtual uint32 Run() OVERRIDE
+	{
+		for (int32 JobIndex = Pipeline.NextJob.Increment() - 1; JobIndex < Pipeline.Jobs.Num(); JobIndex = Pipeline.NextJob.Increment() - 1)
+		{
+			// Don't get too far ahead of the writer.
+			while (JobIndex >= Pipeline.NumWritten.GetValue() + Pipeline.MaxJobsInFlight)
+			{
+				FPlatformProcess::Sleep(0.001f);
+			}
+
+			FPakFileJob& Job = Pipeline.Jobs[JobIndex];
+			PrepareFileForPak(Pipeline.MountPoint, Pipeline.FilesToAdd[JobIndex], Pipeline.Compression, ReadBuffer, Job, Timings);
+			FPlatformMisc::MemoryBarrier();
+			Job.bReady = 1;
+			Pipeline.JobReadyEvent->Trigger();
+		}
+		return 0;
+	}
+};
+
 void ProcessCommandLine(int32 ArgC, ANSICHAR* ArgV[], TArray<FPakInputPair>& Entries)
 {
 	// List of all items to add to pak file
@@ -277,19 +492,6 @@ void CollectFilesToAdd(TArray<FPakInputPair>& OutFilesToAdd, const TArray<FPakIn
 	UE_LOG(LogPakFile, Display, TEXT("Collected %d files in %.2lfs."), OutFilesToAdd.Num(), FPlatformTime::Seconds() - StartTime);
 }
 
-bool BufferedCopyFile(FArchive& Dest, FArchive& Source, const int64 FileSize, void* Buffer, const int64 BufferSize)
-{	
-	int64 RemainingSizeToCopy = FileSize;
-	while (RemainingSizeToCopy > 0)
-	{
-		const int64 SizeToCopy = FMath::Min(BufferSize, RemainingSizeToCopy);
-		Source.Serialize(Buffer, SizeToCopy);
-		Dest.Serialize(Buffer, SizeToCopy);
-		RemainingSizeToCopy -= SizeToCopy;
-	}
-	return true;
-}
-
 /**
  * Creates a pak file writer. This can be a signed writer if the encryption keys are specified in the command line
  */
@@ -338,7 +540,7 @@ FArchive* CreatePakWriter(const TCHAR* Filename)
 	return Writer;
 }
 
-bool CreatePakFile(const TCHAR* Filename, TArray<FPakInputPair>& FilesToAdd)
+bool CreatePakFile(const TCHAR* Filename, TArray<FPakInputPair>& FilesToAdd, const FPakCompressionSettings& Compression, int32 NumWorkerThreads, bool bPathHashIndex)
 {	
 	const double StartTime = FPlatformTime::Seconds();
 
@@ -351,31 +553,82 @@ bool CreatePakFile(const TCHAR* Filename, TArray<FPakInputPair>& FilesToAdd)
 	}
 
 	FPakInfo Info;
+	Info.Version = bPathHashIndex ? FPakInfo::PakFile_Version_PathHashIndex : FPakInfo::PakFile_Version_CompressionBlocks;
 	TArray<FPakEntryPair> Index;
 	FString MountPoint = GetCommonRootPath(FilesToAdd);
-	uint8* ReadBuffer = NULL;
-	int64 BufferSize = 0;
+	int64 TotalUncompressedSize = 0;
+
+	FPakBuildTimings Timings;
+	FPakBuildPipeline Pipeline(FilesToAdd, MountPoint, Compression, FMath::Max(4 * NumWorkerThreads, 16));
+	TArray<FPakBuildWorker*> Workers;
+	TArray<FRunnableThread*> WorkerThreads;
+	for (int32 WorkerIndex = 0; WorkerIndex < NumWorkerThreads; WorkerIndex++)
+	{
+		FPakBuildWorker* Worker = new FPakBuildWorker(Pipeline);
+		Workers.Add(Worker);
+		WorkerThreads.Add(FRunnableThread::Create(Worker, *FString::Printf(TEXT("PakBuildWorker%d"), WorkerIndex)));
+	}
+	TArray<uint8> ReadBuffer;
 
 	for (int32 FileIndex = 0; FileIndex < FilesToAdd.Num(); FileIndex++)
 	{
-		//  Remember the offset but don't serialize it with the entry header.
-		const int64 NewEntryOffset = PakFileHandle->Tell();
-		FPakEntryPair NewEntry;
-		if (CopyFileToPak(*PakFileHandle, MountPoint, FilesToAdd[FileIndex], ReadBuffer, BufferSize, NewEntry) == true)
+		FPakFileJob& Job = Pipeline.Jobs[FileIndex];
+		if (NumWorkerThreads > 0)
+		{
+			const double StallStartTime = FPlatformTime::Seconds();
+			while (!Job.bReady)
+			{
+				Pipeline.JobReadyEvent->Wait(10);
+			}
+			FPlatformMisc::MemoryBarrier();
+			Timings.WriterStallTime += FPlatformTime::Seconds() - StallStartTime;
+		}
+		else
 		{
-			// Update offset now and store it in the index (and only in index)
-			NewEntry.Info.Offset = NewEntryOffset;
+			PrepareFileForPak(MountPoint, FilesToAdd[FileIndex], Compression, ReadBuffer, Job, Timings);
+		}
+
+		if (Job.bFileExists)
+		{
+			// Remember the offset but don't serialize it with the entry header. Store it in the index (and only in index).
+			const double WriteStartTime = FPlatformTime::Seconds();
+			FPakEntryPair& NewEntry = Job.Entry;
+			NewEntry.Info.Offset = PakFileHandle->Tell();
+			NewEntry.Info.Serialize(*PakFileHandle, FPakInfo::PakFile_Version_Latest);
+			PakFileHandle->Serialize(Job.Data.GetData(), Job.Data.Num());
+			Job.Data.Empty();
+			Timings.WriteTime += FPlatformTime::Seconds() - WriteStartTime;
+
 			Index.Add(NewEntry);
-			UE_LOG(LogPakFile, Display, TEXT("Added file \"%s\", %lld bytes."), *NewEntry.Filename, NewEntry.Info.Size);
+			TotalUncompressedSize += NewEntry.Info.UncompressedSize;
+			if (NewEntry.Info.IsCompressed())
+			{
+				UE_LOG(LogPakFile, Display, TEXT("Added file \"%s\", %lld bytes (%lld compressed, %d blocks)."), *NewEntry.Filename, NewEntry.Info.UncompressedSize, NewEntry.Info.Size, NewEntry.Info.CompressionBlocks.Num());
+			}
+			else
+			{
+				UE_LOG(LogPakFile, Display, TEXT("Added file \"%s\", %lld bytes."), *NewEntry.Filename, NewEntry.Info.Size);
+			}
+		}
+		else if (Job.bFileTooLarge)
+		{
+			UE_LOG(LogPakFile, Error, TEXT("File \"%s\" is 2 GB or larger and will not be added to PAK file."), *FilesToAdd[FileIndex].Source);
 		}
 		else
 		{
 			UE_LOG(LogPakFile, Warning, TEXT("Missing file \"%s\" will not be added to PAK file."), *FilesToAdd[FileIndex].Source);
 		}
+		Pipeline.NumWritten.Increment();
 	}
 
-	FMemory::Free(ReadBuffer);
-	ReadBuffer = NULL;
+	for (int32 WorkerIndex = 0; WorkerIndex < Workers.Num(); WorkerIndex++)
+	{
+		WorkerThreads[WorkerIndex]->WaitForCompletion();
+		delete WorkerThreads[WorkerIndex];
+		Timings.Accumulate(Workers[WorkerIndex]->Timings);
+		delete Workers[WorkerIndex];
+	}
+	const double FilesTime = FPlatformTime::Seconds() - StartTime;
 
 	// Remember IndexOffset
 	Info.IndexOffset = PakFileHandle->Tell();
@@ -387,11 +640,29 @@ bool CreatePakFile(const TCHAR* Filename, TArray<FPakInputPair>& FilesToAdd)
 	int32 NumEntries = Index.Num();
 	IndexWriter << MountPoint;
 	IndexWriter << NumEntries;
-	for (int32 EntryIndex = 0; EntryIndex < Index.Num(); EntryIndex++)
+	if (bPathHashIndex)
 	{
-		FPakEntryPair& Entry = Index[EntryIndex];
-		IndexWriter << Entry.Filename;
-		Entry.Info.Serialize(IndexWriter, Info.Version);
+		// Entries without filenames followed by the flat path hash index.
+		TArray<FString> RelativeFilenames;
+		RelativeFilenames.Empty(Index.Num());
+		for (int32 EntryIndex = 0; EntryIndex < Index.Num(); EntryIndex++)
+		{
+			FPakEntryPair& Entry = Index[EntryIndex];
+			Entry.Info.Serialize(IndexWriter, Info.Version);
+			RelativeFilenames.Add(Entry.Filename);
+		}
+		FPakPathHashIndex PathHashIndex;
+		PathHashIndex.Build(RelativeFilenames);
+		PathHashIndex.Serialize(IndexWriter);
+	}
+	else
+	{
+		for (int32 EntryIndex = 0; EntryIndex < Index.Num(); EntryIndex++)
+		{
+			FPakEntryPair& Entry = Index[EntryIndex];
+			IndexWriter << Entry.Filename;
+			Entry.Info.Serialize(IndexWriter, Info.Version);
+		}
 	}
 	PakFileHandle->Serialize(IndexData.GetData(), IndexData.Num());
 
@@ -401,7 +672,10 @@ bool CreatePakFile(const TCHAR* Filename, TArray<FPakInputPair>& FilesToAdd)
 	// Save trailer (offset, size, hash value)
 	Info.Serialize(*PakFileHandle);
 
-	UE_LOG(LogPakFile, Display, TEXT("Added %d files, %lld bytes total, time %.2lfs."), Index.Num(), PakFileHandle->TotalSize(), FPlatformTime::Seconds() - StartTime);
+	UE_LOG(LogPakFile, Display, TEXT("Added %d files, %lld bytes total (%lld bytes uncompressed), time %.2lfs."), Index.Num(), PakFileHandle->TotalSize(), TotalUncompressedSize, FPlatformTime::Seconds() - StartTime);
+	UE_LOG(LogPakFile, Display, TEXT("Stage timings (%d worker threads, worker stages summed over all workers):"), NumWorkerThreads);
+	UE_LOG(LogPakFile, Display, TEXT("  Read: %.2lfs, Compress: %.2lfs, Hash: %.2lfs"), Timings.ReadTime, Timings.CompressTime, Timings.HashTime);
+	UE_LOG(LogPakFile, Display, TEXT("  Write: %.2lfs, Writer stalled: %.2lfs, Files: %.2lfs, Index: %.2lfs"), Timings.WriteTime, Timings.WriterStallTime, FilesTime, FPlatformTime::Seconds() - StartTime - FilesTime);
 
 	PakFileHandle->Close();
 	PakFileHandle.Reset();
@@ -464,6 +738,22 @@ bool TestPakFile(const TCHAR* Filename)
 	}
 }
 
+bool BufferedCopyFile(FArchive& Dest, IFileHandle& Source, const int64 FileSize, uint8* Buffer, const int64 BufferSize)
+{	
+	int64 RemainingSizeToCopy = FileSize;
+	while (RemainingSizeToCopy > 0)
+	{
+		const int64 SizeToCopy = FMath::Min(BufferSize, RemainingSizeToCopy);
+		if (!Source.Read(Buffer, SizeToCopy))
+		{
+			return false;
+		}
+		Dest.Serialize(Buffer, SizeToCopy);
+		RemainingSizeToCopy -= SizeToCopy;
+	}
+	return true;
+}
+
 bool ExtractFilesFromPak(const TCHAR* InPakFilename, const TCHAR* InDestPath)
 {
 	FPakFile PakFile(InPakFilename, FParse::Param(FCommandLine::Get(), TEXT("signed")));
@@ -472,7 +762,7 @@ bool ExtractFilesFromPak(const TCHAR* InPakFilename, const TCHAR* InDestPath)
 		FString DestPath(InDestPath);
 		FArchive& PakReader = *PakFile.GetSharedReader(NULL);
 		const int64 BufferSize = 8 * 1024 * 1024; // 8MB buffer for extracting
-		void* Buffer = FMemory::Malloc(BufferSize);
+		uint8* Buffer = (uint8*)FMemory::Malloc(BufferSize);
 		int32 ErrorCount = 0;
 		int32 FileCount = 0;
 
@@ -489,8 +779,17 @@ bool ExtractFilesFromPak(const TCHAR* InPakFilename, const TCHAR* InDestPath)
 				TAutoPtr<FArchive> FileHandle(IFileManager::Get().CreateFileWriter(*DestFilename));
 				if (FileHandle.IsValid())
 				{
-					BufferedCopyFile(*FileHandle, PakReader, Entry.Size, Buffer, BufferSize);
-					UE_LOG(LogPakFile, Display, TEXT("Extracted \"%s\" to \"%s\"."), *It.Filename(), *DestFilename);
+					// Read through a pak file handle so that compressed entries get decompressed.
+					FPakFileHandle PakHandle(PakFile, Entry, &PakReader, true);
+					if (BufferedCopyFile(*FileHandle, PakHandle, Entry.UncompressedSize, Buffer, BufferSize))
+					{
+						UE_LOG(LogPakFile, Display, TEXT("Extracted \"%s\" to \"%s\"."), *It.Filename(), *DestFilename);
+					}
+					else
+					{
+						UE_LOG(LogPakFile, Error, TEXT("Unable to read \"%s\" from pak."), *It.Filename());
+						ErrorCount++;
+					}
 				}
 				else
 				{
@@ -517,6 +816,118 @@ bool ExtractFilesFromPak(const TCHAR* InPakFilename, const TCHAR* InDestPath)
 	}
 }
 
+/**
+ * Reads every file in a pak through FPakFileHandle and reports read throughput and the amount
+ * of data read from disk. Run it on a compressed and an uncompressed pak to compare the two.
+ */
+bool BenchmarkPakFile(const TCHAR* InPakFilename)
+{
+	FPakFile PakFile(InPakFilename, FParse::Param(FCommandLine::Get(), TEXT("signed")));
+	if (!PakFile.IsValid())
+	{
+		UE_LOG(LogPakFile, Error, TEXT("Unable to open pak file \"%s\"."), InPakFilename);
+		return false;
+	}
+
+	int32 ReadSize = 64 * 1024;
+	FParse::Value(FCommandLine::Get(), TEXT("BenchmarkReadSize="), ReadSize);
+	ReadSize = FMath::Max(ReadSize, 1);
+
+	FArchive& PakReader = *PakFile.GetSharedReader(NULL);
+	uint8* Buffer = (uint8*)FMemory::Malloc(ReadSize);
+	int32 FileCount = 0;
+	int32 CompressedFileCount = 0;
+	int32 ErrorCount = 0;
+	int64 BytesReturned = 0;
+	int64 BytesReadFromPak = 0;
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (FPakFile::FFileIterator It(PakFile); It; ++It, ++FileCount)
+	{
+		const FPakEntry& Entry = It.Info();
+		FPakFileHandle PakHandle(PakFile, Entry, &PakReader, true);
+		for (int64 Remaining = Entry.UncompressedSize; Remaining > 0; Remaining -= ReadSize)
+		{
+			const int64 SizeToRead = FMath::Min<int64>(ReadSize, Remaining);
+			if (!PakHandle.Read(Buffer, SizeToRead))
+			{
+				UE_LOG(LogPakFile, Error, TEXT("Failed to read \"%s\"."), *It.Filename());
+				ErrorCount++;
+				break;
+			}
+			BytesReturned += SizeToRead;
+		}
+		BytesReadFromPak += PakHandle.GetBytesReadFromPak();
+		CompressedFileCount += Entry.IsCompressed() ? 1 : 0;
+	}
+	const double ElapsedTime = FMath::Max(FPlatformTime::Seconds() - StartTime, 0.000001);
+	FMemory::Free(Buffer);
+
+	UE_LOG(LogPakFile, Display, TEXT("Benchmark \"%s\": %d files (%d compressed), %d byte reads."), InPakFilename, FileCount, CompressedFileCount, ReadSize);
+	UE_LOG(LogPakFile, Display, TEXT("  Bytes read from pak: %lld, bytes returned: %lld (%.1f%%)."), BytesReadFromPak, BytesReturned, BytesReturned > 0 ? 100.0 * BytesReadFromPak / BytesReturned : 0.0);
+	UE_LOG(LogPakFile, Display, TEXT("  Time %.3lfs, throughput %.2lf MB/s (%.2lf MB/s from pak)."), ElapsedTime, BytesReturned / ElapsedTime / (1024.0 * 1024.0), BytesReadFromPak / ElapsedTime / (1024.0 * 1024.0));
+	return ErrorCount == 0;
+}
+
+/**
+ * Measures index load time, index memory and FPakFile::Find lookup times for hits and misses.
+ * Run it on paks built with and without -PathHashIndex to compare both index formats.
+ */
+bool BenchmarkPakIndex(const TCHAR* InPakFilename)
+{
+	const double LoadStartTime = FPlatformTime::Seconds();
+	FPakFile PakFile(InPakFilename, FParse::Param(FCommandLine::Get(), TEXT("signed")));
+	const double LoadTime = FPlatformTime::Seconds() - LoadStartTime;
+	if (!PakFile.IsValid())
+	{
+		UE_LOG(LogPakFile, Error, TEXT("Unable to open pak file \"%s\"."), InPakFilename);
+		return false;
+	}
+
+	TArray<FString> Filenames;
+	TArray<FString> MissingFilenames;
+	for (FPakFile::FFileIterator It(PakFile); It; ++It)
+	{
+		Filenames.Add(PakFile.GetMountPoint() + It.Filename());
+		MissingFilenames.Add(Filenames.Last() + TEXT(".missing"));
+	}
+	if (Filenames.Num() == 0)
+	{
+		UE_LOG(LogPakFile, Error, TEXT("Pak file \"%s\" is empty."), InPakFilename);
+		return false;
+	}
+
+	int32 NumLookups = 1000000;
+	FParse::Value(FCommandLine::Get(), TEXT("BenchmarkLookups="), NumLookups);
+	NumLookups = FMath::Max(NumLookups, 1);
+
+	int32 ErrorCount = 0;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Lookup = 0; Lookup < NumLookups; Lookup++)
+	{
+		if (PakFile.Find(Filenames[Lookup % Filenames.Num()]) == NULL)
+		{
+			ErrorCount++;
+		}
+	}
+	const double HitTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Lookup = 0; Lookup < NumLookups; Lookup++)
+	{
+		if (PakFile.Find(MissingFilenames[Lookup % MissingFilenames.Num()]) != NULL)
+		{
+			ErrorCount++;
+		}
+	}
+	const double MissTime = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogPakFile, Display, TEXT("Index benchmark \"%s\": %s index, %d files."), InPakFilename, PakFile.HasPathHashIndex() ? TEXT("path hash") : TEXT("directory map"), Filenames.Num());
+	UE_LOG(LogPakFile, Display, TEXT("  Load time %.2lfms, index memory %.2lfKB."), LoadTime * 1000.0, PakFile.GetIndexAllocatedSize() / 1024.0);
+	UE_LOG(LogPakFile, Display, TEXT("  %d lookups: hit %.1lfns/lookup, miss %.1lfns/lookup, %d errors."), NumLookups, HitTime * 1e9 / NumLookups, MissTime * 1e9 / NumLookups, ErrorCount);
+	return ErrorCount == 0;
+}
+
 /**
  * Application entry point
  * Params:
@@ -526,6 +937,12 @@ bool ExtractFilesFromPak(const TCHAR* InPakFilename, const TCHAR* InDestPath)
  *   -Sign=filename use the key pair in filename to sign a pak file, or: -sign=key_hex_values_separated_with_+, i.e: -sign=0x123456789abcdef+0x1234567+0x12345abc
  *    where the first number is the private key exponend, the second one is modulus and the third one is the public key exponent.
  *   -Signed use with -extract and -test to let the code know this is a signed pak
+ *   -Compress compress files in blocks when creating a pak file
+ *   -CompressionBlockSize=number size of the uncompressed blocks used with -compress (default is 64KB)
+ *   -Threads=number number of worker threads reading, compressing and hashing files (default is the number of cores, 0 builds serially)
+ *   -PathHashIndex write the flat path hash index instead of the filename/directory index
+ *   -BenchmarkIndex measures index memory and file lookup times for the specified pak file(s)
+ *   -Benchmark reads all files from the specified pak file(s) and reports throughput (optionally -BenchmarkReadSize=number)
  *   -GenerateKeys=filename generates encryption key pair for signing a pak file
  *   -P=prime will use a predefined prime number for generating encryption key file
  *   -Q=prime same as above, P != Q, GCD(P, Q) = 1 (which is always true if they're both prime)
@@ -563,7 +980,33 @@ int32 main(int32 ArgC, ANSICHAR* ArgV[])
 		FString PakFilename(ArgV[1]);
 		FPaths::MakeStandardFilename(PakFilename);
 
-		if (FParse::Param(FCommandLine::Get(), TEXT("Test")))
+		if (FParse::Param(FCommandLine::Get(), TEXT("BenchmarkIndex")))
+		{
+			// Benchmark all pak files specified on the command line so both index formats can be compared.
+			for (int32 Index = 1; Index < ArgC; Index++)
+			{
+				if (ArgV[Index][0] != '-')
+				{
+					FString BenchmarkPakFilename(ArgV[Index]);
+					FPaths::MakeStandardFilename(BenchmarkPakFilename);
+					Result |= BenchmarkPakIndex(*BenchmarkPakFilename) ? 0 : 1;
+				}
+			}
+		}
+		else if (FParse::Param(FCommandLine::Get(), TEXT("Benchmark")))
+		{
+			// Benchmark all pak files specified on the command line so compressed and uncompressed paks can be compared.
+			for (int32 Index = 1; Index < ArgC; Index++)
+			{
+				if (ArgV[Index][0] != '-')
+				{
+					FString BenchmarkPakFilename(ArgV[Index]);
+					FPaths::MakeStandardFilename(BenchmarkPakFilename);
+					Result |= BenchmarkPakFile(*BenchmarkPakFilename) ? 0 : 1;
+				}
+			}
+		}
+		else if (FParse::Param(FCommandLine::Get(), TEXT("Test")))
 		{
 			Result = TestPakFile(*PakFilename) ? 0 : 1;
 		}
@@ -597,7 +1040,23 @@ int32 main(int32 ArgC, ANSICHAR* ArgV[])
 				TArray<FPakInputPair> FilesToAdd;
 				CollectFilesToAdd(FilesToAdd, Entries);
 
-				Result = CreatePakFile(*PakFilename, FilesToAdd) ? 0 : 1;
+				FPakCompressionSettings Compression;
+				if (FParse::Param(FCommandLine::Get(), TEXT("Compress")))
+				{
+					Compression.CompressionMethod = COMPRESS_Default;
+					FParse::Value(FCommandLine::Get(), TEXT("CompressionBlockSize="), Compression.BlockSize);
+					Compression.BlockSize = FMath::Clamp<int32>(Compression.BlockSize, 4 * 1024, FCompression::MaxUncompressedSize);
+					UE_LOG(LogPakFile, Display, TEXT("Compressing files in %d byte blocks."), Compression.BlockSize);
+				}
+
+				// Read, compress and hash files on worker threads unless -Threads=0 is specified.
+				int32 NumWorkerThreads = FPlatformMisc::NumberOfCores();
+				FParse::Value(FCommandLine::Get(), TEXT("Threads="), NumWorkerThreads);
+				NumWorkerThreads = FPlatformProcess::SupportsMultithreading() ? FMath::Max(NumWorkerThreads, 0) : 0;
+
+				const bool bPathHashIndex = FParse::Param(FCommandLine::Get(), TEXT("PathHashIndex"));
+
+				Result = CreatePakFile(*PakFilename, FilesToAdd, Compression, NumWorkerThreads, bPathHashIndex) ? 0 : 1;
 			}
 		}
 	}
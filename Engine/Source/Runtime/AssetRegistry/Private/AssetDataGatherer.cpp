@@ -4,10 +4,42 @@
 
 #define MAX_FILES_TO_PROCESS_BEFORE_FLUSH 250
 
-FAssetDataGatherer::FAssetDataGatherer(const TArray<FString>& InPaths, bool bInIsSynchronous)
+/** Version of the asset data disk cache, increment when FDiskCachedAssetData or FBackgroundAssetData serialization changes */
+#define ASSET_DATA_CACHE_VERSION 1
+
+/** Magic number at the start of the asset data disk cache */
+static const uint32 AssetDataCacheMagic = 0xA55E7CAC;
+
+/** Reads a batch of package files, the files are picked off a shared counter by every thread taking part */
+struct FParallelAssetFileReads
+{
+	const FAssetDataGatherer* Gatherer;
+	const TArray<FString>* AssetFilenames;
+	TArray<FAssetDataGatherer::FAssetFileResult> Results;
+	FThreadSafeCounter NextIndex;
+
+	void Run()
+	{
+		for (int32 Index = NextIndex.Increment() - 1; Index < AssetFilenames->Num(); Index = NextIndex.Increment() - 1)
+		{
+			if ( Gatherer->StopTaskCounter.GetValue() != 0 )
+			{
+				// We have been asked to stop, so don't read any more files
+				break;
+			}
+
+			Gatherer->ReadAssetFileOrCache((*AssetFilenames)[Index], Results[Index]);
+		}
+	}
+};
+
+FAssetDataGatherer::FAssetDataGatherer(const TArray<FString>& InPaths, bool bInIsSynchronous, bool bInUseCache)
 	: StopTaskCounter( 0 )
 	, bIsSynchronous( bInIsSynchronous )
 	, SearchStartTime( 0 )
+	, bUseCache( bInUseCache )
+	, NumCachedFiles( 0 )
+	, NumUncachedFiles( 0 )
 {
 	const FString AllIllegalCharacters = INVALID_LONGPACKAGE_CHARACTERS;
 	for ( int32 CharIdx = 0; CharIdx < AllIllegalCharacters.Len() ; ++CharIdx )
@@ -19,6 +51,12 @@ FAssetDataGatherer::FAssetDataGatherer(const TArray<FString>& InPaths, bool bInI
 
 	bGatherDependsData = GIsEditor && !FParse::Param( FCommandLine::Get(), TEXT("NoDependsGathering") );
 
+	if ( FParse::Param( FCommandLine::Get(), TEXT("NoAssetRegistryCache") ) )
+	{
+		bUseCache = false;
+	}
+	CacheFilename = FPaths::GameIntermediateDir() / TEXT("CachedAssetRegistry.bin");
+
 	if ( bIsSynchronous )
 	{
 		Run();
@@ -40,8 +78,15 @@ uint32 FAssetDataGatherer::Run()
 	TArray<FBackgroundAssetData*> LocalAssetResults;
 	TArray<FPackageDependencyData> LocalDependencyResults;
 
+	if ( bUseCache )
+	{
+		LoadCache();
+	}
+
 	while ( StopTaskCounter.GetValue() == 0 )
 	{
+		bool bSearchCompleted = false;
+
 		// Check to see if there are any paths that need scanning for files.  On the first iteration, there will always
 		// be work to do here.  Later, if new paths are added on the fly, we'll also process those.
 		DiscoverFilesToSearch();
@@ -78,6 +123,7 @@ uint32 FAssetDataGatherer::Run()
 			{
 				SearchTimes.Add(FPlatformTime::Seconds() - SearchStartTime);
 				SearchStartTime = 0;
+				bSearchCompleted = PathsToSearch.Num() == 0;
 			}
 		}
 
@@ -93,30 +139,19 @@ uint32 FAssetDataGatherer::Run()
 
 		if ( LocalFilesToSearch.Num() )
 		{
-			for (int32 FileIdx = 0; FileIdx < LocalFilesToSearch.Num(); ++FileIdx)
-			{
-				const FString& AssetFile = LocalFilesToSearch[FileIdx];
-
-				if ( StopTaskCounter.GetValue() != 0 )
-				{
-					// We have been asked to stop, so don't read any more files
-					break;
-				}
-
-				TArray<FBackgroundAssetData*> AssetDataFromFile;
-				FPackageDependencyData DependencyData;
-
-				if ( ReadAssetFile(AssetFile, AssetDataFromFile, DependencyData) )
-				{
-					LocalAssetResults.Append(AssetDataFromFile);
-					LocalDependencyResults.Add(DependencyData);
-				}
-			}
+			ReadAssetFiles(LocalFilesToSearch, LocalAssetResults, LocalDependencyResults);
 
 			LocalFilesToSearch.Empty();
 		}
 		else
 		{
+			if ( bSearchCompleted && bUseCache )
+			{
+				// Later searches are for files that changed while running, those will be read again next session anyway
+				SaveCache();
+				bUseCache = false;
+			}
+
 			if (bIsSynchronous)
 			{
 				// This is synchronous. Since our work is done, we should safely exit
@@ -274,6 +309,186 @@ bool FAssetDataGatherer::IsValidPackageFileToRead(const FString& Filename) const
 	return false;
 }
 
+void FAssetDataGatherer::ReadAssetFiles(const TArray<FString>& AssetFilenames, TArray<FBackgroundAssetData*>& OutAssetResults, TArray<FPackageDependencyData>& OutDependencyResults)
+{
+	FParallelAssetFileReads Parallel;
+	Parallel.Gatherer = this;
+	Parallel.AssetFilenames = &AssetFilenames;
+	Parallel.Results.Empty(AssetFilenames.Num());
+	for (int32 FileIdx = 0; FileIdx < AssetFilenames.Num(); ++FileIdx)
+	{
+		FAssetFileResult* Result = new(Parallel.Results) FAssetFileResult;
+		Result->bSucceeded = false;
+		Result->bFromCache = false;
+	}
+
+	// Opening packages is mostly waiting for the disk, so the task graph workers help even if there are few cores
+	FGraphEventArray Tasks;
+	if ( FPlatformProcess::SupportsMultithreading() )
+	{
+		const int32 NumTasks = FMath::Min(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, AssetFilenames.Num());
+		for (int32 TaskIdx = 1; TaskIdx < NumTasks; ++TaskIdx)
+		{
+			new (Tasks) FGraphEventRef(FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
+				FSimpleDelegateGraphTask::FDelegate::CreateRaw(&Parallel, &FParallelAssetFileReads::Run),
+				TEXT("Read Asset Files"),
+				NULL,
+				ENamedThreads::AnyThread
+				));
+		}
+	}
+	// This thread does its share too instead of just waiting
+	Parallel.Run();
+	FTaskGraphInterface::Get().WaitUntilTasksComplete(Tasks, bIsSynchronous ? ENamedThreads::GameThread : ENamedThreads::AnyThread);
+
+	for (int32 FileIdx = 0; FileIdx < Parallel.Results.Num(); ++FileIdx)
+	{
+		FAssetFileResult& Result = Parallel.Results[FileIdx];
+		if ( !Result.bSucceeded )
+		{
+			continue;
+		}
+
+		OutAssetResults.Append(Result.AssetDataList);
+		OutDependencyResults.Add(Result.DependencyData);
+
+		if ( bUseCache )
+		{
+			NewCachedAssetDataMap.Add(Result.PackageName, Result.CachedData);
+			if ( Result.bFromCache )
+			{
+				NumCachedFiles++;
+			}
+			else
+			{
+				NumUncachedFiles++;
+			}
+		}
+	}
+}
+
+void FAssetDataGatherer::ReadAssetFileOrCache(const FString& AssetFilename, FAssetFileResult& OutResult) const
+{
+	if ( !bUseCache )
+	{
+		OutResult.bSucceeded = ReadAssetFile(AssetFilename, OutResult.AssetDataList, OutResult.DependencyData);
+		return;
+	}
+
+	const FString PackageName = FPackageName::FilenameToLongPackageName(AssetFilename);
+	const FDateTime Timestamp = IFileManager::Get().GetTimeStamp(*AssetFilename);
+	const int64 FileSize = IFileManager::Get().FileSize(*AssetFilename);
+
+	OutResult.PackageName = FName(*PackageName);
+
+	const FDiskCachedAssetData* CachedData = DiskCachedAssetDataMap.Find(OutResult.PackageName);
+	if ( CachedData && CachedData->IsUpToDate(Timestamp, FileSize) && (CachedData->bHasDependencyData || !bGatherDependsData) )
+	{
+		for (int32 AssetIdx = 0; AssetIdx < CachedData->AssetDataList.Num(); ++AssetIdx)
+		{
+			OutResult.AssetDataList.Add(new FBackgroundAssetData(CachedData->AssetDataList[AssetIdx]));
+		}
+
+		if ( bGatherDependsData )
+		{
+			CachedData->GetDependencyData(PackageName, OutResult.DependencyData);
+		}
+
+		OutResult.CachedData = *CachedData;
+		OutResult.bSucceeded = true;
+		OutResult.bFromCache = true;
+		return;
+	}
+
+	OutResult.bSucceeded = ReadAssetFile(AssetFilename, OutResult.AssetDataList, OutResult.DependencyData);
+	if ( OutResult.bSucceeded )
+	{
+		OutResult.CachedData = FDiskCachedAssetData(Timestamp, FileSize);
+		for (int32 AssetIdx = 0; AssetIdx < OutResult.AssetDataList.Num(); ++AssetIdx)
+		{
+			OutResult.CachedData.AssetDataList.Add(*OutResult.AssetDataList[AssetIdx]);
+		}
+
+		if ( bGatherDependsData )
+		{
+			OutResult.CachedData.SetDependencyData(OutResult.DependencyData);
+		}
+	}
+}
+
+void FAssetDataGatherer::LoadCache()
+{
+	const double LoadStartTime = FPlatformTime::Seconds();
+
+	FArchive* FileReader = IFileManager::Get().CreateFileReader(*CacheFilename);
+	if ( !FileReader )
+	{
+		return;
+	}
+
+	uint32 Magic = 0;
+	int32 CacheVersion = 0;
+	int32 PackageFileVersion = 0;
+	*FileReader << Magic;
+	*FileReader << CacheVersion;
+	*FileReader << PackageFileVersion;
+
+	if ( Magic == AssetDataCacheMagic && CacheVersion == ASSET_DATA_CACHE_VERSION && PackageFileVersion == GPackageFileUE4Version )
+	{
+		FNameAsStringProxyArchive Ar(*FileReader);
+		Ar << DiskCachedAssetDataMap;
+
+		if ( Ar.IsError() )
+		{
+			UE_LOG(LogAssetRegistry, Warning, TEXT("Asset data cache %s is corrupt, all packages will be read"), *CacheFilename);
+			DiskCachedAssetDataMap.Empty();
+		}
+	}
+
+	delete FileReader;
+
+	UE_LOG(LogAssetRegistry, Log, TEXT("Loaded %d packages from the asset data cache in %0.6f seconds"), DiskCachedAssetDataMap.Num(), FPlatformTime::Seconds() - LoadStartTime);
+}
+
+void FAssetDataGatherer::SaveCache()
+{
+	const double SaveStartTime = FPlatformTime::Seconds();
+
+	// Write to a temporary file first, so other processes never see a partly written cache
+	const FString TempFilename = CacheFilename + TEXT(".tmp");
+	FArchive* FileWriter = IFileManager::Get().CreateFileWriter(*TempFilename);
+	if ( !FileWriter )
+	{
+		return;
+	}
+
+	uint32 Magic = AssetDataCacheMagic;
+	int32 CacheVersion = ASSET_DATA_CACHE_VERSION;
+	int32 PackageFileVersion = GPackageFileUE4Version;
+	*FileWriter << Magic;
+	*FileWriter << CacheVersion;
+	*FileWriter << PackageFileVersion;
+
+	FNameAsStringProxyArchive Ar(*FileWriter);
+	Ar << NewCachedAssetDataMap;
+
+	const bool bSucceeded = !Ar.IsError() && FileWriter->Close();
+	delete FileWriter;
+
+	if ( bSucceeded && IFileManager::Get().Move(*CacheFilename, *TempFilename) )
+	{
+		UE_LOG(LogAssetRegistry, Log, TEXT("Saved %d packages to the asset data cache in %0.6f seconds, %d packages were found in the cache and %d had to be read"), NewCachedAssetDataMap.Num(), FPlatformTime::Seconds() - SaveStartTime, NumCachedFiles, NumUncachedFiles);
+	}
+	else
+	{
+		IFileManager::Get().Delete(*TempFilename);
+	}
+
+	// Nothing reads the cached data anymore
+	DiskCachedAssetDataMap.Empty();
+	NewCachedAssetDataMap.Empty();
+}
+
 bool FAssetDataGatherer::ReadAssetFile(const FString& AssetFilename, TArray<FBackgroundAssetData*>& AssetDataList, FPackageDependencyData& DependencyData) const
 {
 	FPackageReader PackageReader;
@@ -8,8 +8,8 @@
 class FAssetDataGatherer : public FRunnable
 {
 public:
-	/** Constructor */
-	FAssetDataGatherer(const TArray<FString>& Paths, bool bInIsSynchronous);
+	/** Constructor. Only a gatherer for all content paths should use the disk cache, the cache it saves only holds the packages it found. */
+	FAssetDataGatherer(const TArray<FString>& Paths, bool bInIsSynchronous, bool bInUseCache = false);
 
 	// FRunnable implementation
 	virtual bool Init() OVERRIDE;
@@ -48,6 +48,37 @@ private:
 	 */
 	bool ReadAssetFile(const FString& AssetFilename, TArray<FBackgroundAssetData*>& AssetDataList, FPackageDependencyData& DependencyData) const;
 
+	/** The results of reading one package file */
+	struct FAssetFileResult
+	{
+		/** The FBackgroundAssetData for every asset found in the file */
+		TArray<FBackgroundAssetData*> AssetDataList;
+		/** The FPackageDependencyData of the file */
+		FPackageDependencyData DependencyData;
+		/** The name of the package, only set when using the disk cache */
+		FName PackageName;
+		/** What is stored in the disk cache for the file */
+		FDiskCachedAssetData CachedData;
+		/** True if the file was read, or found in the disk cache */
+		bool bSucceeded;
+		/** True if the file was found in the disk cache */
+		bool bFromCache;
+	};
+
+	/** Gets the asset data of a file from the disk cache if it's unchanged, reads the file otherwise. Called on several threads at once. */
+	void ReadAssetFileOrCache(const FString& AssetFilename, FAssetFileResult& OutResult) const;
+
+	/** Reads a batch of files on task graph workers and this thread */
+	void ReadAssetFiles(const TArray<FString>& AssetFilenames, TArray<FBackgroundAssetData*>& OutAssetResults, TArray<FPackageDependencyData>& OutDependencyResults);
+
+	/** Loads the asset data of the last session from the disk cache */
+	void LoadCache();
+
+	/** Saves the asset data of all packages found so far to the disk cache */
+	void SaveCache();
+
+	friend struct FParallelAssetFileReads;
+
 private:
 	/** A critical section to protect data transfer to the main thread */
 	FCriticalSection WorkerThreadCriticalSection;
@@ -87,6 +118,22 @@ private:
 	/** Set of characters that are invalid in packages, thus files containing them can not be loaded. */
 	TSet<TCHAR> InvalidAssetFileCharacters;
 
+	/** True if package data is read from and saved to the disk cache. Turned off once the first search completes and the cache is saved. */
+	bool bUseCache;
+
+	/** The file the disk cache is stored in */
+	FString CacheFilename;
+
+	/** The asset data loaded from the disk cache, by package name. Not modified while files are being read. */
+	TMap<FName, FDiskCachedAssetData> DiskCachedAssetDataMap;
+
+	/** The asset data of all packages read or found in the cache during this session, by package name. This is what gets saved. */
+	TMap<FName, FDiskCachedAssetData> NewCachedAssetDataMap;
+
+	/** Number of files that were found in the disk cache and that had to be read */
+	int32 NumCachedFiles;
+	int32 NumUncachedFiles;
+
 public:
 	/** Thread to run the cleanup FRunnable on */
 	FRunnableThread* Thread;
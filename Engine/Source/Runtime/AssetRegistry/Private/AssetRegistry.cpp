@@ -179,11 +179,11 @@ void FAssetRegistry::SearchAllAssets(bool bSynchronousSearch)
 	// Start the asset search (synchronous in commandlets)
 	if ( bSynchronousSearch )
 	{
-		ScanPathsSynchronous(PathsToSearch);
+		ScanPathsSynchronous_Internal(PathsToSearch, /*bUseCache=*/true);
 	}
 	else
 	{
-		BackgroundAssetSearch = MakeShareable( new FAssetDataGatherer(PathsToSearch, bSynchronousSearch) );
+		BackgroundAssetSearch = MakeShareable( new FAssetDataGatherer(PathsToSearch, bSynchronousSearch, /*bUseCache=*/true) );
 	}
 }
 
@@ -1019,11 +1019,16 @@ bool FAssetRegistry::RemovePath(const FString& PathToRemove)
 }
 
 void FAssetRegistry::ScanPathsSynchronous(const TArray<FString>& InPaths)
+{
+	ScanPathsSynchronous_Internal(InPaths, /*bUseCache=*/false);
+}
+
+void FAssetRegistry::ScanPathsSynchronous_Internal(const TArray<FString>& InPaths, bool bUseCache)
 {
 	const double SearchStartTime = FPlatformTime::Seconds();
 
 	// Start the sync asset search
-	FAssetDataGatherer AssetSearch(InPaths, /*bSynchronous=*/true);
+	FAssetDataGatherer AssetSearch(InPaths, /*bSynchronous=*/true, bUseCache);
 
 	// Get the search results
 	TArray<FBackgroundAssetData*> AssetResults;
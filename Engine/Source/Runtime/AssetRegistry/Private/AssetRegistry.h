@@ -124,6 +124,9 @@ private:
 	/** Adds a list of files which will be searched for asset data */
 	void AddFilesToSearch (const TArray<FString>& Files);
 
+	/** Scans the given paths right away, optionally reading unchanged packages from the asset data disk cache */
+	void ScanPathsSynchronous_Internal(const TArray<FString>& InPaths, bool bUseCache);
+
 #if WITH_EDITOR
 	/** Called when a file in a content directory changes on disk */
 	void OnDirectoryChanged (const TArray<struct FFileChangeData>& Files);
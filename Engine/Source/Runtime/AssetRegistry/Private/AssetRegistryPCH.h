@@ -13,6 +13,7 @@ DECLARE_LOG_CATEGORY_EXTERN(LogAssetRegistry, Log, All);
 #include "PathTreeNode.h"
 #include "BackgroundAssetData.h"
 #include "PackageDependencyData.h"
+#include "DiskCachedAssetData.h"
 #include "PackageReader.h"
 #include "AssetDataGatherer.h"
 #include "AssetRegistry.h"
@@ -6,11 +6,28 @@
 class FBackgroundAssetData
 {
 public:
+	/** Default constructor, used when reading asset data from the disk cache */
+	FBackgroundAssetData() {}
+
 	/** Constructor */
 	FBackgroundAssetData(const FString& InPackageName, const FString& InPackagePath, const FString& InGroupNames, const FString& InAssetName, const FString& InAssetClass, const TMap<FString, FString>& InTags, const TArray<int32>& InChunkIDs);
 
 	/** Creates an AssetData object based on this object */
 	FAssetData ToAssetData() const;
+
+	/** Serializer used by the disk cache */
+	friend FArchive& operator<<(FArchive& Ar, FBackgroundAssetData& AssetData)
+	{
+		Ar << AssetData.ObjectPath;
+		Ar << AssetData.PackageName;
+		Ar << AssetData.PackagePath;
+		Ar << AssetData.GroupNames;
+		Ar << AssetData.AssetName;
+		Ar << AssetData.AssetClass;
+		Ar << AssetData.TagsAndValues;
+		Ar << AssetData.ChunkIDs;
+		return Ar;
+	}
 	
 	/** The object path for the asset in the form 'Package.GroupNames.AssetName' */
 	FString ObjectPath;
@@ -0,0 +1,78 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/** What the asset data gatherer read from a package file, kept in a cache on disk so unchanged packages don't have to be read again */
+class FDiskCachedAssetData
+{
+public:
+	/** Constructor */
+	FDiskCachedAssetData()
+		: FileSize(0)
+		, bHasDependencyData(false)
+	{}
+
+	FDiskCachedAssetData(const FDateTime& InTimestamp, int64 InFileSize)
+		: Timestamp(InTimestamp)
+		, FileSize(InFileSize)
+		, bHasDependencyData(false)
+	{}
+
+	/** Returns true if this entry was read from a file with the given timestamp and size */
+	bool IsUpToDate(const FDateTime& InTimestamp, int64 InFileSize) const
+	{
+		return Timestamp == InTimestamp && FileSize == InFileSize;
+	}
+
+	/** Remembers the packages a package imports from, the only part of the dependency data the asset registry uses */
+	void SetDependencyData(FPackageDependencyData& DependencyData)
+	{
+		TSet<FName> UniqueImportedPackages;
+		for (int32 ImportIdx = 0; ImportIdx < DependencyData.ImportMap.Num(); ++ImportIdx)
+		{
+			UniqueImportedPackages.Add(DependencyData.GetImportPackageName(ImportIdx));
+		}
+
+		ImportedPackages = UniqueImportedPackages.Array();
+		bHasDependencyData = true;
+	}
+
+	/** Creates dependency data with one import per imported package, which resolves to the same package dependencies as the original */
+	void GetDependencyData(const FString& PackageName, FPackageDependencyData& OutDependencyData) const
+	{
+		static const FName NAME_CoreUObjectPackage(TEXT("/Script/CoreUObject"));
+
+		OutDependencyData.PackageName = PackageName;
+		OutDependencyData.ImportMap.Empty(ImportedPackages.Num());
+
+		for (int32 PackageIdx = 0; PackageIdx < ImportedPackages.Num(); ++PackageIdx)
+		{
+			FObjectImport* Import = new(OutDependencyData.ImportMap) FObjectImport;
+			Import->ClassPackage = NAME_CoreUObjectPackage;
+			Import->ClassName = NAME_Package;
+			Import->ObjectName = ImportedPackages[PackageIdx];
+		}
+	}
+
+	/** Serializer, FNames have to be written through an FNameAsStringProxyArchive */
+	friend FArchive& operator<<(FArchive& Ar, FDiskCachedAssetData& CachedData)
+	{
+		Ar << CachedData.Timestamp;
+		Ar << CachedData.FileSize;
+		Ar << CachedData.AssetDataList;
+		Ar << CachedData.bHasDependencyData;
+		Ar << CachedData.ImportedPackages;
+		return Ar;
+	}
+
+	/** The timestamp of the package file when it was read */
+	FDateTime Timestamp;
+	/** The size of the package file when it was read */
+	int64 FileSize;
+	/** The assets found in the package */
+	TArray<FBackgroundAssetData> AssetDataList;
+	/** True if the package was read with dependency data */
+	bool bHasDependencyData;
+	/** The packages the package imports from */
+	TArray<FName> ImportedPackages;
+};
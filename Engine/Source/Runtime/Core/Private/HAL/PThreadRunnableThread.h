@@ -205,6 +205,9 @@ protected:
 		ThisThread->Run();
 		ThisThread->PostRun();
 
+		// The thread object may be deleted by now, release whatever the allocator cached for this thread
+		FMemory::FlushCurrentThreadCache();
+
 		pthread_exit(NULL);
 		return NULL;
 	}
@@ -0,0 +1,191 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivate.h"
+#include "Json.h"
+
+/**
+ * TJsonSaxReader handler that builds FJsonArenaValues in an FMemStack. Values are linked to their siblings as they
+ * are read, so nothing has to be grown or copied when an array or object gets more values.
+ */
+template <class CharType>
+class TJsonArenaBuilder
+{
+public:
+
+	typedef TJsonStringView<CharType> FStringView;
+
+	TJsonArenaBuilder(FMemStack& InArena)
+		: Arena(InArena)
+		, Root(NULL)
+	{
+	}
+
+	bool OnObjectStart(const FStringView& Identifier)
+	{
+		Open(AddValue(Identifier, EJson::Object));
+		return true;
+	}
+
+	bool OnObjectEnd()
+	{
+		Close();
+		return true;
+	}
+
+	bool OnArrayStart(const FStringView& Identifier)
+	{
+		Open(AddValue(Identifier, EJson::Array));
+		return true;
+	}
+
+	bool OnArrayEnd()
+	{
+		Close();
+		return true;
+	}
+
+	bool OnString(const FStringView& Identifier, const FStringView& Value)
+	{
+		FJsonArenaValue* NewValue = AddValue(Identifier, EJson::String);
+		NewValue->String = CopyString(Value, NewValue->Num);
+		return true;
+	}
+
+	bool OnNumber(const FStringView& Identifier, double Value)
+	{
+		AddValue(Identifier, EJson::Number)->Number = Value;
+		return true;
+	}
+
+	bool OnBoolean(const FStringView& Identifier, bool Value)
+	{
+		AddValue(Identifier, EJson::Boolean)->Boolean = Value;
+		return true;
+	}
+
+	bool OnNull(const FStringView& Identifier)
+	{
+		AddValue(Identifier, EJson::Null);
+		return true;
+	}
+
+	FJsonArenaValue* GetRoot() const
+	{
+		return Root;
+	}
+
+private:
+
+	/** An array or object that is being read, and its last value so far. */
+	struct FOpenValue
+	{
+		FJsonArenaValue* Value;
+		FJsonArenaValue* LastChild;
+	};
+
+	FJsonArenaValue* AddValue(const FStringView& Identifier, EJson::Type Type)
+	{
+		FJsonArenaValue* NewValue = new(Arena) FJsonArenaValue;
+		NewValue->Type = Type;
+		NewValue->Num = 0;
+		NewValue->Next = NULL;
+		NewValue->FirstChild = NULL;
+
+		int32 NameLen = 0;
+		NewValue->Name = Identifier.IsEmpty() ? TEXT("") : CopyString(Identifier, NameLen);
+
+		if (OpenValues.Num() == 0)
+		{
+			Root = NewValue;
+		}
+		else
+		{
+			FOpenValue& Parent = OpenValues.Last();
+			if (Parent.LastChild)
+			{
+				Parent.LastChild->Next = NewValue;
+			}
+			else
+			{
+				Parent.Value->FirstChild = NewValue;
+			}
+			Parent.LastChild = NewValue;
+			Parent.Value->Num++;
+		}
+		return NewValue;
+	}
+
+	void Open(FJsonArenaValue* Value)
+	{
+		FOpenValue& NewOpenValue = OpenValues[OpenValues.AddUninitialized()];
+		NewOpenValue.Value = Value;
+		NewOpenValue.LastChild = NULL;
+	}
+
+	void Close()
+	{
+		OpenValues.Pop();
+	}
+
+	const TCHAR* CopyString(const FStringView& View, int32& OutLen)
+	{
+		TCHAR* Chars = New<TCHAR>(Arena, View.Len + 1);
+		OutLen = View.Unescape(Chars);
+		Chars[OutLen] = 0;
+		return Chars;
+	}
+
+	FMemStack& Arena;
+	FJsonArenaValue* Root;
+	TArray<FOpenValue, TInlineAllocator<32> > OpenValues;
+};
+
+const FJsonArenaValue* FJsonArenaValue::FindField(const TCHAR* FieldName) const
+{
+	check(Type == EJson::Object);
+	for (const FJsonArenaValue* Field = FirstChild; Field; Field = Field->Next)
+	{
+		if (FCString::Strcmp(Field->Name, FieldName) == 0)
+		{
+			return Field;
+		}
+	}
+	return NULL;
+}
+
+FJsonArenaDocument::FJsonArenaDocument()
+	: Root(NULL)
+{
+}
+
+bool FJsonArenaDocument::Parse(const TCHAR* Json, int32 Len)
+{
+	return ParseInternal(Json, Len);
+}
+
+bool FJsonArenaDocument::ParseUTF8(const ANSICHAR* Json, int32 Len)
+{
+	return ParseInternal(Json, Len);
+}
+
+template <class CharType>
+bool FJsonArenaDocument::ParseInternal(const CharType* Json, int32 Len)
+{
+	// the old mark has to be popped before a new one goes on top of it
+	Root = NULL;
+	ArenaMark.Reset();
+	ArenaMark.Reset(new FMemMark(Arena));
+
+	TJsonArenaBuilder<CharType> Builder(Arena);
+	TJsonSaxReader<CharType> Reader(Json, Len);
+	if (!Reader.Parse(Builder))
+	{
+		ErrorMessage = Reader.GetErrorMessage();
+		ArenaMark.Reset();
+		return false;
+	}
+
+	ErrorMessage.Empty();
+	Root = Builder.GetRoot();
+	return true;
+}
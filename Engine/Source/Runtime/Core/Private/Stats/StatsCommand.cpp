@@ -908,10 +908,11 @@ struct FHUDGroupManager
 
 static FString LastFileSaved;
 
-FStatsWriteFile::FStatsWriteFile()
+FStatsWriteFile::FStatsWriteFile(bool bInCompact)
 	: File(NULL)
 	, AsyncTask(NULL)
 	, bFirstFrameWritten(false)
+	, bCompact(bInCompact)
 {
 }
 
@@ -951,6 +952,10 @@ void FStatsWriteFile::Stop()
 		StatsMasterEnableSubtract();
 		FStatsThreadState const& Stats = FStatsThreadState::GetLocalState();
 		Stats.NewFrameDelegate.RemoveThreadSafeSP(this->AsShared(), &FStatsWriteFile::NewFrame);
+		if (bCompact)
+		{
+			CompactStream.Flush();
+		}
 		SendTask();
 		SendTask();
 		if(AsyncTask)
@@ -970,8 +975,15 @@ void FStatsWriteFile::Stop()
 void FStatsWriteFile::NewFrame(int64 TargetFrame)
 {
 	SCOPE_CYCLE_COUNTER(STAT_StreamFile);
-	Stream.WriteCondensedFrame(TargetFrame);
-	if (Stream.OutData.Num() > 1024 * 1024)
+	if (bCompact)
+	{
+		CompactStream.WriteCondensedFrame(TargetFrame);
+	}
+	else
+	{
+		Stream.WriteCondensedFrame(TargetFrame);
+	}
+	if (GetOutData().Num() > 1024 * 1024)
 	{
 		SendTask();
 	}
@@ -994,10 +1006,10 @@ void FStatsWriteFile::SendTask()
 		delete AsyncTask;
 		AsyncTask = NULL;
 	}
-	if (Stream.OutData.Num())
+	if (GetOutData().Num())
 	{
-		AsyncTask = new FAsyncTask<FAsyncWriteWorker>(File, &Stream.OutData);
-		check(!Stream.OutData.Num());
+		AsyncTask = new FAsyncTask<FAsyncWriteWorker>(File, &GetOutData());
+		check(!GetOutData().Num());
 		AsyncTask->StartBackgroundTask();
 	}
 }
@@ -1140,11 +1152,27 @@ static void PrintStatsHelpToOutputDevice( FOutputDevice& Ar )
 	Ar.Log( TEXT("stat group list|listall|enable name|disable name|none|all|default - manages stats groups"));
 
 	Ar.Log( TEXT("stat startfile - starts dumping a capture"));
+	Ar.Log( TEXT("stat startcompactfile - starts dumping a delta encoded and compressed capture, see the StatsAnalyzer commandlet"));
 	Ar.Log( TEXT("stat stopfile - stops dumping a capture"));
 }
 
 static TSharedPtr<FStatsWriteFile, ESPMode::ThreadSafe> CurrentStatFile = NULL;
 
+/** Starts writing a capture to the file named by the next token of Cmd, replacing the current one. */
+static void StartStatFile(const TCHAR* Cmd, bool bCompact)
+{
+	CurrentStatFile = NULL;
+	FString File;
+	FParse::Token(Cmd, File, false);
+	TSharedPtr<FStatsWriteFile, ESPMode::ThreadSafe> StatFile = MakeShareable(new FStatsWriteFile(bCompact));
+	CurrentStatFile = StatFile;
+	CurrentStatFile->Start(File);
+	if (!CurrentStatFile->IsValid())
+	{
+		CurrentStatFile = NULL;
+	}
+}
+
 static void StatCmd(FString InCmd)
 {
 	FStatsThreadState& Stats = FStatsThreadState::GetLocalState();
@@ -1234,16 +1262,11 @@ static void StatCmd(FString InCmd)
 	}
 	else if( FParse::Command( &Cmd, TEXT( "STARTFILE" ) ) )
 	{
-		CurrentStatFile = NULL;
-		FString File;
-		FParse::Token(Cmd, File, false);
-		TSharedPtr<FStatsWriteFile, ESPMode::ThreadSafe> StatFile = MakeShareable(new FStatsWriteFile());
-		CurrentStatFile = StatFile;
-		CurrentStatFile->Start(File);
-		if (!CurrentStatFile->IsValid())
-		{
-			CurrentStatFile = NULL;
-		}
+		StartStatFile(Cmd, false);
+	}
+	else if( FParse::Command( &Cmd, TEXT( "STARTCOMPACTFILE" ) ) )
+	{
+		StartStatFile(Cmd, true);
 	}
 	else if( FParse::Command( &Cmd, TEXT( "STOPFILE" ) ) )
 	{
@@ -1353,7 +1376,7 @@ bool DirectStatsCommand(const TCHAR* Cmd, bool bBlockForCompletion /*= false*/,
 		{
 			PrintStatsHelpToOutputDevice( *Ar );
 		}
-		else if( FParse::Command( &TempCmd, TEXT( "STARTFILE" ) ) )
+		else if( FParse::Command( &TempCmd, TEXT( "STARTFILE" ) ) || FParse::Command( &TempCmd, TEXT( "STARTCOMPACTFILE" ) ) )
 		{
 			FString Extension = TEXT(".ue4stats");
 			AddArgs += TEXT(" ");
@@ -26,10 +26,56 @@ namespace EStatMagic
 	enum Type
 	{
 		MAGIC=0x7E1B83C1,
-		MAGIC_SWAPPED=0xC1831B7E
+		MAGIC_SWAPPED=0xC1831B7E,
+		/** Streams written by FStatsCompactWriteStream */
+		MAGIC_COMPACT=0x7E1B83C2,
+		MAGIC_COMPACT_SWAPPED=0xC2831B7E
 	};
 }
 
+/** Writes an unsigned value 7 bits at a time, the high bit of a byte tells if another one follows. */
+static void WriteStatsVarInt(FArchive& Ar, uint64 Value)
+{
+	do
+	{
+		uint8 Byte = uint8(Value & 0x7f);
+		Value >>= 7;
+		if (Value)
+		{
+			Byte |= 0x80;
+		}
+		Ar << Byte;
+	}
+	while (Value);
+}
+
+static uint64 ReadStatsVarInt(FArchive& Ar)
+{
+	uint64 Value = 0;
+	for (int32 Shift = 0; Shift < 64 && !Ar.IsError(); Shift += 7)
+	{
+		uint8 Byte = 0;
+		Ar << Byte;
+		Value |= uint64(Byte & 0x7f) << Shift;
+		if (!(Byte & 0x80))
+		{
+			break;
+		}
+	}
+	return Value;
+}
+
+/** Maps signed deltas to unsigned values so small negative numbers stay small. */
+FORCEINLINE static uint64 ZigZagEncode(int64 Value)
+{
+	return (uint64(Value) << 1) ^ uint64(Value >> 63);
+}
+
+FORCEINLINE static int64 ZigZagDecode(uint64 Value)
+{
+	return int64(Value >> 1) ^ -int64(Value & 1);
+}
+
 FRawStatStackNode::FRawStatStackNode(FRawStatStackNode const& Other)
 	: Meta(Other.Meta)
 {
@@ -488,6 +534,7 @@ FStatsThreadState::FStatsThreadState(FString const& Filename)
 		return;
 	}
 
+	bool bCompact = false;
 	uint32 Magic = 0;
 	*FileReader << Magic;
 	if (Magic == EStatMagic::MAGIC)
@@ -498,6 +545,15 @@ FStatsThreadState::FStatsThreadState(FString const& Filename)
 	{
 		FileReader->SetByteSwapping(true);
 	}
+	else if (Magic == EStatMagic::MAGIC_COMPACT)
+	{
+		bCompact = true;
+	}
+	else if (Magic == EStatMagic::MAGIC_COMPACT_SWAPPED)
+	{
+		bCompact = true;
+		FileReader->SetByteSwapping(true);
+	}
 	else
 	{
 		UE_LOG(LogStats2, Error, TEXT( "Could not open, bad magic: %s" ), *Filename );
@@ -507,27 +563,55 @@ FStatsThreadState::FStatsThreadState(FString const& Filename)
 
 	TArray<FStatMessage> Messages;
 
-	FStatsReadStream Stream;
-
-	while (FileReader->Tell() < Size)
+	if (bCompact)
 	{
-		FStatMessage Read(Stream.ReadMessage(*FileReader));
-		if (Read.NameAndInfo.GetField<EStatOperation>() == EStatOperation::AdvanceFrameEventGameThread)
+		FStatsCompactReadStream Stream;
+		TArray<FStatMessage> BlockMessages;
+
+		while (FileReader->Tell() < Size)
 		{
-			ProcessMetaDataForLoad(Messages);
-			if (CurrentGameFrame > 0 && Messages.Num())
+			BlockMessages.Reset();
+			if (!Stream.ReadBlock(*FileReader, BlockMessages))
 			{
-				check(!CondensedStackHistory.Contains(CurrentGameFrame));
-				TArray<FStatMessage>* Save = new TArray<FStatMessage>();
-				Exchange(*Save, Messages);
-				CondensedStackHistory.Add(CurrentGameFrame, Save);
-				GoodFrames.Add(CurrentGameFrame);
+				UE_LOG(LogStats2, Warning, TEXT( "Stats file ends in a partial block: %s" ), *Filename );
+				break;
+			}
+			for (int32 Index = 0; Index < BlockMessages.Num(); Index++)
+			{
+				AddLoadedMessage(BlockMessages[Index], Messages);
 			}
 		}
+	}
+	else
+	{
+		FStatsReadStream Stream;
 
-		new (Messages) FStatMessage(Read);
+		while (FileReader->Tell() < Size)
+		{
+			AddLoadedMessage(Stream.ReadMessage(*FileReader), Messages);
+		}
 	}
 	// meh, we will discard the last frame, but we will look for meta data
+
+	delete FileReader;
+}
+
+void FStatsThreadState::AddLoadedMessage(FStatMessage const& Read, TArray<FStatMessage>& Messages)
+{
+	if (Read.NameAndInfo.GetField<EStatOperation>() == EStatOperation::AdvanceFrameEventGameThread)
+	{
+		ProcessMetaDataForLoad(Messages);
+		if (CurrentGameFrame > 0 && Messages.Num())
+		{
+			check(!CondensedStackHistory.Contains(CurrentGameFrame));
+			TArray<FStatMessage>* Save = new TArray<FStatMessage>();
+			Exchange(*Save, Messages);
+			CondensedStackHistory.Add(CurrentGameFrame, Save);
+			GoodFrames.Add(CurrentGameFrame);
+		}
+	}
+
+	new (Messages) FStatMessage(Read);
 }
 
 void FStatsThreadState::AddMessages(TArray<FStatMessage>& InMessages)
@@ -1804,5 +1888,261 @@ void FStastsWriteStream::WriteCondensedFrame(int64 TargetFrame)
 	}
 }
 
+/*-----------------------------------------------------------------------------
+	FStatsCompactWriteStream
+-----------------------------------------------------------------------------*/
+
+FStatsCompactWriteStream::FStatsCompactWriteStream()
+{
+	// the magic is the only thing outside of the compressed blocks
+	{
+		FMemoryWriter Ar(OutData, false, true);
+		uint32 Magic = EStatMagic::MAGIC_COMPACT;
+		Ar << Magic;
+	}
+
+	FMemoryWriter Ar(BlockData, false, true);
+	FStatsThreadState const& Stats = FStatsThreadState::GetLocalState();
+	for (auto It = Stats.ShortNameToLongName.CreateConstIterator(); It; ++It)
+	{
+		WriteMessage(Ar, It.Value());
+	}
+}
+
+void FStatsCompactWriteStream::WriteCondensedFrame(int64 TargetFrame)
+{
+	{
+		FMemoryWriter Ar(BlockData, false, true);
+		FStatsThreadState const& Stats = FStatsThreadState::GetLocalState();
+		TArray<FStatMessage> const& Data = Stats.GetCondensedHistory(TargetFrame);
+		for (auto It = Data.CreateConstIterator(); It; ++It)
+		{
+			WriteMessage(Ar, *It);
+		}
+	}
+
+	// blocks always end on a frame boundary
+	if (BlockData.Num() >= BlockSize)
+	{
+		Flush();
+	}
+}
+
+void FStatsCompactWriteStream::Flush()
+{
+	if (!BlockData.Num())
+	{
+		return;
+	}
+
+	int32 UncompressedSize = BlockData.Num();
+	TArray<uint8> CompressedData;
+	CompressedData.AddUninitialized(UncompressedSize + UncompressedSize / 100 + 64);
+	int32 CompressedSize = CompressedData.Num();
+
+	// a block that doesn't get smaller is stored as is, the reader knows by the sizes being equal
+	const bool bCompressed = FCompression::CompressMemory((ECompressionFlags)(COMPRESS_ZLIB | COMPRESS_BiasSpeed), CompressedData.GetTypedData(), CompressedSize, BlockData.GetTypedData(), UncompressedSize)
+		&& CompressedSize < UncompressedSize;
+
+	FMemoryWriter Ar(OutData, false, true);
+	if (bCompressed)
+	{
+		Ar << UncompressedSize << CompressedSize;
+		Ar.Serialize(CompressedData.GetTypedData(), CompressedSize);
+	}
+	else
+	{
+		Ar << UncompressedSize << UncompressedSize;
+		Ar.Serialize(BlockData.GetTypedData(), UncompressedSize);
+	}
+	BlockData.Reset();
+}
+
+uint32 FStatsCompactWriteStream::WriteStatId(FArchive& Ar, FStatNameAndInfo NameAndInfo)
+{
+	FName RawName = NameAndInfo.GetRawName();
+	const int32 Number = NameAndInfo.GetRawNumber();
+	const uint64 Key = (uint64(uint32(RawName.GetIndex())) << 32) | uint32(Number);
+
+	uint32* ExistingId = StatIds.Find(Key);
+	if (ExistingId)
+	{
+		WriteStatsVarInt(Ar, *ExistingId);
+		return *ExistingId;
+	}
+
+	// a new id is always the next one, so the reader knows the meta data and string follow
+	const uint32 NewId = StatIds.Num();
+	StatIds.Add(Key, NewId);
+	WriteStatsVarInt(Ar, NewId);
+	WriteStatsVarInt(Ar, uint32(Number));
+	FString Name = RawName.ToString();
+	Ar << Name;
+	return NewId;
+}
+
+void FStatsCompactWriteStream::WriteMessage(FArchive& Ar, FStatMessage const& Item)
+{
+	const uint32 StatId = WriteStatId(Ar, Item.NameAndInfo);
+	UpdateThread(StatId, Item.NameAndInfo);
+	switch (Item.NameAndInfo.GetField<EStatDataType>())
+	{
+	case EStatDataType::ST_int64:
+		{
+			int64& LastValue = FindLastValue(StatId);
+			const int64 Payload = Item.GetValue_int64();
+			if (Item.NameAndInfo.GetFlag(EStatMetaFlags::IsPackedCCAndDuration))
+			{
+				// call counts and durations change independently, so they are sent as separate deltas
+				WriteStatsVarInt(Ar, ZigZagEncode(int64(FromPackedCallCountDuration_CallCount(Payload)) - int64(FromPackedCallCountDuration_CallCount(LastValue))));
+				WriteStatsVarInt(Ar, ZigZagEncode(int64(FromPackedCallCountDuration_Duration(Payload)) - int64(FromPackedCallCountDuration_Duration(LastValue))));
+			}
+			else
+			{
+				WriteStatsVarInt(Ar, ZigZagEncode(Payload - LastValue));
+			}
+			LastValue = Payload;
+		}
+		break;
+	case EStatDataType::ST_double:
+		{
+			double Payload = Item.GetValue_double();
+			Ar << Payload;
+		}
+		break;
+	case EStatDataType::ST_FName:
+		WriteStatId(Ar, FStatNameAndInfo(Item.GetValue_FName(), false));
+		break;
+	}
+}
+
+/*-----------------------------------------------------------------------------
+	FStatsCompactReadStream
+-----------------------------------------------------------------------------*/
+
+bool FStatsCompactReadStream::ReadStatId(FArchive& Ar, uint32& OutStatId, FStatNameAndInfo& OutNameAndInfo)
+{
+	OutStatId = uint32(ReadStatsVarInt(Ar));
+	if (OutStatId < uint32(Stats.Num()))
+	{
+		OutNameAndInfo = Stats[OutStatId];
+		return true;
+	}
+	if (OutStatId != uint32(Stats.Num()))
+	{
+		UE_LOG(LogStats2, Warning, TEXT("Missing stat id: %u"), OutStatId);
+		return false;
+	}
+
+	const int32 Number = int32(ReadStatsVarInt(Ar));
+	FString Name;
+	Ar << Name;
+	FStatNameAndInfo Result(FName(*Name), false);
+	Result.SetNumberDirect(Number);
+	Stats.Add(Result);
+	OutNameAndInfo = Result;
+	return !Ar.IsError();
+}
+
+bool FStatsCompactReadStream::ReadMessage(FArchive& Ar, FStatMessage& OutMessage)
+{
+	uint32 StatId = 0;
+	FStatNameAndInfo NameAndInfo;
+	if (!ReadStatId(Ar, StatId, NameAndInfo))
+	{
+		return false;
+	}
+	UpdateThread(StatId, NameAndInfo);
+
+	OutMessage = FStatMessage(NameAndInfo);
+	OutMessage.Clear();
+	switch (NameAndInfo.GetField<EStatDataType>())
+	{
+	case EStatDataType::ST_int64:
+		{
+			int64& LastValue = FindLastValue(StatId);
+			int64 Payload = 0;
+			if (NameAndInfo.GetFlag(EStatMetaFlags::IsPackedCCAndDuration))
+			{
+				const int64 CallCount = int64(FromPackedCallCountDuration_CallCount(LastValue)) + ZigZagDecode(ReadStatsVarInt(Ar));
+				const int64 Duration = int64(FromPackedCallCountDuration_Duration(LastValue)) + ZigZagDecode(ReadStatsVarInt(Ar));
+				Payload = ToPackedCallCountDuration(uint32(CallCount), uint32(Duration));
+			}
+			else
+			{
+				Payload = LastValue + ZigZagDecode(ReadStatsVarInt(Ar));
+			}
+			LastValue = Payload;
+			OutMessage.GetValue_int64() = Payload;
+		}
+		break;
+	case EStatDataType::ST_double:
+		{
+			double Payload = 0;
+			Ar << Payload;
+			OutMessage.GetValue_double() = Payload;
+		}
+		break;
+	case EStatDataType::ST_FName:
+		{
+			uint32 PayloadId = 0;
+			FStatNameAndInfo Payload;
+			if (!ReadStatId(Ar, PayloadId, Payload))
+			{
+				return false;
+			}
+			OutMessage.GetValue_FName() = Payload.GetRawName();
+		}
+		break;
+	}
+	return !Ar.IsError();
+}
+
+bool FStatsCompactReadStream::ReadBlock(FArchive& Ar, TArray<FStatMessage>& OutMessages)
+{
+	int32 UncompressedSize = 0;
+	int32 CompressedSize = 0;
+	if (Ar.TotalSize() - Ar.Tell() < int64(sizeof(UncompressedSize) + sizeof(CompressedSize)))
+	{
+		return false;
+	}
+	Ar << UncompressedSize << CompressedSize;
+	if (UncompressedSize <= 0 || CompressedSize <= 0 || CompressedSize > UncompressedSize || CompressedSize > Ar.TotalSize() - Ar.Tell())
+	{
+		return false;
+	}
+
+	TArray<uint8> CompressedData;
+	CompressedData.AddUninitialized(CompressedSize);
+	Ar.Serialize(CompressedData.GetTypedData(), CompressedSize);
+
+	TArray<uint8> BlockData;
+	if (CompressedSize == UncompressedSize)
+	{
+		Exchange(BlockData, CompressedData);
+	}
+	else
+	{
+		BlockData.AddUninitialized(UncompressedSize);
+		if (!FCompression::UncompressMemory(COMPRESS_ZLIB, BlockData.GetTypedData(), UncompressedSize, CompressedData.GetTypedData(), CompressedSize))
+		{
+			return false;
+		}
+	}
+
+	FMemoryReader BlockReader(BlockData);
+	BlockReader.SetByteSwapping(Ar.ForceByteSwapping());
+	while (BlockReader.Tell() < BlockData.Num())
+	{
+		FStatMessage Message;
+		if (!ReadMessage(BlockReader, Message))
+		{
+			return false;
+		}
+		new (OutMessages) FStatMessage(Message);
+	}
+	return true;
+}
+
 #endif
 
@@ -0,0 +1,190 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*================================================================================
+	MallocStressTest.cpp: Multithreaded allocator stress benchmark
+==================================================================================*/
+#include "CorePrivate.h"
+#include "MallocAnsi.h"
+#include "MallocBinned.h"
+#include "MallocJemalloc.h"
+#include "MallocTBB.h"
+#include "MallocThreadSafeProxy.h"
+
+/** Number of live allocation slots each thread works on. */
+static const int32 MallocStressSlotsPerThread = 4096;
+
+/** Number of malloc/free operations each thread performs per allocator. */
+static const int32 MallocStressOpsPerThread = 1000000;
+
+/**
+ * Worker that randomly allocates and frees blocks of mixed sizes: mostly small blocks,
+ * some up to the binned size limit and a few large ones.
+ */
+class FMallocStressWorker : public FRunnable
+{
+public:
+	FMallocStressWorker(FMalloc* InAllocator, FMallocBinned* InBinnedAllocator, int32 InSeed)
+		: Allocator(InAllocator)
+		, BinnedAllocator(InBinnedAllocator)
+		, RandomStream(InSeed)
+		, NumOps(0)
+	{
+	}
+
+	virtual uint32 Run() OVERRIDE
+	{
+		TArray<void*> Slots;
+		Slots.Init(NULL, MallocStressSlotsPerThread);
+
+		for (int32 OpIndex = 0; OpIndex < MallocStressOpsPerThread; OpIndex++)
+		{
+			const int32 SlotIndex = RandomStream.RandHelper(MallocStressSlotsPerThread);
+			if (Slots[SlotIndex])
+			{
+				Allocator->Free(Slots[SlotIndex]);
+				Slots[SlotIndex] = NULL;
+			}
+			else
+			{
+				const SIZE_T Size = GetRandomSize();
+				uint8* Ptr = (uint8*)Allocator->Malloc(Size, DEFAULT_ALIGNMENT);
+				// Touch the first and last byte so the working set reflects the allocation
+				Ptr[0] = 1;
+				Ptr[Size - 1] = 1;
+				Slots[SlotIndex] = Ptr;
+			}
+		}
+
+		for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); SlotIndex++)
+		{
+			Allocator->Free(Slots[SlotIndex]);
+		}
+		NumOps = MallocStressOpsPerThread + Slots.Num();
+		return 0;
+	}
+
+	virtual void Exit() OVERRIDE
+	{
+#ifdef USE_THREAD_CACHE
+		if (BinnedAllocator)
+		{
+			BinnedAllocator->FlushCurrentThreadCache();
+		}
+#endif
+	}
+
+	int32 GetNumOps() const
+	{
+		return NumOps;
+	}
+
+private:
+	SIZE_T GetRandomSize() const
+	{
+		const float Kind = RandomStream.GetFraction();
+		if (Kind < 0.85f)
+		{
+			return RandomStream.RandRange(1, 256);
+		}
+		if (Kind < 0.99f)
+		{
+			return RandomStream.RandRange(257, 32 * 1024);
+		}
+		return RandomStream.RandRange(32 * 1024 + 1, 512 * 1024);
+	}
+
+	FMalloc* Allocator;
+	FMallocBinned* BinnedAllocator;
+	FRandomStream RandomStream;
+	volatile int32 NumOps;
+};
+
+/**
+ * Runs the stress workers against one allocator on NumThreads threads.
+ *
+ * @param Allocator			Allocator to test.
+ * @param BinnedAllocator	Same allocator if it's an FMallocBinned, so workers can flush their thread caches.
+ * @param NumThreads		Number of worker threads.
+ * @param OutOpsPerSecond	Malloc and free calls per second over all threads.
+ * @param OutPeakWorkingSet	Peak growth of the process working set while the workers ran.
+ */
+static void RunMallocStress(FMalloc* Allocator, FMallocBinned* BinnedAllocator, int32 NumThreads, double& OutOpsPerSecond, uint64& OutPeakWorkingSet)
+{
+	const uint64 StartWorkingSet = FPlatformMemory::GetStats().WorkingSetSize;
+	uint64 PeakWorkingSet = StartWorkingSet;
+
+	TArray<FMallocStressWorker*> Workers;
+	TArray<FRunnableThread*> Threads;
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ThreadIndex++)
+	{
+		FMallocStressWorker* Worker = new FMallocStressWorker(Allocator, BinnedAllocator, 0x1234 + ThreadIndex);
+		Workers.Add(Worker);
+		Threads.Add(FRunnableThread::Create(Worker, *FString::Printf(TEXT("MallocStress%d"), ThreadIndex)));
+	}
+
+	for (int32 ThreadIndex = 0; ThreadIndex < Threads.Num(); ThreadIndex++)
+	{
+		// Threads can't be polled for completion, so sample the working set while waiting on each in turn
+		while (Workers[ThreadIndex]->GetNumOps() == 0)
+		{
+			PeakWorkingSet = FMath::Max<uint64>(PeakWorkingSet, FPlatformMemory::GetStats().WorkingSetSize);
+			FPlatformProcess::Sleep(0.005f);
+		}
+		Threads[ThreadIndex]->WaitForCompletion();
+	}
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+	int64 TotalOps = 0;
+	for (int32 ThreadIndex = 0; ThreadIndex < Threads.Num(); ThreadIndex++)
+	{
+		TotalOps += Workers[ThreadIndex]->GetNumOps();
+		delete Threads[ThreadIndex];
+		delete Workers[ThreadIndex];
+	}
+
+	OutOpsPerSecond = Elapsed > 0.0 ? TotalOps / Elapsed : 0.0;
+	OutPeakWorkingSet = PeakWorkingSet - StartWorkingSet;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMallocStressTest, "Core.HAL.Malloc Stress", EAutomationTestFlags::ATF_Editor | EAutomationTestFlags::ATF_Commandlet)
+
+bool FMallocStressTest::RunTest(const FString& Parameters)
+{
+	const int32 NumThreads = FMath::Max(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 1);
+
+	// Allocators are never freed, the OS memory they hold is reused by later runs of the test
+	// Wrapped the same way GMalloc is when the allocator isn't thread safe by itself
+	static FMalloc* AnsiMalloc = new FMallocAnsi();
+	static FMalloc* AnsiAllocator = AnsiMalloc->IsInternallyThreadSafe() ? AnsiMalloc : new FMallocThreadSafeProxy(AnsiMalloc);
+	static FMallocBinned* BinnedAllocator = new FMallocBinned((uint32)(FPlatformMemory::GetConstants().PageSize & MAX_uint32), (uint64)MAX_uint32 + 1);
+#if PLATFORM_SUPPORTS_JEMALLOC
+	static FMallocJemalloc* JemallocAllocator = new FMallocJemalloc();
+#endif
+#if PLATFORM_SUPPORTS_TBB && TBB_ALLOCATOR_ALLOWED
+	static FMallocTBB* TBBAllocator = new FMallocTBB();
+#endif
+
+	TArray<FMalloc*> Allocators;
+	Allocators.Add(AnsiAllocator);
+	Allocators.Add(BinnedAllocator);
+#if PLATFORM_SUPPORTS_JEMALLOC
+	Allocators.Add(JemallocAllocator);
+#endif
+#if PLATFORM_SUPPORTS_TBB && TBB_ALLOCATOR_ALLOWED
+	Allocators.Add(TBBAllocator);
+#endif
+
+	AddLogItem(FString::Printf(TEXT("%d threads, %d ops per thread. Peak working set is the growth during the run, memory kept by an allocator from an earlier run isn't counted."), NumThreads, MallocStressOpsPerThread));
+	for (int32 AllocatorIndex = 0; AllocatorIndex < Allocators.Num(); AllocatorIndex++)
+	{
+		FMalloc* Allocator = Allocators[AllocatorIndex];
+		double OpsPerSecond = 0.0;
+		uint64 PeakWorkingSet = 0;
+		RunMallocStress(Allocator, Allocator == BinnedAllocator ? BinnedAllocator : NULL, NumThreads, OpsPerSecond, PeakWorkingSet);
+		AddLogItem(FString::Printf(TEXT("%-10s %10.2f Mops/s, peak working set +%.2f MB"),
+			Allocator->GetDescriptiveName(), OpsPerSecond / 1000000.0, PeakWorkingSet / 1024.0 / 1024.0));
+	}
+
+	return true;
+}
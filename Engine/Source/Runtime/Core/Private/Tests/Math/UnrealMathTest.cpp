@@ -577,6 +577,10 @@ bool FVectorRegisterAbstractionTest::RunTest(const FString& Parameters)
 	V3 = MakeVectorRegister( (uint32)0, (uint32)0, (uint32)0, (uint32)-1 );
 	LogTest( TEXT("VectorCompareGT"), TestVectorsEqualBitwise( V2, V3 ) );
 
+	V0 = MakeVectorRegister( 3.0f, 1.0f, 7.0f, 2.0f );
+	V1 = MakeVectorRegister( 2.0f, 4.0f, 6.0f, 8.0f );
+	LogTest( TEXT("VectorMaskBits"), VectorMaskBits( VectorCompareGT( V0, V1 ) ) == 0x5 );
+
 	V0 = MakeVectorRegister( 1.0f, 3.0f, 2.0f, 8.0f );
 	V1 = MakeVectorRegister( 2.0f, 4.0f, 2.0f, 1.0f );
 	V2 = VectorCompareGE( V0, V1 );
@@ -0,0 +1,232 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	JsonParseBenchmark.cpp: Parse throughput of FJsonSerializer, TJsonSaxReader
+	and FJsonArenaDocument on the same document.
+=============================================================================*/
+
+#include "CorePrivate.h"
+#include "AutomationTest.h"
+#include "Json.h"
+
+/** Number of items in the generated document. */
+static const int32 JsonBenchmarkNumItems = 20000;
+
+/** Number of times each parser reads the document. */
+static const int32 JsonBenchmarkNumRuns = 5;
+
+/** Builds a document with an "items" array of objects, every item has an "id" field equal to its index. */
+static FString MakeJsonBenchmarkDocument()
+{
+	FString Json;
+	Json.Reserve(JsonBenchmarkNumItems * 160);
+	Json += TEXT("{\"name\":\"benchmark\",\"items\":[");
+	for (int32 Idx = 0; Idx < JsonBenchmarkNumItems; Idx++)
+	{
+		if (Idx > 0)
+		{
+			Json += TEXT(",");
+		}
+		Json += FString::Printf(
+			TEXT("{\"id\":%d,\"name\":\"Item_%d\",\"weight\":%d.25e-1,\"enabled\":%s,\"parent\":null,")
+			TEXT("\"tags\":[\"a\",\"b\\\"quoted\\\"\",\"\\u00e9t\\u00e9\"],\"note\":\"line\\nbreak \\\\ slash\"}"),
+			Idx, Idx, Idx % 1000, (Idx & 1) ? TEXT("true") : TEXT("false"));
+	}
+	Json += TEXT("]}");
+	return Json;
+}
+
+/** TJsonSaxReader handler that counts values and adds up the "id" fields. */
+template <class CharType>
+struct TJsonBenchmarkCounter
+{
+	typedef TJsonStringView<CharType> FStringView;
+
+	int32 NumValues;
+	int32 NumStrings;
+	double IdSum;
+
+	TJsonBenchmarkCounter()
+		: NumValues(0)
+		, NumStrings(0)
+		, IdSum(0.0)
+	{
+	}
+
+	bool OnObjectStart(const FStringView& Identifier) { NumValues++; return true; }
+	bool OnObjectEnd() { return true; }
+	bool OnArrayStart(const FStringView& Identifier) { NumValues++; return true; }
+	bool OnArrayEnd() { return true; }
+	bool OnString(const FStringView& Identifier, const FStringView& Value) { NumValues++; NumStrings++; return true; }
+	bool OnBoolean(const FStringView& Identifier, bool Value) { NumValues++; return true; }
+	bool OnNull(const FStringView& Identifier) { NumValues++; return true; }
+
+	bool OnNumber(const FStringView& Identifier, double Value)
+	{
+		NumValues++;
+		if (Identifier.Equals("id"))
+		{
+			IdSum += Value;
+		}
+		return true;
+	}
+};
+
+/** Adds up the "id" fields of the items of an arena document, -1 if the document doesn't have the expected layout. */
+static double SumArenaDocumentIds(const FJsonArenaDocument& Document)
+{
+	const FJsonArenaValue* Root = Document.GetRoot();
+	const FJsonArenaValue* Items = Root ? Root->FindField(TEXT("items"), EJson::Array) : NULL;
+	if (!Items || Items->Num != JsonBenchmarkNumItems)
+	{
+		return -1.0;
+	}
+
+	double IdSum = 0.0;
+	for (const FJsonArenaValue* Item = Items->FirstChild; Item; Item = Item->Next)
+	{
+		const FJsonArenaValue* Id = Item->Type == EJson::Object ? Item->FindField(TEXT("id"), EJson::Number) : NULL;
+		if (!Id)
+		{
+			return -1.0;
+		}
+		IdSum += Id->AsNumber();
+	}
+	return IdSum;
+}
+
+/** @return megabytes per second for reading the document JsonBenchmarkNumRuns times in the given number of seconds */
+static double JsonBenchmarkThroughput(int32 NumBytes, double Seconds)
+{
+	return Seconds > 0.0 ? (double)NumBytes * JsonBenchmarkNumRuns / (1024.0 * 1024.0) / Seconds : 0.0;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJsonParseBenchmark, "Core.Serialization.Json Parse Benchmark", EAutomationTestFlags::ATF_Editor | EAutomationTestFlags::ATF_Commandlet)
+
+/**
+ * Parses a generated document with FJsonSerializer, TJsonSaxReader and FJsonArenaDocument (from TCHARs and from UTF-8).
+ * All of them have to see the same ids, and the arena document has to keep escaped strings intact.
+ */
+bool FJsonParseBenchmark::RunTest(const FString& Parameters)
+{
+	const FString Json = MakeJsonBenchmarkDocument();
+	FTCHARToUTF8 JsonUTF8(*Json);
+	const int32 NumBytes = Json.Len() * sizeof(TCHAR);
+	const double ExpectedIdSum = (double)JsonBenchmarkNumItems * (JsonBenchmarkNumItems - 1) / 2.0;
+
+	// FJsonSerializer
+	double DomIdSum = 0.0;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Run = 0; Run < JsonBenchmarkNumRuns; Run++)
+	{
+		TSharedPtr<FJsonObject> Object;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Object) || !Object.IsValid())
+		{
+			AddError(TEXT("FJsonSerializer failed to read the benchmark document"));
+			return false;
+		}
+		DomIdSum = 0.0;
+		const TArray< TSharedPtr<FJsonValue> >& Items = Object->GetArrayField(TEXT("items"));
+		for (int32 Idx = 0; Idx < Items.Num(); Idx++)
+		{
+			DomIdSum += Items[Idx]->AsObject()->GetNumberField(TEXT("id"));
+		}
+	}
+	const double DomTime = FPlatformTime::Seconds() - StartTime;
+
+	// TJsonSaxReader
+	TJsonBenchmarkCounter<TCHAR> Counter;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Run = 0; Run < JsonBenchmarkNumRuns; Run++)
+	{
+		Counter = TJsonBenchmarkCounter<TCHAR>();
+		TJsonSaxReader<TCHAR> Reader(*Json, Json.Len());
+		if (!Reader.Parse(Counter))
+		{
+			AddError(FString::Printf(TEXT("TJsonSaxReader failed to read the benchmark document: %s"), *Reader.GetErrorMessage()));
+			return false;
+		}
+	}
+	const double SaxTime = FPlatformTime::Seconds() - StartTime;
+
+	TJsonBenchmarkCounter<ANSICHAR> CounterUTF8;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Run = 0; Run < JsonBenchmarkNumRuns; Run++)
+	{
+		CounterUTF8 = TJsonBenchmarkCounter<ANSICHAR>();
+		TJsonSaxReader<ANSICHAR> Reader(JsonUTF8.Get(), JsonUTF8.Length());
+		if (!Reader.Parse(CounterUTF8))
+		{
+			AddError(FString::Printf(TEXT("TJsonSaxReader failed to read the UTF-8 benchmark document: %s"), *Reader.GetErrorMessage()));
+			return false;
+		}
+	}
+	const double SaxUTF8Time = FPlatformTime::Seconds() - StartTime;
+
+	// FJsonArenaDocument, reusing the same document so later runs reuse its arena memory
+	FJsonArenaDocument Document;
+	double ArenaIdSum = 0.0;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Run = 0; Run < JsonBenchmarkNumRuns; Run++)
+	{
+		if (!Document.Parse(*Json, Json.Len()))
+		{
+			AddError(FString::Printf(TEXT("FJsonArenaDocument failed to read the benchmark document: %s"), *Document.GetErrorMessage()));
+			return false;
+		}
+		ArenaIdSum = SumArenaDocumentIds(Document);
+	}
+	const double ArenaTime = FPlatformTime::Seconds() - StartTime;
+	const int32 ArenaSize = Document.GetAllocatedSize();
+
+	FJsonArenaDocument DocumentUTF8;
+	double ArenaUTF8IdSum = 0.0;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Run = 0; Run < JsonBenchmarkNumRuns; Run++)
+	{
+		if (!DocumentUTF8.ParseUTF8(JsonUTF8.Get(), JsonUTF8.Length()))
+		{
+			AddError(FString::Printf(TEXT("FJsonArenaDocument failed to read the UTF-8 benchmark document: %s"), *DocumentUTF8.GetErrorMessage()));
+			return false;
+		}
+		ArenaUTF8IdSum = SumArenaDocumentIds(DocumentUTF8);
+	}
+	const double ArenaUTF8Time = FPlatformTime::Seconds() - StartTime;
+
+	TestEqual(TEXT("FJsonSerializer must read every id"), DomIdSum, ExpectedIdSum);
+	TestEqual(TEXT("TJsonSaxReader must read every id"), Counter.IdSum, ExpectedIdSum);
+	TestEqual(TEXT("TJsonSaxReader must read every id from UTF-8"), CounterUTF8.IdSum, ExpectedIdSum);
+	TestEqual(TEXT("TJsonSaxReader must see the same values in TCHAR and UTF-8"), CounterUTF8.NumValues, Counter.NumValues);
+	TestEqual(TEXT("FJsonArenaDocument must read every id"), ArenaIdSum, ExpectedIdSum);
+	TestEqual(TEXT("FJsonArenaDocument must read every id from UTF-8"), ArenaUTF8IdSum, ExpectedIdSum);
+
+	// escapes and multi-byte characters have to come out the same as through FJsonSerializer
+	const FJsonArenaValue* LastItem = NULL;
+	for (const FJsonArenaValue* Item = DocumentUTF8.GetRoot()->FindField(TEXT("items"))->FirstChild; Item; Item = Item->Next)
+	{
+		LastItem = Item;
+	}
+	const FJsonArenaValue* Tags = LastItem->FindField(TEXT("tags"), EJson::Array);
+	const FJsonArenaValue* Note = LastItem->FindField(TEXT("note"), EJson::String);
+	TestTrue(TEXT("Items must have three tags"), Tags && Tags->Num == 3);
+	if (Tags && Tags->Num == 3 && Note)
+	{
+		TestEqual(TEXT("Escaped quotes must be unescaped"), FString(Tags->FirstChild->Next->AsString()), FString(TEXT("b\"quoted\"")));
+		TestEqual(TEXT("Escaped unicode characters must be decoded"), FString(Tags->FirstChild->Next->Next->AsString()), FString(TEXT("\x00e9t\x00e9")));
+		TestEqual(TEXT("Escaped control characters must be unescaped"), FString(Note->AsString()), FString(TEXT("line\nbreak \\ slash")));
+	}
+
+	FJsonArenaDocument BadDocument;
+	TestFalse(TEXT("A truncated document must fail to parse"), BadDocument.Parse(*Json, Json.Len() / 2));
+	TestTrue(TEXT("A document that failed to parse must not have a root"), BadDocument.GetRoot() == NULL);
+
+	AddLogItem(FString::Printf(TEXT("%d items, %.2fMB of TCHARs, %d values, %d runs, arena uses %.2fMB"),
+		JsonBenchmarkNumItems, NumBytes / (1024.0 * 1024.0), Counter.NumValues, JsonBenchmarkNumRuns, ArenaSize / (1024.0 * 1024.0)));
+	AddLogItem(FString::Printf(TEXT("FJsonSerializer             %8.2fms %8.2fMB/s"), DomTime * 1000.0, JsonBenchmarkThroughput(NumBytes, DomTime)));
+	AddLogItem(FString::Printf(TEXT("TJsonSaxReader              %8.2fms %8.2fMB/s"), SaxTime * 1000.0, JsonBenchmarkThroughput(NumBytes, SaxTime)));
+	AddLogItem(FString::Printf(TEXT("TJsonSaxReader (UTF-8)      %8.2fms %8.2fMB/s"), SaxUTF8Time * 1000.0, JsonBenchmarkThroughput(JsonUTF8.Length(), SaxUTF8Time)));
+	AddLogItem(FString::Printf(TEXT("FJsonArenaDocument          %8.2fms %8.2fMB/s"), ArenaTime * 1000.0, JsonBenchmarkThroughput(NumBytes, ArenaTime)));
+	AddLogItem(FString::Printf(TEXT("FJsonArenaDocument (UTF-8)  %8.2fms %8.2fMB/s"), ArenaUTF8Time * 1000.0, JsonBenchmarkThroughput(JsonUTF8.Length(), ArenaUTF8Time)));
+
+	return true;
+}
@@ -13,7 +13,7 @@ DEFINE_LOG_CATEGORY_STATIC(LogUnrealNames, Log, All);
 	FName helpers.
 -----------------------------------------------------------------------------*/
 
-FNameEntry* AllocateNameEntry( const void* Name, NAME_INDEX Index, FNameEntry* HashNext, bool bIsPureAnsi );
+FNameEntry* AllocateNameEntry( const void* Name, NAME_INDEX Index, bool bIsPureAnsi );
 
 /**
 * Helper function that can be used inside the debuggers watch window. E.g. "DebugFName(Class->Name.Index)". 
@@ -223,6 +223,219 @@ FNameEntry*** FName::GetNameTableForDebuggerVisualizers_MT()
 }
 
 
+/*-----------------------------------------------------------------------------
+	FNameHashTable.
+-----------------------------------------------------------------------------*/
+
+/**
+ * Hash table mapping name strings to name entries.
+ *
+ * Lookups never lock. The table uses open addressing with linear probing, slots only ever change from
+ * NULL to an entry and growing publishes a new slot array with a single pointer write. Slot arrays
+ * replaced by a grow are never freed since lookups may still be probing them, together they are smaller
+ * than the current array. Adds lock one of LockStripeCount stripes picked by the hash so adds of different
+ * names rarely wait on each other, and the table doubles once it's half full rather than chaining more
+ * and more names into a fixed number of buckets.
+ */
+class FNameHashTable
+{
+public:
+	enum
+	{
+		/** Number of locks adds are spread over, must be a power of two. */
+		LockStripeCount = 64
+	};
+
+	FNameHashTable()
+		: Slots(AllocateSlots(FNameDefs::NameHashBucketCount, NULL))
+		, NumEntries(0)
+	{
+		check((FNameDefs::NameHashBucketCount & (FNameDefs::NameHashBucketCount - 1)) == 0);
+	}
+
+	/**
+	 * Finds the entry for a name without locking.
+	 *
+	 * @param Name	Name to find, an entry only matches if it is stored with the same character width
+	 * @param Hash	Case insensitive hash of the name
+	 * @return the entry or NULL if the name isn't in the table
+	 */
+	template<typename CharType>
+	FNameEntry* Find( const CharType* Name, uint32 Hash ) const
+	{
+		const FSlotArray* CurrentSlots = Slots;
+		for( uint32 SlotIndex = Hash & CurrentSlots->Mask; ; SlotIndex = (SlotIndex + 1) & CurrentSlots->Mask )
+		{
+			FNameEntry* Entry = CurrentSlots->Entries[SlotIndex];
+			if( !Entry )
+			{
+				return NULL;
+			}
+			FPlatformMisc::Prefetch( CurrentSlots->Entries[(SlotIndex + 1) & CurrentSlots->Mask] );
+			if( Entry->IsEqual( Name ) )
+			{
+				return Entry;
+			}
+		}
+	}
+
+	/**
+	 * Finds the first entry with the same name as the passed in one.
+	 */
+	FNameEntry* Find( const FNameEntry* Entry ) const
+	{
+		return Entry->IsWide() ? Find( Entry->GetWideName(), Entry->GetNameHash() ) : Find( Entry->GetAnsiName(), Entry->GetNameHash() );
+	}
+
+	/**
+	 * Returns the lock to hold while checking for and adding a name with this hash.
+	 */
+	FCriticalSection& GetStripeLock( uint32 Hash )
+	{
+		return StripeLocks[Hash & (LockStripeCount - 1)];
+	}
+
+	/**
+	 * Adds an entry. The caller must hold the stripe lock for the hash and have checked that the
+	 * name isn't in the table yet.
+	 *
+	 * @return true if the table should grow, which the caller has to do after releasing the stripe lock
+	 */
+	bool Add( FNameEntry* Entry, uint32 Hash )
+	{
+		FSlotArray* CurrentSlots = Slots;
+		for( uint32 SlotIndex = Hash & CurrentSlots->Mask; ; SlotIndex = (SlotIndex + 1) & CurrentSlots->Mask )
+		{
+			// Names from other stripes can be added to the same slot at the same time.
+			if( !CurrentSlots->Entries[SlotIndex] 
+			&&	FPlatformAtomics::InterlockedCompareExchangePointer( (void**)&CurrentSlots->Entries[SlotIndex], Entry, NULL ) == NULL )
+			{
+				break;
+			}
+		}
+		return FPlatformAtomics::InterlockedIncrement( &NumEntries ) > (int32)(CurrentSlots->Mask / 2);
+	}
+
+	/**
+	 * Doubles the number of slots if the table is still more than half full. Waits for all adds to finish.
+	 */
+	void Grow()
+	{
+		for( int32 StripeIndex = 0; StripeIndex < LockStripeCount; StripeIndex++ )
+		{
+			StripeLocks[StripeIndex].Lock();
+		}
+
+		FSlotArray* OldSlots = Slots;
+		if( NumEntries > (int32)(OldSlots->Mask / 2) )
+		{
+			FSlotArray* NewSlots = AllocateSlots( (OldSlots->Mask + 1) * 2, OldSlots );
+			for( uint32 OldIndex = 0; OldIndex <= OldSlots->Mask; OldIndex++ )
+			{
+				FNameEntry* Entry = OldSlots->Entries[OldIndex];
+				if( Entry )
+				{
+					uint32 SlotIndex = Entry->GetNameHash() & NewSlots->Mask;
+					while( NewSlots->Entries[SlotIndex] )
+					{
+						SlotIndex = (SlotIndex + 1) & NewSlots->Mask;
+					}
+					NewSlots->Entries[SlotIndex] = Entry;
+				}
+			}
+
+			// Lookups must not see the new array before its entries.
+			FPlatformMisc::MemoryBarrier();
+			Slots = NewSlots;
+		}
+
+		for( int32 StripeIndex = LockStripeCount - 1; StripeIndex >= 0; StripeIndex-- )
+		{
+			StripeLocks[StripeIndex].Unlock();
+		}
+	}
+
+	/**
+	 * Logs the size and probe lengths of the table.
+	 */
+	void Dump( FOutputDevice& Ar ) const
+	{
+		const FSlotArray* CurrentSlots = Slots;
+		int32 NameCount = 0, TotalProbes = 0, MaxProbes = 0, MemUsed = 0;
+		for( uint32 SlotIndex = 0; SlotIndex <= CurrentSlots->Mask; SlotIndex++ )
+		{
+			FNameEntry* Entry = CurrentSlots->Entries[SlotIndex];
+			if( Entry )
+			{
+				NameCount++;
+				// Count how much memory this entry is using
+				MemUsed += FNameEntry::GetSize( Entry->GetNameLength(), !Entry->IsWide() );
+				// Number of slots a lookup of this name has to look at
+				const int32 Probes = ((SlotIndex - Entry->GetNameHash()) & CurrentSlots->Mask) + 1;
+				TotalProbes += Probes;
+				MaxProbes = FMath::Max( MaxProbes, Probes );
+			}
+		}
+		Ar.Logf( TEXT("Hash: %i names, %i slots, %.2f average/ %i max probes, Mem in bytes %i names, %i slots"), 
+			NameCount, CurrentSlots->Mask + 1, NameCount ? (float)TotalProbes / NameCount : 0.f, MaxProbes, MemUsed, GetAllocatedSize() );
+	}
+
+	/**
+	 * @return Size of all slot arrays, including the ones replaced by growing.
+	 */
+	int32 GetAllocatedSize() const
+	{
+		int32 Size = 0;
+		for( const FSlotArray* SlotArray = Slots; SlotArray; SlotArray = SlotArray->Previous )
+		{
+			Size += sizeof(FSlotArray) + (SlotArray->Mask + 1) * sizeof(FNameEntry*);
+		}
+		return Size;
+	}
+
+private:
+	/** Array of slots, the number of slots is a power of two. */
+	struct FSlotArray
+	{
+		/** Entries, NULL for empty slots. */
+		FNameEntry**	Entries;
+		/** Number of slots minus one. */
+		uint32			Mask;
+		/** Array this one replaced. */
+		FSlotArray*		Previous;
+	};
+
+	static FSlotArray* AllocateSlots( uint32 NumSlots, FSlotArray* Previous )
+	{
+		FSlotArray* SlotArray = new FSlotArray;
+		SlotArray->Entries = (FNameEntry**)FMemory::Malloc( NumSlots * sizeof(FNameEntry*) );
+		FMemory::Memzero( SlotArray->Entries, NumSlots * sizeof(FNameEntry*) );
+		SlotArray->Mask = NumSlots - 1;
+		SlotArray->Previous = Previous;
+		return SlotArray;
+	}
+
+	/** Current slots. */
+	FSlotArray* volatile	Slots;
+	/** Number of entries in Slots. */
+	volatile int32			NumEntries;
+	/** Locks serializing adds, picked by hash. */
+	FCriticalSection		StripeLocks[LockStripeCount];
+};
+
+/** Singleton to retrieve the name hash table. */
+static FNameHashTable& GetNameHashTable()
+{
+	// Created on first use for the same reason as the name table in GetNames.
+	static FNameHashTable* HashTable = NULL;
+	if( HashTable == NULL )
+	{
+		check(IsInGameThread());
+		HashTable = new FNameHashTable();
+	}
+	return *HashTable;
+}
+
 FCriticalSection* FName::GetCriticalSection()
 {
 	static FCriticalSection*	CriticalSection = NULL;
@@ -236,7 +449,6 @@ FCriticalSection* FName::GetCriticalSection()
 
 
 // Static variables.
-FNameEntry*						FName::NameHash[ FNameDefs::NameHashBucketCount ];
 int32							FName::NameEntryMemorySize;
 /** Number of ANSI names in name table.						*/
 int32							FName::NumAnsiNames;			
@@ -424,7 +636,7 @@ void FName::Init(const WIDECHAR* InName, int32 InNumber, EFindName FindType, boo
 	int32 OutNumber = InNumber;
 
 	// Hash value of string. Depends on whether the name is going to be ansi or wide.
-	int32 iHash;
+	uint32 Hash;
 
 	// Figure out whether we have a pure ansi name or not.
 	ANSICHAR AnsiName[NAME_SIZE];
@@ -432,53 +644,49 @@ void FName::Init(const WIDECHAR* InName, int32 InNumber, EFindName FindType, boo
 	if( bIsPureAnsi )
 	{
 		FCStringAnsi::Strncpy( AnsiName, StringCast<ANSICHAR>(InName).Get(), ARRAY_COUNT(AnsiName) );
-		iHash = FCrc::Strihash_DEPRECATED( AnsiName ) & (ARRAY_COUNT(NameHash)-1);
+		Hash = FCrc::Strihash_DEPRECATED( AnsiName );
 	}
 	else
 	{
-		iHash = FCrc::Strihash_DEPRECATED( InName ) & (ARRAY_COUNT(NameHash)-1);
+		Hash = FCrc::Strihash_DEPRECATED( InName );
 	}
 
+	FNameHashTable& HashTable = GetNameHashTable();
 	if (OutIndex < 0)
 	{
-		// Try to find the name in the hash.
-		for( FNameEntry* Hash=NameHash[iHash]; Hash; Hash=Hash->HashNext )
+		// Try to find the name in the hash. This doesn't lock as names are never removed.
+		FNameEntry* Entry = bIsPureAnsi ? HashTable.Find( AnsiName, Hash ) : HashTable.Find( InName, Hash );
+		if( Entry )
 		{
-			FPlatformMisc::Prefetch( Hash->HashNext );
-			// Compare the passed in string, either ANSI or TCHAR.
-			if( ( bIsPureAnsi && Hash->IsEqual( AnsiName )) 
-			||  (!bIsPureAnsi && Hash->IsEqual( InName )) )
+			// Found it in the hash.
+			OutIndex = Entry->GetIndex();
+
+			// Check to see if the caller wants to replace the contents of the
+			// FName with the specified value. This is useful for compiling
+			// script classes where the file name is lower case but the class
+			// was intended to be uppercase.
+			if (FindType == FNAME_Replace_Not_Safe_For_Threading)
 			{
-				// Found it in the hash.
-				OutIndex = Hash->GetIndex();
-
-				// Check to see if the caller wants to replace the contents of the
-				// FName with the specified value. This is useful for compiling
-				// script classes where the file name is lower case but the class
-				// was intended to be uppercase.
-				if (FindType == FNAME_Replace_Not_Safe_For_Threading)
+				check(IsInGameThread());
+				// This should be impossible due to the compare above
+				// This *must* be true, or we'll overwrite memory when the
+				// copy happens if it is longer
+				check(FCString::Strlen(InName) == Entry->GetNameLength());
+				// Can't rely on the template override for static arrays since the safe crt version of strcpy will fill in
+				// the remainder of the array of NAME_SIZE with 0xfd.  So, we have to pass in the length of the dynamically allocated array instead.
+				if( bIsPureAnsi )
 				{
-					check(IsInGameThread());
-					// This should be impossible due to the compare above
-					// This *must* be true, or we'll overwrite memory when the
-					// copy happens if it is longer
-					check(FCString::Strlen(InName) == Hash->GetNameLength());
-					// Can't rely on the template override for static arrays since the safe crt version of strcpy will fill in
-					// the remainder of the array of NAME_SIZE with 0xfd.  So, we have to pass in the length of the dynamically allocated array instead.
-					if( bIsPureAnsi )
-					{
-						FCStringAnsi::Strcpy(const_cast<ANSICHAR*>(Hash->GetAnsiName()),Hash->GetNameLength()+1,AnsiName);
-					}
-					else
-					{
-						FCStringWide::Strcpy(const_cast<WIDECHAR*>(Hash->GetWideName()),Hash->GetNameLength()+1,InName);
-					}
+					FCStringAnsi::Strcpy(const_cast<ANSICHAR*>(Entry->GetAnsiName()),Entry->GetNameLength()+1,AnsiName);
+				}
+				else
+				{
+					FCStringWide::Strcpy(const_cast<WIDECHAR*>(Entry->GetWideName()),Entry->GetNameLength()+1,InName);
 				}
-				check(OutIndex >= 0);
-				Index = OutIndex;
-				Number = OutNumber;
-				return;
 			}
+			check(OutIndex >= 0);
+			Index = OutIndex;
+			Number = OutNumber;
+			return;
 		}
 
 		// Didn't find name.
@@ -490,44 +698,50 @@ void FName::Init(const WIDECHAR* InName, int32 InNumber, EFindName FindType, boo
 			return;
 		}
 	}
-	// acquire the lock
-	FScopeLock ScopeLock(GetCriticalSection());
-	if (OutIndex < 0)
+
+	bool bShouldGrow = false;
 	{
-		// Try to find the name in the hash. AGAIN...we might have been adding from a different thread and we just missed it
-		for( FNameEntry* Hash=NameHash[iHash]; Hash; Hash=Hash->HashNext )
+		// Only adds of names that share a lock stripe wait on each other here.
+		FScopeLock StripeLock(&HashTable.GetStripeLock(Hash));
+		if (OutIndex < 0)
 		{
-			// Compare the passed in string, either ANSI or TCHAR.
-			if( ( bIsPureAnsi && Hash->IsEqual( AnsiName )) 
-				||  (!bIsPureAnsi && Hash->IsEqual( InName )) )
+			// Try to find the name in the hash. AGAIN...we might have been adding from a different thread and we just missed it
+			FNameEntry* Entry = bIsPureAnsi ? HashTable.Find( AnsiName, Hash ) : HashTable.Find( InName, Hash );
+			if( Entry )
 			{
 				// Found it in the hash.
-				OutIndex = Hash->GetIndex();
+				OutIndex = Entry->GetIndex();
 				check(FindType == FNAME_Add);  // if this was a replace, well it isn't safe for threading. Find should have already been handled
 				Index = OutIndex;
 				Number = OutNumber;
 				return;
 			}
 		}
+
+		FNameEntry* NewEntry = NULL;
+		{
+			// Assigning the index and allocating the entry isn't thread safe, but only takes a moment.
+			FScopeLock AllocationLock(GetCriticalSection());
+			TNameEntryArray& Names = GetNames();
+			if (OutIndex < 0)
+			{
+				OutIndex = Names.AddZeroed(1);
+			}
+			else
+			{
+				Names.AddZeroed(OutIndex + 1 - Names.Num());
+			}
+			NewEntry = AllocateNameEntry( bIsPureAnsi ? (void const*)AnsiName : (void const*)InName, OutIndex, bIsPureAnsi );
+			if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&Names[OutIndex], NewEntry, NULL) != NULL) // we use an atomic operation to check for unexpected concurrency, verify alignment, etc
+			{
+				UE_LOG(LogUnrealNames, Fatal, TEXT("Hardcoded name '%s' at index %i was duplicated (or unexpected concurrency). Existing entry is '%s'."), *NewEntry->GetPlainNameString(), NewEntry->GetIndex(), *Names[OutIndex]->GetPlainNameString() );
+			}
+		}
+		bShouldGrow = HashTable.Add( NewEntry, Hash );
 	}
-	FNameEntry* OldHash=NameHash[iHash];
-	TNameEntryArray& Names = GetNames();
-	if (OutIndex < 0)
-	{
-		OutIndex = Names.AddZeroed(1);
-	}
-	else
-	{
-		Names.AddZeroed(OutIndex + 1 - Names.Num());
-	}
-	FNameEntry* NewEntry = AllocateNameEntry( bIsPureAnsi ? (void const*)AnsiName : (void const*)InName, OutIndex, OldHash, bIsPureAnsi );
-	if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&Names[OutIndex], NewEntry, NULL) != NULL) // we use an atomic operation to check for unexpected concurrency, verify alignment, etc
-	{
-		UE_LOG(LogUnrealNames, Fatal, TEXT("Hardcoded name '%s' at index %i was duplicated (or unexpected concurrency). Existing entry is '%s'."), *NewEntry->GetPlainNameString(), NewEntry->GetIndex(), *Names[OutIndex]->GetPlainNameString() );
-	}
-	if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&NameHash[iHash], NewEntry, OldHash) != OldHash) // we use an atomic operation to check for unexpected concurrency, verify alignment, etc
+	if( bShouldGrow )
 	{
-		check(0); // someone changed this while we were changing it
+		HashTable.Grow();
 	}
 	check(OutIndex >= 0);
 	Index = OutIndex;
@@ -581,15 +795,10 @@ void FName::StaticInit()
 	FCrc::Init();
 
 	check(GetIsInitialized() == false);
-	check((ARRAY_COUNT(NameHash)&(ARRAY_COUNT(NameHash)-1)) == 0);
 	GetIsInitialized() = 1;
 
-
 	// Init the name hash.
-	for (int32 HashIndex = 0; HashIndex < ARRAY_COUNT(FName::NameHash); HashIndex++)
-	{
-		NameHash[HashIndex] = NULL;
-	}
+	GetNameHashTable();
 
 	{
 		// Register all hardcoded names.
@@ -598,27 +807,23 @@ void FName::StaticInit()
 	}
 
 #if DO_CHECK
-	// Verify no duplicate names.
-	for (int32 HashIndex = 0; HashIndex < ARRAY_COUNT(NameHash); HashIndex++)
+	// Verify no duplicate names. A duplicate isn't found by looking up its own string as lookups return the first match.
+	TNameEntryArray& Names = GetNames();
+	for (int32 NameIndex = 0; NameIndex < Names.Num(); NameIndex++)
 	{
-		for (FNameEntry* Hash = NameHash[HashIndex]; Hash; Hash = Hash->HashNext)
+		const FNameEntry* Hash = Names[NameIndex];
+		if (Hash && GetNameHashTable().Find(Hash) != Hash)
 		{
-			for (FNameEntry* Other = Hash->HashNext; Other; Other = Other->HashNext)
+			// we can't print out here because there may be no log yet if this happens before main starts
+			if (FPlatformMisc::IsDebuggerPresent())
 			{
-				if (FCString::Stricmp(*Hash->GetPlainNameString(), *Other->GetPlainNameString()) == 0)
-				{
-					// we can't print out here because there may be no log yet if this happens before main starts
-					if (FPlatformMisc::IsDebuggerPresent())
-					{
-						FPlatformMisc::DebugBreak();
-					}
-					else
-					{
-						FPlatformMisc::PromptForRemoteDebugging(false);
-						FMessageDialog::Open(EAppMsgType::Ok, FText::Format( NSLOCTEXT("UnrealEd", "DuplicatedHardcodedName", "Duplicate hardcoded name: {0}"), FText::FromString( Hash->GetPlainNameString() ) ) );
-						FPlatformMisc::RequestExit(false);
-					}
-				}
+				FPlatformMisc::DebugBreak();
+			}
+			else
+			{
+				FPlatformMisc::PromptForRemoteDebugging(false);
+				FMessageDialog::Open(EAppMsgType::Ok, FText::Format( NSLOCTEXT("UnrealEd", "DuplicatedHardcodedName", "Duplicate hardcoded name: {0}"), FText::FromString( Hash->GetPlainNameString() ) ) );
+				FPlatformMisc::RequestExit(false);
 			}
 		}
 	}
@@ -648,18 +853,12 @@ bool& FName::GetIsInitialized()
 
 void FName::DisplayHash( FOutputDevice& Ar )
 {
-	int32 UsedBins=0, NameCount=0, MemUsed = 0;
-	for( int32 i=0; i<ARRAY_COUNT(NameHash); i++ )
-	{
-		if( NameHash[i] != NULL ) UsedBins++;
-		for( FNameEntry *Hash = NameHash[i]; Hash; Hash=Hash->HashNext )
-		{
-			NameCount++;
-			// Count how much memory this entry is using
-			MemUsed += FNameEntry::GetSize( Hash->GetNameLength(), Hash->IsWide() );
-		}
-	}
-	Ar.Logf( TEXT("Hash: %i names, %i/%i hash bins, Mem in bytes %i"), NameCount, UsedBins, ARRAY_COUNT(NameHash), MemUsed);
+	GetNameHashTable().Dump( Ar );
+}
+
+int32 FName::GetNameHashMemorySize()
+{
+	return GetNameHashTable().GetAllocatedSize();
 }
 
 bool FName::SplitNameWithCheck(const WIDECHAR* OldName, WIDECHAR* NewName, int32 NewNameLen, int32& NewNumber)
@@ -893,14 +1092,13 @@ private:
 /** Global allocator for name entries. */
 FNameEntryPoolAllocator GNameEntryPoolAllocator;
 
-FNameEntry* AllocateNameEntry( const void* Name, NAME_INDEX Index, FNameEntry* HashNext, bool bIsPureAnsi )
+FNameEntry* AllocateNameEntry( const void* Name, NAME_INDEX Index, bool bIsPureAnsi )
 {
 	const SIZE_T NameLen  = bIsPureAnsi ? FCStringAnsi::Strlen((ANSICHAR*)Name) : FCString::Strlen((TCHAR*)Name);
 	int32 NameEntrySize	  = FNameEntry::GetSize( NameLen, bIsPureAnsi );
 	FNameEntry* NameEntry = GNameEntryPoolAllocator.Allocate( NameEntrySize );
 	FName::NameEntryMemorySize += NameEntrySize;
 	NameEntry->Index      = (Index << NAME_INDEX_SHIFT) | (bIsPureAnsi ? 0 : 1);
-	NameEntry->HashNext   = HashNext;
 	// Can't rely on the template override for static arrays since the safe crt version of strcpy will fill in
 	// the remainder of the array of NAME_SIZE with 0xfd.  So, we have to pass in the length of the dynamically allocated array instead.
 	if( bIsPureAnsi )
@@ -1013,6 +1211,86 @@ static class FFNameExec: private FSelfRegisteringExec
 				check(Test.TestCounter.GetValue() == FTest::NUM_TESTS * FTest::NUM_TASKS);
 				Ar.Logf( TEXT("Ran fname threading test."));
 			}
+			else if( FParse::Command(&Cmd,TEXT("THREADBENCH")) )
+			{
+				// Times adding new names and finding existing ones from several tasks at once, e.g. "FNAME THREADBENCH 8"
+				struct FBench
+				{
+					enum
+					{
+						NUM_NAMES_PER_TASK = 100000
+					};
+					TArray<FString> Strings;
+					FThreadSafeCounter NextTask;
+					int32 NumTasks;
+					FBench(int32 InNumTasks)
+						: NumTasks(InNumTasks)
+					{
+						// Names are new every time the bench runs so the add pass never just finds them
+						static int32 RunIndex = 0;
+						RunIndex++;
+						Strings.Reserve(NUM_NAMES_PER_TASK * NumTasks);
+						for (int32 Index = 0; Index < NUM_NAMES_PER_TASK * NumTasks; Index++)
+						{
+							Strings.Add(FString::Printf(TEXT("Bench%d_Name%d"), RunIndex, Index));
+						}
+					}
+					void Add()
+					{
+						// Each task adds its own slice of the names
+						const int32 TaskIndex = NextTask.Increment() - 1;
+						for (int32 Index = TaskIndex * NUM_NAMES_PER_TASK; Index < (TaskIndex + 1) * NUM_NAMES_PER_TASK; Index++)
+						{
+							FName Temp(*Strings[Index]);
+							check(Temp != NAME_None);
+						}
+					}
+					void Find()
+					{
+						// Each task looks up all of the names, starting at a different point
+						const int32 TaskIndex = NextTask.Increment() - 1;
+						for (int32 Index = 0; Index < Strings.Num(); Index++)
+						{
+							FName Temp(*Strings[(Index + TaskIndex * NUM_NAMES_PER_TASK) % Strings.Num()], FNAME_Find);
+							check(Temp != NAME_None);
+						}
+					}
+					double Run(FSimpleDelegateGraphTask::FDelegate const& Delegate)
+					{
+						NextTask.Reset();
+						FGraphEventArray Handles;
+						const double StartTime = FPlatformTime::Seconds();
+						for (int32 TaskIndex = 0; TaskIndex < NumTasks; TaskIndex++)
+						{
+							new (Handles) FGraphEventRef(FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
+								Delegate,
+								TEXT("FName Bench"),
+								NULL,
+								ENamedThreads::AnyThread
+								));
+						}
+						FTaskGraphInterface::Get().WaitUntilTasksComplete(Handles, ENamedThreads::GameThread);
+						return FPlatformTime::Seconds() - StartTime;
+					}
+				};
+
+				int32 NumTasks = FCString::Atoi(Cmd);
+				if (NumTasks <= 0)
+				{
+					NumTasks = FMath::Max(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 1);
+				}
+				FBench Bench(NumTasks);
+				Ar.Logf( TEXT("Starting fname threading benchmark with %d tasks."), NumTasks);
+
+				const double AddTime = Bench.Run(FSimpleDelegateGraphTask::FDelegate::CreateRaw(&Bench, &FBench::Add));
+				const double FindTime = Bench.Run(FSimpleDelegateGraphTask::FDelegate::CreateRaw(&Bench, &FBench::Find));
+				const int32 NumAdded = FBench::NUM_NAMES_PER_TASK * NumTasks;
+				const int32 NumFound = NumAdded * NumTasks;
+				Ar.Logf( TEXT("Added %d names in %.3fs (%.0f names/s), found %d names in %.3fs (%.0f names/s)."),
+					NumAdded, AddTime, AddTime > 0.0 ? NumAdded / AddTime : 0.0,
+					NumFound, FindTime, FindTime > 0.0 ? NumFound / FindTime : 0.0 );
+				FName::DisplayHash(Ar);
+			}
 			return true;
 #endif // !UE_BUILD_SHIPPING
 		}
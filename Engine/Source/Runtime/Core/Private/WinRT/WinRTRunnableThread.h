@@ -110,7 +110,10 @@ class FRunnableThreadWinRT : public FRunnableThread
 	static ::DWORD STDCALL _ThreadProc(LPVOID pThis)
 	{
 		check(pThis);
-		return ((FRunnableThreadWinRT*)pThis)->Run();
+		const uint32 ExitCode = ((FRunnableThreadWinRT*)pThis)->Run();
+		// The thread object may be deleted by now, release whatever the allocator cached for this thread
+		FMemory::FlushCurrentThreadCache();
+		return ExitCode;
 	}
 
 	/**
@@ -114,7 +114,10 @@ class FRunnableThreadWin : public FRunnableThread
 	static ::DWORD STDCALL _ThreadProc(LPVOID pThis)
 	{
 		check(pThis);
-		return ((FRunnableThreadWin*)pThis)->GuardedRun();
+		const uint32 ExitCode = ((FRunnableThreadWin*)pThis)->GuardedRun();
+		// The thread object may be deleted by now, release whatever the allocator cached for this thread
+		FMemory::FlushCurrentThreadCache();
+		return ExitCode;
 	}
 
 	/** Guarding works only if debugger is not attached or GAlwaysReportCrash is true. */
@@ -11,6 +11,7 @@
 //#define USE_LOCKFREE_DELETE
 #define USE_INTERNAL_LOCKS
 #define CACHE_FREED_OS_ALLOCS
+#define USE_THREAD_CACHE
 
 #ifdef USE_INTERNAL_LOCKS
 //#	define USE_COARSE_GRAIN_LOCKS
@@ -30,6 +31,18 @@
 #	define USE_FINE_GRAIN_LOCKS
 #endif
 
+// Per-thread small block caches only make sense on top of the per-table locks
+#if defined USE_THREAD_CACHE && (!defined USE_FINE_GRAIN_LOCKS || defined USE_LOCKFREE_DELETE)
+#	undef USE_THREAD_CACHE
+#endif
+
+#if defined USE_THREAD_CACHE
+	/** Default maximum number of blocks each thread keeps per pool table. */
+#	define THREAD_CACHE_MAX_BLOCKS_PER_BIN (64)
+	/** Default maximum number of bytes each thread keeps per pool table. Tables where this allows less than 2 blocks aren't cached. */
+#	define THREAD_CACHE_MAX_BYTES_PER_BIN (64*1024)
+#endif
+
 #include "LockFreeList.h"
 #include "Array.h"
 
@@ -204,6 +217,36 @@ private:
 		}
 	};
 
+#ifdef USE_THREAD_CACHE
+	/** Blocks of one pool table cached by a single thread. */
+	struct FThreadCacheBin
+	{
+		/** Cached blocks, linked through FFreeMem::Next. */
+		FFreeMem*	FirstFree;
+		/** Number of cached blocks. */
+		uint32		NumFree;
+#if STATS
+		/** Allocations served from this bin that aren't in the pool table's stats yet. */
+		uint32		PendingRequests;
+		/** Frees into this bin that aren't in the pool table's stats yet. */
+		uint32		PendingFrees;
+		/** Padding of the pending allocations. */
+		uint64		PendingWaste;
+		/** Smallest and largest pending allocation. */
+		uint32		PendingMinRequest;
+		uint32		PendingMaxRequest;
+#endif
+	};
+
+	/** Per-thread block cache. Allocated straight from the OS so creating one never recurses into Malloc. */
+	struct FThreadCache
+	{
+		FThreadCacheBin	Bins[POOL_COUNT];
+		/** Next cache in the list of all thread caches. */
+		FThreadCache*	Next;
+	};
+#endif
+
 	/** Hash table struct for retrieving allocation book keeping information */
 	struct PoolHashBucket
 	{
@@ -291,6 +334,15 @@ private:
 	uint32			CachedTotal;
 #endif
 
+#ifdef USE_THREAD_CACHE
+	/** TLS slot holding the current thread's FThreadCache. */
+	uint32			ThreadCacheTlsSlot;
+	/** Maximum number of blocks a thread caches for each pool table, 0 if the table isn't cached. */
+	uint32			ThreadCacheDepth[POOL_COUNT];
+	/** All thread caches ever created, guarded by AccessGuard. */
+	FThreadCache*	FirstThreadCache;
+#endif
+
 #if STATS
 	uint32		OsCurrent;
 	uint32		OsPeak;
@@ -562,7 +614,6 @@ private:
 	void FreeInternal( void* Ptr )
 	{
 		MEM_TIME(MemTime -= FPlatformTime::Seconds());
-		STAT(CurrentAllocs--);
 
 		UPTRINT BasePtr;
 		FPoolInfo* Pool = FindPoolInfo((UPTRINT)Ptr, BasePtr);
@@ -577,35 +628,7 @@ private:
 #if STATS
 			Table->ActiveRequests--;
 #endif
-			// If this pool was exhausted, move to available list.
-			if( !Pool->FirstMem )
-			{
-				Pool->Unlink();
-				Pool->Link( Table->FirstPool );
-			}
-
-			// Free a pooled allocation.
-			FFreeMem* Free		= (FFreeMem*)Ptr;
-			Free->NumFreeBlocks	= 1;
-			Free->Next			= Pool->FirstMem;
-			Pool->FirstMem		= Free;
-			STAT(UsedCurrent -= Table->BlockSize);
-
-			// Free this pool.
-			checkSlow(Pool->Taken >= 1);
-			if( --Pool->Taken == 0 )
-			{
-#if STATS
-				Table->NumActivePools--;
-#endif
-				// Free the OS memory.
-				SIZE_T OsBytes = Pool->GetOsBytes(PageSize, BinnedOSTableIndex);
-				STAT(OsCurrent -= OsBytes);
-				STAT(WasteCurrent -= OsBytes - Pool->GetBytes());
-				Pool->Unlink();
-				Pool->SetAllocationSizes(0, 0, 0, BinnedOSTableIndex);
-				OSFree((void*)BasePtr, OsBytes);
-			}
+			FreeBlockToPool(Table, Pool, BasePtr, Ptr);
 		}
 		else
 		{
@@ -621,6 +644,197 @@ private:
 		MEM_TIME(MemTime += FPlatformTime::Seconds());
 	}
 
+	/**
+	* Returns a pooled block to its pool. It's the callers responsibility to lock the table before calling this.
+	*/
+	FORCEINLINE void FreeBlockToPool(FPoolTable* Table, FPoolInfo* Pool, UPTRINT BasePtr, void* Ptr)
+	{
+		// If this pool was exhausted, move to available list.
+		if( !Pool->FirstMem )
+		{
+			Pool->Unlink();
+			Pool->Link( Table->FirstPool );
+		}
+
+		// Free a pooled allocation.
+		FFreeMem* Free		= (FFreeMem*)Ptr;
+		Free->NumFreeBlocks	= 1;
+		Free->Next			= Pool->FirstMem;
+		Pool->FirstMem		= Free;
+		STAT(UsedCurrent -= Table->BlockSize);
+
+		// Free this pool.
+		checkSlow(Pool->Taken >= 1);
+		if( --Pool->Taken == 0 )
+		{
+#if STATS
+			Table->NumActivePools--;
+#endif
+			// Free the OS memory.
+			SIZE_T OsBytes = Pool->GetOsBytes(PageSize, BinnedOSTableIndex);
+			STAT(OsCurrent -= OsBytes);
+			STAT(WasteCurrent -= OsBytes - Pool->GetBytes());
+			Pool->Unlink();
+			Pool->SetAllocationSizes(0, 0, 0, BinnedOSTableIndex);
+			OSFree((void*)BasePtr, OsBytes);
+		}
+	}
+
+#ifdef USE_THREAD_CACHE
+	/**
+	* Gets the calling thread's block cache, creating it on first use.
+	*/
+	FORCEINLINE FThreadCache* GetThreadCache()
+	{
+		FThreadCache* Cache = (FThreadCache*)FPlatformTLS::GetTlsValue(ThreadCacheTlsSlot);
+		if( !Cache )
+		{
+			const SIZE_T CacheBytes = Align(sizeof(FThreadCache), PageSize);
+			Cache = (FThreadCache*)FPlatformMemory::BinnedAllocFromOS(CacheBytes);
+			if( !Cache )
+			{
+				OutOfMemory(CacheBytes);
+			}
+			FMemory::Memzero(Cache, sizeof(FThreadCache));
+			STAT(OsPeak = FMath::Max(OsPeak, OsCurrent += CacheBytes));
+			STAT(WastePeak = FMath::Max(WastePeak, WasteCurrent += CacheBytes));
+			{
+				FScopeLock MainLock(&AccessGuard);
+				Cache->Next = FirstThreadCache;
+				FirstThreadCache = Cache;
+			}
+			FPlatformTLS::SetTlsValue(ThreadCacheTlsSlot, Cache);
+		}
+		return Cache;
+	}
+
+	/**
+	* Allocates a block from the calling thread's cache, refilling the cache with a batch of blocks
+	* taken under a single table lock when it's empty.
+	*/
+	FORCEINLINE FFreeMem* AllocateFromThreadCache(FPoolTable* Table, uint32 BinIndex, SIZE_T Size)
+	{
+		FThreadCacheBin& Bin = GetThreadCache()->Bins[BinIndex];
+		if( !Bin.FirstFree )
+		{
+			const uint32 NumBlocks = FMath::Max<uint32>(ThreadCacheDepth[BinIndex] / 2, 1);
+			FScopeLock TableLock(&Table->CriticalSection);
+			AddThreadCacheStats(Table, Bin);
+			for( uint32 BlockIndex = 0; BlockIndex < NumBlocks; BlockIndex++ )
+			{
+				FPoolInfo* Pool = Table->FirstPool;
+				if( !Pool )
+				{
+					Pool = AllocatePoolMemory(Table, BINNED_ALLOC_POOL_SIZE, Size);
+				}
+
+				FFreeMem* Block = AllocateBlockFromPool(Table, Pool);
+				Block->Next = Bin.FirstFree;
+				Bin.FirstFree = Block;
+				Bin.NumFree++;
+			}
+		}
+
+		FFreeMem* Free = Bin.FirstFree;
+		Bin.FirstFree = Free->Next;
+		Bin.NumFree--;
+#if STATS
+		Bin.PendingMinRequest = Bin.PendingRequests == 0 || Size < Bin.PendingMinRequest ? Size : Bin.PendingMinRequest;
+		Bin.PendingMaxRequest = Size > Bin.PendingMaxRequest ? Size : Bin.PendingMaxRequest;
+		Bin.PendingWaste += Table->BlockSize - Size;
+		Bin.PendingRequests++;
+#endif
+		return Free;
+	}
+
+	/**
+	* Adds the allocations and frees a thread cache bin served since the last call to its pool table's stats.
+	* It's the callers responsibility to lock the table before calling this.
+	*/
+	FORCEINLINE void AddThreadCacheStats(FPoolTable* Table, FThreadCacheBin& Bin)
+	{
+#if STATS
+		if( Bin.PendingRequests )
+		{
+			Table->TotalWaste += Bin.PendingWaste;
+			Table->TotalRequests += Bin.PendingRequests;
+			Table->MaxRequest = Bin.PendingMaxRequest > Table->MaxRequest ? Bin.PendingMaxRequest : Table->MaxRequest;
+			Table->MinRequest = Bin.PendingMinRequest < Table->MinRequest ? Bin.PendingMinRequest : Table->MinRequest;
+		}
+		// blocks are often freed by another thread than the one that allocated them, so this bin's frees may
+		// outnumber its allocations and the table's count can briefly drop below zero until the other bins are added
+		Table->ActiveRequests += Bin.PendingRequests - Bin.PendingFrees;
+		if( (int32)Table->ActiveRequests > (int32)Table->MaxActiveRequests )
+		{
+			Table->MaxActiveRequests = Table->ActiveRequests;
+		}
+		Bin.PendingRequests = 0;
+		Bin.PendingFrees = 0;
+		Bin.PendingWaste = 0;
+		Bin.PendingMaxRequest = 0;
+#endif
+	}
+
+	/**
+	* Returns blocks from a thread cache bin to their pools under a single table lock.
+	*/
+	void ReturnThreadCacheBlocks(FPoolTable* Table, FThreadCacheBin& Bin, uint32 NumBlocks)
+	{
+		FScopeLock TableLock(&Table->CriticalSection);
+		AddThreadCacheStats(Table, Bin);
+		for( ; NumBlocks && Bin.FirstFree; --NumBlocks )
+		{
+			FFreeMem* Block = Bin.FirstFree;
+			Bin.FirstFree = Block->Next;
+			Bin.NumFree--;
+
+			UPTRINT BasePtr;
+			FPoolInfo* Pool = FindPoolInfo((UPTRINT)Block, BasePtr);
+			checkSlow(Pool && Pool->TableIndex < BinnedSizeLimit);
+			FreeBlockToPool(Table, Pool, BasePtr, Block);
+		}
+	}
+
+	/**
+	* Puts a freed block in the calling thread's cache if its pool table is cached.
+	*
+	* @return true if the block was cached, false if it needs to be freed normally.
+	*/
+	FORCEINLINE bool FreeToThreadCache(void* Ptr)
+	{
+		UPTRINT BasePtr;
+		FPoolInfo* Pool = FindPoolInfo((UPTRINT)Ptr, BasePtr);
+		checkSlow(Pool);
+		if( Pool->TableIndex >= BinnedSizeLimit )
+		{
+			// Page pool or OS allocation.
+			return false;
+		}
+
+		FPoolTable* Table = MemSizeToPoolTable[Pool->TableIndex];
+		const uint32 BinIndex = Table - PoolTable;
+		const uint32 Depth = ThreadCacheDepth[BinIndex];
+		if( !Depth )
+		{
+			return false;
+		}
+
+		FThreadCacheBin& Bin = GetThreadCache()->Bins[BinIndex];
+		FFreeMem* Free = (FFreeMem*)Ptr;
+		Free->Next = Bin.FirstFree;
+		Bin.FirstFree = Free;
+		Bin.NumFree++;
+		STAT(Bin.PendingFrees++);
+
+		if( Bin.NumFree > Depth )
+		{
+			// Give back half of the cache so alternating alloc/free doesn't hit the lock every time.
+			ReturnThreadCacheBlocks(Table, Bin, Bin.NumFree - Depth / 2);
+		}
+		return true;
+	}
+#endif
+
 	void PushFreeLockless(void* Ptr)
 	{
 #ifdef USE_LOCKFREE_DELETE
@@ -766,6 +980,10 @@ public:
 		,	FreedPageBlocksNum(0)
 		,	CachedTotal(0)
 #endif
+#ifdef USE_THREAD_CACHE
+		,	ThreadCacheTlsSlot(FPlatformTLS::AllocTlsSlot())
+		,	FirstThreadCache(NULL)
+#endif
 #if STATS
 		,	OsCurrent		( 0 )
 		,	OsPeak			( 0 )
@@ -855,7 +1073,68 @@ public:
 		MemSizeToPoolTable[BinnedSizeLimit+1] = &PagePoolTable[1];
 
 		check(MAX_POOLED_ALLOCATION_SIZE - 1 == PoolTable[POOL_COUNT - 1].BlockSize);
+
+#ifdef USE_THREAD_CACHE
+		SetThreadCacheLimits(THREAD_CACHE_MAX_BLOCKS_PER_BIN, THREAD_CACHE_MAX_BYTES_PER_BIN);
+#endif
 	}
+
+	virtual ~FMallocBinned()
+	{
+#ifdef USE_THREAD_CACHE
+		FPlatformTLS::FreeTlsSlot(ThreadCacheTlsSlot);
+#endif
+	}
+
+#ifdef USE_THREAD_CACHE
+	/**
+	 * Sets how many blocks each thread may cache per pool table. Caches that are over the new
+	 * limit shrink the next time their thread frees a block of that size.
+	 *
+	 * @param MaxBlocksPerBin	Maximum number of cached blocks per pool table, 0 disables thread caching.
+	 * @param MaxBytesPerBin	Maximum number of cached bytes per pool table.
+	 */
+	void SetThreadCacheLimits(uint32 MaxBlocksPerBin, uint32 MaxBytesPerBin)
+	{
+		for( uint32 i = 0; i < POOL_COUNT; i++ )
+		{
+			const uint32 Depth = FMath::Min(MaxBlocksPerBin, MaxBytesPerBin / PoolTable[i].BlockSize);
+			ThreadCacheDepth[i] = Depth >= 2 ? Depth : 0;
+		}
+	}
+
+	/**
+	 * Returns all blocks cached by the calling thread to the shared pools and releases the cache itself.
+	 * Called by FRunnableThread when a thread exits; the thread gets a new cache if it allocates again.
+	 */
+	virtual void FlushCurrentThreadCache() OVERRIDE
+	{
+		FThreadCache* Cache = (FThreadCache*)FPlatformTLS::GetTlsValue(ThreadCacheTlsSlot);
+		if( Cache )
+		{
+			for( uint32 i = 0; i < POOL_COUNT; i++ )
+			{
+				ReturnThreadCacheBlocks(&PoolTable[i], Cache->Bins[i], Cache->Bins[i].NumFree);
+			}
+
+			FPlatformTLS::SetTlsValue(ThreadCacheTlsSlot, NULL);
+			{
+				FScopeLock MainLock(&AccessGuard);
+				FThreadCache** Link = &FirstThreadCache;
+				while( *Link != Cache )
+				{
+					Link = &(*Link)->Next;
+				}
+				*Link = Cache->Next;
+			}
+
+			const SIZE_T CacheBytes = Align(sizeof(FThreadCache), PageSize);
+			FPlatformMemory::BinnedFreeToOS(Cache);
+			STAT(OsCurrent -= CacheBytes);
+			STAT(WasteCurrent -= CacheBytes);
+		}
+	}
+#endif
 	
 	/**
 	 * Returns if the allocator is guaranteed to be thread-safe and therefore
@@ -897,20 +1176,29 @@ public:
 		{
 			// Allocate from pool.
 			FPoolTable* Table = MemSizeToPoolTable[Size];
+			checkSlow(Size <= Table->BlockSize);
+#ifdef USE_THREAD_CACHE
+			const uint32 BinIndex = Table - PoolTable;
+			if( ThreadCacheDepth[BinIndex] )
+			{
+				Free = AllocateFromThreadCache(Table, BinIndex, Size);
+			}
+			else
+#endif
+			{
 #ifdef USE_FINE_GRAIN_LOCKS
-			FScopeLock TableLock(&Table->CriticalSection);
+				FScopeLock TableLock(&Table->CriticalSection);
 #endif
-			checkSlow(Size <= Table->BlockSize);
+				TrackStats(Table, Size);
 
-			TrackStats(Table, Size);
+				FPoolInfo* Pool = Table->FirstPool;
+				if( !Pool )
+				{
+					Pool = AllocatePoolMemory(Table, BINNED_ALLOC_POOL_SIZE/*PageSize*/, Size);
+				}
 
-			FPoolInfo* Pool = Table->FirstPool;
-			if( !Pool )
-			{
-				Pool = AllocatePoolMemory(Table, BINNED_ALLOC_POOL_SIZE/*PageSize*/, Size);
+				Free = AllocateBlockFromPool(Table, Pool);
 			}
-
-			Free = AllocateBlockFromPool(Table, Pool);
 		}
 		else if ( ((Size >= BinnedSizeLimit && Size <= PagePoolTable[0].BlockSize) ||
 				  (Size > PageSize && Size <= PagePoolTable[1].BlockSize))
@@ -1045,6 +1333,13 @@ public:
 			return;
 		}
 
+		STAT(CurrentAllocs--);
+#ifdef USE_THREAD_CACHE
+		if( FreeToThreadCache(Ptr) )
+		{
+			return;
+		}
+#endif
 		PushFreeLockless(Ptr);
 	}
 
@@ -1208,6 +1503,22 @@ public:
 		Ar.Logf( TEXT( "%iK allocated in pools (with %iK slack and %iK waste). Efficiency %.2f%%" ), TotalMemory, TotalSlack, TotalWaste, TotalMemory ? 100.0f * (TotalMemory - TotalWaste) / TotalMemory : 100.0f );
 		Ar.Logf( TEXT( "Allocations %i Current / %i Total (in %i pools)"), TotalActiveRequests, TotalTotalRequests, TotalPools );
 		Ar.Logf( TEXT("") );
+
+#ifdef USE_THREAD_CACHE
+		// Other threads keep using their caches, so this is only an estimate.
+		uint32 NumThreadCaches = 0;
+		uint64 ThreadCachedBytes = 0;
+		for( FThreadCache* Cache = FirstThreadCache; Cache; Cache = Cache->Next )
+		{
+			NumThreadCaches++;
+			for( uint32 i = 0; i < POOL_COUNT; i++ )
+			{
+				ThreadCachedBytes += (uint64)Cache->Bins[i].NumFree * PoolTable[i].BlockSize;
+			}
+		}
+		Ar.Logf( TEXT( "Thread caches %i, holding %.2f MB" ), NumThreadCaches, ThreadCachedBytes / ( 1024.0f * 1024.0f ) );
+		Ar.Logf( TEXT("") );
+#endif
 #endif
 	}
 
@@ -109,6 +109,12 @@ public:
 		return( UsedMalloc->ValidateHeap() );
 	}
 
+	virtual void FlushCurrentThreadCache() OVERRIDE
+	{
+		FScopeLock Lock( &SynchronizationObject );
+		UsedMalloc->FlushCurrentThreadCache();
+	}
+
 	bool Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar ) OVERRIDE
 	{
 		FScopeLock ScopeLock( &SynchronizationObject );
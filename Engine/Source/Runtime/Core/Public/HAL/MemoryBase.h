@@ -207,6 +207,13 @@ public:
 		return false; 
 	}
 
+	/**
+	 * Releases anything the allocator cached for the calling thread. Called when a thread exits.
+	 */
+	virtual void FlushCurrentThreadCache()
+	{
+	}
+
 	/**
 	 * Gathers all current memory stats
 	 *
@@ -580,6 +580,18 @@ FORCEINLINE uint32 VectorAnyGreaterThan(const VectorRegister& Vec1, const Vector
 	return (uint32)XMComparisonAnyTrue( comparisonValue );
 }
 
+/**
+ * Returns an integer bit-mask (0x00 - 0x0f) based on the sign-bit for each component in a vector, e.g. of a compare mask.
+ *
+ * @param VecMask		Vector
+ * @return				Bit 0 = sign(VecMask.x), Bit 1 = sign(VecMask.y), Bit 2 = sign(VecMask.z), Bit 3 = sign(VecMask.w)
+ */
+FORCEINLINE int32 VectorMaskBits( const VectorRegister& VecMask )
+{
+	using namespace DirectX;
+	return (int32)((XMVectorGetIntX( VecMask ) >> 31) | ((XMVectorGetIntY( VecMask ) >> 31) << 1) | ((XMVectorGetIntZ( VecMask ) >> 31) << 2) | ((XMVectorGetIntW( VecMask ) >> 31) << 3));
+}
+
 /**
  * Resets the floating point registers so that they can be used again.
  * Some intrinsics use these for MMX purposes (e.g. VectorLoadByte4 and VectorStoreByte4).
@@ -875,6 +875,18 @@ FORCEINLINE int32 VectorAnyGreaterThan( VectorRegister Vec1, VectorRegister Vec2
 	return (int32)buf[0]; // each byte of output corresponds to a component comparison
 }
 
+/**
+ * Returns an integer bit-mask (0x00 - 0x0f) based on the sign-bit for each component in a vector, e.g. of a compare mask.
+ *
+ * @param VecMask		Vector
+ * @return				Bit 0 = sign(VecMask.x), Bit 1 = sign(VecMask.y), Bit 2 = sign(VecMask.z), Bit 3 = sign(VecMask.w)
+ */
+FORCEINLINE int32 VectorMaskBits( VectorRegister VecMask )
+{
+	uint32x4_t SignBits = vshrq_n_u32( (uint32x4_t)VecMask, 31 );
+	return (int32)(vgetq_lane_u32( SignBits, 0 ) | (vgetq_lane_u32( SignBits, 1 ) << 1) | (vgetq_lane_u32( SignBits, 2 ) << 2) | (vgetq_lane_u32( SignBits, 3 ) << 3));
+}
+
 /**
  * Resets the floating point registers so that they can be used again.
  * Some intrinsics use these for MMX purposes (e.g. VectorLoadByte4 and VectorStoreByte4).
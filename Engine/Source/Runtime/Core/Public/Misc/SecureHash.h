@@ -138,6 +138,11 @@ public:
 		return FMemory::Memcmp(&X.Hash, &Y.Hash, sizeof(X.Hash)) != 0;
 	}
 
+	friend uint32 GetTypeHash(const FSHAHash& InKey)
+	{
+		return *(uint32*)InKey.Hash;
+	}
+
 	friend CORE_API FArchive& operator<<( FArchive& Ar, FSHAHash& G );
 };
 
@@ -534,6 +534,12 @@ public:
 		return( UsedMalloc->ValidateHeap() );
 	}
 
+	virtual void FlushCurrentThreadCache() OVERRIDE
+	{
+		FScopeLock Lock( &CriticalSection );
+		UsedMalloc->FlushCurrentThreadCache();
+	}
+
 	/**
 	* If possible determine the size of the memory allocated at the given address
 	*
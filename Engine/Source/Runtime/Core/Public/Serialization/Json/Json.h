@@ -71,3 +71,5 @@ namespace EJsonNotation
 #include "JsonWriter.h"
 #include "JsonDocumentObjectModel.h"
 #include "JsonSerializer.h"
+#include "JsonSaxReader.h"
+#include "JsonArenaDocument.h"
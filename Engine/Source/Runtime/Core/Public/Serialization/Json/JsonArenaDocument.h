@@ -0,0 +1,110 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+/**
+ * A Json value that lives in the memory of an FJsonArenaDocument.
+ * Values are never copied or freed one by one, they all go away with their document.
+ */
+struct FJsonArenaValue
+{
+	EJson::Type Type;
+
+	/** Number of characters of a string, number of values of an array or object. */
+	int32 Num;
+
+	/** Name of this value if it is a field of an object, an empty string otherwise. */
+	const TCHAR* Name;
+
+	/** Next value of the array or object this value is in. */
+	FJsonArenaValue* Next;
+
+	union
+	{
+		double Number;
+		bool Boolean;
+		/** Terminated string. */
+		const TCHAR* String;
+		/** First value of an array or object. */
+		FJsonArenaValue* FirstChild;
+	};
+
+	double AsNumber() const
+	{
+		check(Type == EJson::Number);
+		return Number;
+	}
+
+	bool AsBool() const
+	{
+		check(Type == EJson::Boolean);
+		return Boolean;
+	}
+
+	const TCHAR* AsString() const
+	{
+		check(Type == EJson::String);
+		return String;
+	}
+
+	/** Finds a field of an object by name, objects are scanned so this is linear in the number of fields. */
+	CORE_API const FJsonArenaValue* FindField(const TCHAR* FieldName) const;
+
+	/** Finds a field of an object that has the given type. */
+	const FJsonArenaValue* FindField(const TCHAR* FieldName, EJson::Type FieldType) const
+	{
+		const FJsonArenaValue* Field = FindField(FieldName);
+		return Field && Field->Type == FieldType ? Field : NULL;
+	}
+};
+
+/**
+ * Json document that keeps all of its values and strings in one FMemStack, as an alternative to FJsonSerializer when
+ * the TSharedPtr per value and FString per name and string are too slow. Parsing goes through TJsonSaxReader.
+ */
+class CORE_API FJsonArenaDocument
+{
+public:
+
+	FJsonArenaDocument();
+
+	/** Parses a TCHAR buffer, replacing what was parsed before. */
+	bool Parse(const TCHAR* Json, int32 Len);
+
+	/** Parses a UTF-8 buffer, replacing what was parsed before. */
+	bool ParseUTF8(const ANSICHAR* Json, int32 Len);
+
+	/** @return the root object or array, NULL if nothing was parsed */
+	const FJsonArenaValue* GetRoot() const
+	{
+		return Root;
+	}
+
+	const FString& GetErrorMessage() const
+	{
+		return ErrorMessage;
+	}
+
+	/** @return the number of bytes of arena memory in use */
+	int32 GetAllocatedSize() const
+	{
+		return Arena.GetByteCount();
+	}
+
+private:
+
+	template <class CharType>
+	bool ParseInternal(const CharType* Json, int32 Len);
+
+	FMemStack Arena;
+
+	/** Mark everything is allocated after, popping it frees the document. Declared after Arena so it's destroyed first. */
+	TScopedPointer<FMemMark> ArenaMark;
+
+	FJsonArenaValue* Root;
+
+	FString ErrorMessage;
+
+	/** Not copyable, the values point into the arena. */
+	FJsonArenaDocument(const FJsonArenaDocument&);
+	FJsonArenaDocument& operator=(const FJsonArenaDocument&);
+};
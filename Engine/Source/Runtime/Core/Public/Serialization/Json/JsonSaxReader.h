@@ -0,0 +1,570 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+/**
+ * A string inside a Json buffer, as found by TJsonSaxReader. Nothing is copied or unescaped until ToString() or
+ * Unescape() is called, so the view is only valid as long as the buffer it points into.
+ */
+template <class CharType = TCHAR>
+struct TJsonStringView
+{
+	/** First character after the opening quote. */
+	const CharType* Chars;
+
+	/** Number of characters before the closing quote, escape sequences included. */
+	int32 Len;
+
+	/** Whether the string has escape sequences, if not the raw characters are the string. */
+	bool bHasEscapes;
+
+	TJsonStringView()
+		: Chars(NULL)
+		, Len(0)
+		, bHasEscapes(false)
+	{
+	}
+
+	TJsonStringView(const CharType* InChars, int32 InLen, bool bInHasEscapes)
+		: Chars(InChars)
+		, Len(InLen)
+		, bHasEscapes(bInHasEscapes)
+	{
+	}
+
+	FORCEINLINE bool IsEmpty() const
+	{
+		return Len == 0;
+	}
+
+	/** Compares to an ascii string without unescaping or converting, strings with escapes never match. */
+	bool Equals(const ANSICHAR* Other) const
+	{
+		if (bHasEscapes)
+		{
+			return false;
+		}
+		int32 Index = 0;
+		for (; Index < Len && Other[Index]; Index++)
+		{
+			if (Chars[Index] != CharType(Other[Index]))
+			{
+				return false;
+			}
+		}
+		return Index == Len && !Other[Index];
+	}
+
+	/**
+	 * Writes the unescaped string, converted to TCHAR, without a terminator.
+	 *
+	 * @param Dest		Buffer for at least Len characters, the unescaped string is never longer than the raw one
+	 * @return			Number of characters written
+	 */
+	int32 Unescape(TCHAR* Dest) const
+	{
+		if (!bHasEscapes && sizeof(CharType) == sizeof(TCHAR))
+		{
+			FMemory::Memcpy(Dest, Chars, Len * sizeof(TCHAR));
+			return Len;
+		}
+
+		TCHAR* Out = Dest;
+		const CharType* Current = Chars;
+		const CharType* End = Chars + Len;
+		while (Current < End)
+		{
+			if (*Current == CharType('\\'))
+			{
+				// the reader made sure escapes are complete and valid
+				Current++;
+				switch (*Current++)
+				{
+				case CharType('b'): *Out++ = TEXT('\b'); break;
+				case CharType('f'): *Out++ = TEXT('\f'); break;
+				case CharType('n'): *Out++ = TEXT('\n'); break;
+				case CharType('r'): *Out++ = TEXT('\r'); break;
+				case CharType('t'): *Out++ = TEXT('\t'); break;
+				case CharType('u'):
+					{
+						uint32 HexNum = 0;
+						for (int32 Digit = 0; Digit < 4; Digit++)
+						{
+							HexNum = (HexNum << 4) | FParse::HexDigit(TCHAR(*Current++));
+						}
+						*Out++ = TCHAR(HexNum);
+					}
+					break;
+				default: *Out++ = TCHAR(Current[-1]); break;
+				}
+			}
+			else
+			{
+				Out += DecodeChar(Current, End, Out);
+			}
+		}
+		return Out - Dest;
+	}
+
+	/** Appends the unescaped string, this is the only place a view allocates. */
+	void AppendTo(FString& Out) const
+	{
+		TArray<TCHAR>& OutChars = Out.GetCharArray();
+		const int32 OldLen = Out.Len();
+		OutChars.SetNum(OldLen + Len + 1);
+		const int32 NewLen = OldLen + Unescape(OutChars.GetTypedData() + OldLen);
+		OutChars[NewLen] = 0;
+		OutChars.SetNum(NewLen + 1);
+	}
+
+	FString ToString() const
+	{
+		FString Result;
+		AppendTo(Result);
+		return Result;
+	}
+
+private:
+
+	/** Copies one character, decoding UTF-8 when the buffer is ANSICHAR, and returns the number of TCHARs written. */
+	static FORCEINLINE int32 DecodeChar(const CharType*& Current, const CharType* End, TCHAR* Out)
+	{
+		if (sizeof(CharType) != 1 || uint8(*Current) < 0x80)
+		{
+			*Out = TCHAR(*Current++);
+			return 1;
+		}
+
+		// UTF-8 lead byte followed by continuation bytes
+		const uint8 Lead = uint8(*Current++);
+		if (Lead < 0xC0)
+		{
+			*Out = TCHAR('?');
+			return 1;
+		}
+		int32 NumContinuation = Lead >= 0xF0 ? 3 : (Lead >= 0xE0 ? 2 : 1);
+		uint32 CodePoint = Lead & (0x3F >> NumContinuation);
+		for (; NumContinuation > 0 && Current < End && (uint8(*Current) & 0xC0) == 0x80; NumContinuation--)
+		{
+			CodePoint = (CodePoint << 6) | (uint8(*Current++) & 0x3F);
+		}
+		if (NumContinuation > 0 || CodePoint > 0x10FFFF)
+		{
+			*Out = TCHAR('?');
+			return 1;
+		}
+		if (sizeof(TCHAR) == 2 && CodePoint > 0xFFFF)
+		{
+			CodePoint -= 0x10000;
+			Out[0] = TCHAR(0xD800 + (CodePoint >> 10));
+			Out[1] = TCHAR(0xDC00 + (CodePoint & 0x3FF));
+			return 2;
+		}
+		*Out = TCHAR(CodePoint);
+		return 1;
+	}
+};
+
+/**
+ * Callback driven Json reader over a raw buffer of TCHAR/UCS2 or UTF-8 (ANSICHAR) characters.
+ *
+ * Unlike TJsonReader it neither copies strings nor builds values; names and strings are reported as views into the buffer
+ * and nesting is tracked on an inline stack, so a parse does no allocations unless the document nests very deeply.
+ * The handler is a template argument so its callbacks can be inlined, it needs these methods (returning false stops):
+ *
+ *	bool OnObjectStart(const TJsonStringView<CharType>& Identifier);
+ *	bool OnObjectEnd();
+ *	bool OnArrayStart(const TJsonStringView<CharType>& Identifier);
+ *	bool OnArrayEnd();
+ *	bool OnString(const TJsonStringView<CharType>& Identifier, const TJsonStringView<CharType>& Value);
+ *	bool OnNumber(const TJsonStringView<CharType>& Identifier, double Value);
+ *	bool OnBoolean(const TJsonStringView<CharType>& Identifier, bool Value);
+ *	bool OnNull(const TJsonStringView<CharType>& Identifier);
+ *
+ * The identifier is empty for array elements and the root. Accepts the same documents as TJsonReader.
+ */
+template <class CharType = TCHAR>
+class TJsonSaxReader
+{
+public:
+
+	typedef TJsonStringView<CharType> FStringView;
+
+	/**
+	 * @param InJson	Buffer to parse, it has to outlive the reader and every view the handler keeps
+	 * @param InLen		Number of characters in the buffer, a terminator is allowed but not needed
+	 */
+	TJsonSaxReader(const CharType* InJson, int32 InLen)
+		: Begin(InJson)
+		, End(InJson + InLen)
+		, Current(InJson)
+	{
+	}
+
+	/** Parses the whole buffer, calling the handler for every value. */
+	template <class HandlerType>
+	bool Parse(HandlerType& Handler)
+	{
+		Current = Begin;
+		Scopes.Reset();
+		ErrorMessage.Empty();
+
+		const FStringView NoIdentifier;
+		SkipWhiteSpace();
+		if (Current == End || (*Current != CharType('{') && *Current != CharType('[')))
+		{
+			return SetErrorMessage(TEXT("Open Curly or Square Brace token expected, but not found."));
+		}
+		if (!ParseValue(Handler, NoIdentifier))
+		{
+			return false;
+		}
+
+		while (Scopes.Num() > 0)
+		{
+			SkipWhiteSpace();
+			if (Current == End)
+			{
+				return SetErrorMessage(TEXT("Improperly formatted."));
+			}
+
+			uint8& Scope = Scopes.Last();
+			const bool bObject = (Scope & SCOPE_Object) != 0;
+			if (*Current == (bObject ? CharType('}') : CharType(']')))
+			{
+				Current++;
+				Scopes.Pop();
+				if (!(bObject ? Handler.OnObjectEnd() : Handler.OnArrayEnd()))
+				{
+					return SetErrorMessage(TEXT("Stopped by the handler."));
+				}
+				continue;
+			}
+
+			if (Scope & SCOPE_HasValues)
+			{
+				if (*Current != CharType(','))
+				{
+					return SetErrorMessage(TEXT("Comma token expected, but not found."));
+				}
+				Current++;
+				SkipWhiteSpace();
+			}
+			Scope |= SCOPE_HasValues;
+
+			FStringView Identifier;
+			if (bObject)
+			{
+				if (Current == End || *Current != CharType('\"'))
+				{
+					return SetErrorMessage(TEXT("String token expected, but not found."));
+				}
+				Current++;
+				if (!ParseString(Identifier))
+				{
+					return false;
+				}
+				SkipWhiteSpace();
+				if (Current == End || *Current != CharType(':'))
+				{
+					return SetErrorMessage(TEXT("Colon token expected, but not found."));
+				}
+				Current++;
+				SkipWhiteSpace();
+			}
+
+			if (!ParseValue(Handler, Identifier))
+			{
+				return false;
+			}
+		}
+
+		SkipWhiteSpace();
+		if (Current != End && *Current != CharType('\0'))
+		{
+			return SetErrorMessage(TEXT("Unexpected additional input found."));
+		}
+		return true;
+	}
+
+	FORCEINLINE const FString& GetErrorMessage() const { return ErrorMessage; }
+
+private:
+
+	enum
+	{
+		SCOPE_Object = 1,
+		SCOPE_HasValues = 2,
+	};
+
+	/** Parses the value at Current, objects and arrays only get opened. */
+	template <class HandlerType>
+	bool ParseValue(HandlerType& Handler, const FStringView& Identifier)
+	{
+		if (Current == End)
+		{
+			return SetErrorMessage(TEXT("Improperly formatted."));
+		}
+
+		bool bContinue = true;
+		const CharType Char = *Current;
+		switch (Char)
+		{
+		case CharType('{'):
+			Current++;
+			Scopes.Add(SCOPE_Object);
+			bContinue = Handler.OnObjectStart(Identifier);
+			break;
+		case CharType('['):
+			Current++;
+			Scopes.Add(0);
+			bContinue = Handler.OnArrayStart(Identifier);
+			break;
+		case CharType('\"'):
+			{
+				Current++;
+				FStringView Value;
+				if (!ParseString(Value))
+				{
+					return false;
+				}
+				bContinue = Handler.OnString(Identifier, Value);
+			}
+			break;
+		case CharType('t'): case CharType('T'):
+		case CharType('f'): case CharType('F'):
+		case CharType('n'): case CharType('N'):
+			{
+				const CharType* Start = Current;
+				while (Current < End && IsAlpha(*Current))
+				{
+					Current++;
+				}
+				if (MatchesLiteral(Start, "true"))
+				{
+					bContinue = Handler.OnBoolean(Identifier, true);
+				}
+				else if (MatchesLiteral(Start, "false"))
+				{
+					bContinue = Handler.OnBoolean(Identifier, false);
+				}
+				else if (MatchesLiteral(Start, "null"))
+				{
+					bContinue = Handler.OnNull(Identifier);
+				}
+				else
+				{
+					return SetErrorMessage(TEXT("Invalid Json Token. Check that your member names have quotes around them!"));
+				}
+			}
+			break;
+		default:
+			{
+				double Value = 0.0;
+				if (!ParseNumber(Value))
+				{
+					return false;
+				}
+				bContinue = Handler.OnNumber(Identifier, Value);
+			}
+			break;
+		}
+
+		if (!bContinue)
+		{
+			return SetErrorMessage(TEXT("Stopped by the handler."));
+		}
+		return true;
+	}
+
+	/** Finds the end of the string that starts at Current, which is just past the opening quote. */
+	bool ParseString(FStringView& OutString)
+	{
+		const CharType* Start = Current;
+		bool bHasEscapes = false;
+		while (Current < End)
+		{
+			const CharType Char = *Current;
+			if (Char == CharType('\"'))
+			{
+				OutString = FStringView(Start, Current - Start, bHasEscapes);
+				Current++;
+				return true;
+			}
+
+			Current++;
+			if (Char == CharType('\\'))
+			{
+				bHasEscapes = true;
+				if (Current == End)
+				{
+					break;
+				}
+
+				switch (*Current++)
+				{
+				case CharType('\"'): case CharType('\\'): case CharType('/'):
+				case CharType('b'): case CharType('f'): case CharType('n'): case CharType('r'): case CharType('t'):
+					break;
+				case CharType('u'):
+					for (int32 Digit = 0; Digit < 4; Digit++, Current++)
+					{
+						if (Current == End)
+						{
+							return SetErrorMessage(TEXT("String Token Abruptly Ended."));
+						}
+						if (!IsHexDigit(*Current))
+						{
+							return SetErrorMessage(TEXT("Invalid Hexadecimal digit parsed."));
+						}
+					}
+					break;
+				default:
+					return SetErrorMessage(TEXT("Bad Json escaped char."));
+				}
+			}
+		}
+
+		return SetErrorMessage(TEXT("String Token Abruptly Ended."));
+	}
+
+	/** Validates a number with the same automaton as TJsonReader and converts it without allocating. */
+	bool ParseNumber(double& OutValue)
+	{
+		const CharType* Start = Current;
+		int32 State = 0;
+		for (; Current < End; Current++)
+		{
+			const CharType Char = *Current;
+			const bool bDigit = Char >= CharType('0') && Char <= CharType('9');
+			const bool bExponent = Char == CharType('e') || Char == CharType('E');
+			int32 NextState = -1;
+			switch (State)
+			{
+			case 0:
+				NextState = Char == CharType('-') ? 1 : (Char == CharType('0') ? 2 : (bDigit ? 3 : -1));
+				break;
+			case 1:
+				NextState = Char == CharType('0') ? 2 : (bDigit ? 3 : -1);
+				break;
+			case 2:
+				NextState = Char == CharType('.') ? 4 : (bExponent ? 5 : -1);
+				break;
+			case 3:
+				NextState = bDigit ? 3 : (Char == CharType('.') ? 4 : (bExponent ? 5 : -1));
+				break;
+			case 4:
+				NextState = bDigit ? 6 : -1;
+				break;
+			case 5:
+				NextState = (Char == CharType('-') || Char == CharType('+')) ? 7 : (bDigit ? 8 : -1);
+				break;
+			case 6:
+				NextState = bDigit ? 6 : (bExponent ? 5 : -1);
+				break;
+			case 7:
+			case 8:
+				NextState = bDigit ? 8 : -1;
+				break;
+			}
+
+			if (NextState < 0)
+			{
+				// characters that can be part of a number make it malformed, anything else ends it
+				if (bDigit || bExponent || Char == CharType('-') || Char == CharType('+') || Char == CharType('.'))
+				{
+					return SetErrorMessage(TEXT("Poorly formed Json Number Token."));
+				}
+				break;
+			}
+			State = NextState;
+		}
+
+		if (State != 2 && State != 3 && State != 6 && State != 8)
+		{
+			return SetErrorMessage(Current == Start ? TEXT("Invalid Json Token.") : TEXT("Poorly formed Json Number Token."));
+		}
+
+		// numbers are ascii, so they can be narrowed into a terminated buffer for Atod
+		TCHAR Buffer[64];
+		const int32 Len = Current - Start;
+		if (Len >= ARRAY_COUNT(Buffer))
+		{
+			FString LongNumber;
+			for (const CharType* Char = Start; Char < Current; Char++)
+			{
+				LongNumber += TCHAR(*Char);
+			}
+			OutValue = FCString::Atod(*LongNumber);
+			return true;
+		}
+		for (int32 Index = 0; Index < Len; Index++)
+		{
+			Buffer[Index] = TCHAR(Start[Index]);
+		}
+		Buffer[Len] = 0;
+		OutValue = FCString::Atod(Buffer);
+		return true;
+	}
+
+	/** Case insensitive like TJsonReader, which also accepts True, False and Null. */
+	bool MatchesLiteral(const CharType* Start, const ANSICHAR* Literal) const
+	{
+		const CharType* Char = Start;
+		for (; Char < Current && *Literal; Char++, Literal++)
+		{
+			if ((*Char | 0x20) != CharType(*Literal))
+			{
+				return false;
+			}
+		}
+		return Char == Current && !*Literal;
+	}
+
+	FORCEINLINE void SkipWhiteSpace()
+	{
+		while (Current < End && (*Current == CharType(' ') || *Current == CharType('\t') || *Current == CharType('\n') || *Current == CharType('\r')))
+		{
+			Current++;
+		}
+	}
+
+	static FORCEINLINE bool IsAlpha(CharType Char)
+	{
+		return (Char >= CharType('a') && Char <= CharType('z')) || (Char >= CharType('A') && Char <= CharType('Z'));
+	}
+
+	static FORCEINLINE bool IsHexDigit(CharType Char)
+	{
+		return (Char >= CharType('0') && Char <= CharType('9')) || (Char >= CharType('a') && Char <= CharType('f')) || (Char >= CharType('A') && Char <= CharType('F'));
+	}
+
+	/** Sets the error with the position of Current and returns false. Lines and characters are only counted here. */
+	bool SetErrorMessage(const TCHAR* Message)
+	{
+		uint32 LineNumber = 1;
+		uint32 CharacterNumber = 0;
+		for (const CharType* Char = Begin; Char < Current && Char < End; Char++)
+		{
+			if (*Char == CharType('\n'))
+			{
+				LineNumber++;
+				CharacterNumber = 0;
+			}
+			else
+			{
+				CharacterNumber++;
+			}
+		}
+		ErrorMessage = FString(Message) + FString::Printf(TEXT(" Line: %u Ch: %u"), LineNumber, CharacterNumber);
+		return false;
+	}
+
+	const CharType* Begin;
+	const CharType* End;
+	const CharType* Current;
+
+	/** SCOPE_ flags of every open object and array. */
+	TArray<uint8, TInlineAllocator<64> > Scopes;
+
+	FString ErrorMessage;
+};
@@ -364,6 +364,9 @@ class CORE_API FStatsThreadState
 	/** Internal method to scan the messages to accumulate any non-frame stats. **/
 	void ProcessMetaDataForLoad(TArray<FStatMessage>& Data);
 
+	/** Internal method to add a message read from a file, completing a frame when it advances the game thread. **/
+	void AddLoadedMessage(FStatMessage const& Read, TArray<FStatMessage>& Messages);
+
 	/** Internal method to add meta data packets to the data structures. **/
 	void ProcessMetaDataOnly(TArray<FStatMessage>& Data);
 
@@ -722,6 +725,110 @@ struct CORE_API FStatsReadStream
 	}
 };
 
+/**
+* State shared by the compact stream writer and reader. Both sides see the same messages, so they track the same thread and the
+* same previous values without sending them.
+*/
+struct CORE_API FStatsCompactStreamState
+{
+	/** Stat id of the thread the current message belongs to, the children of the root node of a condensed frame are the threads. **/
+	uint32 CurrentThreadId;
+
+	/** Nesting depth of ChildrenStart/ChildrenEnd messages. **/
+	int32 Depth;
+
+	/** Last int64 payload sent for a stat on a thread, keyed by thread id and stat id. **/
+	TMap<uint64, int64> LastValues;
+
+	FStatsCompactStreamState()
+		: CurrentThreadId(0)
+		, Depth(0)
+	{
+	}
+
+	/** Updates the current thread and nesting depth for a message. **/
+	FORCEINLINE_STATS void UpdateThread(uint32 StatId, FStatNameAndInfo const& NameAndInfo)
+	{
+		if (Depth == 1)
+		{
+			CurrentThreadId = StatId;
+		}
+		EStatOperation::Type Op = NameAndInfo.GetField<EStatOperation>();
+		if (Op == EStatOperation::ChildrenStart)
+		{
+			Depth++;
+		}
+		else if (Op == EStatOperation::ChildrenEnd)
+		{
+			Depth--;
+		}
+	}
+
+	/** Previous int64 payload of a stat on the current thread, zero the first time. **/
+	FORCEINLINE_STATS int64& FindLastValue(uint32 StatId)
+	{
+		return LastValues.FindOrAdd((uint64(CurrentThreadId) << 32) | StatId);
+	}
+};
+
+/**
+* Class for writing the compact capture format. Every name with its meta data is interned into an id that is sent with its string
+* once, int64 payloads are sent as variable length deltas from the last value of the same stat on the same thread, and the stream
+* is zlib compressed in blocks of roughly BlockSize bytes.
+*/
+struct CORE_API FStatsCompactWriteStream : public FStatsCompactStreamState
+{
+	enum
+	{
+		BlockSize = 256 * 1024
+	};
+
+	/** Map from FName index and meta data to the id we sent for it **/
+	TMap<uint64, uint32> StatIds;
+
+	/** Messages that have not been compressed yet **/
+	TArray<uint8> BlockData;
+
+	/** Compressed blocks to send **/
+	TArray<uint8> OutData;
+
+	/** Constructor, add the header info to the stream. **/
+	FStatsCompactWriteStream();
+
+	/** Grabs a frame from the local FStatsThreadState and adds it to the output, compressing a block when it is full **/
+	void WriteCondensedFrame(int64 TargetFrame);
+
+	/** Compresses whatever is left into OutData, call before the last send. **/
+	void Flush();
+
+	/** Sends the id of a name and its meta data, and the string it represents if we have not sent that id before. **/
+	uint32 WriteStatId(FArchive& Ar, FStatNameAndInfo NameAndInfo);
+
+	/** Write a stat message. **/
+	void WriteMessage(FArchive& Ar, FStatMessage const& Item);
+};
+
+/**
+* Class for reading the compact capture format written by FStatsCompactWriteStream
+*/
+struct CORE_API FStatsCompactReadStream : public FStatsCompactStreamState
+{
+	/** Names and meta data, indexed by the id they were sent with. **/
+	TArray<FStatNameAndInfo> Stats;
+
+	/** Read an id and translate or create the name and meta data it stands for. **/
+	bool ReadStatId(FArchive& Ar, uint32& OutStatId, FStatNameAndInfo& OutNameAndInfo);
+
+	/** Read a stat message. **/
+	bool ReadMessage(FArchive& Ar, FStatMessage& OutMessage);
+
+	/**
+	 * Reads and decompresses the next block and adds its messages.
+	 * @return false if the archive ends in the middle of a block or the block is corrupt
+	 */
+	bool ReadBlock(FArchive& Ar, TArray<FStatMessage>& OutMessages);
+};
+
 /**
 * Predicate to sort stats into reverse order of definition, which historically is how people specified a preferred order.
 */
@@ -864,15 +971,24 @@ struct CORE_API FStatsWriteFile : public TSharedFromThis<FStatsWriteFile, ESPMod
 
 	FString ArchiveFilename;
 	FStastsWriteStream Stream;
+	/** Used instead of Stream by compact captures **/
+	FStatsCompactWriteStream CompactStream;
 	FArchive *File;
 	FAsyncTask<FAsyncWriteWorker>* AsyncTask;
 	FCriticalSection CriticalSection;
 	bool bFirstFrameWritten;
+	bool bCompact;
 	
 
-	FStatsWriteFile();
+	FStatsWriteFile(bool bInCompact = false);
 	~FStatsWriteFile();
 
+	/** Data waiting to be written **/
+	TArray<uint8>& GetOutData()
+	{
+		return bCompact ? CompactStream.OutData : Stream.OutData;
+	}
+
 	void NewFrame(int64 TargetFrame);
 	void SendTask();
 	bool IsValid() const
@@ -103,11 +103,6 @@ private:
 	/** Index of name in hash. */
 	NAME_INDEX		Index;
 
-public:
-	/** Pointer to the next entry in this hash bin's linked list. */
-	FNameEntry*		HashNext;
-
-private:
 	/** Name, variable-sized - note that AllocateNameEntry only allocates memory as needed. */
 	union
 	{
@@ -235,7 +230,7 @@ public:
 	}
 
 	// Friend for access to Flags.
-	friend FNameEntry* AllocateNameEntry( const void* Name, NAME_INDEX Index, FNameEntry* HashNext, bool bIsPureAnsi );
+	friend FNameEntry* AllocateNameEntry( const void* Name, NAME_INDEX Index, bool bIsPureAnsi );
 };
 
 /**
@@ -658,8 +653,12 @@ public:
 	*/
 	static int32 GetNameTableMemorySize()
 	{
-		return GetNameEntryMemorySize() + GetMaxNames() * sizeof(FNameEntry*) + sizeof(NameHash);
+		return GetNameEntryMemorySize() + GetMaxNames() * sizeof(FNameEntry*) + GetNameHashMemorySize();
 	}
+	/**
+	 * @return Size of the name hash table
+	 */
+	static int32 GetNameHashMemorySize();
 
 	/**
 	 * @return number of ansi names in name table
@@ -708,8 +707,6 @@ private:
 	/** Number portion of the string/number pair (stored internally as 1 more than actual, so zero'd memory will be the default, no-instance case) */
 	int32		Number;
 
-	/** Name hash.												*/
-	static FNameEntry*						NameHash[ FNameDefs::NameHashBucketCount ];
 	/** Size of all name entries.								*/
 	static int32							NameEntryMemorySize;	
 	/** Number of ANSI names in name table.						*/
@@ -728,7 +725,7 @@ private:
 	friend const TCHAR* DebugFName(int32);
 	friend const TCHAR* DebugFName(int32, int32);
 	friend const TCHAR* DebugFName(FName&);
-	friend FNameEntry* AllocateNameEntry( const void* Name, NAME_INDEX Index, FNameEntry* HashNext, bool bIsPureAnsi );
+	friend FNameEntry* AllocateNameEntry( const void* Name, NAME_INDEX Index, bool bIsPureAnsi );
 
 	/**
 	 * Shared initialization code (between two constructors)
@@ -754,7 +751,7 @@ private:
 		Init(StringCast<WIDECHAR>(InName).Get(), InNumber, FindType, bSplitName, HardcodeIndex);
 	}
 
-	/** Singleton to retrieve the critical section. */
+	/** Singleton to retrieve the critical section guarding name index assignment and entry allocation. */
 	static FCriticalSection* GetCriticalSection();
 
 };
@@ -25,6 +25,11 @@ DECLARE_CYCLE_STAT(TEXT("PostLoadObjects AsyncPackage"),STAT_FAsyncPackage_PostL
 DECLARE_CYCLE_STAT(TEXT("FinishObjects AsyncPackage"),STAT_FAsyncPackage_FinishObjects,STATGROUP_AsyncLoad);
 
 DECLARE_CYCLE_STAT(TEXT("Async Loading Time"),STAT_AsyncLoadingTime,STATGROUP_AsyncLoad);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Game Thread Async Loading (ms)"),STAT_AsyncLoadingGameThreadTime,STATGROUP_AsyncLoad);
+
+DECLARE_CYCLE_STAT(TEXT("Serialize Tables AsyncLoadingThread"),STAT_AsyncLoadingThread_SerializeTables,STATGROUP_AsyncLoad);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Packages Parsed On Loading Thread"),STAT_AsyncLoadingThread_NumPackages,STATGROUP_AsyncLoad);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Game Thread Wait For Loading Thread (ms)"),STAT_AsyncLoadingThread_GameThreadWaitTime,STATGROUP_AsyncLoad);
 
 
 
@@ -45,6 +50,165 @@ void NotifyConstructedDuringAsyncLoading(UObject* Object)
 }
 
 
+/*-----------------------------------------------------------------------------
+	FAsyncLoadingThread.
+-----------------------------------------------------------------------------*/
+
+/**
+ * Thread serializing the package file summary, name, import and export maps of packages being
+ * async loaded. Creating and serializing objects and PostLoad stay on the game thread, as object
+ * creation and lookup aren't thread safe, but parsing the tables and waiting for their I/O no longer
+ * takes game thread time.
+ *
+ * Enabled with AsyncLoadingThread=True in the [Core.System] section of the engine ini or with
+ * -asyncloadingthread on the command line. Only used for seek free or quiet loads, other loads
+ * report progress to GWarn while serializing the summary.
+ */
+class FAsyncLoadingThread : public FRunnable
+{
+	/** Packages the game thread handed over, in the order they were queued. */
+	TArray<FAsyncPackage*> QueuedPackages;
+	/** Guards QueuedPackages. */
+	FCriticalSection QueueCritical;
+	/** Triggered when a package is queued. */
+	FEvent* QueuedEvent;
+	/** Set to stop the thread. */
+	FThreadSafeCounter StopTaskCounter;
+	/** The thread itself. */
+	FRunnableThread* Thread;
+
+	/** The only instance, NULL until the thread is first used. */
+	static FAsyncLoadingThread* Singleton;
+
+	FAsyncLoadingThread()
+		: QueuedEvent(FPlatformProcess::CreateSynchEvent())
+		, Thread(NULL)
+	{
+		Thread = FRunnableThread::Create(this, TEXT("AsyncLoadingThread"), 0, 0, 128 * 1024, TPri_Normal);
+		check(Thread != NULL);
+	}
+
+	~FAsyncLoadingThread()
+	{
+		delete Thread;
+		Thread = NULL;
+		delete QueuedEvent;
+		QueuedEvent = NULL;
+	}
+
+public:
+	/**
+	 * @return true if the async loading thread should be used.
+	 */
+	static bool IsEnabled()
+	{
+		static bool bEnabled = false;
+		static bool bInitialized = false;
+		if (!bInitialized)
+		{
+			if (!GConfig->GetBool(TEXT("Core.System"), TEXT("AsyncLoadingThread"), bEnabled, GEngineIni))
+			{
+				bEnabled = false;
+			}
+			bEnabled = (bEnabled || FParse::Param(FCommandLine::Get(), TEXT("asyncloadingthread"))) && FPlatformProcess::SupportsMultithreading();
+			bInitialized = true;
+		}
+		return bEnabled;
+	}
+
+	/** Returns the thread, starting it on first use. Game thread only. */
+	static FAsyncLoadingThread& Get()
+	{
+		check(IsInGameThread());
+		if (Singleton == NULL)
+		{
+			Singleton = new FAsyncLoadingThread();
+		}
+		return *Singleton;
+	}
+
+	/**
+	 * Stops the thread and waits for it to exit, if it was ever started. Packages still queued are
+	 * left alone, the game thread no longer ticks them. Game thread only.
+	 */
+	static void Shutdown()
+	{
+		check(IsInGameThread());
+		if (Singleton != NULL)
+		{
+			// Kill calls Stop and, as told to wait, joins the thread.
+			Singleton->Thread->Kill(true);
+			delete Singleton;
+			Singleton = NULL;
+		}
+	}
+
+	/**
+	 * Queues a package whose linker has a loader. The game thread must not tick the linker until the
+	 * package's LoadingThreadState changes from LoadingThread_Queued.
+	 */
+	void QueuePackage(FAsyncPackage* Package)
+	{
+		{
+			FScopeLock Lock(&QueueCritical);
+			QueuedPackages.Add(Package);
+		}
+		QueuedEvent->Trigger();
+	}
+
+	// FRunnable interface.
+
+	virtual uint32 Run() OVERRIDE
+	{
+		TArray<FAsyncPackage*> Packages;
+		while (StopTaskCounter.GetValue() == 0)
+		{
+			{
+				FScopeLock Lock(&QueueCritical);
+				Packages = QueuedPackages;
+			}
+			if (Packages.Num() == 0)
+			{
+				QueuedEvent->Wait();
+				continue;
+			}
+
+			// Work on all queued packages so one waiting for I/O doesn't hold up the others.
+			bool bAnyFinished = false;
+			for (int32 PackageIndex = 0; PackageIndex < Packages.Num(); PackageIndex++)
+			{
+				FAsyncPackage* Package = Packages[PackageIndex];
+				if (Package->SerializeLinkerTablesOnLoadingThread())
+				{
+					FScopeLock Lock(&QueueCritical);
+					QueuedPackages.RemoveSingle(Package);
+					bAnyFinished = true;
+				}
+			}
+
+			if (!bAnyFinished)
+			{
+				// Everything is waiting for I/O.
+				FPlatformProcess::Sleep(0.001f);
+			}
+		}
+		return 0;
+	}
+
+	virtual void Stop() OVERRIDE
+	{
+		StopTaskCounter.Increment();
+		QueuedEvent->Trigger();
+	}
+};
+
+FAsyncLoadingThread* FAsyncLoadingThread::Singleton = NULL;
+
+void ShutdownAsyncLoadingThread()
+{
+	FAsyncLoadingThread::Shutdown();
+}
+
 /*-----------------------------------------------------------------------------
 	FAsyncPackage implementation.
 -----------------------------------------------------------------------------*/
@@ -336,6 +500,12 @@ EAsyncPackageState::Type FAsyncPackage::FinishLinker()
 		SCOPE_CYCLE_COUNTER(STAT_FAsyncPackage_FinishLinker);
 		LastObjectWorkWasPerformedOn	= Linker->LinkerRoot;
 		LastTypeOfWorkPerformed			= TEXT("ticking linker");
+
+		// Let the async loading thread serialize the linker tables first.
+		if( !WaitForLoadingThread() )
+		{
+			return EAsyncPackageState::TimeOut;
+		}
 	
 		// Operation still pending if Tick returns false
 		if( Linker->Tick( TimeLimit, bUseTimeLimit ) != ULinkerLoad::LINKER_Loaded)
@@ -349,6 +519,87 @@ EAsyncPackageState::Type FAsyncPackage::FinishLinker()
 	return EAsyncPackageState::Complete;
 }
 
+/**
+ * Hands the linker tables to the async loading thread if it's enabled and waits for it to finish them.
+ *
+ * @return true if the game thread can tick the linker, false if the loading thread is still busy or failed
+ */
+bool FAsyncPackage::WaitForLoadingThread()
+{
+	switch( LoadingThreadState.GetValue() )
+	{
+	case LoadingThread_None:
+		if( !FAsyncLoadingThread::IsEnabled() || !(Linker->LoadFlags & (LOAD_SeekFree | LOAD_Quiet)) )
+		{
+			LoadingThreadState.Set( LoadingThread_NotUsed );
+			return true;
+		}
+		else
+		{
+			// Creating the loader looks up other linkers so it has to happen here.
+			const ULinkerLoad::ELinkerStatus Status = Linker->TickCreateLoader();
+			if( Status == ULinkerLoad::LINKER_Failed )
+			{
+				UE_LOG(LogStreaming, Error, TEXT("FAsyncPackage::FinishLinker failed to create loader for %s."), *PackageNameToLoad);
+				bLoadHasFailed = true;
+				return false;
+			}
+			LoadingThreadState.Set( LoadingThread_Queued );
+			FAsyncLoadingThread::Get().QueuePackage( this );
+		}
+		// Fall through to wait for the loading thread.
+
+	case LoadingThread_Queued:
+		if( bUseTimeLimit )
+		{
+			GiveUpTimeSlice();
+			return false;
+		}
+		else
+		{
+#if STATS
+			const double WaitStartTime = FPlatformTime::Seconds();
+#endif
+			while( LoadingThreadState.GetValue() == LoadingThread_Queued )
+			{
+				SHUTDOWN_IF_EXIT_REQUESTED;
+				FPlatformProcess::Sleep(0);
+			}
+			INC_FLOAT_STAT_BY( STAT_AsyncLoadingThread_GameThreadWaitTime, (float)((FPlatformTime::Seconds() - WaitStartTime) * 1000.0) );
+			return WaitForLoadingThread();
+		}
+
+	case LoadingThread_Failed:
+		UE_LOG(LogStreaming, Error, TEXT("FAsyncPackage::FinishLinker failed to serialize tables of %s."), *PackageNameToLoad);
+		bLoadHasFailed = true;
+		return false;
+
+	default:
+		return true;
+	}
+}
+
+/**
+ * Serializes the package file summary, name, import and export maps. Called on the async loading thread.
+ *
+ * @return true if done, false if the linker is still waiting for I/O
+ */
+bool FAsyncPackage::SerializeLinkerTablesOnLoadingThread()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AsyncLoadingThread_SerializeTables);
+
+	const ULinkerLoad::ELinkerStatus Status = Linker->TickSerializeTables();
+	if( Status == ULinkerLoad::LINKER_TimedOut )
+	{
+		return false;
+	}
+
+	INC_DWORD_STAT(STAT_AsyncLoadingThread_NumPackages);
+	// Publishes the linker state to the game thread, nothing here may touch the package afterwards.
+	LoadingThreadState.Set( Status == ULinkerLoad::LINKER_Loaded ? LoadingThread_Finished : LoadingThread_Failed );
+	return true;
+}
+
 /**
  * Find a package by name.
  * 
@@ -935,6 +1186,9 @@ int32 GetNumAsyncPackages()
 EAsyncPackageState::Type ProcessAsyncLoading( bool bUseTimeLimit, float TimeLimit, FName ExcludeType )
 {
 	SCOPE_CYCLE_COUNTER(STAT_AsyncLoadingTime);
+#if STATS
+	const double ProcessStartTime = FPlatformTime::Seconds();
+#endif
 	// Whether to continue execution.
 	EAsyncPackageState::Type LoadingState = EAsyncPackageState::Complete;
 	EAsyncPackageState::Type CompletionState = EAsyncPackageState::Complete;
@@ -997,6 +1251,7 @@ EAsyncPackageState::Type ProcessAsyncLoading( bool bUseTimeLimit, float TimeLimi
 		CompletionState = FMath::Min(CompletionState, LoadingState);
 		// We cannot access Package anymore!
 	}
+	INC_FLOAT_STAT_BY(STAT_AsyncLoadingGameThreadTime, (float)((FPlatformTime::Seconds() - ProcessStartTime) * 1000.0));
 	return CompletionState;
 }
 
@@ -50,6 +50,54 @@ static volatile bool GIsRunningParallelReachability = false;
 /** Whether we are currently purging an object in the GC purge pass. */
 static bool GIsPurgingObject = false;
 
+/** Currently running a slice or the final pass of an incremental reachability analysis.						*/
+static bool GIsRunningIncrementalReachability = false;
+/**
+ * Objects reached by the incremental reachability analysis, indexed by object index. RF_Unreachable can't be used
+ * as weak pointers, object iterators and hash lookups would treat all objects that haven't been reached yet as dead.
+ */
+static TBitArray<> GIncrementalReachedObjects;
+
+DECLARE_FLOAT_COUNTER_STAT(TEXT("GC Incremental Mark Time (ms)"),STAT_GCIncrementalMarkTime,STATGROUP_Object);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("GC Incremental Worst Pause (ms)"),STAT_GCIncrementalWorstPause,STATGROUP_Object);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("GC Incremental Frames"),STAT_GCIncrementalFrames,STATGROUP_Object);
+
+/**
+ * Marks an object as reached by the incremental reachability analysis.
+ *
+ * @return true if the object hasn't been reached before and its references need to be processed
+ */
+static FORCEINLINE bool MarkReachedIncrementally( UObject* Object )
+{
+	const int32 Index = GUObjectArray.ObjectToIndex(Object);
+	if( GIsRunningParallelReachability )
+	{
+		// Several GC tasks may reach the same object, only the one that sets the bit processes it.
+		volatile int32* Word = (volatile int32*)&GIncrementalReachedObjects.GetData()[ Index / NumBitsPerDWORD ];
+		const int32 Mask = 1 << ( Index & ( NumBitsPerDWORD - 1 ) );
+		while( true )
+		{
+			const int32 Old = *Word;
+			if( Old & Mask )
+			{
+				return false;
+			}
+			if( FPlatformAtomics::InterlockedCompareExchange( Word, Old | Mask, Old ) == Old )
+			{
+				return true;
+			}
+		}
+	}
+
+	FBitReference Reached = GIncrementalReachedObjects[ Index ];
+	if( Reached )
+	{
+		return false;
+	}
+	Reached = true;
+	return true;
+}
+
 /**
  * If set and VERIFY_DISREGARD_GC_ASSUMPTIONS is true, we verify GC assumptions about "Disregard For GC" objects. We also
  * verify that no unreachable actors/ components are referenced if VERIFY_NO_UNREACHABLE_OBJECTS_ARE_REFERENCED
@@ -179,6 +227,14 @@ static FORCEINLINE void HandleObjectReference( TArray<UObject*>& ObjectsToSerial
 				// Null out reference.
 				Object = NULL;
 			}
+			// The incremental reachability analysis tracks reached objects itself as RF_Unreachable isn't set before it has finished.
+			else if( GIsRunningIncrementalReachability )
+			{
+				if( MarkReachedIncrementally( Object ) )
+				{
+					ObjectsToSerialize.Add( Object );
+				}
+			}
 			// Add encountered object reference to list of to be serialized objects if it hasn't already been added.
 			else if( Object->HasAnyFlags( RF_Unreachable ) )
 			{				
@@ -473,34 +529,51 @@ public:
 			}
 			else
 			{				
-				GIsRunningParallelReachability = true;
-
-				int32 NumChunks = FMath::Min<int32>(FTaskGraphInterface::Get().GetNumWorkerThreads(), ObjectsToSerialize.Num());
-				int32 NumPerChunk = ObjectsToSerialize.Num() / NumChunks;
-				check(NumPerChunk > 0);
-				FGraphEventArray ChunkTasks;
-				ChunkTasks.Empty(NumChunks);
-				int32 StartIndex = 0;
-				for (int32 Chunk = 0; Chunk < NumChunks; Chunk++)
-				{
-					if (Chunk + 1 == NumChunks)
-					{
-						NumPerChunk = ObjectsToSerialize.Num() - StartIndex; // last chunk takes all remaining items
-					}
-					ChunkTasks.Add(TGraphTask<FGCTask>::CreateTask().ConstructAndDispatchWhenReady(this, &ObjectsToSerialize, StartIndex, NumPerChunk));
-					StartIndex += NumPerChunk;
-				}
-				FTaskGraphInterface::Get().WaitUntilTasksComplete(ChunkTasks, ENamedThreads::GameThread_Local);
-				GIsRunningParallelReachability = false;
+				DispatchObjectTasks( ObjectsToSerialize );
 			}
 		}
 	}
 
+	/**
+	 * Processes the references of all objects in the array and of all objects found along the way on the task graph
+	 * worker threads, and waits for them to finish.
+	 *
+	 * @param ObjectsToSerialize	Objects to process, already marked as reachable
+	 */
 	void DispatchObjectTasks(TArray<UObject*>& ObjectsToSerialize)
 	{
+		check(!GIsRunningParallelReachability);
+		GIsRunningParallelReachability = true;
+
+		int32 NumChunks = FMath::Min<int32>(FTaskGraphInterface::Get().GetNumWorkerThreads(), ObjectsToSerialize.Num());
+		int32 NumPerChunk = ObjectsToSerialize.Num() / NumChunks;
+		check(NumPerChunk > 0);
+		FGraphEventArray ChunkTasks;
+		ChunkTasks.Empty(NumChunks);
+		int32 StartIndex = 0;
+		for (int32 Chunk = 0; Chunk < NumChunks; Chunk++)
+		{
+			if (Chunk + 1 == NumChunks)
+			{
+				NumPerChunk = ObjectsToSerialize.Num() - StartIndex; // last chunk takes all remaining items
+			}
+			ChunkTasks.Add(TGraphTask<FGCTask>::CreateTask().ConstructAndDispatchWhenReady(this, &ObjectsToSerialize, StartIndex, NumPerChunk));
+			StartIndex += NumPerChunk;
+		}
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(ChunkTasks, ENamedThreads::GameThread_Local);
+		GIsRunningParallelReachability = false;
 	}
 
-	void ProcessObjectArray(TArray<UObject*>& InObjectsToSerializeArray, FGraphEventRef& MyCompletionGraphEvent)
+	/**
+	 * Processes the references of all objects in the array and of all objects found along the way.
+	 *
+	 * @param InObjectsToSerializeArray	Objects to process
+	 * @param MyCompletionGraphEvent	Completion event of the task that runs this, used to spawn sub tasks during parallel reachability
+	 * @param TimeLimitEnd				If not 0, processing stops once FPlatformTime::Seconds() passes it and the objects that still
+	 *									need to be processed are handed back in InObjectsToSerializeArray
+	 * @return true if all objects have been processed, false if the time limit was hit
+	 */
+	bool ProcessObjectArray(TArray<UObject*>& InObjectsToSerializeArray, FGraphEventRef& MyCompletionGraphEvent, double TimeLimitEnd = 0.0)
 	{		
 		UObject* CurrentObject = NULL;
 
@@ -523,6 +596,10 @@ public:
 		// it is necessary to have at least one extra item in the array memory block for the iffy prefetch code, below
 		ObjectsToSerialize.Reserve(ObjectsToSerialize.Num() + 1);
 	
+		// FPlatformTime::Seconds is too expensive to check the time limit for every object.
+		const int32 TimeLimitCheckGranularity = 64;
+		int32 ObjectsSinceTimeLimitCheck = 0;
+
 		// Keep serializing objects till we reach the end of the growing array at which point
 		// we are done.
 		int32 CurrentIndex = 0;
@@ -531,6 +608,17 @@ public:
 			FGCCollector ReferenceCollector( NewObjectsToSerialize );
 			while( CurrentIndex < ObjectsToSerialize.Num() )
 			{
+				if( TimeLimitEnd > 0.0 && ++ObjectsSinceTimeLimitCheck == TimeLimitCheckGranularity )
+				{
+					ObjectsSinceTimeLimitCheck = 0;
+					if( FPlatformTime::Seconds() > TimeLimitEnd )
+					{
+						// ObjectsToSerialize is the caller's array, leave the objects that haven't been processed yet in it.
+						ObjectsToSerialize.RemoveAt( 0, CurrentIndex, false );
+						ObjectsToSerialize.Append( NewObjectsToSerialize );
+						return false;
+					}
+				}
 #if PERF_DETAILED_PER_CLASS_GC_STATS
 				uint32 StartCycles = FPlatformTime::Cycles();
 #endif
@@ -746,9 +834,288 @@ public:
 			}
 		}
 		while( CurrentIndex < ObjectsToSerialize.Num() );
+
+		return true;
 	}
 };
 
+/**
+ * Reachability analysis that is spread over several frames.
+ *
+ * Reached objects are tracked in GIncrementalReachedObjects and RF_Unreachable is only set once the analysis has
+ * finished. The game keeps changing the object graph between the slices: objects created during the analysis are
+ * treated as reached, and objects a reference is stored to go through IncrementalReachabilityWriteBarrier, which
+ * marks them and queues them for processing. The final pass only rescans what may have changed outside of that, the
+ * root set and kept objects (which include FGCObject references) and the created objects, on the GC worker threads.
+ * Objects that became unreachable during the analysis may survive it and are collected by the next one.
+ */
+class FIncrementalReachabilityAnalysis : public FUObjectArray::FUObjectCreateListener
+{
+	/** Objects with these flags are kept regardless of being referenced or not */
+	EObjectFlags KeepFlags;
+	/** Reached objects whose references haven't been processed yet */
+	TArray<UObject*> ObjectsToSerialize;
+	/** Objects created since the analysis started, their references are processed and the token streams of the classes among them assembled when it finishes */
+	TArray<UObject*> CreatedObjects;
+	/** Objects marked by the write barrier since the last slice */
+	TArray<UObject*> BarrierObjects;
+	/** Time the analysis was started */
+	double StartTime;
+	/** Time spent in all slices so far */
+	double TotalSliceTime;
+	/** Time spent in the longest slice so far */
+	double MaxSliceTime;
+	/** Number of slices so far */
+	int32 NumSlices;
+	/** Number of objects created since the analysis started */
+	int32 NumCreatedObjects;
+	/** Number of objects marked by the write barrier since the analysis started */
+	int32 NumBarrierObjects;
+
+public:
+	/**
+	 * Starts the analysis by marking the root set and objects with any of the KeepFlags as reached.
+	 *
+	 * @param InKeepFlags	Objects with these flags will be kept regardless of being referenced or not
+	 */
+	FIncrementalReachabilityAnalysis( EObjectFlags InKeepFlags )
+		: KeepFlags( InKeepFlags )
+		, StartTime( FPlatformTime::Seconds() )
+		, TotalSliceTime( 0.0 )
+		, MaxSliceTime( 0.0 )
+		, NumSlices( 0 )
+		, NumCreatedObjects( 0 )
+		, NumBarrierObjects( 0 )
+	{
+		check( !GIsIncrementalReachabilityPending );
+		GObjectCountDuringLastMarkPhase = 0;
+		GIncrementalReachedObjects.Init( false, GUObjectArray.GetObjectArrayNum() );
+		ObjectsToSerialize.Empty( GUObjectArray.GetObjectArrayNumMinusPermanent() + 2 );
+
+		for( FRawObjectIterator It(true); It; ++It )
+		{
+			UObject* Object = *It;
+
+			// We can't collect garbage during an async load operation and by now all unreachable objects should've been purged.
+			checkf( !Object->HasAnyFlags(RF_AsyncLoading|RF_Unreachable), TEXT("%s"), *Object->GetFullName() );
+
+			// Keep track of how many objects are around.
+			GObjectCountDuringLastMarkPhase++;
+
+			AddIfRootOrKept( Object );
+
+			// Assemble token stream for UClass objects. This is only done once for each class.
+			AssembleTokenStreamIfClass( Object );
+		}
+
+		GUObjectArray.AddUObjectCreateListener( this );
+		GIsIncrementalReachabilityPending = true;
+	}
+
+	/** Stops tracking created objects and stored references, and frees the reached object marks. */
+	virtual ~FIncrementalReachabilityAnalysis()
+	{
+		GIsIncrementalReachabilityPending = false;
+		GUObjectArray.RemoveUObjectCreateListener( this );
+		GIncrementalReachedObjects.Empty();
+	}
+
+	/**
+	 * Processes reached objects until all have been processed or the time limit has been hit.
+	 *
+	 * @param TimeLimitEnd	FPlatformTime::Seconds() to stop at, 0 to process all reachable objects
+	 * @return true if all reachable objects have been processed
+	 */
+	bool Mark( double TimeLimitEnd )
+	{
+		ObjectsToSerialize.Append( BarrierObjects );
+		BarrierObjects.Reset();
+
+		GIsRunningIncrementalReachability = true;
+		FArchiveRealtimeGC TagUsedRealtimeGC;
+		FGraphEventRef InvalidRef;
+		const bool bFinished = TagUsedRealtimeGC.ProcessObjectArray( ObjectsToSerialize, InvalidRef, TimeLimitEnd );
+		GIsRunningIncrementalReachability = false;
+
+		if( bFinished )
+		{
+			// The array still holds the last batch of processed objects.
+			ObjectsToSerialize.Reset();
+		}
+		return bFinished;
+	}
+
+	/**
+	 * Rescans the root set, kept objects, objects created during the analysis and objects marked by the write barrier,
+	 * and marks all objects that haven't been reached as RF_Unreachable. Async loading has to be flushed before.
+	 *
+	 * @param bForceSingleThreaded	If true, the final pass runs on the game thread instead of the GC worker threads
+	 * @param bVerify				If true, RF_Unreachable is set by a full reachability analysis instead, and reachable
+	 *								objects the incremental one missed are reported
+	 */
+	void Finish( bool bForceSingleThreaded, bool bVerify )
+	{
+		// The root set and FGCObject references aren't covered by the write barrier, and created objects were marked before
+		// their references were set, so they are processed again even though they have been reached. Everything else that
+		// has been reached either hasn't changed since it was processed or went through the write barrier.
+		ObjectsToSerialize.Append( BarrierObjects );
+		BarrierObjects.Empty();
+		for( int32 ObjectIndex = 0; ObjectIndex < CreatedObjects.Num(); ObjectIndex++ )
+		{
+			AssembleTokenStreamIfClass( CreatedObjects[ObjectIndex] );
+			ObjectsToSerialize.Add( CreatedObjects[ObjectIndex] );
+		}
+		CreatedObjects.Empty();
+		for( FRawObjectIterator It(true); It; ++It )
+		{
+			AddIfRootOrKept( *It );
+		}
+
+		if( ObjectsToSerialize.Num() )
+		{
+			GIsRunningIncrementalReachability = true;
+			FArchiveRealtimeGC TagUsedRealtimeGC;
+			if( bForceSingleThreaded )
+			{
+				FGraphEventRef InvalidRef;
+				TagUsedRealtimeGC.ProcessObjectArray( ObjectsToSerialize, InvalidRef );
+			}
+			else
+			{
+				TagUsedRealtimeGC.DispatchObjectTasks( ObjectsToSerialize );
+			}
+			GIsRunningIncrementalReachability = false;
+			ObjectsToSerialize.Empty();
+		}
+
+		if( bVerify )
+		{
+			FArchiveRealtimeGC TagUsedRealtimeGC;
+			TagUsedRealtimeGC.PerformReachabilityAnalysis( KeepFlags, true );
+
+			int32 NumMissedObjects = 0;
+			for( FRawObjectIterator It(true); It; ++It )
+			{
+				UObject* Object = *It;
+				if( !Object->HasAnyFlags( RF_Unreachable ) && !GIncrementalReachedObjects[ GUObjectArray.ObjectToIndex(Object) ] )
+				{
+					UE_LOG(LogGarbage, Warning, TEXT("Incremental GC missed reachable object %s"), *Object->GetFullName() );
+					NumMissedObjects++;
+				}
+			}
+			UE_LOG(LogGarbage, Log, TEXT("Incremental GC verified, %d reachable objects missed"), NumMissedObjects );
+			return;
+		}
+
+		for( FRawObjectIterator It(true); It; ++It )
+		{
+			UObject* Object = *It;
+			if( !GIncrementalReachedObjects[ GUObjectArray.ObjectToIndex(Object) ] )
+			{
+				Object->SetFlags( RF_Unreachable );
+			}
+		}
+	}
+
+	/**
+	 * Adds a call to IncrementalCollectGarbage to the stats.
+	 *
+	 * @param SliceTime	Time spent in the call
+	 */
+	void RecordSlice( double SliceTime )
+	{
+		TotalSliceTime += SliceTime;
+		MaxSliceTime = FMath::Max( MaxSliceTime, SliceTime );
+		NumSlices++;
+
+		INC_FLOAT_STAT_BY( STAT_GCIncrementalMarkTime, (float)(SliceTime * 1000.0) );
+		SET_FLOAT_STAT( STAT_GCIncrementalWorstPause, (float)(MaxSliceTime * 1000.0) );
+		SET_DWORD_STAT( STAT_GCIncrementalFrames, NumSlices );
+	}
+
+	/** Logs how the analysis was spread over frames. */
+	void LogStats() const
+	{
+		UE_LOG(LogGarbage, Log, TEXT("%f ms for incremental GC in %d frames over %f ms, worst frame %f ms, %d objects created and %d kept by the write barrier during GC"),
+			TotalSliceTime * 1000, NumSlices, (FPlatformTime::Seconds() - StartTime) * 1000, MaxSliceTime * 1000, NumCreatedObjects, NumBarrierObjects );
+	}
+
+	/**
+	 * Marks an object a reference has been stored to as reached, and queues it for processing if it hasn't been reached before.
+	 *
+	 * @param Object	Object a reference has been stored to
+	 */
+	void HandleWriteBarrier( UObject* Object )
+	{
+		if( !GUObjectAllocator.ResidesInPermanentPool(Object) && MarkReachedIncrementally( Object ) )
+		{
+			BarrierObjects.Add( Object );
+			NumBarrierObjects++;
+		}
+	}
+
+	// Begin FUObjectCreateListener interface
+	virtual void NotifyUObjectCreated( const UObjectBase* Object, int32 Index ) OVERRIDE
+	{
+		while( Index >= GIncrementalReachedObjects.Num() )
+		{
+			GIncrementalReachedObjects.Add( false );
+		}
+		// Index might be reused from an object purged before the analysis started.
+		GIncrementalReachedObjects[Index] = true;
+		CreatedObjects.Add( (UObject*)Object );
+		NumCreatedObjects++;
+	}
+	// End FUObjectCreateListener interface
+
+private:
+	/** Adds an object to the objects to process if it is part of the root set or has any of the KeepFlags and isn't pending kill. */
+	void AddIfRootOrKept( UObject* Object )
+	{
+		if( Object->HasAnyFlags( RF_RootSet ) )
+		{
+			// We cannot use RF_PendingKill on objects that are part of the root set.
+			checkCode( if( Object->HasAnyFlags( RF_PendingKill ) ) { UE_LOG(LogGarbage, Fatal, TEXT("Object %s is part of root set though has been marked RF_PendingKill!"), *Object->GetFullName() ); } );
+			MarkReachedIncrementally( Object );
+			ObjectsToSerialize.Add( Object );
+		}
+		else if( Object->HasAnyFlags( KeepFlags ) && !Object->HasAnyFlags( RF_PendingKill ) )
+		{
+			MarkReachedIncrementally( Object );
+			ObjectsToSerialize.Add( Object );
+		}
+	}
+
+	/** Assembles the reference token stream of a class that doesn't have one yet. */
+	static void AssembleTokenStreamIfClass( UObject* Object )
+	{
+		UClass* Class = Cast<UClass>(Object);
+		if( Class && !Class->HasAnyClassFlags(CLASS_TokenStreamAssembled) )
+		{
+			Class->AssembleReferenceTokenStream();
+			check(Class->HasAnyClassFlags(CLASS_TokenStreamAssembled));
+		}
+	}
+};
+
+/** The incremental reachability analysis in progress, if any. */
+static FIncrementalReachabilityAnalysis* GIncrementalReachabilityAnalysis = NULL;
+
+/** Whether an incremental reachability analysis is pending, only exposed for IncrementalReachabilityWriteBarrier. */
+COREUOBJECT_API bool GIsIncrementalReachabilityPending = false;
+
+/**
+ * Keeps an object alive during an incremental reachability analysis, called by IncrementalReachabilityWriteBarrier.
+ *
+ * @param	Object	object a reference has been stored to
+ */
+void MarkObjectReachableIncrementally( UObject* Object )
+{
+	check( IsInGameThread() );
+	check( GIncrementalReachabilityAnalysis );
+	GIncrementalReachabilityAnalysis->HandleWriteBarrier( Object );
+}
+
 /**
  * Incrementally purge garbage by deleting all unreferenced objects after routing Destroy.
  *
@@ -1020,14 +1387,15 @@ COREUOBJECT_API EditorPostReachabilityAnalysisCallbackType EditorPostReachabilit
 static const auto CVarAllowParallelGC = 
 	IConsoleManager::Get().RegisterConsoleVariable( TEXT("AllowParallelGC"), 1, TEXT("Used to control parallel GC.") )->AsVariableInt();
 
-/** 
- * Deletes all unreferenced objects, keeping objects that have any of the passed in KeepFlags set
- *
- * @param	KeepFlags			objects with those flags will be kept regardless of being referenced or not
- * @param	bPerformFullPurge	if true, perform a full purge after the mark pass
- */
+// Allow checking the incremental GC against a full reachability analysis via console command.
+static const auto CVarVerifyIncrementalReachability = 
+	IConsoleManager::Get().RegisterConsoleVariable( TEXT("VerifyIncrementalReachability"), 0, TEXT("If 1, incremental GC runs a full reachability analysis when it finishes and reports reachable objects it missed, e.g. because native code stored a reference without calling IncrementalReachabilityWriteBarrier.") )->AsVariableInt();
 
-void CollectGarbage( EObjectFlags KeepFlags, bool bPerformFullPurge )
+/**
+ * Routes PreGarbageCollect so we can ensure that we are e.g. not in the middle of loading something by flushing
+ * the async loading, etc...
+ */
+static void BroadcastPreGarbageCollect()
 {
 	// Helper class to register FlushAsyncLoadingCallback on first GC run.
 	struct FAddFlushAsyncLoadingCallback
@@ -1042,15 +1410,95 @@ void CollectGarbage( EObjectFlags KeepFlags, bool bPerformFullPurge )
 			FlushAsyncLoading();
 		}
 	};
-	// Add FlushAsyncLoadingCallback the first time CollectGarbage is called.
+	// Add FlushAsyncLoadingCallback the first time a garbage collection is started.
 	static FAddFlushAsyncLoadingCallback AddFlushAsyncLoadingCallback;
 
+	FCoreDelegates::PreGarbageCollect.Broadcast();
+}
+
+/**
+ * Begins the destruction of all objects the reachability analysis has marked RF_Unreachable and ends the garbage collection.
+ *
+ * @param	bPerformFullPurge	if true, perform a full purge
+ */
+static void BeginDestroyUnreachableObjects( bool bPerformFullPurge )
+{
+#if WITH_EDITOR
+	if ( GIsEditor && EditorPostReachabilityAnalysisCallback )
+	{
+		EditorPostReachabilityAnalysisCallback();
+	}
+#endif // WITH_EDITOR
+
+	// Unhash all unreachable objects.
+	const double StartTime = FPlatformTime::Seconds();
+	for ( FRawObjectIterator It(true); It; ++It )
+	{
+		//@todo UE4 - A prefetch was removed here. Re-add it. It wasn't right anyway, since it was ten items ahead and the consoles on have 8 prefetch slots
+
+		UObject* Object = *It;
+		if( Object->HasAnyFlags( RF_Unreachable ) )
+		{
+			// Begin the object's asynchronous destruction.
+			Object->ConditionalBeginDestroy();
+		}
+	}
+	UE_LOG(LogGarbage, Log, TEXT("%f ms for unhashing unreachable objects"), (FPlatformTime::Seconds() - StartTime) * 1000 );
+
+	// Set flag to indicate that we are relying on a purge to be performed.
+	GObjPurgeIsRequired = true;
+	// Reset purged count.
+	GPurgedObjectCountSinceLastMarkPhase = 0;
+
+	// Perform a full purge by not using a time limit for the incremental purge. The Editor always does a full purge.
+	if( bPerformFullPurge || GIsEditor )
+	{
+		IncrementalPurgeGarbage( false );	
+	}
+
+	// We're done collecting garbage. Note that IncrementalPurgeGarbage above might already clear it internally.
+	GIsGarbageCollecting = false;
+
+	// Route callbacks to verify GC assumptions
+	FCoreDelegates::PostGarbageCollect.Broadcast();
+}
+
+/**
+ * Returns whether the reachability analysis has to run on the game thread instead of the GC worker threads.
+ */
+static bool ShouldForceSingleThreadedGC()
+{
+	// Fall back to single threaded GC if processor count is 1 or parallel GC is disabled
+	// or detailed per class gc stats are enabled (not thread safe)
+	// Temporarily forcing single-threaded GC in the editor until Modify() can be safely removed from HandleObjectReference.
+	return !FApp::ShouldUseThreadingForPerformance() || !FPlatformProcess::SupportsMultithreading() ||
+#if PLATFORM_SUPPORTS_MULTITHREADED_GC
+		( FPlatformMisc::NumberOfCores() < 2 || CVarAllowParallelGC->GetValueOnGameThread() == 0 || PERF_DETAILED_PER_CLASS_GC_STATS );
+#else	//PLATFORM_SUPPORTS_MULTITHREADED_GC
+		true;
+#endif	//PLATFORM_SUPPORTS_MULTITHREADED_GC
+}
+
+/** 
+ * Deletes all unreferenced objects, keeping objects that have any of the passed in KeepFlags set
+ *
+ * @param	KeepFlags			objects with those flags will be kept regardless of being referenced or not
+ * @param	bPerformFullPurge	if true, perform a full purge after the mark pass
+ */
+
+void CollectGarbage( EObjectFlags KeepFlags, bool bPerformFullPurge )
+{
 	// We can't collect garbage while there's a load in progress. E.g. one potential issue is Import.XObject
 	check( !IsLoading() );
 
-	// Route callbacks so we can ensure that we are e.g. not in the middle of loading something by flushing
-	// the async loading, etc...
-	FCoreDelegates::PreGarbageCollect.Broadcast();
+	// A pending incremental reachability analysis is replaced by the full one below.
+	if( GIncrementalReachabilityAnalysis )
+	{
+		delete GIncrementalReachabilityAnalysis;
+		GIncrementalReachabilityAnalysis = NULL;
+	}
+
+	BroadcastPreGarbageCollect();
 	
 	// Set 'I'm garbage collecting' flag - might be checked inside various functions.
 	GIsGarbageCollecting = true; 
@@ -1107,62 +1555,90 @@ void CollectGarbage( EObjectFlags KeepFlags, bool bPerformFullPurge )
 	}
 #endif
 
-	// Fall back to single threaded GC if processor count is 1 or parallel GC is disabled
-	// or detailed per class gc stats are enabled (not thread safe)
-	// Temporarily forcing single-threaded GC in the editor until Modify() can be safely removed from HandleObjectReference.
-	const bool bForceSingleThreadedGC = !FApp::ShouldUseThreadingForPerformance() || !FPlatformProcess::SupportsMultithreading() ||
-#if PLATFORM_SUPPORTS_MULTITHREADED_GC
-		( FPlatformMisc::NumberOfCores() < 2 || CVarAllowParallelGC->GetValueOnGameThread() == 0 || PERF_DETAILED_PER_CLASS_GC_STATS );
-#else	//PLATFORM_SUPPORTS_MULTITHREADED_GC
-		true;
-#endif	//PLATFORM_SUPPORTS_MULTITHREADED_GC
-
 	// Perform reachability analysis.
 	{
 		const double StartTime = FPlatformTime::Seconds();
 		FArchiveRealtimeGC TagUsedRealtimeGC;
-		TagUsedRealtimeGC.PerformReachabilityAnalysis( KeepFlags, bForceSingleThreadedGC );
+		TagUsedRealtimeGC.PerformReachabilityAnalysis( KeepFlags, ShouldForceSingleThreadedGC() );
 		UE_LOG(LogGarbage, Log, TEXT("%f ms for GC"), (FPlatformTime::Seconds() - StartTime) * 1000 );
 	}
 
-#if WITH_EDITOR
-	if ( GIsEditor && EditorPostReachabilityAnalysisCallback )
-	{
-		EditorPostReachabilityAnalysisCallback();
-	}
-#endif // WITH_EDITOR
+	BeginDestroyUnreachableObjects( bPerformFullPurge );
+}
 
-	// Unhash all unreachable objects.
+/**
+ * Performs part of a garbage collection, spreading the reachability analysis over several calls.
+ *
+ * @param	KeepFlags	objects with those flags will be kept regardless of being referenced or not, only used by the call starting a collection
+ * @param	TimeLimit	soft time limit for this function call, 0 to finish the reachability analysis
+ * @return	true if the reachability analysis has finished and the unreachable objects are being destroyed
+ */
+bool IncrementalCollectGarbage( EObjectFlags KeepFlags, float TimeLimit )
+{
 	const double StartTime = FPlatformTime::Seconds();
-	for ( FRawObjectIterator It(true); It; ++It )
+
+	if( !GIncrementalReachabilityAnalysis )
 	{
-		//@todo UE4 - A prefetch was removed here. Re-add it. It wasn't right anyway, since it was ten items ahead and the consoles on have 8 prefetch slots
+		// We can't collect garbage while there's a load in progress. E.g. one potential issue is Import.XObject
+		check( !IsLoading() );
 
-		UObject* Object = *It;
-		if( Object->HasAnyFlags( RF_Unreachable ) )
+		BroadcastPreGarbageCollect();
+
+		UE_LOG(LogGarbage, Log, TEXT("Collecting garbage incrementally") );
+
+		// RF_Unreachable can't change on any objects before the previous purge has finished.
+		if( GObjIncrementalPurgeIsInProgress || GObjPurgeIsRequired )
 		{
-			// Begin the object's asynchronous destruction.
-			Object->ConditionalBeginDestroy();
+			IncrementalPurgeGarbage( false );
 		}
+		check( !GObjIncrementalPurgeIsInProgress );
+		check( !GObjPurgeIsRequired );
+
+		GIncrementalReachabilityAnalysis = new FIncrementalReachabilityAnalysis( KeepFlags );
 	}
-	UE_LOG(LogGarbage, Log, TEXT("%f ms for unhashing unreachable objects"), (FPlatformTime::Seconds() - StartTime) * 1000 );
 
-	// Set flag to indicate that we are relying on a purge to be performed.
-	GObjPurgeIsRequired = true;
-	// Reset purged count.
-	GPurgedObjectCountSinceLastMarkPhase = 0;
+	bool bFinished = false;
+	{
+		TGuardValue<bool> GuardIsGarbageCollecting(GIsGarbageCollecting, true);
+		bFinished = GIncrementalReachabilityAnalysis->Mark( TimeLimit > 0.0f ? StartTime + TimeLimit : 0.0 );
+	}
 
-	// Perform a full purge by not using a time limit for the incremental purge. The Editor always does a full purge.
-	if( bPerformFullPurge || GIsEditor )
+	if( !bFinished )
 	{
-		IncrementalPurgeGarbage( false );	
+		GIncrementalReachabilityAnalysis->RecordSlice( FPlatformTime::Seconds() - StartTime );
+		return false;
 	}
 
-	// We're done collecting garbage. Note that IncrementalPurgeGarbage above might already clear it internally.
-	GIsGarbageCollecting = false;
+	// Objects must not be marked RF_Unreachable while they are being loaded.
+	FlushAsyncLoading();
 
-	// Route callbacks to verify GC assumptions
-	FCoreDelegates::PostGarbageCollect.Broadcast();
+	// Set 'I'm garbage collecting' flag - might be checked inside various functions.
+	GIsGarbageCollecting = true;
+
+	bool bVerify = false;
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+	bVerify = CVarVerifyIncrementalReachability->GetValueOnGameThread() != 0;
+#endif
+	GIncrementalReachabilityAnalysis->Finish( ShouldForceSingleThreadedGC(), bVerify );
+	GIncrementalReachabilityAnalysis->RecordSlice( FPlatformTime::Seconds() - StartTime );
+	GIncrementalReachabilityAnalysis->LogStats();
+
+	delete GIncrementalReachabilityAnalysis;
+	GIncrementalReachabilityAnalysis = NULL;
+
+	BeginDestroyUnreachableObjects( false );
+
+	return true;
+}
+
+/**
+ * Returns whether an incremental reachability analysis has been started and hasn't finished yet.
+ *
+ * @return	true if IncrementalCollectGarbage needs to be called again to finish the current garbage collection, false otherwise.
+ */
+bool IsIncrementalReachabilityAnalysisPending()
+{
+	return GIncrementalReachabilityAnalysis != NULL;
 }
 
 /**
@@ -484,6 +484,12 @@ ULinkerLoad::ELinkerStatus ULinkerLoad::Tick( float InTimeLimit, bool bInUseTime
 				Status = SerializePackageFileSummary();
 			}
 
+			// Propagate the package file summary to the package.
+			if( Status == LINKER_Loaded )
+			{
+				Status = PropagatePackageFileSummary();
+			}
+
 			// Serialize the name map and register the names.
 			if( Status == LINKER_Loaded )
 			{
@@ -559,6 +565,65 @@ ULinkerLoad::ELinkerStatus ULinkerLoad::Tick( float InTimeLimit, bool bInUseTime
 	return Status;
 }
 
+/**
+ * Runs only the loader creation step of Tick, without waiting for the precache request it issues.
+ *
+ * @return	LINKER_Failed if the loader couldn't be created, LINKER_Loaded or LINKER_TimedOut otherwise
+ */
+ULinkerLoad::ELinkerStatus ULinkerLoad::TickCreateLoader()
+{
+	check( !bHasFinishedInitialization );
+
+	TickStartTime		= FPlatformTime::Seconds();
+	bTimeLimitExceeded	= false;
+	bUseTimeLimit		= false;
+	TimeLimit			= 0.f;
+
+	return CreateLoader();
+}
+
+/**
+ * Runs the package file summary, name, import and export map steps of Tick without a time limit.
+ *
+ * @return	LINKER_TimedOut while waiting for I/O, LINKER_Loaded once all tables have been serialized
+ */
+ULinkerLoad::ELinkerStatus ULinkerLoad::TickSerializeTables()
+{
+	// The loader has to exist already, creating it isn't safe outside the game thread.
+	check( Loader );
+	check( !bHasFinishedInitialization );
+
+	TickStartTime		= FPlatformTime::Seconds();
+	bTimeLimitExceeded	= false;
+	bUseTimeLimit		= false;
+	TimeLimit			= 0.f;
+
+	// Only checks whether the package file summary has been precached.
+	ELinkerStatus Status = CreateLoader();
+
+	if( Status == LINKER_Loaded )
+	{
+		Status = SerializePackageFileSummary();
+	}
+
+	if( Status == LINKER_Loaded )
+	{
+		Status = SerializeNameMap();
+	}
+
+	if( Status == LINKER_Loaded )
+	{
+		Status = SerializeImportMap();
+	}
+
+	if( Status == LINKER_Loaded )
+	{
+		Status = SerializeExportMap();
+	}
+
+	return Status;
+}
+
 /**
  * Private constructor, passing arguments through from CreateLinker.
  *
@@ -965,25 +1030,6 @@ ULinkerLoad::ELinkerStatus ULinkerLoad::SerializePackageFileSummary()
 			}
 		}
 
-		UPackage* LinkerRootPackage = LinkerRoot;
-		if( LinkerRootPackage )
-		{
-			// Preserve PIE package flag
-			uint32 PIEFlag = (LinkerRootPackage->PackageFlags & PKG_PlayInEditor);
-			
-			// Propagate package flags
-			LinkerRootPackage->PackageFlags = (Summary.PackageFlags | PIEFlag);
-
-			// Propagate package folder name
-			LinkerRootPackage->SetFolderName(*Summary.FolderName);
-
-			// Propagate streaming install ChunkID
-			LinkerRootPackage->SetChunkIDs(Summary.ChunkIDs);
-			
-			// Propagate package file size
-			LinkerRootPackage->FileSize = TotalSize();
-		}
-		
 		// Propagate fact that package cannot use lazy loading to archive (aka this).
 		if( (Summary.PackageFlags & PKG_DisallowLazyLoading) )
 		{
@@ -1012,6 +1058,39 @@ ULinkerLoad::ELinkerStatus ULinkerLoad::SerializePackageFileSummary()
 	return !IsTimeLimitExceeded( TEXT("serializing package file summary") ) ? LINKER_Loaded : LINKER_TimedOut;
 }
 
+/**
+ * Propagates the package file summary to the package.
+ */
+ULinkerLoad::ELinkerStatus ULinkerLoad::PropagatePackageFileSummary()
+{
+	if( bHasPropagatedPackageFileSummary == false )
+	{
+		UPackage* LinkerRootPackage = LinkerRoot;
+		if( LinkerRootPackage )
+		{
+			// Preserve PIE package flag
+			uint32 PIEFlag = (LinkerRootPackage->PackageFlags & PKG_PlayInEditor);
+			
+			// Propagate package flags
+			LinkerRootPackage->PackageFlags = (Summary.PackageFlags | PIEFlag);
+
+			// Propagate package folder name
+			LinkerRootPackage->SetFolderName(*Summary.FolderName);
+
+			// Propagate streaming install ChunkID
+			LinkerRootPackage->SetChunkIDs(Summary.ChunkIDs);
+			
+			// Propagate package file size
+			LinkerRootPackage->FileSize = TotalSize();
+		}
+
+		// Avoid propagating it again.
+		bHasPropagatedPackageFileSummary = true;
+	}
+
+	return LINKER_Loaded;
+}
+
 /**
  * Serializes the name table.
  */
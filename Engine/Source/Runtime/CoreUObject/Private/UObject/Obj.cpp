@@ -3554,6 +3554,7 @@ void OnCultureChangedUObjectCallback();
 void StaticUObjectInit();
 void InitUObject();
 void StaticExit();
+void ShutdownAsyncLoadingThread();
 
 void PreInitUObject()
 {
@@ -3634,6 +3635,9 @@ void OnCultureChangedUObjectCallback()
 //
 void StaticExit()
 {
+	// The loading thread works on linkers that are about to be destroyed.
+	ShutdownAsyncLoadingThread();
+
 	check(GObjLoaded.Num()==0);
 	if (UObjectInitialized() == false)
 	{
@@ -145,6 +145,28 @@ struct FAsyncPackage : public FGCObject
 		return bLoadHasFinished;
 	}
 
+	/** States of the linker table serialization done by the async loading thread. */
+	enum ELoadingThreadState
+	{
+		/** The loading thread hasn't been asked to do anything. */
+		LoadingThread_None = 0,
+		/** Waiting for or being processed by the loading thread. */
+		LoadingThread_Queued,
+		/** The loading thread serialized the linker tables. */
+		LoadingThread_Finished,
+		/** The loading thread failed to serialize the linker tables. */
+		LoadingThread_Failed,
+		/** The async loading thread isn't used for this package. */
+		LoadingThread_NotUsed
+	};
+
+	/**
+	 * Serializes the package file summary, name, import and export maps. Called on the async loading thread.
+	 *
+	 * @return true if done, false if the linker is still waiting for I/O
+	 */
+	bool SerializeLinkerTablesOnLoadingThread();
+
 private:
 	/** Name of the UPackage to create.																	*/
 	FString						PackageName;
@@ -194,6 +216,8 @@ private:
 	double						LoadStartTime;
 	/** Estimated load percentage.																		*/
 	float						LoadPercentage;
+	/** ELoadingThreadState, written by the async loading thread.										*/
+	FThreadSafeCounter			LoadingThreadState;
 	
 #if WITH_EDITOR
 	/** Editor only: PIE instance ID this package belongs to, INDEX_NONE otherwise */
@@ -283,6 +307,12 @@ private:
 	 * @return true if linker is finished being created, false otherwise
 	 */
 	EAsyncPackageState::Type FinishLinker();
+	/**
+	 * Hands the linker tables to the async loading thread if it's enabled and waits for it to finish them.
+	 *
+	 * @return true if the game thread can tick the linker, false if the loading thread is still busy or failed
+	 */
+	bool WaitForLoadingThread();
 	/** 
 	 * Loads imported packages..
 	 *
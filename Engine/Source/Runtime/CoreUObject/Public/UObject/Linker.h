@@ -1220,6 +1220,8 @@ private:
 
 	/** Whether we already serialized the package file summary.																*/
 	bool					bHasSerializedPackageFileSummary;
+	/** Whether we already propagated the package file summary to the package.												*/
+	bool					bHasPropagatedPackageFileSummary;
 	/** Whether we already fixed up import map.																				*/
 	bool					bHasFixedUpImportMap;
 	/** Whether we already matched up existing exports.																		*/
@@ -1609,6 +1611,23 @@ private:
 	 */
 	ELinkerStatus Tick( float InTimeLimit, bool bInUseTimeLimit );
 
+	/**
+	 * Runs only the loader creation step of Tick, without waiting for the precache request it issues.
+	 * Creating the loader looks up other linkers so this has to be called on the game thread.
+	 *
+	 * @return	LINKER_Failed if the loader couldn't be created, LINKER_Loaded or LINKER_TimedOut otherwise
+	 */
+	ELinkerStatus TickCreateLoader();
+
+	/**
+	 * Runs the package file summary, name, import and export map steps of Tick without a time limit.
+	 * Once TickCreateLoader has succeeded these only touch this linker and its loader, so the async
+	 * loading thread may call this as long as nothing else ticks the linker at the same time.
+	 *
+	 * @return	LINKER_TimedOut while waiting for I/O, LINKER_Loaded once all tables have been serialized
+	 */
+	ELinkerStatus TickSerializeTables();
+
 	/**
 	 * Private constructor, passing arguments through from CreateLinker.
 	 *
@@ -1638,6 +1657,12 @@ private:
 	 */
 	ELinkerStatus SerializePackageFileSummary();
 
+	/**
+	 * Propagates the package flags, folder name, chunk IDs and file size from the package file summary to the package.
+	 * This touches the package so it is done by Tick on the game thread rather than by TickSerializeTables.
+	 */
+	ELinkerStatus PropagatePackageFileSummary();
+
 	/**
 	 * Serializes the name map.
 	 */
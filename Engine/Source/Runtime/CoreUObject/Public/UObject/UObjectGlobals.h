@@ -315,6 +315,57 @@ COREUOBJECT_API bool IsIncrementalPurgePending();
  */
 COREUOBJECT_API void IncrementalPurgeGarbage( bool bUseTimeLimit, float TimeLimit = 0.002 );
 
+/**
+ * Performs part of a garbage collection, spreading the reachability analysis over several calls. The first call
+ * starts a collection and every call marks reachable objects for up to TimeLimit. The call that finishes the
+ * analysis begins the destruction of all unreachable objects like CollectGarbage( KeepFlags, false ) does, and
+ * IncrementalPurgeGarbage has to be called afterwards.
+ *
+ * The object graph may change between the calls. Objects created in the meantime are kept, and so are objects
+ * assigned through UObjectProperty, which includes Blueprint code. Native code that stores a reference into an
+ * existing object while the analysis is pending has to call IncrementalReachabilityWriteBarrier, otherwise the
+ * referenced object may be collected if that was its last path from the root set. The call that finishes the analysis
+ * only processes the root set, kept objects and objects created in the meantime again, on the GC worker threads.
+ * Objects that became unreachable in the meantime may survive until the next collection. CollectGarbage drops a
+ * pending analysis.
+ *
+ * @param	KeepFlags	objects with those flags will be kept regardless of being referenced or not, only used by the call starting a collection
+ * @param	TimeLimit	soft time limit for this function call, 0 to finish the reachability analysis
+ * @return	true if the reachability analysis has finished and the unreachable objects are being destroyed
+ */
+COREUOBJECT_API bool IncrementalCollectGarbage( EObjectFlags KeepFlags, float TimeLimit = 0.002 );
+
+/**
+ * Returns whether an incremental reachability analysis has been started and hasn't finished yet.
+ *
+ * @return	true if IncrementalCollectGarbage needs to be called again to finish the current garbage collection, false otherwise.
+ */
+COREUOBJECT_API bool IsIncrementalReachabilityAnalysisPending();
+
+/** Whether an incremental reachability analysis is pending, only exposed for IncrementalReachabilityWriteBarrier. */
+extern COREUOBJECT_API bool GIsIncrementalReachabilityPending;
+
+/**
+ * Keeps an object alive during an incremental reachability analysis, called by IncrementalReachabilityWriteBarrier.
+ *
+ * @param	Object	object a reference has been stored to
+ */
+COREUOBJECT_API void MarkObjectReachableIncrementally( UObject* Object );
+
+/**
+ * Write barrier for incremental garbage collection, call it after storing a reference to an object into another
+ * object. Costs a single branch unless IncrementalCollectGarbage has started a collection that hasn't finished yet.
+ *
+ * @param	Object	object a reference has been stored to
+ */
+FORCEINLINE void IncrementalReachabilityWriteBarrier( UObject* Object )
+{
+	if( GIsIncrementalReachabilityPending && Object )
+	{
+		MarkObjectReachableIncrementally( Object );
+	}
+}
+
 /**
  * Create a unique name by combining a base name and an arbitrary number string.
  * The object name returned is guaranteed not to exist.
@@ -1773,6 +1773,7 @@ class COREUOBJECT_API UObjectProperty : public TUObjectPropertyBase<UObject*>
 	virtual void SetObjectPropertyValue(void* PropertyValueAddress, UObject* Value) const OVERRIDE
 	{
 		SetPropertyValue(PropertyValueAddress, Value);
+		IncrementalReachabilityWriteBarrier(Value);
 	}
 	// End of UObjectPropertyBase interface
 };
@@ -137,9 +137,27 @@ protected:
 	/** next ID for running query */
 	int32 NextQueryID;
 
+	/** number of queries finished since StatsStartTime */
+	int32 NumFinishedQueries;
+
+	/** sum of frames the queries finished since StatsStartTime were running for */
+	uint64 FinishedQueriesLatency;
+
+	/** start of the period queries per second and latency stats are measured over */
+	double StatsStartTime;
+
 	/** create new instance, using cached data is possible */
 	TSharedPtr<struct FEnvQueryInstance> CreateQueryInstance(class UEnvQuery* Template, EEnvQueryRunMode::Type RunMode);
 
+	/** runs current test of every query that is running a thread safe test on NumTasks task graph tasks, returns number of queries run */
+	int32 ExecuteThreadSafeTests(int32 NumTasks, double TimeLimit);
+
+	/** notify observers and remove queries that are no longer processing */
+	void RemoveFinishedQueries();
+
+	/** notify observer and update stats of a query that is no longer processing */
+	void OnQueryFinished(TSharedPtr<struct FEnvQueryInstance>& QueryInstance);
+
 private:
 
 	/** create and bind delegates in instance */
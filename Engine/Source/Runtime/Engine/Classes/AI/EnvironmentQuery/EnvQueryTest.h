@@ -46,6 +46,10 @@ class ENGINE_API UEnvQueryTest : public UObject
 	UPROPERTY()
 	uint32 bWorkOnFloatValues : 1;
 
+	/** When set, test only reads item data, contexts listed by GetUsedContexts and named params of its query,
+	 *  and can run on a worker thread while other queries are running their tests (see ai.EnvQueryTasks) */
+	uint32 bThreadSafe : 1;
+
 	FExecuteTestSignature ExecuteDelegate;
 
 	/** check if test supports item type */
@@ -66,6 +70,9 @@ class ENGINE_API UEnvQueryTest : public UObject
 	/** normalize scores in range */
 	void NormalizeItemScores(struct FEnvQueryInstance& QueryInstance);
 
+	/** gather contexts read by test, thread safe tests get them cached on game thread before running on a worker thread */
+	virtual void GetUsedContexts(TArray<UClass*>& Contexts) const;
+
 	/** get description of test */
 	virtual FString GetDescriptionTitle() const;
 	virtual FString GetDescriptionDetails() const;
@@ -17,6 +17,10 @@ DECLARE_CYCLE_STAT_EXTERN(TEXT("Test Time"),STAT_AI_EnvQuery_TestTime,STATGROUP_
 DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Num Instances"),STAT_AI_EnvQuery_NumInstances,STATGROUP_AIEnvQuery, );
 DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Num Items"),STAT_AI_EnvQuery_NumItems,STATGROUP_AIEnvQuery, );
 DECLARE_MEMORY_STAT_EXTERN(TEXT("Instance memory"),STAT_AI_EnvQuery_InstanceMemory,STATGROUP_AIEnvQuery, ENGINE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Threaded Test Time"),STAT_AI_EnvQuery_ThreadedTestTime,STATGROUP_AIEnvQuery, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Num Threaded Test Steps"),STAT_AI_EnvQuery_NumThreadedSteps,STATGROUP_AIEnvQuery, );
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Queries Completed Per Second"),STAT_AI_EnvQuery_QueriesPerSecond,STATGROUP_AIEnvQuery, );
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Average Latency (frames)"),STAT_AI_EnvQuery_AverageLatency,STATGROUP_AIEnvQuery, );
 
 UENUM()
 namespace EEnvTestCondition
@@ -384,6 +388,9 @@ struct ENGINE_API FEnvQueryInstance : public FEnvQueryResult
 	/** set when testing final condition of an option */
 	uint8 bPassOnSingleResult : 1;
 
+	/** set while current test runs on a worker thread, contexts can only be read from cache then */
+	uint8 bContextCacheReadOnly : 1;
+
 #if WITH_EDITOR
 	/** set to true to store additional debug info */
 	uint8 bStoreDebugInfo : 1;
@@ -401,7 +408,10 @@ struct ENGINE_API FEnvQueryInstance : public FEnvQueryResult
 	/** if > 0 then it's how much time query has for performing current step */
 	double TimeLimit;
 
-	FEnvQueryInstance() : World(NULL), CurrentTest(-1), NumValidItems(0), bFoundSingleResult(false)
+	/** frame the query was started in */
+	uint64 StartFrame;
+
+	FEnvQueryInstance() : World(NULL), CurrentTest(-1), NumValidItems(0), bFoundSingleResult(false), bContextCacheReadOnly(false), StartFrame(0)
 #if WITH_EDITOR
 		, bStoreDebugInfo(bDebuggingInfoEnabled) 
 #endif // WITH_EDITOR
@@ -412,6 +422,19 @@ struct ENGINE_API FEnvQueryInstance : public FEnvQueryResult
 	/** execute single step of query */
 	void ExecuteOneStep(double TimeLimit);
 
+	/** check if current step is a test that can run on a worker thread, see UEnvQueryTest::bThreadSafe */
+	bool IsCurrentTestThreadSafe() const;
+
+	/** run current test on remaining items without finishing the step, returns true when all items are processed
+	 *  can be called from worker thread if IsCurrentTestThreadSafe, for different instances at the same time */
+	bool ExecuteCurrentTest(double TimeLimit);
+
+	/** finalize current step and move to next test, option or result, on game thread only */
+	void FinishCurrentStep(bool bStepDone);
+
+	/** cache all contexts used by current test, on game thread only before running it on a worker thread */
+	void CacheCurrentTestContexts();
+
 	/** update context cache */
 	bool PrepareContext(UClass* Context, FEnvQueryContextData& ContextData);
 
@@ -487,6 +510,9 @@ protected:
 	/** discard all items but one */
 	void PickSingleItem(int32 ItemIndex);
 
+	/** get context data from its provider and add it to cache, on game thread only */
+	void CacheContext(UClass* ContextClass, FEnvQueryContextData& ContextData);
+
 public:
 
 	/** removes all runtime data that can be used for debugging (not a part of actual query result) */
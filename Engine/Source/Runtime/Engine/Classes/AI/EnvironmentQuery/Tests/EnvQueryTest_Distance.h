@@ -29,6 +29,7 @@ class UEnvQueryTest_Distance : public UEnvQueryTest
 
 	void RunTest(struct FEnvQueryInstance& QueryInstance);
 
+	virtual void GetUsedContexts(TArray<UClass*>& Contexts) const OVERRIDE;
 	virtual FString GetDescriptionTitle() const OVERRIDE;
 	virtual FString GetDescriptionDetails() const OVERRIDE;
 };
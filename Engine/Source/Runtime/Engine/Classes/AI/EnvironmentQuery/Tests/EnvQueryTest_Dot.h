@@ -52,6 +52,7 @@ class UEnvQueryTest_Dot : public UEnvQueryTest
 
 	void RunTest(struct FEnvQueryInstance& QueryInstance);
 
+	virtual void GetUsedContexts(TArray<UClass*>& Contexts) const OVERRIDE;
 	virtual FString GetDescriptionTitle() const OVERRIDE;
 	virtual FString GetDescriptionDetails() const OVERRIDE;
 
@@ -60,6 +60,26 @@ struct FVelocityAvoidanceCone
 	FPlane ConePlane[2];			//Left and right cone planes - these should point in toward each other. Technically, this is a convex hull, it's just unbounded.
 };
 
+/** Avoidance velocity found for an agent by UAvoidanceManager::UpdateBatchedAvoidance */
+struct FNavAvoidanceBatchResult
+{
+	/** Velocity to use instead of the agent's own */
+	FVector Velocity;
+
+	/** Frame the velocity was found in, it's only used in that frame */
+	uint64 FrameNumber;
+
+	/** False if the agent's velocity was unobstructed */
+	bool bDiverted;
+
+	FNavAvoidanceBatchResult()
+		: Velocity(FVector::ZeroVector)
+		, FrameNumber(MAX_uint64)
+		, bDiverted(false)
+	{
+	}
+};
+
 UCLASS(config=Engine, Blueprintable)
 class ENGINE_API UAvoidanceManager : public UObject, public FSelfRegisteringExec
 {
@@ -125,6 +145,19 @@ class ENGINE_API UAvoidanceManager : public UObject, public FSelfRegisteringExec
 	/** For Duration seconds, set this object to ignore all others. */
 	void OverrideToMaxWeight(int32 AvoidanceUID, float Duration);
 
+	/**
+	 * Finds avoidance velocities for all registered movement components at once, spread over ai.AvoidanceBatchTasks tasks.
+	 * Called by the world at the start of the frame, does nothing unless batching is enabled.
+	 */
+	void UpdateBatchedAvoidance();
+
+	/**
+	 * Returns the velocity UpdateBatchedAvoidance found for AvoidanceUID this frame.
+	 * @param CurrentVelocity	Velocity the agent wants to move with, returned as is if the batched velocity wasn't diverted
+	 * @return false if there's no batched velocity for this frame, the agent has to query GetAvoidanceVelocityIgnoringUID itself
+	 */
+	bool GetBatchedAvoidanceVelocity(int32 AvoidanceUID, const FVector& CurrentVelocity, FVector& OutVelocity) const;
+
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 	bool IsDebugOnForUID(int32 AvoidanceUID);
 	bool IsDebugOnForAll();
@@ -156,9 +189,41 @@ private:
 	/** This is called by our blueprint-accessible functions, and permits the user to ignore self, or not. Important in case the user isn't in the avoidance manager. */
 	FVector GetAvoidanceVelocity_Internal(const FNavAvoidanceData& AvoidanceData, float DeltaTime, int32 *IgnoreThisUID = NULL);
 
+	/** GetAvoidanceVelocity_Internal building its cones in Cones, so several threads can search at once if debug drawing is off. */
+	FVector GetAvoidanceVelocity_Internal(const FNavAvoidanceData& AvoidanceData, float DeltaTime, int32 *IgnoreThisUID, TArray<FVelocityAvoidanceCone>& Cones);
+
+	/** Grid cell containing Location */
+	FIntPoint GetGridCell(const FVector& Location) const;
+
+	/** Moves AvoidanceUID to the grid cell of Center, adding it to the grid if it isn't in yet */
+	void UpdateGridCell(int32 AvoidanceUID, const FVector& Center);
+
+	/** Takes AvoidanceUID out of the grid, expired objects aren't kept in it */
+	void RemoveFromGrid(int32 AvoidanceUID);
+
+	/** Rebuilds the grid if TestRadius2D changed since it was built */
+	void RebuildGridIfNeeded();
+
 	/** All objects currently part of the avoidance solution. This is pretty transient stuff. */
 	TMap<int32, FNavAvoidanceData> AvoidanceObjects;
 
+	/** UIDs of the objects that haven't expired, by the 2D grid cell of their center. Queries only visit the cells within TestRadius2D. */
+	TMap<FIntPoint, TArray<int32> > AvoidanceGrid;
+
+	/** Grid cell of every UID in AvoidanceGrid */
+	TMap<int32, FIntPoint> AvoidanceGridCells;
+
+	/** Size of the grid cells, follows TestRadius2D */
+	float AvoidanceGridCellSize;
+
+	/** Movement components registered with RegisterMovementComponent, for UpdateBatchedAvoidance */
+	TArray<TWeakObjectPtr<class UCharacterMovementComponent> > RegisteredMovementComponents;
+
+	/** Velocities found by UpdateBatchedAvoidance, by UID */
+	TArray<FNavAvoidanceBatchResult> BatchResults;
+
+	friend struct FParallelAvoidanceBatch;
+
 	/** This is a pool of keys to be used when new objects are created. */
 	TArray<int32> NewKeyPool;
 
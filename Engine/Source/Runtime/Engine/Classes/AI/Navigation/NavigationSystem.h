@@ -469,6 +469,20 @@ protected:
 	static uint32 LastPathFindingUniqueID;
 };
 
+/** Async pathfinding queries of one frame, processed by several worker tasks at once */
+struct FAsyncPathFindingBatch
+{
+	TArray<FAsyncPathFindingQuery> Queries;
+
+	/** Index of the next query a worker picks up */
+	FThreadSafeCounter NextQueryIndex;
+
+	FAsyncPathFindingBatch(const TArray<FAsyncPathFindingQuery>& InQueries)
+		: Queries(InQueries)
+	{
+	}
+};
+
 struct FNavigationSystemExec: public FSelfRegisteringExec
 {
 	FNavigationSystemExec(class UNavigationSystem* InOwner)
@@ -996,12 +1010,20 @@ private:
 	/** Adds given request to requests queue. Note it's to be called only on game thread only */
 	void AddAsyncQuery(const FAsyncPathFindingQuery& Query);
 		 
-	/** spawns a non-game-thread task to process requests given in PathFindingQueries.
-	 *	In the process PathFindingQueries gets copied. */
+	/** spawns non-game-thread tasks to process requests given in PathFindingQueries, and a single game thread
+	 *	task calling all their delegates once they're done. In the process PathFindingQueries gets copied. */
 	void TriggerAsyncQueries(TArray<FAsyncPathFindingQuery>& PathFindingQueries);
 
-	/** Processes pathfinding requests given in PathFindingQueries.*/
-	void PerformAsyncQueries(TArray<FAsyncPathFindingQuery> PathFindingQueries);
+	/** Processes pathfinding requests of Batch until none are left, several tasks run this at once */
+	void PerformAsyncQueries(FAsyncPathFindingBatch* Batch);
+
+public:
+	/** Spawns NumWorkers non-game-thread tasks processing the requests of Batch.
+	 *	@return completion events of the tasks, Batch has to stay around until they're done */
+	FGraphEventArray DispatchAsyncQueryWorkers(FAsyncPathFindingBatch* Batch, int32 NumWorkers);
+
+	/** Number of worker tasks a batch of NumQueries async pathfinding requests is spread over */
+	static int32 GetNumAsyncQueryWorkers(int32 NumQueries);
 };
 
 struct FNavigationTypeCreator
@@ -0,0 +1,26 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "HierarchicalInstancedStaticMeshComponent.generated.h"
+
+/**
+ * An instanced static mesh that is culled and LODed per cluster of instances instead of as a whole.
+ * A cluster tree is built over the instances whenever the render state is created, every view then draws only the
+ * clusters it can see, each at its own LOD.
+ */
+UCLASS(HeaderGroup=Component, ClassGroup=Rendering, meta=(BlueprintSpawnableComponent), MinimalAPI)
+class UHierarchicalInstancedStaticMeshComponent : public UInstancedStaticMeshComponent
+{
+	GENERATED_UCLASS_BODY()
+
+	/** Maximum number of instances in a leaf cluster. Smaller clusters cull more precisely but take more draw calls. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Culling, meta=(ClampMin=1))
+	int32 MaxInstancesPerLeaf;
+
+	// Begin UPrimitiveComponent Interface
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() OVERRIDE;
+	// End UPrimitiveComponent Interface
+
+	/** Builds a cluster tree over the bounds of the instances, in component space. */
+	ENGINE_API void BuildClusterTree(class FInstanceClusterTree& OutClusterTree) const;
+};
@@ -154,6 +154,13 @@ public:
 	/** If false, this tick will run on the game thread, otherwise it will run on any thread in parallel with the game thread and in parallel with other "async ticks" **/
 	uint32 bRunOnAnyThread:1;
 
+	/** 
+	 * Seconds between ticks of this function, it ticks every frame if this is 0 or less. DeltaTime is the time since the last tick. 
+	 * CAUTION: Do not set this directly while the tick function is registered, call SetTickInterval instead.
+	 **/
+	UPROPERTY()
+	float TickInterval;
+
 private:
 	/** If true, means that this tick function is in the master array of tick functions **/
 	uint32 bRegistered:1;
@@ -170,6 +177,24 @@ private:
 	/** Internal data to track if we have finshed visiting this tick function yet this frame **/
 	int32 TickQueuedGFrameCounter;
 
+	/** If true, this tick function is in the cooldown list of its level and only ticks when it is due **/
+	uint32 bTickOnInterval:1;
+
+	/** Index of this tick function in the cooldown heap of its level, only used if bTickOnInterval is true **/
+	int32 CoolingDownIndex;
+
+	/** Internal data to track the frame this tick function is due to tick on, only used if bTickOnInterval is true **/
+	int32 TickDueGFrameCounter;
+
+	/** Level time this tick function is next due at, only used if bTickOnInterval is true **/
+	double NextTickTime;
+
+	/** Level time this tick function last ticked at, only used if bTickOnInterval is true **/
+	double LastTickTime;
+
+	/** Time accumulated since the last tick, passed as DeltaTime when the tick function is due **/
+	float IntervalDeltaSeconds;
+
 protected:
 	/** Internal data that indicates the tick group we actually executed in (it may have been delayed due to prerequisites) **/
 	TEnumAsByte<enum ETickingGroup> ActualTickGroup;
@@ -210,6 +235,9 @@ public:
 	/** Returns whether the tick function is currently enabled */
 	bool IsTickFunctionEnabled() const { return bTickEnabled; }
 
+	/** Sets the seconds between ticks of this tick function, 0 or less ticks it every frame. **/
+	void SetTickInterval(float InTickInterval);
+
 	/**
 	* Gets the current completion handle of this tick function, so it can be delayed until a later point when some additional
 	* tasks have been completed.  Only valid after TG_PreAsyncWork has started and then only until the TickFunction itself has
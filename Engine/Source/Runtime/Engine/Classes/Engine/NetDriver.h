@@ -408,6 +408,26 @@ public:
 	 */
 	ENGINE_API virtual int32 ServerReplicateActors(float DeltaSeconds);
 
+	/**
+	 * Relevancy and priority stage of ServerReplicateActors for one connection: builds its list of relevant actors sorted by priority.
+	 * Only reads actor and connection state so connections can be prioritized in parallel, anything that has to change is left in
+	 * Prioritization for the game thread.
+	 *
+	 * @param Prioritization	Connection and viewers to prioritize for, receives the sorted actors
+	 * @param ConsiderList		Actors considered for replication this frame
+	 * @param ConsiderListSize	Number of actors in ConsiderList
+	 * @param bDormancyEnabled	Whether net.DormancyEnable is set
+	 * @param bValidateDormancy	Whether dormant actors should be validated against their replicators, only allowed on the game thread
+	 */
+	void ServerReplicateActors_PrioritizeActors(struct FConnectionPrioritization& Prioritization, class AActor** ConsiderList, int32 ConsiderListSize, bool bDormancyEnabled, bool bValidateDormancy);
+
+	/**
+	 * Runs ServerReplicateActors_PrioritizeActors for each connection in Prioritizations that has one.
+	 *
+	 * @param NumTasks	Number of task graph tasks to spread the connections over, connections are prioritized on the game thread if this is 1 or less
+	 */
+	void ServerReplicateActors_PrioritizeConnections(TArray<struct FConnectionPrioritization>& Prioritizations, class AActor** ConsiderList, int32 ConsiderListSize, int32 NumTasks);
+
 	/**
 	 * Process a remote function call on some actor destined for a remote location
 	 *
@@ -1731,6 +1731,13 @@ public:
 	 */
 	void PerformGarbageCollection();
 
+	/**
+	 *  Performs part of a garbage collection, cleaning up like PerformGarbageCollection once it has finished
+	 *
+	 *  @param MarkTimeLimit	Seconds the reachability analysis may take this frame, 0 to collect garbage in one go
+	 */
+	void PerformIncrementalGarbageCollection( float MarkTimeLimit );
+
 	/**
 	 *  Requests a one frame delay of Garbage Collection
 	 */
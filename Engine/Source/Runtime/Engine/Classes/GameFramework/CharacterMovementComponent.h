@@ -1201,6 +1201,9 @@ public:
 	/** allows modifing avoidance velocity, called when bUseRVOPostProcess is set */
 	virtual void PostProcessAvoidanceVelocity(FVector& NewVelocity);
 
+	/** fills the data CalcAvoidanceVelocity would query avoidance with right now, returns false if it wouldn't query */
+	bool GetAvoidanceQueryData(class UAvoidanceManager* Avoidance, struct FNavAvoidanceData& OutData) const;
+
 protected:
 
 	/** called in Tick to update data in RVO avoidance manager */
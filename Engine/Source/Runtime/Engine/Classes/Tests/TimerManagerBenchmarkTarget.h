@@ -0,0 +1,23 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "TimerManagerBenchmarkTarget.generated.h"
+
+/** Object the timers of the timer manager benchmark are bound to, counts how often each of its timers fired. */
+UCLASS(transient)
+class UTimerManagerBenchmarkTarget : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	/** Number of timers bound to each object, one per method as timers with the same object and method are the same timer. */
+	enum { NumTimers = 4 };
+
+	/** How often each of the object's timers fired. */
+	int32 NumFired[NumTimers];
+
+	void OnTimer0() { NumFired[0]++; }
+	void OnTimer1() { NumFired[1]++; }
+	void OnTimer2() { NumFired[2]++; }
+	void OnTimer3() { NumFired[3]++; }
+};
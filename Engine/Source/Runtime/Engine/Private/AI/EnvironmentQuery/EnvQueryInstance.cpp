@@ -32,14 +32,16 @@ bool FEnvQueryInstance::PrepareContext(UClass* ContextClass, FEnvQueryContextDat
 		FEnvQueryContextData* CachedData = ContextCache.Find(ContextClass);
 		if (CachedData == NULL)
 		{
-			UEnvQueryContext* ContextOb = ContextClass->GetDefaultObject<UEnvQueryContext>();
-			ContextOb->ProvideDelegate.ExecuteIfBound(*this, ContextData);
-
-			DEC_MEMORY_STAT_BY(STAT_AI_EnvQuery_InstanceMemory, GetContextAllocatedSize());
-
-			ContextCache.Add(ContextClass, ContextData);
+			if (bContextCacheReadOnly)
+			{
+				// context providers can't run on worker threads, test should list this context in GetUsedContexts
+				checkf(0, TEXT("Query [%s] is running thread safe test [%s] with context [%s] that wasn't cached on game thread"),
+					*QueryName, *UEnvQueryTypes::GetShortTypeName(Options[OptionIndex].TestDelegates[CurrentTest].GetUObject()),
+					*UEnvQueryTypes::GetShortTypeName(ContextClass));
+				return false;
+			}
 
-			INC_MEMORY_STAT_BY(STAT_AI_EnvQuery_InstanceMemory, GetContextAllocatedSize());
+			CacheContext(ContextClass, ContextData);
 		}
 		else
 		{
@@ -60,6 +62,42 @@ bool FEnvQueryInstance::PrepareContext(UClass* ContextClass, FEnvQueryContextDat
 	return true;
 }
 
+void FEnvQueryInstance::CacheContext(UClass* ContextClass, FEnvQueryContextData& ContextData)
+{
+	UEnvQueryContext* ContextOb = ContextClass->GetDefaultObject<UEnvQueryContext>();
+	ContextOb->ProvideDelegate.ExecuteIfBound(*this, ContextData);
+
+	DEC_MEMORY_STAT_BY(STAT_AI_EnvQuery_InstanceMemory, GetContextAllocatedSize());
+
+	ContextCache.Add(ContextClass, ContextData);
+
+	INC_MEMORY_STAT_BY(STAT_AI_EnvQuery_InstanceMemory, GetContextAllocatedSize());
+}
+
+void FEnvQueryInstance::CacheCurrentTestContexts()
+{
+	check(IsInGameThread());
+
+	const UEnvQueryTest* TestOb = (const UEnvQueryTest*)(Options[OptionIndex].TestDelegates[CurrentTest].GetUObject());
+	if (TestOb == NULL)
+	{
+		return;
+	}
+
+	TArray<UClass*> Contexts;
+	TestOb->GetUsedContexts(Contexts);
+
+	for (int32 i = 0; i < Contexts.Num(); i++)
+	{
+		UClass* ContextClass = Contexts[i];
+		if (ContextClass && ContextClass != UEnvQueryContext_Item::StaticClass() && !ContextCache.Contains(ContextClass))
+		{
+			FEnvQueryContextData ContextData;
+			CacheContext(ContextClass, ContextData);
+		}
+	}
+}
+
 bool FEnvQueryInstance::PrepareContext(UClass* Context, TArray<FEnvQuerySpatialData>& Data)
 {
 	if (Context == NULL)
@@ -182,10 +220,11 @@ void FEnvQueryInstance::ExecuteOneStep(double InTimeLimit)
 	CONDITIONAL_SCOPE_CYCLE_COUNTER(STAT_AI_EnvQuery_TestTime, CurrentTest >= 0);
 
 	bool bStepDone = true;
-	TimeLimit = InTimeLimit;
 
 	if (CurrentTest < 0)
 	{
+		TimeLimit = InTimeLimit;
+
 		DEC_DWORD_STAT_BY(STAT_AI_EnvQuery_NumItems, Items.Num());
 
 		RawData.Reset();
@@ -198,20 +237,46 @@ void FEnvQueryInstance::ExecuteOneStep(double InTimeLimit)
 	}
 	else
 	{
-		const int32 ItemsAlreadyProcessed = CurrentTestStartingItem;
-		OptionItem.TestDelegates[CurrentTest].Execute(*this);
-		bStepDone = CurrentTestStartingItem >= Items.Num() || bFoundSingleResult
-			// or no items processed ==> this means error
-			|| (ItemsAlreadyProcessed == CurrentTestStartingItem);
+		bStepDone = ExecuteCurrentTest(InTimeLimit);
+	}
 
-		if (bStepDone)
-		{
-			FinalizeTest();
-		}
+	FinishCurrentStep(bStepDone);
+}
+
+bool FEnvQueryInstance::IsCurrentTestThreadSafe() const
+{
+	if (CurrentTest < 0 || Status != EEnvQueryStatus::Processing)
+	{
+		return false;
 	}
-	
+
+	const UEnvQueryTest* TestOb = (const UEnvQueryTest*)(Options[OptionIndex].TestDelegates[CurrentTest].GetUObject());
+	return TestOb && TestOb->bThreadSafe;
+}
+
+bool FEnvQueryInstance::ExecuteCurrentTest(double InTimeLimit)
+{
+	TimeLimit = InTimeLimit;
+
+	const int32 ItemsAlreadyProcessed = CurrentTestStartingItem;
+	Options[OptionIndex].TestDelegates[CurrentTest].Execute(*this);
+
+	return CurrentTestStartingItem >= Items.Num() || bFoundSingleResult
+		// or no items processed ==> this means error
+		|| (ItemsAlreadyProcessed == CurrentTestStartingItem);
+}
+
+void FEnvQueryInstance::FinishCurrentStep(bool bStepDone)
+{
+	FEnvQueryOptionInstance& OptionItem = Options[OptionIndex];
+
 	if (bStepDone)
 	{
+		if (CurrentTest >= 0)
+		{
+			FinalizeTest();
+		}
+
 #if WITH_EDITOR
 		if (bStoreDebugInfo)
 		{
@@ -15,6 +15,18 @@ DEFINE_STAT(STAT_AI_EnvQuery_TestTime);
 DEFINE_STAT(STAT_AI_EnvQuery_NumInstances);
 DEFINE_STAT(STAT_AI_EnvQuery_NumItems);
 DEFINE_STAT(STAT_AI_EnvQuery_InstanceMemory);
+DEFINE_STAT(STAT_AI_EnvQuery_ThreadedTestTime);
+DEFINE_STAT(STAT_AI_EnvQuery_NumThreadedSteps);
+DEFINE_STAT(STAT_AI_EnvQuery_QueriesPerSecond);
+DEFINE_STAT(STAT_AI_EnvQuery_AverageLatency);
+
+static TAutoConsoleVariable<int32> CVarEnvQueryTasks(
+	TEXT("ai.EnvQueryTasks"),
+	0,
+	TEXT("Number of task graph tasks running the current test of queries at once, when that test is thread safe (UEnvQueryTest::bThreadSafe).\n")
+	TEXT("0 runs all tests on the game thread."),
+	ECVF_Default
+	);
 
 //////////////////////////////////////////////////////////////////////////
 // FEnvQueryRequest
@@ -75,6 +87,9 @@ UEnvQueryManager::UEnvQueryManager(const class FPostConstructInitializePropertie
 	}
 
 	NextQueryID = 0;
+	NumFinishedQueries = 0;
+	FinishedQueriesLatency = 0;
+	StatsStartTime = 0.0;
 }
 
 void UEnvQueryManager::FinishDestroy()
@@ -177,6 +192,7 @@ TSharedPtr<struct FEnvQueryInstance> UEnvQueryManager::PrepareQueryInstance(cons
 	INC_MEMORY_STAT_BY(STAT_AI_EnvQuery_InstanceMemory, QueryInstance->NamedParams.GetAllocatedSize());
 
 	QueryInstance->QueryID = NextQueryID++;
+	QueryInstance->StartFrame = GFrameCounter;
 
 	return QueryInstance;
 }
@@ -200,15 +216,52 @@ bool UEnvQueryManager::AbortQuery(int32 RequestID)
 	return false;
 }
 
+/** Runs current tests of queries until all are done, several of these run at once on task graph workers */
+struct FParallelEnvQueryTests
+{
+	TArray<FEnvQueryInstance*>	Queries;
+	/** result of ExecuteCurrentTest for every query, false for queries that didn't run before the deadline */
+	TArray<bool>				StepsDone;
+	/** time all queries must be done by, each one only gets what is left of it */
+	double						Deadline;
+	FThreadSafeCounter			NextIndex;
+
+	void Run()
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AI_EnvQuery_ThreadedTestTime);
+
+		for (int32 Index = NextIndex.Increment() - 1; Index < Queries.Num(); Index = NextIndex.Increment() - 1)
+		{
+			// a time limit of 0 or less would mean no limit at all
+			const double TimeLeft = Deadline - FPlatformTime::Seconds();
+			if (TimeLeft <= 0.0)
+			{
+				break;
+			}
+			StepsDone[Index] = Queries[Index]->ExecuteCurrentTest(TimeLeft);
+		}
+	}
+};
+
 void UEnvQueryManager::Tick(float DeltaTime)
 {
 	SCOPE_CYCLE_COUNTER(STAT_AI_EnvQuery_Tick);
 	SET_DWORD_STAT(STAT_AI_EnvQuery_NumInstances, RunningQueries.Num());
-	// @TODO: threads?
 
 	const double StartTime = FPlatformTime::Seconds();
 	const double MaxAllowedSeconds = 0.010;
 	double TimeLeft = MaxAllowedSeconds;
+
+	// thread safe tests of all queries first, the game thread gets what's left of the time budget
+	const int32 NumTasks = CVarEnvQueryTasks.GetValueOnGameThread();
+	if (NumTasks > 0)
+	{
+		while (TimeLeft > 0.0 && ExecuteThreadSafeTests(NumTasks, TimeLeft) > 0)
+		{
+			RemoveFinishedQueries();
+			TimeLeft = MaxAllowedSeconds - (FPlatformTime::Seconds() - StartTime);
+		}
+	}
 		
 	while (TimeLeft > 0.0 && RunningQueries.Num() > 0)
 	{
@@ -219,11 +272,7 @@ void UEnvQueryManager::Tick(float DeltaTime)
 			
 			if (QueryInstance->Status != EEnvQueryStatus::Processing)
 			{
-#if WITH_EDITOR
-				EQSDebugger.StoreQuery(QueryInstance);
-#endif // WITH_EDITOR
-
-				QueryInstance->FinishDelegate.ExecuteIfBound(QueryInstance);
+				OnQueryFinished(QueryInstance);
 
 				RunningQueries.RemoveAt(Index);
 				Index--;
@@ -232,6 +281,92 @@ void UEnvQueryManager::Tick(float DeltaTime)
 			TimeLeft -= FPlatformTime::Seconds() - StartTime;
 		}
 	}
+
+#if STATS
+	const double StatsTime = FPlatformTime::Seconds() - StatsStartTime;
+	if (StatsTime >= 1.0)
+	{
+		SET_FLOAT_STAT(STAT_AI_EnvQuery_QueriesPerSecond, StatsStartTime > 0.0 ? NumFinishedQueries / StatsTime : 0.0);
+		SET_FLOAT_STAT(STAT_AI_EnvQuery_AverageLatency, NumFinishedQueries > 0 ? (double)FinishedQueriesLatency / NumFinishedQueries : 0.0);
+
+		NumFinishedQueries = 0;
+		FinishedQueriesLatency = 0;
+		StatsStartTime = FPlatformTime::Seconds();
+	}
+#endif // STATS
+}
+
+int32 UEnvQueryManager::ExecuteThreadSafeTests(int32 NumTasks, double TimeLimit)
+{
+	FParallelEnvQueryTests Parallel;
+
+	for (int32 Index = 0; Index < RunningQueries.Num(); Index++)
+	{
+		FEnvQueryInstance* QueryInstance = RunningQueries[Index].Get();
+		if (QueryInstance->Owner.IsValid() && QueryInstance->IsCurrentTestThreadSafe())
+		{
+			// context providers may touch anything in the world, so they run here and tests only read their cached results
+			QueryInstance->CacheCurrentTestContexts();
+			QueryInstance->bContextCacheReadOnly = true;
+			Parallel.Queries.Add(QueryInstance);
+		}
+	}
+
+	if (Parallel.Queries.Num() == 0)
+	{
+		return 0;
+	}
+
+	INC_DWORD_STAT_BY(STAT_AI_EnvQuery_NumThreadedSteps, Parallel.Queries.Num());
+	Parallel.StepsDone.AddZeroed(Parallel.Queries.Num());
+	Parallel.Deadline = FPlatformTime::Seconds() + TimeLimit;
+
+	// The game thread does its share too instead of just waiting
+	FGraphEventArray Tasks;
+	for (int32 TaskIndex = 1; TaskIndex < FMath::Min(NumTasks, Parallel.Queries.Num()); TaskIndex++)
+	{
+		new (Tasks) FGraphEventRef(FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
+			FSimpleDelegateGraphTask::FDelegate::CreateRaw(&Parallel, &FParallelEnvQueryTests::Run),
+			TEXT("EQS Thread Safe Tests"),
+			NULL,
+			ENamedThreads::AnyThread
+			));
+	}
+	Parallel.Run();
+	FTaskGraphInterface::Get().WaitUntilTasksComplete(Tasks, ENamedThreads::GameThread);
+
+	// finishing a step sorts and shuffles items, which isn't done on workers
+	for (int32 Index = 0; Index < Parallel.Queries.Num(); Index++)
+	{
+		Parallel.Queries[Index]->bContextCacheReadOnly = false;
+		Parallel.Queries[Index]->FinishCurrentStep(Parallel.StepsDone[Index]);
+	}
+
+	return Parallel.Queries.Num();
+}
+
+void UEnvQueryManager::RemoveFinishedQueries()
+{
+	for (int32 Index = RunningQueries.Num() - 1; Index >= 0; Index--)
+	{
+		if (RunningQueries[Index]->Status != EEnvQueryStatus::Processing)
+		{
+			OnQueryFinished(RunningQueries[Index]);
+			RunningQueries.RemoveAt(Index);
+		}
+	}
+}
+
+void UEnvQueryManager::OnQueryFinished(TSharedPtr<FEnvQueryInstance>& QueryInstance)
+{
+#if WITH_EDITOR
+	EQSDebugger.StoreQuery(QueryInstance);
+#endif // WITH_EDITOR
+
+	NumFinishedQueries++;
+	FinishedQueriesLatency += GFrameCounter - QueryInstance->StartFrame;
+
+	QueryInstance->FinishDelegate.ExecuteIfBound(QueryInstance);
 }
 
 void UEnvQueryManager::OnPreLoadMap()
@@ -9,6 +9,7 @@ UEnvQueryTest::UEnvQueryTest(const class FPostConstructInitializeProperties& PCI
 	WeightModifier = EEnvTestWeight::None;
 	Weight.Value = 1.0f;
 	bWorkOnFloatValues = true;
+	bThreadSafe = false;
 	BoolFilter.Value = true;
 }
 
@@ -124,6 +125,11 @@ AActor* UEnvQueryTest::GetItemActor(struct FEnvQueryInstance& QueryInstance, int
 		NULL;
 }
 
+void UEnvQueryTest::GetUsedContexts(TArray<UClass*>& Contexts) const
+{
+	// tests that don't read any contexts have nothing to add
+}
+
 FString UEnvQueryTest::GetDescriptionTitle() const
 {
 	return UEnvQueryTypes::GetShortTypeName(this);
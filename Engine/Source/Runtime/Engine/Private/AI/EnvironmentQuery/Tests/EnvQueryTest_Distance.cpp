@@ -27,6 +27,7 @@ UEnvQueryTest_Distance::UEnvQueryTest_Distance(const class FPostConstructInitial
 	DistanceTo = UEnvQueryContext_Querier::StaticClass();
 	Cost = EEnvTestCost::Low;
 	ValidItemType = UEnvQueryItemType_LocationBase::StaticClass();
+	bThreadSafe = true;
 }
 
 void UEnvQueryTest_Distance::RunTest(struct FEnvQueryInstance& QueryInstance)
@@ -84,6 +85,11 @@ void UEnvQueryTest_Distance::RunTest(struct FEnvQueryInstance& QueryInstance)
 	}
 }
 
+void UEnvQueryTest_Distance::GetUsedContexts(TArray<UClass*>& Contexts) const
+{
+	Contexts.Add(DistanceTo);
+}
+
 FString UEnvQueryTest_Distance::GetDescriptionTitle() const
 {
 	FString ModeDesc;
@@ -8,6 +8,7 @@ UEnvQueryTest_Dot::UEnvQueryTest_Dot(const class FPostConstructInitializePropert
 
 	Cost = EEnvTestCost::Low;
 	ValidItemType = UEnvQueryItemType_LocationBase::StaticClass();
+	bThreadSafe = true;
 	LineA = EEnvTestDot::Direction;
 	LineADirection = UEnvQueryContext_Querier::StaticClass();
 	LineB = EEnvTestDot::Segment;
@@ -162,6 +163,29 @@ bool UEnvQueryTest_Dot::RequiresPerItemUpdates(TSubclassOf<class UEnvQueryContex
 	return bRequirePerItemUpdate;
 }
 
+void UEnvQueryTest_Dot::GetUsedContexts(TArray<UClass*>& Contexts) const
+{
+	if (LineA == EEnvTestDot::Direction)
+	{
+		Contexts.Add(LineADirection);
+	}
+	else
+	{
+		Contexts.Add(LineAFrom);
+		Contexts.Add(LineATo);
+	}
+
+	if (LineB == EEnvTestDot::Direction)
+	{
+		Contexts.Add(LineBDirection);
+	}
+	else
+	{
+		Contexts.Add(LineBFrom);
+		Contexts.Add(LineBTo);
+	}
+}
+
 FString UEnvQueryTest_Dot::GetDescriptionTitle() const
 {
 	FString LineADesc = LineA == EEnvTestDot::Segment ?
@@ -4,6 +4,20 @@
 
 DEFINE_STAT(STAT_AI_ObstacleAvoidance);
 
+/** Avoidance grid cells are never smaller than this, even if TestRadius2D is */
+static const float MIN_AVOIDANCE_GRID_CELL_SIZE = 100.0f;
+
+/** Number of agents a task takes at once in UpdateBatchedAvoidance */
+static const int32 AVOIDANCE_BATCH_CHUNK_SIZE = 16;
+
+static TAutoConsoleVariable<int32> CVarAvoidanceBatchTasks(
+	TEXT("ai.AvoidanceBatchTasks"),
+	0,
+	TEXT("Number of task graph tasks the avoidance velocities of all registered character movement components are found with at the start of the frame.\n")
+	TEXT("0 disables batching, every component finds its own velocity while it moves. Batched velocities are based on where the agents were at the end of the last frame."),
+	ECVF_Default
+	);
+
 void FNavAvoidanceData::Init(class UAvoidanceManager* Avoidance, const FVector& InCenter, float InRadius, float InHeight,
 							 const FVector& InVelocity, float InWeight, int32 InGroupMask, int32 InGroupsToAvoid, int32 InGroupsToIgnore)
 {
@@ -36,6 +50,7 @@ UAvoidanceManager::UAvoidanceManager(const class FPostConstructInitializePropert
 	TestRadius2D = 500.0f;
 	TestHeightDifference = 500.0f;
 	bRequestedUpdateTimer = false;
+	AvoidanceGridCellSize = 0.0f;
 
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 	bDebugAll = false;
@@ -67,6 +82,7 @@ void UAvoidanceManager::RemoveOutdatedObjects()
 			//Expired, not in pool yet, assign to pool
 			//DrawDebugLine(GetWorld(), AvoidanceData.Center, AvoidanceData.Center + FVector(0,0,500), FColor(64,255,64), true, 2.0f, SDPG_MAX, 20.0f);
 			NewKeyPool.AddUnique(ObjectId);
+			RemoveFromGrid(ObjectId);
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 			if (DebugUIDs.Contains(ObjectId))
 			{
@@ -117,6 +133,7 @@ bool UAvoidanceManager::RegisterMovementComponent(UCharacterMovementComponent* M
 			const int32 NewAvoidanceUID = GetNewAvoidanceUID();
 			MovementComp->AvoidanceUID = NewAvoidanceUID;
 			MovementComp->AvoidanceWeight = AvoidanceWeight;
+			RegisteredMovementComponents.AddUnique(MovementComp);
 
 			RequestUpdateTimer();
 			UpdateRVO(NewAvoidanceUID, MovementComp->GetActorLocation(),
@@ -160,6 +177,66 @@ void UAvoidanceManager::UpdateRVO_Internal(int32 inAvoidanceUID, const FNavAvoid
 	{
 		AvoidanceObjects.Add(inAvoidanceUID, inAvoidanceData);
 	}
+
+	RebuildGridIfNeeded();
+	UpdateGridCell(inAvoidanceUID, inAvoidanceData.Center);
+}
+
+FIntPoint UAvoidanceManager::GetGridCell(const FVector& Location) const
+{
+	checkSlow(AvoidanceGridCellSize > 0.0f);
+	return FIntPoint(FMath::FloorToInt(Location.X / AvoidanceGridCellSize), FMath::FloorToInt(Location.Y / AvoidanceGridCellSize));
+}
+
+void UAvoidanceManager::UpdateGridCell(int32 AvoidanceUID, const FVector& Center)
+{
+	const FIntPoint NewCell = GetGridCell(Center);
+	FIntPoint* Cell = AvoidanceGridCells.Find(AvoidanceUID);
+	if (Cell && *Cell == NewCell)
+	{
+		return;
+	}
+
+	if (Cell)
+	{
+		RemoveFromGrid(AvoidanceUID);
+	}
+	AvoidanceGrid.FindOrAdd(NewCell).Add(AvoidanceUID);
+	AvoidanceGridCells.Add(AvoidanceUID, NewCell);
+}
+
+void UAvoidanceManager::RemoveFromGrid(int32 AvoidanceUID)
+{
+	FIntPoint Cell;
+	if (AvoidanceGridCells.RemoveAndCopyValue(AvoidanceUID, Cell))
+	{
+		TArray<int32>& CellUIDs = AvoidanceGrid.FindChecked(Cell);
+		CellUIDs.RemoveSingleSwap(AvoidanceUID);
+		if (CellUIDs.Num() == 0)
+		{
+			AvoidanceGrid.Remove(Cell);
+		}
+	}
+}
+
+void UAvoidanceManager::RebuildGridIfNeeded()
+{
+	const float CellSize = FMath::Max(TestRadius2D, MIN_AVOIDANCE_GRID_CELL_SIZE);
+	if (CellSize == AvoidanceGridCellSize)
+	{
+		return;
+	}
+
+	AvoidanceGridCellSize = CellSize;
+	AvoidanceGrid.Empty();
+	AvoidanceGridCells.Empty();
+	for (auto& AvoidanceObj : AvoidanceObjects)
+	{
+		if (!AvoidanceObj.Value.ShouldBeIgnored())
+		{
+			UpdateGridCell(AvoidanceObj.Key, AvoidanceObj.Value.Center);
+		}
+	}
 }
 
 FVector AvoidCones(TArray<FVelocityAvoidanceCone>& AllCones, const FVector& BasePosition, const FVector& DesiredPosition, const int NumConesToTest)
@@ -229,8 +306,14 @@ FVector AvoidCones(TArray<FVelocityAvoidanceCone>& AllCones, const FVector& Base
 	return CurrentPosition;
 }
 
-//RickH - We could probably significantly improve speed if we put separate Z checks in place and did everything else in 2D.
 FVector UAvoidanceManager::GetAvoidanceVelocity_Internal(const FNavAvoidanceData& inAvoidanceData, float DeltaTime, int32* inIgnoreThisUID)
+{
+	RebuildGridIfNeeded();
+	return GetAvoidanceVelocity_Internal(inAvoidanceData, DeltaTime, inIgnoreThisUID, AllCones);
+}
+
+//RickH - We could probably significantly improve speed if we put separate Z checks in place and did everything else in 2D.
+FVector UAvoidanceManager::GetAvoidanceVelocity_Internal(const FNavAvoidanceData& inAvoidanceData, float DeltaTime, int32* inIgnoreThisUID, TArray<FVelocityAvoidanceCone>& Cones)
 {
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 	if (!bSystemActive)
@@ -268,17 +351,38 @@ FVector UAvoidanceManager::GetAvoidanceVelocity_Internal(const FNavAvoidanceData
 	{
 		return inAvoidanceData.Velocity;
 	}
-	AllCones.Empty(AllCones.Max());
+	Cones.Empty(Cones.Max());
 
 	//DrawDebugDirectionalArrow(GetWorld(), inAvoidanceData.Center, inAvoidanceData.Center + inAvoidanceData.Velocity, 2.5f, FColor(0,255,255), true, 0.05f, SDPG_MAX);
 
-	for (auto& AvoidanceObj : AvoidanceObjects)
+	//Only objects in grid cells within TestRadius2D can pass the distance check below
+	TArray<const FNavAvoidanceData*, TInlineAllocator<64> > NearbyObjects;
+	const FIntPoint MinCell = GetGridCell(inAvoidanceData.Center - FVector(TestRadius2D, TestRadius2D, 0.0f));
+	const FIntPoint MaxCell = GetGridCell(inAvoidanceData.Center + FVector(TestRadius2D, TestRadius2D, 0.0f));
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
 	{
-		if ((inIgnoreThisUID) && (*inIgnoreThisUID == AvoidanceObj.Key))
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
 		{
-			continue;
+			const TArray<int32>* CellUIDs = AvoidanceGrid.Find(FIntPoint(CellX, CellY));
+			if (CellUIDs == NULL)
+			{
+				continue;
+			}
+			for (int32 i = 0; i < CellUIDs->Num(); ++i)
+			{
+				const int32 OtherUID = (*CellUIDs)[i];
+				if ((inIgnoreThisUID) && (*inIgnoreThisUID == OtherUID))
+				{
+					continue;
+				}
+				NearbyObjects.Add(&AvoidanceObjects.FindChecked(OtherUID));
+			}
 		}
-		FNavAvoidanceData& OtherObject = AvoidanceObj.Value;
+	}
+
+	for (int32 ObjectIndex = 0; ObjectIndex < NearbyObjects.Num(); ++ObjectIndex)
+	{
+		const FNavAvoidanceData& OtherObject = *NearbyObjects[ObjectIndex];
 
 		//
 		//Start with a few fast-rejects
@@ -382,7 +486,7 @@ FVector UAvoidanceManager::GetAvoidanceVelocity_Internal(const FNavAvoidanceData
 					Unobstructed = false;
 				}
 
-				AllCones.Add(NewCone);
+				Cones.Add(NewCone);
 			}
 		}
 	}
@@ -393,7 +497,7 @@ FVector UAvoidanceManager::GetAvoidanceVelocity_Internal(const FNavAvoidanceData
 	}
 
 	//Find a good velocity that isn't inside a cone.
-	if (AllCones.Num())
+	if (Cones.Num())
 	{
 		float AngleCurrent;
 		float AngleF = ReturnVelocity.HeadingAngle();
@@ -423,7 +527,7 @@ FVector UAvoidanceManager::GetAvoidanceVelocity_Internal(const FNavAvoidanceData
 			BestScorePotential = (VelSpacePoint|ReturnVelocity) * (VelSpacePoint|VelSpacePoint);
 			if (BestScorePotential > BestScore)
 			{
-				FVector CandidateVelocity = AvoidCones(AllCones, FVector::ZeroVector, VelSpacePoint, AllCones.Num());
+				FVector CandidateVelocity = AvoidCones(Cones, FVector::ZeroVector, VelSpacePoint, Cones.Num());
 				float CandidateScore = (CandidateVelocity|ReturnVelocity) * (CandidateVelocity|CandidateVelocity);
 
 				//Vectors are rated by their length and their overall forward movement.
@@ -455,6 +559,124 @@ void UAvoidanceManager::OverrideToMaxWeight(int32 AvoidanceUID, float Duration)
 	}
 }
 
+/** Avoidance query of one agent in UpdateBatchedAvoidance */
+struct FAvoidanceBatchEntry
+{
+	FNavAvoidanceData Data;
+	int32 AvoidanceUID;
+	FVector Velocity;
+};
+
+/** Pulls agents to find avoidance velocities for until all are done, several of these run at once on task graph workers */
+struct FParallelAvoidanceBatch
+{
+	UAvoidanceManager*				AvoidanceManager;
+	TArray<FAvoidanceBatchEntry>*	Entries;
+	FThreadSafeCounter				NextIndex;
+
+	void Run()
+	{
+		TArray<FVelocityAvoidanceCone> Cones;
+		for (int32 StartIndex = NextIndex.Add(AVOIDANCE_BATCH_CHUNK_SIZE); StartIndex < Entries->Num(); StartIndex = NextIndex.Add(AVOIDANCE_BATCH_CHUNK_SIZE))
+		{
+			const int32 EndIndex = FMath::Min(StartIndex + AVOIDANCE_BATCH_CHUNK_SIZE, Entries->Num());
+			for (int32 Index = StartIndex; Index < EndIndex; ++Index)
+			{
+				FAvoidanceBatchEntry& Entry = (*Entries)[Index];
+				Entry.Velocity = AvoidanceManager->GetAvoidanceVelocity_Internal(Entry.Data, AvoidanceManager->DeltaTimeToPredict, &Entry.AvoidanceUID, Cones);
+			}
+		}
+	}
+};
+
+void UAvoidanceManager::UpdateBatchedAvoidance()
+{
+	const int32 NumTasks = CVarAvoidanceBatchTasks.GetValueOnGameThread();
+	if (NumTasks <= 0 || RegisteredMovementComponents.Num() == 0)
+	{
+		return;
+	}
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+	if (!bSystemActive)
+	{
+		return;
+	}
+#endif
+
+	SCOPE_CYCLE_COUNTER(STAT_AI_ObstacleAvoidance);
+
+	RebuildGridIfNeeded();
+
+	TArray<FAvoidanceBatchEntry> Entries;
+	Entries.Reserve(RegisteredMovementComponents.Num());
+	for (int32 Index = RegisteredMovementComponents.Num() - 1; Index >= 0; --Index)
+	{
+		UCharacterMovementComponent* MovementComp = RegisteredMovementComponents[Index].Get();
+		if (MovementComp == NULL)
+		{
+			RegisteredMovementComponents.RemoveAtSwap(Index);
+			continue;
+		}
+
+		FAvoidanceBatchEntry Entry;
+		Entry.AvoidanceUID = MovementComp->AvoidanceUID;
+
+		// Debug drawing isn't thread safe, agents being debugged find their velocity themselves
+		if (Entry.AvoidanceUID >= 0 && MovementComp->GetAvoidanceQueryData(this, Entry.Data)
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+			&& !IsDebugEnabled(Entry.AvoidanceUID)
+#endif
+			)
+		{
+			Entries.Add(Entry);
+		}
+	}
+
+	FParallelAvoidanceBatch Parallel;
+	Parallel.AvoidanceManager	= this;
+	Parallel.Entries			= &Entries;
+
+	// The game thread does its share too instead of just waiting
+	FGraphEventArray Tasks;
+	for (int32 TaskIndex = 1; TaskIndex < FMath::Min(NumTasks, FMath::DivideAndRoundUp(Entries.Num(), AVOIDANCE_BATCH_CHUNK_SIZE)); TaskIndex++)
+	{
+		new (Tasks) FGraphEventRef(FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
+			FSimpleDelegateGraphTask::FDelegate::CreateRaw(&Parallel, &FParallelAvoidanceBatch::Run),
+			TEXT("Batched Avoidance"),
+			NULL,
+			ENamedThreads::AnyThread
+			));
+	}
+	Parallel.Run();
+	FTaskGraphInterface::Get().WaitUntilTasksComplete(Tasks, ENamedThreads::GameThread);
+
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		const FAvoidanceBatchEntry& Entry = Entries[Index];
+		if (Entry.AvoidanceUID >= BatchResults.Num())
+		{
+			BatchResults.SetNum(Entry.AvoidanceUID + 1);
+		}
+
+		FNavAvoidanceBatchResult& Result = BatchResults[Entry.AvoidanceUID];
+		Result.Velocity = Entry.Velocity;
+		Result.FrameNumber = GFrameCounter;
+		Result.bDiverted = !Entry.Velocity.Equals(Entry.Data.Velocity);
+	}
+}
+
+bool UAvoidanceManager::GetBatchedAvoidanceVelocity(int32 AvoidanceUID, const FVector& CurrentVelocity, FVector& OutVelocity) const
+{
+	if (!BatchResults.IsValidIndex(AvoidanceUID) || BatchResults[AvoidanceUID].FrameNumber != GFrameCounter)
+	{
+		return false;
+	}
+
+	const FNavAvoidanceBatchResult& Result = BatchResults[AvoidanceUID];
+	OutVelocity = Result.bDiverted ? Result.Velocity : CurrentVelocity;
+	return true;
+}
+
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 bool UAvoidanceManager::IsDebugOnForUID(int32 AvoidanceUID)
 {
@@ -17,6 +17,16 @@ static const uint32 MAX_SEARCH_NODES = 2048;
 
 DEFINE_LOG_CATEGORY(LogNavigation);
 
+/** Smallest number of async pathfinding requests worth a worker task of their own */
+static const int32 MIN_ASYNC_QUERIES_PER_WORKER = 4;
+
+static TAutoConsoleVariable<int32> CVarAsyncPathfindingWorkers(
+	TEXT("ai.AsyncPathfindingWorkers"),
+	0,
+	TEXT("Maximum number of task graph tasks a frame's async pathfinding requests are spread over, 0 uses one per task graph worker thread."),
+	ECVF_Default
+	);
+
 DECLARE_CYCLE_STAT(TEXT("Rasterize triangles"), STAT_Navigation_RasterizeTriangles,STATGROUP_Navigation);
 
 //----------------------------------------------------------------------//
@@ -635,33 +645,69 @@ void UNavigationSystem::AbortAsyncFindPathRequest(uint32 AsynPathQueryID)
 	}
 }
 
-void UNavigationSystem::TriggerAsyncQueries(TArray<FAsyncPathFindingQuery>& PathFindingQueries)
+int32 UNavigationSystem::GetNumAsyncQueryWorkers(int32 NumQueries)
 {
-	FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
-		FSimpleDelegateGraphTask::FDelegate::CreateUObject(this, &UNavigationSystem::PerformAsyncQueries, PathFindingQueries)
-		, TEXT("NavigationSystem batched async queries")
-		);
+	const int32 MaxWorkers = CVarAsyncPathfindingWorkers.GetValueOnGameThread() > 0
+		? CVarAsyncPathfindingWorkers.GetValueOnGameThread()
+		: FTaskGraphInterface::Get().GetNumWorkerThreads();
+
+	return FMath::Clamp(FMath::DivideAndRoundUp(NumQueries, MIN_ASYNC_QUERIES_PER_WORKER), 1, FMath::Max(MaxWorkers, 1));
 }
 
-static void AsyncQueryDone(FAsyncPathFindingQuery Query)
+FGraphEventArray UNavigationSystem::DispatchAsyncQueryWorkers(FAsyncPathFindingBatch* Batch, int32 NumWorkers)
 {
-	Query.OnDoneDelegate.ExecuteIfBound(Query.QueryID, Query.Result.Result, Query.Result.Path);
+	FGraphEventArray Workers;
+	for (int32 WorkerIndex = 0; WorkerIndex < FMath::Min(NumWorkers, Batch->Queries.Num()); ++WorkerIndex)
+	{
+		new (Workers) FGraphEventRef(FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
+			FSimpleDelegateGraphTask::FDelegate::CreateUObject(this, &UNavigationSystem::PerformAsyncQueries, Batch)
+			, TEXT("NavigationSystem batched async queries")
+			, NULL
+			, ENamedThreads::AnyThread
+			));
+	}
+	return Workers;
 }
 
-void UNavigationSystem::PerformAsyncQueries(TArray<FAsyncPathFindingQuery> PathFindingQueries)
+/** Calls the delegates of all queries in Batch once the workers are done with it, on the game thread */
+static void AsyncQueriesDone(FAsyncPathFindingBatch* Batch)
 {
-	SCOPE_CYCLE_COUNTER(STAT_Navigation_PathfindingAsync);
+	const int32 QueriesCount = Batch->Queries.Num();
+	FAsyncPathFindingQuery* Query = Batch->Queries.GetTypedData();
 
-	if (PathFindingQueries.Num() == 0)
+	for (int32 i = 0; i < QueriesCount; ++i, ++Query)
 	{
-		return;
+		Query->OnDoneDelegate.ExecuteIfBound(Query->QueryID, Query->Result.Result, Query->Result.Path);
 	}
-	
-	const int32 QueriesCount = PathFindingQueries.Num();
-	FAsyncPathFindingQuery* Query = PathFindingQueries.GetTypedData();
 
-	for (int32 i = 0; i < QueriesCount; ++i, ++Query)
+	delete Batch;
+}
+
+void UNavigationSystem::TriggerAsyncQueries(TArray<FAsyncPathFindingQuery>& PathFindingQueries)
+{
+	FAsyncPathFindingBatch* Batch = new FAsyncPathFindingBatch(PathFindingQueries);
+	const FGraphEventArray Workers = DispatchAsyncQueryWorkers(Batch, GetNumAsyncQueryWorkers(Batch->Queries.Num()));
+
+	// @todo make it return more informative results (bResult == false)
+	// results are delivered on main thread - otherwise it may depend too much on stuff being thread safe
+	FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
+		FSimpleDelegateGraphTask::FDelegate::CreateStatic(AsyncQueriesDone, Batch)
+		, TEXT("Async nav queries finished")
+		, &Workers
+		, ENamedThreads::GameThread
+		);
+}
+
+void UNavigationSystem::PerformAsyncQueries(FAsyncPathFindingBatch* Batch)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Navigation_PathfindingAsync);
+
+	const int32 QueriesCount = Batch->Queries.Num();
+
+	for (int32 i = Batch->NextQueryIndex.Increment() - 1; i < QueriesCount; i = Batch->NextQueryIndex.Increment() - 1)
 	{
+		FAsyncPathFindingQuery* Query = &Batch->Queries[i];
+
 		// @todo this is not necessarily the safest way to use UObjects outside of main thread. 
 		//	think about something else.
 		const ANavigationData* NavData = Query->NavData.IsValid() ? Query->NavData.Get() : GetMainNavData(NavigationSystem::DontCreate);
@@ -682,15 +728,6 @@ void UNavigationSystem::PerformAsyncQueries(TArray<FAsyncPathFindingQuery> PathF
 		{
 			Query->Result = ENavigationQueryResult::Error;
 		}
-
-		// @todo make it return more informative results (bResult == false)
-		// trigger calling delegate on main thread - otherwise it may depend too much on stuff being thread safe
-		FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
-			FSimpleDelegateGraphTask::FDelegate::CreateStatic(AsyncQueryDone, *Query)
-			, TEXT("Async nav query finished")
-			, NULL
-			, ENamedThreads::GameThread
-			);
 	}
 }
 
@@ -2538,6 +2575,66 @@ bool FNavigationSystemExec::Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevi
 	return false;
 }
 
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+/**
+ * Finds NumPaths paths between random points of the main navigation data the way async requests are processed,
+ * with 1 to MaxWorkers worker tasks, and reports the throughput of each.
+ */
+static void PathfindingBenchmark(const TArray<FString>& Args, UWorld* InWorld)
+{
+	UNavigationSystem* NavSys = InWorld ? InWorld->GetNavigationSystem() : NULL;
+	ANavigationData* NavData = NavSys ? NavSys->GetMainNavData(NavigationSystem::DontCreate) : NULL;
+	if (NavData == NULL)
+	{
+		UE_LOG(LogNavigation, Warning, TEXT("ai.PathfindingBenchmark needs a world with navigation data"));
+		return;
+	}
+
+	const int32 NumPaths = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000;
+	const int32 MaxWorkers = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1);
+
+	TArray<FAsyncPathFindingQuery> Queries;
+	Queries.Reserve(NumPaths);
+	for (int32 Index = 0; Index < NumPaths; ++Index)
+	{
+		const FVector Start = NavData->GetRandomPoint().Location;
+		const FVector End = NavData->GetRandomPoint().Location;
+		new (Queries) FAsyncPathFindingQuery(NavData, Start, End, FNavPathQueryDelegate(), NULL);
+	}
+
+	UE_LOG(LogNavigation, Log, TEXT("Finding %d paths on %s"), NumPaths, *NavData->GetName());
+
+	double SerialTime = 0.0;
+	for (int32 NumWorkers = 1; NumWorkers <= MaxWorkers; ++NumWorkers)
+	{
+		FAsyncPathFindingBatch Batch(Queries);
+
+		const double StartTime = FPlatformTime::Seconds();
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(NavSys->DispatchAsyncQueryWorkers(&Batch, NumWorkers), ENamedThreads::GameThread);
+		const double Time = FPlatformTime::Seconds() - StartTime;
+
+		int32 NumFound = 0;
+		for (int32 Index = 0; Index < Batch.Queries.Num(); ++Index)
+		{
+			NumFound += Batch.Queries[Index].Result.IsSuccessful() ? 1 : 0;
+		}
+
+		if (NumWorkers == 1)
+		{
+			SerialTime = Time;
+		}
+		UE_LOG(LogNavigation, Log, TEXT("%3d workers: %8.3f ms, %10.1f paths/s, %5.2fx, %d paths found"),
+			NumWorkers, Time * 1000.0, Time > 0.0 ? NumPaths / Time : 0.0, Time > 0.0 ? SerialTime / Time : 0.0, NumFound);
+	}
+}
+
+FAutoConsoleCommandWithWorldAndArgs PathfindingBenchmarkCommand(
+	TEXT("ai.PathfindingBenchmark"),
+	TEXT("Times finding [NumPaths=1000] random paths on the main navigation data with 1 to [MaxWorkers] async pathfinding workers"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(PathfindingBenchmark)
+	);
+#endif
+
 void UNavigationSystem::CycleNavigationDataDrawn()
 {
 	++CurrentlyDrawnNavDataIndex;
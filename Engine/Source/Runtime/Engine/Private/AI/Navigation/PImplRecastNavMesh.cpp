@@ -31,8 +31,8 @@ checkAtCompileTime(RECAST_UNWALKABLE_POLY_COST == DT_UNWALKABLE_POLY_COST, Unwal
 #endif
 
 /// Helper for accessing navigation query from different threads
-#define INITIALIZE_NAVQUERY(NavQueryVariable, NumNodes)	dtNavMeshQuery NavQueryVariable##Private;	\
-														dtNavMeshQuery& NavQueryVariable = IsInGameThread() ? SharedNavQuery : NavQueryVariable##Private; \
+#define INITIALIZE_NAVQUERY(NavQueryVariable, NumNodes)	FRecastNavQueryPool::FScopedQuery NavQueryVariable##Pooled(IsInGameThread() ? NULL : &NavQueryPool);	\
+														dtNavMeshQuery& NavQueryVariable = NavQueryVariable##Pooled.Query ? *NavQueryVariable##Pooled.Query : SharedNavQuery; \
 														NavQueryVariable.init(DetourNavMesh, NumNodes);
 
 static void* DetourMalloc(int Size, dtAllocHint)
@@ -173,9 +173,32 @@ bool FRecastQueryFilter::IsEqual(const INavigationQueryFilterInterface* Other) c
 }
 
 //----------------------------------------------------------------------//
-// FPImplRecastNavMesh
+// FRecastNavQueryPool
 //----------------------------------------------------------------------//
+FRecastNavQueryPool::~FRecastNavQueryPool()
+{
+	for (int32 Index = 0; Index < FreeQueries.Num(); Index++)
+	{
+		delete FreeQueries[Index];
+	}
+	FreeQueries.Empty();
+}
+
+dtNavMeshQuery* FRecastNavQueryPool::Acquire()
+{
+	FScopeLock ScopeLock(&Lock);
+	return FreeQueries.Num() > 0 ? FreeQueries.Pop() : new dtNavMeshQuery();
+}
+
+void FRecastNavQueryPool::Release(dtNavMeshQuery* Query)
+{
+	FScopeLock ScopeLock(&Lock);
+	FreeQueries.Add(Query);
+}
 
+//----------------------------------------------------------------------//
+// FPImplRecastNavMesh
+//----------------------------------------------------------------------//
 FPImplRecastNavMesh::FPImplRecastNavMesh(ARecastNavMesh* Owner)
 	: NavMeshOwner(Owner)
 	, bOwnsNavMeshData(false)
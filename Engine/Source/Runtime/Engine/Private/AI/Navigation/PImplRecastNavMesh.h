@@ -43,6 +43,47 @@ namespace EClusterPath
 	};
 }
 
+/**
+ * Navmesh queries used by threads other than the game thread.
+ * A query keeps its node pool between uses, so workers don't allocate one for every path they find.
+ */
+class FRecastNavQueryPool
+{
+public:
+	~FRecastNavQueryPool();
+
+	/** Returns a query nobody else uses, allocating a new one if all are taken */
+	dtNavMeshQuery* Acquire();
+
+	/** Returns a query taken with Acquire to the pool */
+	void Release(dtNavMeshQuery* Query);
+
+	/** Takes a query from the pool for the current scope, or nothing if Pool is NULL */
+	struct FScopedQuery
+	{
+		FRecastNavQueryPool* Pool;
+		dtNavMeshQuery* Query;
+
+		FScopedQuery(FRecastNavQueryPool* InPool)
+			: Pool(InPool)
+			, Query(InPool ? InPool->Acquire() : NULL)
+		{
+		}
+
+		~FScopedQuery()
+		{
+			if (Pool)
+			{
+				Pool->Release(Query);
+			}
+		}
+	};
+
+private:
+	FCriticalSection Lock;
+	TArray<dtNavMeshQuery*> FreeQueries;
+};
+
 /** Engine Private! - Private Implementation details of ARecastNavMesh */
 class FPImplRecastNavMesh
 {
@@ -190,6 +231,9 @@ private:
 	/** query used for searching data on game thread */
 	mutable dtNavMeshQuery SharedNavQuery;
 
+	/** queries used for searching data on other threads, one per thread searching at the same time */
+	mutable FRecastNavQueryPool NavQueryPool;
+
 	/** Helper function to serialize a single Recast tile. */
 	static void SerializeRecastMeshTile(FArchive& Ar, unsigned char*& TileData, int32& TileDataSize);
 
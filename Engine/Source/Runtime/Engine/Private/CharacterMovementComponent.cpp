@@ -1894,12 +1894,16 @@ void UCharacterMovementComponent::CalcAvoidanceVelocity(float DeltaTime)
 		}
 		else
 		{
-			FNavAvoidanceData currentData;
-			currentData.Init(AvoidanceManager, GetActorLocation(),
-				OurCapsule->GetScaledCapsuleRadius(), OurCapsule->GetScaledCapsuleHalfHeight(),
-				Velocity, AvoidanceWeight, AvoidanceGroup.Packed, GroupsToAvoid.Packed, GroupsToIgnore.Packed);
+			FVector NewVelocity;
+			if (!AvoidanceManager->GetBatchedAvoidanceVelocity(AvoidanceUID, Velocity, NewVelocity))
+			{
+				FNavAvoidanceData currentData;
+				currentData.Init(AvoidanceManager, GetActorLocation(),
+					OurCapsule->GetScaledCapsuleRadius(), OurCapsule->GetScaledCapsuleHalfHeight(),
+					Velocity, AvoidanceWeight, AvoidanceGroup.Packed, GroupsToAvoid.Packed, GroupsToIgnore.Packed);
 
-			FVector NewVelocity = AvoidanceManager->GetAvoidanceVelocityIgnoringUID(currentData, AvoidanceManager->DeltaTimeToPredict, AvoidanceUID);
+				NewVelocity = AvoidanceManager->GetAvoidanceVelocityIgnoringUID(currentData, AvoidanceManager->DeltaTimeToPredict, AvoidanceUID);
+			}
 			if (bUseRVOPostProcess)
 			{
 				PostProcessAvoidanceVelocity(NewVelocity);
@@ -1955,6 +1959,26 @@ void UCharacterMovementComponent::PostProcessAvoidanceVelocity(FVector& NewVeloc
 	// empty in base class
 }
 
+bool UCharacterMovementComponent::GetAvoidanceQueryData(UAvoidanceManager* Avoidance, FNavAvoidanceData& OutData) const
+{
+	if (!bUseRVOAvoidance || AvoidanceWeight >= 1.0f || CharacterOwner == NULL || !CharacterOwner->bUseAvoidancePathing || CharacterOwner->Role != ROLE_Authority)
+	{
+		return false;
+	}
+
+	// Same conditions as CalcAvoidanceVelocity, locked moves don't query
+	UCapsuleComponent* OurCapsule = CharacterOwner->CapsuleComponent.Get();
+	if (Velocity.IsZero() || MovementMode != MOVE_Walking || OurCapsule == NULL || AvoidanceLockTimer > 0.0f)
+	{
+		return false;
+	}
+
+	OutData.Init(Avoidance, GetActorLocation(),
+		OurCapsule->GetScaledCapsuleRadius(), OurCapsule->GetScaledCapsuleHalfHeight(),
+		Velocity, AvoidanceWeight, AvoidanceGroup.Packed, GroupsToAvoid.Packed, GroupsToIgnore.Packed);
+	return true;
+}
+
 void UCharacterMovementComponent::UpdateDefaultAvoidance()
 {
 	if (!bUseRVOAvoidance)
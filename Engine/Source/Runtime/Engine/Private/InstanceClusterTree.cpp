@@ -0,0 +1,262 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	InstanceClusterTree.cpp: Bounding volume hierarchy over mesh instances.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "InstanceClusterTree.h"
+
+/**
+ * Reorders instances so that the Nth one is the one that would be there if they were sorted by the Axis component of their
+ * centers, with no instance before it greater and no instance after it smaller.
+ */
+static void SelectNthInstance(int32* Instances, int32 NumInstances, int32 N, const TArray<FVector>& InstanceCenters, int32 Axis)
+{
+	int32 Left = 0;
+	int32 Right = NumInstances - 1;
+
+	while (Right > Left)
+	{
+		// Median of three pivot, so sorted and reverse sorted ranges don't degrade
+		const float A = InstanceCenters[Instances[Left]][Axis];
+		const float B = InstanceCenters[Instances[Left + (Right - Left) / 2]][Axis];
+		const float C = InstanceCenters[Instances[Right]][Axis];
+		const float Pivot = FMath::Max(FMath::Min(A, B), FMath::Min(FMath::Max(A, B), C));
+
+		int32 Low = Left;
+		int32 High = Right;
+		while (Low <= High)
+		{
+			while (InstanceCenters[Instances[Low]][Axis] < Pivot)
+			{
+				Low++;
+			}
+			while (InstanceCenters[Instances[High]][Axis] > Pivot)
+			{
+				High--;
+			}
+			if (Low <= High)
+			{
+				Exchange(Instances[Low], Instances[High]);
+				Low++;
+				High--;
+			}
+		}
+
+		if (N <= High)
+		{
+			Right = High;
+		}
+		else if (N >= Low)
+		{
+			Left = Low;
+		}
+		else
+		{
+			break;
+		}
+	}
+}
+
+/** Returns the LOD used at a distance, INDEX_NONE if none is. */
+static int32 GetInstanceClusterLOD(const FInstanceClusterCullParams& Params, float DistanceSquared)
+{
+	if (Params.ForcedLOD != INDEX_NONE)
+	{
+		return Params.ForcedLOD;
+	}
+
+	for (int32 LODIndex = Params.NumLODs - 1; LODIndex >= 0; LODIndex--)
+	{
+		if (DistanceSquared >= FMath::Square(Params.LODDistances[LODIndex]) && DistanceSquared < FMath::Square(Params.LODDistances[LODIndex + 1]))
+		{
+			return LODIndex;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+/** Adds a range of instances, extending the last range if the new one follows it directly. */
+static void AddInstanceClusterRange(TArray<FInstanceClusterRange>& Ranges, int32 FirstInstance, int32 NumInstances)
+{
+	if (Ranges.Num() > 0)
+	{
+		FInstanceClusterRange& LastRange = Ranges.Last();
+		if (LastRange.FirstInstance + LastRange.NumInstances == FirstInstance)
+		{
+			LastRange.NumInstances += NumInstances;
+			return;
+		}
+	}
+
+	FInstanceClusterRange& Range = Ranges[Ranges.AddUninitialized()];
+	Range.FirstInstance = FirstInstance;
+	Range.NumInstances = NumInstances;
+}
+
+void FInstanceClusterTree::Build(const TArray<FBox>& InstanceBoxes, int32 MaxInstancesPerLeaf)
+{
+	const int32 NumInstances = InstanceBoxes.Num();
+	MaxInstancesPerLeaf = FMath::Max(MaxInstancesPerLeaf, 1);
+
+	Nodes.Empty(2 * (NumInstances / MaxInstancesPerLeaf) + 1);
+	SortedInstances.Empty(NumInstances);
+
+	if (NumInstances == 0)
+	{
+		return;
+	}
+
+	TArray<FVector> InstanceCenters;
+	InstanceCenters.AddUninitialized(NumInstances);
+	SortedInstances.AddUninitialized(NumInstances);
+	for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; InstanceIndex++)
+	{
+		InstanceCenters[InstanceIndex] = InstanceBoxes[InstanceIndex].GetCenter();
+		SortedInstances[InstanceIndex] = InstanceIndex;
+	}
+
+	Nodes.AddUninitialized();
+	BuildNode(0, 0, NumInstances, InstanceBoxes, InstanceCenters, MaxInstancesPerLeaf);
+}
+
+void FInstanceClusterTree::BuildNode(int32 NodeIndex, int32 FirstInstance, int32 NumInstances, const TArray<FBox>& InstanceBoxes, const TArray<FVector>& InstanceCenters, int32 MaxInstancesPerLeaf)
+{
+	if (NumInstances <= MaxInstancesPerLeaf)
+	{
+		FBox Bounds(0);
+		for (int32 Index = FirstInstance; Index < FirstInstance + NumInstances; Index++)
+		{
+			Bounds += InstanceBoxes[SortedInstances[Index]];
+		}
+
+		FInstanceClusterNode& Node = Nodes[NodeIndex];
+		Node.BoundMin = Bounds.Min;
+		Node.BoundMax = Bounds.Max;
+		Node.FirstChild = INDEX_NONE;
+		Node.LastChild = INDEX_NONE;
+		Node.FirstInstance = FirstInstance;
+		Node.LastInstance = FirstInstance + NumInstances - 1;
+		return;
+	}
+
+	// Split at the median along the longest axis of the instance centers
+	FBox CenterBounds(0);
+	for (int32 Index = FirstInstance; Index < FirstInstance + NumInstances; Index++)
+	{
+		CenterBounds += InstanceCenters[SortedInstances[Index]];
+	}
+
+	const FVector CenterSize = CenterBounds.GetSize();
+	int32 Axis = 0;
+	if (CenterSize.Y > CenterSize[Axis])
+	{
+		Axis = 1;
+	}
+	if (CenterSize.Z > CenterSize[Axis])
+	{
+		Axis = 2;
+	}
+
+	const int32 NumLeftInstances = NumInstances / 2;
+	SelectNthInstance(&SortedInstances[FirstInstance], NumInstances, NumLeftInstances, InstanceCenters, Axis);
+
+	const int32 FirstChild = Nodes.AddUninitialized(2);
+	BuildNode(FirstChild, FirstInstance, NumLeftInstances, InstanceBoxes, InstanceCenters, MaxInstancesPerLeaf);
+	BuildNode(FirstChild + 1, FirstInstance + NumLeftInstances, NumInstances - NumLeftInstances, InstanceBoxes, InstanceCenters, MaxInstancesPerLeaf);
+
+	// Nodes may have been reallocated by the children
+	FInstanceClusterNode& Node = Nodes[NodeIndex];
+	Node.BoundMin = Nodes[FirstChild].BoundMin.ComponentMin(Nodes[FirstChild + 1].BoundMin);
+	Node.BoundMax = Nodes[FirstChild].BoundMax.ComponentMax(Nodes[FirstChild + 1].BoundMax);
+	Node.FirstChild = FirstChild;
+	Node.LastChild = FirstChild + 1;
+	Node.FirstInstance = FirstInstance;
+	Node.LastInstance = FirstInstance + NumInstances - 1;
+}
+
+void FInstanceClusterTree::TransformBounds(const FMatrix& Transform)
+{
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		FInstanceClusterNode& Node = Nodes[NodeIndex];
+		const FBox Bounds = FBox(Node.BoundMin, Node.BoundMax).TransformBy(Transform);
+		Node.BoundMin = Bounds.Min;
+		Node.BoundMax = Bounds.Max;
+	}
+}
+
+int32 FInstanceClusterTree::Cull(const FInstanceClusterCullParams& Params, TArray<FInstanceClusterRange>* OutRangesPerLOD) const
+{
+	check(Params.NumLODs > 0 && Params.NumLODs <= MAX_STATIC_MESH_LODS);
+
+	if (Nodes.Num() == 0)
+	{
+		return 0;
+	}
+
+	return CullNode(0, Params.Frustum == NULL, Params, OutRangesPerLOD);
+}
+
+int32 FInstanceClusterTree::CullNode(int32 NodeIndex, bool bFullyInsideFrustum, const FInstanceClusterCullParams& Params, TArray<FInstanceClusterRange>* OutRangesPerLOD) const
+{
+	const FInstanceClusterNode& Node = Nodes[NodeIndex];
+	const FVector Center = (Node.BoundMin + Node.BoundMax) * 0.5f;
+	const FVector Extent = (Node.BoundMax - Node.BoundMin) * 0.5f;
+
+	if (!bFullyInsideFrustum && !Params.Frustum->IntersectBox(Center, Extent, bFullyInsideFrustum))
+	{
+		return 0;
+	}
+
+	// Closest and farthest distance of the node's bounds
+	const FVector ToCenter = (Center - Params.ViewOrigin).GetAbs();
+	const FVector ToClosest = (ToCenter - Extent).ComponentMax(FVector::ZeroVector);
+	const FVector ToFarthest = ToCenter + Extent;
+	const float MinDistanceSquared = ToClosest.SizeSquared();
+	const float MaxDistanceSquared = ToFarthest.SizeSquared();
+	const float MaxCullDistanceSquared = (Params.MaxDistance > 0.0f) ? FMath::Square(Params.MaxDistance) : FLT_MAX;
+
+	if (MinDistanceSquared > MaxCullDistanceSquared)
+	{
+		return 0;
+	}
+
+	const int32 NumInstances = Node.LastInstance - Node.FirstInstance + 1;
+	const bool bIsLeaf = (Node.FirstChild == INDEX_NONE);
+
+	if (!bIsLeaf && bFullyInsideFrustum && MaxDistanceSquared <= MaxCullDistanceSquared)
+	{
+		// The whole node is visible, it only has to be split if its instances use different LODs
+		const int32 LODIndex = GetInstanceClusterLOD(Params, MinDistanceSquared);
+		if (LODIndex == GetInstanceClusterLOD(Params, MaxDistanceSquared))
+		{
+			if (LODIndex == INDEX_NONE)
+			{
+				return 0;
+			}
+			AddInstanceClusterRange(OutRangesPerLOD[LODIndex], Node.FirstInstance, NumInstances);
+			return NumInstances;
+		}
+	}
+
+	if (bIsLeaf)
+	{
+		const int32 LODIndex = GetInstanceClusterLOD(Params, (Center - Params.ViewOrigin).SizeSquared());
+		if (LODIndex == INDEX_NONE)
+		{
+			return 0;
+		}
+		AddInstanceClusterRange(OutRangesPerLOD[LODIndex], Node.FirstInstance, NumInstances);
+		return NumInstances;
+	}
+
+	int32 NumVisibleInstances = 0;
+	for (int32 ChildIndex = Node.FirstChild; ChildIndex <= Node.LastChild; ChildIndex++)
+	{
+		NumVisibleInstances += CullNode(ChildIndex, bFullyInsideFrustum, Params, OutRangesPerLOD);
+	}
+	return NumVisibleInstances;
+}
@@ -8,6 +8,7 @@
 #include "ShaderParameters.h"
 #include "EngineComponentClasses.h"
 #include "StaticMeshLight.h"
+#include "InstanceClusterTree.h"
 
 #if WITH_PHYSX
 #include "PhysicsEngine/PhysXSupport.h"
@@ -98,8 +99,9 @@ public:
 	 * Initializes the buffer with the component's data.
 	 * @param InComponent - The owning component
 	 * @param InHitProxies - Array of hit proxies for each instance, if desired.
+	 * @param InInstanceOrder - Indices of the instances in the order they are written to the buffer, empty to keep the component's order.
 	 */
-	void Init(UInstancedStaticMeshComponent* InComponent, const TArray<TRefCountPtr<HHitProxy> >& InHitProxies);
+	void Init(UInstancedStaticMeshComponent* InComponent, const TArray<TRefCountPtr<HHitProxy> >& InHitProxies, const TArray<int32>& InInstanceOrder);
 
 	/** Serializer. */
 	friend FArchive& operator<<(FArchive& Ar, FStaticMeshInstanceBuffer& VertexBuffer);
@@ -163,9 +165,10 @@ void FStaticMeshInstanceBuffer::CleanUp()
  * Initializes the buffer with the component's data.
  * @param InComponent - The owning component
  */
-void FStaticMeshInstanceBuffer::Init(UInstancedStaticMeshComponent* InComponent, const TArray<TRefCountPtr<HHitProxy> >& InHitProxies)
+void FStaticMeshInstanceBuffer::Init(UInstancedStaticMeshComponent* InComponent, const TArray<TRefCountPtr<HHitProxy> >& InHitProxies, const TArray<int32>& InInstanceOrder)
 {
 	NumInstances = InComponent->PerInstanceSMData.Num();
+	check(InInstanceOrder.Num() == 0 || InInstanceOrder.Num() == NumInstances);
 
 	// Allocate the vertex data storage type.
 	AllocateData();
@@ -184,10 +187,19 @@ void FStaticMeshInstanceBuffer::Init(UInstancedStaticMeshComponent* InComponent,
 	// given instance index between reattaches
 	FRandomStream RandomStream( InComponent->InstancingRandomSeed );
 
+	// Draw the random values in component order, so an instance keeps its value whatever order the buffer is in
+	TArray<float> RandomInstanceIDs;
+	RandomInstanceIDs.AddUninitialized(NumInstances);
+	for (uint32 InstanceIndex = 0; InstanceIndex < NumInstances; InstanceIndex++)
+	{
+		RandomInstanceIDs[InstanceIndex] = RandomInstanceIDBase + RandomStream.GetFraction() * RandomInstanceIDRange;
+	}
+
 	FMatrix LocalToWorld = InComponent->GetComponentToWorld().ToMatrixWithScale();
 
-	for (uint32 InstanceIndex = 0; InstanceIndex < NumInstances; InstanceIndex++)
+	for (uint32 BufferIndex = 0; BufferIndex < NumInstances; BufferIndex++)
 	{
+		const uint32 InstanceIndex = InInstanceOrder.Num() ? InInstanceOrder[BufferIndex] : BufferIndex;
 		const FInstancedStaticMeshInstanceData& Instance = InComponent->PerInstanceSMData[InstanceIndex];
 
 		// X, Y	: Shadow map UV bias
@@ -230,7 +242,7 @@ void FStaticMeshInstanceBuffer::Init(UInstancedStaticMeshComponent* InComponent,
 			// Invert the instance -> world matrix
 			const FMatrix WorldToInstance = InstanceToWorld.Inverse();
 
-			const float RandomInstanceID = RandomInstanceIDBase + RandomStream.GetFraction() * RandomInstanceIDRange;
+			const float RandomInstanceID = RandomInstanceIDs[InstanceIndex];
 
 			// hide the offset (bias) of the lightmap and the per-instance random id in the matrix's w
 			const FMatrix Transpose = WorldToInstance.GetTransposed();
@@ -304,6 +316,9 @@ struct FInstancingUserData
 
 	bool bRenderSelected;
 	bool bRenderUnselected;
+
+	/** If true, every mesh batch element draws its NumInstances instances starting at instance UserIndex of the instance buffer. */
+	bool bRenderInstanceRanges;
 };
 
 /**
@@ -354,6 +369,16 @@ public:
 	 */
 	void Copy(const FInstancedStaticMeshVertexFactory& Other);
 
+	/**
+	 * Makes the instance stream start at an instance, so a range of the instances can be drawn. Call after the vertex factory was set.
+	 * @param FirstInstance - The instance to start at
+	 */
+	void SetInstanceOffset(uint32 FirstInstance) const
+	{
+		const FVertexStreamComponent& InstanceComponent = Data.InstancedShadowMapBiasComponent;
+		RHISetStreamSource(InstanceStreamIndex, InstanceComponent.VertexBuffer->VertexBufferRHI, InstanceComponent.Stride, FirstInstance * InstanceComponent.Stride);
+	}
+
 	// FRenderResource interface.
 	virtual void InitRHI();
 
@@ -361,6 +386,9 @@ public:
 
 private:
 	DataType Data;
+
+	/** The instance buffer is the first stream of both the position only and the full declaration. */
+	static const uint32 InstanceStreamIndex = 0;
 };
 
 
@@ -399,16 +427,29 @@ void FInstancedStaticMeshVertexFactory::InitRHI()
 	if(Data.PositionComponent.VertexBuffer != Data.TangentBasisComponents[0].VertexBuffer)
 	{
 		FVertexDeclarationElementList PositionOnlyStreamElements;
-		PositionOnlyStreamElements.Add(AccessPositionStreamComponent(Data.PositionComponent,0));
 
-		// toss in the instanced location stream
+		// toss in the instanced location stream, first so it gets InstanceStreamIndex
 		PositionOnlyStreamElements.Add(AccessPositionStreamComponent(Data.InstancedTransformComponent[0],9));
 		PositionOnlyStreamElements.Add(AccessPositionStreamComponent(Data.InstancedTransformComponent[1],10));
 		PositionOnlyStreamElements.Add(AccessPositionStreamComponent(Data.InstancedTransformComponent[2],11));
+		check(PositionOnlyStreamElements[0].StreamIndex == InstanceStreamIndex);
+
+		PositionOnlyStreamElements.Add(AccessPositionStreamComponent(Data.PositionComponent,0));
 		InitPositionDeclaration(PositionOnlyStreamElements);
 	}
 
 	FVertexDeclarationElementList Elements;
+
+	// toss in the instanced location stream, first so it gets InstanceStreamIndex
+	Elements.Add(AccessStreamComponent(Data.InstancedShadowMapBiasComponent,8));
+	Elements.Add(AccessStreamComponent(Data.InstancedTransformComponent[0],9));
+	Elements.Add(AccessStreamComponent(Data.InstancedTransformComponent[1],10));
+	Elements.Add(AccessStreamComponent(Data.InstancedTransformComponent[2],11));
+ 	Elements.Add(AccessStreamComponent(Data.InstancedInverseTransformComponent[0],12));
+ 	Elements.Add(AccessStreamComponent(Data.InstancedInverseTransformComponent[1],13));
+ 	Elements.Add(AccessStreamComponent(Data.InstancedInverseTransformComponent[2],14));
+	check(Elements[0].StreamIndex == InstanceStreamIndex);
+
 	if(Data.PositionComponent.VertexBuffer != NULL)
 	{
 		Elements.Add(AccessStreamComponent(Data.PositionComponent,0));
@@ -465,15 +506,6 @@ void FInstancedStaticMeshVertexFactory::InitRHI()
 		Elements.Add(AccessStreamComponent(Data.TextureCoordinates[0],15));
 	}
 
-	// toss in the instanced location stream
-	Elements.Add(AccessStreamComponent(Data.InstancedShadowMapBiasComponent,8));
-	Elements.Add(AccessStreamComponent(Data.InstancedTransformComponent[0],9));
-	Elements.Add(AccessStreamComponent(Data.InstancedTransformComponent[1],10));
-	Elements.Add(AccessStreamComponent(Data.InstancedTransformComponent[2],11));
- 	Elements.Add(AccessStreamComponent(Data.InstancedInverseTransformComponent[0],12));
- 	Elements.Add(AccessStreamComponent(Data.InstancedInverseTransformComponent[1],13));
- 	Elements.Add(AccessStreamComponent(Data.InstancedInverseTransformComponent[2],14));
-
 	// we don't need per-vertex shadow or lightmap rendering
 	InitDeclaration(Elements,Data);
 }
@@ -527,6 +559,12 @@ class FInstancedStaticMeshVertexFactoryShaderParameters : public FVertexFactoryS
 			}
 			SetShaderValue( VertexShader->GetVertexShader(), InstancingFadeOutParamsParameter, InstancingFadeOutParams );
 		}
+
+		const FInstancingUserData* InstancingUserData = (FInstancingUserData*)BatchElement.UserData;
+		if (InstancingUserData && InstancingUserData->bRenderInstanceRanges)
+		{
+			((const FInstancedStaticMeshVertexFactory*)VertexFactory)->SetInstanceOffset(BatchElement.UserIndex);
+		}
 	}
 
 	void Serialize(FArchive& Ar)
@@ -560,7 +598,7 @@ class FInstancedStaticMeshRenderData
 {
 public:
 
-	FInstancedStaticMeshRenderData(UInstancedStaticMeshComponent* InComponent)
+	FInstancedStaticMeshRenderData(UInstancedStaticMeshComponent* InComponent, const TArray<int32>& InInstanceOrder)
 	  : Component(InComponent)
 	  , LODModels(Component->StaticMesh->RenderData->LODResources)
 	{
@@ -580,7 +618,7 @@ public:
 		}
 
 		// initialize the instance buffer from the component's instances
-		InstanceBuffer.Init(Component, HitProxies);
+		InstanceBuffer.Init(Component, HitProxies, InInstanceOrder);
 		InitResources();
 	}
 
@@ -794,9 +832,13 @@ class FInstancedStaticMeshSceneProxy : public FStaticMeshSceneProxy
 {
 public:
 
-	FInstancedStaticMeshSceneProxy(UInstancedStaticMeshComponent* InComponent)
+	/**
+	 * @param InComponent - The component
+	 * @param InInstanceOrder - Order of the instances in the instance buffer, empty for the component's order
+	 */
+	FInstancedStaticMeshSceneProxy(UInstancedStaticMeshComponent* InComponent, const TArray<int32>& InInstanceOrder = TArray<int32>())
 	:	FStaticMeshSceneProxy(InComponent)
-	,	InstancedRenderData(InComponent)
+	,	InstancedRenderData(InComponent, InInstanceOrder)
 #if WITH_EDITOR
 	,	bHasSelectedInstances(InComponent->SelectedInstances.Num() > 0)
 #else
@@ -845,6 +887,7 @@ public:
 		UserData_AllInstances.EndCullDistance = InComponent->InstanceEndCullDistance;
 		UserData_AllInstances.bRenderSelected = true;
 		UserData_AllInstances.bRenderUnselected = true;
+		UserData_AllInstances.bRenderInstanceRanges = false;
 
 		// selected only
 		UserData_SelectedInstances = UserData_AllInstances;
@@ -941,7 +984,7 @@ public:
 		}
 	}
 
-private:
+protected:
 
 	/** Array of per-instance static mesh rendering data for the scene proxy */
 	TArray< FInstancedStaticMeshSceneProxyInstanceData > PerInstanceSMData;
@@ -1045,6 +1088,196 @@ bool FInstancedStaticMeshSceneProxy::GetWireframeMeshElement(int32 LODIndex, con
 	return false;
 }
 
+/*-----------------------------------------------------------------------------
+	FHierarchicalInstancedStaticMeshSceneProxy
+-----------------------------------------------------------------------------*/
+
+/**
+ * Instanced static mesh proxy that culls a cluster tree per view and draws the visible ranges of instances at their LOD.
+ * The instance buffer is in the tree's order, so every visible range is one mesh batch element.
+ */
+class FHierarchicalInstancedStaticMeshSceneProxy : public FInstancedStaticMeshSceneProxy
+{
+public:
+
+	/**
+	 * @param InComponent - The component
+	 * @param InClusterTree - Cluster tree over the component's instances, in component space
+	 */
+	FHierarchicalInstancedStaticMeshSceneProxy(UHierarchicalInstancedStaticMeshComponent* InComponent, const FInstanceClusterTree& InClusterTree)
+	:	FInstancedStaticMeshSceneProxy(InComponent, InClusterTree.SortedInstances)
+	,	ClusterTree(InClusterTree)
+	{
+		ClusterTree.TransformBounds(InComponent->GetComponentToWorld().ToMatrixWithScale());
+
+		// The instance buffer is already in tree order, culling only needs the nodes
+		ClusterTree.SortedInstances.Empty();
+
+		UserData_AllInstances.bRenderInstanceRanges = true;
+		UserData_SelectedInstances.bRenderInstanceRanges = true;
+		UserData_DeselectedInstances.bRenderInstanceRanges = true;
+	}
+
+	// FPrimitiveSceneProxy interface.
+
+	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) OVERRIDE
+	{
+		FPrimitiveViewRelevance Result = FInstancedStaticMeshSceneProxy::GetViewRelevance(View);
+
+		// Clusters are culled per view, so nothing goes to the static draw lists
+		Result.bDynamicRelevance = Result.bDynamicRelevance || Result.bStaticRelevance;
+		Result.bStaticRelevance = false;
+		return Result;
+	}
+
+	virtual void DrawStaticElements(FStaticPrimitiveDrawInterface* PDI) OVERRIDE
+	{
+	}
+
+	virtual void DrawDynamicElements(FPrimitiveDrawInterface* PDI,const FSceneView* View) OVERRIDE
+	{
+		DrawDynamicElements(PDI, View, 0);
+	}
+
+	virtual void DrawDynamicElements(FPrimitiveDrawInterface* PDI,const FSceneView* View, uint32 DrawDynamicFlags) OVERRIDE;
+
+private:
+
+	/** Fills in the cull parameters of a view. */
+	void GetCullParams(const FSceneView* View, uint32 DrawDynamicFlags, FInstanceClusterCullParams& OutParams) const;
+
+	/** Cluster tree over the instances, in world space. */
+	FInstanceClusterTree ClusterTree;
+};
+
+void FHierarchicalInstancedStaticMeshSceneProxy::GetCullParams(const FSceneView* View, uint32 DrawDynamicFlags, FInstanceClusterCullParams& OutParams) const
+{
+	const int32 NumLODs = FMath::Min(RenderData->LODResources.Num(), InstancedRenderData.VertexFactories.Num());
+
+	// Shadow depths are drawn with the camera's view, instances outside of its frustum can still cast shadows into it
+	OutParams.Frustum = (DrawDynamicFlags & EDrawDynamicFlags::ShadowDepth) ? NULL : &View->ViewFrustum;
+
+	// Note: These distance calculations must match up with FStaticMeshSceneProxy::GetLOD
+#if !WITH_EDITOR
+	OutParams.ViewOrigin = View->ViewMatrices.ViewOrigin;
+#else
+	OutParams.ViewOrigin = View->IsPerspectiveProjection() ? View->ViewMatrices.ViewOrigin : View->OverrideLODViewOrigin;
+#endif
+	OutParams.MaxDistance = UserData_AllInstances.EndCullDistance;
+
+	// Scale the LOD distances instead of every instance's distance
+	OutParams.NumLODs = NumLODs;
+	for (int32 LODIndex = 0; LODIndex < NumLODs; LODIndex++)
+	{
+		OutParams.LODDistances[LODIndex] = GetMinLODDist(LODIndex) / View->LODDistanceFactor;
+	}
+	OutParams.LODDistances[NumLODs] = GetMaxLODDist(NumLODs - 1) / View->LODDistanceFactor;
+
+	const int32 CVarForcedLODLevel = GetCVarForceLOD();
+	if (DrawDynamicFlags & EDrawDynamicFlags::ForceLowestLOD)
+	{
+		OutParams.ForcedLOD = NumLODs - 1;
+	}
+	else if (CVarForcedLODLevel >= 0)
+	{
+		OutParams.ForcedLOD = FMath::Clamp<int32>(CVarForcedLODLevel, 0, NumLODs - 1);
+	}
+	else if (ForcedLodModel > 0)
+	{
+		OutParams.ForcedLOD = FMath::Clamp(ForcedLodModel, 1, NumLODs) - 1;
+	}
+#if WITH_EDITOR
+	else if (View->Family && View->Family->EngineShowFlags.LOD == 0)
+	{
+		OutParams.ForcedLOD = 0;
+	}
+#endif
+}
+
+void FHierarchicalInstancedStaticMeshSceneProxy::DrawDynamicElements(FPrimitiveDrawInterface* PDI,const FSceneView* View, uint32 DrawDynamicFlags)
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_HierarchicalInstancedStaticMeshSceneProxy_DrawDynamicElements );
+
+	FInstanceClusterCullParams CullParams;
+	GetCullParams(View, DrawDynamicFlags, CullParams);
+
+	TArray<FInstanceClusterRange> RangesPerLOD[MAX_STATIC_MESH_LODS];
+	if (ClusterTree.Cull(CullParams, RangesPerLOD) == 0)
+	{
+		return;
+	}
+
+#if WITH_EDITOR
+	const bool bSelectionRenderEnabled = GIsEditor && View->Family->EngineShowFlags.Selection;
+
+	// If the first pass rendered selected instances only, we need to render the deselected instances in a second pass
+	const int32 NumPasses = (bSelectionRenderEnabled && bHasSelectedInstances && !PDI->IsRenderingSelectionOutline()) ? 2 : 1;
+
+	FInstancingUserData* PassUserData[2] =
+	{
+		bHasSelectedInstances && bSelectionRenderEnabled ? &UserData_SelectedInstances : &UserData_AllInstances,
+		&UserData_DeselectedInstances
+	};
+
+	bool PassRenderSelection[2] = 
+	{
+		bSelectionRenderEnabled && IsSelected(),
+		false
+	};
+#else
+	const int32 NumPasses = 1;
+	FInstancingUserData* PassUserData[1] = { &UserData_AllInstances };
+	bool PassRenderSelection[1] = { false };
+#endif
+
+	const FLinearColor UtilColor( LevelColor );
+	const bool bIsWireframe = View->Family->EngineShowFlags.Wireframe;
+
+	for( int32 Pass=0;Pass < NumPasses; Pass++ )
+	{
+		for (int32 LODIndex = 0; LODIndex < CullParams.NumLODs; LODIndex++)
+		{
+			const TArray<FInstanceClusterRange>& Ranges = RangesPerLOD[LODIndex];
+			if (Ranges.Num() == 0)
+			{
+				continue;
+			}
+
+			const FStaticMeshLODResources& LODModel = RenderData->LODResources[LODIndex];
+
+			for(int32 SectionIndex = 0;SectionIndex < LODModel.Sections.Num();SectionIndex++)
+			{
+				FMeshBatch MeshElement;
+				if(GetMeshElement(LODIndex,SectionIndex,GetDepthPriorityGroup(View), MeshElement, PassRenderSelection[Pass], IsHovered()))
+				{
+					// One element per visible range of instances
+					const FMeshBatchElement SectionElement = MeshElement.Elements[0];
+					MeshElement.Elements.Empty(Ranges.Num());
+					for (int32 RangeIndex = 0; RangeIndex < Ranges.Num(); RangeIndex++)
+					{
+						FMeshBatchElement& BatchElement = *new(MeshElement.Elements) FMeshBatchElement(SectionElement);
+						BatchElement.UserData = PassUserData[Pass];
+						BatchElement.UserIndex = Ranges[RangeIndex].FirstInstance;
+						BatchElement.NumInstances = Ranges[RangeIndex].NumInstances;
+					}
+
+					const int32 NumCalls = DrawRichMesh(
+						PDI,
+						MeshElement,
+						WireframeColor,
+						UtilColor,
+						PropertyColor,
+						this,
+						PassRenderSelection[Pass],
+						bIsWireframe
+						);
+					INC_DWORD_STAT_BY(STAT_StaticMeshTriangles,MeshElement.GetNumPrimitives() * NumCalls);
+				}
+			}
+		}
+	}
+}
+
 /*-----------------------------------------------------------------------------
 	FInstancedStaticMeshStaticLightingTextureMapping
 -----------------------------------------------------------------------------*/
@@ -1474,3 +1707,56 @@ void UInstancedStaticMeshComponent::SelectInstance(bool bInSelected, int32 InIns
 	}
 #endif
 }
+
+/*-----------------------------------------------------------------------------
+	UHierarchicalInstancedStaticMeshComponent
+-----------------------------------------------------------------------------*/
+
+UHierarchicalInstancedStaticMeshComponent::UHierarchicalInstancedStaticMeshComponent(const class FPostConstructInitializeProperties& PCIP)
+	: Super(PCIP)
+	, MaxInstancesPerLeaf(16)
+{
+}
+
+void UHierarchicalInstancedStaticMeshComponent::BuildClusterTree(FInstanceClusterTree& OutClusterTree) const
+{
+	check(StaticMesh);
+	const FBoxSphereBounds MeshBounds = StaticMesh->GetBounds();
+
+	TArray<FBox> InstanceBoxes;
+	InstanceBoxes.AddUninitialized(PerInstanceSMData.Num());
+	for (int32 InstanceIndex = 0; InstanceIndex < PerInstanceSMData.Num(); InstanceIndex++)
+	{
+		InstanceBoxes[InstanceIndex] = MeshBounds.TransformBy(PerInstanceSMData[InstanceIndex].Transform).GetBox();
+	}
+
+	OutClusterTree.Build(InstanceBoxes, MaxInstancesPerLeaf);
+}
+
+FPrimitiveSceneProxy* UHierarchicalInstancedStaticMeshComponent::CreateSceneProxy()
+{
+	// We don't support instancing on ES2
+	if (GRHIFeatureLevel == ERHIFeatureLevel::ES2)
+	{
+		return NULL;
+	}
+
+	if (PerInstanceSMData.Num() > 0 && StaticMesh && StaticMesh->HasValidRenderData())
+	{
+		// Used by the PerInstanceRandom material expression, see UInstancedStaticMeshComponent::CreateSceneProxy
+		while( InstancingRandomSeed == 0 )
+		{
+			InstancingRandomSeed = FMath::Rand();
+		}
+
+		// The tree is rebuilt whenever the render state is, just like the instance buffer
+		FInstanceClusterTree ClusterTree;
+		BuildClusterTree(ClusterTree);
+
+		return ::new FHierarchicalInstancedStaticMeshSceneProxy(this, ClusterTree);
+	}
+	else
+	{
+		return NULL;
+	}
+}
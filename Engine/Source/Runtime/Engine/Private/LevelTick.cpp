@@ -77,6 +77,7 @@ DEFINE_STAT(STAT_NetPrioritizeActorsTime);
 DEFINE_STAT(STAT_NetReplicateActorsTime);
 DEFINE_STAT(STAT_NetReplicateDynamicPropTime);
 DEFINE_STAT(STAT_NetSkippedDynamicProps);
+DEFINE_STAT(STAT_NetSharedChangelistTime);
 DEFINE_STAT(STAT_NetSerializeItemDeltaTime);
 DEFINE_STAT(STAT_NetReplicateStaticPropTime);
 DEFINE_STAT(STAT_NetBroadcastPostTickTime);
@@ -695,6 +696,12 @@ void UWorld::RunTickGroup(ETickingGroup Group, bool bBlockTillComplete = true)
 	TickGroup = ETickingGroup(TickGroup + 1); // new actors go into the next tick group because this one is already gone
 }
 
+static TAutoConsoleVariable<float> CVarIncrementalGCMarkTimeLimit(
+	TEXT("IncrementalGCMarkTimeLimit"),
+	0.0f,
+	TEXT("Time in ms the garbage collector may spend per frame on finding reachable objects, spreading it over several frames.\n")
+	TEXT("0 finds them in one go (default). The frame that finishes a collection only processes the root set and objects created in between again, on the GC worker threads."));
+
 static TAutoConsoleVariable<int32> CVarAllowAsyncRenderThreadUpdates(
 	TEXT("AllowAsyncRenderThreadUpdates"),
 	EXPERIMENTAL_PARALLEL_CODE ? 1 : 0,
@@ -1089,6 +1096,11 @@ void UWorld::Tick( ELevelTick TickType, float DeltaSeconds )
 			SCOPE_CYCLE_COUNTER(STAT_NavWorldTickTime);
 			NavigationSystem->Tick(DeltaSeconds);
 		}
+
+		if (AvoidanceManager != NULL)
+		{
+			AvoidanceManager->UpdateBatchedAvoidance();
+		}
 	}
 
 	bool bDoingActorTicks = 
@@ -1309,13 +1321,19 @@ void UWorld::Tick( ELevelTick TickType, float DeltaSeconds )
 		{
 			bShouldDelayGarbageCollect = false;
 		}
+		// Continue an incremental garbage collection started on an earlier frame.
+		else if( IsIncrementalReachabilityAnalysisPending() )
+		{
+			SCOPE_CYCLE_COUNTER(STAT_GCMarkTime);
+			PerformIncrementalGarbageCollection( CVarIncrementalGCMarkTimeLimit.GetValueOnGameThread() / 1000.0f );
+		}
 		// Perform incremental purge update if it's pending or in progress.
 		else if( !IsIncrementalPurgePending() 
 		// Purge reference to pending kill objects every now and so often.
 		&&	(TimeSinceLastPendingKillPurge > TimeBetweenPurgingPendingKillObjects) && TimeBetweenPurgingPendingKillObjects > 0 )
 		{
 			SCOPE_CYCLE_COUNTER(STAT_GCMarkTime);
-			PerformGarbageCollection();
+			PerformIncrementalGarbageCollection( CVarIncrementalGCMarkTimeLimit.GetValueOnGameThread() / 1000.0f );
 		}
 		else
 		{
@@ -1391,13 +1409,32 @@ void UWorld::DelayGarbageCollection()
  *  Interface to allow WorldSettings to request immediate garbage collection
  */
 void UWorld::PerformGarbageCollection()
+{
+	PerformIncrementalGarbageCollection( 0.0f );
+}
+
+/**
+ *  Performs part of a garbage collection, cleaning up like PerformGarbageCollection once it has finished
+ */
+void UWorld::PerformIncrementalGarbageCollection( float MarkTimeLimit )
 {
 	// We don't collect garbage while there are outstanding async load requests as we would need
 	// to block on loading the remaining data.
 	if( !IsAsyncLoading() )
 	{
 		// Perform housekeeping.
-		CollectGarbage( GARBAGE_COLLECTION_KEEPFLAGS, false );
+		if( MarkTimeLimit > 0.0f || IsIncrementalReachabilityAnalysisPending() )
+		{
+			// A time limit of 0 finishes a pending collection.
+			if( !IncrementalCollectGarbage( GARBAGE_COLLECTION_KEEPFLAGS, MarkTimeLimit ) )
+			{
+				return;
+			}
+		}
+		else
+		{
+			CollectGarbage( GARBAGE_COLLECTION_KEEPFLAGS, false );
+		}
 
 		// Remove NULL entries from actor list. Only does so for dynamic actors to avoid resorting; in theory static 
 		// actors shouldn't be deleted during gameplay.
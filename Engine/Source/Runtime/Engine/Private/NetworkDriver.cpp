@@ -1593,6 +1593,269 @@ static FAutoConsoleVariableRef CVarNetRemoteRoleOnCloseTest(
 	);
 
 
+static TAutoConsoleVariable<int32> CVarNetParallelRelevancy(
+	TEXT("net.ParallelRelevancy"),
+	0,
+	TEXT("Number of task graph tasks ServerReplicateActors spreads relevancy and priority checks for the connections over, 1 or less checks them on the game thread.\n")
+	TEXT("IsNetRelevantFor, GetNetPriority and GetNetDormancy overrides have to be safe to call from several threads at once when this is used, ")
+	TEXT("and AWorldSettings::ReplicationViewers isn't set to the connection being prioritized."),
+	ECVF_Default
+	);
+
+/** Relevant actors of one connection sorted by priority, the output of the prioritization stage of ServerReplicateActors */
+struct FConnectionPrioritization
+{
+	/** Connection to prioritize for, NULL if the connection isn't updated this frame */
+	UNetConnection*				Connection;
+	/** Viewers of the connection and its children */
+	TArray<FNetViewer>			Viewers;
+	bool						bLowNetBandwidth;
+	/** Relevant actors and deletion entries */
+	TArray<FActorPriority>		PriorityList;
+	/** Entries of PriorityList sorted by priority */
+	TArray<FActorPriority*>		PriorityActors;
+	/** Channels that should start becoming dormant, this is done on the game thread after prioritizing */
+	TArray<UActorChannel*>		ChannelsToStartDormancy;
+	int32						DeletedCount;
+
+	FConnectionPrioritization()
+		: Connection(NULL)
+		, bLowNetBandwidth(false)
+		, DeletedCount(0)
+	{
+	}
+};
+
+/** Pulls connections to prioritize until all are done, several of these run at once on task graph workers */
+struct FParallelConnectionPrioritization
+{
+	UNetDriver*								NetDriver;
+	TArray<FConnectionPrioritization>*		Prioritizations;
+	AActor**								ConsiderList;
+	int32									ConsiderListSize;
+	bool									bDormancyEnabled;
+	FThreadSafeCounter						NextIndex;
+
+	void Run()
+	{
+		for (int32 Index = NextIndex.Increment() - 1; Index < Prioritizations->Num(); Index = NextIndex.Increment() - 1)
+		{
+			FConnectionPrioritization& Prioritization = (*Prioritizations)[Index];
+			if (Prioritization.Connection != NULL)
+			{
+				NetDriver->ServerReplicateActors_PrioritizeActors(Prioritization, ConsiderList, ConsiderListSize, bDormancyEnabled, false);
+			}
+		}
+	}
+};
+
+void UNetDriver::ServerReplicateActors_PrioritizeActors(FConnectionPrioritization& Prioritization, AActor** ConsiderList, int32 ConsiderListSize, bool bDormancyEnabled, bool bValidateDormancy)
+{
+	UNetConnection* Connection = Prioritization.Connection;
+	const TArray<FNetViewer>& ConnectionViewers = Prioritization.Viewers;
+	const bool bLowNetBandwidth = Prioritization.bLowNetBandwidth;
+
+	Prioritization.PriorityList.Reset();
+	Prioritization.PriorityActors.Reset();
+	Prioritization.ChannelsToStartDormancy.Reset();
+	Prioritization.DeletedCount = 0;
+
+	// Actors that are already in the list or were sent as temporaries are skipped
+	// This is tracked per connection rather than with AActor::NetTag so connections can be prioritized at the same time
+	TSet<AActor*> SkipActors;
+	for (int32 j = 0; j < Connection->SentTemporaries.Num(); j++)
+	{
+		SkipActors.Add(Connection->SentTemporaries[j]);
+	}
+
+	// Reserve everything up front, PriorityActors points into PriorityList
+	int32 MaxCount = ConsiderListSize + Connection->DestroyedStartupOrDormantActors.Num() + Connection->OwnedConsiderListSize;
+	for (int32 ChildIdx = 0; ChildIdx < Connection->Children.Num(); ChildIdx++)
+	{
+		MaxCount += Connection->Children[ChildIdx]->OwnedConsiderListSize;
+	}
+	Prioritization.PriorityList.Reserve(MaxCount);
+
+	for (int32 j = 0; j < ConsiderListSize; j++)
+	{
+		AActor* Actor = ConsiderList[j];
+		UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
+
+		// Skip Actor if dormant
+		if ( bDormancyEnabled )
+		{
+			// If actor is already dormant on this channel, then skip replication entirely
+			if ( Connection->DormantActors.Contains( Actor ) )
+			{
+				// net.DormancyValidate can be set to 2 to validate dormant actor properties on every replicate
+				// (this could be moved to be done every tick instead of every net update if necessary, but seems excessive)
+				if ( bValidateDormancy )
+				{
+					TSharedRef< FObjectReplicator > * Replicator = Connection->DormantReplicatorMap.Find( Actor );
+
+					if ( Replicator != NULL )
+					{
+						Replicator->Get().ValidateAgainstState( Actor );
+					}
+				}
+
+				continue;
+			}
+
+			// If actor might need to go dormant on this channel, then check
+			if (Actor->NetDormancy > DORM_Awake && Channel && !Channel->bPendingDormancy && !Channel->Dormant )
+			{
+				bool ShouldGoDormant = true;
+				if (Actor->NetDormancy == DORM_DormantPartial)
+				{
+					float Time  = Channel ? (Connection->Driver->Time - Channel->LastUpdateTime) : Connection->Driver->SpawnPrioritySeconds;
+					for (int32 viewerIdx = 0; viewerIdx < ConnectionViewers.Num(); viewerIdx++)
+					{
+						if (!Actor->GetNetDormancy(ConnectionViewers[viewerIdx].ViewLocation, ConnectionViewers[viewerIdx].ViewDir, ConnectionViewers[viewerIdx].InViewer, Channel, Time, bLowNetBandwidth))
+						{
+							ShouldGoDormant = false;
+							break;
+						}
+					}
+				}
+
+				if (ShouldGoDormant)
+				{
+					Prioritization.ChannelsToStartDormancy.Add(Channel);
+				}
+			}
+		}
+
+		const bool bLevelInitializedForActor = Connection->ClientWorldPackageName == Actor->GetWorld()->GetOutermost()->GetFName() && Connection->ClientHasInitializedLevelFor( Actor );
+
+		// Skip actor if not relevant and theres no channel already.
+		// Historically Relevancy checks were deferred until after prioritization because they were expensive (line traces).
+		// Relevancy is now cheap and we are dealing with larger lists of considered actors, so we want to keep the list of
+		// prioritized actors low.
+		if (!Channel)
+		{
+			if ( !bLevelInitializedForActor )
+			{
+				// If the level this actor belongs to isn't loaded on client, don't bother sending
+				continue;
+			}
+			bool Relevant = false;
+			for (int32 viewerIdx = 0; viewerIdx < ConnectionViewers.Num(); viewerIdx++)
+			{
+				if(Actor->IsNetRelevantFor(ConnectionViewers[viewerIdx].InViewer, ConnectionViewers[viewerIdx].Viewer, ConnectionViewers[viewerIdx].ViewLocation))
+				{
+					Relevant = true;
+					break;
+				}
+			}
+			if (!Relevant)
+			{
+				continue;
+			}
+		}
+
+		if( SkipActors.Num() == 0 || !SkipActors.Contains(Actor) ) // Do not consider actor for this connection if it was sent as a temporary
+		{
+			UE_LOG(LogNetTraffic, Log, TEXT("Consider %s alwaysrelevant %d frequency %f "),*Actor->GetName(), Actor->bAlwaysRelevant, Actor->NetUpdateFrequency);
+			new(Prioritization.PriorityList) FActorPriority(Connection, Channel, Actor, ConnectionViewers, bLowNetBandwidth);
+		}
+	}
+
+	// Add in deleted actors
+	for (auto It = Connection->DestroyedStartupOrDormantActors.CreateConstIterator(); It; ++It)
+	{
+		FActorDestructionInfo &DInfo = DestroyedStartupOrDormantActors.FindChecked(*It);
+		new(Prioritization.PriorityList) FActorPriority(Connection, &DInfo, ConnectionViewers);
+		Prioritization.DeletedCount++;
+	}
+
+	UNetConnection* NextConnection = Connection;
+	int32 ChildIndex = 0;
+	while (NextConnection != NULL)
+	{
+		for (int32 j = 0; j < NextConnection->OwnedConsiderListSize; j++)
+		{
+			AActor* Actor = NextConnection->OwnedConsiderList[j];
+			UE_LOG(LogNetTraffic, Log, TEXT("Consider owned %s always relevant %d frequency %f  "),*Actor->GetName(), Actor->bAlwaysRelevant,Actor->NetUpdateFrequency);
+			if (!SkipActors.Contains(Actor))
+			{
+				UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
+				SkipActors.Add(Actor);
+				new(Prioritization.PriorityList) FActorPriority(NextConnection, Channel, Actor, ConnectionViewers, bLowNetBandwidth);
+			}
+		}
+
+		NextConnection = (ChildIndex < Connection->Children.Num()) ? Connection->Children[ChildIndex++] : NULL;
+	}
+
+	check(Prioritization.PriorityList.Num() <= MaxCount);
+
+	Prioritization.PriorityActors.Reserve(Prioritization.PriorityList.Num());
+	for (int32 j = 0; j < Prioritization.PriorityList.Num(); j++)
+	{
+		Prioritization.PriorityActors.Add(&Prioritization.PriorityList[j]);
+	}
+
+	// Sort by priority
+	struct FCompareFActorPriority
+	{
+		FORCEINLINE bool operator()( const FActorPriority& A, const FActorPriority& B ) const
+		{
+			return B.Priority < A.Priority;
+		}
+	};
+	Sort( Prioritization.PriorityActors.GetTypedData(), Prioritization.PriorityActors.Num(), FCompareFActorPriority() );
+}
+
+void UNetDriver::ServerReplicateActors_PrioritizeConnections(TArray<FConnectionPrioritization>& Prioritizations, AActor** ConsiderList, int32 ConsiderListSize, int32 NumTasks)
+{
+	SCOPE_CYCLE_COUNTER(STAT_NetPrioritizeActorsTime);
+	check(IsInGameThread());
+
+	static const auto DormancyCVar = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("net.DormancyEnable"));
+	const bool bDormancyEnabled = !DormancyCVar || DormancyCVar->GetValueOnGameThread() == 1;
+
+	static const auto ValidateCVar = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("net.DormancyValidate"));
+	const bool bValidateDormancy = ValidateCVar && ValidateCVar->GetValueOnGameThread() == 2;
+
+	// Validating dormant actors isn't thread safe
+	if (NumTasks <= 1 || bValidateDormancy || Prioritizations.Num() <= 1)
+	{
+		for (int32 Index = 0; Index < Prioritizations.Num(); Index++)
+		{
+			UNetConnection* Connection = Prioritizations[Index].Connection;
+			if (Connection != NULL)
+			{
+				// set the replication viewers to the current connection (and children) so that actors can determine who is currently being considered for relevancy checks
+				Connection->OwningActor->GetWorld()->GetWorldSettings()->ReplicationViewers = Prioritizations[Index].Viewers;
+				ServerReplicateActors_PrioritizeActors(Prioritizations[Index], ConsiderList, ConsiderListSize, bDormancyEnabled, bValidateDormancy);
+			}
+		}
+		return;
+	}
+
+	FParallelConnectionPrioritization Parallel;
+	Parallel.NetDriver			= this;
+	Parallel.Prioritizations	= &Prioritizations;
+	Parallel.ConsiderList		= ConsiderList;
+	Parallel.ConsiderListSize	= ConsiderListSize;
+	Parallel.bDormancyEnabled	= bDormancyEnabled;
+
+	// The game thread does its share too instead of just waiting
+	FGraphEventArray Tasks;
+	for (int32 TaskIndex = 1; TaskIndex < FMath::Min(NumTasks, Prioritizations.Num()); TaskIndex++)
+	{
+		new (Tasks) FGraphEventRef(FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
+			FSimpleDelegateGraphTask::FDelegate::CreateRaw(&Parallel, &FParallelConnectionPrioritization::Run),
+			TEXT("Prioritize Connections"),
+			NULL,
+			ENamedThreads::AnyThread
+			));
+	}
+	Parallel.Run();
+	FTaskGraphInterface::Get().WaitUntilTasksComplete(Tasks, ENamedThreads::GameThread);
+}
+
 int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 {
 	SCOPE_CYCLE_COUNTER(STAT_NetServerRepActorsTime);
@@ -1892,6 +2155,57 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 	SET_DWORD_STAT(STAT_NumInitiallyDormantActors,NumInitiallyDormant);
 	SET_DWORD_STAT(STAT_NumConsideredActors,ConsiderListSize);
 
+	// Set up the connections that are ticked this frame, the viewers trace against the world so this stays on the game thread
+	TArray<FConnectionPrioritization> Prioritizations;
+	Prioritizations.Empty(NumClientsToTick);
+	for( int32 i=0; i < NumClientsToTick; i++ )
+	{
+		UNetConnection* Connection = ClientConnections[i];
+		FConnectionPrioritization& Prioritization = *new(Prioritizations) FConnectionPrioritization();
+		if (!Connection->Viewer)
+		{
+			continue;
+		}
+		Prioritization.Connection = Connection;
+
+		// send ClientAdjustment if necessary
+		// we do this here so that we send a maximum of one per packet to that client; there is no value in stacking additional corrections
+		if (Connection->PlayerController)
+		{
+			Connection->PlayerController->SendClientAdjustment();
+		}
+
+		for (int32 ChildIdx = 0; ChildIdx < Connection->Children.Num(); ChildIdx++)
+		{
+			if (Connection->Children[ChildIdx]->PlayerController != NULL)
+			{
+				Connection->Children[ChildIdx]->PlayerController->SendClientAdjustment();
+			}
+		}
+
+		Connection->TickCount++;
+
+		new(Prioritization.Viewers) FNetViewer(Connection, DeltaSeconds);
+		for (int32 ChildIdx = 0; ChildIdx < Connection->Children.Num(); ChildIdx++)
+		{
+			if (Connection->Children[ChildIdx]->Viewer != NULL)
+			{
+				new(Prioritization.Viewers) FNetViewer(Connection->Children[ChildIdx], DeltaSeconds);
+			}
+		}
+
+		check(World == Connection->OwningActor->GetWorld());
+
+		// determine whether we should priority sort the list of relevant actors based on the saturation/bandwidth of the current connection
+		//@note - if the server is currently CPU saturated then do not sort until framerate improves
+		check(World == Connection->Viewer->GetWorld());
+		AGameMode const* const GameMode = World->GetAuthGameMode();
+		Prioritization.bLowNetBandwidth = !bCPUSaturated && (Connection->CurrentNetSpeed / float(GameMode->NumPlayers + GameMode->NumBots) < 500.f );
+	}
+
+	// Get the sorted list of visible/relevant actors for every connection
+	ServerReplicateActors_PrioritizeConnections(Prioritizations, ConsiderList, ConsiderListSize, CVarNetParallelRelevancy.GetValueOnGameThread());
+
 	for( int32 i=0; i < ClientConnections.Num(); i++ )
 	{
 		UNetConnection* Connection = ClientConnections[i];
@@ -1937,202 +2251,44 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 		}
 		else if (Connection->Viewer)
 		{
+			FConnectionPrioritization& Prioritization = Prioritizations[i];
+			check(Prioritization.Connection == Connection);
+
 			int32 j;
-			int32 ConsiderCount	= 0;
-			int32 DeletedCount = 0;
-			
-			int32 NetRelevantCount = 0;
-			FActorPriority* PriorityList = NULL;
-			FActorPriority** PriorityActors = NULL;
+			const int32 ConsiderCount = Prioritization.PriorityActors.Num();
+			FActorPriority** PriorityActors = Prioritization.PriorityActors.GetTypedData();
+			const int32 NetRelevantCount = World->GetNetRelevantActorCount() + DestroyedStartupOrDormantActors.Num();
 
+			// set the replication viewers to the current connection (and children) so that actors can determine who is currently being considered for relevancy checks
 			TArray<FNetViewer>& ConnectionViewers = WorldSettings->ReplicationViewers;
+			ConnectionViewers = Prioritization.Viewers;
 
 			float PruneActors = 0.f;
 			CLOCK_CYCLES(PruneActors);
-			FMemMark RelevantActorMark(FMemStack::Get());
 
-			// Prioritize actors for this connection
+			// Apply what prioritizing found for this connection
 			{
-				SCOPE_CYCLE_COUNTER(STAT_NetPrioritizeActorsTime);
-
-				// send ClientAdjustment if necessary
-				// we do this here so that we send a maximum of one per packet to that client; there is no value in stacking additional corrections
-				if (Connection->PlayerController)
-				{
-					Connection->PlayerController->SendClientAdjustment();
-				}
-				
-				for (int32 ChildIdx = 0; ChildIdx < Connection->Children.Num(); ChildIdx++)
-				{
-					if (Connection->Children[ChildIdx]->PlayerController != NULL)
-					{
-						Connection->Children[ChildIdx]->PlayerController->SendClientAdjustment();
-					}
-				}
-
-				// Get list of visible/relevant actors.
-				
-				NetTag++;
-				Connection->TickCount++;
-
-				// Set up to skip all sent temporary actors
-				for( j=0; j<Connection->SentTemporaries.Num(); j++ )
-				{
-					Connection->SentTemporaries[j]->NetTag = NetTag;
-				}
-
-				// set the replication viewers to the current connection (and children) so that actors can determine who is currently being considered for relevancy checks
-				ConnectionViewers.Reset();
-				new(ConnectionViewers) FNetViewer(Connection, DeltaSeconds);
-				for (j = 0; j < Connection->Children.Num(); j++)
+				for (j = 0; j < Prioritization.ChannelsToStartDormancy.Num(); j++)
 				{
-					if (Connection->Children[j]->Viewer != NULL)
-					{
-						new(ConnectionViewers) FNetViewer(Connection->Children[j], DeltaSeconds);
-					}
+					// Channel is marked to go dormant now once all properties have been replicated (but is not dormant yet)
+					Prioritization.ChannelsToStartDormancy[j]->StartBecomingDormant();
 				}
 
-				// Make list of all actors to consider.
-				check(World == Connection->OwningActor->GetWorld());
-				
-				NetRelevantCount = World->GetNetRelevantActorCount() + DestroyedStartupOrDormantActors.Num();
-				PriorityList = new(FMemStack::Get(),NetRelevantCount+2)FActorPriority;
-				PriorityActors = new(FMemStack::Get(),NetRelevantCount+2)FActorPriority*;
-
-				// determine whether we should priority sort the list of relevant actors based on the saturation/bandwidth of the current connection
-				//@note - if the server is currently CPU saturated then do not sort until framerate improves
-				check(World == Connection->Viewer->GetWorld());
-				AGameMode const* const GameMode = World->GetAuthGameMode();
-				bool bLowNetBandwidth = !bCPUSaturated && (Connection->CurrentNetSpeed / float(GameMode->NumPlayers + GameMode->NumBots) < 500.f );
-
-				for( j=0; j<ConsiderListSize; j++ )
+				if (DebugRelevantActors)
 				{
-					AActor* Actor = ConsiderList[j];
-					UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
-
-					// Skip Actor if dormant
-					static const auto CVar = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("net.DormancyEnable"));
-					if ( !CVar || CVar->GetValueOnGameThread() == 1 )
-					{
-						// If actor is already dormant on this channel, then skip replication entirely
-						if ( Connection->DormantActors.Contains( Actor ) )
-						{
-							// net.DormancyValidate can be set to 2 to validate dormant actor properties on every replicate
-							// (this could be moved to be done every tick instead of every net update if necessary, but seems excessive)
-							static const auto ValidateCVar = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("net.DormancyValidate"));
-							if ( ValidateCVar && ValidateCVar->GetValueOnGameThread() == 2 )
-							{
-								TSharedRef< FObjectReplicator > * Replicator = Connection->DormantReplicatorMap.Find( Actor );
-
-								if ( Replicator != NULL )
-								{
-									Replicator->Get().ValidateAgainstState( Actor );
-								}
-							}
-
-							continue;
-						}
-
-						// If actor might need to go dormant on this channel, then check
-						if (Actor->NetDormancy > DORM_Awake && Channel && !Channel->bPendingDormancy && !Channel->Dormant )
-						{
-							bool ShouldGoDormant = true;
-							if (Actor->NetDormancy == DORM_DormantPartial)
-							{
-								float Time  = Channel ? (Connection->Driver->Time - Channel->LastUpdateTime) : Connection->Driver->SpawnPrioritySeconds;
-								for (int32 viewerIdx = 0; viewerIdx < ConnectionViewers.Num(); viewerIdx++)
-								{
-									if (!Actor->GetNetDormancy(ConnectionViewers[viewerIdx].ViewLocation, ConnectionViewers[viewerIdx].ViewDir, ConnectionViewers[viewerIdx].InViewer, Channel, Time, bLowNetBandwidth))
-									{
-										ShouldGoDormant = false;
-										break;
-									}
-								}
-							}
-
-							if (ShouldGoDormant)
-							{
-								// Channel is marked to go dormant now once all properties have been replicated (but is not dormant yet)
-								Channel->StartBecomingDormant();
-							}
-						}
-					}
-
-					const bool bLevelInitializedForActor = Connection->ClientWorldPackageName == Actor->GetWorld()->GetOutermost()->GetFName() && Connection->ClientHasInitializedLevelFor( Actor );
-
-					// Skip actor if not relevant and theres no channel already.
-					// Historically Relevancy checks were deferred until after prioritization because they were expensive (line traces).
-					// Relevancy is now cheap and we are dealing with larger lists of considered actors, so we want to keep the list of
-					// prioritized actors low.
-					if (!Channel)
-					{
-						if ( !bLevelInitializedForActor )
-						{
-							// If the level this actor belongs to isn't loaded on client, don't bother sending
-							continue;
-						}
-						bool Relevant = false;
-						for (int32 viewerIdx = 0; viewerIdx < ConnectionViewers.Num(); viewerIdx++)
-						{
-							if(Actor->IsNetRelevantFor(ConnectionViewers[viewerIdx].InViewer, ConnectionViewers[viewerIdx].Viewer, ConnectionViewers[viewerIdx].ViewLocation))
-							{
-								Relevant = true;
-								break;
-							}
-						}
-						if (!Relevant)
-						{
-							continue;
-						}
-					}
-
-					if( Actor->NetTag!=NetTag ) // Do not consider actor for this connection if this connection has it marked dormant
+					for (j = 0; j < Prioritization.PriorityList.Num(); j++)
 					{
-						UE_LOG(LogNetTraffic, Log, TEXT("Consider %s alwaysrelevant %d frequency %f "),*Actor->GetName(), Actor->bAlwaysRelevant, Actor->NetUpdateFrequency);
-						Actor->NetTag                 = NetTag;
-						PriorityList  [ConsiderCount] = FActorPriority(Connection, Channel, Actor, ConnectionViewers, bLowNetBandwidth);
-						PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
-						ConsiderCount++;
-
-						if (DebugRelevantActors)
+						if (Prioritization.PriorityList[j].Actor != NULL)
 						{
-							LastPrioritizedActors.Add(Actor);
+							LastPrioritizedActors.Add(Prioritization.PriorityList[j].Actor);
 						}
 					}
 				}
 
-				// Add in deleted actors
-				for (auto It = Connection->DestroyedStartupOrDormantActors.CreateIterator(); It; ++It)
-				{
-					FActorDestructionInfo &DInfo = DestroyedStartupOrDormantActors.FindChecked(*It);
-					PriorityList  [ConsiderCount] = FActorPriority(Connection, &DInfo, ConnectionViewers);
-					PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
-					ConsiderCount++;
-					DeletedCount++;
-				}
-
 				UNetConnection* NextConnection = Connection;
 				int32 ChildIndex = 0;
 				while (NextConnection != NULL)
 				{
-					for (int32 j = 0; j < NextConnection->OwnedConsiderListSize; j++)
-					{
-						AActor* Actor = NextConnection->OwnedConsiderList[j];
-						UE_LOG(LogNetTraffic, Log, TEXT("Consider owned %s always relevant %d frequency %f  "),*Actor->GetName(), Actor->bAlwaysRelevant,Actor->NetUpdateFrequency);
-						if (Actor->NetTag != NetTag)
-						{
-							UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
-							Actor->NetTag                 = NetTag;
-							PriorityList  [ConsiderCount] = FActorPriority(NextConnection, Channel, Actor, ConnectionViewers, bLowNetBandwidth);
-							PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
-							ConsiderCount++;
-
-							if (DebugRelevantActors)
-							{
-								LastPrioritizedActors.Add(Actor);
-							}
-						}
-					}
 					NextConnection->OwnedConsiderList = NULL;
 					NextConnection->OwnedConsiderListSize = 0;
 
@@ -2140,19 +2296,8 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 				}
 
 				SET_DWORD_STAT(STAT_PrioritizedActors,ConsiderCount);
-				SET_DWORD_STAT(STAT_NumRelevantDeletedActors,DeletedCount);
-
-				// Sort by priority
-				struct FCompareFActorPriority
-				{
-					FORCEINLINE bool operator()( const FActorPriority& A, const FActorPriority& B ) const
-					{
-						return B.Priority < A.Priority;
-					}
-				};
-				Sort( PriorityActors, ConsiderCount, FCompareFActorPriority() );
-
-			} // END PRIORITIZE
+				SET_DWORD_STAT(STAT_NumRelevantDeletedActors,Prioritization.DeletedCount);
+			}
 
 			// Update all relevant actors in sorted order.
 			bool bNewSaturated = !Connection->IsNetReady(0);
@@ -2353,7 +2498,6 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 					}
 				}
 			}
-			RelevantActorMark.Pop();
 			UE_LOG(LogNetTraffic, Log, TEXT("Potential %04i ConsiderList %03i ConsiderCount %03i Prune=%01.4f "),NetRelevantCount, 
 						ConsiderListSize, ConsiderCount, FPlatformTime::ToMilliseconds(PruneActors) );
 
@@ -2395,6 +2539,99 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 }
 
 
+#if WITH_SERVER_CODE && !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+/**
+ * Times the prioritization stage of ServerReplicateActors with 1 to MaxTasks tasks.
+ * A server has no simulated clients, so NumConnections are made by cycling the connected clients.
+ */
+static void RelevancyBenchmark(const TArray<FString>& Args, UWorld* InWorld)
+{
+	UNetDriver* NetDriver = InWorld ? InWorld->GetNetDriver() : NULL;
+	if (NetDriver == NULL || NetDriver->ServerConnection != NULL)
+	{
+		UE_LOG(LogNet, Warning, TEXT("net.RelevancyBenchmark has to be run on a server"));
+		return;
+	}
+
+	const int32 NumConnections = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100;
+	const int32 MaxTasks = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : FMath::Max(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 1);
+	const int32 NumIterations = 10;
+
+	// Connections that had a viewer the last time actors were replicated
+	// Owned consider lists are only valid inside ServerReplicateActors and are empty here
+	TArray<UNetConnection*> ReadyConnections;
+	for (int32 ConnIdx = 0; ConnIdx < NetDriver->ClientConnections.Num(); ConnIdx++)
+	{
+		UNetConnection* Connection = NetDriver->ClientConnections[ConnIdx];
+		if (Connection->Viewer != NULL && Connection->OwningActor != NULL && Connection->State == USOCK_Open && Connection->OwnedConsiderListSize == 0)
+		{
+			ReadyConnections.Add(Connection);
+		}
+	}
+
+	if (ReadyConnections.Num() == 0)
+	{
+		UE_LOG(LogNet, Warning, TEXT("net.RelevancyBenchmark needs at least one connected client"));
+		return;
+	}
+
+	// Every actor that could be relevant to any connection, without the side effects of building the real consider list
+	TArray<AActor*> ConsiderList;
+	for (int32 ActorIdx = 0; ActorIdx < InWorld->NetworkActors.Num(); ActorIdx++)
+	{
+		AActor* Actor = InWorld->NetworkActors[ActorIdx];
+		if (Actor != NULL && !Actor->IsPendingKill() && Actor->GetRemoteRole() != ROLE_None && Actor->NetDriverName == NetDriver->NetDriverName && !Actor->bOnlyRelevantToOwner)
+		{
+			ConsiderList.Add(Actor);
+		}
+	}
+
+	TArray<FConnectionPrioritization> Prioritizations;
+	for (int32 Index = 0; Index < NumConnections; Index++)
+	{
+		UNetConnection* Connection = ReadyConnections[Index % ReadyConnections.Num()];
+		FConnectionPrioritization& Prioritization = *new(Prioritizations) FConnectionPrioritization();
+		Prioritization.Connection = Connection;
+		new(Prioritization.Viewers) FNetViewer(Connection, 0.f);
+		for (int32 ChildIdx = 0; ChildIdx < Connection->Children.Num(); ChildIdx++)
+		{
+			if (Connection->Children[ChildIdx]->Viewer != NULL)
+			{
+				new(Prioritization.Viewers) FNetViewer(Connection->Children[ChildIdx], 0.f);
+			}
+		}
+	}
+
+	UE_LOG(LogNet, Log, TEXT("Prioritizing %d actors for %d connections (%d connected clients), %d iterations"), ConsiderList.Num(), NumConnections, ReadyConnections.Num(), NumIterations);
+
+	double SerialTime = 0.0;
+	for (int32 NumTasks = 1; NumTasks <= MaxTasks; NumTasks++)
+	{
+		// Warm up so the first run doesn't pay for growing the arrays
+		NetDriver->ServerReplicateActors_PrioritizeConnections(Prioritizations, ConsiderList.GetTypedData(), ConsiderList.Num(), NumTasks);
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			NetDriver->ServerReplicateActors_PrioritizeConnections(Prioritizations, ConsiderList.GetTypedData(), ConsiderList.Num(), NumTasks);
+		}
+		const double Time = (FPlatformTime::Seconds() - StartTime) / NumIterations;
+
+		if (NumTasks == 1)
+		{
+			SerialTime = Time;
+		}
+		UE_LOG(LogNet, Log, TEXT("%3d tasks: %8.3f ms, %5.2fx"), NumTasks, Time * 1000.0, Time > 0.0 ? SerialTime / Time : 0.0);
+	}
+}
+
+FAutoConsoleCommandWithWorldAndArgs RelevancyBenchmarkCommand(
+	TEXT("net.RelevancyBenchmark"),
+	TEXT("Times relevancy and priority checks for [NumConnections=100] connections with 1 to [MaxTasks] tasks, needs a connected client"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(RelevancyBenchmark)
+	);
+#endif
+
 void UNetDriver::PrintDebugRelevantActors()
 {
 	struct SLocal
@@ -11,6 +11,8 @@
 
 static TAutoConsoleVariable<int32> CVarAllowPropertySkipping( TEXT( "net.AllowPropertySkipping" ), 1, TEXT( "Allow skipping of properties that haven't changed for other clients" ) );
 
+static TAutoConsoleVariable<int32> CVarShareChangelists( TEXT( "net.ShareChangelists" ), 0, TEXT( "Compare each object once per frame into a changelist history shared by all connections, instead of once per connection" ) );
+
 static TAutoConsoleVariable<int32> CVarDoPropertyChecksum( TEXT( "net.DoPropertyChecksum" ), 0, TEXT( "" ) );
 
 FAutoConsoleVariable CVarDoReplicationContextString( TEXT( "net.ContextDebug" ), 0, TEXT( "" ) );
@@ -458,6 +460,129 @@ bool FRepLayout::GenerateChangelist( FRepState * RepState, const uint8 * Data, T
 	return CompareProperties( RepState, RepState->StaticBuffer.GetTypedData(), Data, OutChangedParents, UnconditionalLifetime );
 }
 
+static void BuildChangelistFromParents( const TArray< FRepChangedParent > & ChangedParents, TArray< uint16 > & OutChanged )
+{
+	// Append in the order of the parents so that the change list is fully sorted
+	for ( int32 i = 0; i < ChangedParents.Num(); i++ )
+	{
+		OutChanged.Append( ChangedParents[i].Changed );
+	}
+
+	OutChanged.Add( 0 );
+}
+
+void FRepLayout::InitChangelistState( FRepChangelistState * ChangelistState, UClass * InObjectClass, const uint8 * Src ) const
+{
+	FRepState * ShadowState = &ChangelistState->ShadowState;
+
+	ShadowState->StaticBuffer.Empty();
+	ShadowState->StaticBuffer.AddZeroed( InObjectClass->GetDefaultsCount() );
+
+	ConstructProperties( ShadowState );
+	InitProperties( ShadowState, (uint8*)Src );
+
+	ChangelistState->ChangedParents.SetNum( Parents.Num() );
+}
+
+void FRepLayout::UpdateChangelistState( FRepChangelistState * ChangelistState, const uint8 * Data, const uint32 ReplicationFrame ) const
+{
+	if ( ChangelistState->LastCompareFrame == ReplicationFrame )
+	{
+		return;		// Another connection already compared this frame
+	}
+
+	ChangelistState->LastCompareFrame = ReplicationFrame;
+
+	TArray< FRepChangedParent > & ChangedParents = ChangelistState->ChangedParents;
+
+	if ( !CompareProperties( &ChangelistState->ShadowState, ChangelistState->ShadowState.StaticBuffer.GetTypedData(), Data, ChangedParents, UnconditionalLifetime ) )
+	{
+		return;
+	}
+
+	if ( ChangelistState->HistoryEnd - ChangelistState->HistoryStart == FRepChangelistState::MAX_CHANGE_HISTORY )
+	{
+		// History is full, fold the oldest item into the next one
+		// Connections that haven't sent the oldest item yet will send it as part of the next one
+		FRepChangedHistory & OldestItem	= ChangelistState->ChangeHistory[ ChangelistState->HistoryStart % FRepChangelistState::MAX_CHANGE_HISTORY ];
+		FRepChangedHistory & NextItem	= ChangelistState->ChangeHistory[ ( ChangelistState->HistoryStart + 1 ) % FRepChangelistState::MAX_CHANGE_HISTORY ];
+
+		TArray< uint16 > Temp = NextItem.Changed;
+		MergeDirtyList( (void*)Data, OldestItem.Changed, Temp, NextItem.Changed );
+		OldestItem.Changed.Empty();
+
+		ChangelistState->HistoryStart++;
+	}
+
+	FRepChangedHistory & NewHistoryItem = ChangelistState->ChangeHistory[ ChangelistState->HistoryEnd % FRepChangelistState::MAX_CHANGE_HISTORY ];
+
+	ChangelistState->HistoryEnd++;
+
+	check( NewHistoryItem.Changed.Num() == 0 );
+
+	BuildChangelistFromParents( ChangedParents, NewHistoryItem.Changed );
+
+#ifdef SANITY_CHECK_MERGES
+	SanityCheckChangeList( Data, NewHistoryItem.Changed );
+#endif
+
+	// The shadow state now matches the object, and the scratch lists are ready for the next compare
+	StoreChangedParents( &ChangelistState->ShadowState, Data, ChangedParents );
+
+	for ( int32 i = 0; i < ChangedParents.Num(); i++ )
+	{
+		ChangedParents[i].Changed.Reset();
+	}
+}
+
+bool FRepLayout::MergeChangelistHistory( FRepState * RepState, const FRepChangelistState * ChangelistState, const uint8 * Data, TArray< uint16 > & OutChanged ) const
+{
+	OutChanged.Empty();
+
+	// Items before HistoryStart were folded into HistoryStart
+	const int32 FirstIndex = FMath::Max( RepState->LastChangelistIndex, ChangelistState->HistoryStart );
+
+	for ( int32 i = FirstIndex; i < ChangelistState->HistoryEnd; i++ )
+	{
+		const FRepChangedHistory & HistoryItem = ChangelistState->ChangeHistory[ i % FRepChangelistState::MAX_CHANGE_HISTORY ];
+
+		// Always merge, even a single item, so older items are pruned to the current shape of the arrays
+		TArray< uint16 > Temp = OutChanged;
+		MergeDirtyList( (void*)Data, Temp, HistoryItem.Changed, OutChanged );
+	}
+
+	RepState->LastChangelistIndex = ChangelistState->HistoryEnd;
+
+	// A merged list that only holds the terminator means everything was pruned
+	if ( OutChanged.Num() <= 1 )
+	{
+		OutChanged.Empty();
+		return false;
+	}
+
+#ifdef SANITY_CHECK_MERGES
+	SanityCheckChangeList( Data, OutChanged );
+#endif
+
+	return true;
+}
+
+void FRepLayout::StoreChangedParents( FRepState * RepState, const uint8 * Data, const TArray< FRepChangedParent > & ChangedParents ) const
+{
+	uint8 * StoredData = RepState->StaticBuffer.GetTypedData();
+
+	for ( int32 i = 0; i < Parents.Num(); i++ )
+	{
+		if ( ChangedParents[i].Changed.Num() > 0 )
+		{
+			PTRINT Offset = Parents[i].Property->ContainerPtrToValuePtr<uint8>( StoredData, Parents[i].ArrayIndex ) - StoredData;
+			check( Offset >= 0 && Offset < RepState->StaticBuffer.Num() );
+
+			Parents[i].Property->CopySingleValue( StoredData + Offset, Data + Offset );
+		}
+	}
+}
+
 void FRepLayout::ValidateChangelist(
 	FRepState *							RepState, 
 	const uint8 * 						Data, 
@@ -499,57 +624,104 @@ bool FRepLayout::ReplicateProperties(
 
 	bool PropertyChanged = false;
 
+	const bool bShareChangelists = CVarShareChangelists.GetValueOnGameThread() > 0;
+
+	// Unconditional properties that changed since this connection last sent, when using the shared changelists
+	TArray< uint16 > SharedChanged;
+
 #ifdef ENABLE_SUPER_CHECKSUMS
 	const bool bIsAllAcked = AllAcked( RepState );
 
 	if ( bIsAllAcked || !RepState->OpenAckedCalled )
 #endif
 	{
-		const int32	AllowSkipping = CVarAllowPropertySkipping.GetValueOnGameThread();
-		
-		const bool bCanSkip =	AllowSkipping > 0 && 
-								RepState->LastReplicationFrame != 0 &&
-								ChangeTracker->LastReplicationFrame == NetDriver->ReplicationFrame &&
-								ChangeTracker->LastReplicationGroupFrame == RepState->LastReplicationFrame;
-
-		if ( bCanSkip )
+		if ( bShareChangelists )
 		{
-			INC_DWORD_STAT_BY( STAT_NetSkippedDynamicProps, UnconditionalLifetime.Num() );
+			SCOPE_CYCLE_COUNTER( STAT_NetSharedChangelistTime );
+
+			if ( !ChangeTracker->ChangelistState.IsValid() )
+			{
+				ChangeTracker->ChangelistState = MakeShareable( new FRepChangelistState );
+				InitChangelistState( ChangeTracker->ChangelistState.Get(), ObjectClass, Data );
+				ChangeTracker->ChangelistState->ShadowState.RepLayout = RepState->RepLayout;
+			}
 
-			if ( AllowSkipping == 2 )
+			FRepChangelistState * ChangelistState = ChangeTracker->ChangelistState.Get();
+
+			// Only the first connection to replicate this object this frame actually compares
+			UpdateChangelistState( ChangelistState, Data, NetDriver->ReplicationFrame );
+
+			if ( RepState->LastChangelistIndex == INDEX_NONE )
 			{
-				// Sanity check results
-				check( ChangeTracker->UnconditionalPropChanged == ChangedParentsHasChanged( UnconditionalLifetime, ChangeTracker->Parents ) );
+				// This connection hasn't used the shared history yet, so its shadow state can differ from the shared one
+				// Compare against it once, from then on the shared history covers everything
+				TArray< FRepChangedParent > LocalChangedParents;
 
-				SanityCheckShadowStateAgainstChangeList( RepState, Data, OwningChannel, UnconditionalLifetime, ChangeTracker->LastRepState, ChangeTracker->Parents );
+				if ( GenerateChangelist( RepState, Data, LocalChangedParents ) )
+				{
+					BuildChangelistFromParents( LocalChangedParents, SharedChanged );
+				}
+
+				RepState->LastChangelistIndex = ChangelistState->HistoryEnd;
+			}
+			else
+			{
+				MergeChangelistHistory( RepState, ChangelistState, Data, SharedChanged );
 			}
+
+			PropertyChanged = SharedChanged.Num() > 0;
 		}
 		else
 		{
-			// FRepState group changed, force this group to compare again this frame
-			// This happens either once a frame, which is normal, or multiple times a frame 
-			// when multiple connections of the same actor aren't updated at the same time
-			ChangeTracker->LastReplicationFrame			= NetDriver->ReplicationFrame;
-			ChangeTracker->LastReplicationGroupFrame	= RepState->LastReplicationFrame;
-			ChangeTracker->LastRepState					= RepState;
+			// Start over with a full compare if the shared changelists get turned on
+			RepState->LastChangelistIndex = INDEX_NONE;
+
+			const int32	AllowSkipping = CVarAllowPropertySkipping.GetValueOnGameThread();
+		
+			const bool bCanSkip =	AllowSkipping > 0 && 
+									RepState->LastReplicationFrame != 0 &&
+									ChangeTracker->LastReplicationFrame == NetDriver->ReplicationFrame &&
+									ChangeTracker->LastReplicationGroupFrame == RepState->LastReplicationFrame;
 
-			// Reset changed list if anything changed last time
-			if ( ChangeTracker->UnconditionalPropChanged )
+			if ( bCanSkip )
 			{
-				for ( int32 i = UnconditionalLifetime.Num() - 1; i >= 0; i-- )
+				INC_DWORD_STAT_BY( STAT_NetSkippedDynamicProps, UnconditionalLifetime.Num() );
+
+				if ( AllowSkipping == 2 )
 				{
-					ChangeTracker->Parents[UnconditionalLifetime[i]].Changed.Empty();
+					// Sanity check results
+					check( ChangeTracker->UnconditionalPropChanged == ChangedParentsHasChanged( UnconditionalLifetime, ChangeTracker->Parents ) );
+
+					SanityCheckShadowStateAgainstChangeList( RepState, Data, OwningChannel, UnconditionalLifetime, ChangeTracker->LastRepState, ChangeTracker->Parents );
 				}
 			}
+			else
+			{
+				// FRepState group changed, force this group to compare again this frame
+				// This happens either once a frame, which is normal, or multiple times a frame 
+				// when multiple connections of the same actor aren't updated at the same time
+				ChangeTracker->LastReplicationFrame			= NetDriver->ReplicationFrame;
+				ChangeTracker->LastReplicationGroupFrame	= RepState->LastReplicationFrame;
+				ChangeTracker->LastRepState					= RepState;
+
+				// Reset changed list if anything changed last time
+				if ( ChangeTracker->UnconditionalPropChanged )
+				{
+					for ( int32 i = UnconditionalLifetime.Num() - 1; i >= 0; i-- )
+					{
+						ChangeTracker->Parents[UnconditionalLifetime[i]].Changed.Empty();
+					}
+				}
 
-			// Loop over all unconditional lifetime properties
-			ChangeTracker->UnconditionalPropChanged = CompareProperties( RepState, CompareData, Data, ChangeTracker->Parents, UnconditionalLifetime );
+				// Loop over all unconditional lifetime properties
+				ChangeTracker->UnconditionalPropChanged = CompareProperties( RepState, CompareData, Data, ChangeTracker->Parents, UnconditionalLifetime );
+			}
 		}
 
 		// Remember the last frame this FRepState was replicated, so we can note above when the FRepState replication group changes
 		RepState->LastReplicationFrame = NetDriver->ReplicationFrame;
 
-		if ( ChangeTracker->UnconditionalPropChanged )
+		if ( !bShareChangelists && ChangeTracker->UnconditionalPropChanged )
 		{
 			PropertyChanged	= true;
 		}
@@ -586,7 +758,35 @@ bool FRepLayout::ReplicateProperties(
 
 		check( Changed.Num() == 0 );		// Make sure this history item is actually inactive
 
-		if ( PropertyChanged )
+		if ( PropertyChanged && bShareChangelists )
+		{
+			// Merge the connection's conditional properties into the shared change list
+			TArray< uint16 > ConditionalChanged;
+
+			for ( int32 i = 0; i < Parents.Num(); i++ )
+			{
+				if ( ( Parents[i].Flags & PARENT_IsConditional ) && ChangeTracker->Parents[i].Changed.Num() > 0 )
+				{
+					ConditionalChanged.Append( ChangeTracker->Parents[i].Changed );
+					ChangeTracker->Parents[i].Changed.Empty();
+				}
+			}
+
+			if ( ConditionalChanged.Num() > 0 )
+			{
+				ConditionalChanged.Add( 0 );
+				MergeDirtyList( (void*)Data, SharedChanged, ConditionalChanged, Changed );
+			}
+			else
+			{
+				Changed = SharedChanged;
+			}
+
+#ifdef SANITY_CHECK_MERGES
+			SanityCheckChangeList( Data, Changed );
+#endif
+		}
+		else if ( PropertyChanged )
 		{
 			// Initialize the history item change list with the parent change lists
 			// We do it in the order of the parents so that the final change list will be fully sorted
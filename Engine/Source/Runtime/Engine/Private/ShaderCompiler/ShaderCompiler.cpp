@@ -319,6 +319,9 @@ struct FShaderCompileWorkerInfo
 	/** Jobs that this worker is responsible for compiling. */
 	TArray<FShaderCompileJob*> QueuedJobs;
 
+	/** Jobs of QueuedJobs the worker actually compiles, the others were found in the job cache or are identical to jobs compiled by other workers. */
+	TArray<FShaderCompileJob*> JobsToCompile;
+
 	FShaderCompileWorkerInfo() :
 		WorkerAppId(0),
 		bIssuedTasksToWorker(false),
@@ -331,11 +334,24 @@ struct FShaderCompileWorkerInfo
 	{
 	}
 
+	/** Returns true if all jobs of the batch have their output, including the ones that waited for identical jobs of other workers. */
+	bool AreAllJobsFinalized() const
+	{
+		for (int32 JobIndex = 0; JobIndex < QueuedJobs.Num(); JobIndex++)
+		{
+			if (!QueuedJobs[JobIndex]->bFinalized)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
 	void CreatePipeAndNewTask(uint32 WorkerIndex, uint32 ProcessId)
 	{
 #if PLATFORM_SUPPORTS_NAMED_PIPES
 		check(GShaderPipeConfig.bUseNamedPipes);
-		if (QueuedJobs.Num() > 0)
+		if (JobsToCompile.Num() > 0)
 		{
 			// Open the pipe; figure out if the worker is still listening, which means we can recycle the pipe
 			bool bAllocNameForPipe = (PipeWorker.PipeName.Len() == 0);
@@ -358,7 +374,7 @@ struct FShaderCompileWorkerInfo
 				bWorkerForPipeWasLaunched = false;
 			}
 			PipeWorker.CreatePipe(WorkerIndex, ProcessId, bAllocNameForPipe);
-			PipeWorker.WriteTasksForPipe(QueuedJobs);
+			PipeWorker.WriteTasksForPipe(JobsToCompile);
 		}
 #else
 		check(0);
@@ -369,7 +385,7 @@ struct FShaderCompileWorkerInfo
 	{
 #if PLATFORM_SUPPORTS_NAMED_PIPES
 		check(GShaderPipeConfig.bUseNamedPipes);
-		if (QueuedJobs.Num() == 0 || !bWorkerForPipeWasLaunched)
+		if (JobsToCompile.Num() == 0 || !bWorkerForPipeWasLaunched)
 		{
 			return;
 		}
@@ -391,7 +407,7 @@ struct FShaderCompileWorkerInfo
 		if (!bError)
 		{
 			FMemoryReader ResultReader(PipeWorker.ResultsBuffer);
-			DoReadTaskResults(QueuedJobs, ResultReader);
+			DoReadTaskResults(JobsToCompile, ResultReader);
 			bComplete = true;
 		}
 
@@ -411,7 +427,7 @@ struct FShaderCompileWorkerInfo
 		if (PipeWorker.UpdateResultsState())
 		{
 			FMemoryReader ResultReader(PipeWorker.ResultsBuffer);
-			DoReadTaskResults(QueuedJobs, ResultReader);
+			DoReadTaskResults(JobsToCompile, ResultReader);
 			bComplete = true;
 		}
 
@@ -424,6 +440,260 @@ struct FShaderCompileWorkerInfo
 
 };
 
+// Bump when changing what the job cache stores in the derived data cache
+#define SHADERJOBCACHE_DERIVEDDATA_VER TEXT("1")
+
+/** 
+ * Output of compiled shader jobs, keyed by a hash of the compiler input and of the shader files the compiler reads.
+ * Material instances and permutations produce many identical jobs, only the first of them has to be compiled.
+ * Only accessed by the thread running the compiling loop.
+ */
+class FShaderJobCache
+{
+public:
+
+	FShaderJobCache(bool bInUseDDC, int64 InMemoryLimit) :
+		bUseDDC(bInUseDDC),
+		MemoryLimit(InMemoryLimit),
+		MemoryUsed(0),
+		NumLookups(0),
+		NumHits(0),
+		NumDDCHits(0),
+		NumDuplicates(0),
+		SavedTime(0),
+		NumLookupsReported(0)
+	{
+	}
+
+	/** 
+	 * Looks up a new job.
+	 * @return true if the job was finalized with cached output or will be along with an identical job being compiled, false if it has to be compiled.
+	 */
+	bool TryFinishJob(FShaderCompileJob& Job)
+	{
+		// The compiler dumps debug info for every job that asks for it
+		if (!Job.Input.DumpDebugInfoPath.IsEmpty())
+		{
+			return false;
+		}
+
+		const FSHAHash Key = GetJobKey(Job);
+		NumLookups++;
+
+		const FCachedOutput* CachedOutput = Outputs.Find(Key);
+
+		if (CachedOutput)
+		{
+			FinishJob(Job, CachedOutput->Output);
+			SavedTime += CachedOutput->CompileTime;
+			NumHits++;
+			return true;
+		}
+
+		TArray<FShaderCompileJob*>* WaitingJobs = JobsWaitingForKey.Find(Key);
+
+		if (WaitingJobs)
+		{
+			WaitingJobs->Add(&Job);
+			NumDuplicates++;
+			return true;
+		}
+
+		if (bUseDDC)
+		{
+			TArray<uint8> CachedData;
+
+			if (GetDerivedDataCacheRef().GetSynchronous(*GetDDCKey(Job, Key), CachedData))
+			{
+				FMemoryReader Ar(CachedData);
+				FCachedOutput DDCOutput;
+				Ar << DDCOutput;
+
+				if (!Ar.IsError())
+				{
+					DDCOutput.Output.GenerateOutputHash();
+					FinishJob(Job, DDCOutput.Output);
+					SavedTime += DDCOutput.CompileTime;
+					NumDDCHits++;
+					AddOutput(Key, DDCOutput);
+					return true;
+				}
+			}
+		}
+
+		// Identical jobs that come in while this one is being compiled wait for it
+		JobsWaitingForKey.Add(Key, TArray<FShaderCompileJob*>());
+		KeysBeingCompiled.Add(&Job, Key);
+		return false;
+	}
+
+	/** Caches the output of a job TryFinishJob returned false for, and finalizes the identical jobs that waited for it. */
+	void AddCompiledJob(FShaderCompileJob& Job, double CompileTime)
+	{
+		FSHAHash Key;
+
+		if (!KeysBeingCompiled.RemoveAndCopyValue(&Job, Key))
+		{
+			return;
+		}
+
+		TArray<FShaderCompileJob*> WaitingJobs;
+		JobsWaitingForKey.RemoveAndCopyValue(Key, WaitingJobs);
+
+		for (int32 JobIndex = 0; JobIndex < WaitingJobs.Num(); JobIndex++)
+		{
+			FinishJob(*WaitingJobs[JobIndex], Job.Output);
+			SavedTime += CompileTime;
+		}
+
+		// Failed jobs are compiled again when retried, the shader files may have been fixed in the meantime
+		if (Job.bSucceeded)
+		{
+			FCachedOutput CachedOutput;
+			CachedOutput.Output = Job.Output;
+			CachedOutput.CompileTime = CompileTime;
+
+			if (bUseDDC)
+			{
+				TArray<uint8> CachedData;
+				FMemoryWriter Ar(CachedData);
+				Ar << CachedOutput;
+				GetDerivedDataCacheRef().Put(*GetDDCKey(Job, Key), CachedData);
+			}
+
+			AddOutput(Key, CachedOutput);
+		}
+	}
+
+	/** Logs the hit rate and the worker time saved, if there were lookups since the last time. */
+	void LogStats()
+	{
+		if (NumLookups == NumLookupsReported)
+		{
+			return;
+		}
+
+		NumLookupsReported = NumLookups;
+		const int32 NumReused = NumHits + NumDDCHits + NumDuplicates;
+
+		UE_LOG(LogShaderCompilers, Display, TEXT("Shader job cache: reused %d of %d jobs (%.1f%%), %d cached, %d from the DDC, %d identical to jobs being compiled. Saved %.1fs of worker time, %.1fMB cached."),
+			NumReused,
+			NumLookups,
+			100.0f * NumReused / NumLookups,
+			NumHits,
+			NumDDCHits,
+			NumDuplicates,
+			SavedTime,
+			MemoryUsed / (1024.0f * 1024.0f));
+	}
+
+private:
+
+	/** Output of a compiled job and the worker time it took. */
+	struct FCachedOutput
+	{
+		FShaderCompilerOutput Output;
+		double CompileTime;
+
+		FCachedOutput() :
+			CompileTime(0)
+		{
+		}
+
+		friend FArchive& operator<<(FArchive& Ar, FCachedOutput& CachedOutput)
+		{
+			return Ar << CachedOutput.CompileTime << CachedOutput.Output;
+		}
+	};
+
+	/** Hashes the same data the workers get, which includes the generated material code and all defines, along with the shader files they read. */
+	FSHAHash GetJobKey(FShaderCompileJob& Job)
+	{
+		KeyData.Reset();
+		FMemoryWriter Ar(KeyData);
+		Ar << Job.Input;
+
+		FSHA1 HashState;
+		HashState.Update(KeyData.GetData(), KeyData.Num());
+		HashState.Update(Job.SourceHash.Hash, sizeof(Job.SourceHash.Hash));
+		HashState.Final();
+
+		FSHAHash Key;
+		HashState.GetHash(&Key.Hash[0]);
+		return Key;
+	}
+
+	/** The compiler may change between sessions, so DDC keys include its version. */
+	static FString GetDDCKey(const FShaderCompileJob& Job, const FSHAHash& Key)
+	{
+		static ITargetPlatformManagerModule& TPM = GetTargetPlatformManagerRef();
+		const IShaderFormat* Compiler = TPM.FindShaderFormat(Job.Input.ShaderFormat);
+		const uint32 FormatVersion = Compiler ? Compiler->GetVersion(Job.Input.ShaderFormat) : 0;
+		const FString KeySuffix = FString::Printf(TEXT("%s_%u_%s"), *Job.Input.ShaderFormat.ToString(), FormatVersion, *Key.ToString());
+
+		return FDerivedDataCacheInterface::BuildCacheKey(TEXT("SHADERJOB"), SHADERJOBCACHE_DERIVEDDATA_VER, *KeySuffix);
+	}
+
+	static void FinishJob(FShaderCompileJob& Job, const FShaderCompilerOutput& Output)
+	{
+		check(!Job.bFinalized);
+		Job.bFinalized = true;
+		Job.Output = Output;
+		Job.bSucceeded = Output.bSucceeded;
+	}
+
+	/** Keeps the output for this session unless that exceeds the memory limit. */
+	void AddOutput(const FSHAHash& Key, const FCachedOutput& CachedOutput)
+	{
+		const int64 OutputSize = sizeof(FCachedOutput) + CachedOutput.Output.Code.Num();
+
+		if (MemoryUsed + OutputSize <= MemoryLimit)
+		{
+			Outputs.Add(Key, CachedOutput);
+			MemoryUsed += OutputSize;
+		}
+	}
+
+	bool bUseDDC;
+	int64 MemoryLimit;
+	int64 MemoryUsed;
+
+	/** Output of compiled jobs by key. */
+	TMap<FSHAHash, FCachedOutput> Outputs;
+	/** Keys of the jobs being compiled, mapped to the identical jobs that came in since. */
+	TMap<FSHAHash, TArray<FShaderCompileJob*> > JobsWaitingForKey;
+	/** Jobs being compiled, mapped to their keys. */
+	TMap<FShaderCompileJob*, FSHAHash> KeysBeingCompiled;
+	/** Reused for serializing job input. */
+	TArray<uint8> KeyData;
+
+	int32 NumLookups;
+	int32 NumHits;
+	int32 NumDDCHits;
+	int32 NumDuplicates;
+	/** Worker time the reused jobs took to compile originally, in seconds. */
+	double SavedTime;
+	int32 NumLookupsReported;
+};
+
+/** Returns the hash of the shader files the compiler reads from disk for a shader of the given types. */
+static FSHAHash GetShaderJobSourceHash(FShaderType* ShaderType, FVertexFactoryType* VFType)
+{
+	FSHA1 HashState;
+	HashState.Update(ShaderType->GetSourceHash().Hash, sizeof(FSHAHash));
+
+	if (VFType)
+	{
+		HashState.Update(VFType->GetSourceHash().Hash, sizeof(FSHAHash));
+	}
+
+	HashState.Final();
+
+	FSHAHash SourceHash;
+	HashState.GetHash(&SourceHash.Hash[0]);
+	return SourceHash;
+}
+
 FShaderCompileThreadRunnable::FShaderCompileThreadRunnable(FShaderCompilingManager* InManager) :
 	Manager(InManager),
 	Thread(NULL),
@@ -431,6 +701,11 @@ FShaderCompileThreadRunnable::FShaderCompileThreadRunnable(FShaderCompilingManag
 {
 	LastCheckForWorkersTime = 0;
 
+	if (Manager->bUseJobCache)
+	{
+		JobCache = new FShaderJobCache(Manager->bUseJobCacheDDC, Manager->JobCacheMemoryLimit);
+	}
+
 	for (uint32 WorkerIndex = 0; WorkerIndex < Manager->NumShaderCompilingThreads; WorkerIndex++)
 	{
 		WorkerInfos.Add(new FShaderCompileWorkerInfo());
@@ -518,6 +793,7 @@ void FShaderCompileThreadRunnable::CheckHealth() const
 int32 FShaderCompileThreadRunnable::PullTasksFromQueue()
 {
 	int32 NumActiveThreads = 0;
+	TArray<FShaderCompileWorkerInfo*> WorkersWithNewJobs;
 	{
 		// Enter the critical section so we can access the input and output queues
 		FScopeLock Lock(&Manager->CompileQueueSection);
@@ -552,6 +828,7 @@ int32 FShaderCompileThreadRunnable::PullTasksFromQueue()
 					CurrentWorkerInfo.StartTime = FPlatformTime::Seconds();
 					NumActiveThreads++;
 					Manager->CompileQueue.RemoveAt(0, JobIndex);
+					WorkersWithNewJobs.Add(&CurrentWorkerInfo);
 				}
 			}
 			else
@@ -562,7 +839,8 @@ int32 FShaderCompileThreadRunnable::PullTasksFromQueue()
 				}
 
 				// Add completed jobs to the output queue, which is ShaderMapJobs
-				if (CurrentWorkerInfo.bComplete)
+				// Jobs that are identical to jobs of other workers may still be waiting for them
+				if (CurrentWorkerInfo.bComplete && CurrentWorkerInfo.AreAllJobsFinalized())
 				{
 					for (int32 JobIndex = 0; JobIndex < CurrentWorkerInfo.QueuedJobs.Num(); JobIndex++)
 					{
@@ -598,9 +876,61 @@ int32 FShaderCompileThreadRunnable::PullTasksFromQueue()
 			}
 		}
 	}
+
+	// Hashing the new jobs takes a while, so it's done outside of the critical section
+	for (int32 WorkerIndex = 0; WorkerIndex < WorkersWithNewJobs.Num(); WorkerIndex++)
+	{
+		LookUpJobCache(*WorkersWithNewJobs[WorkerIndex]);
+	}
+
 	return NumActiveThreads;
 }
 
+void FShaderCompileThreadRunnable::LookUpJobCache(FShaderCompileWorkerInfo& CurrentWorkerInfo)
+{
+	CurrentWorkerInfo.JobsToCompile.Empty(CurrentWorkerInfo.QueuedJobs.Num());
+
+	for (int32 JobIndex = 0; JobIndex < CurrentWorkerInfo.QueuedJobs.Num(); JobIndex++)
+	{
+		FShaderCompileJob* Job = CurrentWorkerInfo.QueuedJobs[JobIndex];
+
+		if (!JobCache.IsValid() || !JobCache->TryFinishJob(*Job))
+		{
+			CurrentWorkerInfo.JobsToCompile.Add(Job);
+		}
+	}
+
+	// Nothing for the worker to do, the batch is done once the jobs it waits for are
+	if (CurrentWorkerInfo.JobsToCompile.Num() == 0)
+	{
+		CurrentWorkerInfo.bComplete = true;
+	}
+}
+
+void FShaderCompileThreadRunnable::AddCompiledJobsToCache()
+{
+	for (int32 WorkerIndex = 0; WorkerIndex < WorkerInfos.Num(); WorkerIndex++)
+	{
+		FShaderCompileWorkerInfo& CurrentWorkerInfo = *WorkerInfos[WorkerIndex];
+
+		if (CurrentWorkerInfo.bComplete && CurrentWorkerInfo.JobsToCompile.Num() > 0)
+		{
+			if (JobCache.IsValid())
+			{
+				const double CompileTime = (FPlatformTime::Seconds() - CurrentWorkerInfo.StartTime) / CurrentWorkerInfo.JobsToCompile.Num();
+
+				for (int32 JobIndex = 0; JobIndex < CurrentWorkerInfo.JobsToCompile.Num(); JobIndex++)
+				{
+					JobCache->AddCompiledJob(*CurrentWorkerInfo.JobsToCompile[JobIndex], CompileTime);
+				}
+			}
+
+			// The worker has nothing left to compile for this batch
+			CurrentWorkerInfo.JobsToCompile.Empty();
+		}
+	}
+}
+
 void FShaderCompileThreadRunnable::WriteNewTasks()
 {
 	for (int32 WorkerIndex = 0; WorkerIndex < WorkerInfos.Num(); WorkerIndex++)
@@ -608,7 +938,7 @@ void FShaderCompileThreadRunnable::WriteNewTasks()
 		FShaderCompileWorkerInfo& CurrentWorkerInfo = *WorkerInfos[WorkerIndex];
 
 		// Only write tasks once
-		if (!CurrentWorkerInfo.bIssuedTasksToWorker && CurrentWorkerInfo.QueuedJobs.Num() > 0)
+		if (!CurrentWorkerInfo.bIssuedTasksToWorker && CurrentWorkerInfo.JobsToCompile.Num() > 0)
 		{
 			CurrentWorkerInfo.bIssuedTasksToWorker = true;
 
@@ -659,7 +989,7 @@ void FShaderCompileThreadRunnable::WriteNewTasks()
 				}
 				check(TransferFile);
 
-				DoWriteTasks(CurrentWorkerInfo.QueuedJobs, *TransferFile);
+				DoWriteTasks(CurrentWorkerInfo.JobsToCompile, *TransferFile);
 				delete TransferFile;
 
 #if PLATFORM_MAC			
@@ -675,7 +1005,7 @@ void FShaderCompileThreadRunnable::WriteNewTasks()
 void FShaderCompileThreadRunnable::LaunchWorkerIfNeeded(FShaderCompileWorkerInfo& CurrentWorkerInfo, uint32 WorkerIndex)
 {
 #if PLATFORM_SUPPORTS_NAMED_PIPES
-	if (CurrentWorkerInfo.QueuedJobs.Num() == 0)
+	if (CurrentWorkerInfo.JobsToCompile.Num() == 0)
 	{
 		return;
 	}
@@ -730,7 +1060,7 @@ void FShaderCompileThreadRunnable::LaunchWorkersIfNeeded()
 	for (int32 WorkerIndex = 0; WorkerIndex < WorkerInfos.Num(); WorkerIndex++)
 	{
 		FShaderCompileWorkerInfo& CurrentWorkerInfo = *WorkerInfos[WorkerIndex];
-		if (CurrentWorkerInfo.QueuedJobs.Num() == 0 )
+		if (CurrentWorkerInfo.JobsToCompile.Num() == 0)
 		{
 			// Skip if nothing to do
 			continue;
@@ -787,7 +1117,7 @@ void FShaderCompileThreadRunnable::ReadAvailableResults()
 		FShaderCompileWorkerInfo& CurrentWorkerInfo = *WorkerInfos[WorkerIndex];
 
 		// Check for available result files
-		if (CurrentWorkerInfo.QueuedJobs.Num() > 0)
+		if (CurrentWorkerInfo.JobsToCompile.Num() > 0)
 		{
 #if PLATFORM_SUPPORTS_NAMED_PIPES
 			if (GShaderPipeConfig.bUseNamedPipes && !GShaderPipeConfig.bSingleJobPerNamedPipeProcess)
@@ -800,7 +1130,7 @@ void FShaderCompileThreadRunnable::ReadAvailableResults()
 				if (CurrentWorkerInfo.PipeWorker.UpdateResultsState())
 				{
 					FMemoryReader ResultReader(CurrentWorkerInfo.PipeWorker.ResultsBuffer);
-					DoReadTaskResults(CurrentWorkerInfo.QueuedJobs, ResultReader);
+					DoReadTaskResults(CurrentWorkerInfo.JobsToCompile, ResultReader);
 					CurrentWorkerInfo.bComplete = true;
 					CurrentWorkerInfo.PipeWorker.DestroyPipe();
 				}
@@ -823,7 +1153,7 @@ void FShaderCompileThreadRunnable::ReadAvailableResults()
 					if (OutputFilePtr)
 					{
 						FArchive& OutputFile = *OutputFilePtr;
-						DoReadTaskResults(CurrentWorkerInfo.QueuedJobs, OutputFile);
+						DoReadTaskResults(CurrentWorkerInfo.JobsToCompile, OutputFile);
 
 						// Close the output file.
 						delete OutputFilePtr;
@@ -854,11 +1184,11 @@ void FShaderCompileThreadRunnable::CompileDirectlyThroughDll()
 	{
 		FShaderCompileWorkerInfo& CurrentWorkerInfo = *WorkerInfos[WorkerIndex];
 
-		if (CurrentWorkerInfo.QueuedJobs.Num() > 0)
+		if (CurrentWorkerInfo.JobsToCompile.Num() > 0)
 		{
-			for (int32 JobIndex = 0; JobIndex < CurrentWorkerInfo.QueuedJobs.Num(); JobIndex++)
+			for (int32 JobIndex = 0; JobIndex < CurrentWorkerInfo.JobsToCompile.Num(); JobIndex++)
 			{
-				FShaderCompileJob& CurrentJob = *CurrentWorkerInfo.QueuedJobs[JobIndex];
+				FShaderCompileJob& CurrentJob = *CurrentWorkerInfo.JobsToCompile[JobIndex];
 
 				check(!CurrentJob.bFinalized);
 				CurrentJob.bFinalized = true;
@@ -903,6 +1233,11 @@ int32 FShaderCompileThreadRunnable::CompilingLoop()
 	// Grab more shader compile jobs from the input queue, and move completed jobs to Manager->ShaderMapJobs
 	const int32 NumActiveThreads = PullTasksFromQueue();
 
+	if (NumActiveThreads == 0 && JobCache.IsValid())
+	{
+		JobCache->LogStats();
+	}
+
 	if (NumActiveThreads == 0 && Manager->bAllowAsynchronousShaderCompiling)
 	{
 		// Yield while there's nothing to do
@@ -941,6 +1276,9 @@ int32 FShaderCompileThreadRunnable::CompilingLoop()
 		CompileDirectlyThroughDll();
 	}
 
+	// Cache the output of finished jobs and hand it to the identical jobs waiting for it
+	AddCompiledJobsToCache();
+
 	return NumActiveThreads;
 }
 
@@ -990,6 +1328,17 @@ FShaderCompilingManager::FShaderCompilingManager() :
 	verify(GConfig->GetInt( TEXT("DevOptions.Shaders"), TEXT("MaxShaderJobBatchSize"), MaxShaderJobBatchSize, GEngineIni ));
 	verify(GConfig->GetBool( TEXT("DevOptions.Shaders"), TEXT("bPromptToRetryFailedShaderCompiles"), bPromptToRetryFailedShaderCompiles, GEngineIni ));
 	verify(GConfig->GetBool( TEXT("DevOptions.Shaders"), TEXT("bLogJobCompletionTimes"), bLogJobCompletionTimes, GEngineIni ));
+	verify(GConfig->GetBool( TEXT("DevOptions.Shaders"), TEXT("bUseJobCache"), bUseJobCache, GEngineIni ));
+	verify(GConfig->GetBool( TEXT("DevOptions.Shaders"), TEXT("bUseJobCacheDDC"), bUseJobCacheDDC, GEngineIni ));
+
+	int32 JobCacheMemoryLimitMB;
+	verify(GConfig->GetInt( TEXT("DevOptions.Shaders"), TEXT("JobCacheMemoryLimitMB"), JobCacheMemoryLimitMB, GEngineIni ));
+	JobCacheMemoryLimit = (int64)JobCacheMemoryLimitMB * 1024 * 1024;
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("noshaderjobcache")))
+	{
+		bUseJobCache = false;
+	}
 
 #if PLATFORM_SUPPORTS_NAMED_PIPES
 	GShaderPipeConfig.ReadFromConfigIni();
@@ -1660,6 +2009,7 @@ bool FShaderCompilingManager::HandlePotentialRetryOnError(TMap<int32, FShaderMap
 					// NOTE: Changes to MaterialTemplate.usf before retrying won't work, because the entry for Material.usf in CurrentJob.Environment.IncludeFileNameToContentsMap isn't reset
 					CurrentJob.Output = FShaderCompilerOutput();
 					CurrentJob.bFinalized = false;
+					CurrentJob.SourceHash = GetShaderJobSourceHash(CurrentJob.ShaderType, CurrentJob.VFType);
 				}
 
 				// Send all the shaders from this shader map through the compiler again
@@ -1871,6 +2221,7 @@ void GlobalBeginCompileShader(
 	Input.ShaderFormat = LegacyShaderPlatformToShaderFormat(EShaderPlatform(Target.Platform));
 	Input.SourceFilename = SourceFilename;
 	Input.EntryPointName = FunctionName;
+	NewJob->SourceHash = GetShaderJobSourceHash(ShaderType, VFType);
 
 	if (GDumpShaderDebugInfo != 0)
 	{
@@ -0,0 +1,199 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	InstanceClusterTreeBenchmark.cpp: Instances drawn and cull time per view of
+	a whole instanced component, per instance culling and the cluster tree.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "InstanceClusterTree.h"
+
+/** Number of instances in the benchmark component. */
+static const int32 InstanceClusterBenchmarkNumInstances = 1000000;
+
+/** Number of views the instances are culled against. */
+static const int32 InstanceClusterBenchmarkNumViews = 8;
+
+/** Maximum number of instances in a leaf cluster. */
+static const int32 InstanceClusterBenchmarkInstancesPerLeaf = 16;
+
+/** Half the size of the square the instances are spread over. */
+static const float InstanceClusterBenchmarkWorldExtent = 200000.0f;
+
+/** Distance beyond which instances are culled, like InstanceEndCullDistance of foliage. */
+static const float InstanceClusterBenchmarkCullDistance = 30000.0f;
+
+/** Number of LODs of the benchmark mesh. */
+static const int32 InstanceClusterBenchmarkNumLODs = 4;
+
+/** Instances drawn and milliseconds spent for all views with one of the culling methods. */
+struct FInstanceClusterBenchmarkResult
+{
+	double Time;
+	int64 NumInstances;
+	int64 NumRanges;
+	int64 NumInstancesPerLOD[InstanceClusterBenchmarkNumLODs];
+
+	FInstanceClusterBenchmarkResult()
+		: Time(0.0)
+		, NumInstances(0)
+		, NumRanges(0)
+	{
+		FMemory::Memzero(NumInstancesPerLOD, sizeof(NumInstancesPerLOD));
+	}
+};
+
+/** Returns true if an instance is visible, the way the tree culls a node with just that instance. */
+static bool IsInstanceVisible(const FBox& InstanceBox, const FInstanceClusterCullParams& Params)
+{
+	const FVector Center = InstanceBox.GetCenter();
+	const FVector Extent = InstanceBox.GetExtent();
+	const FVector ToClosest = ((Center - Params.ViewOrigin).GetAbs() - Extent).ComponentMax(FVector::ZeroVector);
+
+	return ToClosest.SizeSquared() <= FMath::Square(Params.MaxDistance) && Params.Frustum->IntersectBox(Center, Extent);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInstanceClusterTreeBenchmark, "Engine.Instance Cluster Tree Benchmark", EAutomationTestFlags::ATF_Editor | EAutomationTestFlags::ATF_Commandlet)
+
+/**
+ * Spreads a million instances over a terrain sized area and culls them against several views as one primitive, one instance
+ * at a time and with a cluster tree. The tree has to keep every instance that per instance culling keeps.
+ */
+bool FInstanceClusterTreeBenchmark::RunTest(const FString& Parameters)
+{
+	FRandomStream RandomStream(0x51a7);
+
+	TArray<FBox> InstanceBoxes;
+	InstanceBoxes.AddUninitialized(InstanceClusterBenchmarkNumInstances);
+
+	for (int32 Index = 0; Index < InstanceClusterBenchmarkNumInstances; ++Index)
+	{
+		const FVector Location(
+			RandomStream.FRandRange(-InstanceClusterBenchmarkWorldExtent, InstanceClusterBenchmarkWorldExtent),
+			RandomStream.FRandRange(-InstanceClusterBenchmarkWorldExtent, InstanceClusterBenchmarkWorldExtent),
+			RandomStream.FRandRange(-1000.0f, 1000.0f)
+			);
+		const float Scale = RandomStream.FRandRange(0.5f, 2.0f);
+		InstanceBoxes[Index] = FBox(Location - FVector(100.0f, 100.0f, 0.0f) * Scale, Location + FVector(100.0f, 100.0f, 300.0f) * Scale);
+	}
+
+	double StartTime = FPlatformTime::Seconds();
+	FInstanceClusterTree ClusterTree;
+	ClusterTree.Build(InstanceBoxes, InstanceClusterBenchmarkInstancesPerLeaf);
+	const double BuildTime = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	const FBox ComponentBox = ClusterTree.GetBounds();
+
+	FInstanceClusterBenchmarkResult ComponentResult;
+	FInstanceClusterBenchmarkResult InstanceResult;
+	FInstanceClusterBenchmarkResult TreeResult;
+	int32 NumMissingInstances = 0;
+
+	TBitArray<> TreeVisibility;
+	TArray<FInstanceClusterRange> RangesPerLOD[MAX_STATIC_MESH_LODS];
+
+	for (int32 ViewIndex = 0; ViewIndex < InstanceClusterBenchmarkNumViews; ++ViewIndex)
+	{
+		// Views a few meters above the ground, looking roughly along it
+		const FVector ViewLocation(
+			RandomStream.FRandRange(-InstanceClusterBenchmarkWorldExtent, InstanceClusterBenchmarkWorldExtent),
+			RandomStream.FRandRange(-InstanceClusterBenchmarkWorldExtent, InstanceClusterBenchmarkWorldExtent),
+			RandomStream.FRandRange(200.0f, 2000.0f)
+			);
+		const FRotator ViewRotation(RandomStream.FRandRange(-30.0f, 10.0f), RandomStream.FRandRange(-180.0f, 180.0f), 0.0f);
+		const FMatrix ViewMatrix = FTranslationMatrix(-ViewLocation) * FInverseRotationMatrix(ViewRotation) * FMatrix(
+			FPlane(0, 0, 1, 0),
+			FPlane(1, 0, 0, 0),
+			FPlane(0, 1, 0, 0),
+			FPlane(0, 0, 0, 1));
+		const FMatrix ProjectionMatrix = FPerspectiveMatrix(PI / 4.0f, 1920.0f, 1080.0f, 10.0f, 2.0f * InstanceClusterBenchmarkWorldExtent);
+
+		FConvexVolume Frustum;
+		GetViewFrustumBounds(Frustum, ViewMatrix * ProjectionMatrix, true);
+
+		FInstanceClusterCullParams Params;
+		Params.Frustum = &Frustum;
+		Params.ViewOrigin = ViewLocation;
+		Params.MaxDistance = InstanceClusterBenchmarkCullDistance;
+		Params.NumLODs = InstanceClusterBenchmarkNumLODs;
+		for (int32 LODIndex = 1; LODIndex < InstanceClusterBenchmarkNumLODs; ++LODIndex)
+		{
+			Params.LODDistances[LODIndex] = 2500.0f * (1 << LODIndex);
+		}
+		Params.LODDistances[InstanceClusterBenchmarkNumLODs] = WORLD_MAX;
+
+		// The whole component is one primitive, every instance is drawn if any part of it is visible
+		StartTime = FPlatformTime::Seconds();
+		const bool bComponentVisible = IsInstanceVisible(ComponentBox, Params);
+		ComponentResult.Time += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		ComponentResult.NumInstances += bComponentVisible ? InstanceClusterBenchmarkNumInstances : 0;
+		ComponentResult.NumRanges += bComponentVisible ? 1 : 0;
+
+		// Every instance on its own, the fewest instances any bounds based culling can draw
+		TBitArray<> InstanceVisibility(false, InstanceClusterBenchmarkNumInstances);
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < InstanceClusterBenchmarkNumInstances; ++Index)
+		{
+			if (IsInstanceVisible(InstanceBoxes[Index], Params))
+			{
+				InstanceVisibility[Index] = true;
+				InstanceResult.NumInstances++;
+			}
+		}
+		InstanceResult.Time += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		for (int32 LODIndex = 0; LODIndex < InstanceClusterBenchmarkNumLODs; ++LODIndex)
+		{
+			RangesPerLOD[LODIndex].Reset();
+		}
+
+		StartTime = FPlatformTime::Seconds();
+		TreeResult.NumInstances += ClusterTree.Cull(Params, RangesPerLOD);
+		TreeResult.Time += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		TreeVisibility.Init(false, InstanceClusterBenchmarkNumInstances);
+		for (int32 LODIndex = 0; LODIndex < InstanceClusterBenchmarkNumLODs; ++LODIndex)
+		{
+			TreeResult.NumRanges += RangesPerLOD[LODIndex].Num();
+			for (int32 RangeIndex = 0; RangeIndex < RangesPerLOD[LODIndex].Num(); ++RangeIndex)
+			{
+				const FInstanceClusterRange& Range = RangesPerLOD[LODIndex][RangeIndex];
+				TreeResult.NumInstancesPerLOD[LODIndex] += Range.NumInstances;
+				for (int32 Index = Range.FirstInstance; Index < Range.FirstInstance + Range.NumInstances; ++Index)
+				{
+					TreeVisibility[ClusterTree.SortedInstances[Index]] = true;
+				}
+			}
+		}
+
+		for (int32 Index = 0; Index < InstanceClusterBenchmarkNumInstances; ++Index)
+		{
+			if (InstanceVisibility[Index] && !TreeVisibility[Index])
+			{
+				NumMissingInstances++;
+			}
+		}
+	}
+
+	// Per instance culling counts one range per instance, which is what drawing its result would take
+	InstanceResult.NumRanges = InstanceResult.NumInstances;
+
+	if (NumMissingInstances > 0)
+	{
+		AddError(FString::Printf(TEXT("Cluster tree culled %d instances that are visible"), NumMissingInstances));
+	}
+
+	const int32 NumViews = InstanceClusterBenchmarkNumViews;
+
+	AddLogItem(FString::Printf(TEXT("%d instances, %d views, %d instances per leaf, %d nodes built in %.1f ms"), InstanceClusterBenchmarkNumInstances, NumViews, InstanceClusterBenchmarkInstancesPerLeaf, ClusterTree.Nodes.Num(), BuildTime));
+	AddLogItem(FString::Printf(TEXT("                  %12s %12s %12s"), TEXT("Component"), TEXT("PerInstance"), TEXT("ClusterTree")));
+	AddLogItem(FString::Printf(TEXT("instances/view    %12lld %12lld %12lld"), ComponentResult.NumInstances / NumViews, InstanceResult.NumInstances / NumViews, TreeResult.NumInstances / NumViews));
+	AddLogItem(FString::Printf(TEXT("ranges/view       %12lld %12lld %12lld"), ComponentResult.NumRanges / NumViews, InstanceResult.NumRanges / NumViews, TreeResult.NumRanges / NumViews));
+	AddLogItem(FString::Printf(TEXT("ms/view           %12.3f %12.3f %12.3f"), ComponentResult.Time / NumViews, InstanceResult.Time / NumViews, TreeResult.Time / NumViews));
+	for (int32 LODIndex = 0; LODIndex < InstanceClusterBenchmarkNumLODs; ++LODIndex)
+	{
+		AddLogItem(FString::Printf(TEXT("LOD %d instances/view %lld"), LODIndex, TreeResult.NumInstancesPerLOD[LODIndex] / NumViews));
+	}
+
+	return NumMissingInstances == 0;
+}
@@ -0,0 +1,232 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	RepLayoutBenchmark.cpp: Compares per connection and shared property comparison
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Net/RepLayout.h"
+
+/** Number of simulated actors. */
+static const int32 RepBenchmarkNumActors = 256;
+
+/** Number of simulated connections every actor replicates to. */
+static const int32 RepBenchmarkNumConnections = 64;
+
+/** Number of simulated frames. */
+static const int32 RepBenchmarkNumFrames = 30;
+
+/** Fraction of the actors that change some properties each frame. */
+static const float RepBenchmarkChangedActorFraction = 0.25f;
+
+/**
+ * Changes a replicated value, recursing into structs to find something that can be changed.
+ *
+ * @return true if the value was changed
+ */
+static bool MutateRepBenchmarkValue( UProperty * Property, void * Value, FRandomStream & RandomStream )
+{
+	if ( UFloatProperty * FloatProperty = Cast< UFloatProperty >( Property ) )
+	{
+		FloatProperty->SetPropertyValue( Value, FloatProperty->GetPropertyValue( Value ) + 1.0f );
+		return true;
+	}
+	if ( UIntProperty * IntProperty = Cast< UIntProperty >( Property ) )
+	{
+		IntProperty->SetPropertyValue( Value, IntProperty->GetPropertyValue( Value ) + 1 );
+		return true;
+	}
+	if ( UByteProperty * ByteProperty = Cast< UByteProperty >( Property ) )
+	{
+		// Stay inside the enum so the value is still valid
+		const uint8 NumValues = ByteProperty->Enum ? ByteProperty->Enum->NumEnums() - 1 : 255;
+		ByteProperty->SetPropertyValue( Value, NumValues > 0 ? ( ByteProperty->GetPropertyValue( Value ) + 1 ) % NumValues : 0 );
+		return NumValues > 1;
+	}
+	if ( UBoolProperty * BoolProperty = Cast< UBoolProperty >( Property ) )
+	{
+		BoolProperty->SetPropertyValue( Value, !BoolProperty->GetPropertyValue( Value ) );
+		return true;
+	}
+	if ( UStructProperty * StructProperty = Cast< UStructProperty >( Property ) )
+	{
+		TArray< UProperty * > Fields;
+		for ( TFieldIterator< UProperty > It( StructProperty->Struct ); It; ++It )
+		{
+			Fields.Add( *It );
+		}
+		for ( int32 Attempt = 0; Attempt < Fields.Num(); Attempt++ )
+		{
+			UProperty * Field = Fields[ RandomStream.RandHelper( Fields.Num() ) ];
+			if ( MutateRepBenchmarkValue( Field, Field->ContainerPtrToValuePtr< void >( Value ), RandomStream ) )
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FRepLayoutSharedChangelistBenchmark, "Networking.Replication.Shared Changelist Benchmark", EAutomationTestFlags::ATF_Editor | EAutomationTestFlags::ATF_Commandlet )
+
+/**
+ * Replicates ACharacter properties from RepBenchmarkNumActors actors to RepBenchmarkNumConnections connections, once
+ * comparing every actor for every connection, and once comparing every actor once per frame into a shared history that
+ * the connections merge from. Connections replicate every 1 to 3 frames so the shared history holds more than one frame.
+ * Only the property comparison is timed, nothing is serialized.
+ */
+bool FRepLayoutSharedChangelistBenchmark::RunTest( const FString & Parameters )
+{
+	UClass * ActorClass = ACharacter::StaticClass();
+
+	TSharedPtr< FRepLayout > RepLayout = MakeShareable( new FRepLayout() );
+	RepLayout->InitFromObjectClass( ActorClass );
+
+	TSharedPtr< FRepChangedPropertyTracker > ChangedTracker = MakeShareable( new FRepChangedPropertyTracker() );
+	RepLayout->InitChangedTracker( ChangedTracker.Get() );
+
+	// Properties the benchmark changes
+	TArray< UProperty * > MutableProperties;
+	for ( TFieldIterator< UProperty > It( ActorClass ); It; ++It )
+	{
+		UStructProperty * StructProperty = Cast< UStructProperty >( *It );
+		if ( ( It->PropertyFlags & CPF_Net ) && !( StructProperty && ( StructProperty->Struct->StructFlags & STRUCT_NetDeltaSerializeNative ) ) )
+		{
+			MutableProperties.Add( *It );
+		}
+	}
+
+	if ( MutableProperties.Num() == 0 )
+	{
+		AddError( FString::Printf( TEXT( "%s has no replicated properties" ), *ActorClass->GetName() ) );
+		return false;
+	}
+
+	// The actors themselves live in FRepState buffers, which hold a constructed copy of every replicated property
+	uint8 * ActorDefaults = (uint8*)ActorClass->GetDefaultObject();
+
+	TIndirectArray< FRepState >				Actors;
+	TIndirectArray< FRepChangelistState >	PerConnectionStates;
+	TIndirectArray< FRepChangelistState >	SharedStates;
+	TIndirectArray< FRepState >				SharedConnections;
+
+	for ( int32 ActorIndex = 0; ActorIndex < RepBenchmarkNumActors; ActorIndex++ )
+	{
+		FRepState * Actor = new FRepState();
+		RepLayout->InitRepState( Actor, ActorClass, ActorDefaults, ChangedTracker );
+		Actor->RepLayout = RepLayout;
+		Actors.Add( Actor );
+
+		FRepChangelistState * SharedState = new FRepChangelistState();
+		RepLayout->InitChangelistState( SharedState, ActorClass, Actor->StaticBuffer.GetTypedData() );
+		SharedState->ShadowState.RepLayout = RepLayout;
+		SharedStates.Add( SharedState );
+
+		for ( int32 ConnectionIndex = 0; ConnectionIndex < RepBenchmarkNumConnections; ConnectionIndex++ )
+		{
+			// Per connection compares use a changelist state of their own, so both modes do the same work per compare
+			FRepChangelistState * PerConnectionState = new FRepChangelistState();
+			RepLayout->InitChangelistState( PerConnectionState, ActorClass, Actor->StaticBuffer.GetTypedData() );
+			PerConnectionState->ShadowState.RepLayout = RepLayout;
+			PerConnectionStates.Add( PerConnectionState );
+
+			// Shared compares only need to know what each connection has merged
+			FRepState * SharedConnection = new FRepState();
+			SharedConnection->LastChangelistIndex = 0;
+			SharedConnections.Add( SharedConnection );
+		}
+	}
+
+	// Whether the last per connection compare found anything, the shared history must not miss it
+	TArray< bool > PerConnectionChanged;
+	PerConnectionChanged.Init( false, RepBenchmarkNumActors * RepBenchmarkNumConnections );
+
+	FRandomStream RandomStream( 0x5eed );
+	TArray< uint16 > Changed;
+	double PerConnectionTime = 0.0;
+	double SharedTime = 0.0;
+	int32 NumMismatches = 0;
+
+	for ( uint32 Frame = 1; Frame <= RepBenchmarkNumFrames; Frame++ )
+	{
+		for ( int32 ActorIndex = 0; ActorIndex < RepBenchmarkNumActors; ActorIndex++ )
+		{
+			if ( RandomStream.GetFraction() < RepBenchmarkChangedActorFraction )
+			{
+				for ( int32 ChangeIndex = 0; ChangeIndex < 2; ChangeIndex++ )
+				{
+					UProperty * Property = MutableProperties[ RandomStream.RandHelper( MutableProperties.Num() ) ];
+					MutateRepBenchmarkValue( Property, Property->ContainerPtrToValuePtr< void >( Actors[ActorIndex].StaticBuffer.GetTypedData() ), RandomStream );
+				}
+			}
+		}
+
+		// Every connection compares every actor it replicates against its own shadow state
+		const double PerConnectionStartTime = FPlatformTime::Seconds();
+		for ( int32 ActorIndex = 0; ActorIndex < RepBenchmarkNumActors; ActorIndex++ )
+		{
+			const uint8 * Data = Actors[ActorIndex].StaticBuffer.GetTypedData();
+
+			for ( int32 ConnectionIndex = 0; ConnectionIndex < RepBenchmarkNumConnections; ConnectionIndex++ )
+			{
+				if ( ( Frame + ConnectionIndex ) % ( 1 + ConnectionIndex % 3 ) != 0 )
+				{
+					continue;
+				}
+
+				const int32 StateIndex = ActorIndex * RepBenchmarkNumConnections + ConnectionIndex;
+				FRepChangelistState & State = PerConnectionStates[StateIndex];
+				RepLayout->UpdateChangelistState( &State, Data, Frame );
+
+				PerConnectionChanged[StateIndex] = State.HistoryEnd > State.HistoryStart;
+
+				// Sent and acked right away
+				if ( PerConnectionChanged[StateIndex] )
+				{
+					State.ChangeHistory[ ( State.HistoryEnd - 1 ) % FRepChangelistState::MAX_CHANGE_HISTORY ].Changed.Reset();
+					State.HistoryStart = State.HistoryEnd;
+				}
+			}
+		}
+		PerConnectionTime += FPlatformTime::Seconds() - PerConnectionStartTime;
+
+		// Every actor is compared once, the connections merge the history they haven't sent
+		const double SharedStartTime = FPlatformTime::Seconds();
+		for ( int32 ActorIndex = 0; ActorIndex < RepBenchmarkNumActors; ActorIndex++ )
+		{
+			const uint8 * Data = Actors[ActorIndex].StaticBuffer.GetTypedData();
+
+			for ( int32 ConnectionIndex = 0; ConnectionIndex < RepBenchmarkNumConnections; ConnectionIndex++ )
+			{
+				if ( ( Frame + ConnectionIndex ) % ( 1 + ConnectionIndex % 3 ) != 0 )
+				{
+					continue;
+				}
+
+				RepLayout->UpdateChangelistState( &SharedStates[ActorIndex], Data, Frame );
+
+				const int32 StateIndex = ActorIndex * RepBenchmarkNumConnections + ConnectionIndex;
+				const bool bSharedChanged = RepLayout->MergeChangelistHistory( &SharedConnections[StateIndex], &SharedStates[ActorIndex], Data, Changed );
+
+				// The shared history can also hold changes that were undone since, so it only has to be a superset
+				if ( PerConnectionChanged[StateIndex] && !bSharedChanged )
+				{
+					NumMismatches++;
+				}
+			}
+		}
+		SharedTime += FPlatformTime::Seconds() - SharedStartTime;
+	}
+
+	if ( NumMismatches > 0 )
+	{
+		AddError( FString::Printf( TEXT( "Shared changelists missed changes found by per connection compares %d times" ), NumMismatches ) );
+	}
+
+	AddLogItem( FString::Printf( TEXT( "%s: %d actors, %d connections, %d frames, %d replicated properties" ),
+		*ActorClass->GetName(), RepBenchmarkNumActors, RepBenchmarkNumConnections, RepBenchmarkNumFrames, MutableProperties.Num() ) );
+	AddLogItem( FString::Printf( TEXT( "Per connection compare: %8.3f ms per frame" ), PerConnectionTime * 1000.0 / RepBenchmarkNumFrames ) );
+	AddLogItem( FString::Printf( TEXT( "Shared changelists:     %8.3f ms per frame" ), SharedTime * 1000.0 / RepBenchmarkNumFrames ) );
+
+	return NumMismatches == 0;
+}
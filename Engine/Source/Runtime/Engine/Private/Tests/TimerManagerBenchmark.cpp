@@ -0,0 +1,218 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	TimerManagerBenchmark.cpp: Timer set/query/clear/tick throughput
+=============================================================================*/
+
+#include "EnginePrivate.h"
+
+/** Number of timers that are set at once. */
+static const int32 TimerBenchmarkNumTimers = 20000;
+
+/** Number of simulated frames the timers are ticked for. */
+static const int32 TimerBenchmarkNumFrames = 60;
+
+UTimerManagerBenchmarkTarget::UTimerManagerBenchmarkTarget(const class FPostConstructInitializeProperties& PCIP)
+	: Super(PCIP)
+{
+	FMemory::Memzero(NumFired, sizeof(NumFired));
+}
+
+/** Returns the delegate of a benchmark timer, timers are spread over the objects UTimerManagerBenchmarkTarget::NumTimers at a time. */
+static FTimerDelegate GetTimerBenchmarkDelegate(TArray<UTimerManagerBenchmarkTarget*> const& Targets, int32 TimerIndex)
+{
+	typedef void (UTimerManagerBenchmarkTarget::*FOnTimer)();
+	static const FOnTimer OnTimerMethods[UTimerManagerBenchmarkTarget::NumTimers] =
+	{
+		&UTimerManagerBenchmarkTarget::OnTimer0,
+		&UTimerManagerBenchmarkTarget::OnTimer1,
+		&UTimerManagerBenchmarkTarget::OnTimer2,
+		&UTimerManagerBenchmarkTarget::OnTimer3,
+	};
+
+	UTimerManagerBenchmarkTarget* const Target = Targets[TimerIndex / UTimerManagerBenchmarkTarget::NumTimers];
+	return FTimerDelegate::CreateUObject(Target, OnTimerMethods[TimerIndex % UTimerManagerBenchmarkTarget::NumTimers]);
+}
+
+/** Returns how often a benchmark timer fired. */
+static int32 GetTimerBenchmarkNumFired(TArray<UTimerManagerBenchmarkTarget*> const& Targets, int32 TimerIndex)
+{
+	return Targets[TimerIndex / UTimerManagerBenchmarkTarget::NumTimers]->NumFired[TimerIndex % UTimerManagerBenchmarkTarget::NumTimers];
+}
+
+/** Creates the objects for TimerBenchmarkNumTimers timers, rooted so they stay around while the benchmark runs. */
+static void CreateTimerBenchmarkTargets(TArray<UTimerManagerBenchmarkTarget*>& OutTargets)
+{
+	const int32 NumTargets = TimerBenchmarkNumTimers / UTimerManagerBenchmarkTarget::NumTimers;
+	for (int32 Idx = 0; Idx < NumTargets; Idx++)
+	{
+		UTimerManagerBenchmarkTarget* const Target = ConstructObject<UTimerManagerBenchmarkTarget>(UTimerManagerBenchmarkTarget::StaticClass());
+		Target->AddToRoot();
+		OutTargets.Add(Target);
+	}
+}
+
+/** Lets the garbage collector have the benchmark objects again. */
+static void DestroyTimerBenchmarkTargets(TArray<UTimerManagerBenchmarkTarget*>& Targets)
+{
+	for (int32 Idx = 0; Idx < Targets.Num(); Idx++)
+	{
+		Targets[Idx]->RemoveFromRoot();
+		Targets[Idx]->MarkPendingKill();
+	}
+	Targets.Empty();
+}
+
+/** Milliseconds spent on each phase of a benchmark run. */
+struct FTimerBenchmarkTimes
+{
+	double Set;
+	double Query;
+	double Tick;
+	double Clear;
+	double ClearAll;
+};
+
+/**
+ * Sets TimerBenchmarkNumTimers looping timers bound to the targets, queries each, ticks them for TimerBenchmarkNumFrames
+ * frames, clears half of them one by one and the other half with ClearAllTimersForObject.
+ *
+ * @param bUseHandles	Use the handle based API instead of finding timers by delegate
+ * @param OutNumErrors	Incremented for every query that returned the wrong result
+ */
+static FTimerBenchmarkTimes RunTimerBenchmark(TArray<UTimerManagerBenchmarkTarget*> const& Targets, TArray<float> const& Rates, bool bUseHandles, int32& OutNumErrors)
+{
+	FTimerBenchmarkTimes Times;
+	FTimerManager TimerManager;
+	TArray<FTimerHandle> Handles;
+	Handles.AddZeroed(TimerBenchmarkNumTimers);
+
+	// Timers set before the first tick of a frame are pending until then, the game sets most of its timers after
+	TimerManager.Tick(0.f);
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Idx = 0; Idx < TimerBenchmarkNumTimers; Idx++)
+	{
+		FTimerDelegate const Delegate = GetTimerBenchmarkDelegate(Targets, Idx);
+		if (bUseHandles)
+		{
+			TimerManager.SetTimer(Handles[Idx], Delegate, Rates[Idx], true);
+		}
+		else
+		{
+			TimerManager.SetTimer(Delegate, Rates[Idx], true);
+		}
+	}
+	Times.Set = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Idx = 0; Idx < TimerBenchmarkNumTimers; Idx++)
+	{
+		const bool bActive = bUseHandles ?
+			TimerManager.IsTimerActive(Handles[Idx]) :
+			TimerManager.IsTimerActive(GetTimerBenchmarkDelegate(Targets, Idx));
+		if (!bActive)
+		{
+			OutNumErrors++;
+		}
+	}
+	Times.Query = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < TimerBenchmarkNumFrames; Frame++)
+	{
+		TimerManager.Tick(1.f / 30.f);
+	}
+	Times.Tick = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	// the timers of the first half of the objects are cleared one by one
+	const int32 NumClearedSingly = (Targets.Num() / 2) * UTimerManagerBenchmarkTarget::NumTimers;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Idx = 0; Idx < NumClearedSingly; Idx++)
+	{
+		if (bUseHandles)
+		{
+			TimerManager.ClearTimer(Handles[Idx]);
+		}
+		else
+		{
+			TimerManager.ClearTimer(GetTimerBenchmarkDelegate(Targets, Idx));
+		}
+	}
+	Times.Clear = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Idx = Targets.Num() / 2; Idx < Targets.Num(); Idx++)
+	{
+		TimerManager.ClearAllTimersForObject(Targets[Idx]);
+	}
+	Times.ClearAll = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	for (int32 Idx = 0; Idx < TimerBenchmarkNumTimers; Idx++)
+	{
+		if (TimerManager.IsTimerActive(GetTimerBenchmarkDelegate(Targets, Idx)) || TimerManager.TimerExists(Handles[Idx]))
+		{
+			OutNumErrors++;
+		}
+	}
+
+	return Times;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimerManagerBenchmark, "Engine.Timers.Timer Throughput Benchmark", EAutomationTestFlags::ATF_Editor | EAutomationTestFlags::ATF_Commandlet)
+
+/**
+ * Runs TimerBenchmarkNumTimers looping timers, bound to UObjects a few at a time like gameplay timers, through the
+ * delegate based and the handle based API. Both runs have to fire every timer the same number of times.
+ */
+bool FTimerManagerBenchmark::RunTest(const FString& Parameters)
+{
+	FRandomStream RandomStream(0x7173);
+	TArray<float> Rates;
+	for (int32 Idx = 0; Idx < TimerBenchmarkNumTimers; Idx++)
+	{
+		Rates.Add(RandomStream.FRandRange(0.1f, 2.f));
+	}
+
+	TArray<UTimerManagerBenchmarkTarget*> DelegateTargets;
+	TArray<UTimerManagerBenchmarkTarget*> HandleTargets;
+	CreateTimerBenchmarkTargets(DelegateTargets);
+	CreateTimerBenchmarkTargets(HandleTargets);
+
+	int32 NumErrors = 0;
+	const FTimerBenchmarkTimes DelegateTimes = RunTimerBenchmark(DelegateTargets, Rates, false, NumErrors);
+	const FTimerBenchmarkTimes HandleTimes = RunTimerBenchmark(HandleTargets, Rates, true, NumErrors);
+
+	int32 NumMismatches = 0;
+	int64 NumFired = 0;
+	for (int32 Idx = 0; Idx < TimerBenchmarkNumTimers; Idx++)
+	{
+		NumFired += GetTimerBenchmarkNumFired(HandleTargets, Idx);
+		if (GetTimerBenchmarkNumFired(DelegateTargets, Idx) != GetTimerBenchmarkNumFired(HandleTargets, Idx))
+		{
+			NumMismatches++;
+		}
+	}
+
+	DestroyTimerBenchmarkTargets(DelegateTargets);
+	DestroyTimerBenchmarkTargets(HandleTargets);
+
+	if (NumErrors > 0)
+	{
+		AddError(FString::Printf(TEXT("%d timer queries returned the wrong result"), NumErrors));
+	}
+	if (NumMismatches > 0)
+	{
+		AddError(FString::Printf(TEXT("%d timers fired a different number of times through handles and delegates"), NumMismatches));
+	}
+
+	AddLogItem(FString::Printf(TEXT("%d looping timers on %d objects, %d frames, %lld timer calls"), TimerBenchmarkNumTimers, TimerBenchmarkNumTimers / UTimerManagerBenchmarkTarget::NumTimers, TimerBenchmarkNumFrames, NumFired));
+	AddLogItem(FString::Printf(TEXT("            %10s %10s"), TEXT("Delegate"), TEXT("Handle")));
+	AddLogItem(FString::Printf(TEXT("Set         %8.2fms %8.2fms"), DelegateTimes.Set, HandleTimes.Set));
+	AddLogItem(FString::Printf(TEXT("IsActive    %8.2fms %8.2fms"), DelegateTimes.Query, HandleTimes.Query));
+	AddLogItem(FString::Printf(TEXT("Tick        %8.2fms %8.2fms"), DelegateTimes.Tick, HandleTimes.Tick));
+	AddLogItem(FString::Printf(TEXT("Clear       %8.2fms %8.2fms"), DelegateTimes.Clear, HandleTimes.Clear));
+	AddLogItem(FString::Printf(TEXT("ClearAll    %8.2fms %8.2fms"), DelegateTimes.ClearAll, HandleTimes.ClearAll));
+
+	return NumErrors == 0 && NumMismatches == 0;
+}
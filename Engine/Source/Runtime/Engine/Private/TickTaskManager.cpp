@@ -18,6 +18,8 @@ DECLARE_CYCLE_STAT(TEXT("Queue Ticks Wait"),STAT_QueueTicksWait,STATGROUP_Game);
 DECLARE_CYCLE_STAT(TEXT("Queue Tick Task"),STAT_QueueTickTask,STATGROUP_Game);
 DECLARE_CYCLE_STAT(TEXT("Post Queue Tick Task"),STAT_PostTickTask,STATGROUP_Game);
 DECLARE_DWORD_COUNTER_STAT(TEXT("Ticks Queued"),STAT_TicksQueued,STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Interval Ticks Queued"),STAT_IntervalTicksQueued,STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Interval Ticks Skipped"),STAT_IntervalTicksSkipped,STATGROUP_Game);
 
 static TAutoConsoleVariable<int32> CVarLogTicks(
 	TEXT("LogTicks"),0,
@@ -118,6 +120,11 @@ public:
 		bool bIsOriginalTickGroup = (TickFunction->ActualTickGroup == TickFunction->TickGroup);
 
 		UseContext.Thread = ENamedThreads::GameThread;
+		if (TickFunction->bTickOnInterval)
+		{
+			// interval ticks get all of the time since they last ticked
+			UseContext.DeltaSeconds = TickFunction->IntervalDeltaSeconds;
+		}
 		if (TickFunction->bRunOnAnyThread && bAllowConcurrentTicks && bIsOriginalTickGroup)
 		{
 			UseContext.Thread = ENamedThreads::AnyThread;
@@ -334,6 +341,7 @@ public:
 	FTickTaskLevel()
 		: TickTaskSequencer(FTickTaskSequencer::Get())
 		, bTickNewlySpawned(false)
+		, LevelTime(0.0)
 	{
 	}
 	~FTickTaskLevel()
@@ -342,6 +350,12 @@ public:
 		{
 			(*It)->bRegistered = false;
 		}
+		for (int32 Index = 0; Index < CoolingDownTickFunctions.Num(); Index++)
+		{
+			CoolingDownTickFunctions[Index]->bRegistered = false;
+			CoolingDownTickFunctions[Index]->bTickOnInterval = false;
+			CoolingDownTickFunctions[Index]->CoolingDownIndex = INDEX_NONE;
+		}
 		for (TSet<FTickFunction *>::TIterator It(AllDisabledTickFunctions); It; ++It)
 		{
 			(*It)->bRegistered = false;
@@ -361,7 +375,8 @@ public:
 		Context.TickType = InContext.TickType;
 		Context.Thread = ENamedThreads::GameThread;
 		bTickNewlySpawned = true;
-		return AllEnabledTickFunctions.Num();
+		ScheduleIntervalTicks();
+		return AllEnabledTickFunctions.Num() + DueTickFunctions.Num();
 	}
 	/* Queue all tick functions for execution */
 	void QueueAllTicks()
@@ -370,12 +385,26 @@ public:
 		{
 			(*It)->QueueTickFunction(Context);
 		}
+		for (int32 Index = 0; Index < DueTickFunctions.Num(); Index++)
+		{
+			DueTickFunctions[Index]->QueueTickFunction(Context);
+		}
 	}
 	/* Retrieve the tick set */
 	TSet<FTickFunction *>& GetTickSet()
 	{
 		return AllEnabledTickFunctions;
 	}
+	/* Retrieve the interval tick functions that are due this frame */
+	const TArray<FTickFunction *>& GetDueTickFunctions() const
+	{
+		return DueTickFunctions;
+	}
+	/** @return the number of interval tick functions that are not due this frame **/
+	int32 GetNumCoolingDown() const
+	{
+		return CoolingDownTickFunctions.Num() - DueTickFunctions.Num();
+	}
 	/**
 	 * Queues the newly spawned ticks for this level
 	 * @return - the number of items 
@@ -403,14 +432,12 @@ public:
 		check(!NewlySpawnedTickFunctions.Num()); // There shouldn't be any in here at this point in the frame
 		for (TSet<FTickFunction *>::TIterator It(AllEnabledTickFunctions); It; ++It)
 		{
-			FTickFunction* TickFunction = *It;
-			TickFunction->CompletionHandle = NULL; // might as well NULL this out to allow these handles to be recycled
-			if (TickFunction->bTickEvenWhenPaused && TickFunction->bTickEnabled && (!TickFunction->EnableParent || TickFunction->EnableParent->bTickEnabled))
-			{
-				TickFunction->TickVisitedGFrameCounter = GFrameCounter;
-				TickFunction->TickQueuedGFrameCounter = GFrameCounter;
-				TickFunction->ExecuteTick(InContext.DeltaSeconds, InContext.TickType, ENamedThreads::GameThread, FGraphEventRef());
-			}
+			RunPauseTick(*It, InContext);
+		}
+		// pause ticks ignore the tick interval
+		for (int32 Index = 0; Index < CoolingDownTickFunctions.Num(); Index++)
+		{
+			RunPauseTick(CoolingDownTickFunctions[Index], InContext);
 		}
 		check(!NewlySpawnedTickFunctions.Num()); // We don't support new spawns during pause ticks
 	}
@@ -419,6 +446,7 @@ public:
 	void EndFrame()
 	{
 		bTickNewlySpawned = false;
+		DueTickFunctions.Reset();
 		check(!NewlySpawnedTickFunctions.Num()); // hmmm, this might be ok, but basically anything that was added this late cannot be ticked until the next frame
 	}
 	// Interface that is private to FTickFunction
@@ -426,13 +454,23 @@ public:
 	/** Return true if this tick function is in the master list **/
 	bool HasTickFunction(FTickFunction* TickFunction)
 	{
+		if (TickFunction->bTickOnInterval)
+		{
+			const int32 Index = TickFunction->CoolingDownIndex;
+			return CoolingDownTickFunctions.IsValidIndex(Index) && CoolingDownTickFunctions[Index] == TickFunction;
+		}
 		return AllEnabledTickFunctions.Contains(TickFunction) || AllDisabledTickFunctions.Contains(TickFunction);
 	}
 	/** Add the tick function to the master list **/
 	void AddTickFunction(FTickFunction* TickFunction)
 	{
 		check(!HasTickFunction(TickFunction));
-		if (TickFunction->bTickEnabled)
+		if (TickFunction->bTickEnabled && TickFunction->TickInterval > 0.f)
+		{
+			// interval ticks don't tick as newly spawned, they wait until they are first due
+			ScheduleFirstIntervalTick(TickFunction);
+		}
+		else if (TickFunction->bTickEnabled)
 		{
 			AllEnabledTickFunctions.Add(TickFunction);
 			if (bTickNewlySpawned)
@@ -481,8 +519,12 @@ public:
 			{
 				DumpTickFunction(Ar, *It, TickGroupEnum);
 			}
+			for (int32 Index = 0; Index < CoolingDownTickFunctions.Num(); Index++)
+			{
+				DumpTickFunction(Ar, CoolingDownTickFunctions[Index], TickGroupEnum);
+			}
 		}
-		EnabledCount += AllEnabledTickFunctions.Num();
+		EnabledCount += AllEnabledTickFunctions.Num() + CoolingDownTickFunctions.Num();
 		if (bDisabled)
 		{
 			for (TSet<FTickFunction *>::TIterator It(AllDisabledTickFunctions); It; ++It)
@@ -496,7 +538,14 @@ public:
 	/** Remove the tick function from the master list **/
 	void RemoveTickFunction(FTickFunction* TickFunction)
 	{
-		if (TickFunction->bTickEnabled)
+		if (TickFunction->bTickOnInterval)
+		{
+			check(HasTickFunction(TickFunction));
+			RemoveCoolingDownAt(TickFunction->CoolingDownIndex);
+			DueTickFunctions.RemoveSingleSwap(TickFunction);
+			TickFunction->bTickOnInterval = false;
+		}
+		else if (TickFunction->bTickEnabled)
 		{
 			verify(AllEnabledTickFunctions.Remove(TickFunction) == 1); // otherwise you changed bEnabled while the tick function was registered. Call SetTickFunctionEnable instead.
 		}
@@ -512,9 +561,134 @@ public:
 
 private:
 
+	/** Puts a tick function at an index of the cooldown heap **/
+	FORCEINLINE void SetCoolingDown(int32 Index, FTickFunction* TickFunction)
+	{
+		CoolingDownTickFunctions[Index] = TickFunction;
+		TickFunction->CoolingDownIndex = Index;
+	}
+
+	/** Moves the tick function at an index of the cooldown heap up until its parent is due before it, @return its new index **/
+	int32 SiftUpCoolingDown(int32 Index)
+	{
+		FTickFunction* TickFunction = CoolingDownTickFunctions[Index];
+		while (Index > 0)
+		{
+			const int32 ParentIndex = (Index - 1) / 2;
+			FTickFunction* Parent = CoolingDownTickFunctions[ParentIndex];
+			if (Parent->NextTickTime <= TickFunction->NextTickTime)
+			{
+				break;
+			}
+			SetCoolingDown(Index, Parent);
+			Index = ParentIndex;
+		}
+		SetCoolingDown(Index, TickFunction);
+		return Index;
+	}
+
+	/** Moves the tick function at an index of the cooldown heap down until its children are due after it **/
+	void SiftDownCoolingDown(int32 Index)
+	{
+		FTickFunction* TickFunction = CoolingDownTickFunctions[Index];
+		const int32 Num = CoolingDownTickFunctions.Num();
+		for (int32 ChildIndex = 2 * Index + 1; ChildIndex < Num; ChildIndex = 2 * Index + 1)
+		{
+			if (ChildIndex + 1 < Num && CoolingDownTickFunctions[ChildIndex + 1]->NextTickTime < CoolingDownTickFunctions[ChildIndex]->NextTickTime)
+			{
+				ChildIndex++;
+			}
+			FTickFunction* Child = CoolingDownTickFunctions[ChildIndex];
+			if (TickFunction->NextTickTime <= Child->NextTickTime)
+			{
+				break;
+			}
+			SetCoolingDown(Index, Child);
+			Index = ChildIndex;
+		}
+		SetCoolingDown(Index, TickFunction);
+	}
+
+	/** Adds a tick function to the cooldown heap **/
+	void PushCoolingDown(FTickFunction* TickFunction)
+	{
+		SetCoolingDown(CoolingDownTickFunctions.AddUninitialized(), TickFunction);
+		SiftUpCoolingDown(TickFunction->CoolingDownIndex);
+	}
+
+	/** Removes the tick function at an index of the cooldown heap **/
+	void RemoveCoolingDownAt(int32 Index)
+	{
+		CoolingDownTickFunctions[Index]->CoolingDownIndex = INDEX_NONE;
+		FTickFunction* Last = CoolingDownTickFunctions.Pop(false);
+		if (Index < CoolingDownTickFunctions.Num())
+		{
+			// the last tick function may belong above or below the removed one
+			SetCoolingDown(Index, Last);
+			SiftDownCoolingDown(SiftUpCoolingDown(Index));
+		}
+	}
+
+	/** Executes a pause tick for a tick function if it ticks even when paused **/
+	FORCEINLINE void RunPauseTick(FTickFunction* TickFunction, const FTickContext& InContext)
+	{
+		TickFunction->CompletionHandle = NULL; // might as well NULL this out to allow these handles to be recycled
+		if (TickFunction->bTickEvenWhenPaused && TickFunction->bTickEnabled && (!TickFunction->EnableParent || TickFunction->EnableParent->bTickEnabled))
+		{
+			TickFunction->TickVisitedGFrameCounter = GFrameCounter;
+			TickFunction->TickQueuedGFrameCounter = GFrameCounter;
+			TickFunction->ExecuteTick(InContext.DeltaSeconds, InContext.TickType, ENamedThreads::GameThread, FGraphEventRef());
+		}
+	}
+
+	/**
+	 * Puts a newly added interval tick function in the cooldown heap.
+	 * Tick functions with the same interval are offset by the golden ratio of the interval from each other, which spreads
+	 * them evenly over the interval however many there are, so they don't all become due on the same frame.
+	 */
+	void ScheduleFirstIntervalTick(FTickFunction* TickFunction)
+	{
+		const float Interval = TickFunction->TickInterval;
+		uint32& NumScheduled = NumScheduledByInterval.FindOrAdd(Interval);
+		const float Phase = FMath::Fractional(NumScheduled * 0.618034f);
+		NumScheduled++;
+
+		TickFunction->bTickOnInterval = true;
+		TickFunction->LastTickTime = LevelTime;
+		TickFunction->NextTickTime = LevelTime + Interval * Phase;
+		PushCoolingDown(TickFunction);
+	}
+
+	/** Advances the level time and moves the interval tick functions that are due into DueTickFunctions **/
+	void ScheduleIntervalTicks()
+	{
+		LevelTime += Context.DeltaSeconds;
+		DueTickFunctions.Reset();
+
+		// due tick functions stay in the heap, they are rescheduled past the level time so each is only handed out once per frame
+		while (DueTickFunctions.Num() < CoolingDownTickFunctions.Num() && CoolingDownTickFunctions[0]->NextTickTime <= LevelTime)
+		{
+			FTickFunction* TickFunction = CoolingDownTickFunctions[0];
+
+			TickFunction->TickDueGFrameCounter = GFrameCounter;
+			TickFunction->IntervalDeltaSeconds = float(LevelTime - TickFunction->LastTickTime);
+			TickFunction->LastTickTime = LevelTime;
+
+			// keep the phase so the spread isn't lost, if more than one interval passed it is only ticked once
+			const float Interval = TickFunction->TickInterval;
+			TickFunction->NextTickTime += Interval;
+			if (TickFunction->NextTickTime <= LevelTime)
+			{
+				TickFunction->NextTickTime = LevelTime + Interval + FMath::Fmod(float(TickFunction->NextTickTime - LevelTime), Interval);
+			}
+			DueTickFunctions.Add(TickFunction);
+			SiftDownCoolingDown(0);
+		}
+	}
+
 	/** Global Sequencer														*/
 	FTickTaskSequencer&							TickTaskSequencer;
-	/** Master list of enabled tick functions **/
+	/** Master list of enabled tick functions that tick every frame **/
 	TSet<FTickFunction *>						AllEnabledTickFunctions;
 	/** Master list of disabled tick functions **/
 	TSet<FTickFunction *>						AllDisabledTickFunctions;
@@ -524,6 +698,14 @@ private:
 	FTickContext								Context;
 	/** true during the tick phase, when true, tick function adds also go to the newly spawned list. **/
 	bool										bTickNewlySpawned;
+	/** Enabled tick functions with a tick interval, a heap ordered by the level time they are next due at. Each tick function keeps its index in the heap so it can be removed without a search **/
+	TArray<FTickFunction *>						CoolingDownTickFunctions;
+	/** Interval tick functions that are due this frame **/
+	TArray<FTickFunction *>						DueTickFunctions;
+	/** Number of tick functions scheduled for each interval, used to spread them over the interval **/
+	TMap<float, uint32>							NumScheduledByInterval;
+	/** Seconds this level has ticked for, interval tick functions are scheduled against this **/
+	double										LevelTime;
 };
 
 /** Helper struct to hold completion items from parallel task. They are moved into a separate place for cache coherency **/
@@ -586,11 +768,17 @@ public:
 		TickTaskSequencer.StartFrame();
 		FillLevelList();
 		int32 TotalTickFunctions = 0;
+		int32 TotalDueTickFunctions = 0;
+		int32 TotalCoolingDownTickFunctions = 0;
 		for( int32 LevelIndex = 0; LevelIndex < LevelList.Num(); LevelIndex++ )
 		{
 			TotalTickFunctions += LevelList[LevelIndex]->StartFrame(Context);
+			TotalDueTickFunctions += LevelList[LevelIndex]->GetDueTickFunctions().Num();
+			TotalCoolingDownTickFunctions += LevelList[LevelIndex]->GetNumCoolingDown();
 		}
 		INC_DWORD_STAT_BY(STAT_TicksQueued, TotalTickFunctions);
+		INC_DWORD_STAT_BY(STAT_IntervalTicksQueued, TotalDueTickFunctions);
+		INC_DWORD_STAT_BY(STAT_IntervalTicksSkipped, TotalCoolingDownTickFunctions);
 
 		int32 NumWorkerThread = 0;
 		bool bConcurrentQueue;
@@ -644,27 +832,39 @@ public:
 			int32 NumTicksSoFar = 0;
 			int32 Task = 0;
 
+			// every frame ticks, then the interval ticks that are due this frame
+			int32 NumFilled = 0;
 			for( int32 LevelIndex = 0; LevelIndex < LevelList.Num(); LevelIndex++ )
 			{
 				for (TSet<FTickFunction *>::TIterator TickIt(LevelList[LevelIndex]->GetTickSet()); TickIt; ++TickIt)
 				{
-					AllTickFunctions[Start + NumTicksSoFar] = *TickIt;
-					NumTicksSoFar++;
-					if (NumTicksSoFar == NumThisTask)
+					AllTickFunctions[NumFilled++] = *TickIt;
+				}
+				const TArray<FTickFunction*>& DueTickFunctions = LevelList[LevelIndex]->GetDueTickFunctions();
+				for (int32 DueIndex = 0; DueIndex < DueTickFunctions.Num(); DueIndex++)
+				{
+					AllTickFunctions[NumFilled++] = DueTickFunctions[DueIndex];
+				}
+			}
+			check(NumFilled == AllTickFunctions.Num());
+
+			for (int32 TickIndex = 0; TickIndex < AllTickFunctions.Num(); TickIndex++)
+			{
+				NumTicksSoFar++;
+				if (NumTicksSoFar == NumThisTask)
+				{
+					check(Task < NumTasks);
+					FGraphEventArray Setup;
+					new (Setup) FGraphEventRef(TGraphTask<FQueueTickTasks>::CreateTask(NULL,ENamedThreads::GameThread).ConstructAndDispatchWhenReady(AllTickFunctions.GetTypedData() + Start, AllCompletionEvents.GetTypedData() + Start, NumThisTask, &Context));
+					new (QueueTickTasks) FGraphEventRef(TGraphTask<FPostTickTasks>::CreateTask(&Setup,ENamedThreads::GameThread).ConstructAndDispatchWhenReady(AllCompletionEvents.GetTypedData() + Start, NumThisTask));
+					Start += NumThisTask;
+					NumTicksSoFar = 0;
+
+					Task++;
+					if (Task + 1 == NumTasks)
 					{
-						check(Task < NumTasks);
-						FGraphEventArray Setup;
-						new (Setup) FGraphEventRef(TGraphTask<FQueueTickTasks>::CreateTask(NULL,ENamedThreads::GameThread).ConstructAndDispatchWhenReady(AllTickFunctions.GetTypedData() + Start, AllCompletionEvents.GetTypedData() + Start, NumThisTask, &Context));
-						new (QueueTickTasks) FGraphEventRef(TGraphTask<FPostTickTasks>::CreateTask(&Setup,ENamedThreads::GameThread).ConstructAndDispatchWhenReady(AllCompletionEvents.GetTypedData() + Start, NumThisTask));
-						Start += NumThisTask;
-						NumTicksSoFar = 0;
-
-						Task++;
-						if (Task + 1 == NumTasks)
-						{
-							// last task needs to take an remainder
-							NumThisTask = AllTickFunctions.Num() - Start;
-						}
+						// last task needs to take an remainder
+						NumThisTask = AllTickFunctions.Num() - Start;
 					}
 				}
 			}
@@ -958,10 +1158,17 @@ FTickFunction::FTickFunction()
 	, bCanEverTick(false)
 	, bAllowTickOnDedicatedServer(true)
 	, bRunOnAnyThread(false)
+	, TickInterval(0.f)
 	, bRegistered(false)
 	, bTickEnabled(true)
 	, TickVisitedGFrameCounter(0)
 	, TickQueuedGFrameCounter(0)
+	, bTickOnInterval(false)
+	, CoolingDownIndex(INDEX_NONE)
+	, TickDueGFrameCounter(0)
+	, NextTickTime(0.0)
+	, LastTickTime(0.0)
+	, IntervalDeltaSeconds(0.f)
 	, ActualTickGroup(TG_PrePhysics)
 	, EnableParent(NULL)
 	, TickTaskLevel(NULL)
@@ -1027,6 +1234,22 @@ void FTickFunction::SetTickFunctionEnable(bool bInEnabled)
 	}
 }
 
+/** Sets the seconds between ticks of this tick function, 0 or less ticks it every frame. **/
+void FTickFunction::SetTickInterval(float InTickInterval)
+{
+	if (bRegistered && TickInterval != InTickInterval)
+	{
+		check(TickTaskLevel);
+		TickTaskLevel->RemoveTickFunction(this);
+		TickInterval = InTickInterval;
+		TickTaskLevel->AddTickFunction(this);
+	}
+	else
+	{
+		TickInterval = InTickInterval;
+	}
+}
+
 /** 
  * Adds a tick function to the list of prerequisites...in other words, adds the requirement that TargetTickFunction is called before this tick function is 
  * @param TargetObject - UObject containing this tick function. Only used to verify that the other pointer is still usable
@@ -1060,7 +1283,7 @@ void FTickFunction::QueueTickFunction(const struct FTickContext& TickContext)
 	{
 		TickVisitedGFrameCounter = GFrameCounter;
 		CompletionHandle = NULL; // allow the old completion handle to be recycled
-		if (bTickEnabled && (!EnableParent || EnableParent->bTickEnabled))
+		if (bTickEnabled && (!EnableParent || EnableParent->bTickEnabled) && (!bTickOnInterval || TickDueGFrameCounter == GFrameCounter))
 		{
 			ETickingGroup MaxPrerequisiteTickGroup =  ETickingGroup(0);
 
@@ -1134,7 +1357,7 @@ void FTickFunction::QueueTickFunctionParallel(const FTickContext& TickContext, T
 	{
 		check(bRegistered);
 		CompletionHandle = NULL; // allow the old completion handle to be recycled
-		if (bTickEnabled && (!EnableParent || EnableParent->bTickEnabled))
+		if (bTickEnabled && (!EnableParent || EnableParent->bTickEnabled) && (!bTickOnInterval || TickDueGFrameCounter == GFrameCounter))
 		{
 			ETickingGroup MaxPrerequisiteTickGroup =  ETickingGroup(0);
 
@@ -1,78 +1,160 @@
 // Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
 
 /*=============================================================================
-	TickTaskManager.cpp: Manager for ticking tasks
+	TimerManager.cpp: Global gameplay timer facility
 =============================================================================*/
 
 #include "EnginePrivate.h"
 
+/** Stale heap entries are only dropped once there are at least this many, small heaps aren't worth compacting. */
+static const int32 MinStaleHeapEntriesToCompact = 1024;
 
 // ---------------------------------
 // Private members
 // ---------------------------------
 
-/** Will find and return a timer if it exists, regardless whether it is paused. */ 
-FTimerData const* FTimerManager::FindTimer(FTimerUnifiedDelegate const& InDelegate, int32* OutTimerIndex) const
+FTimerData const* FTimerManager::GetTimer(FTimerHandle InHandle) const
 {
-	int32 ActiveTimerIdx = FindTimerInList(ActiveTimerHeap, InDelegate);
-	if (ActiveTimerIdx != INDEX_NONE)
+	const int32 Index = InHandle.GetIndex();
+	if (InHandle.IsValid() && Index < Timers.GetMaxIndex() && Timers.IsAllocated(Index))
 	{
-		// found it in the active heap
-		if (OutTimerIndex)
+		FTimerData const& TimerData = Timers[Index];
+		if (TimerData.Handle == InHandle)
 		{
-			*OutTimerIndex = ActiveTimerIdx;
+			return &TimerData;
 		}
-		return &ActiveTimerHeap[ActiveTimerIdx];
 	}
+	return NULL;
+}
+
+FTimerData* FTimerManager::GetTimer(FTimerHandle InHandle)
+{
+	return const_cast<FTimerData*>(static_cast<FTimerManager const*>(this)->GetTimer(InHandle));
+}
+
+FTimerData const* FTimerManager::FindTimer(FTimerHandle InHandle) const
+{
+	FTimerData const* const TimerData = GetTimer(InHandle);
+	return (TimerData && TimerData->Status != ETimerStatus::Executing) ? TimerData : NULL;
+}
+
+FTimerData* FTimerManager::FindTimer(FTimerHandle InHandle)
+{
+	FTimerData* const TimerData = GetTimer(InHandle);
+	return (TimerData && TimerData->Status != ETimerStatus::Executing) ? TimerData : NULL;
+}
+
+/** Will find and return a timer if it exists, regardless whether it is paused. */
+FTimerData const* FTimerManager::FindTimer(FTimerUnifiedDelegate const& InDelegate) const
+{
+	return FindTimer(FindTimerHandle(InDelegate));
+}
 
-	int32 PausedTimerIdx = FindTimerInList(PausedTimerList, InDelegate);
-	if (PausedTimerIdx != INDEX_NONE)
+FTimerHandle FTimerManager::FindTimerHandle(FTimerUnifiedDelegate const& InDelegate) const
+{
+	TSet<FTimerHandle> const* const ObjectTimers = ObjectToTimers.Find(InDelegate.GetBoundObject());
+	if (ObjectTimers)
 	{
-		// found it in the paused list
-		if (OutTimerIndex)
+		for (TSet<FTimerHandle>::TConstIterator It(*ObjectTimers); It; ++It)
 		{
-			*OutTimerIndex = PausedTimerIdx;
+			FTimerData const* const TimerData = GetTimer(*It);
+			check(TimerData);
+			if (TimerData->TimerDelegate == InDelegate)
+			{
+				return *It;
+			}
 		}
-		return &PausedTimerList[PausedTimerIdx];
 	}
 
-	int32 PendingTimerIdx = FindTimerInList(PendingTimerList, InDelegate);
-	if (PendingTimerIdx != INDEX_NONE)
+	return FTimerHandle();
+}
+
+FTimerHandle FTimerManager::AddTimer(FTimerData const& TimerData)
+{
+	// serial numbers wrap around after 4 billion timers, skipping 0 so handles stay valid
+	if (++LastAssignedSerialNumber == 0)
 	{
-		// found it in the paused list
-		if (OutTimerIndex)
-		{
-			*OutTimerIndex = PendingTimerIdx;
-		}
-		return &PendingTimerList[PendingTimerIdx];
+		LastAssignedSerialNumber = 1;
 	}
 
-	return NULL;
+	const int32 Index = Timers.Add(TimerData);
+
+	FTimerData& NewTimerData = Timers[Index];
+	NewTimerData.Handle.SetIndexAndSerialNumber(Index, LastAssignedSerialNumber);
+	NewTimerData.TimerIndicesByObjectKey = NewTimerData.TimerDelegate.GetBoundObject();
+	ObjectToTimers.FindOrAdd(NewTimerData.TimerIndicesByObjectKey).Add(NewTimerData.Handle);
+
+	return NewTimerData.Handle;
 }
 
+void FTimerManager::RemoveTimer(FTimerHandle InHandle)
+{
+	FTimerData const* const TimerData = GetTimer(InHandle);
+	check(TimerData);
+
+	void const* const ObjectKey = TimerData->TimerIndicesByObjectKey;
+	TSet<FTimerHandle>* const ObjectTimers = ObjectToTimers.Find(ObjectKey);
+	check(ObjectTimers);
+	ObjectTimers->Remove(InHandle);
+	if (ObjectTimers->Num() == 0)
+	{
+		ObjectToTimers.Remove(ObjectKey);
+	}
+
+	Timers.RemoveAt(InHandle.GetIndex());
+}
 
-/** Will find the given timer in the given TArray and return its index. */ 
-int32 FTimerManager::FindTimerInList(const TArray<FTimerData> &SearchArray, FTimerUnifiedDelegate const& InDelegate) const
+void FTimerManager::PushActiveTimer(FTimerData& TimerData)
 {
-	for (int32 Idx=0; Idx<SearchArray.Num(); ++Idx)
+	TimerData.Status = ETimerStatus::Active;
+	TimerData.HeapSerialNumber = ++LastAssignedHeapSerialNumber;
+
+	FTimerHeapEntry Entry;
+	Entry.ExpireTime = TimerData.ExpireTime;
+	Entry.Handle = TimerData.Handle;
+	Entry.HeapSerialNumber = TimerData.HeapSerialNumber;
+	ActiveTimerHeap.HeapPush(Entry);
+}
+
+void FTimerManager::AddStaleHeapEntry()
+{
+	NumStaleHeapEntries++;
+
+	// Dropping the stale entries costs a heapify, which is paid for by the removals that made more than half the heap stale
+	if (NumStaleHeapEntries >= MinStaleHeapEntriesToCompact && NumStaleHeapEntries * 2 > ActiveTimerHeap.Num())
 	{
-		if (SearchArray[Idx].TimerDelegate == InDelegate)
+		for (int32 Idx=0; Idx<ActiveTimerHeap.Num(); ++Idx)
 		{
-			return Idx;
+			FTimerHeapEntry const& Entry = ActiveTimerHeap[Idx];
+			FTimerData const* const TimerData = GetTimer(Entry.Handle);
+			if (!TimerData || TimerData->Status != ETimerStatus::Active || TimerData->HeapSerialNumber != Entry.HeapSerialNumber)
+			{
+				ActiveTimerHeap.RemoveAtSwap(Idx--);
+			}
 		}
+		ActiveTimerHeap.Heapify();
+		NumStaleHeapEntries = 0;
 	}
-
-	return INDEX_NONE;
 }
 
 void FTimerManager::InternalSetTimer(FTimerUnifiedDelegate const& InDelegate, float InRate, bool InbLoop)
+{
+	// if the timer is already set, just clear it and we'll re-add it, since
+	// there's no data to maintain.
+	FTimerHandle Handle = FindTimerHandle(InDelegate);
+	InternalSetTimer(Handle, InDelegate, InRate, InbLoop);
+}
+
+void FTimerManager::InternalSetTimer(FTimerHandle& InOutHandle, FTimerUnifiedDelegate const& InDelegate, float InRate, bool InbLoop)
 {
 	// not currently threadsafe
 	check(IsInGameThread());
 
-	// if the timer is already set, just clear it and we'll re-add it, since 
-	// there's no data to maintain.
-	InternalClearTimer(InDelegate);
+	if (InOutHandle.IsValid())
+	{
+		InternalClearTimer(InOutHandle);
+		InOutHandle.Invalidate();
+	}
 
 	if (InRate > 0.f)
 	{
@@ -81,99 +163,101 @@ void FTimerManager::InternalSetTimer(FTimerUnifiedDelegate const& InDelegate, fl
 		NewTimerData.Rate = InRate;
 		NewTimerData.bLoop = InbLoop;
 		NewTimerData.TimerDelegate = InDelegate;
-		
+
+		InOutHandle = AddTimer(NewTimerData);
+		FTimerData& TimerData = *GetTimer(InOutHandle);
+
 		if( HasBeenTickedThisFrame() )
 		{
-			NewTimerData.ExpireTime = InternalTime + InRate;
-			NewTimerData.Status = ETimerStatus::Active;
-			ActiveTimerHeap.HeapPush(NewTimerData);
+			TimerData.ExpireTime = InternalTime + InRate;
+			PushActiveTimer(TimerData);
 		}
 		else
 		{
 			// Store time remaining in ExpireTime while pending
-			NewTimerData.ExpireTime = InRate;
-			NewTimerData.Status = ETimerStatus::Pending;
-			PendingTimerList.Add(NewTimerData);
+			TimerData.ExpireTime = InRate;
+			TimerData.Status = ETimerStatus::Pending;
+			PendingTimerSet.Add(InOutHandle);
 		}
 	}
 }
 
 void FTimerManager::InternalClearTimer(FTimerUnifiedDelegate const& InDelegate)
+{
+	InternalClearTimer(FindTimerHandle(InDelegate));
+}
+
+void FTimerManager::InternalClearTimer(FTimerHandle InHandle)
 {
 	// not currently threadsafe
 	check(IsInGameThread());
 
-	int32 TimerIdx;
-	FTimerData const* const TimerData = FindTimer(InDelegate, &TimerIdx);
+	FTimerData const* const TimerData = GetTimer(InHandle);
 	if( TimerData )
 	{
-		switch( TimerData->Status )
+		ETimerStatus::Type const Status = TimerData->Status;
+		RemoveTimer(InHandle);
+
+		switch( Status )
 		{
-			case ETimerStatus::Pending : PendingTimerList.RemoveAtSwap(TimerIdx); break;
-			case ETimerStatus::Active : ActiveTimerHeap.HeapRemoveAt(TimerIdx); break;
-			case ETimerStatus::Paused : PausedTimerList.RemoveAtSwap(TimerIdx); break;
+			case ETimerStatus::Pending : PendingTimerSet.Remove(InHandle); break;
+			// The heap entry is left behind and skipped when it reaches the top
+			case ETimerStatus::Active : AddStaleHeapEntry(); break;
+			case ETimerStatus::Paused : break;
+			// We're currently handling this timer when it got cleared. Removing it stops it from firing again
+			// in case it was scheduled to fire multiple times.
+			case ETimerStatus::Executing : break;
 			default : check(false);
 		}
 	}
-	else
-	{
-		// Edge case. We're currently handling this timer when it got cleared.  Unbind it to prevent it firing again
-		// in case it was scheduled to fire multiple times.
-		if (CurrentlyExecutingTimer.TimerDelegate == InDelegate)
-		{
-			CurrentlyExecutingTimer.TimerDelegate.Unbind();
-		}
-	}
 }
 
-
 void FTimerManager::InternalClearAllTimers(void const* Object)
 {
 	if (Object)
 	{
-		// search active timer heap for timers using this object and remove them
-		int32 const OldActiveHeapSize = ActiveTimerHeap.Num();
+		// clearing removes the handles from the sets being iterated
+		TArray<FTimerHandle> TimersToClear;
 
-		for (int32 Idx=0; Idx<ActiveTimerHeap.Num(); ++Idx)
+		TSet<FTimerHandle> const* const ObjectTimers = ObjectToTimers.Find(Object);
+		if (ObjectTimers)
 		{
-			if ( ActiveTimerHeap[Idx].TimerDelegate.IsBoundToObject(Object) )
+			TimersToClear.Reserve(ObjectTimers->Num());
+			for (TSet<FTimerHandle>::TConstIterator It(*ObjectTimers); It; ++It)
 			{
-				// remove this item
-				// this will break the heap property, but we will re-heapify afterward
-				ActiveTimerHeap.RemoveAtSwap(Idx--);
+				TimersToClear.Add(*It);
 			}
 		}
-		if (OldActiveHeapSize != ActiveTimerHeap.Num())
-		{
-			// need to heapify
-			ActiveTimerHeap.Heapify();
-		}
 
-		// search paused timer list for timers using this object and remove them, too
-		for (int32 Idx=0; Idx<PausedTimerList.Num(); ++Idx)
+		// raw and shared pointer delegates aren't indexed by their object
+		TSet<FTimerHandle> const* const UnindexedTimers = ObjectToTimers.Find(NULL);
+		if (UnindexedTimers)
 		{
-			if (PausedTimerList[Idx].TimerDelegate.IsBoundToObject(Object))
+			for (TSet<FTimerHandle>::TConstIterator It(*UnindexedTimers); It; ++It)
 			{
-				PausedTimerList.RemoveAtSwap(Idx--);
+				FTimerData const* const TimerData = GetTimer(*It);
+				check(TimerData);
+				if (TimerData->TimerDelegate.IsBoundToObject(Object))
+				{
+					TimersToClear.Add(*It);
+				}
 			}
 		}
 
-		// search pending timer list for timers using this object and remove them, too
-		for (int32 Idx=0; Idx<PendingTimerList.Num(); ++Idx)
+		for (int32 Idx=0; Idx<TimersToClear.Num(); ++Idx)
 		{
-			if (PendingTimerList[Idx].TimerDelegate.IsBoundToObject(Object))
-			{
-				PendingTimerList.RemoveAtSwap(Idx--);
-			}
+			InternalClearTimer(TimersToClear[Idx]);
 		}
 	}
 }
 
-
-
 float FTimerManager::InternalGetTimerRemaining(FTimerUnifiedDelegate const& InDelegate) const
 {
-	FTimerData const* const TimerData = FindTimer(InDelegate);
+	return InternalGetTimerRemaining(FindTimer(InDelegate));
+}
+
+float FTimerManager::InternalGetTimerRemaining(FTimerData const* TimerData) const
+{
 	if (TimerData)
 	{
 		if( TimerData->Status != ETimerStatus::Active )
@@ -192,7 +276,11 @@ float FTimerManager::InternalGetTimerRemaining(FTimerUnifiedDelegate const& InDe
 
 float FTimerManager::InternalGetTimerElapsed(FTimerUnifiedDelegate const& InDelegate) const
 {
-	FTimerData const* const TimerData = FindTimer(InDelegate);
+	return InternalGetTimerElapsed(FindTimer(InDelegate));
+}
+
+float FTimerManager::InternalGetTimerElapsed(FTimerData const* TimerData) const
+{
 	if (TimerData)
 	{
 		if( TimerData->Status != ETimerStatus::Active)
@@ -220,34 +308,42 @@ float FTimerManager::InternalGetTimerRate(FTimerUnifiedDelegate const& InDelegat
 }
 
 void FTimerManager::InternalPauseTimer(FTimerUnifiedDelegate const& InDelegate)
+{
+	PauseTimer(FindTimerHandle(InDelegate));
+}
+
+void FTimerManager::InternalUnPauseTimer(FTimerUnifiedDelegate const& InDelegate)
+{
+	UnPauseTimer(FindTimerHandle(InDelegate));
+}
+
+// ---------------------------------
+// Public members
+// ---------------------------------
+
+void FTimerManager::PauseTimer(FTimerHandle InHandle)
 {
 	// not currently threadsafe
 	check(IsInGameThread());
 
-	int32 TimerIdx;
-	FTimerData const* TimerToPause = FindTimer(InDelegate, &TimerIdx);
+	FTimerData* const TimerToPause = FindTimer(InHandle);
 	if( TimerToPause && (TimerToPause->Status != ETimerStatus::Paused) )
 	{
-		ETimerStatus::Type PreviousStatus = TimerToPause->Status;
-
-		// Add to Paused list
-		int32 NewIndex = PausedTimerList.Add(*TimerToPause);
+		ETimerStatus::Type const PreviousStatus = TimerToPause->Status;
 
 		// Set new status
-		FTimerData &NewTimer = PausedTimerList[NewIndex];
-		NewTimer.Status = ETimerStatus::Paused;
+		TimerToPause->Status = ETimerStatus::Paused;
 
-		// Remove from previous TArray
 		switch( PreviousStatus )
 		{
-			case ETimerStatus::Active : 
+			case ETimerStatus::Active :
 				// Store time remaining in ExpireTime while paused
-				NewTimer.ExpireTime = NewTimer.ExpireTime - InternalTime;
-				ActiveTimerHeap.HeapRemoveAt(TimerIdx); 
+				TimerToPause->ExpireTime = TimerToPause->ExpireTime - InternalTime;
+				AddStaleHeapEntry();
 				break;
-			
-			case ETimerStatus::Pending : 
-				PendingTimerList.RemoveAtSwap(TimerIdx); 
+
+			case ETimerStatus::Pending :
+				PendingTimerSet.Remove(InHandle);
 				break;
 
 			default : check(false);
@@ -255,40 +351,28 @@ void FTimerManager::InternalPauseTimer(FTimerUnifiedDelegate const& InDelegate)
 	}
 }
 
-void FTimerManager::InternalUnPauseTimer(FTimerUnifiedDelegate const& InDelegate)
+void FTimerManager::UnPauseTimer(FTimerHandle InHandle)
 {
 	// not currently threadsafe
 	check(IsInGameThread());
 
-	int32 PausedTimerIdx = FindTimerInList(PausedTimerList, InDelegate);
-	if (PausedTimerIdx != INDEX_NONE)
+	FTimerData* const TimerToUnPause = FindTimer(InHandle);
+	if( TimerToUnPause && (TimerToUnPause->Status == ETimerStatus::Paused) )
 	{
-		FTimerData& TimerToUnPause = PausedTimerList[PausedTimerIdx];
-		check(TimerToUnPause.Status == ETimerStatus::Paused);
-
-		// Move it out of paused list and into proper TArray
 		if( HasBeenTickedThisFrame() )
 		{
 			// Convert from time remaining back to a valid ExpireTime
-			TimerToUnPause.ExpireTime += InternalTime;
-			TimerToUnPause.Status = ETimerStatus::Active;
-			ActiveTimerHeap.HeapPush(TimerToUnPause);
+			TimerToUnPause->ExpireTime += InternalTime;
+			PushActiveTimer(*TimerToUnPause);
 		}
 		else
 		{
-			TimerToUnPause.Status = ETimerStatus::Pending;
-			PendingTimerList.Add(TimerToUnPause);
+			TimerToUnPause->Status = ETimerStatus::Pending;
+			PendingTimerSet.Add(InHandle);
 		}
-
-		// remove from paused list
-		PausedTimerList.RemoveAtSwap(PausedTimerIdx);
 	}
 }
 
-// ---------------------------------
-// Public members
-// ---------------------------------
-
 void FTimerManager::Tick(float DeltaTime)
 {
 	// @todo, might need to handle long-running case
@@ -298,42 +382,58 @@ void FTimerManager::Tick(float DeltaTime)
 
 	while (ActiveTimerHeap.Num() > 0)
 	{
-		FTimerData& Top = ActiveTimerHeap.HeapTop();
+		FTimerHeapEntry const& Top = ActiveTimerHeap.HeapTop();
+		FTimerData* TopTimer = GetTimer(Top.Handle);
+		if (!TopTimer || TopTimer->Status != ETimerStatus::Active || TopTimer->HeapSerialNumber != Top.HeapSerialNumber)
+		{
+			// The timer was cleared or paused after this entry was pushed
+			ActiveTimerHeap.HeapPopDiscard();
+			NumStaleHeapEntries--;
+			continue;
+		}
+
 		if (InternalTime > Top.ExpireTime)
 		{
 			// Timer has expired! Fire the delegate, then handle potential looping.
-
-			// Remove it from the heap and store it while we're executing
-			ActiveTimerHeap.HeapPop(CurrentlyExecutingTimer); 
+			FTimerHandle const Handle = Top.Handle;
+			ActiveTimerHeap.HeapPopDiscard();
+			TopTimer->Status = ETimerStatus::Executing;
 
 			// Determine how many times the timer may have elapsed (e.g. for large DeltaTime on a short looping timer)
-			int32 const CallCount = CurrentlyExecutingTimer.bLoop ? 
-				FMath::Trunc( (InternalTime - CurrentlyExecutingTimer.ExpireTime) / CurrentlyExecutingTimer.Rate ) + 1
+			int32 const CallCount = TopTimer->bLoop ?
+				FMath::Trunc( (InternalTime - TopTimer->ExpireTime) / TopTimer->Rate ) + 1
 				: 1;
 
+			// Setting timers in the delegate can grow the timer array, so call a copy of it
+			FTimerUnifiedDelegate TimerDelegate = TopTimer->TimerDelegate;
+
 			// Now call the function
 			for (int32 CallIdx=0; CallIdx<CallCount; ++CallIdx)
 			{
-				CurrentlyExecutingTimer.TimerDelegate.Execute();
+				TimerDelegate.Execute();
 
-				// If timer was cleared in the delegate execution, don't execute further 
-				if( !CurrentlyExecutingTimer.TimerDelegate.IsBound() )
+				// If timer was cleared in the delegate execution, don't execute further
+				if( !GetTimer(Handle) )
 				{
 					break;
 				}
 			}
 
-			if( CurrentlyExecutingTimer.bLoop && 
-				CurrentlyExecutingTimer.TimerDelegate.IsBound() && 							// did not get cleared during execution
-				(FindTimer(CurrentlyExecutingTimer.TimerDelegate) == NULL)		// did not get manually re-added during execution
-			  )
+			// Timers cleared during execution are already gone, this includes timers that were re-added with the same delegate
+			FTimerData* const ExecutedTimer = GetTimer(Handle);
+			if (ExecutedTimer)
 			{
-				// Put this timer back on the heap
-				CurrentlyExecutingTimer.ExpireTime += CallCount * CurrentlyExecutingTimer.Rate;
-				ActiveTimerHeap.HeapPush(CurrentlyExecutingTimer);
+				if (ExecutedTimer->bLoop)
+				{
+					// Put this timer back on the heap
+					ExecutedTimer->ExpireTime += CallCount * ExecutedTimer->Rate;
+					PushActiveTimer(*ExecutedTimer);
+				}
+				else
+				{
+					RemoveTimer(Handle);
+				}
 			}
-
-			CurrentlyExecutingTimer.TimerDelegate.Unbind();
 		}
 		else
 		{
@@ -346,17 +446,17 @@ void FTimerManager::Tick(float DeltaTime)
 	LastTickedFrame = GFrameCounter;
 
 	// If we have any Pending Timers, add them to the Active Queue.
-	if( PendingTimerList.Num() > 0 )
+	if( PendingTimerSet.Num() > 0 )
 	{
-		for(int32 Index=0; Index<PendingTimerList.Num(); Index++)
+		for (TSet<FTimerHandle>::TConstIterator It(PendingTimerSet); It; ++It)
 		{
-			FTimerData& TimerToActivate = PendingTimerList[Index];
+			FTimerData* const TimerToActivate = GetTimer(*It);
+			check(TimerToActivate && TimerToActivate->Status == ETimerStatus::Pending);
 			// Convert from time remaining back to a valid ExpireTime
-			TimerToActivate.ExpireTime += InternalTime;
-			TimerToActivate.Status = ETimerStatus::Active;
-			ActiveTimerHeap.HeapPush( TimerToActivate );
+			TimerToActivate->ExpireTime += InternalTime;
+			PushActiveTimer(*TimerToActivate);
 		}
-		PendingTimerList.Empty();
+		PendingTimerSet.Empty();
 	}
 }
 
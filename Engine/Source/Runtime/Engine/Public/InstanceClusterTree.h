@@ -0,0 +1,112 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/*=============================================================================
+	InstanceClusterTree.h: Bounding volume hierarchy over mesh instances.
+=============================================================================*/
+
+/**
+ * A node of an instance cluster tree. Covers a contiguous range of the tree's sorted instances.
+ */
+struct FInstanceClusterNode
+{
+	/** Bounds of all instances of the node. */
+	FVector BoundMin;
+	/** Index of the first child node, INDEX_NONE for leaves. */
+	int32 FirstChild;
+	FVector BoundMax;
+	/** Index of the last child node, the children are stored next to each other. */
+	int32 LastChild;
+	/** Range of the node's instances in FInstanceClusterTree::SortedInstances. */
+	int32 FirstInstance;
+	int32 LastInstance;
+};
+
+/** A contiguous range of sorted instances that is drawn with one mesh element. */
+struct FInstanceClusterRange
+{
+	int32 FirstInstance;
+	int32 NumInstances;
+};
+
+/** Per view settings an instance cluster tree is culled with. */
+struct FInstanceClusterCullParams
+{
+	/** View frustum, NULL to only cull by distance. */
+	const FConvexVolume* Frustum;
+	/** Origin LOD and cull distances are measured from. */
+	FVector ViewOrigin;
+	/** Instances are culled beyond this distance, 0 to never cull instances by distance. */
+	float MaxDistance;
+	/** Number of LODs to choose from. */
+	int32 NumLODs;
+	/** LOD N is used at distances in [LODDistances[N], LODDistances[N + 1]). */
+	float LODDistances[MAX_STATIC_MESH_LODS + 1];
+	/** If not INDEX_NONE, all instances use this LOD. */
+	int32 ForcedLOD;
+
+	FInstanceClusterCullParams()
+		: Frustum(NULL)
+		, ViewOrigin(ForceInitToZero)
+		, MaxDistance(0.0f)
+		, NumLODs(1)
+		, ForcedLOD(INDEX_NONE)
+	{
+		for (int32 Index = 0; Index < ARRAY_COUNT(LODDistances); Index++)
+		{
+			LODDistances[Index] = (Index == 0) ? 0.0f : WORLD_MAX;
+		}
+	}
+};
+
+/**
+ * Bounding volume hierarchy over the instances of an instanced static mesh. Instances are sorted so that every node covers a
+ * contiguous range of them, culling then yields a few ranges of instances per LOD that can be drawn directly from an
+ * instance buffer in the same order.
+ */
+class ENGINE_API FInstanceClusterTree
+{
+public:
+
+	/** Nodes, the root is the first node. Empty if the tree was built from no instances. */
+	TArray<FInstanceClusterNode> Nodes;
+
+	/** Instance indices in tree order. */
+	TArray<int32> SortedInstances;
+
+	/**
+	 * Builds the tree, splitting nodes along their longest axis at the median instance until nodes have few enough instances.
+	 *
+	 * @param InstanceBoxes			Bounds of every instance
+	 * @param MaxInstancesPerLeaf	Leaves have at most this many instances
+	 */
+	void Build(const TArray<FBox>& InstanceBoxes, int32 MaxInstancesPerLeaf);
+
+	/** Transforms the bounds of all nodes, i.e. from component to world space. */
+	void TransformBounds(const FMatrix& Transform);
+
+	/**
+	 * Culls the tree against a view. Nodes that are completely inside the same LOD's distance range are not split any further,
+	 * leaves that span several LODs use the LOD of their center.
+	 *
+	 * @param Params			View settings
+	 * @param OutRangesPerLOD	Array of Params.NumLODs arrays that receive the visible ranges of sorted instances per LOD
+	 * @return Number of visible instances
+	 */
+	int32 Cull(const FInstanceClusterCullParams& Params, TArray<FInstanceClusterRange>* OutRangesPerLOD) const;
+
+	/** Returns the bounds of all instances. */
+	FBox GetBounds() const
+	{
+		return Nodes.Num() > 0 ? FBox(Nodes[0].BoundMin, Nodes[0].BoundMax) : FBox(0);
+	}
+
+private:
+
+	/** Initializes a node and its subtree from a range of SortedInstances. */
+	void BuildNode(int32 NodeIndex, int32 FirstInstance, int32 NumInstances, const TArray<FBox>& InstanceBoxes, const TArray<FVector>& InstanceCenters, int32 MaxInstancesPerLeaf);
+
+	/** Culls a node and its subtree. */
+	int32 CullNode(int32 NodeIndex, bool bFullyInsideFrustum, const FInstanceClusterCullParams& Params, TArray<FInstanceClusterRange>* OutRangesPerLOD) const;
+};
@@ -18,6 +18,8 @@ public:
 	uint32				IsConditional	: 1;
 };
 
+class FRepChangelistState;
+
 /** FRepChangedPropertyTracker
  * This class is used to store the change list for a group of properties of a particular actor/object
  * This information is shared across connections when possible
@@ -52,6 +54,8 @@ public:
 
 	uint32						ActiveStatusChanged;
 	bool						UnconditionalPropChanged;
+
+	TSharedPtr< FRepChangelistState >	ChangelistState;		// Changelists shared by all connections, used when net.ShareChangelists is on
 };
 
 class FRepLayout;
@@ -80,7 +84,8 @@ public:
 		UnmappedFrames( 0 ),
 		OpenAckedCalled( false ),
 		AwakeFromDormancy( false ),
-		ActiveStatusChanged( 0 )
+		ActiveStatusChanged( 0 ),
+		LastChangelistIndex( INDEX_NONE )
 	{ }
 
 	~FRepState();
@@ -114,6 +119,34 @@ public:
 	TArray< uint16 >				ConditionalLifetime;		// Properties the need to be checked conditionally (based on net initial, role, etc)
 	FReplicationFlags				RepFlags;
 	uint32							ActiveStatusChanged;
+
+	int32							LastChangelistIndex;		// FRepChangelistState history index this connection has sent up to, INDEX_NONE until it has done a full compare
+};
+
+/** FRepChangelistState
+ *  Per object changelist history shared by all connections
+ *  The object is compared once per frame against a shared shadow state, each connection then merges the changelists it hasn't sent yet
+*/
+class FRepChangelistState
+{
+public:
+	FRepChangelistState() : 
+		HistoryStart( 0 ), 
+		HistoryEnd( 0 ), 
+		LastCompareFrame( 0 ) 
+	{ }
+
+	FRepState					ShadowState;		// State of the object as of the last compare
+
+	static const int32 MAX_CHANGE_HISTORY = 64;
+
+	FRepChangedHistory			ChangeHistory[MAX_CHANGE_HISTORY];
+	int32						HistoryStart;		// These only grow, index ChangeHistory with % MAX_CHANGE_HISTORY
+	int32						HistoryEnd;
+
+	uint32						LastCompareFrame;
+
+	TArray< FRepChangedParent >	ChangedParents;		// Scratch space for the compare, kept to avoid reallocating every frame
 };
 
 enum ERepLayoutCmdType
@@ -298,6 +331,17 @@ public:
 
 	bool GenerateChangelist( FRepState * RepState, const uint8 * Data, TArray< FRepChangedParent > & OutChangedParents ) const;
 
+	void InitChangelistState( FRepChangelistState * ChangelistState, UClass * InObjectClass, const uint8 * Src ) const;
+
+	/** Compares the object against the shared shadow state once per ReplicationFrame, adding a history item if anything changed */
+	void UpdateChangelistState( FRepChangelistState * ChangelistState, const uint8 * Data, const uint32 ReplicationFrame ) const;
+
+	/** Merges the shared history items RepState hasn't sent yet into OutChanged, returns true if anything changed */
+	bool MergeChangelistHistory( FRepState * RepState, const FRepChangelistState * ChangelistState, const uint8 * Data, TArray< uint16 > & OutChanged ) const;
+
+	/** Copies the changed parent properties into the shadow state, for shadow states that are compared but never sent */
+	void StoreChangedParents( FRepState * RepState, const uint8 * Data, const TArray< FRepChangedParent > & ChangedParents ) const;
+
 	void ValidateChangelist(
 		FRepState *							RepState, 
 		const uint8 * 						Data, 
@@ -23,7 +23,9 @@ namespace EDrawDynamicFlags
 {
 	enum Type
 	{
-		ForceLowestLOD = 0x1
+		ForceLowestLOD = 0x1,
+		/** The elements are drawn into a shadow depth map, the view is the camera view the shadow is for rather than the light's view. */
+		ShadowDepth = 0x2
 	};
 }
 
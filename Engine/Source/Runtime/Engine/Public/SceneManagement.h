@@ -1276,6 +1276,8 @@ struct FMeshBatchElement
 	uint32 MaxVertexIndex;
 	int32 GPUSkinCacheKey;	// -1 if not using GPU skin cache
 	void* UserData;
+	/** Index for use by the vertex factory, e.g. the first instance of a range of instances to draw. */
+	int32 UserIndex;
 
 	/** 
 	 *	DynamicIndexData - pointer to user memory containing the index data.
@@ -1290,6 +1292,7 @@ struct FMeshBatchElement
 	,	NumInstances(1)
 	,	GPUSkinCacheKey(-1)
 	,	UserData(NULL)
+	,	UserIndex(0)
 	,	DynamicIndexData(NULL)
 	{
 	}
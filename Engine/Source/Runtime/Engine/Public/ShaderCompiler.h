@@ -22,6 +22,8 @@ public:
 	FShaderType* ShaderType;
 	/** Input for the shader compile */
 	FShaderCompilerInput Input;
+	/** Hash of the shader files the compiler reads from disk, the input only references them by name. */
+	FSHAHash SourceHash;
 	/** true if the results of the shader compile have been processed. */
 	bool bFinalized;
 	/** Output of the shader compile */
@@ -69,6 +71,8 @@ private:
 	TArray<struct FShaderCompileWorkerInfo*> WorkerInfos;
 	/** Tracks the last time that this thread checked if the workers were still active. */
 	double LastCheckForWorkersTime;
+	/** Output of jobs that were already compiled, NULL if disabled. */
+	TScopedPointer<class FShaderJobCache> JobCache;
 
 public:
 	/** Initialization constructor. */
@@ -92,6 +96,15 @@ private:
 	 */
 	int32 PullTasksFromQueue();
 
+	/** 
+	 * Finalizes new jobs of the given worker whose output is in the job cache, and jobs that are identical to one being compiled.
+	 * The remaining jobs are put into JobsToCompile of the worker.
+	 */
+	void LookUpJobCache(FShaderCompileWorkerInfo& CurrentWorkerInfo);
+
+	/** Adds the output of jobs the workers finished compiling to the job cache, which finalizes the identical jobs that waited for them. */
+	void AddCompiledJobsToCache();
+
 	/** Used when compiling through workers, writes out the worker inputs for any new tasks in WorkerInfos.QueuedJobs. */
 	void WriteNewTasks();
 
@@ -190,6 +203,12 @@ private:
 	bool bPromptToRetryFailedShaderCompiles;
 	/** Whether to log out shader job completion times on the worker thread.  Useful for tracking down which global shader is taking a long time. */
 	bool bLogJobCompletionTimes;
+	/** Whether to reuse the output of identical jobs instead of compiling them again. */
+	bool bUseJobCache;
+	/** Whether the job cache also looks up and stores job output in the derived data cache. */
+	bool bUseJobCacheDDC;
+	/** Memory the job cache may use for job output in this session, in bytes. */
+	int64 JobCacheMemoryLimit;
 	/** Target execution time for ProcessAsyncResults.  Larger values speed up async shader map processing but cause more hitchiness while async compiling is happening. */
 	float ProcessGameThreadTargetTime;
 	/** Base directory where temporary files are written out during multi core shader compiling. */
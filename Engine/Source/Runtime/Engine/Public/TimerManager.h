@@ -69,6 +69,13 @@ struct FTimerUnifiedDelegate
 		return false;
 	}
 
+	/** Returns the UObject the delegate is bound to, timers are indexed by this. NULL for raw, shared pointer and static delegates. */
+	inline void const* GetBoundObject() const
+	{
+		void const* const Object = FuncDelegate.GetUObject();
+		return Object ? Object : FuncDynDelegate.GetObject();
+	}
+
 	inline void Unbind()
 	{
 		FuncDelegate.Unbind();
@@ -88,10 +95,67 @@ namespace ETimerStatus
 	{
 		Pending,
 		Active,
-		Paused
+		Paused,
+		Executing
 	};
 }
 
+/** Unique handle that can be used to distinguish timers that have identical delegates. */
+struct FTimerHandle
+{
+	FTimerHandle()
+		: Handle(0)
+	{}
+
+	/** True if this handle was ever set to a timer, the timer may have been cleared since. */
+	bool IsValid() const
+	{
+		return Handle != 0;
+	}
+
+	void Invalidate()
+	{
+		Handle = 0;
+	}
+
+	bool operator==(const FTimerHandle& Other) const
+	{
+		return Handle == Other.Handle;
+	}
+
+	bool operator!=(const FTimerHandle& Other) const
+	{
+		return Handle != Other.Handle;
+	}
+
+	friend uint32 GetTypeHash(const FTimerHandle& InHandle)
+	{
+		return GetTypeHash(InHandle.Handle);
+	}
+
+private:
+	friend class FTimerManager;
+
+	/** Index of the timer in FTimerManager's sparse array in the low 32 bits, serial number of the timer in the high 32 bits. */
+	uint64 Handle;
+
+	void SetIndexAndSerialNumber(int32 Index, uint32 SerialNumber)
+	{
+		check(Index >= 0 && SerialNumber != 0);
+		Handle = (uint64(SerialNumber) << 32) | uint64(uint32(Index));
+	}
+
+	int32 GetIndex() const
+	{
+		return int32(Handle & 0xffffffff);
+	}
+
+	uint32 GetSerialNumber() const
+	{
+		return uint32(Handle >> 32);
+	}
+};
+
 struct FTimerData
 {
 	/** If true, this timer will loop indefinitely.  Otherwise, it will be destroyed when it expires. */
@@ -113,13 +177,39 @@ struct FTimerData
 	/** Holds the delegate to call. */
 	FTimerUnifiedDelegate TimerDelegate;
 
+	/** Handle of this timer. */
+	FTimerHandle Handle;
+
+	/** Object the delegate was bound to when the timer was set, the key of this timer in the per object index. */
+	void const* TimerIndicesByObjectKey;
+
+	/** Serial number of the active heap entry that is current for this timer, older entries are skipped. */
+	uint32 HeapSerialNumber;
+
 	FTimerData()
 		: bLoop(false), Status(ETimerStatus::Active)
 		, Rate(0), ExpireTime(0)
+		, TimerIndicesByObjectKey(NULL), HeapSerialNumber(0)
 	{}
+};
+
+/** 
+ * Entry in the heap of active timers. Clearing or pausing a timer leaves its entry behind instead of re-sorting the heap,
+ * entries that no longer match their timer are dropped when they reach the top.
+ */
+struct FTimerHeapEntry
+{
+	/** Time (on the FTimerManager's clock) the timer expires at. */
+	double ExpireTime;
+
+	/** Timer this entry is for. */
+	FTimerHandle Handle;
+
+	/** Matches FTimerData::HeapSerialNumber while this entry is current. */
+	uint32 HeapSerialNumber;
 
 	/** Operator less, used to sort the heap based on time until execution. **/
-	bool operator<(const FTimerData& Other) const
+	bool operator<(const FTimerHeapEntry& Other) const
 	{
 		return ExpireTime < Other.ExpireTime;
 	}
@@ -144,7 +234,10 @@ public:
 	// Timer API
 
 	FTimerManager()
-		: InternalTime(0.0)
+		: NumStaleHeapEntries(0)
+		, LastAssignedSerialNumber(0)
+		, LastAssignedHeapSerialNumber(0)
+		, InternalTime(0.0)
 	{}
 
 
@@ -390,6 +483,88 @@ public:
 		return InternalGetTimerRemaining( FTimerUnifiedDelegate(InDynDelegate) );
 	}
 
+	// ----------------------------------
+	// Handle based timer API
+	//
+	// Timers set through a handle are found without comparing delegates, and several timers can share a delegate.
+
+	/**
+	 * Sets a timer to call the given native function at a set interval. If the handle refers to an existing timer,
+	 * that timer is cleared first.
+	 *
+	 * @param InOutHandle	Handle to the timer, set to the new timer or invalidated if no timer was set.
+	 * @param inObj			Object to call the timer function on.
+	 * @param inTimerMethod Method to call when timer fires.
+	 * @param inRate		The amount of time between set and firing.  If <= 0.f, clears the existing timer.
+	 * @param inbLoop		true to keep firing at Rate intervals, false to fire only once.
+	 */
+	template< class UserClass >	
+	FORCEINLINE void SetTimer(FTimerHandle& InOutHandle, UserClass* inObj, typename FTimerDelegate::TUObjectMethodDelegate< UserClass >::FMethodPtr inTimerMethod, float inRate, bool inbLoop = false)
+	{
+		SetTimer( InOutHandle, FTimerDelegate::CreateUObject(inObj, inTimerMethod), inRate, inbLoop );
+	}
+	template< class UserClass >	
+	FORCEINLINE void SetTimer(FTimerHandle& InOutHandle, UserClass* inObj, typename FTimerDelegate::TUObjectMethodDelegate_Const< UserClass >::FMethodPtr inTimerMethod, float inRate, bool inbLoop = false)
+	{
+		SetTimer( InOutHandle, FTimerDelegate::CreateUObject(inObj, inTimerMethod), inRate, inbLoop );
+	}
+
+	/** Version that takes any generic delegate. */
+	FORCEINLINE void SetTimer(FTimerHandle& InOutHandle, FTimerDelegate const& InDelegate, float InRate, bool InbLoop)
+	{
+		InternalSetTimer( InOutHandle, FTimerUnifiedDelegate(InDelegate), InRate, InbLoop );
+	}
+	/** Version that takes a dynamic delegate (e.g. for UFunctions). */
+	FORCEINLINE void SetTimer(FTimerHandle& InOutHandle, FTimerDynamicDelegate const& InDynDelegate, float InRate, bool InbLoop)
+	{
+		InternalSetTimer( InOutHandle, FTimerUnifiedDelegate(InDynDelegate), InRate, InbLoop );
+	}
+
+	/** Clears a previously set timer and invalidates the handle. */
+	FORCEINLINE void ClearTimer(FTimerHandle& InHandle)
+	{
+		InternalClearTimer( InHandle );
+		InHandle.Invalidate();
+	}
+
+	/** Pauses a previously set timer. */
+	void PauseTimer(FTimerHandle InHandle);
+
+	/** Unpauses a previously set timer. */
+	void UnPauseTimer(FTimerHandle InHandle);
+
+	/** @return	The current rate or -1.f if timer does not exist. */
+	float GetTimerRate(FTimerHandle InHandle) const
+	{
+		FTimerData const* const TimerData = FindTimer( InHandle );
+		return TimerData ? TimerData->Rate : -1.f;
+	}
+
+	/** @return	true if the timer exists and is not paused. */
+	bool IsTimerActive(FTimerHandle InHandle) const
+	{
+		FTimerData const* const TimerData = FindTimer( InHandle );
+		return ( (TimerData != NULL) && (TimerData->Status != ETimerStatus::Paused) );
+	}
+
+	/** @return	true if the timer exists, paused or not. */
+	bool TimerExists(FTimerHandle InHandle) const
+	{
+		return FindTimer( InHandle ) != NULL;
+	}
+
+	/** @return	The current time elapsed or -1.f if timer does not exist. */
+	float GetTimerElapsed(FTimerHandle InHandle) const
+	{
+		return InternalGetTimerElapsed( FindTimer( InHandle ) );
+	}
+
+	/** @return	The current time remaining, or -1.f if timer does not exist. */
+	float GetTimerRemaining(FTimerHandle InHandle) const
+	{
+		return InternalGetTimerRemaining( FindTimer( InHandle ) );
+	}
+
 	/** Timer manager has been ticked this frame? */
 	bool FORCEINLINE HasBeenTickedThisFrame() const
 	{
@@ -399,11 +574,22 @@ public:
 private:
 
 	void InternalSetTimer( FTimerUnifiedDelegate const& InDelegate, float inRate, bool inbLoop );
+	void InternalSetTimer( FTimerHandle& InOutHandle, FTimerUnifiedDelegate const& InDelegate, float inRate, bool inbLoop );
 	void InternalClearTimer( FTimerUnifiedDelegate const& InDelegate );
+	void InternalClearTimer( FTimerHandle InHandle );
 	void InternalClearAllTimers(void const* Object);
 
-	/** Will find a timer either in the active or paused list. */
-	FTimerData const* FindTimer( FTimerUnifiedDelegate const& InDelegate, int32* OutTimerIndex=NULL ) const;
+	/** Will find a timer that is pending, active or paused. Timers are not found while their delegate is executing. */
+	FTimerData const* FindTimer( FTimerUnifiedDelegate const& InDelegate ) const;
+	FTimerData const* FindTimer( FTimerHandle InHandle ) const;
+	FTimerData* FindTimer( FTimerHandle InHandle );
+
+	/** Returns the timer the handle refers to, whatever its status, or NULL if it was cleared. */
+	FTimerData const* GetTimer( FTimerHandle InHandle ) const;
+	FTimerData* GetTimer( FTimerHandle InHandle );
+
+	/** Finds the timer bound to the given delegate through the per object index, including a timer that is executing. */
+	FTimerHandle FindTimerHandle( FTimerUnifiedDelegate const& InDelegate ) const;
 
 	void InternalPauseTimer( FTimerUnifiedDelegate const& InDelegate );
 	void InternalUnPauseTimer( FTimerUnifiedDelegate const& InDelegate );
@@ -411,23 +597,38 @@ private:
 	float InternalGetTimerRate( FTimerUnifiedDelegate const& InDelegate ) const;
 	float InternalGetTimerElapsed( FTimerUnifiedDelegate const& InDelegate ) const;
 	float InternalGetTimerRemaining( FTimerUnifiedDelegate const& InDelegate ) const;
+	float InternalGetTimerElapsed( FTimerData const* TimerData ) const;
+	float InternalGetTimerRemaining( FTimerData const* TimerData ) const;
 
-	/** Will find the given timer in the given TArray and return its index. */ 
-	int32 FindTimerInList(const TArray<FTimerData> &SearchArray, FTimerUnifiedDelegate const& InDelegate ) const;
+	/** Adds a timer to the sparse array and the per object index and returns its handle. */
+	FTimerHandle AddTimer( FTimerData const& TimerData );
+	/** Removes a timer from the sparse array and the per object index. */
+	void RemoveTimer( FTimerHandle InHandle );
 
+	/** Pushes a new heap entry for an active timer, older entries for it become stale. */
+	void PushActiveTimer( FTimerData& TimerData );
+	/** Counts a heap entry that became stale, and drops all stale entries once they make up most of the heap. */
+	void AddStaleHeapEntry();
+
+	/** All timers, indexed by FTimerHandle. */
+	TSparseArray<FTimerData> Timers;
 	/** Heap of actively running timers. */
-	TArray<FTimerData> ActiveTimerHeap;
-	/** Unordered list of paused timers. */
-	TArray<FTimerData> PausedTimerList;
-	/** List of timers added this frame, to be added after timer has been ticked */
-	TArray<FTimerData> PendingTimerList;
+	TArray<FTimerHeapEntry> ActiveTimerHeap;
+	/** Number of entries in ActiveTimerHeap that no longer match their timer. */
+	int32 NumStaleHeapEntries;
+	/** Timers added this frame, to be added after timer has been ticked */
+	TSet<FTimerHandle> PendingTimerSet;
+	/** Handles of the timers bound to each UObject, used to find timers by delegate. Timers without a UObject are under NULL. */
+	TMap<void const*, TSet<FTimerHandle> > ObjectToTimers;
+
+	/** The last serial number handed out to a timer, 0 is never used so a zero handle is invalid. */
+	uint32 LastAssignedSerialNumber;
+	/** The last serial number handed out to an active heap entry. */
+	uint32 LastAssignedHeapSerialNumber;
 
 	/** An internally consistent clock, independent of World.  Advances during ticking. */
 	double InternalTime;
 
-	/** Timer delegate currently being executed.  Used to handle "timer delegates that manipulating timers" cases. */
-	FTimerData CurrentlyExecutingTimer;
-
 	/** Set this to GFrameCounter when Timer is ticked. To figure out if Timer has been already ticked or not this frame. */
 	uint64 LastTickedFrame;
 };
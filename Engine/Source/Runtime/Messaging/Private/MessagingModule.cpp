@@ -13,6 +13,9 @@
 #endif
 
 
+DEFINE_LOG_CATEGORY(LogMessaging);
+
+
 /**
  * Implements the Messaging module.
  */
@@ -70,6 +73,11 @@ public:
 		return MakeShareable(new FMessageBus(RecipientAuthorizer));
 	}
 
+	virtual ISerializeMessagesPtr CreateBinaryMessageSerializer( ) OVERRIDE
+	{
+		return MakeShareable(new FBinaryMessageSerializer());
+	}
+
 	virtual ISerializeMessagesPtr CreateJsonMessageSerializer( ) OVERRIDE
 	{
 		return MakeShareable(new FJsonMessageSerializer());
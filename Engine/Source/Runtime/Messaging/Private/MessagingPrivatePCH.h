@@ -19,6 +19,12 @@
 #include "SocketSubsystem.h"
 
 
+/* Log categories
+ *****************************************************************************/
+
+DECLARE_LOG_CATEGORY_EXTERN(LogMessaging, Log, All);
+
+
 /* Private includes
  *****************************************************************************/
 
@@ -29,6 +35,7 @@
 #include "MessageRouter.h"
 #include "MessageBus.h"
 
+#include "BinaryMessageSerializer.h"
 #include "BsonMessageSerializer.h"
 #include "JsonMessageSerializer.h"
 #include "XmlMessageSerializer.h"
@@ -0,0 +1,381 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	BinaryMessageSerializer.cpp: Implements the FBinaryMessageSerializer structure.
+=============================================================================*/
+
+#include "MessagingPrivatePCH.h"
+
+
+/** Holds the number every binary message starts with, so messages in other formats are rejected right away. */
+static const uint32 BinaryMessageMagic = 0x4D42E401;
+
+
+/* ISerializeMessages interface
+ *****************************************************************************/
+
+bool FBinaryMessageSerializer::DeserializeMessage( FArchive& Archive, IMutableMessageContextRef& OutContext )
+{
+	uint32 Magic = 0;
+	Archive << Magic;
+
+	if (Magic != BinaryMessageMagic)
+	{
+		return false;
+	}
+
+	// deserialize context
+	FMessageAddress Sender;
+	Archive << Sender;
+	OutContext->SetSender(Sender);
+
+	TArray<FMessageAddress> Recipients;
+	Archive << Recipients;
+
+	for (int32 RecipientIndex = 0; RecipientIndex < Recipients.Num(); ++RecipientIndex)
+	{
+		OutContext->AddRecipient(Recipients[RecipientIndex]);
+	}
+
+	TEnumAsByte<EMessageScope::Type> Scope;
+	Archive << Scope;
+	OutContext->SetScope(Scope);
+
+	FDateTime TimeSent;
+	Archive << TimeSent;
+	OutContext->SetTimeSent(TimeSent);
+
+	FDateTime Expiration;
+	Archive << Expiration;
+	OutContext->SetExpiration(Expiration);
+
+	TMap<FName, FString> Headers;
+	Archive << Headers;
+
+	for (TMap<FName, FString>::TConstIterator It(Headers); It; ++It)
+	{
+		OutContext->SetHeader(It.Key(), It.Value());
+	}
+
+	// deserialize message type
+	FString TypeName;
+	Archive << TypeName;
+
+	uint32 SchemaHash = 0;
+	Archive << SchemaHash;
+
+	if (Archive.IsError())
+	{
+		return false;
+	}
+
+	UScriptStruct* TypeInfo = FMessageTypeMap::MessageTypeMap.Find(TypeName);
+
+	if (TypeInfo == nullptr)
+	{
+		return false;
+	}
+
+	if (SchemaHash != GetSchemaHash(TypeInfo))
+	{
+		UE_LOG(LogMessaging, Verbose, TEXT("Dropped message of type %s, the sender's layout of this type is different"), *TypeName);
+
+		return false;
+	}
+
+	// deserialize message
+	void* Data = FMemory::Malloc(TypeInfo->PropertiesSize);
+	TypeInfo->InitializeScriptStruct(Data);
+
+	if (!DeserializeStruct(Archive, Data, TypeInfo) || Archive.IsError())
+	{
+		UE_LOG(LogMessaging, Verbose, TEXT("Dropped malformed message of type %s"), *TypeName);
+
+		TypeInfo->DestroyScriptStruct(Data);
+		FMemory::Free(Data);
+
+		return false;
+	}
+
+	OutContext->SetMessage(Data, TypeInfo);
+
+	return true;
+}
+
+
+bool FBinaryMessageSerializer::SerializeMessage( const IMessageContextRef& Context, FArchive& Archive )
+{
+	if (!Context->IsValid())
+	{
+		return false;
+	}
+
+	uint32 Magic = BinaryMessageMagic;
+	Archive << Magic;
+
+	// serialize context
+	FMessageAddress Sender = Context->GetSender();
+	Archive << Sender;
+
+	TArray<FMessageAddress> Recipients = Context->GetRecipients();
+	Archive << Recipients;
+
+	TEnumAsByte<EMessageScope::Type> Scope = Context->GetScope();
+	Archive << Scope;
+
+	FDateTime TimeSent = Context->GetTimeSent();
+	Archive << TimeSent;
+
+	FDateTime Expiration = Context->GetExpiration();
+	Archive << Expiration;
+
+	TMap<FName, FString> Headers = Context->GetHeaders();
+	Archive << Headers;
+
+	// serialize message type
+	UScriptStruct* TypeInfo = Context->GetMessageTypeInfo().Get();
+
+	FString TypeName = TypeInfo->GetName();
+	Archive << TypeName;
+
+	uint32 SchemaHash = GetSchemaHash(TypeInfo);
+	Archive << SchemaHash;
+
+	// serialize message
+	SerializeStruct(Archive, Context->GetMessage(), TypeInfo);
+
+	return !Archive.IsError();
+}
+
+
+/* FBinaryMessageSerializer interface
+ *****************************************************************************/
+
+uint32 FBinaryMessageSerializer::GetSchemaHash( UScriptStruct* TypeInfo )
+{
+	FScopeLock Lock(&SchemaHashesCriticalSection);
+
+	uint32* SchemaHash = SchemaHashes.Find(TypeInfo);
+
+	if (SchemaHash != nullptr)
+	{
+		return *SchemaHash;
+	}
+
+	return SchemaHashes.Add(TypeInfo, HashStruct(TypeInfo, FCrc::StrCrc32(*TypeInfo->GetName())));
+}
+
+
+/* FBinaryMessageSerializer implementation
+ *****************************************************************************/
+
+bool FBinaryMessageSerializer::DeserializeStruct( FArchive& Archive, void* Data, UStruct* TypeInfo )
+{
+	for (TFieldIterator<UProperty> It(TypeInfo, EFieldIteratorFlags::IncludeSuper); It; ++It)
+	{
+		for (int32 ArrayIndex = 0; ArrayIndex < It->ArrayDim; ++ArrayIndex)
+		{
+			if (!DeserializeValue(Archive, It->ContainerPtrToValuePtr<void>(Data, ArrayIndex), *It))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+
+bool FBinaryMessageSerializer::DeserializeValue( FArchive& Archive, void* Value, UProperty* Property )
+{
+	// booleans
+	if (Property->IsA(UBoolProperty::StaticClass()))
+	{
+		uint8 BoolValue = 0;
+		Archive << BoolValue;
+		Cast<UBoolProperty>(Property)->SetPropertyValue(Value, BoolValue != 0);
+	}
+
+	// numbers & enumerations
+	else if (Property->IsA(UNumericProperty::StaticClass()))
+	{
+		Archive.ByteOrderSerialize(Value, Property->ElementSize);
+	}
+
+	// names & strings
+	else if (Property->IsA(UStrProperty::StaticClass()))
+	{
+		Archive << *(FString*)Value;
+	}
+	else if (Property->IsA(UNameProperty::StaticClass()))
+	{
+		FString NameString;
+		Archive << NameString;
+		*(FName*)Value = FName(*NameString);
+	}
+
+	// dynamic arrays
+	else if (Property->IsA(UArrayProperty::StaticClass()))
+	{
+		UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Property);
+		UProperty* Inner = ArrayProperty->Inner;
+
+		int32 Num = 0;
+		Archive << Num;
+
+		if (Archive.IsError() || (Num < 0))
+		{
+			return false;
+		}
+
+		FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
+
+		if (Inner->IsA(UNumericProperty::StaticClass()) && !Archive.IsByteSwapping())
+		{
+			// don't let a corrupted count allocate more memory than there is data
+			if ((int64)Num * Inner->ElementSize > Archive.TotalSize() - Archive.Tell())
+			{
+				return false;
+			}
+
+			ArrayHelper.EmptyAndAddValues(Num);
+			Archive.Serialize(ArrayHelper.GetRawPtr(), Num * Inner->ElementSize);
+		}
+		else
+		{
+			// grow one element at a time, so a corrupted count runs into the end of the data first
+			ArrayHelper.EmptyValues(0);
+
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				const int32 NewIndex = ArrayHelper.AddValue();
+
+				if (!DeserializeValue(Archive, ArrayHelper.GetRawPtr(NewIndex), Inner) || Archive.IsError())
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	// structures
+	else if (Property->IsA(UStructProperty::StaticClass()))
+	{
+		return DeserializeStruct(Archive, Value, Cast<UStructProperty>(Property)->Struct);
+	}
+
+	// object references, delegates and interfaces can't be sent and are skipped on both ends
+
+	return !Archive.IsError();
+}
+
+
+void FBinaryMessageSerializer::SerializeStruct( FArchive& Archive, const void* Data, UStruct* TypeInfo )
+{
+	for (TFieldIterator<UProperty> It(TypeInfo, EFieldIteratorFlags::IncludeSuper); It; ++It)
+	{
+		for (int32 ArrayIndex = 0; ArrayIndex < It->ArrayDim; ++ArrayIndex)
+		{
+			SerializeValue(Archive, It->ContainerPtrToValuePtr<void>(Data, ArrayIndex), *It);
+		}
+	}
+}
+
+
+void FBinaryMessageSerializer::SerializeValue( FArchive& Archive, const void* Value, UProperty* Property )
+{
+	// booleans
+	if (Property->IsA(UBoolProperty::StaticClass()))
+	{
+		uint8 BoolValue = Cast<UBoolProperty>(Property)->GetPropertyValue(Value) ? 1 : 0;
+		Archive << BoolValue;
+	}
+
+	// numbers & enumerations
+	else if (Property->IsA(UNumericProperty::StaticClass()))
+	{
+		// byte swapping happens in place, so the message itself must not be passed in
+		uint8 NumericValue[sizeof(uint64)];
+		check(Property->ElementSize <= sizeof(NumericValue));
+
+		FMemory::Memcpy(NumericValue, Value, Property->ElementSize);
+		Archive.ByteOrderSerialize(NumericValue, Property->ElementSize);
+	}
+
+	// names & strings
+	else if (Property->IsA(UStrProperty::StaticClass()))
+	{
+		Archive << *(FString*)Value;
+	}
+	else if (Property->IsA(UNameProperty::StaticClass()))
+	{
+		FString NameString = ((const FName*)Value)->ToString();
+		Archive << NameString;
+	}
+
+	// dynamic arrays
+	else if (Property->IsA(UArrayProperty::StaticClass()))
+	{
+		UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Property);
+		UProperty* Inner = ArrayProperty->Inner;
+		FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
+
+		int32 Num = ArrayHelper.Num();
+		Archive << Num;
+
+		if (Num == 0)
+		{
+			return;
+		}
+
+		if (Inner->IsA(UNumericProperty::StaticClass()) && !Archive.IsByteSwapping())
+		{
+			// arrays of numbers, i.e. the byte arrays used for binary payloads, are written in one go
+			Archive.Serialize(ArrayHelper.GetRawPtr(), Num * Inner->ElementSize);
+		}
+		else
+		{
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				SerializeValue(Archive, ArrayHelper.GetRawPtr(Index), Inner);
+			}
+		}
+	}
+
+	// structures
+	else if (Property->IsA(UStructProperty::StaticClass()))
+	{
+		SerializeStruct(Archive, Value, Cast<UStructProperty>(Property)->Struct);
+	}
+}
+
+
+uint32 FBinaryMessageSerializer::HashStruct( UStruct* TypeInfo, uint32 Hash )
+{
+	for (TFieldIterator<UProperty> It(TypeInfo, EFieldIteratorFlags::IncludeSuper); It; ++It)
+	{
+		Hash = HashProperty(*It, Hash);
+	}
+
+	return Hash;
+}
+
+
+uint32 FBinaryMessageSerializer::HashProperty( UProperty* Property, uint32 Hash )
+{
+	Hash = FCrc::StrCrc32(*Property->GetName(), Hash);
+	Hash = FCrc::StrCrc32(*Property->GetClass()->GetName(), Hash);
+	Hash = FCrc::MemCrc32(&Property->ArrayDim, sizeof(Property->ArrayDim), Hash);
+
+	if (Property->IsA(UArrayProperty::StaticClass()))
+	{
+		Hash = HashProperty(Cast<UArrayProperty>(Property)->Inner, Hash);
+	}
+	else if (Property->IsA(UStructProperty::StaticClass()))
+	{
+		UScriptStruct* Struct = Cast<UStructProperty>(Property)->Struct;
+		Hash = HashStruct(Struct, FCrc::StrCrc32(*Struct->GetName(), Hash));
+	}
+
+	return Hash;
+}
@@ -0,0 +1,112 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	BinaryMessageSerializer.h: Declares the FBinaryMessageSerializer structure.
+=============================================================================*/
+
+#pragma once
+
+
+/**
+ * Implements a message serializer that serializes from and to a compact binary format.
+ *
+ * Properties are written in declaration order without their names, so both ends have to agree on the
+ * layout of a message type. Every message carries a hash of its type's layout, and messages whose hash
+ * does not match the receiver's layout are dropped instead of being misread.
+ */
+class FBinaryMessageSerializer
+	: public ISerializeMessages
+{
+public:
+
+	// Begin ISerializeMessages interface
+
+	virtual bool DeserializeMessage( FArchive& Archive, IMutableMessageContextRef& OutContext ) OVERRIDE;
+
+	virtual bool SerializeMessage( const IMessageContextRef& Context, FArchive& Archive ) OVERRIDE;
+
+	// End ISerializeMessages interface
+
+public:
+
+	/**
+	 * Gets the layout hash of a message type.
+	 *
+	 * The hash covers the names, types and array dimensions of all properties, including those of nested structures.
+	 *
+	 * @param TypeInfo - The message type.
+	 *
+	 * @return The layout hash.
+	 */
+	uint32 GetSchemaHash( UScriptStruct* TypeInfo );
+
+protected:
+
+	/**
+	 * Deserializes the properties of a structure.
+	 *
+	 * @param Archive - The archive to read from.
+	 * @param Data - The structure to read into.
+	 * @param TypeInfo - The structure's type information.
+	 *
+	 * @return true on success, false if the data was malformed.
+	 */
+	static bool DeserializeStruct( FArchive& Archive, void* Data, UStruct* TypeInfo );
+
+	/**
+	 * Deserializes a single value of a property.
+	 *
+	 * @param Archive - The archive to read from.
+	 * @param Value - The value to read into.
+	 * @param Property - The property the value belongs to.
+	 *
+	 * @return true on success, false if the data was malformed.
+	 */
+	static bool DeserializeValue( FArchive& Archive, void* Value, UProperty* Property );
+
+	/**
+	 * Serializes the properties of a structure.
+	 *
+	 * @param Archive - The archive to write to.
+	 * @param Data - The structured data to serialize.
+	 * @param TypeInfo - The structure's type information.
+	 */
+	static void SerializeStruct( FArchive& Archive, const void* Data, UStruct* TypeInfo );
+
+	/**
+	 * Serializes a single value of a property.
+	 *
+	 * @param Archive - The archive to write to.
+	 * @param Value - The value to serialize.
+	 * @param Property - The property the value belongs to.
+	 */
+	static void SerializeValue( FArchive& Archive, const void* Value, UProperty* Property );
+
+	/**
+	 * Adds the layout of a structure to a hash.
+	 *
+	 * @param TypeInfo - The structure's type information.
+	 * @param Hash - The hash so far.
+	 *
+	 * @return The new hash.
+	 */
+	static uint32 HashStruct( UStruct* TypeInfo, uint32 Hash );
+
+	/**
+	 * Adds the layout of a property to a hash.
+	 *
+	 * @param Property - The property to add.
+	 * @param Hash - The hash so far.
+	 *
+	 * @return The new hash.
+	 */
+	static uint32 HashProperty( UProperty* Property, uint32 Hash );
+
+private:
+
+	// Holds the layout hashes of the message types that were used so far.
+	TMap<UScriptStruct*, uint32> SchemaHashes;
+
+	// Holds a critical section for the layout hashes, messages are (de)serialized on any thread.
+	FCriticalSection SchemaHashesCriticalSection;
+};
@@ -0,0 +1,258 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	MessageSerializerBenchmark.cpp: Serialization rate and message size of the
+	binary and the Json message serializers.
+=============================================================================*/
+
+#include "MessagingPrivatePCH.h"
+#include "AutomationTest.h"
+
+
+/** Number of times each message is serialized and deserialized. */
+static const int32 MessageBenchmarkNumIterations = 100;
+
+/** Number of elements put into arrays of numbers, i.e. the byte arrays profiler data is sent in. */
+static const int32 MessageBenchmarkNumPayloadElements = 4096;
+
+/** Number of elements put into all other arrays. */
+static const int32 MessageBenchmarkNumArrayElements = 8;
+
+
+static void FillBenchmarkStruct( void* Data, UStruct* TypeInfo, int32 Seed );
+
+
+/** Sets a single value of a property to something that depends on the seed. */
+static void FillBenchmarkValue( void* Value, UProperty* Property, int32 Seed )
+{
+	if (Property->IsA(UBoolProperty::StaticClass()))
+	{
+		Cast<UBoolProperty>(Property)->SetPropertyValue(Value, (Seed & 1) != 0);
+	}
+	else if (Property->IsA(UNumericProperty::StaticClass()))
+	{
+		UNumericProperty* NumericProperty = Cast<UNumericProperty>(Property);
+
+		if (NumericProperty->IsFloatingPoint())
+		{
+			NumericProperty->SetFloatingPointPropertyValue(Value, Seed * 0.25);
+		}
+		else if (NumericProperty->IsEnum())
+		{
+			NumericProperty->SetIntPropertyValue(Value, (uint64)(Seed % FMath::Max(1, NumericProperty->GetIntPropertyEnum()->NumEnums() - 1)));
+		}
+		else
+		{
+			NumericProperty->SetIntPropertyValue(Value, (uint64)(Seed % 100));
+		}
+	}
+	else if (Property->IsA(UStrProperty::StaticClass()))
+	{
+		*(FString*)Value = FString::Printf(TEXT("%s value %d"), *Property->GetName(), Seed);
+	}
+	else if (Property->IsA(UNameProperty::StaticClass()))
+	{
+		*(FName*)Value = FName(*FString::Printf(TEXT("BenchmarkName%d"), Seed % 16));
+	}
+	else if (Property->IsA(UArrayProperty::StaticClass()))
+	{
+		UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Property);
+		FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
+		const int32 Num = ArrayProperty->Inner->IsA(UNumericProperty::StaticClass()) ? MessageBenchmarkNumPayloadElements : MessageBenchmarkNumArrayElements;
+
+		ArrayHelper.EmptyAndAddValues(Num);
+
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			FillBenchmarkValue(ArrayHelper.GetRawPtr(Index), ArrayProperty->Inner, Seed + Index);
+		}
+	}
+	else if (Property->IsA(UStructProperty::StaticClass()))
+	{
+		FillBenchmarkStruct(Value, Cast<UStructProperty>(Property)->Struct, Seed);
+	}
+}
+
+
+/** Sets all properties of a structure to something that depends on the seed. */
+static void FillBenchmarkStruct( void* Data, UStruct* TypeInfo, int32 Seed )
+{
+	for (TFieldIterator<UProperty> It(TypeInfo, EFieldIteratorFlags::IncludeSuper); It; ++It)
+	{
+		for (int32 ArrayIndex = 0; ArrayIndex < It->ArrayDim; ++ArrayIndex)
+		{
+			FillBenchmarkValue(It->ContainerPtrToValuePtr<void>(Data, ArrayIndex), *It, Seed++);
+		}
+	}
+}
+
+
+/** Checks whether all properties of two messages of the same type are identical. */
+static bool AreBenchmarkMessagesIdentical( const void* A, const void* B, UStruct* TypeInfo )
+{
+	for (TFieldIterator<UProperty> It(TypeInfo, EFieldIteratorFlags::IncludeSuper); It; ++It)
+	{
+		for (int32 ArrayIndex = 0; ArrayIndex < It->ArrayDim; ++ArrayIndex)
+		{
+			if (!It->Identical_InContainer(A, B, ArrayIndex, 0))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+
+/** Accumulated results of one serializer. */
+struct FMessageBenchmarkResult
+{
+	double SerializeTime;
+	double DeserializeTime;
+	int64 NumBytes;
+	int32 NumMessages;
+	int32 NumFailed;
+
+	FMessageBenchmarkResult( )
+		: SerializeTime(0.0)
+		, DeserializeTime(0.0)
+		, NumBytes(0)
+		, NumMessages(0)
+		, NumFailed(0)
+	{ }
+};
+
+
+/**
+ * Serializes and deserializes a message MessageBenchmarkNumIterations times.
+ *
+ * @param Serializer - The serializer to use.
+ * @param Context - The message to serialize.
+ * @param Result - Will hold the accumulated times and sizes.
+ * @param bCheckRoundTrip - Whether the deserialized message has to be identical to the original.
+ *
+ * @return false if the message failed to make the round trip.
+ */
+static bool RunMessageSerializerBenchmark( ISerializeMessages& Serializer, const IMessageContextRef& Context, FMessageBenchmarkResult& Result, bool bCheckRoundTrip )
+{
+	UScriptStruct* TypeInfo = Context->GetMessageTypeInfo().Get();
+	TArray<uint8> Buffer;
+	bool bSucceeded = true;
+
+	for (int32 Iteration = 0; Iteration < MessageBenchmarkNumIterations && bSucceeded; ++Iteration)
+	{
+		Buffer.Reset();
+		FMemoryWriter Writer(Buffer);
+
+		double StartTime = FPlatformTime::Seconds();
+		bSucceeded = Serializer.SerializeMessage(Context, Writer);
+		Result.SerializeTime += FPlatformTime::Seconds() - StartTime;
+		Result.NumBytes += Buffer.Num();
+
+		if (!bSucceeded)
+		{
+			break;
+		}
+
+		FMemoryReader Reader(Buffer);
+		IMutableMessageContextRef Deserialized = MakeShareable(new FMessageContext());
+
+		StartTime = FPlatformTime::Seconds();
+		bSucceeded = Serializer.DeserializeMessage(Reader, Deserialized);
+		Result.DeserializeTime += FPlatformTime::Seconds() - StartTime;
+
+		void* DeserializedMessage = const_cast<void*>(Deserialized->GetMessage());
+
+		if (bSucceeded && bCheckRoundTrip)
+		{
+			bSucceeded = (Deserialized->GetMessageTypeInfo().Get() == TypeInfo) && AreBenchmarkMessagesIdentical(Context->GetMessage(), DeserializedMessage, TypeInfo);
+		}
+
+		// message contexts destroy their message, but don't free it
+		if (DeserializedMessage != nullptr)
+		{
+			Deserialized->SetMessage(nullptr, nullptr);
+			TypeInfo->DestroyScriptStruct(DeserializedMessage);
+			FMemory::Free(DeserializedMessage);
+		}
+	}
+
+	Result.NumMessages++;
+
+	if (!bSucceeded)
+	{
+		Result.NumFailed++;
+	}
+
+	return bSucceeded;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMessageSerializerBenchmark, "Core.Messaging.Serializers.Binary vs Json Benchmark", EAutomationTestFlags::ATF_Editor | EAutomationTestFlags::ATF_Commandlet)
+
+
+/**
+ * Fills an instance of every loaded message type and sends it through the binary and the Json serializer.
+ * The binary serializer has to deliver identical messages, the Json serializer only contributes times and sizes.
+ */
+bool FMessageSerializerBenchmark::RunTest( const FString& Parameters )
+{
+	FBinaryMessageSerializer BinarySerializer;
+	FJsonMessageSerializer JsonSerializer;
+	FMessageBenchmarkResult BinaryResult;
+	FMessageBenchmarkResult JsonResult;
+
+	TArray<FMessageAddress> Recipients;
+	Recipients.Add(FMessageAddress::NewGuid());
+
+	for (TObjectIterator<UScriptStruct> It; It; ++It)
+	{
+		UScriptStruct* TypeInfo = *It;
+
+		// only message types can be deserialized
+		if (FMessageTypeMap::MessageTypeMap.Find(TypeInfo->GetName()) != TypeInfo)
+		{
+			continue;
+		}
+
+		void* Message = FMemory::Malloc(TypeInfo->PropertiesSize);
+		TypeInfo->InitializeScriptStruct(Message);
+		FillBenchmarkStruct(Message, TypeInfo, BinaryResult.NumMessages);
+
+		{
+			IMessageContextRef Context = MakeShareable(new FMessageContext(Message, TypeInfo, IMessageAttachmentPtr(), FMessageAddress::NewGuid(), Recipients, EMessageScope::Network, FDateTime::UtcNow(), FDateTime::MaxValue(), ENamedThreads::GameThread));
+
+			if (!RunMessageSerializerBenchmark(BinarySerializer, Context, BinaryResult, true))
+			{
+				AddError(FString::Printf(TEXT("Message type %s did not make it through the binary serializer intact"), *TypeInfo->GetName()));
+			}
+
+			RunMessageSerializerBenchmark(JsonSerializer, Context, JsonResult, false);
+		}
+
+		// the context destroyed the message
+		FMemory::Free(Message);
+	}
+
+	if (BinaryResult.NumMessages == 0)
+	{
+		AddWarning(TEXT("No message types are loaded, nothing to benchmark"));
+
+		return true;
+	}
+
+	const int32 NumRoundTrips = BinaryResult.NumMessages * MessageBenchmarkNumIterations;
+
+	AddLogItem(FString::Printf(TEXT("%d message types, %d round trips each"), BinaryResult.NumMessages, MessageBenchmarkNumIterations));
+	AddLogItem(FString::Printf(TEXT("                 %12s %12s"), TEXT("Binary"), TEXT("Json")));
+	AddLogItem(FString::Printf(TEXT("Serialize        %10.2fms %10.2fms"), BinaryResult.SerializeTime * 1000.0, JsonResult.SerializeTime * 1000.0));
+	AddLogItem(FString::Printf(TEXT("Deserialize      %10.2fms %10.2fms"), BinaryResult.DeserializeTime * 1000.0, JsonResult.DeserializeTime * 1000.0));
+	AddLogItem(FString::Printf(TEXT("Messages/s       %12.0f %12.0f"),
+		NumRoundTrips / FMath::Max(BinaryResult.SerializeTime + BinaryResult.DeserializeTime, SMALL_NUMBER),
+		NumRoundTrips / FMath::Max(JsonResult.SerializeTime + JsonResult.DeserializeTime, SMALL_NUMBER)));
+	AddLogItem(FString::Printf(TEXT("Average size     %10.0f B %10.0f B"), (double)BinaryResult.NumBytes / NumRoundTrips, (double)JsonResult.NumBytes / NumRoundTrips));
+	AddLogItem(FString::Printf(TEXT("Failed types     %12d %12d"), BinaryResult.NumFailed, JsonResult.NumFailed));
+
+	return BinaryResult.NumFailed == 0;
+}
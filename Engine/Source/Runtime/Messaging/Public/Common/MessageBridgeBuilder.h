@@ -81,6 +81,20 @@ public:
 	/**
 	 * Configures the bridge to use a binary message serializer.
 	 *
+	 * All bridges that exchange messages have to use the same serializer.
+	 *
+	 * @return This instance (for method chaining).
+	 */
+	FMessageBridgeBuilder& UsingBinarySerializer( )
+	{
+		Serializer = IMessagingModule::Get().CreateBinaryMessageSerializer();
+
+		return *this;
+	}
+
+	/**
+	 * Configures the bridge to use a Json message serializer.
+	 *
 	 * @return This instance (for method chaining).
 	 */
 	FMessageBridgeBuilder& UsingJsonSerializer( )
@@ -43,6 +43,16 @@ public:
 	 */
 	virtual IMessageBusPtr CreateBus( const IAuthorizeMessageRecipientsPtr& RecipientAuthorizer ) = 0;
 
+	/**
+	 * Creates a binary message serializer.
+	 *
+	 * Binary messages are much smaller and faster to (de)serialize than Json messages, but both ends
+	 * need the same build of a message type; messages with a different layout are dropped.
+	 *
+	 * @return A new serializer.
+	 */
+	virtual ISerializeMessagesPtr CreateBinaryMessageSerializer( ) = 0;
+
 	/**
 	 * Creates a Json message serializer (deprecated).
 	 *
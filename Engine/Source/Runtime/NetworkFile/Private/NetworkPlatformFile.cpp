@@ -16,6 +16,18 @@
 
 DEFINE_LOG_CATEGORY(LogNetworkPlatformFile);
 
+/** Bump this when the format of the local file hashes changes */
+static const int32 LocalFileHashesVersion = 1;
+
+/** Number of synced files after which their hashes are saved */
+static const int32 LocalFileHashesSaveInterval = 64;
+
+/** Where the hashes of the files synced from the server are kept between runs */
+static FString GetLocalFileHashesFilename()
+{
+	return FPaths::GeneratedConfigDir() / TEXT("NetworkFileHashes.bin");
+}
+
 
 FNetworkPlatformFile::FNetworkPlatformFile()
 	: bHasLoadedDDCDirectories(false)
@@ -24,6 +36,7 @@ FNetworkPlatformFile::FNetworkPlatformFile()
 	, FileServerPort(DEFAULT_FILE_SERVING_PORT)
 	, FileSocket(NULL)
 	, MCSocket(NULL)
+	, NumUnsavedLocalFileHashes(0)
 	, FinishedAsyncReadUnsolicitedFiles(NULL)
 	, FinishedAsyncWriteUnsolicitedFiles(NULL)
 {
@@ -144,6 +157,10 @@ void FNetworkPlatformFile::InitializeAfterSetActive()
 			TMap<FString, FDateTime> ServerCachedFiles;
 			Response << ServerCachedFiles;
 
+			// receive the files earlier clients requested during startup
+			TArray<FString> ServerStartupFiles;
+			Response << ServerStartupFiles;
+
 			bool bDeleteAllFiles = true;
 			// Check the stored cooked version
 			FString CookedVersionFile = FPaths::GeneratedConfigDir() / TEXT("CookedVersion.txt");
@@ -182,8 +199,13 @@ void FNetworkPlatformFile::InitializeAfterSetActive()
 				UE_LOG(LogNetworkPlatformFile, Display, TEXT("Cooked version file missing: %s\n"), *CookedVersionFile);
 			}
 
+			// the hashes of files synced by earlier runs let out of date files be checked with the server instead of being deleted
+			LoadLocalFileHashes();
+
 			if (bDeleteAllFiles == true)
 			{
+				LocalFileHashes.Empty();
+
 				// Make sure the config file exists...
 				InnerPlatformFile->CreateDirectoryTree(*(FPaths::GeneratedConfigDir()));
 				// Update the cooked version file
@@ -212,6 +234,9 @@ void FNetworkPlatformFile::InitializeAfterSetActive()
 				InnerPlatformFile->IterateDirectory( *ContentFolder, Visitor);
 			}
 
+			// out of date files whose contents may not have changed, they are synced together after startup
+			TArray<FString> FilesToSync;
+
 			// delete out of date files using the server cached files
 			for (TMap<FString, FDateTime>::TIterator It(ServerCachedFiles); It; ++It)
 			{
@@ -240,15 +265,22 @@ void FNetworkPlatformFile::InitializeAfterSetActive()
 						bDeleteFile = (TimeDiffInSeconds > 1.0) || (TimeDiffInSeconds < -1.0);
 						if (bDeleteFile == true)
 						{
-							if (InnerPlatformFile->FileExists(*ServerFile) == true)
+							if (InnerPlatformFile->FileExists(*ServerFile) == false)
 							{
-								UE_LOG(LogNetworkPlatformFile, Display, TEXT("Deleting cached file: TimeDiff %5.3f, %s"), TimeDiffInSeconds, *It.Key());
+								// It's a directory
+								bDeleteFile = false;
 							}
-							else
+							else if (LocalFileHashes.Contains(ServerFile))
 							{
-								// It's a directory
+								// the server only sends it again if the contents changed
+								UE_LOG(LogNetworkPlatformFile, Display, TEXT("Validating cached file: TimeDiff %5.3f, %s"), TimeDiffInSeconds, *It.Key());
+								FilesToSync.Add(ServerFile);
 								bDeleteFile = false;
 							}
+							else
+							{
+								UE_LOG(LogNetworkPlatformFile, Display, TEXT("Deleting cached file: TimeDiff %5.3f, %s"), TimeDiffInSeconds, *It.Key());
+							}
 						}
 					}
 				}
@@ -285,6 +317,34 @@ void FNetworkPlatformFile::InitializeAfterSetActive()
 			{
 				UE_LOG(LogNetworkPlatformFile, Fatal, TEXT("Could not sync test file %s."), *TestSyncFile);
 			}
+
+			// the files earlier clients requested during startup are needed now too, get them along with the out of date
+			// files in one request instead of one at a time when they are first opened
+			for (int32 Index = 0; Index < ServerStartupFiles.Num(); Index++)
+			{
+				FString StartupFile = ServerStartupFiles[Index];
+				ConvertServerFilenameToClientFilename(StartupFile);
+				if (!IsInLocalDirectory(StartupFile) && !InnerPlatformFile->FileExists(*StartupFile))
+				{
+					FilesToSync.AddUnique(StartupFile);
+				}
+			}
+
+			// the same goes for the files an earlier run synced but that are gone now
+			{
+				// unsolicited files from syncing the test file may still be adding hashes
+				FScopeLock HashesLock(&LocalFileHashesCriticalSection);
+				for (TMap<FString, FSHAHash>::TConstIterator It(LocalFileHashes); It; ++It)
+				{
+					if (ServerFiles.FindFile(It.Key()) != NULL && !InnerPlatformFile->FileExists(*It.Key()))
+					{
+						FilesToSync.AddUnique(It.Key());
+					}
+				}
+			}
+
+			SyncFiles(FilesToSync);
+			SaveLocalFileHashes();
 		}
 	}
 
@@ -654,9 +714,9 @@ bool FNetworkPlatformFile::SendMessageToServer(const TCHAR* Message, IPlatformFi
 
 		FArrayReader Response;
 #if USE_MCSOCKET_FOR_NFS
-		if (FNFSMessageHeader::SendPayloadAndReceiveResponse(Payload, Response, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main)) == false)
+		if (FNFSMessageHeader::SendPayloadAndReceiveResponse(Payload, Response, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main, SocketCriticalSection)) == false)
 #else
-		if (FNFSMessageHeader::SendPayloadAndReceiveResponse(Payload, Response, FSimpleAbstractSocket_FSocket(FileSocket)) == false)
+		if (FNFSMessageHeader::SendPayloadAndReceiveResponse(Payload, Response, FSimpleAbstractSocket_FSocket(FileSocket, SocketCriticalSection)) == false)
 #endif
 		{
 			return false;
@@ -699,17 +759,20 @@ public:
 	/** timestamp for the file **/
 	FDateTime ServerTimeStamp;
 	IPlatformFile& InnerPlatformFile;
+	/** Network file to remember the hash of the written file in */
+	FNetworkPlatformFile& NetworkFile;
 	FScopedEvent* Event;
 
-	uint8 Buffer[128 * 1024];
+	uint8 Buffer[FNFSFileContents::BlockSize];
 
 	/** Constructor
 	*/
-	FAsyncNetworkWriteWorker(const TCHAR* InFilename, FArchive* InArchive, FDateTime InServerTimeStamp, IPlatformFile* InInnerPlatformFile, FScopedEvent* InEvent)
+	FAsyncNetworkWriteWorker(const TCHAR* InFilename, FArchive* InArchive, FDateTime InServerTimeStamp, IPlatformFile* InInnerPlatformFile, FNetworkPlatformFile* InNetworkFile, FScopedEvent* InEvent)
 		: Filename(InFilename)
 		, FileArchive(InArchive)
 		, ServerTimeStamp(InServerTimeStamp)
 		, InnerPlatformFile(*InInnerPlatformFile)
+		, NetworkFile(*InNetworkFile)
 		, Event(InEvent)
 	{
 	}
@@ -717,72 +780,98 @@ public:
 	/** Write the file  */
 	void DoWork()
 	{
-		if (InnerPlatformFile.FileExists(*Filename))
+		// Read the header first so that the correct amount of data is read from the archive
+		// before exiting this worker.
+		FNFSFileContents::FHeader Header;
+		*FileArchive << Header;
+
+		if (Header.bUnchanged)
 		{
+			// the local copy has the server's contents, it only needs the server's timestamp
 			InnerPlatformFile.SetReadOnly(*Filename, false);
-			InnerPlatformFile.DeleteFile(*Filename);
+			InnerPlatformFile.SetTimeStamp(*Filename, ServerTimeStamp);
 		}
-		// Read FileSize first so that the correct amount of data is read from the archive
-		// before exiting this worker.
-		uint64 FileSize;
-		*FileArchive << FileSize;
-		if (ServerTimeStamp != FDateTime::MinValue())  // if the file didn't actually exist on the server, don't create a zero byte file
+		else
 		{
-			FString TempFilename = Filename + TEXT(".tmp");
-			InnerPlatformFile.CreateDirectoryTree(*FPaths::GetPath(Filename));
+			if (InnerPlatformFile.FileExists(*Filename))
 			{
-				TAutoPtr<IFileHandle> FileHandle;
-				FileHandle = InnerPlatformFile.OpenWrite(*TempFilename);
-
-				if (!FileHandle)
+				InnerPlatformFile.SetReadOnly(*Filename, false);
+				InnerPlatformFile.DeleteFile(*Filename);
+			}
+			if (ServerTimeStamp != FDateTime::MinValue())  // if the file didn't actually exist on the server, don't create a zero byte file
+			{
+				FString TempFilename = Filename + TEXT(".tmp");
+				InnerPlatformFile.CreateDirectoryTree(*FPaths::GetPath(Filename));
 				{
-					UE_LOG(LogNetworkPlatformFile, Fatal, TEXT("Could not open file for writing '%s'."), *TempFilename);
-				}
+					TAutoPtr<IFileHandle> FileHandle;
+					FileHandle = InnerPlatformFile.OpenWrite(*TempFilename);
 
-				// now write the file from bytes pulled from the archive
-				// read/write a chunk at a time
-				uint64 RemainingData = FileSize;
-				while (RemainingData)
-				{
-					// read next chunk from archive
-					uint32 LocalSize = FPlatformMath::Min<uint32>(ARRAY_COUNT(Buffer), RemainingData);
-					FileArchive->Serialize(Buffer, LocalSize);
-					// write it out
-					if (!FileHandle->Write(Buffer, LocalSize))
+					if (!FileHandle)
 					{
-						UE_LOG(LogNetworkPlatformFile, Fatal, TEXT("Could not write '%s'."), *TempFilename);
+						UE_LOG(LogNetworkPlatformFile, Fatal, TEXT("Could not open file for writing '%s'."), *TempFilename);
 					}
 
-					// decrement how much is left
-					RemainingData -= LocalSize;
-				}
+					// now write the file from blocks pulled from the archive, hashing them on the way
+					FSHA1 HashState;
+					uint64 RemainingData = Header.Size;
+					while (RemainingData)
+					{
+						// read and uncompress next block from archive
+						int32 LocalSize = (int32)FMath::Min<uint64>(FNFSFileContents::BlockSize, RemainingData);
+						if (!FNFSFileContents::ReadBlock(*FileArchive, Buffer, LocalSize))
+						{
+							UE_LOG(LogNetworkPlatformFile, Fatal, TEXT("Could not read '%s' from the server."), *Filename);
+						}
+						HashState.Update(Buffer, LocalSize);
 
-				// delete async write archives
-				if (Event)
-				{
-					delete FileArchive;
+						// write it out
+						if (!FileHandle->Write(Buffer, LocalSize))
+						{
+							UE_LOG(LogNetworkPlatformFile, Fatal, TEXT("Could not write '%s'."), *TempFilename);
+						}
+
+						// decrement how much is left
+						RemainingData -= LocalSize;
+					}
+
+					FSHAHash LocalHash;
+					HashState.Final();
+					HashState.GetHash(LocalHash.Hash);
+					if (LocalHash != Header.Hash)
+					{
+						UE_LOG(LogNetworkPlatformFile, Fatal, TEXT("Hash of '%s' is %s, the server's is %s."), *Filename, *LocalHash.ToString(), *Header.Hash.ToString());
+					}
 				}
 
-				if (InnerPlatformFile.FileSize(*TempFilename) != FileSize)
+				if (InnerPlatformFile.FileSize(*TempFilename) != Header.Size)
 				{
 					UE_LOG(LogNetworkPlatformFile, Fatal, TEXT("Did not write '%s'."), *TempFilename);
 				}
-			}
 
-			// rename from temp filename to real filename
-			InnerPlatformFile.MoveFile(*Filename, *TempFilename);
+				// rename from temp filename to real filename
+				InnerPlatformFile.MoveFile(*Filename, *TempFilename);
 
-			// now set the server's timestamp on the local file (so we can make valid comparisons)
-			InnerPlatformFile.SetTimeStamp(*Filename, ServerTimeStamp);
+				// now set the server's timestamp on the local file (so we can make valid comparisons)
+				InnerPlatformFile.SetTimeStamp(*Filename, ServerTimeStamp);
+			}
+		}
 
+		if (ServerTimeStamp != FDateTime::MinValue())
+		{
 			FDateTime CheckTime = InnerPlatformFile.GetTimeStamp(*Filename);
 			if (CheckTime < ServerTimeStamp)
 			{
 				UE_LOG(LogNetworkPlatformFile, Fatal, TEXT("Could Not Set Timestamp '%s'."), *Filename);
 			}
+
+			NetworkFile.SetLocalFileHash(Filename, Header.Hash);
 		}
+
+		// delete async write archives
 		if (Event)
 		{
+			delete FileArchive;
+
 			if (!OutstandingAsyncWrites.Decrement())
 			{
 				Event->Trigger(); // last file, fire trigger
@@ -801,15 +890,15 @@ public:
 /**
  * Write a file async or sync, with the data coming from a TArray or an FArchive/Filesize
  */
-void SyncWriteFile(FArchive* Archive, const FString& Filename, FDateTime ServerTimeStamp, IPlatformFile& InnerPlatformFile)
+void SyncWriteFile(FArchive* Archive, const FString& Filename, FDateTime ServerTimeStamp, IPlatformFile& InnerPlatformFile, FNetworkPlatformFile& NetworkFile)
 {
 	FScopedEvent* NullEvent = NULL;
-	(new FAutoDeleteAsyncTask<FAsyncNetworkWriteWorker>(*Filename, Archive, ServerTimeStamp, &InnerPlatformFile, NullEvent))->StartSynchronousTask();
+	(new FAutoDeleteAsyncTask<FAsyncNetworkWriteWorker>(*Filename, Archive, ServerTimeStamp, &InnerPlatformFile, &NetworkFile, NullEvent))->StartSynchronousTask();
 }
 
-void AsyncWriteFile(FArchive* Archive, const FString& Filename, FDateTime ServerTimeStamp, IPlatformFile& InnerPlatformFile, FScopedEvent* Event = NULL)
+void AsyncWriteFile(FArchive* Archive, const FString& Filename, FDateTime ServerTimeStamp, IPlatformFile& InnerPlatformFile, FNetworkPlatformFile& NetworkFile, FScopedEvent* Event = NULL)
 {
-	(new FAutoDeleteAsyncTask<FAsyncNetworkWriteWorker>(*Filename, Archive, ServerTimeStamp, &InnerPlatformFile, Event))->StartBackgroundTask();
+	(new FAutoDeleteAsyncTask<FAsyncNetworkWriteWorker>(*Filename, Archive, ServerTimeStamp, &InnerPlatformFile, &NetworkFile, Event))->StartBackgroundTask();
 }
 
 void AsyncReadUnsolicitedFile(int32 InNumUnsolictedFiles, FNetworkPlatformFile& InNetworkFile, FScopedEvent* InEvent, IPlatformFile& InInnerPlatformFile, 
@@ -862,7 +951,7 @@ void AsyncReadUnsolicitedFile(int32 InNumUnsolictedFiles, FNetworkPlatformFile&
 				*UnsolictedResponse << UnsolictedServerTimeStamp;
 
 				// write the file by pulling out of the FArrayReader
-				AsyncWriteFile(UnsolictedResponse, UnsolictedReplyFile, UnsolictedServerTimeStamp, InnerPlatformFile, AllDoneEvent);
+				AsyncWriteFile(UnsolictedResponse, UnsolictedReplyFile, UnsolictedServerTimeStamp, InnerPlatformFile, NetworkFile, AllDoneEvent);
 			}
 			Event->Trigger();
 		}
@@ -982,7 +1071,7 @@ void FNetworkPlatformFile::EnsureFileIsLocal(const FString& Filename)
 	Response << ServerTimeStamp;
 
 	// write the file in chunks, synchronously
-	SyncWriteFile(&Response, ReplyFile, ServerTimeStamp, *InnerPlatformFile);
+	SyncWriteFile(&Response, ReplyFile, ServerTimeStamp, *InnerPlatformFile, *this);
 
 	int32 NumUnsolictedFiles;
 	Response << NumUnsolictedFiles;
@@ -994,10 +1083,189 @@ void FNetworkPlatformFile::EnsureFileIsLocal(const FString& Filename)
 		AsyncReadUnsolicitedFile(NumUnsolictedFiles, *this, FinishedAsyncReadUnsolicitedFiles, *InnerPlatformFile, FinishedAsyncWriteUnsolicitedFiles, ServerEngineDir, ServerGameDir);
 	}
 
+	// keep what has been synced so far, runs often don't exit cleanly
+	if (NumUnsavedLocalFileHashes >= LocalFileHashesSaveInterval)
+	{
+		SaveLocalFileHashes();
+	}
+
 	ThisTime = 1000.0f * float(FPlatformTime::Seconds() - StartTime);
 	//UE_LOG(LogNetworkPlatformFile, Display, TEXT("Write file to local %6.2fms"), ThisTime);
 }
 
+void FNetworkPlatformFile::SyncFiles(const TArray<FString>& Filenames)
+{
+	delete FinishedAsyncReadUnsolicitedFiles; // wait here for any async unsolicited files to finish reading being read from the network 
+	FinishedAsyncReadUnsolicitedFiles = NULL;
+	delete FinishedAsyncWriteUnsolicitedFiles; // wait here for any async unsolicited files to finish writing 
+	FinishedAsyncWriteUnsolicitedFiles = NULL;
+
+	FScopeLock ScopeLock(&SynchronizationObject);
+
+	// send the hash of each local copy along, so the server can leave out the files that didn't change
+	TArray<FString> RequestedFiles;
+	TArray<FSHAHash> LocalHashes;
+	for (int32 Index = 0; Index < Filenames.Num(); Index++)
+	{
+		const FString& Filename = Filenames[Index];
+		if (CachedLocalFiles.Find(Filename) == NULL)
+		{
+			CachedLocalFiles.Add(Filename);
+			RequestedFiles.Add(Filename);
+			LocalHashes.Add(FindLocalFileHash(Filename));
+		}
+	}
+
+	if (RequestedFiles.Num() == 0)
+	{
+		return;
+	}
+
+	double StartTime = FPlatformTime::Seconds();
+
+	FNetworkFileArchive Payload(NFS_Messages::SyncFiles);
+	Payload << RequestedFiles;
+	Payload << LocalHashes;
+
+	if (!WrapAndSendPayload(Payload))
+	{
+		UE_LOG(LogNetworkPlatformFile, Fatal, TEXT("Send failure!"));
+		return;
+	}
+
+	// the server sends the files one at a time without waiting for us, so write each one in the background
+	// while the next one is received
+	FScopedEvent* FinishedWrites = new FScopedEvent;
+	check(!OutstandingAsyncWrites.GetValue());
+	OutstandingAsyncWrites.Add(RequestedFiles.Num());
+
+	int64 NumBytesReceived = 0;
+	for (int32 Index = 0; Index < RequestedFiles.Num(); Index++)
+	{
+		// allocate array reader on the heap, because the AsyncWriteFile function will delete it
+		FArrayReader* FileResponse = new FArrayReader;
+		if (!ReceivePayload(*FileResponse))
+		{
+			UE_LOG(LogNetworkPlatformFile, Fatal, TEXT("Receive failure!"));
+			return;
+		}
+		NumBytesReceived += FileResponse->Num();
+
+		FString ReplyFile;
+		*FileResponse << ReplyFile;
+		ConvertServerFilenameToClientFilename(ReplyFile);
+
+		// get the server file timestamp
+		FDateTime ServerTimeStamp;
+		*FileResponse << ServerTimeStamp;
+
+		AsyncWriteFile(FileResponse, ReplyFile, ServerTimeStamp, *InnerPlatformFile, *this, FinishedWrites);
+	}
+
+	delete FinishedWrites; // wait here for the files to be written
+
+	FArrayReader Response;
+	if (!ReceivePayload(Response))
+	{
+		UE_LOG(LogNetworkPlatformFile, Fatal, TEXT("Receive failure!"));
+		return;
+	}
+
+	int32 NumSyncedFiles;
+	Response << NumSyncedFiles;
+	check(NumSyncedFiles == RequestedFiles.Num());
+
+	const double SyncTime = FPlatformTime::Seconds() - StartTime;
+	const double MegabytesReceived = NumBytesReceived / (1024.0 * 1024.0);
+	UE_LOG(LogNetworkPlatformFile, Display, TEXT("Synced %d files in %.3f seconds, received %.2f MB at %.2f MB/s"),
+		NumSyncedFiles, SyncTime, MegabytesReceived, SyncTime > 0.0 ? MegabytesReceived / SyncTime : 0.0);
+
+	int32 NumUnsolictedFiles;
+	Response << NumUnsolictedFiles;
+
+	if (NumUnsolictedFiles)
+	{
+		FinishedAsyncReadUnsolicitedFiles = new FScopedEvent;
+		FinishedAsyncWriteUnsolicitedFiles = new FScopedEvent;
+		AsyncReadUnsolicitedFile(NumUnsolictedFiles, *this, FinishedAsyncReadUnsolicitedFiles, *InnerPlatformFile, FinishedAsyncWriteUnsolicitedFiles, ServerEngineDir, ServerGameDir);
+	}
+}
+
+FSHAHash FNetworkPlatformFile::FindLocalFileHash(const FString& Filename)
+{
+	if (InnerPlatformFile->FileExists(*Filename))
+	{
+		FScopeLock ScopeLock(&LocalFileHashesCriticalSection);
+		const FSHAHash* Hash = LocalFileHashes.Find(Filename);
+		if (Hash != NULL)
+		{
+			return *Hash;
+		}
+	}
+	return FSHAHash();
+}
+
+void FNetworkPlatformFile::SetLocalFileHash(const FString& Filename, const FSHAHash& Hash)
+{
+	FScopeLock ScopeLock(&LocalFileHashesCriticalSection);
+	LocalFileHashes.Add(Filename, Hash);
+	NumUnsavedLocalFileHashes++;
+}
+
+void FNetworkPlatformFile::LoadLocalFileHashes()
+{
+	FScopeLock ScopeLock(&LocalFileHashesCriticalSection);
+	LocalFileHashes.Empty();
+	NumUnsavedLocalFileHashes = 0;
+
+	TAutoPtr<IFileHandle> FileHandle;
+	FileHandle = InnerPlatformFile->OpenRead(*GetLocalFileHashesFilename());
+	if (!FileHandle)
+	{
+		return;
+	}
+
+	TArray<uint8> Bytes;
+	Bytes.AddUninitialized(FileHandle->Size());
+	if (!FileHandle->Read(Bytes.GetTypedData(), Bytes.Num()))
+	{
+		return;
+	}
+
+	FMemoryReader Reader(Bytes);
+	int32 Version = 0;
+	Reader << Version;
+	if (Version == LocalFileHashesVersion)
+	{
+		Reader << LocalFileHashes;
+	}
+	if (Reader.IsError())
+	{
+		LocalFileHashes.Empty();
+	}
+}
+
+void FNetworkPlatformFile::SaveLocalFileHashes()
+{
+	FBufferArchive Writer;
+	{
+		FScopeLock ScopeLock(&LocalFileHashesCriticalSection);
+		int32 Version = LocalFileHashesVersion;
+		Writer << Version;
+		Writer << LocalFileHashes;
+		NumUnsavedLocalFileHashes = 0;
+	}
+
+	InnerPlatformFile->CreateDirectoryTree(*FPaths::GeneratedConfigDir());
+
+	TAutoPtr<IFileHandle> FileHandle;
+	FileHandle = InnerPlatformFile->OpenWrite(*GetLocalFileHashesFilename());
+	if (!FileHandle || !FileHandle->Write(Writer.GetData(), Writer.Num()))
+	{
+		UE_LOG(LogNetworkPlatformFile, Warning, TEXT("Could not write '%s'."), *GetLocalFileHashesFilename());
+	}
+}
+
 bool FNetworkPlatformFile::IsInLocalDirectoryUnGuarded(const FString& Filename)
 {
 	// cache the directory of the input file
@@ -1081,18 +1349,18 @@ bool FNetworkPlatformFile::ReceivePayload(FArrayReader& OutPayload)
 {
 	if (MCSocket)
 	{
-		return FNFSMessageHeader::ReceivePayload(OutPayload, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main));
+		return FNFSMessageHeader::ReceivePayload(OutPayload, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main, SocketCriticalSection));
 	}
-	return FNFSMessageHeader::ReceivePayload(OutPayload, FSimpleAbstractSocket_FSocket(FileSocket));
+	return FNFSMessageHeader::ReceivePayload(OutPayload, FSimpleAbstractSocket_FSocket(FileSocket, SocketCriticalSection));
 }
 
 bool FNetworkPlatformFile::WrapAndSendPayload(const TArray<uint8>& Payload)
 {
 	if (MCSocket)
 	{
-		return FNFSMessageHeader::WrapAndSendPayload(Payload, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main));
+		return FNFSMessageHeader::WrapAndSendPayload(Payload, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main, SocketCriticalSection));
 	}
-	return FNFSMessageHeader::WrapAndSendPayload(Payload, FSimpleAbstractSocket_FSocket(FileSocket));
+	return FNFSMessageHeader::WrapAndSendPayload(Payload, FSimpleAbstractSocket_FSocket(FileSocket, SocketCriticalSection));
 }
 
 bool FNetworkPlatformFile::SendPayloadAndReceiveResponse(const TArray<uint8>& Payload, class FArrayReader& Response)
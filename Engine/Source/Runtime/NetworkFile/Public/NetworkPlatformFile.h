@@ -121,6 +121,14 @@ public:
 	 */
 	bool ReceivePayload(FArrayReader& OutPayload);
 
+	/**
+	 * Remembers the hash of a file synced from the server, only public for an async task
+	 *
+	 * @param Filename The client version of the filename
+	 * @param Hash Hash of the file's contents
+	 */
+	void SetLocalFileHash(const FString& Filename, const FSHAHash& Hash);
+
 	static void ConvertServerFilenameToClientFilename(FString& FilenameToConvert, const FString& InServerEngineDir, const FString& InServerGameDir);
 
 protected:
@@ -145,6 +153,28 @@ protected:
 
 	virtual void ProcessServerInitialResponse(FArrayReader& InResponse, int32 OutServerPackageVersion, int32 OutServerPackageLicenseeVersion);
 
+	/**
+	 * Given a filename, make sure the file exists on the local filesystem
+	 */
+	void EnsureFileIsLocal(const FString& Filename);
+
+	/**
+	 * Given a list of filenames, make sure they all exist on the local filesystem and are up to date. The files are
+	 * requested at once and streamed back by the server, local copies with the server's hash are kept.
+	 */
+	void SyncFiles(const TArray<FString>& Filenames);
+
+	/**
+	 * This function will send a payload data (with header) and wait for a response, serializing
+	 * the response to a FBufferArchive
+	 *
+	 * @param Payload Bytes to send over the network
+	 * @param Response The archive to read the response into
+	 *
+	 * @return true if successful
+	 */
+	bool SendPayloadAndReceiveResponse(const TArray<uint8>& Payload, class FArrayReader& Response);
+
 private:
 	
 	/**
@@ -159,9 +189,15 @@ private:
 	bool IsInLocalDirectory(const FString& Filename);
 
 	/**
-	 * Given a filename, make sure the file exists on the local filesystem
+	 * @return the hash of the local copy of a file synced from the server, all zeros if there is no local copy or it isn't known
 	 */
-	void EnsureFileIsLocal(const FString& Filename);
+	FSHAHash FindLocalFileHash(const FString& Filename);
+
+	/** Loads the hashes of files synced by earlier runs */
+	void LoadLocalFileHashes();
+
+	/** Saves the hashes of synced files for later runs */
+	void SaveLocalFileHashes();
 
 	/**
 	 * This function will create a header for the payload, then send the header and 
@@ -173,17 +209,6 @@ private:
 	 */
 	bool WrapAndSendPayload(const TArray<uint8>& Payload);
 
-	/**
-	 * This function will send a payload data (with header) and wait for a response, serializing
-	 * the response to a FBufferArchive
-	 *
-	 * @param Payload Bytes to send over the network
-	 * @param Response The archive to read the response into
-	 *
-	 * @return true if successful
-	 */
-	bool SendPayloadAndReceiveResponse(const TArray<uint8>& Payload, class FArrayReader& Response);
-
 
 protected:
 
@@ -215,6 +240,17 @@ protected:
 	class FSocket*		FileSocket;
 	class FMultichannelTcpSocket* MCSocket;
 
+	/** Held while a message is sent or received on the socket */
+	FCriticalSection	SocketCriticalSection;
+
+	/** Hashes of the files synced from the server, by client filename, kept between runs */
+	TMap<FString, FSHAHash> LocalFileHashes;
+
+	/** Number of hashes added since they were last saved */
+	int32 NumUnsavedLocalFileHashes;
+
+	FCriticalSection	LocalFileHashesCriticalSection;
+
 private:
 	FScopedEvent* FinishedAsyncReadUnsolicitedFiles;
 	FScopedEvent* FinishedAsyncWriteUnsolicitedFiles;
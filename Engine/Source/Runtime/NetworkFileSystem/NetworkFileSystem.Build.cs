@@ -18,6 +18,7 @@ namespace UnrealBuildTool.Rules
 			new string[]
 			{
                 "CoreUObject",
+				"NetworkFile",
 				"Projects",
 				"SandboxFile",
 				"TargetPlatform",
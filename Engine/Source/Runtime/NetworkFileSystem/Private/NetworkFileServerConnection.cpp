@@ -9,6 +9,38 @@
 #include "TargetPlatform.h"
 
 
+/** Seconds after a client asked for the file list during which the files it requests are considered startup files */
+static const double StartupFilesRecordTime = 60.0;
+
+/** Number of clients in a row that may not request a startup file before it is taken off the list */
+static const int32 StartupFilesMaxAge = 8;
+
+
+/**
+ * Loads the startup files recorded for a platform, one file per line after the number of clients in a row that
+ * didn't request it.
+ */
+static void LoadStartupFiles( const FString& StartupFilesFilename, TMap<FString, int32>& OutStartupFileAges )
+{
+	FString StartupFileList;
+	if (FFileHelper::LoadFileToString(StartupFileList, *StartupFilesFilename))
+	{
+		TArray<FString> Lines;
+		StartupFileList.ParseIntoArray(&Lines, LINE_TERMINATOR, true);
+
+		for (int32 Index = 0; Index < Lines.Num(); Index++)
+		{
+			FString Age;
+			FString Filename;
+			if (Lines[Index].Split(TEXT("\t"), &Age, &Filename))
+			{
+				OutStartupFileAges.Add(Filename, FCString::Atoi(*Age));
+			}
+		}
+	}
+}
+
+
 /* FNetworkFileServerClientConnection structors
  *****************************************************************************/
 
@@ -17,6 +49,8 @@ FNetworkFileServerClientConnection::FNetworkFileServerClientConnection( FSocket*
 	, MCSocket(NULL)
 	, Sandbox(NULL)
 	, Socket(InSocket)
+	, ConnectTime(0.0)
+	, bStartupFilesSaved(false)
 	, bNeedsToStop(false)
 {
 	if (InFileRequestDelegate.IsBound())
@@ -70,9 +104,9 @@ uint32 FNetworkFileServerClientConnection::Run( )
 		// read a header and payload pair
 		FArrayReader Payload; 
 #if USE_MCSOCKET_FOR_NFS
-		if (FNFSMessageHeader::ReceivePayload(Payload, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main)) == false)
+		if (FNFSMessageHeader::ReceivePayload(Payload, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main, SocketCriticalSection)) == false)
 #else
-		if (FNFSMessageHeader::ReceivePayload(Payload, FSimpleAbstractSocket_FSocket(Socket)) == false)
+		if (FNFSMessageHeader::ReceivePayload(Payload, FSimpleAbstractSocket_FSocket(Socket, SocketCriticalSection)) == false)
 #endif
 		{
 			// if we failed to receive the payload, then the client is most likely dead, so, we can kill this connection
@@ -96,6 +130,9 @@ void FNetworkFileServerClientConnection::Stop( )
 
 void FNetworkFileServerClientConnection::Exit()
 {
+	// the client may disconnect before its startup is over
+	SaveStartupFiles();
+
 	// close all the files the client had opened through us when the client disconnects
 	for (TMap<uint64, IFileHandle*>::TIterator It(OpenFiles); It; ++It)
 	{
@@ -267,6 +304,11 @@ void FNetworkFileServerClientConnection::ProcessPayload( FArchive& Ar )
 		bSendUnsolicitedFiles = true;
 		break;
 
+	case NFS_Messages::SyncFiles:
+		ProcessSyncFiles(Ar, Out);
+		bSendUnsolicitedFiles = true;
+		break;
+
 	case NFS_Messages::RecompileShaders:
 		ProcessRecompileShaders(Ar, Out);
 		break;
@@ -288,26 +330,18 @@ void FNetworkFileServerClientConnection::ProcessPayload( FArchive& Ar )
 		UE_LOG(LogFileServer, Verbose, TEXT("Returning payload with %d bytes"), Out.Num());
 
 		// send back a reply
-#if USE_MCSOCKET_FOR_NFS
-		FNFSMessageHeader::WrapAndSendPayload(Out, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main));
-#else
-		FNFSMessageHeader::WrapAndSendPayload(Out, FSimpleAbstractSocket_FSocket(Socket));
-#endif
+		SendPayload(Out);
 
 		if (bSendUnsolicitedFiles)
 		{
 			for (int32 Index = 0; Index < NumUnsolictedFiles; Index++)
 			{
 				FBufferArchive OutUnsolicitedFile;
-				PackageFile(UnsolictedFiles[Index], OutUnsolicitedFile);
+				PackageFile(UnsolictedFiles[Index], FSHAHash(), OutUnsolicitedFile);
 
 				UE_LOG(LogFileServer, Display, TEXT("Returning unsolicited file %s with %d bytes"), *UnsolictedFiles[Index], OutUnsolicitedFile.Num());
 
-#if USE_MCSOCKET_FOR_NFS
-				FNFSMessageHeader::WrapAndSendPayload(OutUnsolicitedFile, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main));
-#else
-				FNFSMessageHeader::WrapAndSendPayload(OutUnsolicitedFile, FSimpleAbstractSocket_FSocket(Socket));
-#endif
+				SendPayload(OutUnsolicitedFile);
 			}
 
 			UnsolictedFiles.Empty();
@@ -757,6 +791,10 @@ void FNetworkFileServerClientConnection::ProcessGetFileList( FArchive& In, FArch
 		}
 	}
 
+	// the files clients of this platform requested during startup are kept next to its sandbox
+	StartupFilesFilename = FPaths::GetPath(SandboxDirectory) / FString::Printf(TEXT("StartupFiles-%s.txt"), *ConnectedPlatformName);
+	ConnectTime = FPlatformTime::Seconds();
+
 	// delete any existing one first, in case game name somehow changed and client is re-asking for files (highly unlikely)
 	delete Sandbox;
 	Sandbox = new FSandboxPlatformFile(false);
@@ -843,6 +881,14 @@ void FNetworkFileServerClientConnection::ProcessGetFileList( FArchive& In, FArch
 	
 		// return the cached files and their timestamps
 		Out << VisitorForCacheDates.FileTimes;
+
+		// return the files earlier clients requested during startup, so this one can sync them in a single request
+		TMap<FString, int32> StartupFileAges;
+		LoadStartupFiles(StartupFilesFilename, StartupFileAges);
+
+		TArray<FString> PreviousStartupFiles;
+		StartupFileAges.GenerateKeyArray(PreviousStartupFiles);
+		Out << PreviousStartupFiles;
 	}
 }
 
@@ -866,7 +912,7 @@ void FNetworkFileServerClientConnection::ProcessHeartbeat( FArchive& In, FArchiv
 /* FStreamingNetworkFileServerConnection callbacks
  *****************************************************************************/
 
-void FNetworkFileServerClientConnection::PackageFile( FString& Filename, FArchive& Out )
+void FNetworkFileServerClientConnection::PackageFile( FString& Filename, const FSHAHash& ClientHash, FArchive& Out )
 {
 	// get file timestamp and send it to client
 	FDateTime ServerTimeStamp = Sandbox->GetTimeStamp(*Filename);
@@ -902,9 +948,20 @@ void FNetworkFileServerClientConnection::PackageFile( FString& Filename, FArchiv
 
 	Out << Filename;
 	Out << ServerTimeStamp;
-	uint64 FileSize = Contents.Num();
-	Out << FileSize;
-	Out.Serialize(Contents.GetData(), FileSize);
+
+	// a missing file never matches what the client has, so it always deletes its copy
+	const bool bFileExists = (ServerTimeStamp != FDateTime::MinValue());
+	FNFSFileContents::Write(Out, Contents.GetTypedData(), Contents.Num(), bFileExists ? ClientHash : FSHAHash());
+}
+
+
+void FNetworkFileServerClientConnection::SendPayload( const TArray<uint8>& Payload )
+{
+#if USE_MCSOCKET_FOR_NFS
+	FNFSMessageHeader::WrapAndSendPayload(Payload, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main, SocketCriticalSection));
+#else
+	FNFSMessageHeader::WrapAndSendPayload(Payload, FSimpleAbstractSocket_FSocket(Socket, SocketCriticalSection));
+#endif
 }
 
 
@@ -953,5 +1010,128 @@ void FNetworkFileServerClientConnection::ProcessSyncFile( FArchive& In, FArchive
 		}
 	}
 
-	PackageFile(Filename, Out);
+	PackageFile(Filename, FSHAHash(), Out);
+
+	RecordStartupFile(Filename);
+}
+
+
+void FNetworkFileServerClientConnection::ProcessSyncFiles( FArchive& In, FArchive& Out )
+{
+	// get the filenames and the hashes of the client's copies
+	TArray<FString> Filenames;
+	TArray<FSHAHash> ClientHashes;
+	In << Filenames;
+	In << ClientHashes;
+
+	if (ClientHashes.Num() != Filenames.Num())
+	{
+		UE_LOG(LogFileServer, Error, TEXT("SyncFiles request has %d hashes for %d files."), ClientHashes.Num(), Filenames.Num());
+		ClientHashes.Empty();
+		ClientHashes.AddZeroed(Filenames.Num());
+	}
+
+	for (int32 Index = 0; Index < Filenames.Num(); Index++)
+	{
+		ConvertClientFilenameToServerFilename(Filenames[Index]);
+	}
+
+	int64 NumBytesSent = 0;
+	double StartTime = FPlatformTime::Seconds();
+
+	// send each file as soon as it is ready, so the client writes one while the next one is being read and sent
+	for (int32 Index = 0; Index < Filenames.Num(); Index++)
+	{
+		TArray<FString> NewUnsolictedFiles;
+
+		FileRequestDelegate.ExecuteIfBound(Filenames[Index], NewUnsolictedFiles);
+
+		for (int32 UnsolicitedIndex = 0; UnsolicitedIndex < NewUnsolictedFiles.Num(); UnsolicitedIndex++)
+		{
+			if (!Filenames.Contains(NewUnsolictedFiles[UnsolicitedIndex]))
+			{
+				UnsolictedFiles.AddUnique(NewUnsolictedFiles[UnsolicitedIndex]);
+			}
+		}
+
+		FBufferArchive OutFile;
+		PackageFile(Filenames[Index], ClientHashes[Index], OutFile);
+		SendPayload(OutFile);
+
+		RecordStartupFile(Filenames[Index]);
+
+		NumBytesSent += OutFile.Num();
+	}
+
+	const double SyncTime = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogFileServer, Display, TEXT("Sent %d files with %.2f MB in %.3f seconds"), Filenames.Num(), NumBytesSent / (1024.0 * 1024.0), SyncTime);
+
+	// the reply tells the client all of the files were sent
+	int32 NumFiles = Filenames.Num();
+	Out << NumFiles;
+}
+
+
+void FNetworkFileServerClientConnection::RecordStartupFile( const FString& Filename )
+{
+	if (bStartupFilesSaved)
+	{
+		return;
+	}
+
+	if (FPlatformTime::Seconds() - ConnectTime > StartupFilesRecordTime)
+	{
+		SaveStartupFiles();
+		return;
+	}
+
+	// only files that exist are worth syncing ahead of time
+	if (Sandbox->FileExists(*Filename))
+	{
+		StartupFiles.AddUnique(Filename);
+	}
+}
+
+
+void FNetworkFileServerClientConnection::SaveStartupFiles( )
+{
+	if (bStartupFilesSaved || StartupFiles.Num() == 0)
+	{
+		return;
+	}
+	bStartupFilesSaved = true;
+
+	TMap<FString, int32> PreviousStartupFileAges;
+	LoadStartupFiles(StartupFilesFilename, PreviousStartupFileAges);
+
+	// clients that started with some of the files already local didn't request all of them, so the ones recorded before
+	// are kept for a while, unless they were deleted
+	TMap<FString, int32> StartupFileAges;
+	for (TMap<FString, int32>::TConstIterator It(PreviousStartupFileAges); It; ++It)
+	{
+		if (It.Value() < StartupFilesMaxAge && !StartupFiles.Contains(It.Key()) && Sandbox->FileExists(*It.Key()))
+		{
+			StartupFileAges.Add(It.Key(), It.Value() + 1);
+		}
+	}
+
+	for (int32 Index = 0; Index < StartupFiles.Num(); Index++)
+	{
+		StartupFileAges.Add(StartupFiles[Index], 0);
+	}
+
+	FString StartupFileList;
+	for (TMap<FString, int32>::TConstIterator It(StartupFileAges); It; ++It)
+	{
+		StartupFileList += FString::Printf(TEXT("%d\t%s"), It.Value(), *It.Key()) + LINE_TERMINATOR;
+	}
+
+	if (FFileHelper::SaveStringToFile(StartupFileList, *StartupFilesFilename))
+	{
+		UE_LOG(LogFileServer, Display, TEXT("Recorded %d startup files for %s in %s, %d requested by this client"), StartupFileAges.Num(), *ConnectedPlatformName, *StartupFilesFilename, StartupFiles.Num());
+	}
+	else
+	{
+		UE_LOG(LogFileServer, Warning, TEXT("Could not write the startup files to %s"), *StartupFilesFilename);
+	}
 }
\ No newline at end of file
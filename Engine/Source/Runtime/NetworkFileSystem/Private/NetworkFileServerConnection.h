@@ -155,7 +155,21 @@ protected:
 		return OpenFile ? *OpenFile : NULL;
 	}
 
-	void PackageFile( FString& Filename, FArchive& Out );
+	/**
+	 * Writes a file's name, timestamp and contents for the client.
+	 *
+	 * @param Filename - The server version of the filename.
+	 * @param ClientHash - Hash of the client's copy of the file, its contents are left out if they are the same.
+	 * @param Out - The archive to write to.
+	 */
+	void PackageFile( FString& Filename, const FSHAHash& ClientHash, FArchive& Out );
+
+	/**
+	 * Sends a payload to the client.
+	 *
+	 * @param Payload - The payload to send.
+	 */
+	void SendPayload( const TArray<uint8>& Payload );
 
 	/**
 	 * Processes a RecompileShaders message.
@@ -173,6 +187,28 @@ protected:
 	 */
 	void ProcessSyncFile( FArchive& In, FArchive& Out );
 
+	/**
+	 * Processes a SyncFiles message, sending each of the requested files as its own payload before the reply.
+	 *
+	 * @param In -
+	 * @param Out -
+	 */
+	void ProcessSyncFiles( FArchive& In, FArchive& Out );
+
+	/**
+	 * Remembers a file the client requested during startup, so the next client can sync it along with all the other
+	 * startup files in a single request.
+	 *
+	 * @param Filename - The server version of the filename.
+	 */
+	void RecordStartupFile( const FString& Filename );
+
+	/**
+	 * Updates the startup files of this client's platform with the ones this client requested. Files earlier clients
+	 * requested are kept until they have not been requested by several clients in a row, or no longer exist.
+	 */
+	void SaveStartupFiles( );
+
 
 private:
 
@@ -206,6 +242,9 @@ private:
 	// Holds the client socket.
 	FSocket* Socket;
 
+	// Holds a critical section that is held while a message is sent or received on the socket.
+	FCriticalSection SocketCriticalSection;
+
 	// Holds the client connection thread.
 	FRunnableThread* Thread;
 
@@ -215,6 +254,18 @@ private:
 	// Holds the list of directories being watched.
 	TArray<FString> WatchedDirectories;
 
+	// Holds the file the startup files of clients of the connected platform are kept in.
+	FString StartupFilesFilename;
+
+	// Holds the files the client requested on its own during startup, in the order they were requested.
+	TArray<FString> StartupFiles;
+
+	// Holds the time the client asked for the file list, files it requests within StartupFilesRecordTime are startup files.
+	double ConnectTime;
+
+	// Holds a flag indicating that the startup files of this client have been saved.
+	bool bStartupFilesSaved;
+
 	// Holds a delegate to be invoked on every sync request.
 	FFileRequestDelegate FileRequestDelegate;
 
@@ -0,0 +1,388 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	NetworkFileTransferBenchmark.cpp: Time it takes a network platform file to
+	sync a startup set of files from a file server connection over loopback,
+	one file per request and batched.
+=============================================================================*/
+
+#include "NetworkFileSystemPrivatePCH.h"
+#include "AutomationTest.h"
+#include "NetworkMessage.h"
+#include "NetworkPlatformFile.h"
+
+
+/** Maximum number of bytes of engine files synced by the benchmark. */
+static const int64 NetworkFileBenchmarkMaxBytes = 64 * 1024 * 1024;
+
+/** Platform name the benchmark client connects with, it keeps the server's startup file list apart from real clients. */
+static const TCHAR* NetworkFileBenchmarkPlatformName = TEXT("NetworkFileBenchmark");
+
+
+/**
+ * Network platform file that syncs into a sandbox instead of replacing the engine's files. It connects to the file
+ * server without touching the command line, and skips the local cache validation done by InitializeAfterSetActive.
+ */
+class FNetworkFileBenchmarkClient
+	: public FNetworkPlatformFile
+{
+public:
+
+	/**
+	 * Connects to a file server on this machine.
+	 *
+	 * @param Inner The platform file the synced files are written to.
+	 * @param Port The port the server listens on.
+	 * @return true if the connection was made.
+	 */
+	bool Connect( IPlatformFile* Inner, int32 Port )
+	{
+		InnerPlatformFile = Inner;
+		FileServerPort = Port;
+
+		ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get();
+		TSharedRef<FInternetAddr> Addr = SocketSubsystem->CreateInternetAddr(0, FileServerPort);
+		bool bIsValid = false;
+		Addr->SetIp(TEXT("127.0.0.1"), bIsValid);
+
+		FileSocket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("FNetworkFileBenchmarkClient tcp"));
+		if (!bIsValid || FileSocket == NULL || !FileSocket->Connect(*Addr))
+		{
+			if (FileSocket != NULL)
+			{
+				SocketSubsystem->DestroySocket(FileSocket);
+				FileSocket = NULL;
+			}
+		}
+
+		bIsUsable = FileSocket != NULL;
+		return bIsUsable;
+	}
+
+	/**
+	 * Sends the server the file list request every client starts with.
+	 *
+	 * @param OutStartupFiles Receives the files earlier clients requested during startup.
+	 * @return false if the connection failed.
+	 */
+	bool GetFileList( TArray<FString>& OutStartupFiles )
+	{
+		FNetworkFileArchive Payload(NFS_Messages::GetFileList);
+		FillGetFileList(Payload, false);
+
+		FArrayReader Response;
+		if (!SendPayloadAndReceiveResponse(Payload, Response))
+		{
+			return false;
+		}
+
+		int32 ServerPackageVersion = 0;
+		int32 ServerPackageLicenseeVersion = 0;
+		ProcessServerInitialResponse(Response, ServerPackageVersion, ServerPackageLicenseeVersion);
+
+		TMap<FString, FDateTime> ServerCachedFiles;
+		Response << ServerCachedFiles;
+		Response << OutStartupFiles;
+
+		for (int32 Index = 0; Index < OutStartupFiles.Num(); Index++)
+		{
+			ConvertServerFilenameToClientFilename(OutStartupFiles[Index]);
+		}
+
+		return true;
+	}
+
+	/** Requests the files one at a time, the way they are synced when they are first opened. */
+	void SyncFilesOneAtATime( const TArray<FString>& Filenames )
+	{
+		for (int32 Index = 0; Index < Filenames.Num(); Index++)
+		{
+			EnsureFileIsLocal(Filenames[Index]);
+		}
+	}
+
+	/**
+	 * Requests the files in one batch, the way out of date and startup files are synced after connecting.
+	 *
+	 * @param Filenames The files to sync.
+	 * @param bValidateSyncedFiles Whether to request files that were synced before again, sending the hashes of the local copies.
+	 */
+	void SyncFilesBatched( const TArray<FString>& Filenames, bool bValidateSyncedFiles )
+	{
+		if (bValidateSyncedFiles)
+		{
+			CachedLocalFiles.Empty();
+		}
+
+		SyncFiles(Filenames);
+	}
+
+protected:
+
+	// Begin FNetworkPlatformFile overrides
+
+	virtual void FillGetFileList( FNetworkFileArchive& Payload, bool bInStreamingFileRequest ) OVERRIDE
+	{
+		TArray<FString> TargetPlatformNames;
+		TargetPlatformNames.Add(NetworkFileBenchmarkPlatformName);
+		FString GameName = FApp::GetGameName();
+		if (FPaths::IsProjectFilePathSet())
+		{
+			GameName = FPaths::GetProjectFilePath();
+		}
+
+		FString EngineRelPath = FPaths::EngineDir();
+		FString GameRelPath = FPaths::GameDir();
+		TArray<FString> Directories;
+		Directories.Add(EngineRelPath);
+		Directories.Add(GameRelPath);
+
+		Payload << TargetPlatformNames;
+		Payload << GameName;
+		Payload << EngineRelPath;
+		Payload << GameRelPath;
+		Payload << Directories;
+		Payload << bInStreamingFileRequest;
+	}
+
+	// End FNetworkPlatformFile overrides
+};
+
+
+/**
+ * A benchmark client, the sandbox it syncs into and the server's connection to it.
+ */
+class FNetworkFileBenchmarkSession
+{
+public:
+
+	/**
+	 * Connects a new client to a new server connection. The client's sandbox starts out empty.
+	 *
+	 * @param ListenSocket The socket the server connection is accepted on.
+	 * @param SandboxDirectory The directory the client syncs into.
+	 */
+	FNetworkFileBenchmarkSession( FSocket* ListenSocket, const FString& SandboxDirectory )
+		: Client(new FNetworkFileBenchmarkClient)
+		, Connection(NULL)
+	{
+		IFileManager::Get().DeleteDirectory(*SandboxDirectory, false, true);
+
+		// the engine's copies of the synced files must not show through
+		Sandbox.Initialize(&FPlatformFileManager::Get().GetPlatformFile(), *FString::Printf(TEXT("-sandbox=\"%s\""), *SandboxDirectory));
+		Sandbox.AddExclusion(TEXT("*/Engine/Config/*"));
+		Sandbox.AddExclusion(TEXT("*/Engine/Shaders/*"));
+
+		if (Client->Connect(&Sandbox, ListenSocket->GetPortNo()))
+		{
+			FSocket* ServerSocket = ListenSocket->Accept(TEXT("FNetworkFileBenchmarkSession server"));
+			if (ServerSocket != NULL)
+			{
+				Connection = new FNetworkFileServerClientConnection(ServerSocket, FFileRequestDelegate(), FRecompileShadersDelegate());
+			}
+		}
+	}
+
+	/** Disconnects the client, the server connection saves the files it requested during startup. */
+	~FNetworkFileBenchmarkSession( )
+	{
+		// the server connection stops once its socket is closed by the client
+		delete Client;
+		delete Connection;
+	}
+
+	/** @return true if the client is connected to the server. */
+	bool IsConnected( ) const
+	{
+		return Connection != NULL;
+	}
+
+	/** @return true if the client's copy of the file has the same contents as the engine's. */
+	bool FileMatches( const FString& Filename )
+	{
+		TArray<uint8> Contents;
+		if (!FFileHelper::LoadFileToArray(Contents, *Filename))
+		{
+			return false;
+		}
+
+		TAutoPtr<IFileHandle> FileHandle(Sandbox.OpenRead(*Filename));
+		if (!FileHandle.IsValid() || FileHandle->Size() != Contents.Num())
+		{
+			return false;
+		}
+
+		TArray<uint8> SyncedContents;
+		SyncedContents.AddUninitialized(Contents.Num());
+
+		return FileHandle->Read(SyncedContents.GetTypedData(), SyncedContents.Num()) && (SyncedContents == Contents);
+	}
+
+	FNetworkFileBenchmarkClient* Client;
+
+private:
+
+	FSandboxPlatformFile Sandbox;
+	FNetworkFileServerClientConnection* Connection;
+};
+
+
+/** @return the number of files that were not synced correctly. */
+static int32 CountBadBenchmarkFiles( FNetworkFileBenchmarkSession& Session, const TArray<FString>& Filenames )
+{
+	int32 NumBadFiles = 0;
+	for (int32 Index = 0; Index < Filenames.Num(); Index++)
+	{
+		if (!Session.FileMatches(Filenames[Index]))
+		{
+			NumBadFiles++;
+		}
+	}
+	return NumBadFiles;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNetworkFileTransferBenchmark, "Network File.Transfer Benchmark", EAutomationTestFlags::ATF_Editor | EAutomationTestFlags::ATF_Commandlet)
+
+/**
+ * Syncs engine config and shader files, the files a client needs before its first frame, from a file server connection
+ * over loopback. A new client gets them one at a time as it opens them, which makes the server record them as startup
+ * files. The next new client gets the recorded startup files in one batch, and syncs them again with the hashes of the
+ * copies it already has.
+ */
+bool FNetworkFileTransferBenchmark::RunTest( const FString& Parameters )
+{
+	TArray<FString> FoundFilenames;
+	IFileManager::Get().FindFilesRecursive(FoundFilenames, *(FPaths::EngineDir() / TEXT("Config")), TEXT("*.ini"), true, false, false);
+	IFileManager::Get().FindFilesRecursive(FoundFilenames, *(FPaths::EngineDir() / TEXT("Shaders")), TEXT("*.usf"), true, false, false);
+
+	TArray<FString> Filenames;
+	int64 NumBytes = 0;
+
+	for (int32 Index = 0; Index < FoundFilenames.Num() && NumBytes < NetworkFileBenchmarkMaxBytes; Index++)
+	{
+		const int64 FileSize = IFileManager::Get().FileSize(*FoundFilenames[Index]);
+		if (FileSize > 0)
+		{
+			Filenames.Add(FoundFilenames[Index]);
+			NumBytes += FileSize;
+		}
+	}
+
+	if (Filenames.Num() == 0)
+	{
+		AddError(TEXT("No engine files to sync"));
+		return false;
+	}
+
+	// the server keeps the startup files of the benchmark platform next to the sandboxes
+	FString SandboxesDirectory = FPaths::GameSavedDir() / TEXT("Sandboxes");
+	if (FPaths::IsProjectFilePathSet())
+	{
+		SandboxesDirectory = FPaths::GetPath(FPaths::GetProjectFilePath()) / TEXT("Saved/Sandboxes");
+	}
+	const FString StartupFilesFilename = SandboxesDirectory / FString::Printf(TEXT("StartupFiles-%s.txt"), NetworkFileBenchmarkPlatformName);
+	const FString ClientSandboxDirectory = FPaths::GameSavedDir() / TEXT("Sandboxes") / NetworkFileBenchmarkPlatformName;
+
+	IFileManager::Get().Delete(*StartupFilesFilename);
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get();
+	TSharedRef<FInternetAddr> Addr = SocketSubsystem->CreateInternetAddr(0, 0);
+	bool bIsValid = false;
+	Addr->SetIp(TEXT("127.0.0.1"), bIsValid);
+
+	FSocket* ListenSocket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("FNetworkFileTransferBenchmark listen"));
+	if (!bIsValid || ListenSocket == NULL || !ListenSocket->Bind(*Addr) || !ListenSocket->Listen(1))
+	{
+		AddError(TEXT("Could not listen on a loopback socket"));
+		if (ListenSocket != NULL)
+		{
+			SocketSubsystem->DestroySocket(ListenSocket);
+		}
+		return false;
+	}
+
+	double OneAtATimeTime = 0.0;
+	double BatchedTime = 0.0;
+	double CachedTime = 0.0;
+	int32 NumBadFiles = 0;
+	int32 NumStartupFiles = 0;
+	bool bConnected = false;
+
+	// a new client without a startup file list on the server
+	{
+		FNetworkFileBenchmarkSession Session(ListenSocket, ClientSandboxDirectory);
+		TArray<FString> StartupFiles;
+
+		bConnected = Session.IsConnected() && Session.Client->GetFileList(StartupFiles);
+		if (bConnected)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Session.Client->SyncFilesOneAtATime(Filenames);
+			OneAtATimeTime = FPlatformTime::Seconds() - StartTime;
+
+			NumBadFiles += CountBadBenchmarkFiles(Session, Filenames);
+		}
+	}
+
+	// a new client that gets the startup files the first one requested
+	if (bConnected)
+	{
+		FNetworkFileBenchmarkSession Session(ListenSocket, ClientSandboxDirectory);
+		TArray<FString> StartupFiles;
+
+		bConnected = Session.IsConnected() && Session.Client->GetFileList(StartupFiles);
+		if (bConnected)
+		{
+			for (int32 Index = 0; Index < Filenames.Num(); Index++)
+			{
+				if (StartupFiles.Contains(Filenames[Index]))
+				{
+					NumStartupFiles++;
+				}
+			}
+
+			double StartTime = FPlatformTime::Seconds();
+			Session.Client->SyncFilesBatched(StartupFiles, false);
+			BatchedTime = FPlatformTime::Seconds() - StartTime;
+
+			NumBadFiles += CountBadBenchmarkFiles(Session, Filenames);
+
+			StartTime = FPlatformTime::Seconds();
+			Session.Client->SyncFilesBatched(StartupFiles, true);
+			CachedTime = FPlatformTime::Seconds() - StartTime;
+
+			NumBadFiles += CountBadBenchmarkFiles(Session, Filenames);
+		}
+	}
+
+	SocketSubsystem->DestroySocket(ListenSocket);
+
+	IFileManager::Get().Delete(*StartupFilesFilename);
+	IFileManager::Get().DeleteDirectory(*ClientSandboxDirectory, false, true);
+
+	if (!bConnected)
+	{
+		AddError(TEXT("Loopback connection to the file server failed"));
+		return false;
+	}
+
+	if (NumBadFiles > 0)
+	{
+		AddError(FString::Printf(TEXT("%d synced files did not match the engine's"), NumBadFiles));
+	}
+
+	if (NumStartupFiles != Filenames.Num())
+	{
+		AddError(FString::Printf(TEXT("Only %d of %d files were recorded as startup files"), NumStartupFiles, Filenames.Num()));
+	}
+
+	const double Megabytes = NumBytes / (1024.0 * 1024.0);
+
+	AddLogItem(FString::Printf(TEXT("%d files, %.2f MB"), Filenames.Num(), Megabytes));
+	AddLogItem(FString::Printf(TEXT("                  %12s %12s %12s"), TEXT("OneAtATime"), TEXT("Batched"), TEXT("Cached")));
+	AddLogItem(FString::Printf(TEXT("first frame ms    %12.1f %12.1f %12.1f"), OneAtATimeTime * 1000.0, BatchedTime * 1000.0, CachedTime * 1000.0));
+	AddLogItem(FString::Printf(TEXT("MB/s              %12.1f %12.1f %12.1f"), Megabytes / OneAtATimeTime, Megabytes / BatchedTime, Megabytes / CachedTime));
+
+	return NumBadFiles == 0 && NumStartupFiles == Filenames.Num();
+}
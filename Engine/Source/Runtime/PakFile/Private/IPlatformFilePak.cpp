@@ -17,6 +17,7 @@ FPakFile::FPakFile(const TCHAR* Filename, bool bIsSigned)
 	: PakFilename(Filename)
 	, bSigned(bIsSigned)
 	, bIsValid(false)
+	, bHasPathHashIndex(false)
 {
 	FArchive* Reader = GetSharedReader(NULL);
 	if (Reader)
@@ -30,6 +31,7 @@ FPakFile::FPakFile(IPlatformFile* LowerLevel, const TCHAR* Filename, bool bIsSig
 	: PakFilename(Filename)
 	, bSigned(bIsSigned)
 	, bIsValid(false)
+	, bHasPathHashIndex(false)
 {
 	FArchive* Reader = GetSharedReader(LowerLevel);
 	if (Reader)
@@ -119,6 +121,20 @@ void FPakFile::LoadIndex(FArchive* Reader)
 		IndexReader << NumEntries;
 
 		MakeDirectoryFromPath(MountPoint);
+
+		if (Info.Version >= FPakInfo::PakFile_Version_PathHashIndex)
+		{
+			// Entries are stored without filenames, paths only exist in the path hash index.
+			Files.SetNum(NumEntries);
+			for (int32 EntryIndex = 0; EntryIndex < NumEntries; EntryIndex++)
+			{
+				Files[EntryIndex].Serialize(IndexReader, Info.Version);
+			}
+			PathHashIndex.Serialize(IndexReader);
+			bHasPathHashIndex = true;
+			return;
+		}
+
 		// Allocate enough memory to hold all entries (and not reallocate while they're being added to it).
 		Files.Empty(NumEntries);
 
@@ -172,6 +188,165 @@ void FPakFile::LoadIndex(FArchive* Reader)
 	}
 }
 
+SIZE_T FPakFile::GetIndexAllocatedSize() const
+{
+	SIZE_T Size = Files.GetAllocatedSize() + PathHashIndex.GetAllocatedSize() + Index.GetAllocatedSize();
+	for (int32 EntryIndex = 0; EntryIndex < Files.Num(); EntryIndex++)
+	{
+		Size += Files[EntryIndex].CompressionBlocks.GetAllocatedSize();
+	}
+	for (TMap<FString, FPakDirectory>::TConstIterator It(Index); It; ++It)
+	{
+		Size += It.Key().GetAllocatedSize() + It.Value().GetAllocatedSize();
+		for (FPakDirectory::TConstIterator DirectoryIt(It.Value()); DirectoryIt; ++DirectoryIt)
+		{
+			Size += DirectoryIt.Key().GetAllocatedSize();
+		}
+	}
+	return Size;
+}
+
+void FPakPathHashIndex::Build(const TArray<FString>& RelativeFilenames)
+{
+	StringPool.Empty();
+	FileNameOffsets.Empty(RelativeFilenames.Num());
+	Directories.Empty();
+	DirectoryFiles.Empty(RelativeFilenames.Num());
+
+	// Collect all directories, including the parent directories of directories that contain files.
+	// The mount point itself is always a directory, even if no files are directly in it.
+	TMap<FString, TArray<int32>> DirectoryMap;
+	DirectoryMap.Add(FString(), TArray<int32>());
+	for (int32 FileIndex = 0; FileIndex < RelativeFilenames.Num(); FileIndex++)
+	{
+		FString Path = FPaths::GetPath(RelativeFilenames[FileIndex]);
+		FPakFile::MakeDirectoryFromPath(Path);
+		DirectoryMap.FindOrAdd(Path).Add(FileIndex);
+
+		int32 Offset = 0;
+		while (Path.Len() > 1 && Path.LeftChop(1).FindLastChar('/', Offset))
+		{
+			Path = Path.Left(Offset + 1);
+			DirectoryMap.FindOrAdd(Path);
+		}
+	}
+	DirectoryMap.KeySort(TLess<FString>());
+
+	// Store all filenames in entry order.
+	for (int32 FileIndex = 0; FileIndex < RelativeFilenames.Num(); FileIndex++)
+	{
+		const FString& Filename = RelativeFilenames[FileIndex];
+		FileNameOffsets.Add(StringPool.Num());
+		for (int32 CharIndex = 0; CharIndex < Filename.Len(); CharIndex++)
+		{
+			StringPool.Add((uint16)Filename[CharIndex]);
+		}
+		StringPool.Add(0);
+	}
+
+	// Store directories with the list of files they contain.
+	TArray<int32> DirectoryNameOffsets;
+	for (TMap<FString, TArray<int32>>::TConstIterator It(DirectoryMap); It; ++It)
+	{
+		const FString& DirectoryName = It.Key();
+		FDirectory Directory;
+		Directory.NameOffset = StringPool.Num();
+		Directory.FirstFile = DirectoryFiles.Num();
+		Directory.NumFiles = It.Value().Num();
+		Directories.Add(Directory);
+		DirectoryNameOffsets.Add(Directory.NameOffset);
+		DirectoryFiles.Append(It.Value());
+
+		for (int32 CharIndex = 0; CharIndex < DirectoryName.Len(); CharIndex++)
+		{
+			StringPool.Add((uint16)DirectoryName[CharIndex]);
+		}
+		StringPool.Add(0);
+	}
+
+	BuildTable(FileTable, FileNameOffsets);
+	BuildTable(DirectoryTable, DirectoryNameOffsets);
+}
+
+void FPakPathHashIndex::BuildTable(FHashTable& Table, const TArray<int32>& NameOffsets)
+{
+	// Keep the load factor at or below 50% so probe sequences stay short.
+	const int32 NumSlots = FMath::RoundUpToPowerOfTwo(FMath::Max(NameOffsets.Num() * 2, 1));
+	const uint32 SlotMask = NumSlots - 1;
+	Table.Hashes.Init(0, NumSlots);
+	Table.Values.Init(INDEX_NONE, NumSlots);
+
+	for (int32 NameIndex = 0; NameIndex < NameOffsets.Num(); NameIndex++)
+	{
+		const uint64 Hash = HashPath(*GetString(NameOffsets[NameIndex]));
+		uint32 Slot = (uint32)Hash & SlotMask;
+		while (Table.Values[Slot] != INDEX_NONE)
+		{
+			Slot = (Slot + 1) & SlotMask;
+		}
+		Table.Hashes[Slot] = Hash;
+		Table.Values[Slot] = NameIndex;
+	}
+}
+
+void FPakPathHashIndex::Serialize(FArchive& Ar)
+{
+	Ar << StringPool;
+	Ar << FileNameOffsets;
+	Ar << Directories;
+	Ar << DirectoryFiles;
+	Ar << FileTable;
+	Ar << DirectoryTable;
+}
+
+FString FPakPathHashIndex::GetString(int32 Offset) const
+{
+	const uint16* Chars = StringPool.GetData() + Offset;
+	int32 Len = 0;
+	while (Chars[Len])
+	{
+		Len++;
+	}
+	FString Result;
+	Result.Reserve(Len);
+	for (int32 CharIndex = 0; CharIndex < Len; CharIndex++)
+	{
+		Result.AppendChar((TCHAR)Chars[CharIndex]);
+	}
+	return Result;
+}
+
+int32 FPakPathHashIndex::FindInTable(const FHashTable& Table, const TCHAR* Path, bool bDirectories) const
+{
+	if (Table.Values.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const uint64 Hash = HashPath(Path);
+	const uint32 SlotMask = Table.Values.Num() - 1;
+	for (uint32 Slot = (uint32)Hash & SlotMask; Table.Values[Slot] != INDEX_NONE; Slot = (Slot + 1) & SlotMask)
+	{
+		if (Table.Hashes[Slot] == Hash)
+		{
+			// Compare the stored name to rule out hash collisions.
+			const int32 Value = Table.Values[Slot];
+			const uint16* Name = StringPool.GetData() + (bDirectories ? Directories[Value].NameOffset : FileNameOffsets[Value]);
+			const TCHAR* Query = Path;
+			while (*Name && (uint16)FChar::ToLower(*Query) == (uint16)FChar::ToLower((TCHAR)*Name))
+			{
+				++Name;
+				++Query;
+			}
+			if (*Name == 0 && *Query == 0)
+			{
+				return Value;
+			}
+		}
+	}
+	return INDEX_NONE;
+}
+
 FArchive* FPakFile::GetSharedReader(IPlatformFile* LowerLevel)
 {
 	uint32 Thread = FPlatformTLS::GetCurrentThreadId();
@@ -211,6 +386,76 @@ FArchive* FPakFile::GetSharedReader(IPlatformFile* LowerLevel)
 	return PakReader;
 }
 
+const FPakFileHandle::FCachedBlock* FPakFileHandle::GetDecompressedBlock(int32 BlockIndex)
+{
+	// Check if the block has been decompressed recently and find the least recently used slot at the same time.
+	FCachedBlock* LeastRecentlyUsed = &BlockCache[0];
+	for (int32 CacheIndex = 0; CacheIndex < MaxCachedBlocks; CacheIndex++)
+	{
+		FCachedBlock& CachedBlock = BlockCache[CacheIndex];
+		if (CachedBlock.BlockIndex == BlockIndex)
+		{
+			CachedBlock.LastUsed = ++BlockCacheClock;
+			return &CachedBlock;
+		}
+		if (CachedBlock.BlockIndex == INDEX_NONE || CachedBlock.LastUsed < LeastRecentlyUsed->LastUsed)
+		{
+			LeastRecentlyUsed = &CachedBlock;
+		}
+	}
+
+	const FPakCompressedBlock& Block = PakEntry.CompressionBlocks[BlockIndex];
+	const int32 CompressedSize = (int32)(Block.CompressedEnd - Block.CompressedStart);
+	const int64 BlockStart = (int64)BlockIndex * PakEntry.CompressionBlockSize;
+	const int32 UncompressedBlockSize = (int32)FMath::Min<int64>(PakEntry.CompressionBlockSize, PakEntry.UncompressedSize - BlockStart);
+
+	CompressedBuffer.Reset();
+	CompressedBuffer.AddUninitialized(CompressedSize);
+	PakReader->Seek(OffsetToFile + Block.CompressedStart);
+	PakReader->Serialize(CompressedBuffer.GetData(), CompressedSize);
+	BytesReadFromPak += CompressedSize;
+
+	FCachedBlock& NewBlock = *LeastRecentlyUsed;
+	NewBlock.Data.Reset();
+	NewBlock.Data.AddUninitialized(UncompressedBlockSize);
+	if (!FCompression::UncompressMemory((ECompressionFlags)PakEntry.CompressionMethod, NewBlock.Data.GetData(), UncompressedBlockSize, CompressedBuffer.GetData(), CompressedSize))
+	{
+		UE_LOG(LogPakFile, Error, TEXT("Failed to decompress block %d of a pak entry (%d compressed bytes)."), BlockIndex, CompressedSize);
+		NewBlock.BlockIndex = INDEX_NONE;
+		return NULL;
+	}
+	NewBlock.BlockIndex = BlockIndex;
+	NewBlock.LastUsed = ++BlockCacheClock;
+	return &NewBlock;
+}
+
+bool FPakFileHandle::ReadCompressed(uint8* Destination, int64 BytesToRead)
+{
+	if (PakEntry.UncompressedSize < (ReadPos + BytesToRead))
+	{
+		return false;
+	}
+
+	const int64 BlockSize = PakEntry.CompressionBlockSize;
+	while (BytesToRead > 0)
+	{
+		const int32 BlockIndex = (int32)(ReadPos / BlockSize);
+		const int64 OffsetInBlock = ReadPos - BlockIndex * BlockSize;
+		const FCachedBlock* Block = GetDecompressedBlock(BlockIndex);
+		if (Block == NULL)
+		{
+			return false;
+		}
+
+		const int64 SizeToCopy = FMath::Min<int64>(Block->Data.Num() - OffsetInBlock, BytesToRead);
+		FMemory::Memcpy(Destination, Block->Data.GetData() + OffsetInBlock, SizeToCopy);
+		Destination += SizeToCopy;
+		BytesToRead -= SizeToCopy;
+		ReadPos += SizeToCopy;
+	}
+	return true;
+}
+
 #if !UE_BUILD_SHIPPING
 class FPakExec : private FSelfRegisteringExec
 {
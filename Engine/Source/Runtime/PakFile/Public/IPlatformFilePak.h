@@ -22,8 +22,10 @@ struct FPakInfo
 	{
 		PakFile_Version_Initial = 1,
 		PakFile_Version_NoTimestamps = 2,
+		PakFile_Version_CompressionBlocks = 3,
+		PakFile_Version_PathHashIndex = 4,
 
-		PakFile_Version_Latest = PakFile_Version_NoTimestamps
+		PakFile_Version_Latest = PakFile_Version_PathHashIndex
 	};
 
 	/** Pak file magic value. */
@@ -80,6 +82,34 @@ struct FPakInfo
 	}
 };
 
+/**
+ * Struct storing offsets and sizes of a compressed block.
+ */
+struct FPakCompressedBlock
+{
+	/** Offset of the start of a compression block. Offset is relative to the start of the file data (after the file header). */
+	int64 CompressedStart;
+	/** Offset of the end of a compression block. This may not align completely with the start of the next block. */
+	int64 CompressedEnd;
+
+	bool operator == (const FPakCompressedBlock& B) const
+	{
+		return CompressedStart == B.CompressedStart && CompressedEnd == B.CompressedEnd;
+	}
+
+	bool operator != (const FPakCompressedBlock& B) const
+	{
+		return !(*this == B);
+	}
+
+	friend FArchive& operator << (FArchive& Ar, FPakCompressedBlock& Block)
+	{
+		Ar << Block.CompressedStart;
+		Ar << Block.CompressedEnd;
+		return Ar;
+	}
+};
+
 /**
  * Struct holding info about a single file stored in pak file.
  */
@@ -93,8 +123,12 @@ struct FPakEntry
 	int64 UncompressedSize;
 	/** Compression method. */
 	int32 CompressionMethod;
-	/** File SHA1 value. */
+	/** File SHA1 value (of the serialized, possibly compressed, data). */
 	uint8 Hash[20];
+	/** Array of compression blocks that describe how to decompress this pak entry. */
+	TArray<FPakCompressedBlock> CompressionBlocks;
+	/** Size of a single uncompressed block. */
+	uint32 CompressionBlockSize;
 
 	/**
 	 * Constructor.
@@ -103,11 +137,22 @@ struct FPakEntry
 		: Offset(-1)
 		, Size(0)
 		, UncompressedSize(0)
-		, CompressionMethod(0)
+		, CompressionMethod(COMPRESS_None)
+		, CompressionBlockSize(0)
 	{
 		FMemory::Memset(Hash, 0, sizeof(Hash));
 	}
 
+	/**
+	 * Checks if this entry is stored compressed.
+	 *
+	 * @return true if the file data is split into compressed blocks.
+	 */
+	bool IsCompressed() const
+	{
+		return CompressionMethod != COMPRESS_None;
+	}
+
 	/**
 	 * Gets the size of data serialized by this struct.
 	 *
@@ -121,6 +166,11 @@ struct FPakEntry
 			// Timestamp
 			SerializedSize += sizeof(int64);
 		}
+		if (Version >= FPakInfo::PakFile_Version_CompressionBlocks && CompressionMethod != COMPRESS_None)
+		{
+			// Block table and block size
+			SerializedSize += sizeof(int32) + sizeof(FPakCompressedBlock) * CompressionBlocks.Num() + sizeof(CompressionBlockSize);
+		}
 		return SerializedSize;
 	}
 
@@ -134,6 +184,8 @@ struct FPakEntry
 		return Size == B.Size && 
 			UncompressedSize == B.UncompressedSize &&
 			CompressionMethod == B.CompressionMethod &&
+			CompressionBlockSize == B.CompressionBlockSize &&
+			CompressionBlocks == B.CompressionBlocks &&
 			FMemory::Memcmp(Hash, B.Hash, sizeof(Hash)) == 0;
 	}
 
@@ -147,6 +199,8 @@ struct FPakEntry
 		return Size != B.Size || 
 			UncompressedSize != B.UncompressedSize ||
 			CompressionMethod != B.CompressionMethod ||
+			CompressionBlockSize != B.CompressionBlockSize ||
+			CompressionBlocks != B.CompressionBlocks ||
 			FMemory::Memcmp(Hash, B.Hash, sizeof(Hash)) != 0;
 	}
 
@@ -168,9 +222,153 @@ struct FPakEntry
 			Ar << Timestamp;
 		}
 		Ar.Serialize(Hash, sizeof(Hash));
+		if (Version >= FPakInfo::PakFile_Version_CompressionBlocks && CompressionMethod != COMPRESS_None)
+		{
+			Ar << CompressionBlocks;
+			Ar << CompressionBlockSize;
+		}
 	}
 };
 
+/**
+ * Flat pak index. All paths (relative to the mount point) are stored in a single string pool and
+ * files and directories are resolved with a precomputed path hash table, so loading the index
+ * requires no per-entry allocations and a lookup doesn't need to split or copy the path.
+ */
+struct PAKFILE_API FPakPathHashIndex
+{
+	/** Directory stored in the index. */
+	struct FDirectory
+	{
+		/** Offset of the directory name (relative to the mount point, ends with '/') in the string pool. */
+		int32 NameOffset;
+		/** Index of the first file of this directory in DirectoryFiles. */
+		int32 FirstFile;
+		/** Number of files directly in this directory. */
+		int32 NumFiles;
+
+		friend FArchive& operator << (FArchive& Ar, FDirectory& Directory)
+		{
+			Ar << Directory.NameOffset;
+			Ar << Directory.FirstFile;
+			Ar << Directory.NumFiles;
+			return Ar;
+		}
+	};
+
+	/** Open addressing hash table mapping path hashes to file or directory indices. */
+	struct FHashTable
+	{
+		/** Path hash of each slot. */
+		TArray<uint64> Hashes;
+		/** File or directory index of each slot, INDEX_NONE for empty slots. */
+		TArray<int32> Values;
+
+		friend FArchive& operator << (FArchive& Ar, FHashTable& Table)
+		{
+			Ar << Table.Hashes;
+			Ar << Table.Values;
+			return Ar;
+		}
+	};
+
+	/** Zero terminated file and directory names. */
+	TArray<uint16> StringPool;
+	/** Offset of each file name in the string pool, in pak entry order. */
+	TArray<int32> FileNameOffsets;
+	/** All directories, including parent directories that contain no files. */
+	TArray<FDirectory> Directories;
+	/** Pak entry indices grouped by directory. */
+	TArray<int32> DirectoryFiles;
+	/** Filename hash to pak entry index. */
+	FHashTable FileTable;
+	/** Directory name hash to index in Directories. */
+	FHashTable DirectoryTable;
+
+	/**
+	 * Builds the index.
+	 *
+	 * @param RelativeFilenames Filenames relative to the mount point, in pak entry order.
+	 */
+	void Build(const TArray<FString>& RelativeFilenames);
+
+	/**
+	 * Serializes the index.
+	 *
+	 * @param Ar Archive to serialize data with.
+	 */
+	void Serialize(FArchive& Ar);
+
+	/**
+	 * Finds a file.
+	 *
+	 * @param RelativeFilename Filename relative to the mount point.
+	 * @return Pak entry index or INDEX_NONE if the file is not in the index.
+	 */
+	int32 FindFile(const TCHAR* RelativeFilename) const
+	{
+		return FindInTable(FileTable, RelativeFilename, false);
+	}
+
+	/**
+	 * Finds a directory.
+	 *
+	 * @param RelativePath Directory relative to the mount point, ending with '/'.
+	 * @return Index in Directories or INDEX_NONE if the directory is not in the index.
+	 */
+	int32 FindDirectory(const TCHAR* RelativePath) const
+	{
+		return FindInTable(DirectoryTable, RelativePath, true);
+	}
+
+	/** Gets the name of a file relative to the mount point. */
+	FString GetFilename(int32 FileIndex) const
+	{
+		return GetString(FileNameOffsets[FileIndex]);
+	}
+
+	/** Gets the name of a directory relative to the mount point. */
+	FString GetDirectoryName(int32 DirectoryIndex) const
+	{
+		return GetString(Directories[DirectoryIndex].NameOffset);
+	}
+
+	/** Gets the amount of memory allocated by this index. */
+	SIZE_T GetAllocatedSize() const
+	{
+		return StringPool.GetAllocatedSize() + FileNameOffsets.GetAllocatedSize() + Directories.GetAllocatedSize() + DirectoryFiles.GetAllocatedSize() +
+			FileTable.Hashes.GetAllocatedSize() + FileTable.Values.GetAllocatedSize() + DirectoryTable.Hashes.GetAllocatedSize() + DirectoryTable.Values.GetAllocatedSize();
+	}
+
+	/**
+	 * Computes the case insensitive hash of a path.
+	 *
+	 * @param Path Path to hash.
+	 * @return 64 bit path hash.
+	 */
+	static uint64 HashPath(const TCHAR* Path)
+	{
+		// FNV-1a
+		uint64 Hash = 0xcbf29ce484222325ULL;
+		for (; *Path; ++Path)
+		{
+			Hash = (Hash ^ (uint16)FChar::ToLower(*Path)) * 0x100000001b3ULL;
+		}
+		return Hash;
+	}
+
+private:
+
+	/** Converts a string from the string pool. */
+	FString GetString(int32 Offset) const;
+
+	/** Looks up a path in one of the hash tables and compares the stored name to rule out hash collisions. */
+	int32 FindInTable(const FHashTable& Table, const TCHAR* Path, bool bDirectories) const;
+
+	/** Builds a hash table over the given name offsets. */
+	void BuildTable(FHashTable& Table, const TArray<int32>& NameOffsets);
+};
+
 /** Pak directory type. */
 typedef TMap<FString, FPakEntry*> FPakDirectory;
 
@@ -193,14 +391,18 @@ class PAKFILE_API FPakFile
 	FString MountPoint;
 	/** Info on all files stored in pak. */
 	TArray<FPakEntry> Files;	
-	/** Pak Index organized as a map of directories for faster Directory iteration. */
+	/** Pak Index organized as a map of directories for faster Directory iteration. Empty if the pak uses a path hash index. */
 	TMap<FString, FPakDirectory> Index;
+	/** Flat path hash index, used instead of Index by paks with PakFile_Version_PathHashIndex or newer. */
+	FPakPathHashIndex PathHashIndex;
 	/** Timestamp of this pak file. */
 	FDateTime Timestamp;	
 	/** True if this is a signed pak file. */
 	bool bSigned;
 	/** True if this pak file is valid and usable */
 	bool bIsValid;
+	/** True if this pak file's index is stored in PathHashIndex. */
+	bool bHasPathHashIndex;
 
 	FArchive* CreatePakReader(const TCHAR* Filename);
 	FArchive* CreatePakReader(IFileHandle& InHandle, const TCHAR* Filename);
@@ -257,6 +459,33 @@ public:
 		return Index;
 	}
 
+	/**
+	 * Checks if this pak file uses the flat path hash index instead of the directory map.
+	 *
+	 * @return true if the index is stored in GetPathHashIndex().
+	 */
+	bool HasPathHashIndex() const
+	{
+		return bHasPathHashIndex;
+	}
+
+	/**
+	 * Gets the flat path hash index.
+	 *
+	 * @return Path hash index (empty unless HasPathHashIndex() returns true).
+	 */
+	const FPakPathHashIndex& GetPathHashIndex() const
+	{
+		return PathHashIndex;
+	}
+
+	/**
+	 * Gets the amount of memory used by the pak file index.
+	 *
+	 * @return Allocated size in bytes.
+	 */
+	SIZE_T GetIndexAllocatedSize() const;
+
 	/**
 	 * Gets shared pak file archive for given thrad
 	 *
@@ -275,6 +504,11 @@ public:
 		const FPakEntry*const * FoundFile = NULL;
 		if (Filename.StartsWith(MountPoint))
 		{
+			if (bHasPathHashIndex)
+			{
+				const int32 FileIndex = PathHashIndex.FindFile(*Filename + MountPoint.Len());
+				return FileIndex != INDEX_NONE ? &Files[FileIndex] : NULL;
+			}
 			FString Path(FPaths::GetPath(Filename));
 			const FPakDirectory* PakDirectory = FindDirectory(*Path);
 			if (PakDirectory != NULL)
@@ -329,6 +563,12 @@ public:
 		if ((Directory.StartsWith(MountPoint)) || (MountPoint.StartsWith(Directory)))
 		{
 			TArray<FString> DirectoriesInPak; // List of all unique directories at path
+			if (bHasPathHashIndex)
+			{
+				FindFilesAtPathInPathHashIndex(OutFiles, DirectoriesInPak, Directory, bIncludeFiles, bIncludeDirectories, bRecursive);
+				OutFiles.Append(DirectoriesInPak);
+				return;
+			}
 			for (TMap<FString, FPakDirectory>::TConstIterator It(Index); It; ++It)
 			{
 				FString PakPath(MountPoint + It.Key());
@@ -377,7 +617,46 @@ public:
 	}
 
 	/**
-	 * Finds a directory in pak file.
+	 * Path hash index version of FindFilesAtPath.
+	 */
+	template <class ContainerType>
+	void FindFilesAtPathInPathHashIndex(ContainerType& OutFiles, TArray<FString>& OutDirectoriesInPak, const FString& Directory, bool bIncludeFiles, bool bIncludeDirectories, bool bRecursive) const
+	{
+		for (int32 DirectoryIndex = 0; DirectoryIndex < PathHashIndex.Directories.Num(); DirectoryIndex++)
+		{
+			const FPakPathHashIndex::FDirectory& PakDirectory = PathHashIndex.Directories[DirectoryIndex];
+			FString PakPath(MountPoint + PathHashIndex.GetDirectoryName(DirectoryIndex));
+			// Check if the file is under the specified path.
+			if (PakPath.StartsWith(Directory))
+			{
+				const int32 SubDirIndex = bRecursive || PakPath.Len() <= Directory.Len() ? INDEX_NONE : PakPath.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Directory.Len() + 1);
+				if (bIncludeFiles && (bRecursive || SubDirIndex == INDEX_NONE))
+				{
+					for (int32 FileIndex = PakDirectory.FirstFile; FileIndex < PakDirectory.FirstFile + PakDirectory.NumFiles; FileIndex++)
+					{
+						OutFiles.Add(MountPoint + PathHashIndex.GetFilename(PathHashIndex.DirectoryFiles[FileIndex]));
+					}
+				}
+				if (bIncludeDirectories)
+				{
+					if (bRecursive)
+					{
+						if (Directory != PakPath)
+						{
+							OutDirectoriesInPak.Add(PakPath);
+						}
+					}
+					else if (SubDirIndex >= 0)
+					{
+						OutDirectoriesInPak.AddUnique(PakPath.Left(SubDirIndex + 1));
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * Finds a directory in pak file. Always returns NULL for paks using a path hash index.
 	 *
 	 * @param InPath Directory path.
 	 * @return Pointer to a map with directory contents if the directory was found, NULL otherwise.
@@ -404,6 +683,12 @@ public:
 	 */
 	bool DirectoryExists(const TCHAR* InPath) const
 	{
+		if (bHasPathHashIndex)
+		{
+			FString Directory(InPath);
+			MakeDirectoryFromPath(Directory);
+			return Directory.StartsWith(MountPoint) && PathHashIndex.FindDirectory(*Directory + MountPoint.Len()) != INDEX_NONE;
+		}
 		return !!FindDirectory(InPath);
 	}
 
@@ -416,6 +701,15 @@ public:
 		TMap<FString, FPakDirectory>::TConstIterator IndexIt;
 		/** Directory iterator. */
 		FPakDirectory::TConstIterator DirectoryIt;
+		/** Current entry when iterating a path hash index. */
+		int32 FileIndex;
+
+		/** Empty directory used to initialize DirectoryIt when there's no directory to iterate. */
+		static const FPakDirectory& GetEmptyDirectory()
+		{
+			static const FPakDirectory EmptyDirectory;
+			return EmptyDirectory;
+		}
 
 	public:
 		/**
@@ -426,11 +720,17 @@ public:
 		FFileIterator(const FPakFile& InPakFile)
 		:	PakFile(InPakFile)
 		, IndexIt(PakFile.GetIndex())
-		, DirectoryIt(IndexIt.Value())
+		, DirectoryIt(IndexIt ? IndexIt.Value() : GetEmptyDirectory())
+		, FileIndex(0)
 		{}
 
 		FFileIterator& operator++()		
 		{ 
+			if (PakFile.HasPathHashIndex())
+			{
+				++FileIndex;
+				return *this;
+			}
 			// Continue with the next file
 			++DirectoryIt;
 			while (!DirectoryIt && IndexIt)
@@ -452,7 +752,7 @@ public:
 		/** conversion to "bool" returning true if the iterator is valid. */
 		FORCEINLINE_EXPLICIT_OPERATOR_BOOL() const
 		{ 
-			return !!IndexIt; 
+			return PakFile.HasPathHashIndex() ? FileIndex < PakFile.Files.Num() : !!IndexIt;
 		}
 		/** inverse of the "bool" operator */
 		FORCEINLINE bool operator !() const
@@ -460,8 +760,8 @@ public:
 			return !(bool)*this;
 		}
 
-		const FString& Filename() const		{ return DirectoryIt.Key(); }
-		const FPakEntry& Info() const	{ return *DirectoryIt.Value(); }
+		FString Filename() const		{ return PakFile.HasPathHashIndex() ? PakFile.GetPathHashIndex().GetFilename(FileIndex) : DirectoryIt.Key(); }
+		const FPakEntry& Info() const	{ return PakFile.HasPathHashIndex() ? PakFile.Files[FileIndex] : *DirectoryIt.Value(); }
 	};
 
 	/**
@@ -517,6 +817,25 @@ public:
  */
 class PAKFILE_API FPakFileHandle : public IFileHandle
 {	
+	/** Number of decompressed blocks each handle keeps around. */
+	enum { MaxCachedBlocks = 2 };
+
+	/** Decompressed block kept in the handle's block cache. */
+	struct FCachedBlock
+	{
+		/** Index of the block in the pak entry, INDEX_NONE if the slot is empty. */
+		int32 BlockIndex;
+		/** Value of BlockCacheClock when this block was last used. */
+		uint32 LastUsed;
+		/** Decompressed block data. */
+		TArray<uint8> Data;
+
+		FCachedBlock()
+			: BlockIndex(INDEX_NONE)
+			, LastUsed(0)
+		{}
+	};
+
 	/** Pak file entry for this file. */
 	const FPakEntry& PakEntry;
 	/** Pak file archive to read the data from. */
@@ -527,6 +846,31 @@ class PAKFILE_API FPakFileHandle : public IFileHandle
 	int64 OffsetToFile;
 	/** Current read position. */
 	int64 ReadPos;
+	/** Number of bytes this handle has read from the pak file. */
+	int64 BytesReadFromPak;
+	/** Recently decompressed blocks (compressed entries only). */
+	FCachedBlock BlockCache[MaxCachedBlocks];
+	/** Monotonic counter used to find the least recently used cached block. */
+	uint32 BlockCacheClock;
+	/** Scratch buffer for compressed block data. */
+	TArray<uint8> CompressedBuffer;
+
+	/**
+	 * Gets decompressed data for a block, decompressing it into the block cache if necessary.
+	 *
+	 * @param BlockIndex Index of the block in the pak entry.
+	 * @return Pointer to the cached block or NULL if the block could not be decompressed.
+	 */
+	const FCachedBlock* GetDecompressedBlock(int32 BlockIndex);
+
+	/**
+	 * Reads data from a compressed pak entry, decompressing only the blocks the read touches.
+	 *
+	 * @param Destination Buffer to read into.
+	 * @param BytesToRead Number of (uncompressed) bytes to read.
+	 * @return true if all requested bytes were read.
+	 */
+	bool ReadCompressed(uint8* Destination, int64 BytesToRead);
 
 public:
 
@@ -542,6 +886,8 @@ public:
 		, PakReader(InPakReader)
 		, bSharedReader(bIsSharedReader)
 		, ReadPos(0)
+		, BytesReadFromPak(0)
+		, BlockCacheClock(0)
 	{
 		OffsetToFile = PakEntry.Offset + PakEntry.GetSerializedSize(PakFile.GetInfo().Version);
 	}
@@ -557,6 +903,17 @@ public:
 		}
 	}
 
+	/**
+	 * Gets the number of bytes this handle has read from the pak file so far. For compressed
+	 * entries this is the amount of compressed data read, not the amount of data returned.
+	 *
+	 * @return Number of bytes read from the pak file.
+	 */
+	int64 GetBytesReadFromPak() const
+	{
+		return BytesReadFromPak;
+	}
+
 	// BEGIN IFileHandle Interface
 	virtual int64 Tell() OVERRIDE
 	{
@@ -564,7 +921,7 @@ public:
 	}
 	virtual bool Seek(int64 NewPosition) OVERRIDE
 	{
-		if (NewPosition > PakEntry.Size || NewPosition < 0)
+		if (NewPosition > PakEntry.UncompressedSize || NewPosition < 0)
 		{
 			return false;
 		}
@@ -573,16 +930,21 @@ public:
 	}
 	virtual bool SeekFromEnd(int64 NewPositionRelativeToEnd) OVERRIDE
 	{
-		return Seek(PakEntry.Size - NewPositionRelativeToEnd);
+		return Seek(PakEntry.UncompressedSize - NewPositionRelativeToEnd);
 	}
 	virtual bool Read(uint8* Destination, int64 BytesToRead) OVERRIDE
 	{
+		if (PakEntry.IsCompressed())
+		{
+			return ReadCompressed(Destination, BytesToRead);
+		}
 		PakReader->Seek(OffsetToFile + ReadPos);
 		if (PakEntry.Size >= (ReadPos + BytesToRead))
 		{
 			// Read directly from Pak.
 			PakReader->Serialize(Destination, BytesToRead);
 			ReadPos += BytesToRead;
+			BytesReadFromPak += BytesToRead;
 			return true;
 		}
 		else
@@ -597,7 +959,7 @@ public:
 	}
 	virtual int64 Size() OVERRIDE
 	{
-		return PakEntry.Size;
+		return PakEntry.UncompressedSize;
 	}
 	/// END IFileHandle Interface
 };
@@ -810,7 +1172,7 @@ public:
 		const FPakEntry* FileEntry = FindFileInPakFiles(Filename);
 		if (FileEntry != NULL)
 		{
-			return FileEntry->Size;
+			return FileEntry->UncompressedSize;
 		}
 		// First look for the file in the user dir.
 		int64 Result = LowerLevel->FileSize(Filename);
@@ -201,6 +201,7 @@ void FPrimitiveSceneInfo::AddToScene(bool bUpdateStaticDrawLists)
 	PrimitiveBounds.BoxExtent = BoxSphereBounds.BoxExtent;
 	PrimitiveBounds.MinDrawDistanceSq = FMath::Square(Proxy->GetMinDrawDistance());
 	PrimitiveBounds.MaxDrawDistance = Proxy->GetMaxDrawDistance();
+	Scene->PrimitiveCullingBounds.SetBounds(PackedIndex, PrimitiveBounds);
 
 	// Store precomputed visibility ID.
 	int32 VisibilityBitIndex = Proxy->GetVisibilityId();
@@ -91,6 +91,7 @@ SIZE_T FScene::GetSizeBytes() const
 void FScene::CheckPrimitiveArrays()
 {
 	check(Primitives.Num() == PrimitiveBounds.Num());
+	check(Primitives.Num() == PrimitiveCullingBounds.Num());
 	check(Primitives.Num() == PrimitiveVisibilityIds.Num());
 	check(Primitives.Num() == PrimitiveOcclusionFlags.Num());
 	check(Primitives.Num() == PrimitiveComponentIds.Num());
@@ -107,6 +108,7 @@ void FScene::AddPrimitiveSceneInfo_RenderThread(FPrimitiveSceneInfo* PrimitiveSc
 	PrimitiveSceneInfo->PackedIndex = PrimitiveIndex;
 
 	PrimitiveBounds.AddUninitialized();
+	PrimitiveCullingBounds.AddUninitialized();
 	PrimitiveVisibilityIds.AddUninitialized();
 	PrimitiveOcclusionFlags.AddUninitialized();
 	PrimitiveComponentIds.AddUninitialized();
@@ -477,6 +479,7 @@ void FScene::RemovePrimitiveSceneInfo_RenderThread(FPrimitiveSceneInfo* Primitiv
 	int32 PrimitiveIndex = PrimitiveSceneInfo->PackedIndex;
 	Primitives.RemoveAtSwap(PrimitiveIndex);
 	PrimitiveBounds.RemoveAtSwap(PrimitiveIndex);
+	PrimitiveCullingBounds.RemoveAtSwap(PrimitiveIndex);
 	PrimitiveVisibilityIds.RemoveAtSwap(PrimitiveIndex);
 	PrimitiveOcclusionFlags.RemoveAtSwap(PrimitiveIndex);
 	PrimitiveComponentIds.RemoveAtSwap(PrimitiveIndex);
@@ -1859,6 +1862,7 @@ void FScene::ApplyWorldOffset_RenderThread(FVector InOffset)
 	{
 		(*It).Origin+= InOffset;
 	}
+	PrimitiveCullingBounds.ApplyOffset(InOffset);
 
 	// Primitive occlusion bounds
 	for (auto It = PrimitiveOcclusionBounds.CreateIterator(); It; ++It)
@@ -1028,6 +1028,111 @@ struct FPrimitiveBounds
 	float MaxDrawDistance;
 };
 
+/**
+ * FPrimitiveBounds of all primitives in the scene with one array per component, so that primitives can be frustum
+ * culled four at a time. Indices match FScene::PrimitiveBounds.
+ */
+class FPrimitiveCullingBounds
+{
+public:
+
+	TArray<float> OriginX;
+	TArray<float> OriginY;
+	TArray<float> OriginZ;
+	TArray<float> BoxExtentX;
+	TArray<float> BoxExtentY;
+	TArray<float> BoxExtentZ;
+	TArray<float> SphereRadius;
+	TArray<float> MinDrawDistanceSq;
+	TArray<float> MaxDrawDistance;
+
+	int32 Num() const
+	{
+		return OriginX.Num();
+	}
+
+	/** Adds a primitive at the end, its bounds have to be set with SetBounds. */
+	void AddUninitialized()
+	{
+		OriginX.AddUninitialized();
+		OriginY.AddUninitialized();
+		OriginZ.AddUninitialized();
+		BoxExtentX.AddUninitialized();
+		BoxExtentY.AddUninitialized();
+		BoxExtentZ.AddUninitialized();
+		SphereRadius.AddUninitialized();
+		MinDrawDistanceSq.AddUninitialized();
+		MaxDrawDistance.AddUninitialized();
+	}
+
+	/** Removes a primitive by moving the last one into its place, like FScene does with all packed primitive arrays. */
+	void RemoveAtSwap(int32 Index)
+	{
+		OriginX.RemoveAtSwap(Index);
+		OriginY.RemoveAtSwap(Index);
+		OriginZ.RemoveAtSwap(Index);
+		BoxExtentX.RemoveAtSwap(Index);
+		BoxExtentY.RemoveAtSwap(Index);
+		BoxExtentZ.RemoveAtSwap(Index);
+		SphereRadius.RemoveAtSwap(Index);
+		MinDrawDistanceSq.RemoveAtSwap(Index);
+		MaxDrawDistance.RemoveAtSwap(Index);
+	}
+
+	void SetBounds(int32 Index, const FPrimitiveBounds& Bounds)
+	{
+		OriginX[Index] = Bounds.Origin.X;
+		OriginY[Index] = Bounds.Origin.Y;
+		OriginZ[Index] = Bounds.Origin.Z;
+		BoxExtentX[Index] = Bounds.BoxExtent.X;
+		BoxExtentY[Index] = Bounds.BoxExtent.Y;
+		BoxExtentZ[Index] = Bounds.BoxExtent.Z;
+		SphereRadius[Index] = Bounds.SphereRadius;
+		MinDrawDistanceSq[Index] = Bounds.MinDrawDistanceSq;
+		MaxDrawDistance[Index] = Bounds.MaxDrawDistance;
+	}
+
+	/** Moves the origins of all primitives. */
+	void ApplyOffset(const FVector& Offset)
+	{
+		for (int32 Index = 0; Index < Num(); ++Index)
+		{
+			OriginX[Index] += Offset.X;
+			OriginY[Index] += Offset.Y;
+			OriginZ[Index] += Offset.Z;
+		}
+	}
+};
+
+/** Per view settings FrustumCullPrimitives culls with. */
+struct FFrustumCullParams
+{
+	/** Origin draw distances are measured from. */
+	FVector ViewOrigin;
+	/** Scale applied to the max draw distance of all primitives. */
+	float MaxDrawDistanceScale;
+	/** Distance over which primitives fade out beyond their max draw distance, 0 to disable fading. */
+	float FadeRadius;
+	/** If true, primitives are never culled by their max draw distance. */
+	bool bDisableMaxDrawDistance;
+};
+
+/**
+ * Frustum culls primitives against a view and their draw distances. Bits of visible primitives are set in
+ * VisibilityMap and bits of primitives that might be fading in or out are set in FadingMap, all other bits are left
+ * alone. Primitives are culled four at a time, and big scenes are split into chunks of whole words of the bit arrays
+ * that task graph workers cull in parallel.
+ *
+ * @param Bounds			Bounds of the primitives
+ * @param Frustum			View frustum
+ * @param Params			Draw distance settings of the view
+ * @param VisibilityMap		Bit per primitive, set if the primitive is visible
+ * @param FadingMap			Bit per primitive, set if the primitive might be fading
+ * @param bAllowParallel	If false, all primitives are culled on the calling thread
+ * @return Number of culled primitives
+ */
+extern int32 FrustumCullPrimitives(const FPrimitiveCullingBounds& Bounds, const FConvexVolume& Frustum, const FFrustumCullParams& Params, FSceneBitArray& VisibilityMap, FSceneBitArray& FadingMap, bool bAllowParallel);
+
 /**
  * Precomputed primitive visibility ID.
  */
@@ -1174,6 +1279,8 @@ public:
 	TArray<FPrimitiveSceneInfo*> Primitives;
 	/** Packed array of primitive bounds. */
 	TArray<FPrimitiveBounds> PrimitiveBounds;
+	/** Copy of PrimitiveBounds with one array per component, used by frustum culling. */
+	FPrimitiveCullingBounds PrimitiveCullingBounds;
 	/** Packed array of precomputed primitive visibility IDs. */
 	TArray<FPrimitiveVisibilityId> PrimitiveVisibilityIds;
 	/** Packed array of primitive occlusion flags. See EOcclusionFlags. */
@@ -76,6 +76,14 @@ static TAutoConsoleVariable<int32> CVarLightShaftQuality(
 	TEXT("  1: on (default)\n"),
 	ECVF_Scalability | ECVF_RenderThreadSafe);
 
+static int32 GParallelFrustumCull = 1;
+static FAutoConsoleVariableRef CVarParallelFrustumCull(
+	TEXT("r.ParallelFrustumCull"),
+	GParallelFrustumCull,
+	TEXT("Whether scenes with many primitives are frustum culled on the task graph worker threads as well as the rendering thread."),
+	ECVF_RenderThreadSafe
+	);
+
 /** Distance fade cvars */
 static int32 GDisableLODFade = false;
 static FAutoConsoleVariableRef CVarDisableLODFade( TEXT("r.DisableLODFade"), GDisableLODFade, TEXT("Disable fading for distance culling"), ECVF_RenderThreadSafe );
@@ -240,56 +248,351 @@ bool FViewInfo::IsDistanceCulled( float DistanceSquared, float MinDrawDistance,
 	return ( bDistanceCulled && !bStillFading );
 }
 
+/** Number of primitives in a chunk that one thread culls at a time, a multiple of the bits in a word of FSceneBitArray. */
+static const int32 FrustumCullChunkSize = 32 * NumBitsPerDWORD;
+
+/** Scenes with fewer primitives than this are culled on the rendering thread alone. */
+static const int32 MinPrimitivesForParallelFrustumCull = 4 * FrustumCullChunkSize;
+
+/** A frustum plane with every component replicated, so four primitives can be tested against it at once. */
+struct FFrustumCullPlane
+{
+	VectorRegister X;
+	VectorRegister Y;
+	VectorRegister Z;
+	VectorRegister W;
+	VectorRegister AbsX;
+	VectorRegister AbsY;
+	VectorRegister AbsZ;
+};
+
 /**
- * Frustum cull primitives in the scene against the view.
+ * Culls primitives in chunks of whole words of the visibility bit arrays, so any number of threads can cull a
+ * view at once without sharing words. The arithmetic matches FConvexVolume::IntersectSphere and IntersectBox.
  */
-static int32 FrustumCull(const FScene* Scene, FViewInfo& View)
+class FFrustumCullContext
 {
-	SCOPE_CYCLE_COUNTER(STAT_FrustumCull);
+public:
+
+	FFrustumCullContext(const FPrimitiveCullingBounds& InBounds, const FConvexVolume& Frustum, const FFrustumCullParams& Params, FSceneBitArray& VisibilityMap, FSceneBitArray& FadingMap)
+		: Bounds(InBounds)
+		, NumPrimitives(InBounds.Num())
+		, VisibilityWords(VisibilityMap.GetData())
+		, FadingWords(FadingMap.GetData())
+		, bDisableMaxDrawDistance(Params.bDisableMaxDrawDistance)
+	{
+		check(VisibilityMap.Num() == NumPrimitives && FadingMap.Num() == NumPrimitives);
 
-	int32 NumCulledPrimitives = 0;
-	FVector ViewOriginForDistanceCulling = View.ViewMatrices.ViewOrigin;
-	float MaxDrawDistanceScale = GetCachedScalabilityCVars().ViewDistanceScale;
-	float FadeRadius = GDisableLODFade ? 0.0f : GDistanceFadeMaxTravel;
+		NumChunks = (NumPrimitives + FrustumCullChunkSize - 1) / FrustumCullChunkSize;
+
+		ViewOriginX = VectorLoadFloat1(&Params.ViewOrigin.X);
+		ViewOriginY = VectorLoadFloat1(&Params.ViewOrigin.Y);
+		ViewOriginZ = VectorLoadFloat1(&Params.ViewOrigin.Z);
+		MaxDrawDistanceScale = VectorLoadFloat1(&Params.MaxDrawDistanceScale);
+		FadeRadius = VectorLoadFloat1(&Params.FadeRadius);
+		const float MaxFloat = FLT_MAX;
+		DisabledMaxDrawDistance = VectorLoadFloat1(&MaxFloat);
 
-	for (FSceneBitArray::FIterator BitIt(View.PrimitiveVisibilityMap); BitIt; ++BitIt)
+		Planes.AddUninitialized(Frustum.Planes.Num());
+		for (int32 PlaneIndex = 0; PlaneIndex < Frustum.Planes.Num(); ++PlaneIndex)
+		{
+			const FPlane& Plane = Frustum.Planes[PlaneIndex];
+			FFrustumCullPlane& CullPlane = Planes[PlaneIndex];
+			CullPlane.X = VectorLoadFloat1(&Plane.X);
+			CullPlane.Y = VectorLoadFloat1(&Plane.Y);
+			CullPlane.Z = VectorLoadFloat1(&Plane.Z);
+			CullPlane.W = VectorLoadFloat1(&Plane.W);
+			CullPlane.AbsX = VectorAbs(CullPlane.X);
+			CullPlane.AbsY = VectorAbs(CullPlane.Y);
+			CullPlane.AbsZ = VectorAbs(CullPlane.Z);
+		}
+	}
+
+	/** Culls chunks until none are left. Called by every thread that helps culling the view. */
+	void Run()
 	{
-		const FPrimitiveBounds& Bounds = Scene->PrimitiveBounds[BitIt.GetIndex()];
-		float DistanceSquared = (Bounds.Origin - ViewOriginForDistanceCulling).SizeSquared();
-		float MaxDrawDistance = Bounds.MaxDrawDistance * MaxDrawDistanceScale;
+		int32 NumCulledInRun = 0;
 
-		// If cull distance is disabled, always show
-		if (View.Family->EngineShowFlags.DistanceCulledPrimitives)
+		for (int32 ChunkIndex = NextChunk.Increment() - 1; ChunkIndex < NumChunks; ChunkIndex = NextChunk.Increment() - 1)
 		{
-			MaxDrawDistance = FLT_MAX;
+			NumCulledInRun += CullChunk(ChunkIndex);
 		}
 
-		// The primitive is always culled if it exceeds the max fade distance or lay outside the view frustum.
-		if (DistanceSquared > FMath::Square(MaxDrawDistance + FadeRadius) ||
-			DistanceSquared < Bounds.MinDrawDistanceSq ||
-			View.ViewFrustum.IntersectSphere(Bounds.Origin, Bounds.SphereRadius) == false ||
-			View.ViewFrustum.IntersectBox(Bounds.Origin, Bounds.BoxExtent) == false)
+		NumCulled.Add(NumCulledInRun);
+	}
+
+	int32 GetNumChunks() const
+	{
+		return NumChunks;
+	}
+
+	int32 GetNumCulled() const
+	{
+		return NumCulled.GetValue();
+	}
+
+private:
+
+	/** Culls the primitives of one chunk and returns how many were culled. */
+	int32 CullChunk(int32 ChunkIndex)
+	{
+		// Number of set bits of every four bit mask.
+		static const int32 NumBitsSet[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+		const int32 FirstPrimitive = ChunkIndex * FrustumCullChunkSize;
+		const int32 LastPrimitive = FMath::Min(FirstPrimitive + FrustumCullChunkSize, NumPrimitives);
+		int32 NumCulledInChunk = 0;
+
+		for (int32 WordFirstPrimitive = FirstPrimitive; WordFirstPrimitive < LastPrimitive; WordFirstPrimitive += NumBitsPerDWORD)
 		{
-			STAT(NumCulledPrimitives++);
-			continue;
+			uint32 VisibleWord = 0;
+			uint32 FadingWord = 0;
+
+			for (int32 Shift = 0; Shift < NumBitsPerDWORD; Shift += 4)
+			{
+				const int32 Index = WordFirstPrimitive + Shift;
+				const int32 NumValid = FMath::Min(LastPrimitive - Index, 4);
+
+				if (NumValid <= 0)
+				{
+					break;
+				}
+
+				int32 CulledMask;
+				int32 VisibleMask;
+				int32 FadingMask;
+
+				if (NumValid == 4)
+				{
+					CullFour(Index, CulledMask, VisibleMask, FadingMask);
+				}
+				else
+				{
+					CullPartialFour(Index, NumValid, CulledMask, VisibleMask, FadingMask);
+				}
+
+				VisibleWord |= (uint32)VisibleMask << Shift;
+				FadingWord |= (uint32)FadingMask << Shift;
+				NumCulledInChunk += NumBitsSet[CulledMask];
+			}
+
+			const int32 WordIndex = WordFirstPrimitive / NumBitsPerDWORD;
+			VisibilityWords[WordIndex] |= VisibleWord;
+			FadingWords[WordIndex] |= FadingWord;
 		}
 
-		if (DistanceSquared > FMath::Square(MaxDrawDistance))
+		return NumCulledInChunk;
+	}
+
+	/** Culls four primitives starting at Index. */
+	FORCEINLINE void CullFour(int32 Index, int32& OutCulledMask, int32& OutVisibleMask, int32& OutFadingMask) const
+	{
+		CullFour(
+			&Bounds.OriginX[Index], &Bounds.OriginY[Index], &Bounds.OriginZ[Index],
+			&Bounds.BoxExtentX[Index], &Bounds.BoxExtentY[Index], &Bounds.BoxExtentZ[Index],
+			&Bounds.SphereRadius[Index], &Bounds.MinDrawDistanceSq[Index], &Bounds.MaxDrawDistance[Index],
+			OutCulledMask, OutVisibleMask, OutFadingMask
+			);
+	}
+
+	/** Culls the last primitives of the scene, when there are fewer than four left. */
+	void CullPartialFour(int32 Index, int32 NumValid, int32& OutCulledMask, int32& OutVisibleMask, int32& OutFadingMask) const
+	{
+		float Staged[9][4];
+		FMemory::Memzero(Staged, sizeof(Staged));
+
+		for (int32 Lane = 0; Lane < NumValid; ++Lane)
 		{
-			View.PotentiallyFadingPrimitiveMap.AccessCorrespondingBit(BitIt) = true;
+			Staged[0][Lane] = Bounds.OriginX[Index + Lane];
+			Staged[1][Lane] = Bounds.OriginY[Index + Lane];
+			Staged[2][Lane] = Bounds.OriginZ[Index + Lane];
+			Staged[3][Lane] = Bounds.BoxExtentX[Index + Lane];
+			Staged[4][Lane] = Bounds.BoxExtentY[Index + Lane];
+			Staged[5][Lane] = Bounds.BoxExtentZ[Index + Lane];
+			Staged[6][Lane] = Bounds.SphereRadius[Index + Lane];
+			Staged[7][Lane] = Bounds.MinDrawDistanceSq[Index + Lane];
+			Staged[8][Lane] = Bounds.MaxDrawDistance[Index + Lane];
 		}
-		else
+
+		CullFour(Staged[0], Staged[1], Staged[2], Staged[3], Staged[4], Staged[5], Staged[6], Staged[7], Staged[8], OutCulledMask, OutVisibleMask, OutFadingMask);
+
+		const int32 ValidMask = (1 << NumValid) - 1;
+		OutCulledMask &= ValidMask;
+		OutVisibleMask &= ValidMask;
+		OutFadingMask &= ValidMask;
+	}
+
+	/** Culls four primitives, bit N of the masks belongs to the Nth primitive. */
+	FORCEINLINE void CullFour(
+		const float* OriginX, const float* OriginY, const float* OriginZ,
+		const float* BoxExtentX, const float* BoxExtentY, const float* BoxExtentZ,
+		const float* SphereRadius, const float* MinDrawDistanceSq, const float* MaxDrawDistance,
+		int32& OutCulledMask, int32& OutVisibleMask, int32& OutFadingMask
+		) const
+	{
+		const VectorRegister OrigX = VectorLoad(OriginX);
+		const VectorRegister OrigY = VectorLoad(OriginY);
+		const VectorRegister OrigZ = VectorLoad(OriginZ);
+
+		// Distance checks, the same as (Origin - ViewOrigin).SizeSquared() against the squared draw distances
+		const VectorRegister DeltaX = VectorSubtract(OrigX, ViewOriginX);
+		const VectorRegister DeltaY = VectorSubtract(OrigY, ViewOriginY);
+		const VectorRegister DeltaZ = VectorSubtract(OrigZ, ViewOriginZ);
+		VectorRegister DistanceSquared = VectorMultiply(DeltaX, DeltaX);
+		DistanceSquared = VectorMultiplyAdd(DeltaY, DeltaY, DistanceSquared);
+		DistanceSquared = VectorMultiplyAdd(DeltaZ, DeltaZ, DistanceSquared);
+
+		const VectorRegister MaxDist = bDisableMaxDrawDistance ? DisabledMaxDrawDistance : VectorMultiply(VectorLoad(MaxDrawDistance), MaxDrawDistanceScale);
+		const VectorRegister MaxFadeDist = VectorAdd(MaxDist, FadeRadius);
+		const VectorRegister MinFadeDist = VectorSubtract(MaxDist, FadeRadius);
+
+		VectorRegister Culled = VectorBitwiseOr(
+			VectorCompareGT(DistanceSquared, VectorMultiply(MaxFadeDist, MaxFadeDist)),
+			VectorCompareGT(VectorLoad(MinDrawDistanceSq), DistanceSquared)
+			);
+
+		// Frustum checks, the primitive is outside if its sphere or its box is completely outside any plane
+		const VectorRegister Radius = VectorLoad(SphereRadius);
+		const VectorRegister AbsExtentX = VectorAbs(VectorLoad(BoxExtentX));
+		const VectorRegister AbsExtentY = VectorAbs(VectorLoad(BoxExtentY));
+		const VectorRegister AbsExtentZ = VectorAbs(VectorLoad(BoxExtentZ));
+
+		for (int32 PlaneIndex = 0; PlaneIndex < Planes.Num(); ++PlaneIndex)
 		{
-			// The primitive is visible!
-			BitIt.GetValue() = true;
-			if (DistanceSquared > FMath::Square(MaxDrawDistance - FadeRadius))
-			{
-				View.PotentiallyFadingPrimitiveMap.AccessCorrespondingBit(BitIt) = true;
-			}
+			const FFrustumCullPlane& Plane = Planes[PlaneIndex];
+			VectorRegister Distance = VectorMultiply(OrigX, Plane.X);
+			Distance = VectorMultiplyAdd(OrigY, Plane.Y, Distance);
+			Distance = VectorMultiplyAdd(OrigZ, Plane.Z, Distance);
+			Distance = VectorSubtract(Distance, Plane.W);
+
+			VectorRegister PushOut = VectorMultiply(AbsExtentX, Plane.AbsX);
+			PushOut = VectorMultiplyAdd(AbsExtentY, Plane.AbsY, PushOut);
+			PushOut = VectorMultiplyAdd(AbsExtentZ, Plane.AbsZ, PushOut);
+
+			Culled = VectorBitwiseOr(Culled, VectorBitwiseOr(VectorCompareGT(Distance, Radius), VectorCompareGT(Distance, PushOut)));
+		}
+
+		const int32 CulledMask = VectorMaskBits(Culled);
+		const int32 BeyondMaxDistMask = VectorMaskBits(VectorCompareGT(DistanceSquared, VectorMultiply(MaxDist, MaxDist)));
+		const int32 BeyondMinFadeDistMask = VectorMaskBits(VectorCompareGT(DistanceSquared, VectorMultiply(MinFadeDist, MinFadeDist)));
+
+		// Primitives beyond their max draw distance are only drawn while fading out
+		OutCulledMask = CulledMask;
+		OutVisibleMask = ~(CulledMask | BeyondMaxDistMask) & 0xf;
+		OutFadingMask = ~CulledMask & (BeyondMaxDistMask | BeyondMinFadeDistMask) & 0xf;
+	}
+
+	/** The bounds to cull. */
+	const FPrimitiveCullingBounds& Bounds;
+	/** Number of primitives to cull. */
+	int32 NumPrimitives;
+	/** Number of chunks the primitives are split into. */
+	int32 NumChunks;
+	/** Words of the visibility map. */
+	uint32* VisibilityWords;
+	/** Words of the fading map. */
+	uint32* FadingWords;
+	/** The frustum planes. */
+	TArray<FFrustumCullPlane, TAlignedHeapAllocator<16> > Planes;
+	/** Replicated view settings. */
+	VectorRegister ViewOriginX;
+	VectorRegister ViewOriginY;
+	VectorRegister ViewOriginZ;
+	VectorRegister MaxDrawDistanceScale;
+	VectorRegister FadeRadius;
+	VectorRegister DisabledMaxDrawDistance;
+	/** Whether max draw distances are ignored. */
+	bool bDisableMaxDrawDistance;
+	/** Index of the next chunk a thread picks up. */
+	FThreadSafeCounter NextChunk;
+	/** Number of culled primitives in all chunks culled so far. */
+	FThreadSafeCounter NumCulled;
+};
+
+/** Helps culling a view on a task graph worker thread. */
+class FFrustumCullTask
+{
+public:
+
+	FFrustumCullTask(FFrustumCullContext& InContext)
+		: Context(InContext)
+	{
+	}
+
+	static const TCHAR* GetTaskName()
+	{
+		return TEXT("FFrustumCullTask");
+	}
+
+	FORCEINLINE static TStatId GetStatId()
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FFrustumCullTask, STATGROUP_TaskGraphTasks);
+	}
+
+	static ENamedThreads::Type GetDesiredThread()
+	{
+		return ENamedThreads::AnyThread;
+	}
+
+	static ESubsequentsMode::Type GetSubsequentsMode()
+	{
+		return ESubsequentsMode::TrackSubsequents;
+	}
+
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		Context.Run();
+	}
+
+private:
+
+	FFrustumCullContext& Context;
+};
+
+int32 FrustumCullPrimitives(const FPrimitiveCullingBounds& Bounds, const FConvexVolume& Frustum, const FFrustumCullParams& Params, FSceneBitArray& VisibilityMap, FSceneBitArray& FadingMap, bool bAllowParallel)
+{
+	FFrustumCullContext Context(Bounds, Frustum, Params, VisibilityMap, FadingMap);
+
+	FGraphEventArray Tasks;
+
+	if (bAllowParallel && Bounds.Num() >= MinPrimitivesForParallelFrustumCull)
+	{
+		// The calling thread culls as well, so one task less than there are chunks is enough
+		const int32 NumTasks = FMath::Min(Context.GetNumChunks() - 1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+
+		for (int32 TaskIndex = 0; TaskIndex < NumTasks; ++TaskIndex)
+		{
+			Tasks.Add(TGraphTask<FFrustumCullTask>::CreateTask().ConstructAndDispatchWhenReady(Context));
 		}
 	}
 
-	return NumCulledPrimitives;
+	Context.Run();
+
+	if (Tasks.Num() > 0)
+	{
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(Tasks);
+	}
+
+	return Context.GetNumCulled();
+}
+
+/**
+ * Frustum cull primitives in the scene against the view.
+ */
+static int32 FrustumCull(const FScene* Scene, FViewInfo& View)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FrustumCull);
+
+	FFrustumCullParams Params;
+	Params.ViewOrigin = View.ViewMatrices.ViewOrigin;
+	Params.MaxDrawDistanceScale = GetCachedScalabilityCVars().ViewDistanceScale;
+	Params.FadeRadius = GDisableLODFade ? 0.0f : GDistanceFadeMaxTravel;
+	// If cull distance is disabled, always show
+	Params.bDisableMaxDrawDistance = View.Family->EngineShowFlags.DistanceCulledPrimitives;
+
+	const bool bAllowParallel = GParallelFrustumCull && FApp::ShouldUseThreadingForPerformance();
+
+	return FrustumCullPrimitives(Scene->PrimitiveCullingBounds, View.ViewFrustum, Params, View.PrimitiveVisibilityMap, View.PotentiallyFadingPrimitiveMap, bAllowParallel);
 }
 
 /**
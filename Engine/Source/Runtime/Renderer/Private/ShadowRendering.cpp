@@ -1357,11 +1357,11 @@ void FProjectedShadowInfo::RenderDepth(FDeferredShadingSceneRenderer* SceneRende
 	{
 		SCOPE_CYCLE_COUNTER(STAT_WholeSceneDynamicShadowDepthsTime);
 
-		uint32 DrawPrimitiveFlags = 0;
+		uint32 DrawPrimitiveFlags = EDrawDynamicFlags::ShadowDepth;
 		if(bReflectiveShadowmap)
 		{
 			// force lowest LOD for RSMs
-			DrawPrimitiveFlags = EDrawDynamicFlags::ForceLowestLOD;
+			DrawPrimitiveFlags |= EDrawDynamicFlags::ForceLowestLOD;
 		}
 
 		TDynamicPrimitiveDrawer<FShadowDepthDrawingPolicyFactory> Drawer(FoundView, FShadowDepthDrawingPolicyFactory::ContextType(this), true);
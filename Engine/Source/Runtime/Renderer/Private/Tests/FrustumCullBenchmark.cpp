@@ -0,0 +1,217 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	FrustumCullBenchmark.cpp: Frustum culling time per view of the per primitive
+	reference loop, the four wide cull and the parallel four wide cull.
+=============================================================================*/
+
+#include "RendererPrivate.h"
+#include "ScenePrivate.h"
+#include "AutomationTest.h"
+
+/** Number of primitives in the benchmark scene. */
+static const int32 FrustumCullBenchmarkNumPrimitives = 200000;
+
+/** Number of views the scene is culled against. */
+static const int32 FrustumCullBenchmarkNumViews = 8;
+
+/** Number of times every view is culled. */
+static const int32 FrustumCullBenchmarkNumIterations = 10;
+
+/** Half the size of the cube the primitives are spread over. */
+static const float FrustumCullBenchmarkWorldExtent = 100000.0f;
+
+/**
+ * Culls primitives one at a time with FConvexVolume, the way FrustumCull did before primitives were culled four at a time.
+ */
+static int32 FrustumCullReference(const TArray<FPrimitiveBounds>& PrimitiveBounds, const FConvexVolume& Frustum, const FFrustumCullParams& Params, FSceneBitArray& VisibilityMap, FSceneBitArray& FadingMap)
+{
+	int32 NumCulledPrimitives = 0;
+
+	for (int32 Index = 0; Index < PrimitiveBounds.Num(); ++Index)
+	{
+		const FPrimitiveBounds& Bounds = PrimitiveBounds[Index];
+		float DistanceSquared = (Bounds.Origin - Params.ViewOrigin).SizeSquared();
+		float MaxDrawDistance = Params.bDisableMaxDrawDistance ? FLT_MAX : Bounds.MaxDrawDistance * Params.MaxDrawDistanceScale;
+
+		if (DistanceSquared > FMath::Square(MaxDrawDistance + Params.FadeRadius) ||
+			DistanceSquared < Bounds.MinDrawDistanceSq ||
+			Frustum.IntersectSphere(Bounds.Origin, Bounds.SphereRadius) == false ||
+			Frustum.IntersectBox(Bounds.Origin, Bounds.BoxExtent) == false)
+		{
+			NumCulledPrimitives++;
+			continue;
+		}
+
+		if (DistanceSquared > FMath::Square(MaxDrawDistance))
+		{
+			FadingMap[Index] = true;
+		}
+		else
+		{
+			VisibilityMap[Index] = true;
+			if (DistanceSquared > FMath::Square(MaxDrawDistance - Params.FadeRadius))
+			{
+				FadingMap[Index] = true;
+			}
+		}
+	}
+
+	return NumCulledPrimitives;
+}
+
+/** Results of culling all views with one of the culling paths. */
+struct FFrustumCullBenchmarkResult
+{
+	/** Milliseconds spent culling, summed over all views and iterations. */
+	double Time;
+	/** Number of culled primitives, summed over all views of one iteration. */
+	int32 NumCulled;
+	/** Visibility and fading maps of every view. */
+	TArray<FSceneBitArray> VisibilityMaps;
+	TArray<FSceneBitArray> FadingMaps;
+
+	FFrustumCullBenchmarkResult()
+		: Time(0.0)
+		, NumCulled(0)
+	{
+	}
+};
+
+/**
+ * Culls every view FrustumCullBenchmarkNumIterations times.
+ *
+ * @param Mode	0 for the reference loop, 1 for the four wide cull on this thread, 2 for the parallel four wide cull
+ */
+static void RunFrustumCullBenchmark(int32 Mode, const TArray<FPrimitiveBounds>& PrimitiveBounds, const FPrimitiveCullingBounds& CullingBounds, const TArray<FConvexVolume>& Frustums, const TArray<FFrustumCullParams>& Params, FFrustumCullBenchmarkResult& Result)
+{
+	Result.VisibilityMaps.SetNum(Frustums.Num());
+	Result.FadingMaps.SetNum(Frustums.Num());
+
+	for (int32 Iteration = 0; Iteration < FrustumCullBenchmarkNumIterations; ++Iteration)
+	{
+		for (int32 ViewIndex = 0; ViewIndex < Frustums.Num(); ++ViewIndex)
+		{
+			FSceneBitArray& VisibilityMap = Result.VisibilityMaps[ViewIndex];
+			FSceneBitArray& FadingMap = Result.FadingMaps[ViewIndex];
+			VisibilityMap.Init(false, PrimitiveBounds.Num());
+			FadingMap.Init(false, PrimitiveBounds.Num());
+
+			const double StartTime = FPlatformTime::Seconds();
+			const int32 NumCulled = (Mode == 0) ?
+				FrustumCullReference(PrimitiveBounds, Frustums[ViewIndex], Params[ViewIndex], VisibilityMap, FadingMap) :
+				FrustumCullPrimitives(CullingBounds, Frustums[ViewIndex], Params[ViewIndex], VisibilityMap, FadingMap, Mode == 2);
+			Result.Time += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+			if (Iteration == 0)
+			{
+				Result.NumCulled += NumCulled;
+			}
+		}
+	}
+}
+
+/** Returns the number of primitives whose bits differ from the reference. */
+static int32 CountFrustumCullMismatches(const FFrustumCullBenchmarkResult& Reference, const FFrustumCullBenchmarkResult& Result)
+{
+	int32 NumMismatches = 0;
+
+	for (int32 ViewIndex = 0; ViewIndex < Reference.VisibilityMaps.Num(); ++ViewIndex)
+	{
+		for (int32 Index = 0; Index < Reference.VisibilityMaps[ViewIndex].Num(); ++Index)
+		{
+			if (Reference.VisibilityMaps[ViewIndex][Index] != Result.VisibilityMaps[ViewIndex][Index] ||
+				Reference.FadingMaps[ViewIndex][Index] != Result.FadingMaps[ViewIndex][Index])
+			{
+				NumMismatches++;
+			}
+		}
+	}
+
+	return NumMismatches;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrustumCullBenchmark, "Renderer.Frustum Cull Benchmark", EAutomationTestFlags::ATF_Editor | EAutomationTestFlags::ATF_Commandlet)
+
+/**
+ * Culls a synthetic scene against several views with the reference loop and with FrustumCullPrimitives on one and on all
+ * threads. Doesn't touch the RHI, so it runs with -nullrhi. All paths have to produce the same visibility and fading bits.
+ */
+bool FFrustumCullBenchmark::RunTest(const FString& Parameters)
+{
+	FRandomStream RandomStream(0x3f2c);
+
+	TArray<FPrimitiveBounds> PrimitiveBounds;
+	FPrimitiveCullingBounds CullingBounds;
+	PrimitiveBounds.AddUninitialized(FrustumCullBenchmarkNumPrimitives);
+
+	for (int32 Index = 0; Index < FrustumCullBenchmarkNumPrimitives; ++Index)
+	{
+		FPrimitiveBounds& Bounds = PrimitiveBounds[Index];
+		Bounds.Origin = FVector(
+			RandomStream.FRandRange(-FrustumCullBenchmarkWorldExtent, FrustumCullBenchmarkWorldExtent),
+			RandomStream.FRandRange(-FrustumCullBenchmarkWorldExtent, FrustumCullBenchmarkWorldExtent),
+			RandomStream.FRandRange(-FrustumCullBenchmarkWorldExtent, FrustumCullBenchmarkWorldExtent)
+			);
+		Bounds.BoxExtent = FVector(RandomStream.FRandRange(10.0f, 2000.0f), RandomStream.FRandRange(10.0f, 2000.0f), RandomStream.FRandRange(10.0f, 2000.0f));
+		Bounds.SphereRadius = Bounds.BoxExtent.Size();
+		Bounds.MinDrawDistanceSq = (RandomStream.FRand() < 0.1f) ? FMath::Square(RandomStream.FRandRange(100.0f, 1000.0f)) : 0.0f;
+		Bounds.MaxDrawDistance = (RandomStream.FRand() < 0.5f) ? RandomStream.FRandRange(5000.0f, 50000.0f) : FLT_MAX;
+
+		CullingBounds.AddUninitialized();
+		CullingBounds.SetBounds(Index, Bounds);
+	}
+
+	TArray<FConvexVolume> Frustums;
+	TArray<FFrustumCullParams> Params;
+
+	for (int32 ViewIndex = 0; ViewIndex < FrustumCullBenchmarkNumViews; ++ViewIndex)
+	{
+		const FVector ViewLocation = RandomStream.GetUnitVector() * RandomStream.FRandRange(0.0f, FrustumCullBenchmarkWorldExtent);
+		const FRotator ViewRotation(RandomStream.FRandRange(-60.0f, 60.0f), RandomStream.FRandRange(-180.0f, 180.0f), 0.0f);
+		const FMatrix ViewMatrix = FTranslationMatrix(-ViewLocation) * FInverseRotationMatrix(ViewRotation) * FMatrix(
+			FPlane(0, 0, 1, 0),
+			FPlane(1, 0, 0, 0),
+			FPlane(0, 1, 0, 0),
+			FPlane(0, 0, 0, 1));
+		const FMatrix ProjectionMatrix = FPerspectiveMatrix(PI / 4.0f, 1920.0f, 1080.0f, 10.0f, 2.0f * FrustumCullBenchmarkWorldExtent);
+
+		FConvexVolume& Frustum = *new(Frustums) FConvexVolume();
+		GetViewFrustumBounds(Frustum, ViewMatrix * ProjectionMatrix, true);
+
+		FFrustumCullParams& ViewParams = Params[Params.AddUninitialized()];
+		ViewParams.ViewOrigin = ViewLocation;
+		ViewParams.MaxDrawDistanceScale = 1.0f;
+		ViewParams.FadeRadius = 1000.0f;
+		// One view with distance culling disabled, like the DistanceCulledPrimitives show flag
+		ViewParams.bDisableMaxDrawDistance = (ViewIndex == FrustumCullBenchmarkNumViews - 1);
+	}
+
+	FFrustumCullBenchmarkResult ReferenceResult;
+	FFrustumCullBenchmarkResult VectorResult;
+	FFrustumCullBenchmarkResult ParallelResult;
+	RunFrustumCullBenchmark(0, PrimitiveBounds, CullingBounds, Frustums, Params, ReferenceResult);
+	RunFrustumCullBenchmark(1, PrimitiveBounds, CullingBounds, Frustums, Params, VectorResult);
+	RunFrustumCullBenchmark(2, PrimitiveBounds, CullingBounds, Frustums, Params, ParallelResult);
+
+	const int32 NumVectorMismatches = CountFrustumCullMismatches(ReferenceResult, VectorResult);
+	const int32 NumParallelMismatches = CountFrustumCullMismatches(ReferenceResult, ParallelResult);
+
+	if (NumVectorMismatches > 0 || VectorResult.NumCulled != ReferenceResult.NumCulled)
+	{
+		AddError(FString::Printf(TEXT("Four wide cull differs from the reference for %d primitives, %d culled instead of %d"), NumVectorMismatches, VectorResult.NumCulled, ReferenceResult.NumCulled));
+	}
+	if (NumParallelMismatches > 0 || ParallelResult.NumCulled != ReferenceResult.NumCulled)
+	{
+		AddError(FString::Printf(TEXT("Parallel cull differs from the reference for %d primitives, %d culled instead of %d"), NumParallelMismatches, ParallelResult.NumCulled, ReferenceResult.NumCulled));
+	}
+
+	const int32 NumCulls = FrustumCullBenchmarkNumViews * FrustumCullBenchmarkNumIterations;
+
+	AddLogItem(FString::Printf(TEXT("%d primitives, %d views, %d culls per view, %d worker threads"), FrustumCullBenchmarkNumPrimitives, FrustumCullBenchmarkNumViews, FrustumCullBenchmarkNumIterations, FTaskGraphInterface::Get().GetNumWorkerThreads()));
+	AddLogItem(FString::Printf(TEXT("Culled per view  %d of %d"), ReferenceResult.NumCulled / FrustumCullBenchmarkNumViews, FrustumCullBenchmarkNumPrimitives));
+	AddLogItem(FString::Printf(TEXT("              %10s %10s %10s"), TEXT("Reference"), TEXT("FourWide"), TEXT("Parallel")));
+	AddLogItem(FString::Printf(TEXT("ms per view   %10.3f %10.3f %10.3f"), ReferenceResult.Time / NumCulls, VectorResult.Time / NumCulls, ParallelResult.Time / NumCulls));
+
+	return NumVectorMismatches == 0 && NumParallelMismatches == 0;
+}
@@ -5,9 +5,6 @@
 #include "NetworkMessage.h"
 #include "MultiChannelTcp.h"
 
-// we can't have multiple threads sending/receiving responses at the same time
-static FCriticalSection SocketCriticalSection;
-
 bool FSimpleAbstractSocket_FSocket::Receive(uint8 *Results, int32 Size) const
 {
 	int32 Offset = 0;
@@ -60,7 +57,8 @@ bool FSimpleAbstractSocket_FMultichannelTCPSocket::Send(const uint8 *Buffer, int
 
 bool FNFSMessageHeader::WrapAndSendPayload(const TArray<uint8>& Payload, const FSimpleAbstractSocket& Socket)
 {
-	FScopeLock SocketLock(&SocketCriticalSection);
+	// we can't have multiple threads sending/receiving responses on the same socket at the same time
+	FScopeLock SocketLock(&Socket.GetCriticalSection());
 
 	// make a header for the payload
 	FNFSMessageHeader Header(Socket, Payload);
@@ -83,7 +81,7 @@ bool FNFSMessageHeader::WrapAndSendPayload(const TArray<uint8>& Payload, const F
 
 bool FNFSMessageHeader::ReceivePayload(FArrayReader& OutPayload, const FSimpleAbstractSocket& Socket)
 {
-	FScopeLock SocketLock(&SocketCriticalSection);
+	FScopeLock SocketLock(&Socket.GetCriticalSection());
 
 	// make room to receive a header
 	TArray<uint8> HeaderBytes;
@@ -152,4 +150,83 @@ bool FNFSMessageHeader::SendPayloadAndReceiveResponse(const TArray<uint8>& Paylo
 
 	// wait for response and get it
 	return ReceivePayload(Response, Socket);
-}
\ No newline at end of file
+}
+
+void FNFSFileContents::Write(FArchive& Out, const uint8* Contents, uint64 Size, const FSHAHash& ReceiverHash, bool bCompress)
+{
+	FHeader Header;
+	Header.Size = Size;
+
+	// hash a block at a time, the hash functions only take 32 bit sizes
+	FSHA1 HashState;
+	for (uint64 Offset = 0; Offset < Size; Offset += BlockSize)
+	{
+		HashState.Update(Contents + Offset, (uint32)FMath::Min<uint64>(BlockSize, Size - Offset));
+	}
+	HashState.Final();
+	HashState.GetHash(Header.Hash.Hash);
+
+	// the receiver already has these contents, only the header needs to go over the network
+	Header.bUnchanged = (Header.Hash == ReceiverHash);
+	Out << Header;
+
+	if (Header.bUnchanged)
+	{
+		return;
+	}
+
+	TArray<uint8> CompressedBlock;
+	CompressedBlock.AddUninitialized(BlockSize);
+
+	for (uint64 Offset = 0; Offset < Size; Offset += BlockSize)
+	{
+		const int32 UncompressedSize = (int32)FMath::Min<uint64>(BlockSize, Size - Offset);
+		int32 CompressedSize = UncompressedSize;
+
+		// blocks that don't get any smaller are sent as they are, which the reader can tell by their size
+		if (bCompress
+			&& FCompression::CompressMemory(COMPRESS_ZLIB, CompressedBlock.GetTypedData(), CompressedSize, Contents + Offset, UncompressedSize)
+			&& CompressedSize < UncompressedSize)
+		{
+			Out << CompressedSize;
+			Out.Serialize(CompressedBlock.GetTypedData(), CompressedSize);
+		}
+		else
+		{
+			CompressedSize = UncompressedSize;
+			Out << CompressedSize;
+			Out.Serialize((void*)(Contents + Offset), UncompressedSize);
+		}
+	}
+}
+
+bool FNFSFileContents::ReadBlock(FArchive& In, uint8* OutBlock, int32 UncompressedSize)
+{
+	check(UncompressedSize <= BlockSize);
+
+	int32 CompressedSize = 0;
+	In << CompressedSize;
+
+	if (In.IsError() || CompressedSize <= 0 || CompressedSize > UncompressedSize)
+	{
+		UE_LOG(LogSockets, Error, TEXT("Bad file contents block size %d, expected at most %d."), CompressedSize, UncompressedSize);
+		return false;
+	}
+
+	if (CompressedSize == UncompressedSize)
+	{
+		In.Serialize(OutBlock, UncompressedSize);
+		return !In.IsError();
+	}
+
+	TArray<uint8> CompressedBlock;
+	CompressedBlock.AddUninitialized(CompressedSize);
+	In.Serialize(CompressedBlock.GetTypedData(), CompressedSize);
+
+	if (In.IsError() || !FCompression::UncompressMemory(COMPRESS_ZLIB, OutBlock, UncompressedSize, CompressedBlock.GetTypedData(), CompressedSize))
+	{
+		UE_LOG(LogSockets, Error, TEXT("Unable to uncompress file contents block."));
+		return false;
+	}
+	return true;
+}
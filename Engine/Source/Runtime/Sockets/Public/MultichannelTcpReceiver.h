@@ -78,7 +78,7 @@ public:
 			// read a header and payload pair
 			FArrayReader Payload; 
 
-			if (FNFSMessageHeader::ReceivePayload(Payload, FSimpleAbstractSocket_FSocket(Socket)) == false)
+			if (FNFSMessageHeader::ReceivePayload(Payload, FSimpleAbstractSocket_FSocket(Socket, SocketCriticalSection)) == false)
 			{
 				// if we failed to receive the payload, then the client is most likely dead, so, we can kill this connection
 				// @todo: Add more error codes, maybe some errors shouldn't kill the connection
@@ -125,6 +125,9 @@ private:
 	// Holds the socket to use for communication.
 	FSocket* Socket;
 
+	// Holds a critical section that is held while a message is sent or received on the socket.
+	FCriticalSection SocketCriticalSection;
+
 	// Holds the thread we are running on.
 	FRunnableThread* Thread;
 
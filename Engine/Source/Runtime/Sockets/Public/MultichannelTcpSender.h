@@ -185,7 +185,7 @@ public:
 				Ar << Channel;
 				Ar << Data;
 
-				if (!FNFSMessageHeader::WrapAndSendPayload(Ar, FSimpleAbstractSocket_FSocket(Socket)))
+				if (!FNFSMessageHeader::WrapAndSendPayload(Ar, FSimpleAbstractSocket_FSocket(Socket, SocketCriticalSection)))
 				{
 					UE_LOG(LogMultichannelTCP, Error, TEXT("Failed to send payload."));
 
@@ -249,6 +249,9 @@ private:
 	// Holds the socket to use.
 	FSocket* Socket;
 
+	// Holds a critical section that is held while a message is sent or received on the socket.
+	FCriticalSection SocketCriticalSection;
+
 	// Holds the thread that is running this instance.
 	FRunnableThread* Thread;
 
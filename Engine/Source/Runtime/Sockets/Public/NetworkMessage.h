@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "SecureHash.h"
+
 enum
 { 
 	DEFAULT_FILE_SERVING_PORT=41899 // port that the network file server uses
@@ -40,6 +42,7 @@ namespace NFS_Messages
 		GetFileList,
 		Heartbeat,
 		RecompileShaders,
+		SyncFiles,
 	};
 }
 
@@ -60,6 +63,14 @@ namespace NFS_Channels
 class SOCKETS_API FSimpleAbstractSocket
 {
 public:
+	/**
+	* Constructor
+	* @param InCriticalSection	Lock owned by whoever owns the socket, messages on the socket are not sent or received by more than one thread at a time
+	**/
+	FSimpleAbstractSocket(FCriticalSection& InCriticalSection)
+		: CriticalSection(InCriticalSection)
+	{
+	}
 	/**
 	* Block until we receive data from the socket
 	* @param Results		Buffer of at least Size size, used to hold the results
@@ -76,6 +87,14 @@ public:
 	virtual bool Send(const uint8 *Buffer, int32 Size) const = 0;
 	/** return the magic number for this message, also used for endian correction on the archives **/
 	virtual uint32 GetMagic() const = 0;
+	/** return the lock that is held while a message is sent or received on the socket **/
+	FCriticalSection& GetCriticalSection() const
+	{
+		return CriticalSection;
+	}
+private:
+	/** Lock owned by whoever owns the socket **/
+	FCriticalSection& CriticalSection;
 };
 
 /**
@@ -89,9 +108,11 @@ public:
 	/**
 	* Constructor
 	* @param InSocket		Ordinary socket to forward requests to
+	* @param InCriticalSection	Lock owned by whoever owns the socket
 	**/
-	FSimpleAbstractSocket_FSocket(class FSocket* InSocket)
-		: Socket(InSocket)
+	FSimpleAbstractSocket_FSocket(class FSocket* InSocket, FCriticalSection& InCriticalSection)
+		: FSimpleAbstractSocket(InCriticalSection)
+		, Socket(InSocket)
 	{
 	}
 	virtual bool Receive(uint8 *Results, int32 Size) const;
@@ -118,10 +139,12 @@ public:
 	* Constructor
 	* @param InSocket			Multichannel socket to forward requests to
 	* @param InSendChannel		Channel to send to
+	* @param InCriticalSection	Lock owned by whoever owns the socket
 	* @param InReceiveChannel	Channel to receive from, defaults to the sending channel
 	**/
-	FSimpleAbstractSocket_FMultichannelTCPSocket(class FMultichannelTcpSocket* InSocket, uint32 InSendChannel, uint32 InReceiveChannel = 0)
-		: Socket(InSocket)
+	FSimpleAbstractSocket_FMultichannelTCPSocket(class FMultichannelTcpSocket* InSocket, uint32 InSendChannel, FCriticalSection& InCriticalSection, uint32 InReceiveChannel = 0)
+		: FSimpleAbstractSocket(InCriticalSection)
+		, Socket(InSocket)
 		, SendChannel(InSendChannel)
 		, ReceiveChannel(InReceiveChannel ? InReceiveChannel : InSendChannel)
 	{
@@ -230,6 +253,65 @@ struct SOCKETS_API FNFSMessageHeader
 };
 
 
+/**
+ * Writes and reads the contents of files synced over the network file system. Contents are sent a block at a time,
+ * each block compressed if that makes it smaller, and are left out if the receiver already has a copy with the same hash.
+ */
+struct SOCKETS_API FNFSFileContents
+{
+	enum
+	{
+		/** Size of the blocks contents are compressed in, FCompression can't take much more at once */
+		BlockSize = 128 * 1024,
+	};
+
+	/** What the receiver knows about the contents before reading any blocks */
+	struct FHeader
+	{
+		/** Hash of the uncompressed contents */
+		FSHAHash Hash;
+		/** Size of the uncompressed contents */
+		uint64 Size;
+		/** True if the receiver's copy has the same hash, no blocks follow */
+		bool bUnchanged;
+
+		FHeader()
+			: Size(0)
+			, bUnchanged(false)
+		{
+		}
+
+		friend FArchive& operator<<(FArchive& Ar, FHeader& Header)
+		{
+			Ar << Header.Hash;
+			Ar << Header.Size;
+			Ar << Header.bUnchanged;
+			return Ar;
+		}
+	};
+
+	/**
+	 * Writes the header and blocks of a file's contents
+	 *
+	 * @param Out				Archive to write to
+	 * @param Contents			Contents of the file
+	 * @param Size				Size of the contents
+	 * @param ReceiverHash		Hash of the receiver's copy of the file, all zeros if it has none
+	 * @param bCompress			Whether to try compressing the blocks
+	 */
+	static void Write(FArchive& Out, const uint8* Contents, uint64 Size, const FSHAHash& ReceiverHash, bool bCompress = true);
+
+	/**
+	 * Reads the next block of contents written by Write
+	 *
+	 * @param In				Archive to read from
+	 * @param OutBlock			Buffer of at least BlockSize bytes to hold the uncompressed block
+	 * @param UncompressedSize	Size of the block, BlockSize for all but the last block
+	 * @return					true if the block was read and uncompressed
+	 */
+	static bool ReadBlock(FArchive& In, uint8* OutBlock, int32 UncompressedSize);
+};
+
 /**
  * A helper class for storing all available file info.
  */
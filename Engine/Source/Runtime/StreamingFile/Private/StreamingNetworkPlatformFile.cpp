@@ -307,9 +307,9 @@ bool FStreamingNetworkPlatformFile::InitializeInternal(IPlatformFile* Inner, con
 			// Send the directories over, and wait for a response.
 			FArrayReader Response;
 #if USE_MCSOCKET_FOR_NFS
-			if (FNFSMessageHeader::SendPayloadAndReceiveResponse(Payload, Response, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main)) == false)
+			if (FNFSMessageHeader::SendPayloadAndReceiveResponse(Payload, Response, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main, SocketCriticalSection)) == false)
 #else
-			if (FNFSMessageHeader::SendPayloadAndReceiveResponse(Payload, Response, FSimpleAbstractSocket_FSocket(FileSocket)) == false)
+			if (FNFSMessageHeader::SendPayloadAndReceiveResponse(Payload, Response, FSimpleAbstractSocket_FSocket(FileSocket, SocketCriticalSection)) == false)
 #endif
 			{
 				// On failure, shut it all down.
@@ -828,9 +828,9 @@ bool FStreamingNetworkPlatformFile::SendCloseMessage(uint64 HandleId)
 bool FStreamingNetworkPlatformFile::SendPayloadAndReceiveResponse(FStreamingNetworkFileArchive& Payload, FArrayReader& Response)
 {
 #if USE_MCSOCKET_FOR_NFS
-	if (FNFSMessageHeader::SendPayloadAndReceiveResponse(Payload, Response, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main)) == false)
+	if (FNFSMessageHeader::SendPayloadAndReceiveResponse(Payload, Response, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main, SocketCriticalSection)) == false)
 #else
-	if (FNFSMessageHeader::SendPayloadAndReceiveResponse(Payload, Response, FSimpleAbstractSocket_FSocket(FileSocket)) == false)
+	if (FNFSMessageHeader::SendPayloadAndReceiveResponse(Payload, Response, FSimpleAbstractSocket_FSocket(FileSocket, SocketCriticalSection)) == false)
 #endif
 	{
 		UE_LOG(LogStreamingPlatformFile, Fatal, TEXT("Receive failure!"));
@@ -846,9 +846,9 @@ void FStreamingNetworkPlatformFile::PerformHeartbeat()
 	// send the filename over
 	FArrayReader Response;
 #if USE_MCSOCKET_FOR_NFS
-	if (FNFSMessageHeader::SendPayloadAndReceiveResponse(Payload, Response, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main)) == false)
+	if (FNFSMessageHeader::SendPayloadAndReceiveResponse(Payload, Response, FSimpleAbstractSocket_FMultichannelTCPSocket(MCSocket, NFS_Channels::Main, SocketCriticalSection)) == false)
 #else
-	if (FNFSMessageHeader::SendPayloadAndReceiveResponse(Payload, Response, FSimpleAbstractSocket_FSocket(FileSocket)) == false)
+	if (FNFSMessageHeader::SendPayloadAndReceiveResponse(Payload, Response, FSimpleAbstractSocket_FSocket(FileSocket, SocketCriticalSection)) == false)
 #endif
 	{
 		return;